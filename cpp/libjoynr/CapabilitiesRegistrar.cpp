@@ -17,7 +17,9 @@
  * #L%
  */
 #include "joynr/CapabilitiesRegistrar.h"
+
 #include "joynr/ParticipantIdStorage.h"
+#include "joynr/exceptions/JoynrException.h"
 
 namespace joynr
 {
@@ -67,6 +69,184 @@ void CapabilitiesRegistrar::removeAsync(
     discoveryProxy->removeAsync(participantId, std::move(onSuccessWrapper), std::move(onError));
 }
 
+std::vector<std::string> CapabilitiesRegistrar::addAsync(
+        std::vector<ProviderRegistration> registrations,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException&)> onError,
+        bool persist,
+        bool awaitGlobalRegistration) noexcept
+{
+    std::vector<std::string> participantIds;
+    participantIds.reserve(registrations.size());
+    for (const ProviderRegistration& registration : registrations) {
+        participantIds.push_back(registration.entry.getParticipantId());
+    }
+    if (registrations.empty()) {
+        onSuccess();
+        return participantIds;
+    }
+
+    // routing entries added for a failed batch are removed again, unknown participantIds are
+    // ignored by the router
+    std::function<void(const exceptions::JoynrRuntimeException&)> onErrorWrapper = [
+        participantIds,
+        messageRouter = util::as_weak_ptr(messageRouter),
+        onError = std::move(onError)
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        if (auto ptr = messageRouter.lock()) {
+            ptr->removeNextHops(participantIds);
+        }
+        onError(error);
+    };
+
+    auto onNextHopsAdded = [
+        registrations,
+        participantIdStorage = util::as_weak_ptr(participantIdStorage),
+        discoveryProxy = util::as_weak_ptr(discoveryProxy),
+        awaitGlobalRegistration,
+        onSuccess = std::move(onSuccess),
+        onErrorWrapper,
+        persist
+    ]()
+    {
+        if (persist) {
+            if (auto participantIdStoragePtr = participantIdStorage.lock()) {
+                for (const ProviderRegistration& registration : registrations) {
+                    participantIdStoragePtr->setProviderParticipantId(
+                            registration.domain,
+                            registration.interfaceName,
+                            registration.majorVersion,
+                            registration.entry.getParticipantId());
+                }
+            }
+        }
+
+        auto discoveryProxyPtr = discoveryProxy.lock();
+        if (!discoveryProxyPtr) {
+            onErrorWrapper(exceptions::JoynrRuntimeException(
+                    "runtime and required discovery proxy have been already destroyed"));
+            return;
+        }
+
+        std::vector<types::DiscoveryEntry> entries;
+        entries.reserve(registrations.size());
+        boost::optional<MessagingQos> messagingQos;
+        for (const ProviderRegistration& registration : registrations) {
+            entries.push_back(registration.entry);
+            if (registration.isInternalProvider) {
+                messagingQos = MessagingQos(std::numeric_limits<std::int64_t>::max());
+            }
+        }
+        discoveryProxyPtr->addAsync(
+                entries,
+                awaitGlobalRegistration,
+                [ numberOfProviders = entries.size(), onSuccess ]() {
+                    JOYNR_LOG_INFO(logger(), "Registered {} providers", numberOfProviders);
+                    onSuccess();
+                },
+                onErrorWrapper,
+                std::move(messagingQos));
+    };
+
+    // the Routing interface adds many participants with a single call only if they share
+    // the visibility, so there is one call for the global and one for the local providers
+    std::vector<std::string> globallyVisibleParticipantIds;
+    std::vector<std::string> locallyVisibleParticipantIds;
+    for (const ProviderRegistration& registration : registrations) {
+        const std::string& participantId = registration.entry.getParticipantId();
+        for (std::shared_ptr<IDispatcher> currentDispatcher : dispatcherList) {
+            assert(currentDispatcher != nullptr);
+            currentDispatcher->addRequestCaller(participantId, registration.caller);
+        }
+        if (registration.entry.getQos().getScope() == types::ProviderScope::GLOBAL) {
+            globallyVisibleParticipantIds.push_back(participantId);
+        } else {
+            locallyVisibleParticipantIds.push_back(participantId);
+        }
+    }
+
+    auto addLocallyVisibleNextHops = [
+        locallyVisibleParticipantIds = std::move(locallyVisibleParticipantIds),
+        messageRouter = util::as_weak_ptr(messageRouter),
+        dispatcherAddress = this->dispatcherAddress,
+        onNextHopsAdded = std::move(onNextHopsAdded),
+        onErrorWrapper
+    ]()
+    {
+        if (locallyVisibleParticipantIds.empty()) {
+            onNextHopsAdded();
+            return;
+        }
+        auto messageRouterPtr = messageRouter.lock();
+        if (!messageRouterPtr) {
+            onErrorWrapper(exceptions::JoynrRuntimeException(
+                    "runtime and required message router have been already destroyed"));
+            return;
+        }
+        constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+        const bool isGloballyVisible = false;
+        const bool isSticky = false;
+        messageRouterPtr->addNextHops(locallyVisibleParticipantIds,
+                                      dispatcherAddress,
+                                      isGloballyVisible,
+                                      expiryDateMs,
+                                      isSticky,
+                                      onNextHopsAdded,
+                                      onErrorWrapper);
+    };
+
+    if (globallyVisibleParticipantIds.empty()) {
+        addLocallyVisibleNextHops();
+    } else {
+        constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+        const bool isGloballyVisible = true;
+        const bool isSticky = false;
+        messageRouter->addNextHops(globallyVisibleParticipantIds,
+                                   dispatcherAddress,
+                                   isGloballyVisible,
+                                   expiryDateMs,
+                                   isSticky,
+                                   std::move(addLocallyVisibleNextHops),
+                                   onErrorWrapper);
+    }
+    return participantIds;
+}
+
+void CapabilitiesRegistrar::removeAsync(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException&)> onError) noexcept
+{
+    if (participantIds.empty()) {
+        onSuccess();
+        return;
+    }
+
+    auto onSuccessWrapper = [
+        dispatcherList = this->dispatcherList,
+        messageRouter = util::as_weak_ptr(messageRouter),
+        participantIds,
+        onSuccess = std::move(onSuccess),
+        onError
+    ]()
+    {
+        for (const std::string& participantId : participantIds) {
+            for (std::shared_ptr<IDispatcher> currentDispatcher : dispatcherList) {
+                currentDispatcher->removeRequestCaller(participantId);
+            }
+        }
+
+        if (auto ptr = messageRouter.lock()) {
+            ptr->removeNextHops(participantIds, onSuccess, onError);
+        } else {
+            onSuccess();
+        }
+    };
+
+    discoveryProxy->removeAsync(participantIds, std::move(onSuccessWrapper), std::move(onError));
+}
+
 void CapabilitiesRegistrar::addDispatcher(std::shared_ptr<IDispatcher> dispatcher)
 {
     dispatcherList.push_back(std::move(dispatcher));
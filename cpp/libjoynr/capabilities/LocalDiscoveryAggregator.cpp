@@ -24,17 +24,58 @@
 #include <memory>
 #include <utility>
 
+#include "joynr/BatchCompletion.h"
 #include "joynr/Future.h"
+#include "joynr/Util.h"
 #include "joynr/exceptions/JoynrException.h"
+#include "joynr/exceptions/MethodInvocationException.h"
 #include "joynr/types/DiscoveryEntry.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
 
 namespace joynr
 {
 
+namespace
+{
+
+bool isUnknownMethod(const exceptions::JoynrRuntimeException& error)
+{
+    return error.getTypeName() == exceptions::MethodInvocationException::TYPE_NAME();
+}
+
+std::function<void()> createOnBatchSuccess(std::shared_ptr<joynr::Future<void>> future,
+                                           std::function<void()> onSuccess)
+{
+    return [ future = std::move(future), onSuccess = std::move(onSuccess) ]()
+    {
+        if (onSuccess) {
+            onSuccess();
+        }
+        future->onSuccess();
+    };
+}
+
+std::function<void(const exceptions::JoynrRuntimeException&)> createOnBatchError(
+        std::shared_ptr<joynr::Future<void>> future,
+        std::function<void(const exceptions::JoynrRuntimeException&)> onRuntimeError)
+{
+    return [ future = std::move(future), onRuntimeError = std::move(onRuntimeError) ](
+            const exceptions::JoynrRuntimeException& error)
+    {
+        if (onRuntimeError) {
+            onRuntimeError(error);
+        }
+        future->onError(std::shared_ptr<exceptions::JoynrException>(error.clone()));
+    };
+}
+
+} // namespace
+
 LocalDiscoveryAggregator::LocalDiscoveryAggregator(
         std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo> provisionedDiscoveryEntries)
-        : discoveryProxy(), provisionedDiscoveryEntries(std::move(provisionedDiscoveryEntries))
+        : discoveryProxy(),
+          localParticipantLookup(),
+          provisionedDiscoveryEntries(std::move(provisionedDiscoveryEntries))
 {
 }
 
@@ -43,6 +84,25 @@ void LocalDiscoveryAggregator::setDiscoveryProxy(std::shared_ptr<IDiscoveryAsync
     this->discoveryProxy = std::move(discoveryProxy);
 }
 
+void LocalDiscoveryAggregator::setLocalParticipantLookup(
+        std::weak_ptr<ILocalParticipantLookup> localParticipantLookup)
+{
+    this->localParticipantLookup = std::move(localParticipantLookup);
+}
+
+boost::optional<types::DiscoveryEntryWithMetaInfo> LocalDiscoveryAggregator::lookupLocally(
+        const std::string& participantId)
+{
+    auto entry = provisionedDiscoveryEntries.find(participantId);
+    if (entry != provisionedDiscoveryEntries.cend()) {
+        return entry->second;
+    }
+    if (auto localParticipantLookupSharedPtr = localParticipantLookup.lock()) {
+        return localParticipantLookupSharedPtr->lookupLocally(participantId);
+    }
+    return boost::none;
+}
+
 #define REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(FUTURE_TYPE)                            \
     if (!discoveryProxy) {                                                                         \
         const std::string errorMsg("internal discoveryProxy not set");                             \
@@ -84,6 +144,59 @@ std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::addAsync(
                                     std::move(messagingQos));
 }
 
+std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::addAsync(
+        const std::vector<types::DiscoveryEntry>& discoveryEntries,
+        const bool& awaitGlobalRegistration,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException&)> onRuntimeError,
+        boost::optional<joynr::MessagingQos> messagingQos) noexcept
+{
+    assert(discoveryProxy);
+    REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(void)
+    auto future = std::make_shared<joynr::Future<void>>();
+    auto onBatchSuccess = createOnBatchSuccess(future, std::move(onSuccess));
+    auto onBatchError = createOnBatchError(future, std::move(onRuntimeError));
+    // cluster controllers providing Discovery 0.1 do not know the batch call, the entries are
+    // added one by one then
+    auto onError = [
+        discoveryProxy = util::as_weak_ptr(discoveryProxy),
+        discoveryEntries,
+        awaitGlobalRegistration,
+        onBatchSuccess,
+        onBatchError,
+        messagingQos
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        auto discoveryProxySharedPtr = discoveryProxy.lock();
+        if (!discoveryProxySharedPtr || !isUnknownMethod(error)) {
+            onBatchError(error);
+            return;
+        }
+        JOYNR_LOG_INFO(logger(),
+                       "discovery provider does not support adding several entries with a "
+                       "single call, adding {} entries one by one",
+                       discoveryEntries.size());
+        if (discoveryEntries.empty()) {
+            onBatchSuccess();
+            return;
+        }
+        auto batch = BatchCompletion::create(discoveryEntries.size(), onBatchSuccess, onBatchError);
+        for (const types::DiscoveryEntry& discoveryEntry : discoveryEntries) {
+            discoveryProxySharedPtr->addAsync(discoveryEntry,
+                                              awaitGlobalRegistration,
+                                              batch->successCallback(batch),
+                                              batch->errorCallback(batch),
+                                              messagingQos);
+        }
+    };
+    discoveryProxy->addAsync(discoveryEntries,
+                             awaitGlobalRegistration,
+                             std::move(onBatchSuccess),
+                             std::move(onError),
+                             std::move(messagingQos));
+    return future;
+}
+
 std::shared_ptr<joynr::Future<std::vector<types::DiscoveryEntryWithMetaInfo>>>
 LocalDiscoveryAggregator::lookupAsync(
         const std::vector<std::string>& domains,
@@ -142,4 +255,53 @@ std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::removeAsync(
                                        std::move(messagingQos));
 }
 
+std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::removeAsync(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException&)> onRuntimeError,
+        boost::optional<joynr::MessagingQos> messagingQos) noexcept
+{
+    assert(discoveryProxy);
+    REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(void)
+    auto future = std::make_shared<joynr::Future<void>>();
+    auto onBatchSuccess = createOnBatchSuccess(future, std::move(onSuccess));
+    auto onBatchError = createOnBatchError(future, std::move(onRuntimeError));
+    // cluster controllers providing Discovery 0.1 do not know the batch call, the entries are
+    // removed one by one then
+    auto onError = [
+        discoveryProxy = util::as_weak_ptr(discoveryProxy),
+        participantIds,
+        onBatchSuccess,
+        onBatchError,
+        messagingQos
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        auto discoveryProxySharedPtr = discoveryProxy.lock();
+        if (!discoveryProxySharedPtr || !isUnknownMethod(error)) {
+            onBatchError(error);
+            return;
+        }
+        JOYNR_LOG_INFO(logger(),
+                       "discovery provider does not support removing several entries with a "
+                       "single call, removing {} entries one by one",
+                       participantIds.size());
+        if (participantIds.empty()) {
+            onBatchSuccess();
+            return;
+        }
+        auto batch = BatchCompletion::create(participantIds.size(), onBatchSuccess, onBatchError);
+        for (const std::string& participantId : participantIds) {
+            discoveryProxySharedPtr->removeAsync(participantId,
+                                                 batch->successCallback(batch),
+                                                 batch->errorCallback(batch),
+                                                 messagingQos);
+        }
+    };
+    discoveryProxy->removeAsync(participantIds,
+                                std::move(onBatchSuccess),
+                                std::move(onError),
+                                std::move(messagingQos));
+    return future;
+}
+
 } // namespace joynr
@@ -19,7 +19,10 @@
 #include "joynr/ParticipantIdStorage.h"
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 
+#include <boost/crc.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include <boost/format.hpp>
@@ -29,8 +32,50 @@
 namespace joynr
 {
 
+namespace
+{
+
+const char FILE_MAGIC[4] = {'J', 'P', 'I', 'S'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::size_t FILE_HEADER_SIZE = sizeof(FILE_MAGIC) + sizeof(std::uint32_t);
+constexpr std::size_t RECORD_HEADER_SIZE = 3 * sizeof(std::uint32_t);
+
+std::uint32_t checksum(const std::string& key, const std::string& participantId)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(key.data(), key.size());
+    crc.process_bytes(participantId.data(), participantId.size());
+    return crc.checksum();
+}
+
+std::uint32_t readUInt32(const char* position)
+{
+    std::uint32_t value;
+    std::memcpy(&value, position, sizeof(value));
+    return value;
+}
+
+void appendUInt32(std::string& buffer, std::uint32_t value)
+{
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string fileHeader()
+{
+    std::string header(FILE_MAGIC, sizeof(FILE_MAGIC));
+    appendUInt32(header, FORMAT_VERSION);
+    return header;
+}
+
+} // namespace
+
 ParticipantIdStorage::ParticipantIdStorage(const std::string& filename)
-        : fileMutex(), storageMutex(), storage(), entriesWrittenToDisk(0), fileName(filename)
+        : fileMutex(),
+          storageMutex(),
+          storage(),
+          entriesWrittenToDisk(0),
+          fileHasHeader(false),
+          fileName(filename)
 {
     assert(!fileName.empty());
     loadEntriesFromFile();
@@ -50,8 +95,91 @@ void ParticipantIdStorage::loadEntriesFromFile()
 
     JOYNR_LOG_TRACE(logger(), "Attempting to load ParticipantIdStorage from: {}", fileName);
 
-    boost::property_tree::ptree pt;
+    std::string content;
+    try {
+        content = joynr::util::loadStringFromFile(fileName);
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_WARN(logger(),
+                       "Cannot read participantId storage file {}. Exception: {}",
+                       fileName,
+                       ex.what());
+        return;
+    }
+
+    std::lock_guard<std::mutex> lockAccessToFile(fileMutex);
     WriteLocker lockAccessToStorage(storageMutex);
+
+    bool fileNeedsRewrite = false;
+    if (content.empty()) {
+        // an empty file gets its header with the first entry
+    } else if (content.size() >= sizeof(FILE_MAGIC) &&
+               std::equal(FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC), content.cbegin())) {
+        fileHasHeader = true;
+        fileNeedsRewrite = !loadEntriesFromBinaryFile(content);
+    } else {
+        fileNeedsRewrite = importEntriesFromIniFile();
+    }
+
+    // set entriesWrittenToDisk to the size of the storage
+    entriesWrittenToDisk = storage.get<participantIdStorageTags::write>().size();
+    if (fileNeedsRewrite) {
+        rewriteFile();
+    }
+    JOYNR_LOG_TRACE(logger(), "Loaded {} entries.", entriesWrittenToDisk);
+}
+
+bool ParticipantIdStorage::loadEntriesFromBinaryFile(const std::string& content)
+{
+    if (content.size() < FILE_HEADER_SIZE ||
+        readUInt32(content.data() + sizeof(FILE_MAGIC)) != FORMAT_VERSION) {
+        JOYNR_LOG_WARN(logger(),
+                       "Unsupported participantId storage file {}. Discarding its content.",
+                       fileName);
+        return false;
+    }
+
+    auto& writeIndex = storage.get<participantIdStorageTags::write>();
+    writeIndex.reserve((content.size() - FILE_HEADER_SIZE) / RECORD_HEADER_SIZE);
+
+    std::size_t position = FILE_HEADER_SIZE;
+    while (position < content.size()) {
+        if (content.size() - position < RECORD_HEADER_SIZE) {
+            break;
+        }
+        const std::uint32_t keySize = readUInt32(content.data() + position);
+        const std::uint32_t participantIdSize =
+                readUInt32(content.data() + position + sizeof(std::uint32_t));
+        const std::uint32_t crc = readUInt32(content.data() + position + 2 * sizeof(std::uint32_t));
+        const std::size_t payloadPosition = position + RECORD_HEADER_SIZE;
+        if (content.size() - payloadPosition <
+            static_cast<std::size_t>(keySize) + participantIdSize) {
+            break;
+        }
+        std::string key = content.substr(payloadPosition, keySize);
+        std::string participantId = content.substr(payloadPosition + keySize, participantIdSize);
+        if (checksum(key, participantId) != crc) {
+            break;
+        }
+        storage.insert(StorageItem{std::move(key), std::move(participantId)});
+        position = payloadPosition + keySize + participantIdSize;
+    }
+
+    if (position != content.size()) {
+        // a record was only partially written, e.g. because the process died while appending
+        JOYNR_LOG_WARN(logger(),
+                       "Discarding {} corrupt bytes at the end of participantId storage file {}.",
+                       content.size() - position,
+                       fileName);
+        return false;
+    }
+    return true;
+}
+
+bool ParticipantIdStorage::importEntriesFromIniFile()
+{
+    JOYNR_LOG_INFO(logger(), "Importing participantId storage file {} in INI format.", fileName);
+
+    boost::property_tree::ptree pt;
     try {
         boost::property_tree::ini_parser::read_ini(fileName, pt);
         for (boost::property_tree::ptree::const_iterator it = pt.begin(); it != pt.end(); ++it) {
@@ -64,12 +192,46 @@ void ParticipantIdStorage::loadEntriesFromFile()
                        "Cannot read participantId storage file {}. Removing file. Exception: {}",
                        fileName,
                        ex.what());
+        storage.clear();
         std::remove(fileName.c_str());
+        return false;
     }
+    return true;
+}
 
-    // set entriesWrittenToDisk to the size of the storage
-    entriesWrittenToDisk = storage.get<participantIdStorageTags::write>().size();
-    JOYNR_LOG_TRACE(logger(), "Loaded {} entries.", entriesWrittenToDisk);
+void ParticipantIdStorage::rewriteFile()
+{
+    std::string content = fileHeader();
+    for (const StorageItem& item : storage.get<participantIdStorageTags::write>()) {
+        appendRecord(content, item);
+    }
+
+    const std::string tmpFileName = fileName + ".tmp";
+    try {
+        joynr::util::saveStringToFile(tmpFileName, content);
+        if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+            throw std::runtime_error("rename failed");
+        }
+        fileHasHeader = true;
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(),
+                        "Cannot rewrite participantId storage file {}. Exception: {}",
+                        fileName,
+                        ex.what());
+        std::remove(tmpFileName.c_str());
+        std::remove(fileName.c_str());
+        fileHasHeader = false;
+        entriesWrittenToDisk = 0;
+    }
+}
+
+void ParticipantIdStorage::appendRecord(std::string& buffer, const StorageItem& item)
+{
+    appendUInt32(buffer, static_cast<std::uint32_t>(item.key.size()));
+    appendUInt32(buffer, static_cast<std::uint32_t>(item.participantId.size()));
+    appendUInt32(buffer, checksum(item.key, item.participantId));
+    buffer.append(item.key);
+    buffer.append(item.participantId);
 }
 
 void ParticipantIdStorage::setProviderParticipantId(const std::string& domain,
@@ -111,63 +273,57 @@ std::string ParticipantIdStorage::getProviderParticipantId(const std::string& do
     assert(!interfaceName.empty());
 
     const std::string providerKey = createProviderKey(domain, interfaceName, majorVersion);
-    MultiIndexContainer::const_iterator value;
 
     {
         ReadLocker lockAccessToStorage(storageMutex);
-        value = storage.template get<participantIdStorageTags::read>().find(providerKey);
+        const auto& readIndex = storage.get<participantIdStorageTags::read>();
+        auto value = readIndex.find(providerKey);
+        if (value != readIndex.cend()) {
+            return value->participantId;
+        }
     }
 
-    if (value != storage.cend()) {
-        return value->participantId;
-    } else {
-        return (!defaultValue.empty()) ? defaultValue : util::createUuid();
-    }
+    return (!defaultValue.empty()) ? defaultValue : util::createUuid();
 }
 
 void ParticipantIdStorage::writeStoreToFile()
 {
     std::lock_guard<std::mutex> lockAccessToFile(fileMutex);
-    WriteLocker lockAccessToStorage(storageMutex);
 
-    auto& writeIndex = storage.get<participantIdStorageTags::write>();
-    const size_t entries = writeIndex.size();
+    // collect the records of all entries which are not yet on disk, the file itself is written
+    // without blocking readers of the storage
+    std::string records;
+    size_t entries;
+    {
+        ReadLocker lockAccessToStorage(storageMutex);
+        auto& writeIndex = storage.get<participantIdStorageTags::write>();
+        entries = writeIndex.size();
+        for (size_t i = entriesWrittenToDisk; i < entries; ++i) {
+            appendRecord(records, writeIndex[i]);
+        }
+    }
 
-    // The storage in memory is supposed to contain at least one entry at this point.
-    if (entries == 0) {
-        assert(entriesWrittenToDisk == 0);
+    if (entries <= entriesWrittenToDisk) {
         return;
     }
 
-    if (entries > entriesWrittenToDisk) {
-        JOYNR_LOG_TRACE(
-                logger(), "Writing {} new entries to file.", entries - entriesWrittenToDisk);
-
-        // write not present entries to File
-        size_t writtenToDisk = 0;
-        for (size_t i = entriesWrittenToDisk; i < entries; ++i, ++writtenToDisk) {
-            auto entry = writeIndex[i];
-            try {
-                joynr::util::appendStringToFile(fileName, entry.toIniForm());
-            } catch (const std::runtime_error& ex) {
-                JOYNR_LOG_ERROR(logger(),
-                                "Cannot save ParticipantId to file. Next application lifecycle "
-                                "might not function correctly. Exception: ",
-                                ex.what());
-                entriesWrittenToDisk += writtenToDisk;
-                return;
-            }
+    JOYNR_LOG_TRACE(logger(), "Writing {} new entries to file.", entries - entriesWrittenToDisk);
+    try {
+        if (fileHasHeader) {
+            joynr::util::appendStringToFile(fileName, records);
+        } else {
+            joynr::util::saveStringToFile(fileName, fileHeader() + records);
+            fileHasHeader = true;
         }
-        assert(entries == entriesWrittenToDisk + writtenToDisk);
-        entriesWrittenToDisk = entries;
-        JOYNR_LOG_TRACE(logger(), "Storage on file contains now {} entries.", entriesWrittenToDisk);
-    } else if (entries < entriesWrittenToDisk) {
-        // This actually means that someone modified the file and inserted other entries.
-        // Do nothing.
-    } else {
-        // In this case the number of entries written to disk matches those in the store.
-        // Do nothing.
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(),
+                        "Cannot save ParticipantId to file. Next application lifecycle "
+                        "might not function correctly. Exception: {}",
+                        ex.what());
+        return;
     }
+    entriesWrittenToDisk = entries;
+    JOYNR_LOG_TRACE(logger(), "Storage on file contains now {} entries.", entriesWrittenToDisk);
 }
 
 std::string ParticipantIdStorage::createProviderKey(const std::string& domain,
@@ -59,5 +59,22 @@ std::vector<types::DiscoveryEntryWithMetaInfo> convert(
     return result;
 }
 
+std::vector<types::DiscoveryEntryWithMetaInfo> convert(
+        bool isLocal,
+        const std::vector<std::shared_ptr<const types::DiscoveryEntry>>& entries)
+{
+    std::vector<types::DiscoveryEntryWithMetaInfo> result;
+    result.reserve(entries.size());
+
+    std::transform(entries.begin(),
+                   entries.end(),
+                   std::back_inserter(result),
+                   [isLocal](const std::shared_ptr<const types::DiscoveryEntry>& entry) {
+                       return convert(isLocal, *entry);
+                   });
+
+    return result;
+}
+
 } // namespace util
 } // namespace joynr
@@ -23,7 +23,8 @@
 namespace joynr
 {
 
-MessagingStubFactory::MessagingStubFactory() : address2MessagingStubMap(), factoryList(), mutex()
+MessagingStubFactory::MessagingStubFactory()
+        : address2MessagingStubMap(), factoryList(), mutex(), generation(1)
 {
 }
 
@@ -53,9 +54,27 @@ void MessagingStubFactory::remove(
 {
     if (contains(destinationAddress)) {
         address2MessagingStubMap.remove(destinationAddress);
+        ++generation;
     }
 }
 
+std::shared_ptr<IMessagingStub> MessagingStubFactory::createCached(
+        const std::shared_ptr<const joynr::system::RoutingTypes::Address>& destinationAddress,
+        CachedMessagingStub& cachedStub)
+{
+    // read the generation before resolving the stub, a stub removed in the meantime is then
+    // cached with an outdated generation
+    const std::uint64_t currentGeneration = generation;
+    std::shared_ptr<IMessagingStub> stub = cachedStub.get(currentGeneration);
+    if (!stub) {
+        stub = create(destinationAddress);
+        if (stub) {
+            cachedStub.set(stub, currentGeneration);
+        }
+    }
+    return stub;
+}
+
 bool MessagingStubFactory::contains(
         const std::shared_ptr<const joynr::system::RoutingTypes::Address>& destinationAddress)
 {
@@ -18,13 +18,26 @@
  */
 #include "joynr/BlockingQueue.h"
 
+#include <cassert>
+
 #include "joynr/Runnable.h"
 
 namespace joynr
 {
 
-BlockingQueue::BlockingQueue() : stoppingScheduler(false), queue(), condition(), conditionMutex()
+BlockingQueue::BlockingQueue(std::uint32_t maxBypassCount)
+        : stoppingScheduler(false),
+          queues(),
+          bypassCounts(),
+          oldestTaskBypassCounts(),
+          nextSequenceNumber(0),
+          queueLength(0),
+          maxBypassCount(maxBypassCount),
+          condition(),
+          conditionMutex()
 {
+    bypassCounts.fill(0);
+    oldestTaskBypassCounts.fill(0);
 }
 
 BlockingQueue::~BlockingQueue()
@@ -34,9 +47,12 @@ BlockingQueue::~BlockingQueue()
 
 void BlockingQueue::add(std::shared_ptr<Runnable> work)
 {
+    const std::size_t priorityClass = SchedulingPriority::toIndex(work->getPriority());
+    const TimePoint deadline = work->getDeadline();
     {
         std::lock_guard<std::mutex> lock(conditionMutex);
-        queue.push_front(std::move(work));
+        queues[priorityClass].insert(QueueEntry{deadline, nextSequenceNumber++, std::move(work)});
+        ++queueLength;
     }
 
     // Notify a waiting thread
@@ -53,9 +69,9 @@ std::shared_ptr<Runnable> BlockingQueue::take()
     std::unique_lock<std::mutex> lock(
             conditionMutex); // std::condition_variable works only with unique_lock
 
-    JOYNR_LOG_TRACE(logger(), "Wait for condition (queuelen={})", queue.size());
+    JOYNR_LOG_TRACE(logger(), "Wait for condition (queuelen={})", queueLength);
     // Wait for work or shutdown
-    condition.wait(lock, [this] { return (stoppingScheduler || !queue.empty()); });
+    condition.wait(lock, [this] { return (stoppingScheduler || queueLength > 0); });
     if (stoppingScheduler) {
         JOYNR_LOG_TRACE(logger(), "Shutting down and returning NULL");
         return nullptr;
@@ -64,15 +80,68 @@ std::shared_ptr<Runnable> BlockingQueue::take()
     JOYNR_LOG_TRACE(logger(), "Condition released");
 
     // Get the item
-    std::shared_ptr<Runnable> item = queue.back();
-    queue.pop_back();
+    std::shared_ptr<Runnable> item = takeFrom(selectPriorityClass());
+    --queueLength;
     return item;
 }
 
+std::shared_ptr<Runnable> BlockingQueue::takeFrom(std::size_t priorityClass)
+{
+    PriorityClassQueue& queue = queues[priorityClass];
+    auto& deadlineIndex = queue.get<Deadline>();
+    auto& sequenceIndex = queue.get<Sequence>();
+    auto oldest = sequenceIndex.begin();
+    std::uint32_t& oldestTaskBypassCount = oldestTaskBypassCounts[priorityClass];
+
+    std::shared_ptr<Runnable> item;
+    if (oldestTaskBypassCount >= maxBypassCount ||
+        deadlineIndex.begin()->sequenceNumber == oldest->sequenceNumber) {
+        // the oldest task has been passed over too often or has the earliest deadline anyway
+        oldestTaskBypassCount = 0;
+        item = oldest->task;
+        sequenceIndex.erase(oldest);
+    } else {
+        ++oldestTaskBypassCount;
+        auto first = deadlineIndex.begin();
+        item = first->task;
+        deadlineIndex.erase(first);
+    }
+    return item;
+}
+
+std::size_t BlockingQueue::selectPriorityClass()
+{
+    std::size_t selected = queues.size();
+    // a class which has been passed over too often is served first
+    for (std::size_t i = 0; i < queues.size(); ++i) {
+        if (!queues[i].empty() && bypassCounts[i] >= maxBypassCount) {
+            selected = i;
+            break;
+        }
+    }
+    if (selected == queues.size()) {
+        for (std::size_t i = 0; i < queues.size(); ++i) {
+            if (!queues[i].empty()) {
+                selected = i;
+                break;
+            }
+        }
+    }
+    assert(selected < queues.size());
+
+    bypassCounts[selected] = 0;
+    for (std::size_t i = selected + 1; i < queues.size(); ++i) {
+        if (!queues[i].empty()) {
+            ++bypassCounts[i];
+        }
+    }
+    return selected;
+}
+
 int BlockingQueue::getQueueLength() const
 {
     std::lock_guard<std::mutex> lock(conditionMutex);
-    return queue.size();
+    return queueLength;
 }
 
 void BlockingQueue::shutdown()
@@ -88,7 +157,10 @@ void BlockingQueue::shutdown()
         //    delete i;
         //}
         //}
-        queue.clear();
+        for (auto& queue : queues) {
+            queue.clear();
+        }
+        queueLength = 0;
     }
 
     // unblock waiting threads
@@ -0,0 +1,130 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/DistributedReadWriteLock.h"
+
+namespace joynr
+{
+
+constexpr std::size_t DistributedReadWriteLock::NUMBER_OF_SLOTS;
+constexpr std::size_t DistributedReadWriteLock::CACHE_LINE_SIZE;
+
+DistributedReadWriteLock::DistributedReadWriteLock()
+        : slots(),
+          isWriterActive(false),
+          writerMutex(),
+          readersDrainedMutex(),
+          readersDrained()
+{
+    for (ReaderSlot& slot : slots) {
+        slot.readers = 0;
+    }
+}
+
+std::size_t DistributedReadWriteLock::getSlotIndex()
+{
+    // threads are assigned to the slots round robin when they take their first read lock
+    static std::atomic<std::size_t> nextSlotIndex(0);
+    thread_local const std::size_t slotIndex = nextSlotIndex++ % NUMBER_OF_SLOTS;
+    return slotIndex;
+}
+
+bool DistributedReadWriteLock::hasReaders() const
+{
+    for (const ReaderSlot& slot : slots) {
+        if (slot.readers.load() != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DistributedReadWriteLock::lock()
+{
+    writerMutex.lock();
+    isWriterActive = true;
+    if (hasReaders()) {
+        std::unique_lock<std::mutex> lock(readersDrainedMutex);
+        readersDrained.wait(lock, [this]() { return !hasReaders(); });
+    }
+}
+
+bool DistributedReadWriteLock::try_lock()
+{
+    if (!writerMutex.try_lock()) {
+        return false;
+    }
+    isWriterActive = true;
+    if (hasReaders()) {
+        isWriterActive = false;
+        writerMutex.unlock();
+        return false;
+    }
+    return true;
+}
+
+void DistributedReadWriteLock::unlock()
+{
+    isWriterActive = false;
+    writerMutex.unlock();
+}
+
+void DistributedReadWriteLock::lock_shared()
+{
+    std::atomic<std::uint32_t>& readers = slots[getSlotIndex()].readers;
+    while (true) {
+        // sequentially consistent so that either the writer sees this reader or the reader sees
+        // the writer
+        readers++;
+        if (!isWriterActive) {
+            return;
+        }
+        releaseSlot(readers);
+        // the writer holds the mutex until it unlocks
+        std::lock_guard<std::mutex> waitForWriter(writerMutex);
+    }
+}
+
+bool DistributedReadWriteLock::try_lock_shared()
+{
+    std::atomic<std::uint32_t>& readers = slots[getSlotIndex()].readers;
+    readers++;
+    if (!isWriterActive) {
+        return true;
+    }
+    releaseSlot(readers);
+    return false;
+}
+
+void DistributedReadWriteLock::unlock_shared()
+{
+    releaseSlot(slots[getSlotIndex()].readers);
+}
+
+void DistributedReadWriteLock::releaseSlot(std::atomic<std::uint32_t>& readers)
+{
+    // either the writer sees the decremented counter when checking for readers or this thread
+    // sees the active writer; notifying under the mutex keeps the wakeup from getting lost
+    // between the writer's check and its wait
+    if (--readers == 0 && isWriterActive) {
+        std::lock_guard<std::mutex> lock(readersDrainedMutex);
+        readersDrained.notify_one();
+    }
+}
+
+} // namespace joynr
@@ -25,4 +25,14 @@ Runnable::Runnable() : enable_shared_from_this<Runnable>()
 {
 }
 
+SchedulingPriority::Enum Runnable::getPriority() const
+{
+    return SchedulingPriority::Enum::NORMAL;
+}
+
+TimePoint Runnable::getDeadline() const
+{
+    return TimePoint::max();
+}
+
 } // namespace joynr
@@ -0,0 +1,95 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/ShutdownGuard.h"
+
+#include <mutex>
+
+namespace joynr
+{
+
+ShutdownGuard::Pass::Pass() : guard(nullptr)
+{
+}
+
+ShutdownGuard::Pass::Pass(ShutdownGuard* guard) : guard(guard)
+{
+}
+
+ShutdownGuard::Pass::Pass(Pass&& other) noexcept : guard(other.guard)
+{
+    other.guard = nullptr;
+}
+
+ShutdownGuard::Pass& ShutdownGuard::Pass::operator=(Pass&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        guard = other.guard;
+        other.guard = nullptr;
+    }
+    return *this;
+}
+
+ShutdownGuard::Pass::~Pass()
+{
+    release();
+}
+
+ShutdownGuard::Pass::operator bool() const
+{
+    return guard != nullptr;
+}
+
+void ShutdownGuard::Pass::release()
+{
+    if (guard) {
+        guard->lock.unlock_shared();
+        guard = nullptr;
+    }
+}
+
+ShutdownGuard::ShutdownGuard() : lock(), shutDown(false)
+{
+}
+
+ShutdownGuard::Pass ShutdownGuard::enter()
+{
+    if (shutDown) {
+        return Pass();
+    }
+    lock.lock_shared();
+    if (shutDown) {
+        lock.unlock_shared();
+        return Pass();
+    }
+    return Pass(this);
+}
+
+void ShutdownGuard::shutdown()
+{
+    std::lock_guard<DistributedReadWriteLock> waitForPasses(lock);
+    shutDown = true;
+}
+
+bool ShutdownGuard::isShutDown() const
+{
+    return shutDown;
+}
+
+} // namespace joynr
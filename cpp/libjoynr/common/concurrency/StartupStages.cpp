@@ -0,0 +1,196 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/StartupStages.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+StartupStages::StartupStages(std::string name, std::size_t maxParallelStages)
+        : name(std::move(name)),
+          maxParallelStages(std::max<std::size_t>(maxParallelStages, 1)),
+          stages(),
+          stageDurations(),
+          hasRun(false)
+{
+}
+
+std::size_t StartupStages::getDefaultMaxParallelStages()
+{
+    // loading files and connecting transports mostly waits, so do not stop at a single core
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 4);
+}
+
+void StartupStages::add(std::string stageName,
+                        std::vector<std::string> dependencies,
+                        Stage stage)
+{
+    auto findStage = [this](const std::string& nameToFind) {
+        return std::find_if(stages.begin(), stages.end(), [&nameToFind](const StageNode& node) {
+            return node.name == nameToFind;
+        });
+    };
+    if (findStage(stageName) != stages.end()) {
+        throw exceptions::JoynrRuntimeException(name + ": duplicate startup stage " + stageName);
+    }
+    const std::size_t index = stages.size();
+    for (const std::string& dependency : dependencies) {
+        auto dependencyNode = findStage(dependency);
+        if (dependencyNode == stages.end()) {
+            throw exceptions::JoynrRuntimeException(name + ": startup stage " + stageName +
+                                                    " depends on unknown stage " + dependency);
+        }
+        dependencyNode->dependents.push_back(index);
+    }
+    // dependencies are known before their dependents, hence the graph has no cycles
+    stages.push_back(StageNode{std::move(stageName), {}, dependencies.size(), std::move(stage)});
+}
+
+void StartupStages::run()
+{
+    if (hasRun) {
+        throw exceptions::JoynrRuntimeException(name + ": startup stages can only be run once");
+    }
+    hasRun = true;
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+
+    std::mutex mutex;
+    std::condition_variable stageFinished;
+    std::deque<std::size_t> readyStages;
+    std::deque<std::pair<std::size_t, std::thread>> runningStages;
+    std::vector<std::size_t> finishedStages;
+    std::vector<bool> isFailed(stages.size(), false);
+    std::exception_ptr firstError;
+    std::size_t numberOfCompletedStages = 0;
+
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+        if (stages[i].pendingDependencies == 0) {
+            readyStages.push_back(i);
+        }
+    }
+
+    auto runStage = [&](std::size_t index) {
+        const Clock::time_point stageStart = Clock::now();
+        std::exception_ptr error;
+        try {
+            stages[index].stage();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        const auto duration =
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - stageStart);
+        std::lock_guard<std::mutex> stageLock(mutex);
+        if (error) {
+            isFailed[index] = true;
+            if (!firstError) {
+                firstError = error;
+            }
+        }
+        stageDurations.emplace_back(stages[index].name, duration);
+        finishedStages.push_back(index);
+        stageFinished.notify_one();
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (numberOfCompletedStages < stages.size()) {
+        while (!readyStages.empty() && runningStages.size() < maxParallelStages) {
+            const std::size_t index = readyStages.front();
+            readyStages.pop_front();
+            runningStages.emplace_back(index, std::thread(runStage, index));
+        }
+
+        stageFinished.wait(lock, [&finishedStages]() { return !finishedStages.empty(); });
+
+        std::vector<std::size_t> justFinished;
+        justFinished.swap(finishedStages);
+        for (std::size_t index : justFinished) {
+            auto running = std::find_if(
+                    runningStages.begin(),
+                    runningStages.end(),
+                    [index](const std::pair<std::size_t, std::thread>& runningStage) {
+                        return runningStage.first == index;
+                    });
+            std::thread stageThread = std::move(running->second);
+            runningStages.erase(running);
+            lock.unlock();
+            stageThread.join();
+            lock.lock();
+
+            // a failed stage is skipped together with all stages depending on it
+            std::vector<std::size_t> completed{index};
+            while (!completed.empty()) {
+                const std::size_t completedIndex = completed.back();
+                completed.pop_back();
+                ++numberOfCompletedStages;
+                for (std::size_t dependent : stages[completedIndex].dependents) {
+                    if (isFailed[completedIndex]) {
+                        if (!isFailed[dependent]) {
+                            isFailed[dependent] = true;
+                            JOYNR_LOG_ERROR(logger(),
+                                            "{}: skipping startup stage {} after {} failed",
+                                            name,
+                                            stages[dependent].name,
+                                            stages[completedIndex].name);
+                            completed.push_back(dependent);
+                        }
+                    } else if (--stages[dependent].pendingDependencies == 0 &&
+                               !isFailed[dependent]) {
+                        readyStages.push_back(dependent);
+                    }
+                }
+            }
+        }
+    }
+    lock.unlock();
+
+    for (const auto& stageDuration : stageDurations) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "{}: startup stage {} took {} us",
+                        name,
+                        stageDuration.first,
+                        stageDuration.second.count());
+    }
+    JOYNR_LOG_INFO(logger(),
+                   "{}: {} startup stages took {} ms",
+                   name,
+                   stages.size(),
+                   std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start)
+                           .count());
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+const StartupStages::StageDurations& StartupStages::getStageDurations() const
+{
+    return stageDurations;
+}
+
+} // namespace joynr
@@ -22,6 +22,7 @@
 #include <functional>
 #include <set>
 
+#include "joynr/BackPressureController.h"
 #include "joynr/Runnable.h"
 
 namespace joynr
@@ -114,6 +115,7 @@ void ThreadPool::execute(std::shared_ptr<Runnable> runnable)
 void ThreadPool::threadLifecycle(std::shared_ptr<ThreadPool> thisSharedPtr)
 {
     JOYNR_LOG_TRACE(logger(), "Thread enters lifecycle");
+    BackPressureController::markCurrentThreadAsInternal();
 
     while (thisSharedPtr->keepRunning) {
 
@@ -25,7 +25,9 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "joynr/IMessageRouter.h"
 #include "joynr/JoynrExport.h"
@@ -60,6 +62,7 @@ template <typename T>
 class MessageQueue;
 class ITransportStatus;
 
+class BackPressureController;
 class IMessagingStub;
 class IMessagingStubFactory;
 class ImmutableMessage;
@@ -86,13 +89,24 @@ public:
     virtual void setToKnown(const std::string& participantId) override;
 
     virtual void init();
-    void saveRoutingTable();
+    /**
+     * @brief persists the routing table if persistency is enabled
+     * @return false if the routing table could not be written
+     */
+    bool saveRoutingTable();
     void loadRoutingTable(std::string fileName);
     std::uint64_t getNumberOfRoutedMessages() const;
 
     void route(std::shared_ptr<ImmutableMessage> message, std::uint32_t tryCount = 0) final;
     virtual void shutdown();
 
+    /**
+     * @brief Sets the controller which accounts all messages held by this router.
+     * Messages which have not been accounted by a transport skeleton yet are accounted
+     * without a client id when they are routed.
+     */
+    void setBackPressureController(std::shared_ptr<BackPressureController> backPressureController);
+
     friend class MessageRunnable;
     friend class ConsumerPermissionCallback;
 
@@ -116,10 +130,12 @@ protected:
         }
     };
 
-    // use specialized set with custom comparator to prevent duplicate insertion
+    // maps destination addresses to the messaging stub cached on their routing entry (nullptr
+    // if there is none), uses a custom comparator to prevent duplicate insertion
     // of elements with logically equivalent content
-    using AddressUnorderedSet =
-            std::unordered_set<std::shared_ptr<const joynr::system::RoutingTypes::Address>,
+    using AddressUnorderedMap =
+            std::unordered_map<std::shared_ptr<const joynr::system::RoutingTypes::Address>,
+                               std::shared_ptr<CachedMessagingStub>,
                                AddressHash,
                                AddressEqual>;
 
@@ -135,7 +151,7 @@ protected:
                                   transportNotAvailableQueue);
 
     virtual bool publishToGlobal(const ImmutableMessage& message) = 0;
-    AddressUnorderedSet getDestinationAddresses(const ImmutableMessage& message,
+    AddressUnorderedMap getDestinationAddresses(const ImmutableMessage& message,
                                                 const ReadLocker& messageQueueRetryReadLock);
 
     void registerGlobalRoutingEntryIfRequired(const ImmutableMessage& message);
@@ -162,15 +178,31 @@ protected:
                            const std::int64_t expiryDateMs,
                            const bool isSticky);
 
+    /*
+     * Adds the entries of all participantIds and persists the routing table once.
+     * Returns false if the routing table could not be persisted.
+     */
+    bool addToRoutingTable(const std::vector<std::string>& participantIds,
+                           bool isGloballyVisible,
+                           std::shared_ptr<const joynr::system::RoutingTypes::Address> address,
+                           const std::int64_t expiryDateMs,
+                           const bool isSticky);
+
     virtual void doAccessControlCheckOrScheduleMessage(
             std::shared_ptr<ImmutableMessage> message,
             std::shared_ptr<const system::RoutingTypes::Address> destAddress,
-            std::uint32_t tryCount = 0);
+            std::uint32_t tryCount = 0,
+            std::shared_ptr<CachedMessagingStub> cachedStub = nullptr);
 
+    /*
+     * If cachedStub is set, the messaging stub is taken from it as long as it is valid
+     * instead of being looked up by the destination address.
+     */
     void scheduleMessage(std::shared_ptr<ImmutableMessage> message,
                          std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress,
                          std::uint32_t tryCount = 0,
-                         std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+                         std::chrono::milliseconds delay = std::chrono::milliseconds(0),
+                         std::shared_ptr<CachedMessagingStub> cachedStub = nullptr);
 
     void activateMessageCleanerTimer();
     void activateRoutingTableCleanerTimer();
@@ -222,13 +254,21 @@ protected:
     const std::chrono::milliseconds messageQueueCleanerTimerPeriodMs;
     SteadyTimer routingTableCleanerTimer;
     std::vector<std::shared_ptr<ITransportStatus>> transportStatuses;
+    std::shared_ptr<BackPressureController> backPressureController;
 
 private:
     DISALLOW_COPY_AND_ASSIGN(AbstractMessageRouter);
     ADD_LOGGER(AbstractMessageRouter)
 
     void checkExpiryDate(const ImmutableMessage& message);
-    AddressUnorderedSet lookupAddresses(const std::unordered_set<std::string>& participantIds);
+    AddressUnorderedMap lookupAddresses(const std::unordered_set<std::string>& participantIds);
+    // requires routingTableLock to be held for writing
+    void addToRoutingTableLocked(
+            std::string participantId,
+            bool isGloballyVisible,
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+            std::int64_t expiryDateMs,
+            bool isSticky);
     std::atomic<bool> isShuttingDown;
     std::atomic<std::uint64_t> numberOfRoutedMessages;
     const std::uint64_t maxAclRetryIntervalMs;
@@ -247,6 +287,8 @@ public:
                     std::uint32_t tryCount);
     void shutdown() override;
     void run() override;
+    SchedulingPriority::Enum getPriority() const override;
+    TimePoint getDeadline() const override;
 
 private:
     std::shared_ptr<ImmutableMessage> message;
@@ -0,0 +1,178 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#ifndef BACKPRESSURECONTROLLER_H
+#define BACKPRESSURECONTROLLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief What a producer experiences when the router is saturated
+ */
+struct BackPressurePolicy
+{
+    enum class Enum {
+        /*! back-pressure is not signalled */
+        DISABLED = 0,
+        /*! the sending thread blocks until the router has drained or a timeout elapses;
+            internal threads of the runtime fail immediately instead */
+        BLOCK = 1,
+        /*! sending fails immediately with a JoynrMessageNotSentException */
+        FAIL_FAST = 2,
+        /*! sending is not delayed; producers query the state and register ready callbacks */
+        NOTIFY = 3
+    };
+
+    static std::string getLiteral(const BackPressurePolicy::Enum& value);
+    static BackPressurePolicy::Enum getEnum(const std::string& policyString);
+};
+
+class BackPressureController;
+
+/**
+ * @brief Accounts the size of one message for as long as the router holds on to it.
+ *
+ * The reservation is attached to the message and released when the last reference to the
+ * message is gone, i.e. after it was transmitted, expired or was discarded.
+ */
+class JOYNR_EXPORT BackPressureReservation
+{
+public:
+    BackPressureReservation(std::weak_ptr<BackPressureController> controller,
+                            std::string clientId,
+                            std::uint64_t bytes);
+    ~BackPressureReservation();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BackPressureReservation);
+    std::weak_ptr<BackPressureController> controller;
+    const std::string clientId;
+    const std::uint64_t bytes;
+};
+
+/**
+ * @brief Tracks the bytes held by the message router and signals back-pressure to producers.
+ *
+ * The router is saturated once the pending bytes reach the high watermark and stays saturated
+ * until they drop to the low watermark again; a low watermark of 0 or above the high watermark
+ * defaults to three quarters of the high watermark. Independently of saturation, every client may
+ * hold at most perClientQuotaBytes in the router, so that a single misbehaving client cannot
+ * exhaust the memory shared by all clients. A limit of 0 disables the respective check.
+ *
+ * Bytes are released when the last reference to a message is dropped, which can happen on any
+ * thread and while locks of the caller are held. Ready callbacks are therefore posted to the
+ * given io_service instead of being invoked by the releasing thread.
+ */
+class JOYNR_EXPORT BackPressureController
+        : public std::enable_shared_from_this<BackPressureController>
+{
+public:
+    BackPressureController(BackPressurePolicy::Enum policy,
+                           std::uint64_t highWatermarkBytes,
+                           std::uint64_t lowWatermarkBytes,
+                           std::chrono::milliseconds maxBlockingTime,
+                           boost::asio::io_service& ioService,
+                           std::uint64_t perClientQuotaBytes = 0);
+
+    ~BackPressureController() = default;
+
+    /**
+     * @brief Accounts bytes on behalf of a client.
+     * @param clientId the client the message originates from; empty for local producers,
+     *        which are not subject to the per client quota
+     * @param bytes size of the message
+     * @return the reservation to be kept alive as long as the message is held, or nullptr if
+     *         the quota of the client would be exceeded
+     */
+    std::shared_ptr<BackPressureReservation> reserve(const std::string& clientId,
+                                                     std::uint64_t bytes);
+
+    /**
+     * @brief Applies the configured policy before a producer sends a new message.
+     *
+     * Returns immediately if not saturated or for policies DISABLED and NOTIFY.
+     * @throw exceptions::JoynrMessageNotSentException for policy FAIL_FAST, or for policy
+     *        BLOCK if the router did not drain within maxBlockingTime or the calling thread
+     *        is an internal thread, which might be needed to drain the router
+     */
+    void admit();
+
+    /**
+     * @brief Marks the calling thread as an internal thread of the runtime, which must never be
+     * blocked by admit(). Called by the io_service and thread pool threads when they start.
+     */
+    static void markCurrentThreadAsInternal();
+
+    bool isSaturated() const;
+
+    /**
+     * @brief Calls the callback once the router is no longer saturated.
+     * The callback is invoked immediately if it is not saturated right now, otherwise it is
+     * posted to the io_service once the router has drained.
+     */
+    void notifyWhenReady(std::function<void()> callback);
+
+    std::uint64_t getPendingBytes() const;
+    std::uint64_t getPendingBytes(const std::string& clientId) const;
+
+    BackPressurePolicy::Enum getPolicy() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BackPressureController);
+    friend class BackPressureReservation;
+
+    void release(const std::string& clientId, std::uint64_t bytes);
+
+    const BackPressurePolicy::Enum policy;
+    const std::uint64_t highWatermarkBytes;
+    const std::uint64_t lowWatermarkBytes;
+    const std::chrono::milliseconds maxBlockingTime;
+    const std::uint64_t perClientQuotaBytes;
+    boost::asio::io_service& ioService;
+
+    mutable std::mutex mutex;
+    std::condition_variable drained;
+    std::uint64_t pendingBytes;
+    std::unordered_map<std::string, std::uint64_t> pendingBytesPerClient;
+    bool saturated;
+    std::vector<std::function<void()>> readyCallbacks;
+
+    ADD_LOGGER(BackPressureController)
+};
+
+} // namespace joynr
+
+#endif // BACKPRESSURECONTROLLER_H
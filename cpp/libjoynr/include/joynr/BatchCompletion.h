@@ -0,0 +1,88 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef BATCHCOMPLETION_H
+#define BATCHCOMPLETION_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+/**
+ * Collects the results of the single calls a batch consists of: onSuccess is called after the
+ * last call succeeded, onError once for the first failure.
+ */
+class BatchCompletion
+{
+public:
+    using OnError = std::function<void(const exceptions::JoynrRuntimeException&)>;
+
+    static std::shared_ptr<BatchCompletion> create(std::size_t count,
+                                                   std::function<void()> onSuccess,
+                                                   OnError onError)
+    {
+        return std::make_shared<BatchCompletion>(count, std::move(onSuccess), std::move(onError));
+    }
+
+    BatchCompletion(std::size_t count, std::function<void()> onSuccess, OnError onError)
+            : pending(count),
+              failed(false),
+              onSuccess(std::move(onSuccess)),
+              onError(std::move(onError))
+    {
+    }
+
+    void succeeded()
+    {
+        if (--pending == 0 && !failed && onSuccess) {
+            onSuccess();
+        }
+    }
+
+    void fail(const exceptions::JoynrRuntimeException& error)
+    {
+        if (!failed.exchange(true) && onError) {
+            onError(error);
+        }
+    }
+
+    std::function<void()> successCallback(const std::shared_ptr<BatchCompletion>& self)
+    {
+        return [self]() { self->succeeded(); };
+    }
+
+    OnError errorCallback(const std::shared_ptr<BatchCompletion>& self)
+    {
+        return [self](const exceptions::JoynrRuntimeException& error) { self->fail(error); };
+    }
+
+private:
+    std::atomic<std::size_t> pending;
+    std::atomic<bool> failed;
+    std::function<void()> onSuccess;
+    OnError onError;
+};
+
+} // namespace joynr
+#endif // BATCHCOMPLETION_H
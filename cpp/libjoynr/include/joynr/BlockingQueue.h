@@ -19,14 +19,23 @@
 #ifndef BLOCKINGQUEUE_H
 #define BLOCKINGQUEUE_H
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
 #include "joynr/JoynrExport.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
+#include "joynr/SchedulingPriority.h"
+#include "joynr/TimePoint.h"
 
 namespace joynr
 {
@@ -37,17 +46,32 @@ class Runnable;
  * @class BlockingQueue
  * @brief A thread safe queue for submitting tasks
  *
- * This class provides a FIFO queue to add and take tasks of type
+ * This class provides a queue to add and take tasks of type
  * @ref Runnable. In case of an empty queue, calling @ref take will
  * block until a task is available.
+ *
+ * Tasks are taken by priority class (@ref Runnable::getPriority) and
+ * earliest deadline first within a class (@ref Runnable::getDeadline).
+ * Tasks with equal priority and deadline are taken in FIFO order.
+ * A non-empty class which has been passed over maxBypassCount times in a row
+ * is served next, so that lower priorities do not starve. Likewise the oldest
+ * task of a class is taken once tasks with earlier deadlines have been taken
+ * before it maxBypassCount times in a row, so that tasks without or with a far
+ * deadline do not starve within their class.
  */
 class JOYNR_EXPORT BlockingQueue
 {
 public:
+    /*! Default number of times a non-empty priority class may be passed over */
+    static constexpr std::uint32_t DEFAULT_MAX_BYPASS_COUNT = 16;
+
     /**
      * @brief Constructor
+     * @param maxBypassCount Number of consecutive @ref take calls which may pass
+     *      over a non-empty priority class in favour of a higher one, and over the
+     *      oldest task of a class in favour of an earlier deadline
      */
-    BlockingQueue();
+    explicit BlockingQueue(std::uint32_t maxBypassCount = DEFAULT_MAX_BYPASS_COUNT);
 
     /**
      * @brief Destructor
@@ -84,6 +108,50 @@ public:
     int getQueueLength() const;
 
 private:
+    struct QueueEntry
+    {
+        TimePoint deadline;
+        std::uint64_t sequenceNumber;
+        std::shared_ptr<Runnable> task;
+    };
+
+    struct EarliestDeadlineFirst
+    {
+        bool operator()(const QueueEntry& lhs, const QueueEntry& rhs) const
+        {
+            if (lhs.deadline == rhs.deadline) {
+                return lhs.sequenceNumber < rhs.sequenceNumber;
+            }
+            return lhs.deadline < rhs.deadline;
+        }
+    };
+
+    struct Deadline
+    {
+    };
+
+    struct Sequence
+    {
+    };
+
+    using PriorityClassQueue = boost::multi_index_container<
+            QueueEntry,
+            boost::multi_index::indexed_by<
+                    boost::multi_index::ordered_unique<boost::multi_index::tag<Deadline>,
+                                                       boost::multi_index::identity<QueueEntry>,
+                                                       EarliestDeadlineFirst>,
+                    boost::multi_index::ordered_unique<
+                            boost::multi_index::tag<Sequence>,
+                            boost::multi_index::member<QueueEntry,
+                                                       std::uint64_t,
+                                                       &QueueEntry::sequenceNumber>>>>;
+
+    /*! Selects the priority class to take from; conditionMutex must be locked */
+    std::size_t selectPriorityClass();
+
+    /*! Removes the next task from the priority class; conditionMutex must be locked */
+    std::shared_ptr<Runnable> takeFrom(std::size_t priorityClass);
+
     /*! Not allowed to copy @ref BlockingQueue */
     DISALLOW_COPY_AND_ASSIGN(BlockingQueue);
 
@@ -94,13 +162,27 @@ private:
     /*! Flag indicating scheduler is shutting down */
     std::atomic_bool stoppingScheduler;
 
-    /*! Queue of waiting work */
-    std::deque<std::shared_ptr<Runnable>> queue;
+    /*! Queues of waiting work, one per priority class */
+    std::array<PriorityClassQueue, SchedulingPriority::NUMBER_OF_PRIORITIES> queues;
+
+    /*! Number of consecutive takes which passed over each non-empty priority class */
+    std::array<std::uint32_t, SchedulingPriority::NUMBER_OF_PRIORITIES> bypassCounts;
+
+    /*! Number of consecutive takes which passed over the oldest task of each priority class */
+    std::array<std::uint32_t, SchedulingPriority::NUMBER_OF_PRIORITIES> oldestTaskBypassCounts;
+
+    /*! Tie breaker keeping FIFO order for equal deadlines */
+    std::uint64_t nextSequenceNumber;
+
+    /*! Total number of queued tasks */
+    std::size_t queueLength;
+
+    const std::uint32_t maxBypassCount;
 
     /*! Cond to wait for task on calling @ref take */
     std::condition_variable condition;
 
-    /*! Mutual exclusion of the @ref queue and for @ref condition */
+    /*! Mutual exclusion of the @ref queues and for @ref condition */
     mutable std::mutex conditionMutex;
 };
 } // namespace joynr
@@ -0,0 +1,72 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef CACHEDMESSAGINGSTUB_H
+#define CACHEDMESSAGINGSTUB_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class IMessagingStub;
+
+/**
+ * @brief Messaging stub resolved for the address of a routing entry.
+ *
+ * The stub is only referenced weakly and tagged with the generation of the messaging stub
+ * factory it was resolved in. Once the factory removes any stub, its generation changes and the
+ * cached stub is resolved again on the next use.
+ */
+class CachedMessagingStub
+{
+public:
+    CachedMessagingStub() : mutex(), stub(), generation(0)
+    {
+    }
+
+    std::shared_ptr<IMessagingStub> get(std::uint64_t currentGeneration) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (generation != currentGeneration) {
+            return nullptr;
+        }
+        return stub.lock();
+    }
+
+    void set(const std::shared_ptr<IMessagingStub>& resolvedStub, std::uint64_t resolvedGeneration)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stub = resolvedStub;
+        generation = resolvedGeneration;
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(CachedMessagingStub);
+
+    mutable std::mutex mutex;
+    std::weak_ptr<IMessagingStub> stub;
+    std::uint64_t generation;
+};
+
+} // namespace joynr
+#endif // CACHEDMESSAGINGSTUB_H
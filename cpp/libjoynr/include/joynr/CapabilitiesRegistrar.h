@@ -44,6 +44,19 @@
 namespace joynr
 {
 
+/**
+ * @brief A provider prepared for registration, see CapabilitiesRegistrar::addAsync
+ */
+struct ProviderRegistration
+{
+    std::string domain;
+    std::string interfaceName;
+    std::uint32_t majorVersion;
+    std::shared_ptr<RequestCaller> caller;
+    types::DiscoveryEntry entry;
+    bool isInternalProvider;
+};
+
 /**
  * Class that handles provider registration/deregistration
  */
@@ -60,15 +73,14 @@ public:
             std::weak_ptr<PublicationManager> publicationManager,
             const std::string& globalAddress);
 
+    /**
+     * @brief Prepares the registration of a provider, the returned registration can be passed
+     * to addAsync together with others to register all of them in a single batch.
+     */
     template <class T>
-    std::string addAsync(
-            const std::string& domain,
-            std::shared_ptr<T> provider,
-            const types::ProviderQos& providerQos,
-            std::function<void()> onSuccess,
-            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError,
-            bool persist = true,
-            bool awaitGlobalRegistration = false) noexcept
+    ProviderRegistration createProviderRegistration(const std::string& domain,
+                                                    std::shared_ptr<T> provider,
+                                                    const types::ProviderQos& providerQos)
     {
         const std::string interfaceName = T::INTERFACE_NAME();
         const std::string participantId = participantIdStorage->getProviderParticipantId(
@@ -99,6 +111,31 @@ public:
                                            lastSeenDateMs,
                                            discoveryEntryExpiryDateMs,
                                            defaultPublicKeyId);
+        return ProviderRegistration{domain,
+                                    interfaceName,
+                                    T::MAJOR_VERSION,
+                                    std::move(caller),
+                                    std::move(entry),
+                                    isInternalProvider};
+    }
+
+    template <class T>
+    std::string addAsync(
+            const std::string& domain,
+            std::shared_ptr<T> provider,
+            const types::ProviderQos& providerQos,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError,
+            bool persist = true,
+            bool awaitGlobalRegistration = false) noexcept
+    {
+        ProviderRegistration registration =
+                createProviderRegistration(domain, std::move(provider), providerQos);
+        const std::string& interfaceName = registration.interfaceName;
+        const std::string participantId = registration.entry.getParticipantId();
+        std::shared_ptr<RequestCaller> caller = std::move(registration.caller);
+        joynr::types::DiscoveryEntry entry = std::move(registration.entry);
+        const bool isInternalProvider = registration.isInternalProvider;
         bool isGloballyVisible = providerQos.getScope() == types::ProviderScope::GLOBAL;
 
         auto onSuccessWrapper = [
@@ -201,11 +238,32 @@ public:
         return participantId;
     }
 
+    /**
+     * @brief Registers all providers as one batch: the routing entries are added first, then the
+     * participantIds are persisted and the discovery entries are added with a single call.
+     * If the batch fails, its routing entries are removed again before onError is called.
+     * @return the participantIds of the providers in the order of the registrations
+     */
+    std::vector<std::string> addAsync(
+            std::vector<ProviderRegistration> registrations,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError,
+            bool persist = true,
+            bool awaitGlobalRegistration = false) noexcept;
+
     void removeAsync(const std::string& participantId,
                      std::function<void()> onSuccess,
                      std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
                              onError) noexcept;
 
+    /**
+     * @brief Unregisters all providers as one batch, see addAsync for batches
+     */
+    void removeAsync(const std::vector<std::string>& participantIds,
+                     std::function<void()> onSuccess,
+                     std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                             onError) noexcept;
+
     template <class T>
     std::string removeAsync(
             const std::string& domain,
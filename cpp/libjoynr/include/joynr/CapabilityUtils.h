@@ -17,6 +17,7 @@
  * #L%
  */
 
+#include <memory>
 #include <vector>
 
 namespace joynr
@@ -33,6 +34,9 @@ types::DiscoveryEntryWithMetaInfo convert(bool isLocal, const types::DiscoveryEn
 std::vector<types::DiscoveryEntryWithMetaInfo> convert(
         bool isLocal,
         const std::vector<types::DiscoveryEntry>& entries);
+std::vector<types::DiscoveryEntryWithMetaInfo> convert(
+        bool isLocal,
+        const std::vector<std::shared_ptr<const types::DiscoveryEntry>>& entries);
 } // namespace util
 
 } // namespace joynr
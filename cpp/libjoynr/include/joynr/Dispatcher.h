@@ -20,6 +20,7 @@
 #define DISPATCHER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "joynr/IDispatcher.h"
@@ -27,7 +28,7 @@
 #include "joynr/LibJoynrDirectories.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
-#include "joynr/ReadWriteLock.h"
+#include "joynr/ShutdownGuard.h"
 
 namespace boost
 {
@@ -97,8 +98,7 @@ private:
     std::shared_ptr<ThreadPool> handleReceivedMessageThreadPool;
     ADD_LOGGER(Dispatcher)
     std::mutex subscriptionHandlingMutex;
-    bool isShuttingDown;
-    ReadWriteLock isShuttingDownLock;
+    ShutdownGuard shutdownGuard;
 
     friend class ReceivedMessageRunnable;
 };
@@ -0,0 +1,89 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef DISTRIBUTEDREADWRITELOCK_H
+#define DISTRIBUTEDREADWRITELOCK_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Reader-writer lock whose readers do not contend with each other.
+ *
+ * Each reader only increments a counter in one of several slots, each of them on a cache line of
+ * its own; threads are spread over the slots. A writer blocks new readers, waits until the
+ * counters of all slots dropped to zero and keeps the writer mutex until it unlocks, so readers
+ * which meet an active writer wait on this mutex. A reader which drops the counter of its slot
+ * to zero while a writer is active wakes the writer up. This makes read locking cheap on many cores
+ * at the expense of write locking, which has to visit every slot, and of the memory footprint.
+ *
+ * The lock can be used with boost::shared_lock and boost::unique_lock like boost::shared_mutex.
+ * Unlike boost::shared_mutex, a lock has to be released by the thread which acquired it.
+ */
+class JOYNR_EXPORT DistributedReadWriteLock
+{
+public:
+    static constexpr std::size_t NUMBER_OF_SLOTS = 16;
+
+    DistributedReadWriteLock();
+    ~DistributedReadWriteLock() = default;
+
+    void lock();
+    bool try_lock();
+    void unlock();
+
+    void lock_shared();
+    bool try_lock_shared();
+    void unlock_shared();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(DistributedReadWriteLock);
+
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    struct ReaderSlot
+    {
+        std::atomic<std::uint32_t> readers;
+        // keeps the counters of different slots on different cache lines
+        char padding[CACHE_LINE_SIZE - sizeof(std::atomic<std::uint32_t>)];
+    };
+
+    static std::size_t getSlotIndex();
+    bool hasReaders() const;
+    void releaseSlot(std::atomic<std::uint32_t>& readers);
+
+    std::array<ReaderSlot, NUMBER_OF_SLOTS> slots;
+    std::atomic<bool> isWriterActive;
+    std::mutex writerMutex;
+    std::mutex readersDrainedMutex;
+    std::condition_variable readersDrained;
+};
+
+} // namespace joynr
+
+#endif // DISTRIBUTEDREADWRITELOCK_H
@@ -0,0 +1,50 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef ILOCALPARTICIPANTLOOKUP_H
+#define ILOCALPARTICIPANTLOOKUP_H
+
+#include <string>
+
+#include <boost/optional.hpp>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/types/DiscoveryEntryWithMetaInfo.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Synchronous lookup of a participantId which is known without asking a remote discovery,
+ * e.g. a provisioned entry or a provider registered in the same process.
+ */
+class JOYNR_EXPORT ILocalParticipantLookup
+{
+public:
+    virtual ~ILocalParticipantLookup() = default;
+
+    /**
+     * @return the discovery entry of the participant or boost::none if the participant is not
+     * known locally.
+     */
+    virtual boost::optional<types::DiscoveryEntryWithMetaInfo> lookupLocally(
+            const std::string& participantId) = 0;
+};
+
+} // namespace joynr
+#endif // ILOCALPARTICIPANTLOOKUP_H
@@ -22,6 +22,8 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "joynr/JoynrExport.h"
 
@@ -59,12 +61,36 @@ public:
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
                     onError = nullptr) = 0;
 
+    /**
+     * @brief adds routing entries with the same address for all participantIds, a persisted
+     * routing table is updated once and the parent router is called once for the whole batch
+     */
+    virtual void addNextHops(
+            const std::vector<std::string>& participantIds,
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+            bool isGloballyVisible,
+            const std::int64_t expiryDateMs,
+            const bool isSticky,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
+                    onError = nullptr) = 0;
+
     virtual void removeNextHop(
             const std::string& participantId,
             std::function<void()> onSuccess = nullptr,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
                     onError = nullptr) = 0;
 
+    /**
+     * @brief removes the routing entries of all participantIds, a persisted routing table is
+     * updated once and the parent router is called once for the whole batch
+     */
+    virtual void removeNextHops(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
+                    onError = nullptr) = 0;
+
     virtual void addMulticastReceiver(
             const std::string& multicastId,
             const std::string& subscriberParticipantId,
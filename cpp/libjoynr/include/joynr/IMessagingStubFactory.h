@@ -20,6 +20,9 @@
 #define IMESSAGINGSTUBFACTORY_H
 
 #include <memory>
+#include <tuple>
+
+#include "joynr/CachedMessagingStub.h"
 
 namespace joynr
 {
@@ -45,6 +48,18 @@ public:
     virtual bool contains(const std::shared_ptr<const joynr::system::RoutingTypes::Address>&
                                   destinationAddress) = 0;
     virtual void shutdown() = 0;
+
+    /**
+     * @brief Same as create, but returns the stub held by cachedStub while it is still valid
+     * and stores a newly created stub in cachedStub.
+     */
+    virtual std::shared_ptr<IMessagingStub> createCached(
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& destinationAddress,
+            CachedMessagingStub& cachedStub)
+    {
+        std::ignore = cachedStub;
+        return create(destinationAddress);
+    }
 };
 
 } // namespace joynr
@@ -20,25 +20,42 @@
 #ifndef IMMUTABLEMESSAGE_H
 #define IMMUTABLEMESSAGE_H
 
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <unordered_map>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/optional.hpp>
 #include <smrf/ByteVector.h>
 #include <smrf/MessageDeserializer.h>
 
 #include "joynr/Logger.h"
+#include "joynr/SchedulingPriority.h"
 #include "joynr/TimePoint.h"
 #include "serializer/Serializer.h"
 
 namespace joynr
 {
 
-struct RequiredHeaders
+class BackPressureReservation;
+
+/**
+ * @brief Index of the headers used on the routing and dispatching paths.
+ *
+ * It is built once when the message is decoded and points into the header map of the
+ * message. The map is node based, so the entries stay valid when the message is moved.
+ */
+struct MessageHeaderIndex
 {
-    std::string id;
-    std::string type;
-    static constexpr std::size_t NUM_REQUIRED_HEADERS = 2;
+    using HeaderEntry = std::unordered_map<std::string, std::string>::value_type;
+    static constexpr std::size_t NUM_INLINE_CUSTOM_HEADERS = 4;
+
+    const std::string* id = nullptr;
+    const std::string* type = nullptr;
+    const std::string* effort = nullptr;
+    const std::string* replyTo = nullptr;
+    boost::container::small_vector<const HeaderEntry*, NUM_INLINE_CUSTOM_HEADERS> customHeaders;
 };
 
 class ImmutableMessage
@@ -53,9 +70,9 @@ public:
 
     ~ImmutableMessage() = default;
 
-    std::string getSender() const;
+    const std::string& getSender() const;
 
-    std::string getRecipient() const;
+    const std::string& getRecipient() const;
 
     bool isTtlAbsolute() const;
 
@@ -81,8 +98,28 @@ public:
 
     boost::optional<std::string> getEffort() const;
 
+    /**
+     * @brief Non-copying variants of getReplyTo() and getEffort().
+     * The returned reference is valid as long as this message exists.
+     */
+    boost::optional<const std::string&> getReplyToView() const;
+
+    boost::optional<const std::string&> getEffortView() const;
+
+    /**
+     * @brief Non-copying lookup of an arbitrary header (including the custom header prefix).
+     */
+    boost::optional<const std::string&> getHeaderView(const std::string& key) const;
+
     TimePoint getExpiryDate() const;
 
+    /**
+     * @brief Priority class used when the message is queued for sending.
+     * Replies are HIGH, publications, multicasts and best effort messages are LOW,
+     * everything else is NORMAL.
+     */
+    SchedulingPriority::Enum getSchedulingPriority() const;
+
     const smrf::ByteVector& getSerializedMessage() const;
 
     std::size_t getMessageSize() const;
@@ -106,6 +143,13 @@ public:
      */
     void setReceivedFromGlobal(bool receivedFromGlobal);
 
+    /**
+     * @brief Attaches the back-pressure accounting of this message; it is released together
+     * with the message. Like receivedFromGlobal, the reservation is not serialized.
+     */
+    void setBackPressureReservation(std::shared_ptr<BackPressureReservation> reservation);
+    bool hasBackPressureReservation() const;
+
     void setCreator(const std::string& creator);
 
     void setCreator(std::string&& creator);
@@ -117,8 +161,6 @@ public:
     template <typename Archive>
     void save(Archive& archive)
     {
-        const auto& recipient = getRecipient();
-        const auto& sender = getSender();
         const auto expiryDate = messageDeserializer.getTtlMs();
         smrf::ByteArrayView body = getUnencryptedBody();
         const std::string payload(body.data(), body.data() + body.size());
@@ -135,14 +177,31 @@ public:
     void setAccessControlChecked();
 
 private:
-    boost::optional<std::string> getOptionalHeaderByKey(const std::string& key) const;
+    friend class MutableMessage;
+
+    /**
+     * Used by MutableMessage, which takes the headers, sender and recipient from the message it
+     * has just serialized instead of decoding them from serializedMessage again.
+     */
+    ImmutableMessage(smrf::ByteVector&& serializedMessage,
+                     std::unordered_map<std::string, std::string>&& headers,
+                     const std::string& sender,
+                     const std::string& recipient);
+
+    static boost::optional<const std::string&> toOptional(const std::string* value);
 
     void init();
+    void indexHeaders();
+    SchedulingPriority::Enum calculateSchedulingPriority() const;
     bool isCustomHeaderKey(const std::string& key) const;
 
     smrf::ByteVector serializedMessage;
     smrf::MessageDeserializer messageDeserializer;
     std::unordered_map<std::string, std::string> headers;
+    MessageHeaderIndex headerIndex;
+    std::string sender;
+    std::string recipient;
+    SchedulingPriority::Enum schedulingPriority;
     mutable boost::optional<smrf::ByteArrayView> bodyView;
     mutable boost::optional<smrf::ByteVector> decompressedBody;
 
@@ -150,9 +209,9 @@ private:
     // It is only used locally for routing decisions.
     bool receivedFromGlobal;
     bool accessControlChecked;
+    std::shared_ptr<BackPressureReservation> backPressureReservation;
 
     std::string creator;
-    RequiredHeaders requiredHeaders;
     ADD_LOGGER(ImmutableMessage)
 };
 
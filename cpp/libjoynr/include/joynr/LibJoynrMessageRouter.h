@@ -25,6 +25,7 @@
 #include <mutex>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "joynr/AbstractMessageRouter.h"
 #include "joynr/JoynrExport.h"
@@ -106,11 +107,25 @@ public:
                     std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
                             onError = nullptr) final;
 
+    void addNextHops(const std::vector<std::string>& participantIds,
+                     const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+                     bool isGloballyVisible,
+                     const std::int64_t expiryDateMs,
+                     const bool isSticky,
+                     std::function<void()> onSuccess = nullptr,
+                     std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
+                             onError = nullptr) final;
+
     void removeNextHop(
             const std::string& participantId,
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
 
+    void removeNextHops(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
     void addMulticastReceiver(
             const std::string& multicastId,
             const std::string& subscriberParticipantId,
@@ -159,11 +174,16 @@ private:
                             const WriteLocker& messageQueueRetryWriteLock) final;
 
     bool isParentMessageRouterSet();
-    void addNextHopToParent(std::string participantId,
-                            bool isGloballyVisible,
-                            std::function<void(void)> onSuccess = nullptr,
-                            std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
-                                    onError = nullptr);
+    // ParticipantIds is a single participantId or a vector of participantIds
+    template <typename ParticipantIds>
+    void addNextHopToParent(
+            const ParticipantIds& participantIds,
+            bool isGloballyVisible,
+            std::function<void(void)> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException&)> onErrorWrapper);
+    static std::function<void(const joynr::exceptions::JoynrRuntimeException&)>
+    createAddNextHopToParentOnError(
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError);
     bool isValidForRoutingTable(
             std::shared_ptr<const joynr::system::RoutingTypes::Address> address) final;
     bool allowRoutingEntryUpdate(const routingtable::RoutingEntry& oldEntry,
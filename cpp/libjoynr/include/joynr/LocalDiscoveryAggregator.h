@@ -20,10 +20,13 @@
 #define LOCALDISCOVERYAGGREGATOR_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "joynr/ILocalParticipantLookup.h"
 #include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/system/IDiscovery.h"
 
@@ -43,8 +46,12 @@ class DiscoveryQos;
  * of provisioned discovery entries (for example for the discovery and routing provider). If a
  * lookup is performed by using a participant ID, these entries are checked and returned first
  * before the request is forwarded to the wrapped discovery provider.
+ *
+ * Provisioned entries and entries of an optional local participant lookup (e.g. the local
+ * capabilities directory of a cluster controller) can also be resolved synchronously.
  */
-class JOYNR_EXPORT LocalDiscoveryAggregator : public joynr::system::IDiscoveryAsync
+class JOYNR_EXPORT LocalDiscoveryAggregator : public joynr::system::IDiscoveryAsync,
+                                              public joynr::ILocalParticipantLookup
 {
 public:
     LocalDiscoveryAggregator(std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo>
@@ -52,6 +59,12 @@ public:
 
     void setDiscoveryProxy(std::shared_ptr<IDiscoveryAsync> discoveryProxy);
 
+    void setLocalParticipantLookup(std::weak_ptr<ILocalParticipantLookup> localParticipantLookup);
+
+    // inherited from joynr::ILocalParticipantLookup
+    boost::optional<joynr::types::DiscoveryEntryWithMetaInfo> lookupLocally(
+            const std::string& participantId) override;
+
     // inherited from joynr::system::IDiscoveryAsync
     std::shared_ptr<joynr::Future<void>> addAsync(
             const joynr::types::DiscoveryEntry& discoveryEntry,
@@ -69,6 +82,15 @@ public:
                     onRuntimeError = nullptr,
             boost::optional<joynr::MessagingQos> messagingQos = boost::none) noexcept override;
 
+    // inherited from joynr::system::IDiscoveryAsync
+    std::shared_ptr<joynr::Future<void>> addAsync(
+            const std::vector<joynr::types::DiscoveryEntry>& discoveryEntries,
+            const bool& awaitGlobalRegistration,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                    onRuntimeError = nullptr,
+            boost::optional<joynr::MessagingQos> messagingQos = boost::none) noexcept override;
+
     // inherited from joynr::system::IDiscoveryAsync
     std::shared_ptr<joynr::Future<std::vector<joynr::types::DiscoveryEntryWithMetaInfo>>>
     lookupAsync(
@@ -98,10 +120,20 @@ public:
                     onRuntimeError = nullptr,
             boost::optional<joynr::MessagingQos> messagingQos = boost::none) noexcept override;
 
+    // inherited from joynr::system::IDiscoveryAsync
+    std::shared_ptr<joynr::Future<void>> removeAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                    onRuntimeError = nullptr,
+            boost::optional<joynr::MessagingQos> messagingQos = boost::none) noexcept override;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(LocalDiscoveryAggregator);
+    ADD_LOGGER(LocalDiscoveryAggregator)
 
     std::shared_ptr<joynr::system::IDiscoveryAsync> discoveryProxy;
+    std::weak_ptr<ILocalParticipantLookup> localParticipantLookup;
     const std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo>
             provisionedDiscoveryEntries;
 };
@@ -0,0 +1,82 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef MESSAGEBATCH_H
+#define MESSAGEBATCH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/JoynrExport.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Envelope which carries several serialized joynr messages in one transport payload,
+ * e.g. one MQTT publication or one WebSocket frame.
+ *
+ * The envelope starts with a 4 byte header ("JMB" followed by the format version) which can
+ * never be the start of a SMRF message, so single messages and batches can be sent over the
+ * same topic or connection. The header is followed by the messages, each preceded by its size
+ * as 4 byte unsigned integer in network byte order. Unlike the concatenated messages received
+ * via HTTP, the messages can be split without deserializing them and each one is handed on
+ * without the bytes of the following messages.
+ */
+class JOYNR_EXPORT MessageBatch
+{
+public:
+    static constexpr std::size_t HEADER_SIZE = 4;
+    static constexpr std::size_t FRAME_OVERHEAD = sizeof(std::uint32_t);
+
+    MessageBatch();
+
+    void append(const smrf::ByteArrayView& message);
+
+    std::size_t getNumberOfMessages() const;
+
+    /**
+     * @return size of the payload including the header
+     */
+    std::size_t getSize() const;
+
+    const smrf::ByteVector& getPayload() const;
+
+    static bool isBatch(const smrf::ByteVector& payload);
+
+    /**
+     * @brief Splits a batch into its messages.
+     * @throw std::invalid_argument if the payload is not a valid batch
+     */
+    static std::vector<smrf::ByteVector> split(const smrf::ByteVector& payload);
+
+private:
+    static const std::array<std::uint8_t, HEADER_SIZE>& header();
+
+    smrf::ByteVector payload;
+    std::size_t numberOfMessages;
+};
+
+} // namespace joynr
+
+#endif // MESSAGEBATCH_H
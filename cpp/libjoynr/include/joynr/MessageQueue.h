@@ -35,6 +35,7 @@
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/ImmutableMessage.h"
+#include "joynr/SchedulingPriority.h"
 
 namespace joynr
 {
@@ -44,6 +45,7 @@ namespace messagequeuetags
 struct key;
 struct ttlAbsolute;
 struct key_and_ttlAbsolute;
+struct key_and_priority_and_ttlAbsolute;
 }
 
 template <typename T>
@@ -80,6 +82,7 @@ public:
         MessageQueueItem item;
         item.key = std::move(key);
         item.ttlAbsolute = message->getExpiryDate();
+        item.priority = message->getSchedulingPriority();
         item.message = std::move(message);
 
         std::lock_guard<std::mutex> lock(queueMutex);
@@ -105,16 +108,22 @@ public:
                         getQueueLengthUnlocked());
     }
 
+    /**
+     * @brief Removes and returns the next message queued for key: the message of the
+     * highest priority class with the earliest expiry date.
+     */
     std::shared_ptr<ImmutableMessage> getNextMessageFor(const T& key)
     {
         std::lock_guard<std::mutex> lock(queueMutex);
-        auto& keyIndex = boost::multi_index::get<messagequeuetags::key>(queue);
+        auto& keyAndPriorityIndex =
+                boost::multi_index::get<messagequeuetags::key_and_priority_and_ttlAbsolute>(
+                        queue);
 
-        auto queueElement = keyIndex.find(key);
-        if (queueElement != keyIndex.cend()) {
+        auto queueElement = keyAndPriorityIndex.lower_bound(key);
+        if (queueElement != keyAndPriorityIndex.cend() && queueElement->key == key) {
             auto message = std::move(queueElement->message);
             queueSizeBytes -= message->getMessageSize();
-            queue.erase(queueElement);
+            keyAndPriorityIndex.erase(queueElement);
             JOYNR_LOG_TRACE(logger(),
                             "getNextMessageFor: message {}, new "
                             "queueSize(bytes) = {}, #msgs = {}",
@@ -168,6 +177,7 @@ protected:
     {
         T key;
         TimePoint ttlAbsolute;
+        SchedulingPriority::Enum priority;
         std::shared_ptr<ImmutableMessage> message;
     };
 
@@ -186,6 +196,19 @@ protected:
                                     MessageQueueItem,
                                     boost::multi_index::
                                             member<MessageQueueItem, T, &MessageQueueItem::key>,
+                                    BOOST_MULTI_INDEX_MEMBER(MessageQueueItem,
+                                                             TimePoint,
+                                                             ttlAbsolute)>>,
+                    boost::multi_index::ordered_non_unique<
+                            boost::multi_index::tag<
+                                    messagequeuetags::key_and_priority_and_ttlAbsolute>,
+                            boost::multi_index::composite_key<
+                                    MessageQueueItem,
+                                    boost::multi_index::
+                                            member<MessageQueueItem, T, &MessageQueueItem::key>,
+                                    BOOST_MULTI_INDEX_MEMBER(MessageQueueItem,
+                                                             SchedulingPriority::Enum,
+                                                             priority),
                                     BOOST_MULTI_INDEX_MEMBER(MessageQueueItem,
                                                              TimePoint,
                                                              ttlAbsolute)>>>>;
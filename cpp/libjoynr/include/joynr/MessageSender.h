@@ -19,6 +19,7 @@
 #ifndef MESSAGESENDER_H
 #define MESSAGESENDER_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -32,6 +33,7 @@
 namespace joynr
 {
 
+class BackPressureController;
 class IMessageRouter;
 class IReplyCaller;
 class IDispatcher;
@@ -73,9 +75,16 @@ class SubscriptionPublication;
 class JOYNR_EXPORT MessageSender : public IMessageSender
 {
 public:
+    /**
+     * @param backPressureController if set, requests, one-way requests and publications are
+     *        admitted according to its back-pressure policy before they are routed; a request
+     *        which is not admitted is failed through its reply caller. Replies and subscription
+     *        control messages are always sent.
+     */
     MessageSender(std::shared_ptr<IMessageRouter> messagingRouter,
                   std::shared_ptr<IKeychain> keyChain,
-                  std::uint64_t ttlUpliftMs = 0);
+                  std::uint64_t ttlUpliftMs = 0,
+                  std::shared_ptr<BackPressureController> backPressureController = nullptr);
 
     ~MessageSender() override = default;
 
@@ -146,12 +155,25 @@ public:
                        const MulticastPublication& multicastPublication,
                        const MessagingQos& messagingQos) override;
 
+    /**
+     * @return true if a back-pressure controller is set and the message router is saturated
+     */
+    bool isBackPressured() const;
+
+    /**
+     * @brief Calls the callback once the message router is not saturated (anymore).
+     * Intended for producers which use the NOTIFY back-pressure policy.
+     */
+    void notifyWhenReady(std::function<void()> callback);
+
 private:
     DISALLOW_COPY_AND_ASSIGN(MessageSender);
+    void admit();
     std::weak_ptr<IDispatcher> dispatcher;
     std::shared_ptr<IMessageRouter> messageRouter;
     MutableMessageFactory messageFactory;
     std::string replyToAddress;
+    std::shared_ptr<BackPressureController> backPressureController;
     ADD_LOGGER(MessageSender)
 };
 
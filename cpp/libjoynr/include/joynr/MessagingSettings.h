@@ -50,6 +50,11 @@ public:
     static const std::string& SETTING_MQTT_EXPONENTIAL_BACKOFF_ENABLED();
     static const std::string& SETTING_MQTT_CONNECTION_TIMEOUT_MS();
     static const std::string& SETTING_MQTT_MAX_MESSAGE_SIZE_BYTES();
+    static const std::string& SETTING_MQTT_PUBLISH_CONNECTIONS();
+    static const std::string& SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES();
+    static const std::string& SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES();
+    static const std::string& SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS();
+    static const std::string& SETTING_MQTT_MAX_INFLIGHT_MESSAGES();
     static const std::string& SETTING_INDEX();
     static const std::string& SETTING_CREATE_CHANNEL_RETRY_INTERVAL();
     static const std::string& SETTING_DELETE_CHANNEL_RETRY_INTERVAL();
@@ -96,6 +101,10 @@ public:
     static const std::string& SETTING_DISCOVERY_MESSAGES_TTL_MS();
     static const std::string& SETTING_SEND_MESSAGE_MAX_TTL();
     static const std::string& SETTING_TTL_UPLIFT_MS();
+    static const std::string& SETTING_BACK_PRESSURE_POLICY();
+    static const std::string& SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES();
+    static const std::string& SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES();
+    static const std::string& SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS();
 
     static const std::string& DEFAULT_MESSAGING_SETTINGS_FILENAME();
     static const std::string& DEFAULT_PERSISTENCE_FILENAME();
@@ -111,6 +120,10 @@ public:
     static std::int64_t DEFAULT_SEND_MESSAGE_MAX_TTL();
     static std::uint64_t DEFAULT_TTL_UPLIFT_MS();
     static bool DEFAULT_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS();
+    static const std::string& DEFAULT_BACK_PRESSURE_POLICY();
+    static std::uint64_t DEFAULT_BACK_PRESSURE_HIGH_WATERMARK_BYTES();
+    static std::uint64_t DEFAULT_BACK_PRESSURE_LOW_WATERMARK_BYTES();
+    static std::int64_t DEFAULT_BACK_PRESSURE_MAX_BLOCKING_TIME_MS();
 
     /**
      * @brief DEFAULT_MAXIMUM_TTL_MS
@@ -124,6 +137,11 @@ public:
     static std::chrono::milliseconds DEFAULT_MQTT_CONNECTION_TIMEOUT_MS();
     static std::int64_t DEFAULT_MQTT_MAX_MESSAGE_SIZE_BYTES();
     static std::int64_t NO_MQTT_MAX_MESSAGE_SIZE_BYTES();
+    static std::uint32_t DEFAULT_MQTT_PUBLISH_CONNECTIONS();
+    static std::uint32_t DEFAULT_MQTT_PUBLISH_BATCH_MAX_MESSAGES();
+    static std::uint32_t DEFAULT_MQTT_PUBLISH_BATCH_MAX_BYTES();
+    static std::chrono::milliseconds DEFAULT_MQTT_PUBLISH_BATCH_MAX_DELAY_MS();
+    static std::uint32_t DEFAULT_MQTT_MAX_INFLIGHT_MESSAGES();
 
     BrokerUrl getBrokerUrl() const;
     std::string getBrokerUrlString() const;
@@ -146,6 +164,32 @@ public:
     std::chrono::milliseconds getMqttConnectionTimeoutMs() const;
     std::int64_t getMqttMaxMessageSizeBytes() const;
     void setMqttMaxMessageSizeBytes(std::int64_t mqttMaxMessageSizeBytes);
+    /**
+     * @brief Number of additional broker connections used only for publishing; messages are
+     * assigned to them by the hash of their topic. 0 publishes via the receiving connection.
+     */
+    std::uint32_t getMqttPublishConnections() const;
+    void setMqttPublishConnections(std::uint32_t numberOfConnections);
+    /**
+     * @brief Maximum number of messages to the same topic which are published together in one
+     * batch. 1 disables batching. Batches can only be received by cluster controllers which
+     * support them, so this must only be enabled if all receivers do.
+     */
+    std::uint32_t getMqttPublishBatchMaxMessages() const;
+    void setMqttPublishBatchMaxMessages(std::uint32_t maxMessages);
+    std::uint32_t getMqttPublishBatchMaxBytes() const;
+    void setMqttPublishBatchMaxBytes(std::uint32_t maxBytes);
+    /**
+     * @brief Maximum time a message waits in a batch before the batch is published.
+     */
+    std::chrono::milliseconds getMqttPublishBatchMaxDelayMs() const;
+    void setMqttPublishBatchMaxDelayMs(std::chrono::milliseconds maxDelay);
+    /**
+     * @brief Maximum number of QoS 1 and 2 messages per broker connection which are published
+     * but not yet acknowledged. 0 means unlimited.
+     */
+    std::uint32_t getMqttMaxInflightMessages() const;
+    void setMqttMaxInflightMessages(std::uint32_t maxInflightMessages);
     std::int64_t getIndex() const;
     void setIndex(std::int64_t index);
     int getCreateChannelRetryInterval() const;
@@ -213,6 +257,19 @@ public:
     void setDiscardUnroutableRepliesAndPublications(
             const bool& discardUnroutableRepliesAndPublications);
 
+    /**
+     * @brief Back-pressure policy applied by the MessageSender when the message router
+     * is saturated: DISABLED, BLOCK, FAIL_FAST or NOTIFY.
+     */
+    std::string getBackPressurePolicy() const;
+    void setBackPressurePolicy(const std::string& policy);
+    std::uint64_t getBackPressureHighWatermarkBytes() const;
+    void setBackPressureHighWatermarkBytes(std::uint64_t highWatermarkBytes);
+    std::uint64_t getBackPressureLowWatermarkBytes() const;
+    void setBackPressureLowWatermarkBytes(std::uint64_t lowWatermarkBytes);
+    std::int64_t getBackPressureMaxBlockingTimeMs() const;
+    void setBackPressureMaxBlockingTimeMs(std::int64_t maxBlockingTimeMs);
+
     bool contains(const std::string& key) const;
 
     void printSettings() const;
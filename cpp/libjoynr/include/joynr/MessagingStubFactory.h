@@ -19,6 +19,8 @@
 #ifndef MESSAGINGSTUBFACTORY_H
 #define MESSAGINGSTUBFACTORY_H
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -62,6 +64,9 @@ public:
                         destinationAddress) override;
     bool contains(const std::shared_ptr<const joynr::system::RoutingTypes::Address>&
                           destinationAddress) override;
+    std::shared_ptr<IMessagingStub> createCached(
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& destinationAddress,
+            CachedMessagingStub& cachedStub) override;
 
     void registerStubFactory(std::shared_ptr<IMiddlewareMessagingStubFactory> factory);
     void shutdown() override;
@@ -90,6 +95,8 @@ private:
     ThreadSafeMap<AddressPtr, std::shared_ptr<IMessagingStub>, Map> address2MessagingStubMap;
     std::vector<std::shared_ptr<IMiddlewareMessagingStubFactory>> factoryList;
     std::mutex mutex;
+    // changes whenever a stub is removed, invalidates all CachedMessagingStubs
+    std::atomic<std::uint64_t> generation;
 };
 
 } // namespace joynr
@@ -0,0 +1,117 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef MULTITHREADEDIOSERVICE_H
+#define MULTITHREADEDIOSERVICE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include "joynr/BackPressureController.h"
+#include "joynr/Semaphore.h"
+#include "joynr/Logger.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Runs an io_service on a fixed number of threads. Handlers which must not run
+ * concurrently have to be serialized by the user, e.g. with an io_service::strand.
+ */
+class MultiThreadedIOService : public std::enable_shared_from_this<MultiThreadedIOService>
+{
+public:
+    explicit MultiThreadedIOService(std::size_t numberOfThreads,
+                                    std::shared_ptr<Semaphore> destructed = nullptr)
+            : std::enable_shared_from_this<MultiThreadedIOService>(),
+              numberOfThreads(std::max<std::size_t>(numberOfThreads, 1)),
+              ioService(static_cast<int>(this->numberOfThreads)),
+              ioServiceWork(),
+              ioServiceThreads(),
+              destructed(destructed)
+    {
+        JOYNR_LOG_TRACE(logger(), "Created.");
+    }
+
+    ~MultiThreadedIOService()
+    {
+        if (destructed) {
+            destructed->notify();
+        }
+    }
+
+    void start()
+    {
+        ioServiceWork = std::make_unique<boost::asio::io_service::work>(ioService);
+        ioServiceThreads.reserve(numberOfThreads);
+        for (std::size_t i = 0; i < numberOfThreads; ++i) {
+            ioServiceThreads.emplace_back(&runIOService, shared_from_this());
+        }
+        JOYNR_LOG_TRACE(logger(), "Started {} threads.", numberOfThreads);
+    }
+
+    void stop()
+    {
+        JOYNR_LOG_TRACE(logger(), "Stopping.");
+        ioServiceWork.reset();
+        ioService.stop();
+
+        // same as SingleThreadedIOService: a thread of this service which stops it must not
+        // join itself; it keeps this object alive through its shared_ptr until it has ended
+        for (std::thread& ioServiceThread : ioServiceThreads) {
+            if (std::this_thread::get_id() == ioServiceThread.get_id()) {
+                ioServiceThread.detach();
+                JOYNR_LOG_TRACE(logger(), "Same thread: detach!");
+            } else if (ioServiceThread.joinable()) {
+                ioServiceThread.join();
+            }
+        }
+    }
+
+    boost::asio::io_service& getIOService()
+    {
+        return ioService;
+    }
+
+    std::size_t getNumberOfThreads() const
+    {
+        return numberOfThreads;
+    }
+
+private:
+    static void runIOService(std::shared_ptr<MultiThreadedIOService> multiThreadedIOService)
+    {
+        BackPressureController::markCurrentThreadAsInternal();
+        multiThreadedIOService->ioService.run();
+    }
+
+private:
+    ADD_LOGGER(MultiThreadedIOService)
+    const std::size_t numberOfThreads;
+    boost::asio::io_service ioService;
+    std::unique_ptr<boost::asio::io_service::work> ioServiceWork;
+    std::vector<std::thread> ioServiceThreads;
+    std::shared_ptr<Semaphore> destructed;
+};
+
+} // namespace joynr
+#endif // MULTITHREADEDIOSERVICE_H
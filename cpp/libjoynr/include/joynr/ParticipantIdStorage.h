@@ -19,13 +19,15 @@
 #ifndef PARTICIPANTIDSTORAGE_H
 #define PARTICIPANTIDSTORAGE_H
 
+#include <cstdint>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/indexed_by.hpp>
 #include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
 
 #include "joynr/JoynrExport.h"
@@ -45,6 +47,10 @@ struct read;
 /**
  * Creates and persists participant ids.
  *
+ * The ids are kept in an append-only binary file: a header followed by one checksummed record per
+ * entry. The file is read once at startup to build the in-memory index, every new entry is
+ * appended as a single record. Files in the former INI format are imported once and rewritten.
+ *
  * This class is thread safe.
  */
 class JOYNR_EXPORT ParticipantIdStorage
@@ -91,22 +97,15 @@ private:
     {
         const std::string key;
         const std::string participantId;
-
-        std::string toIniForm() const
-        {
-            std::stringstream iniForm;
-            iniForm << key << "=" << participantId << std::endl;
-            return iniForm.str();
-        }
     };
 
     // Use one view for writing and one for reading:
-    //  - reading is ordered alphabetically and hence optimized for lookups
+    //  - reading is hashed and hence optimized for lookups
     //  - writing is ordered sequentially so that we only write the diff to disk
     using MultiIndexContainer = boost::multi_index_container<
             StorageItem,
             boost::multi_index::indexed_by<
-                    boost::multi_index::ordered_unique<
+                    boost::multi_index::hashed_unique<
                             boost::multi_index::tag<participantIdStorageTags::read>,
                             BOOST_MULTI_INDEX_MEMBER(StorageItem, const std::string, key)>,
                     boost::multi_index::random_access<
@@ -119,13 +118,18 @@ private:
                                   const std::string& interfaceName,
                                   std::uint32_t majorVersion);
     void loadEntriesFromFile();
+    bool loadEntriesFromBinaryFile(const std::string& content);
+    bool importEntriesFromIniFile();
+    void rewriteFile();
     void writeStoreToFile();
+    static void appendRecord(std::string& buffer, const StorageItem& item);
 
     std::mutex fileMutex;
     ReadWriteLock storageMutex;
 
     MultiIndexContainer storage;
     size_t entriesWrittenToDisk;
+    bool fileHasHeader;
     std::string fileName;
 };
 
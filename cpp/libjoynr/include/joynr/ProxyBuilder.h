@@ -25,10 +25,13 @@
 #include <memory>
 #include <string>
 
+#include <boost/optional.hpp>
+
 #include "joynr/Arbitrator.h"
 #include "joynr/ArbitratorFactory.h"
 #include "joynr/DiscoveryQos.h"
 #include "joynr/Future.h"
+#include "joynr/ILocalParticipantLookup.h"
 #include "joynr/IMessageRouter.h"
 #include "joynr/IProxyBuilder.h"
 #include "joynr/IRequestCallerDirectory.h"
@@ -56,6 +59,9 @@ class MessagingSettings;
  * All invocations will be queued until either the message TTL expires or the
  * arbitration finishes successfully. Synchronous calls will block until the
  * arbitration is done.
+ *
+ * Proxies with the fixed participant arbitration strategy whose provider is known locally
+ * (provisioned or registered at the same cluster controller) are built without arbitration.
  */
 template <class T>
 class ProxyBuilder : public IProxyBuilder<T>, public std::enable_shared_from_this<ProxyBuilder<T>>
@@ -133,6 +139,8 @@ public:
 private:
     DISALLOW_COPY_AND_ASSIGN(ProxyBuilder);
 
+    boost::optional<types::DiscoveryEntryWithMetaInfo> lookupFixedParticipantLocally() const;
+
     std::weak_ptr<JoynrRuntimeImpl> runtime;
     std::string domain;
     MessagingQos messagingQos;
@@ -218,11 +226,12 @@ void ProxyBuilder<T>::buildAsync(
         std::function<void(const exceptions::DiscoveryException& exception)> onError) noexcept
 {
     auto runtimeSharedPtr = runtime.lock();
-    std::lock_guard<std::mutex> lock(arbitratorsMutex);
+    std::unique_lock<std::mutex> lock(arbitratorsMutex);
 
     if (runtimeSharedPtr == nullptr || shuttingDown) {
         const exceptions::DiscoveryException error(runtimeAlreadyDestroyed);
         onError(error);
+        return;
     }
 
     joynr::types::Version interfaceVersion(T::MAJOR_VERSION, T::MINOR_VERSION);
@@ -290,12 +299,58 @@ void ProxyBuilder<T>::buildAsync(
                                   onErrorAddNextHop);
     };
 
+    if (auto fixedParticipantEntry = lookupFixedParticipantLocally()) {
+        lock.unlock();
+        JOYNR_LOG_DEBUG(logger(),
+                        "DISCOVERY fixed participant {} resolved locally, skipping arbitration",
+                        fixedParticipantEntry->getParticipantId());
+        arbitrationSucceeds(*fixedParticipantEntry);
+        return;
+    }
+
     auto arbitrator = ArbitratorFactory::createArbitrator(
             domain, T::INTERFACE_NAME(), interfaceVersion, discoveryProxy, discoveryQos);
     arbitrator->startArbitration(std::move(arbitrationSucceeds), std::move(onError));
     arbitrators.push_back(std::move(arbitrator));
 }
 
+template <class T>
+boost::optional<types::DiscoveryEntryWithMetaInfo> ProxyBuilder<T>::lookupFixedParticipantLocally()
+        const
+{
+    if (discoveryQos.getArbitrationStrategy() !=
+        DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT) {
+        return boost::none;
+    }
+    auto localParticipantLookup =
+            std::dynamic_pointer_cast<ILocalParticipantLookup>(discoveryProxy.lock());
+    if (!localParticipantLookup) {
+        return boost::none;
+    }
+    const auto customParameters = discoveryQos.getCustomParameters();
+    auto fixedParticipantId = customParameters.find("fixedParticipantId");
+    if (fixedParticipantId == customParameters.cend()) {
+        return boost::none;
+    }
+
+    auto discoveryEntry =
+            localParticipantLookup->lookupLocally(fixedParticipantId->second.getValue());
+    if (!discoveryEntry) {
+        return boost::none;
+    }
+    // incompatible providers are left to the arbitrator which reports the proper error
+    const types::Version& providerVersion = discoveryEntry->getProviderVersion();
+    if (providerVersion.getMajorVersion() != T::MAJOR_VERSION ||
+        providerVersion.getMinorVersion() < T::MINOR_VERSION) {
+        return boost::none;
+    }
+    if (discoveryQos.getProviderMustSupportOnChange() &&
+        !discoveryEntry->getQos().getSupportsOnChangeSubscriptions()) {
+        return boost::none;
+    }
+    return discoveryEntry;
+}
+
 template <class T>
 ProxyBuilder<T>* ProxyBuilder<T>::setMessagingQos(const MessagingQos& messagingQos) noexcept
 {
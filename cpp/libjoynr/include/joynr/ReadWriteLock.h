@@ -21,10 +21,19 @@
 
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
+
+#ifdef JOYNR_ENABLE_DISTRIBUTED_READ_WRITE_LOCK
+#include "joynr/DistributedReadWriteLock.h"
+#endif // JOYNR_ENABLE_DISTRIBUTED_READ_WRITE_LOCK
+
 namespace joynr
 {
 
+#ifdef JOYNR_ENABLE_DISTRIBUTED_READ_WRITE_LOCK
+using ReadWriteLock = DistributedReadWriteLock;
+#else
 using ReadWriteLock = boost::shared_mutex;
+#endif // JOYNR_ENABLE_DISTRIBUTED_READ_WRITE_LOCK
 using ReadLocker = boost::shared_lock<ReadWriteLock>;
 using WriteLocker = boost::unique_lock<ReadWriteLock>;
 
@@ -31,6 +31,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/optional.hpp>
 
+#include "joynr/CachedMessagingStub.h"
 #include "joynr/InProcessMessagingAddress.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
@@ -66,7 +67,8 @@ struct RoutingEntry
               address(),
               isGloballyVisible(true),
               expiryDateMs(std::numeric_limits<std::int64_t>::max()),
-              isSticky(false)
+              isSticky(false),
+              cachedMessagingStub(std::make_shared<CachedMessagingStub>())
     {
     }
 
@@ -79,7 +81,8 @@ struct RoutingEntry
               address(std::move(address)),
               isGloballyVisible(isGloballyVisible),
               expiryDateMs(std::move(expiryDateMs)),
-              isSticky(std::move(isSticky))
+              isSticky(std::move(isSticky)),
+              cachedMessagingStub(std::make_shared<CachedMessagingStub>())
     {
     }
 
@@ -134,6 +137,8 @@ struct RoutingEntry
     bool isGloballyVisible;
     std::int64_t expiryDateMs;
     bool isSticky; // true if entry should be protected from being purged
+    // shared by all copies of the entry, a new entry is created whenever the address changes
+    std::shared_ptr<CachedMessagingStub> cachedMessagingStub;
 };
 } // namespace routingtable
 
@@ -22,6 +22,8 @@
 #include <memory>
 
 #include "joynr/JoynrExport.h"
+#include "joynr/SchedulingPriority.h"
+#include "joynr/TimePoint.h"
 
 namespace joynr
 {
@@ -50,6 +52,18 @@ public:
      */
     virtual void run() = 0;
 
+    /**
+     * @brief Priority class used by @ref BlockingQueue to order pending work
+     * @return SchedulingPriority::Enum::NORMAL unless overridden
+     */
+    virtual SchedulingPriority::Enum getPriority() const;
+
+    /**
+     * @brief Deadline used by @ref BlockingQueue to order pending work of the same priority
+     * @return TimePoint::max() unless overridden, i.e. such work is taken in FIFO order
+     */
+    virtual TimePoint getDeadline() const;
+
 protected:
     /**
      * @brief Constructor
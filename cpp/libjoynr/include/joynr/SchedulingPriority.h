@@ -0,0 +1,62 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#ifndef SCHEDULINGPRIORITY_H
+#define SCHEDULINGPRIORITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace joynr
+{
+
+/**
+ * @brief Priority classes used when draining queued work.
+ *
+ * Lower values are served first. Within one class, work is served earliest deadline first.
+ */
+struct SchedulingPriority
+{
+    enum class Enum : std::uint8_t { HIGH = 0, NORMAL = 1, LOW = 2 };
+
+    static constexpr std::size_t NUMBER_OF_PRIORITIES = 3;
+
+    static std::size_t toIndex(const SchedulingPriority::Enum& value)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    static std::string getLiteral(const SchedulingPriority::Enum& value)
+    {
+        switch (value) {
+        case Enum::HIGH:
+            return "HIGH";
+        case Enum::NORMAL:
+            return "NORMAL";
+        case Enum::LOW:
+            return "LOW";
+        }
+        return "UNKNOWN";
+    }
+};
+
+} // namespace joynr
+
+#endif // SCHEDULINGPRIORITY_H
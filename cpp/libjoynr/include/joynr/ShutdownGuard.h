@@ -0,0 +1,90 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHUTDOWNGUARD_H
+#define SHUTDOWNGUARD_H
+
+#include <atomic>
+
+#include "joynr/DistributedReadWriteLock.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Lets many threads enter an object concurrently until the object is shut down.
+ *
+ * Replaces the combination of an isShuttingDown flag and a ReadWriteLock: a thread enters with
+ * enter() and keeps the returned Pass while it uses the guarded resources; shutdown() waits for
+ * all passes to be released and lets no thread enter afterwards. Entering only touches a reader
+ * counter of the calling thread's slot of a DistributedReadWriteLock, so concurrent entries do
+ * not contend on a shared cache line. A pass must be released by the thread which obtained it.
+ */
+class JOYNR_EXPORT ShutdownGuard
+{
+public:
+    class JOYNR_EXPORT Pass
+    {
+    public:
+        Pass();
+        Pass(Pass&& other) noexcept;
+        Pass& operator=(Pass&& other) noexcept;
+        ~Pass();
+
+        /**
+         * @return false if the guard has been shut down before the pass was requested
+         */
+        explicit operator bool() const;
+
+        /**
+         * @brief Leaves the guard before the pass goes out of scope.
+         */
+        void release();
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(Pass);
+        friend class ShutdownGuard;
+        explicit Pass(ShutdownGuard* guard);
+
+        ShutdownGuard* guard;
+    };
+
+    ShutdownGuard();
+    ~ShutdownGuard() = default;
+
+    Pass enter();
+
+    /**
+     * @brief Waits until all passes are released and rejects all further calls of enter().
+     */
+    void shutdown();
+
+    bool isShutDown() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ShutdownGuard);
+
+    DistributedReadWriteLock lock;
+    std::atomic<bool> shutDown;
+};
+
+} // namespace joynr
+
+#endif // SHUTDOWNGUARD_H
@@ -23,6 +23,7 @@
 #include <thread>
 
 #include <boost/asio/io_service.hpp>
+#include "joynr/BackPressureController.h"
 #include "joynr/Semaphore.h"
 #include "joynr/Logger.h"
 
@@ -83,6 +84,7 @@ public:
 private:
     static void runIOService(std::shared_ptr<SingleThreadedIOService> singleThreadedIOService)
     {
+        BackPressureController::markCurrentThreadAsInternal();
         singleThreadedIOService->ioService.run();
     }
 
@@ -0,0 +1,102 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef STARTUPSTAGES_H
+#define STARTUPSTAGES_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Runs the stages of a runtime startup as a dependency graph.
+ *
+ * Every stage is started on a thread of its own as soon as all stages it depends on have
+ * finished, with at most maxParallelStages stages running at the same time. Stages which do
+ * not depend on each other, e.g. loading different persistence files, thus run in parallel.
+ */
+class JOYNR_EXPORT StartupStages
+{
+public:
+    using Stage = std::function<void()>;
+    using StageDurations = std::vector<std::pair<std::string, std::chrono::microseconds>>;
+
+    /**
+     * @param name used in log messages
+     * @param maxParallelStages 1 runs the stages one after another
+     */
+    StartupStages(std::string name, std::size_t maxParallelStages);
+    ~StartupStages() = default;
+
+    /**
+     * @brief Adds a stage which is run after all given stages have finished. The dependencies
+     * have to be added before the stage.
+     * @throw JoynrRuntimeException if a stage with this name exists or a dependency is unknown
+     */
+    void add(std::string stageName, std::vector<std::string> dependencies, Stage stage);
+
+    /**
+     * @brief Runs all stages and blocks until they finished. If a stage throws, the stages
+     * depending on it are skipped and the first exception is rethrown once all running stages
+     * finished. Can only be called once.
+     */
+    void run();
+
+    /**
+     * @return the run time of every finished stage in the order the stages finished
+     */
+    const StageDurations& getStageDurations() const;
+
+    /**
+     * @return a number of parallel stages suitable for this machine
+     */
+    static std::size_t getDefaultMaxParallelStages();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(StartupStages);
+
+    struct StageNode
+    {
+        std::string name;
+        std::vector<std::size_t> dependents;
+        std::size_t pendingDependencies;
+        Stage stage;
+    };
+
+    const std::string name;
+    const std::size_t maxParallelStages;
+    std::vector<StageNode> stages;
+    StageDurations stageDurations;
+    bool hasRun;
+
+    ADD_LOGGER(StartupStages)
+};
+
+} // namespace joynr
+
+#endif // STARTUPSTAGES_H
@@ -97,7 +97,7 @@ private:
     /*! Worker threads */
     std::vector<std::thread> threads;
 
-    /*! FIFO queue of work that could be done right now */
+    /*! Priority queue of work that could be done right now */
     BlockingQueue scheduler;
 
     /*! Flag indicating @ref threads to keep running */
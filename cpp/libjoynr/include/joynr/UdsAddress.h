@@ -0,0 +1,100 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef UDSADDRESS_H
+#define UDSADDRESS_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/system/RoutingTypes/Address.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Address of a cluster controller which accepts libjoynr runtimes on a unix domain
+ * socket. It is only used within the libjoynr runtime which connects to this socket and is
+ * never sent to the cluster controller; the libjoynr runtime itself is still addressed by its
+ * WebSocketClientAddress.
+ */
+class JOYNR_EXPORT UdsAddress : public joynr::system::RoutingTypes::Address
+{
+public:
+    UdsAddress() = default;
+    explicit UdsAddress(std::string path) : Address(), path(std::move(path))
+    {
+    }
+
+    const std::string& getPath() const
+    {
+        return path;
+    }
+
+    std::string toString() const override
+    {
+        return "UdsAddress{path:" + path + "}";
+    }
+
+    std::size_t hashCode() const override
+    {
+        return std::hash<std::string>()(path);
+    }
+
+    std::unique_ptr<joynr::system::RoutingTypes::Address> clone() const override
+    {
+        return std::make_unique<UdsAddress>(*this);
+    }
+
+    template <typename Archive>
+    void serialize(Archive& archive)
+    {
+        archive(MUESLI_NVP(path));
+    }
+
+    bool equals(const joynr::system::RoutingTypes::Address& other,
+                std::size_t maxUlps) const override
+    {
+        if (typeid(*this) != typeid(other)) {
+            return false;
+        }
+        return this->equalsInternal(other, maxUlps);
+    }
+
+protected:
+    bool equalsInternal(const joynr::system::RoutingTypes::Address& otherBase,
+                        std::size_t maxUlps) const override
+    {
+        const UdsAddress& other = static_cast<const UdsAddress&>(otherBase);
+        return this->path == other.path && Address::equalsInternal(other, maxUlps);
+    }
+
+private:
+    std::string path;
+};
+
+} // namespace joynr
+
+MUESLI_REGISTER_POLYMORPHIC_TYPE(joynr::UdsAddress,
+                                 joynr::system::RoutingTypes::Address,
+                                 "joynr.UdsAddress")
+
+#endif // UDSADDRESS_H
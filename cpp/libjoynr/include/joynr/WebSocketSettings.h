@@ -20,6 +20,7 @@
 #define WEBSOCKETSETTINGS_H
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 #include "joynr/Logger.h"
@@ -41,7 +42,14 @@ class WebSocketSettings
 {
 public:
     static const std::string& SETTING_CC_MESSAGING_URL();
+    static const std::string& SETTING_CC_MESSAGING_UDS_PATH();
     static const std::string& SETTING_RECONNECT_SLEEP_TIME_MS();
+    static const std::string& SETTING_RECONNECT_MAX_SLEEP_TIME_MS();
+    static const std::string& SETTING_SEND_QUEUE_SIZE();
+    static const std::string& SETTING_SHARED_MEMORY_RING_SIZE();
+    static const std::string& SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS();
+    static const std::string& SETTING_COALESCING_MAX_BYTES();
+    static const std::string& SETTING_COALESCING_MAX_DELAY_US();
     static const std::string& SETTING_CERTIFICATE_AUTHORITY_PEM_FILENAME();
     static const std::string& SETTING_CERTIFICATE_PEM_FILENAME();
     static const std::string& SETTING_PRIVATE_KEY_PEM_FILENAME();
@@ -59,9 +67,55 @@ public:
     void setClusterControllerMessagingUrl(const std::string& url);
     system::RoutingTypes::WebSocketAddress createClusterControllerMessagingAddress() const;
 
+    /**
+     * @brief If a unix domain socket path is set, the libjoynr runtime connects to the cluster
+     * controller via this socket instead of the WebSocket url.
+     */
+    std::string getClusterControllerMessagingUdsPath() const;
+    void setClusterControllerMessagingUdsPath(const std::string& path);
+
+    /**
+     * @brief If the ring size is greater than zero, the libjoynr runtime offers a shared memory
+     * channel with two rings of this size (in bytes, rounded up to a power of two) to the cluster
+     * controller. Messages are exchanged via shared memory if the cluster controller attaches to
+     * it within the attach timeout, otherwise the WebSocket connection is used.
+     */
+    std::uint64_t getSharedMemoryRingSize() const;
+    void setSharedMemoryRingSize(std::uint64_t ringSize);
+
+    std::chrono::milliseconds getSharedMemoryAttachTimeoutMs() const;
+    void setSharedMemoryAttachTimeoutMs(const std::chrono::milliseconds attachTimeoutMs);
+
+    /**
+     * @brief If greater than zero, the libjoynr runtime offers the cluster controller to pack
+     * messages which are sent in short succession into one WebSocket frame of at most this size
+     * (in bytes). A frame is sent at the latest after the coalescing delay.
+     */
+    std::uint32_t getCoalescingMaxBytes() const;
+    void setCoalescingMaxBytes(std::uint32_t maxBytes);
+
+    std::chrono::microseconds getCoalescingMaxDelayUs() const;
+    void setCoalescingMaxDelayUs(const std::chrono::microseconds maxDelayUs);
+
     std::chrono::milliseconds getReconnectSleepTimeMs() const;
     void setReconnectSleepTimeMs(const std::chrono::milliseconds reconnectSleepTimeMs);
 
+    /**
+     * @brief Upper limit of the sleep time between reconnect attempts. Starting at the reconnect
+     * sleep time, the limit doubles after every failed attempt up to this value; the actual sleep
+     * time is chosen randomly between half of the limit and the limit.
+     */
+    std::chrono::milliseconds getReconnectMaxSleepTimeMs() const;
+    void setReconnectMaxSleepTimeMs(const std::chrono::milliseconds reconnectMaxSleepTimeMs);
+
+    /**
+     * @brief Maximum number of messages the libjoynr runtime holds while it is not connected to
+     * the cluster controller. Queued messages are sent in order right after (re)connecting. If
+     * zero, messages fail immediately and are retried by the message router.
+     */
+    std::uint32_t getSendQueueSize() const;
+    void setSendQueueSize(std::uint32_t sendQueueSize);
+
     bool getEncryptedTlsUsage() const;
     void setEncryptedTlsUsage(bool encryptedTls);
 
@@ -29,6 +29,7 @@
 #include <boost/asio/io_service.hpp>
 #include <spdlog/fmt/fmt.h>
 
+#include "joynr/BackPressureController.h"
 #include "joynr/IMessagingStub.h"
 #include "joynr/IMessagingStubFactory.h"
 #include "joynr/ImmutableMessage.h"
@@ -83,6 +84,7 @@ AbstractMessageRouter::AbstractMessageRouter(
           messageQueueCleanerTimerPeriodMs(std::chrono::milliseconds(1000)),
           routingTableCleanerTimer(ioService),
           transportStatuses(std::move(transportStatuses)),
+          backPressureController(),
           isShuttingDown(false),
           numberOfRoutedMessages(0),
           maxAclRetryIntervalMs(
@@ -134,32 +136,30 @@ void AbstractMessageRouter::addProvisionedNextHop(
     addToRoutingTable(participantId, isGloballyVisible, address, expiryDateMs, isSticky);
 }
 
-AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::lookupAddresses(
+AbstractMessageRouter::AddressUnorderedMap AbstractMessageRouter::lookupAddresses(
         const std::unordered_set<std::string>& participantIds)
 {
     // Caution: Do not lock routingTableLock here, it must have been locked from outside
     // this method gets called from getDestinationAddresses()
-    AbstractMessageRouter::AddressUnorderedSet addresses;
+    AbstractMessageRouter::AddressUnorderedMap addresses;
 
-    std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress;
     for (const auto& participantId : participantIds) {
         const auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(participantId);
         if (routingEntry) {
-            destAddress = routingEntry->address;
-            addresses.insert(destAddress);
+            addresses.emplace(routingEntry->address, routingEntry->cachedMessagingStub);
         }
     }
     assert(addresses.size() <= participantIds.size());
     return addresses;
 }
 
-AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::getDestinationAddresses(
+AbstractMessageRouter::AddressUnorderedMap AbstractMessageRouter::getDestinationAddresses(
         const ImmutableMessage& message,
         const ReadLocker& messageQueueRetryReadLock)
 {
     assert(messageQueueRetryReadLock.owns_lock());
     ReadLocker lock(routingTableLock);
-    AbstractMessageRouter::AddressUnorderedSet addresses;
+    AbstractMessageRouter::AddressUnorderedMap addresses;
     if (message.getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
         const std::string& multicastId = message.getRecipient();
 
@@ -174,14 +174,14 @@ AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::getDestination
             std::shared_ptr<const joynr::system::RoutingTypes::Address> globalTransport =
                     addressCalculator->compute(message);
             if (globalTransport) {
-                addresses.insert(std::move(globalTransport));
+                addresses.emplace(std::move(globalTransport), nullptr);
             }
         }
     } else {
         const std::string& destinationPartId = message.getRecipient();
         const auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(destinationPartId);
         if (routingEntry) {
-            addresses.insert(routingEntry->address);
+            addresses.emplace(routingEntry->address, routingEntry->cachedMessagingStub);
         }
     }
     return addresses;
@@ -213,7 +213,7 @@ void AbstractMessageRouter::registerGlobalRoutingEntryIfRequired(const Immutable
         messageType == Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST() ||
         messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()) {
 
-        boost::optional<std::string> optionalReplyTo = message.getReplyTo();
+        boost::optional<const std::string&> optionalReplyTo = message.getReplyToView();
 
         if (!optionalReplyTo) {
             std::string errorMessage("message " + message.getTrackingInfo() +
@@ -254,9 +254,19 @@ void AbstractMessageRouter::route(std::shared_ptr<ImmutableMessage> message, std
     assert(message);
     numberOfRoutedMessages++;
     checkExpiryDate(*message);
+    if (backPressureController && !message->hasBackPressureReservation()) {
+        message->setBackPressureReservation(
+                backPressureController->reserve(std::string(), message->getMessageSize()));
+    }
     routeInternal(std::move(message), tryCount);
 }
 
+void AbstractMessageRouter::setBackPressureController(
+        std::shared_ptr<BackPressureController> backPressureController)
+{
+    this->backPressureController = std::move(backPressureController);
+}
+
 // following method may be overridden by subclass
 void AbstractMessageRouter::setToKnown(const std::string& participantId)
 {
@@ -283,11 +293,13 @@ void AbstractMessageRouter::sendQueuedMessages(
 void AbstractMessageRouter::doAccessControlCheckOrScheduleMessage(
         std::shared_ptr<ImmutableMessage> message,
         std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress,
-        std::uint32_t tryCount)
+        std::uint32_t tryCount,
+        std::shared_ptr<CachedMessagingStub> cachedStub)
 {
     std::ignore = message;
     std::ignore = destAddress;
     std::ignore = tryCount;
+    std::ignore = cachedStub;
     // no implementation needed when this method is called by LibjoynrMessageRouter
 }
 
@@ -295,7 +307,8 @@ void AbstractMessageRouter::scheduleMessage(
         std::shared_ptr<ImmutableMessage> message,
         std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress,
         std::uint32_t tryCount,
-        std::chrono::milliseconds delay)
+        std::chrono::milliseconds delay,
+        std::shared_ptr<CachedMessagingStub> cachedStub)
 {
     for (const auto& transportStatus : transportStatuses) {
         if (transportStatus->isReponsibleFor(destAddress)) {
@@ -314,7 +327,8 @@ void AbstractMessageRouter::scheduleMessage(
         }
     }
 
-    auto stub = messagingStubFactory->create(destAddress);
+    auto stub = cachedStub ? messagingStubFactory->createCached(destAddress, *cachedStub)
+                           : messagingStubFactory->create(destAddress);
     if (stub) {
         messageScheduler->schedule(std::make_shared<MessageRunnable>(std::move(message),
                                                                      std::move(stub),
@@ -480,10 +494,10 @@ void AbstractMessageRouter::loadRoutingTable(std::string fileName)
     }
 }
 
-void AbstractMessageRouter::saveRoutingTable()
+bool AbstractMessageRouter::saveRoutingTable()
 {
     if (!persistRoutingTable) {
-        return;
+        return true;
     }
     WriteLocker lock(routingTableLock);
     try {
@@ -491,7 +505,9 @@ void AbstractMessageRouter::saveRoutingTable()
                 routingTableFileName, joynr::serializer::serializeToJson(routingTable));
     } catch (const std::runtime_error& ex) {
         JOYNR_LOG_INFO(logger(), ex.what());
+        return false;
     }
+    return true;
 }
 
 void AbstractMessageRouter::addToRoutingTable(
@@ -509,48 +525,7 @@ void AbstractMessageRouter::addToRoutingTable(
     }
     {
         WriteLocker lock(routingTableLock);
-        auto oldRoutingEntry = routingTable.lookupRoutingEntryByParticipantId(participantId);
-        if (oldRoutingEntry) {
-            const bool addressOrVisibilityOfRoutingEntryChanged =
-                    (!oldRoutingEntry->address->equals(*address, joynr::util::MAX_ULPS)) ||
-                    (oldRoutingEntry->isGloballyVisible != isGloballyVisible);
-            if (addressOrVisibilityOfRoutingEntryChanged) {
-                if (oldRoutingEntry->isSticky) {
-                    JOYNR_LOG_ERROR(
-                            logger(),
-                            "unable to update participantId={} in routing table, since "
-                            "the participantId is already associated with STICKY routing entry {}.",
-                            participantId,
-                            oldRoutingEntry->toString());
-                    return;
-                }
-                if (!allowRoutingEntryUpdate(*oldRoutingEntry, *address)) {
-                    JOYNR_LOG_WARN(logger(),
-                                   "unable to update participantId={} in routing table, since "
-                                   "the participantId is already associated with routing entry {}.",
-                                   participantId,
-                                   oldRoutingEntry->toString());
-                    return;
-                }
-                JOYNR_LOG_TRACE(
-                        logger(), "updating participantId={} in routing table", participantId);
-            } else {
-                JOYNR_LOG_TRACE(
-                        logger(),
-                        "Updating expiryDate and sticky-flag of participantId={} in routing table.",
-                        participantId);
-            }
-            // keep longest lifetime
-            if (oldRoutingEntry->expiryDateMs > expiryDateMs) {
-                expiryDateMs = oldRoutingEntry->expiryDateMs;
-            }
-            if (oldRoutingEntry->isSticky) {
-                isSticky = true;
-            }
-        }
-        // manual removal of old entry is not required here since routingTable.add() automatically
-        // calls replace in case insert fails
-        routingTable.add(
+        addToRoutingTableLocked(
                 std::move(participantId), isGloballyVisible, address, expiryDateMs, isSticky);
     }
     const joynr::InProcessMessagingAddress* inprocessAddress =
@@ -560,6 +535,84 @@ void AbstractMessageRouter::addToRoutingTable(
     }
 }
 
+bool AbstractMessageRouter::addToRoutingTable(
+        const std::vector<std::string>& participantIds,
+        bool isGloballyVisible,
+        std::shared_ptr<const joynr::system::RoutingTypes::Address> address,
+        std::int64_t expiryDateMs,
+        bool isSticky)
+{
+    if (!isValidForRoutingTable(address)) {
+        JOYNR_LOG_TRACE(logger(),
+                        "{} participantIds have an unsupported address within this process",
+                        participantIds.size());
+        return true;
+    }
+    {
+        WriteLocker lock(routingTableLock);
+        for (const std::string& participantId : participantIds) {
+            addToRoutingTableLocked(
+                    participantId, isGloballyVisible, address, expiryDateMs, isSticky);
+        }
+    }
+    const joynr::InProcessMessagingAddress* inprocessAddress =
+            dynamic_cast<const joynr::InProcessMessagingAddress*>(address.get());
+    if (!inprocessAddress) {
+        return saveRoutingTable();
+    }
+    return true;
+}
+
+void AbstractMessageRouter::addToRoutingTableLocked(
+        std::string participantId,
+        bool isGloballyVisible,
+        const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+        std::int64_t expiryDateMs,
+        bool isSticky)
+{
+    auto oldRoutingEntry = routingTable.lookupRoutingEntryByParticipantId(participantId);
+    if (oldRoutingEntry) {
+        const bool addressOrVisibilityOfRoutingEntryChanged =
+                (!oldRoutingEntry->address->equals(*address, joynr::util::MAX_ULPS)) ||
+                (oldRoutingEntry->isGloballyVisible != isGloballyVisible);
+        if (addressOrVisibilityOfRoutingEntryChanged) {
+            if (oldRoutingEntry->isSticky) {
+                JOYNR_LOG_ERROR(
+                        logger(),
+                        "unable to update participantId={} in routing table, since "
+                        "the participantId is already associated with STICKY routing entry {}.",
+                        participantId,
+                        oldRoutingEntry->toString());
+                return;
+            }
+            if (!allowRoutingEntryUpdate(*oldRoutingEntry, *address)) {
+                JOYNR_LOG_WARN(logger(),
+                               "unable to update participantId={} in routing table, since "
+                               "the participantId is already associated with routing entry {}.",
+                               participantId,
+                               oldRoutingEntry->toString());
+                return;
+            }
+            JOYNR_LOG_TRACE(logger(), "updating participantId={} in routing table", participantId);
+        } else {
+            JOYNR_LOG_TRACE(
+                    logger(),
+                    "Updating expiryDate and sticky-flag of participantId={} in routing table.",
+                    participantId);
+        }
+        // keep longest lifetime
+        if (oldRoutingEntry->expiryDateMs > expiryDateMs) {
+            expiryDateMs = oldRoutingEntry->expiryDateMs;
+        }
+        if (oldRoutingEntry->isSticky) {
+            isSticky = true;
+        }
+    }
+    // manual removal of old entry is not required here since routingTable.add() automatically
+    // calls replace in case insert fails
+    routingTable.add(std::move(participantId), isGloballyVisible, address, expiryDateMs, isSticky);
+}
+
 std::uint64_t AbstractMessageRouter::getNumberOfRoutedMessages() const
 {
     return numberOfRoutedMessages;
@@ -626,48 +679,54 @@ void MessageRunnable::shutdown()
 {
 }
 
+SchedulingPriority::Enum MessageRunnable::getPriority() const
+{
+    return message->getSchedulingPriority();
+}
+
+TimePoint MessageRunnable::getDeadline() const
+{
+    return decayTime;
+}
+
 void MessageRunnable::run()
 {
     if (!isExpired()) {
-        // TODO is it safe to capture (this) here? rather capture members by value!
-        auto onFailure = [thisWeakPtr = joynr::util::as_weak_ptr(
-                                  std::dynamic_pointer_cast<MessageRunnable>(shared_from_this()))](
-                const exceptions::JoynrRuntimeException& e)
+        // captures the members by value: the message may be queued by the messaging stub and
+        // fail after this runnable has been released, it is rescheduled nevertheless
+        auto onFailure = [
+            message = this->message,
+            destAddress = this->destAddress,
+            messageRouter = this->messageRouter,
+            tryCount = this->tryCount
+        ](const exceptions::JoynrRuntimeException& e)
         {
-            if (auto thisSharedPtr = thisWeakPtr.lock()) {
-                try {
-                    exceptions::JoynrDelayMessageException& delayException =
-                            dynamic_cast<exceptions::JoynrDelayMessageException&>(
-                                    const_cast<exceptions::JoynrRuntimeException&>(e));
-                    std::chrono::milliseconds delay = delayException.getDelayMs();
-
-                    if (auto messageRouterSharedPtr = thisSharedPtr->messageRouter.lock()) {
-                        JOYNR_LOG_TRACE(
-                                logger(),
-                                "Rescheduling message after error: message {}, new delay {}ms, "
-                                "reason: {}",
-                                thisSharedPtr->message->getTrackingInfo(),
-                                delay.count(),
-                                e.getMessage());
-                        messageRouterSharedPtr->scheduleMessage(thisSharedPtr->message,
-                                                                thisSharedPtr->destAddress,
-                                                                thisSharedPtr->tryCount + 1,
-                                                                delay);
-                    } else {
-                        JOYNR_LOG_ERROR(logger(),
-                                        "Message {} could not be sent! reason: messageRouter "
-                                        "not available",
-                                        thisSharedPtr->message->getTrackingInfo());
-                    }
-                } catch (const std::bad_cast&) {
-                    JOYNR_LOG_ERROR(logger(),
-                                    "Message {} could not be sent! reason: {}",
-                                    thisSharedPtr->message->getTrackingInfo(),
+            try {
+                exceptions::JoynrDelayMessageException& delayException =
+                        dynamic_cast<exceptions::JoynrDelayMessageException&>(
+                                const_cast<exceptions::JoynrRuntimeException&>(e));
+                std::chrono::milliseconds delay = delayException.getDelayMs();
+
+                if (auto messageRouterSharedPtr = messageRouter.lock()) {
+                    JOYNR_LOG_TRACE(logger(),
+                                    "Rescheduling message after error: message {}, new delay {}ms, "
+                                    "reason: {}",
+                                    message->getTrackingInfo(),
+                                    delay.count(),
                                     e.getMessage());
+                    messageRouterSharedPtr->scheduleMessage(
+                            message, destAddress, tryCount + 1, delay);
+                } else {
+                    JOYNR_LOG_ERROR(logger(),
+                                    "Message {} could not be sent! reason: messageRouter "
+                                    "not available",
+                                    message->getTrackingInfo());
                 }
-            } else {
+            } catch (const std::bad_cast&) {
                 JOYNR_LOG_ERROR(logger(),
-                                "Message could not be sent! reason: MessageRunnable not available");
+                                "Message {} could not be sent! reason: {}",
+                                message->getTrackingInfo(),
+                                e.getMessage());
             }
         };
 
@@ -0,0 +1,228 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/BackPressureController.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+namespace
+{
+thread_local bool isInternalThread = false;
+} // namespace
+
+std::string BackPressurePolicy::getLiteral(const BackPressurePolicy::Enum& value)
+{
+    switch (value) {
+    case Enum::DISABLED:
+        return "DISABLED";
+    case Enum::BLOCK:
+        return "BLOCK";
+    case Enum::FAIL_FAST:
+        return "FAIL_FAST";
+    case Enum::NOTIFY:
+        return "NOTIFY";
+    default:
+        throw exceptions::JoynrRuntimeException("Invalid back-pressure policy value");
+    }
+}
+
+BackPressurePolicy::Enum BackPressurePolicy::getEnum(const std::string& policyString)
+{
+    if (policyString == "DISABLED") {
+        return Enum::DISABLED;
+    }
+    if (policyString == "BLOCK") {
+        return Enum::BLOCK;
+    }
+    if (policyString == "FAIL_FAST") {
+        return Enum::FAIL_FAST;
+    }
+    if (policyString == "NOTIFY") {
+        return Enum::NOTIFY;
+    }
+    throw std::invalid_argument(policyString + " is unknown literal for BackPressurePolicy");
+}
+
+BackPressureReservation::BackPressureReservation(std::weak_ptr<BackPressureController> controller,
+                                                 std::string clientId,
+                                                 std::uint64_t bytes)
+        : controller(std::move(controller)), clientId(std::move(clientId)), bytes(bytes)
+{
+}
+
+BackPressureReservation::~BackPressureReservation()
+{
+    if (auto controllerSharedPtr = controller.lock()) {
+        controllerSharedPtr->release(clientId, bytes);
+    }
+}
+
+BackPressureController::BackPressureController(BackPressurePolicy::Enum policy,
+                                               std::uint64_t highWatermarkBytes,
+                                               std::uint64_t lowWatermarkBytes,
+                                               std::chrono::milliseconds maxBlockingTime,
+                                               boost::asio::io_service& ioService,
+                                               std::uint64_t perClientQuotaBytes)
+        : policy(policy),
+          highWatermarkBytes(highWatermarkBytes),
+          lowWatermarkBytes((lowWatermarkBytes == 0 || lowWatermarkBytes > highWatermarkBytes)
+                                    ? highWatermarkBytes - highWatermarkBytes / 4
+                                    : lowWatermarkBytes),
+          maxBlockingTime(maxBlockingTime),
+          perClientQuotaBytes(perClientQuotaBytes),
+          ioService(ioService),
+          mutex(),
+          drained(),
+          pendingBytes(0),
+          pendingBytesPerClient(),
+          saturated(false),
+          readyCallbacks()
+{
+}
+
+std::shared_ptr<BackPressureReservation> BackPressureController::reserve(
+        const std::string& clientId,
+        std::uint64_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!clientId.empty()) {
+            std::uint64_t& clientBytes = pendingBytesPerClient[clientId];
+            if (perClientQuotaBytes > 0 && clientBytes + bytes > perClientQuotaBytes) {
+                JOYNR_LOG_WARN(logger(),
+                               "client {} exceeds its quota of {} bytes ({} bytes pending)",
+                               clientId,
+                               perClientQuotaBytes,
+                               clientBytes);
+                if (clientBytes == 0) {
+                    pendingBytesPerClient.erase(clientId);
+                }
+                return nullptr;
+            }
+            clientBytes += bytes;
+        }
+        pendingBytes += bytes;
+        if (!saturated && highWatermarkBytes > 0 && pendingBytes >= highWatermarkBytes) {
+            JOYNR_LOG_WARN(logger(),
+                           "message router saturated: {} bytes pending, high watermark {}",
+                           pendingBytes,
+                           highWatermarkBytes);
+            saturated = true;
+        }
+    }
+    return std::make_shared<BackPressureReservation>(shared_from_this(), clientId, bytes);
+}
+
+void BackPressureController::release(const std::string& clientId, std::uint64_t bytes)
+{
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!clientId.empty()) {
+            auto it = pendingBytesPerClient.find(clientId);
+            if (it != pendingBytesPerClient.end()) {
+                it->second -= std::min(it->second, bytes);
+                if (it->second == 0) {
+                    pendingBytesPerClient.erase(it);
+                }
+            }
+        }
+        pendingBytes -= std::min(pendingBytes, bytes);
+        if (!saturated || pendingBytes > lowWatermarkBytes) {
+            return;
+        }
+        JOYNR_LOG_INFO(logger(), "message router drained: {} bytes pending", pendingBytes);
+        saturated = false;
+        callbacks.swap(readyCallbacks);
+    }
+    drained.notify_all();
+    // the releasing thread may be destroying a message while holding locks of the router
+    for (auto& callback : callbacks) {
+        ioService.post(std::move(callback));
+    }
+}
+
+void BackPressureController::admit()
+{
+    if (policy == BackPressurePolicy::Enum::DISABLED ||
+        policy == BackPressurePolicy::Enum::NOTIFY) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!saturated) {
+        return;
+    }
+    if (policy == BackPressurePolicy::Enum::FAIL_FAST || isInternalThread) {
+        throw exceptions::JoynrMessageNotSentException(
+                "message router saturated: " + std::to_string(pendingBytes) + " bytes pending");
+    }
+    if (!drained.wait_for(lock, maxBlockingTime, [this]() { return !saturated; })) {
+        throw exceptions::JoynrMessageNotSentException(
+                "message router did not drain within " +
+                std::to_string(maxBlockingTime.count()) + " ms");
+    }
+}
+
+void BackPressureController::markCurrentThreadAsInternal()
+{
+    isInternalThread = true;
+}
+
+bool BackPressureController::isSaturated() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return saturated;
+}
+
+void BackPressureController::notifyWhenReady(std::function<void()> callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (saturated) {
+            readyCallbacks.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+std::uint64_t BackPressureController::getPendingBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pendingBytes;
+}
+
+std::uint64_t BackPressureController::getPendingBytes(const std::string& clientId) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = pendingBytesPerClient.find(clientId);
+    return it == pendingBytesPerClient.cend() ? 0 : it->second;
+}
+
+BackPressurePolicy::Enum BackPressureController::getPolicy() const
+{
+    return policy;
+}
+
+} // namespace joynr
@@ -22,6 +22,7 @@
 #include "boost/algorithm/string.hpp"
 
 #include "joynr/Message.h"
+#include "joynr/MessagingQosEffort.h"
 
 namespace joynr
 {
@@ -30,12 +31,16 @@ ImmutableMessage::ImmutableMessage(smrf::ByteVector&& serializedMessage, bool ve
         : serializedMessage(std::move(serializedMessage)),
           messageDeserializer(smrf::ByteArrayView(this->serializedMessage), verifyInput),
           headers(),
+          headerIndex(),
+          sender(),
+          recipient(),
+          schedulingPriority(SchedulingPriority::Enum::NORMAL),
           bodyView(),
           decompressedBody(),
           receivedFromGlobal(false),
           accessControlChecked(false),
-          creator(),
-          requiredHeaders()
+          backPressureReservation(),
+          creator()
 {
     init();
 }
@@ -44,24 +49,49 @@ ImmutableMessage::ImmutableMessage(const smrf::ByteVector& serializedMessage, bo
         : serializedMessage(serializedMessage),
           messageDeserializer(smrf::ByteArrayView(this->serializedMessage), verifyInput),
           headers(),
+          headerIndex(),
+          sender(),
+          recipient(),
+          schedulingPriority(SchedulingPriority::Enum::NORMAL),
           bodyView(),
           decompressedBody(),
           receivedFromGlobal(false),
           accessControlChecked(false),
-          creator(),
-          requiredHeaders()
+          backPressureReservation(),
+          creator()
 {
     init();
 }
 
-std::string ImmutableMessage::getSender() const
+ImmutableMessage::ImmutableMessage(smrf::ByteVector&& serializedMessage,
+                                   std::unordered_map<std::string, std::string>&& headers,
+                                   const std::string& sender,
+                                   const std::string& recipient)
+        : serializedMessage(std::move(serializedMessage)),
+          messageDeserializer(smrf::ByteArrayView(this->serializedMessage), false),
+          headers(std::move(headers)),
+          headerIndex(),
+          sender(sender),
+          recipient(recipient),
+          schedulingPriority(SchedulingPriority::Enum::NORMAL),
+          bodyView(),
+          decompressedBody(),
+          receivedFromGlobal(false),
+          accessControlChecked(false),
+          backPressureReservation(),
+          creator()
+{
+    indexHeaders();
+}
+
+const std::string& ImmutableMessage::getSender() const
 {
-    return messageDeserializer.getSender();
+    return sender;
 }
 
-std::string ImmutableMessage::getRecipient() const
+const std::string& ImmutableMessage::getRecipient() const
 {
-    return messageDeserializer.getRecipient();
+    return recipient;
 }
 
 bool ImmutableMessage::isTtlAbsolute() const
@@ -76,21 +106,15 @@ const std::unordered_map<std::string, std::string>& ImmutableMessage::getHeaders
 
 std::unordered_map<std::string, std::string> ImmutableMessage::getCustomHeaders() const
 {
-    if (headers.size() <= RequiredHeaders::NUM_REQUIRED_HEADERS) {
-        return std::unordered_map<std::string, std::string>();
+    std::unordered_map<std::string, std::string> result;
+    if (headerIndex.customHeaders.empty()) {
+        return result;
     }
 
     static std::size_t CUSTOM_HEADER_PREFIX_LENGTH = Message::CUSTOM_HEADER_PREFIX().length();
-    std::unordered_map<std::string, std::string> result;
-
-    for (const auto& headersPair : headers) {
-        const std::string& headerName = headersPair.first;
-
-        if (isCustomHeaderKey(headerName)) {
-            std::string headerNameWithoutPrefix = headerName.substr(CUSTOM_HEADER_PREFIX_LENGTH);
-
-            result.insert({std::move(headerNameWithoutPrefix), headersPair.second});
-        }
+    result.reserve(headerIndex.customHeaders.size());
+    for (const MessageHeaderIndex::HeaderEntry* entry : headerIndex.customHeaders) {
+        result.insert({entry->first.substr(CUSTOM_HEADER_PREFIX_LENGTH), entry->second});
     }
 
     return result;
@@ -98,18 +122,14 @@ std::unordered_map<std::string, std::string> ImmutableMessage::getCustomHeaders(
 
 std::unordered_map<std::string, std::string> ImmutableMessage::getPrefixedCustomHeaders() const
 {
-    if (headers.size() <= RequiredHeaders::NUM_REQUIRED_HEADERS) {
-        return std::unordered_map<std::string, std::string>();
-    }
-
     std::unordered_map<std::string, std::string> result;
+    if (headerIndex.customHeaders.empty()) {
+        return result;
+    }
 
-    for (const auto& headersPair : headers) {
-        const std::string& headerName = headersPair.first;
-
-        if (isCustomHeaderKey(headerName)) {
-            result.insert({headersPair.first, headersPair.second});
-        }
+    result.reserve(headerIndex.customHeaders.size());
+    for (const MessageHeaderIndex::HeaderEntry* entry : headerIndex.customHeaders) {
+        result.insert(*entry);
     }
 
     return result;
@@ -150,22 +170,46 @@ std::string ImmutableMessage::toLogMessage() const
 
 const std::string& ImmutableMessage::getType() const
 {
-    return requiredHeaders.type;
+    return *headerIndex.type;
 }
 
 const std::string& ImmutableMessage::getId() const
 {
-    return requiredHeaders.id;
+    return *headerIndex.id;
 }
 
 boost::optional<std::string> ImmutableMessage::getReplyTo() const
 {
-    return getOptionalHeaderByKey(Message::HEADER_REPLY_TO());
+    boost::optional<std::string> value;
+    if (headerIndex.replyTo) {
+        value = *headerIndex.replyTo;
+    }
+    return value;
 }
 
 boost::optional<std::string> ImmutableMessage::getEffort() const
 {
-    return getOptionalHeaderByKey(Message::HEADER_EFFORT());
+    boost::optional<std::string> value;
+    if (headerIndex.effort) {
+        value = *headerIndex.effort;
+    }
+    return value;
+}
+
+boost::optional<const std::string&> ImmutableMessage::getReplyToView() const
+{
+    return toOptional(headerIndex.replyTo);
+}
+
+boost::optional<const std::string&> ImmutableMessage::getEffortView() const
+{
+    return toOptional(headerIndex.effort);
+}
+
+boost::optional<const std::string&> ImmutableMessage::getHeaderView(const std::string& key) const
+{
+    auto it = headers.find(key);
+    return toOptional(it != headers.cend() ? &it->second : nullptr);
 }
 
 TimePoint ImmutableMessage::getExpiryDate() const
@@ -175,6 +219,11 @@ TimePoint ImmutableMessage::getExpiryDate() const
     return TimePoint::fromAbsoluteMs(messageDeserializer.getTtlMs());
 }
 
+SchedulingPriority::Enum ImmutableMessage::getSchedulingPriority() const
+{
+    return schedulingPriority;
+}
+
 const smrf::ByteVector& ImmutableMessage::getSerializedMessage() const
 {
     return serializedMessage;
@@ -200,6 +249,17 @@ void ImmutableMessage::setReceivedFromGlobal(bool receivedFromGlobal)
     this->receivedFromGlobal = receivedFromGlobal;
 }
 
+void ImmutableMessage::setBackPressureReservation(
+        std::shared_ptr<BackPressureReservation> reservation)
+{
+    backPressureReservation = std::move(reservation);
+}
+
+bool ImmutableMessage::hasBackPressureReservation() const
+{
+    return backPressureReservation != nullptr;
+}
+
 void ImmutableMessage::setCreator(const std::string& creator)
 {
     this->creator = creator;
@@ -215,31 +275,66 @@ const std::string& ImmutableMessage::getCreator() const
     return creator;
 }
 
-boost::optional<std::string> ImmutableMessage::getOptionalHeaderByKey(const std::string& key) const
+boost::optional<const std::string&> ImmutableMessage::toOptional(const std::string* value)
 {
-    boost::optional<std::string> value;
-    auto it = headers.find(key);
-    if (it != headers.cend()) {
-        value = it->second;
+    if (value) {
+        return boost::optional<const std::string&>(*value);
     }
-    return value;
+    return boost::none;
 }
 
 void ImmutableMessage::init()
 {
+    sender = messageDeserializer.getSender();
+    recipient = messageDeserializer.getRecipient();
     headers = messageDeserializer.getHeaders();
-    boost::optional<std::string> optionalId = getOptionalHeaderByKey(Message::HEADER_ID());
-    boost::optional<std::string> optionalType = getOptionalHeaderByKey(Message::HEADER_TYPE());
-
-    JOYNR_LOG_TRACE(logger(), "init: {}", toLogMessage());
+    indexHeaders();
+}
+
+void ImmutableMessage::indexHeaders()
+{
+    // single pass over the headers; all later header accesses use the index
+    for (const auto& entry : headers) {
+        const std::string& key = entry.first;
+        if (key == Message::HEADER_ID()) {
+            headerIndex.id = &entry.second;
+        } else if (key == Message::HEADER_TYPE()) {
+            headerIndex.type = &entry.second;
+        } else if (key == Message::HEADER_EFFORT()) {
+            headerIndex.effort = &entry.second;
+        } else if (key == Message::HEADER_REPLY_TO()) {
+            headerIndex.replyTo = &entry.second;
+        } else if (isCustomHeaderKey(key)) {
+            headerIndex.customHeaders.push_back(&entry);
+        }
+    }
 
     // check if necessary headers are set
-    if (!optionalId.is_initialized() || !optionalType.is_initialized()) {
+    if (!headerIndex.id || !headerIndex.type) {
         throw std::invalid_argument("missing header");
-    } else {
-        requiredHeaders.id = std::move(*optionalId);
-        requiredHeaders.type = std::move(*optionalType);
     }
+    schedulingPriority = calculateSchedulingPriority();
+
+    JOYNR_LOG_TRACE(logger(), "init: {}", toLogMessage());
+}
+
+SchedulingPriority::Enum ImmutableMessage::calculateSchedulingPriority() const
+{
+    const std::string& type = *headerIndex.type;
+    if (type == Message::VALUE_MESSAGE_TYPE_REPLY() ||
+        type == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) {
+        return SchedulingPriority::Enum::HIGH;
+    }
+    if (type == Message::VALUE_MESSAGE_TYPE_PUBLICATION() ||
+        type == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+        return SchedulingPriority::Enum::LOW;
+    }
+    static const std::string bestEffort =
+            MessagingQosEffort::getLiteral(MessagingQosEffort::Enum::BEST_EFFORT);
+    if (headerIndex.effort && *headerIndex.effort == bestEffort) {
+        return SchedulingPriority::Enum::LOW;
+    }
+    return SchedulingPriority::Enum::NORMAL;
 }
 
 bool ImmutableMessage::isCustomHeaderKey(const std::string& key) const
@@ -259,8 +354,8 @@ void ImmutableMessage::setAccessControlChecked()
 
 std::string ImmutableMessage::getTrackingInfo() const
 {
-    auto requestReplyId = getOptionalHeaderByKey(Message::CUSTOM_HEADER_PREFIX() +
-                                                 Message::CUSTOM_HEADER_REQUEST_REPLY_ID());
+    auto requestReplyId = getHeaderView(Message::CUSTOM_HEADER_PREFIX() +
+                                        Message::CUSTOM_HEADER_REQUEST_REPLY_ID());
     std::string trackingInfo = "messageId: " + getId() + ", type: " + getType() + ", sender: " +
                                getSender() + ", recipient: " + getRecipient() +
                                (requestReplyId ? ", requestReplyId: " + *requestReplyId : "") +
@@ -23,13 +23,16 @@
 
 #include <boost/asio/io_service.hpp>
 
+#include "joynr/BatchCompletion.h"
 #include "joynr/IMessagingStubFactory.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/IMulticastAddressCalculator.h"
 #include "joynr/InProcessMessagingAddress.h"
 #include "joynr/Message.h"
 #include "joynr/MessageQueue.h"
+#include "joynr/UdsAddress.h"
 #include "joynr/exceptions/JoynrException.h"
+#include "joynr/exceptions/MethodInvocationException.h"
 #include "joynr/system/RoutingProxy.h"
 #include "joynr/system/RoutingTypes/Address.h"
 #include "joynr/system/RoutingTypes/BrowserAddress.h"
@@ -106,7 +109,7 @@ void LibJoynrMessageRouter::setParentRouter(
     addNextHopToParent(this->parentRouter->getProxyParticipantId(),
                        isGloballyVisible,
                        std::move(onSuccess),
-                       std::move(onError));
+                       createAddNextHopToParentOnError(std::move(onError)));
 }
 
 void LibJoynrMessageRouter::setToKnown(const std::string& participantId)
@@ -130,7 +133,7 @@ void LibJoynrMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> mess
                                           std::uint32_t tryCount)
 {
     JOYNR_LOG_TRACE(logger(), "Route message with Id {}", message->getId());
-    AbstractMessageRouter::AddressUnorderedSet destAddresses;
+    AbstractMessageRouter::AddressUnorderedMap destAddresses;
     {
         ReadLocker lock(messageQueueRetryLock);
         // search for the destination addresses
@@ -221,8 +224,12 @@ void LibJoynrMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> mess
     }
 
     // If this point is reached, the message can be sent without delay
-    for (std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress : destAddresses) {
-        scheduleMessage(message, destAddress, tryCount);
+    for (const auto& destination : destAddresses) {
+        scheduleMessage(message,
+                        destination.first,
+                        tryCount,
+                        std::chrono::milliseconds(0),
+                        destination.second);
     }
 }
 
@@ -265,11 +272,30 @@ bool LibJoynrMessageRouter::isParentMessageRouterSet()
     return true;
 }
 
+std::function<void(const exceptions::JoynrRuntimeException&)> LibJoynrMessageRouter::
+        createAddNextHopToParentOnError(
+                std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    return [onError = std::move(onError)](const exceptions::JoynrRuntimeException& error)
+    {
+        if (onError) {
+            onError(joynr::exceptions::ProviderRuntimeException(error.getMessage()));
+        } else {
+            JOYNR_LOG_WARN(logger(),
+                           "Unable to report error (received by calling "
+                           "parentRouter->addNextHopAsync), since onError function is "
+                           "empty. Error message: {}",
+                           error.getMessage());
+        }
+    };
+}
+
+template <typename ParticipantIds>
 void LibJoynrMessageRouter::addNextHopToParent(
-        std::string participantId,
+        const ParticipantIds& participantIds,
         bool isGloballyVisible,
         std::function<void(void)> onSuccess,
-        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+        std::function<void(const exceptions::JoynrRuntimeException&)> onErrorWrapper)
 {
     if (!isParentMessageRouterSet()) {
         // this special case happens if we get here while the routing proxy is being built.
@@ -281,24 +307,11 @@ void LibJoynrMessageRouter::addNextHopToParent(
         return;
     }
 
-    std::function<void(const exceptions::JoynrException&)> onErrorWrapper =
-            [onError](const exceptions::JoynrException& error) {
-        if (onError) {
-            onError(joynr::exceptions::ProviderRuntimeException(error.getMessage()));
-        } else {
-            JOYNR_LOG_WARN(logger(),
-                           "Unable to report error (received by calling "
-                           "parentRouter->addNextHopAsync), since onError function is "
-                           "empty. Error message: {}",
-                           error.getMessage());
-        }
-    };
-
     // add to parent router
     if (auto channelAddress =
                 std::dynamic_pointer_cast<const joynr::system::RoutingTypes::ChannelAddress>(
                         incomingAddress)) {
-        parentRouter->addNextHopAsync(participantId,
+        parentRouter->addNextHopAsync(participantIds,
                                       *channelAddress,
                                       isGloballyVisible,
                                       std::move(onSuccess),
@@ -306,7 +319,7 @@ void LibJoynrMessageRouter::addNextHopToParent(
     } else if (auto mqttAddress =
                        std::dynamic_pointer_cast<const joynr::system::RoutingTypes::MqttAddress>(
                                incomingAddress)) {
-        parentRouter->addNextHopAsync(participantId,
+        parentRouter->addNextHopAsync(participantIds,
                                       *mqttAddress,
                                       isGloballyVisible,
                                       std::move(onSuccess),
@@ -314,14 +327,14 @@ void LibJoynrMessageRouter::addNextHopToParent(
     } else if (auto browserAddress =
                        std::dynamic_pointer_cast<const joynr::system::RoutingTypes::BrowserAddress>(
                                incomingAddress)) {
-        parentRouter->addNextHopAsync(participantId,
+        parentRouter->addNextHopAsync(participantIds,
                                       *browserAddress,
                                       isGloballyVisible,
                                       std::move(onSuccess),
                                       std::move(onErrorWrapper));
     } else if (auto webSocketAddress = std::dynamic_pointer_cast<
                        const joynr::system::RoutingTypes::WebSocketAddress>(incomingAddress)) {
-        parentRouter->addNextHopAsync(participantId,
+        parentRouter->addNextHopAsync(participantIds,
                                       *webSocketAddress,
                                       isGloballyVisible,
                                       std::move(onSuccess),
@@ -329,7 +342,7 @@ void LibJoynrMessageRouter::addNextHopToParent(
     } else if (auto webSocketClientAddress = std::dynamic_pointer_cast<
                        const joynr::system::RoutingTypes::WebSocketClientAddress>(
                        incomingAddress)) {
-        parentRouter->addNextHopAsync(participantId,
+        parentRouter->addNextHopAsync(participantIds,
                                       *webSocketClientAddress,
                                       isGloballyVisible,
                                       std::move(onSuccess),
@@ -341,11 +354,12 @@ bool LibJoynrMessageRouter::isValidForRoutingTable(
         std::shared_ptr<const joynr::system::RoutingTypes::Address> address)
 {
     if (typeid(*address) == typeid(system::RoutingTypes::WebSocketAddress) ||
+        typeid(*address) == typeid(UdsAddress) ||
         typeid(*address) == typeid(InProcessMessagingAddress)) {
         return true;
     }
     JOYNR_LOG_ERROR(logger(),
-                    "An address which is neither of type WebSocketAddress nor "
+                    "An address which is neither of type WebSocketAddress, UdsAddress nor "
                     "InProcessMessagingAddress will not be used for libjoynr Routing Table: {}",
                     address->toString());
     return false;
@@ -354,15 +368,17 @@ bool LibJoynrMessageRouter::isValidForRoutingTable(
 bool LibJoynrMessageRouter::allowRoutingEntryUpdate(const routingtable::RoutingEntry& oldEntry,
                                                     const system::RoutingTypes::Address& newAddress)
 {
-    // precedence: InProcessAddress > WebSocketAddress > WebSocketClientAddress >
+    // precedence: InProcessAddress > WebSocketAddress/UdsAddress > WebSocketClientAddress >
     // MqttAddress/ChannelAddress
     if (typeid(newAddress) == typeid(InProcessMessagingAddress)) {
         return true;
     }
     if (typeid(*oldEntry.address) != typeid(InProcessMessagingAddress)) {
-        if (typeid(newAddress) == typeid(system::RoutingTypes::WebSocketAddress)) {
+        if (typeid(newAddress) == typeid(system::RoutingTypes::WebSocketAddress) ||
+            typeid(newAddress) == typeid(UdsAddress)) {
             return true;
-        } else if (typeid(*oldEntry.address) != typeid(system::RoutingTypes::WebSocketAddress)) {
+        } else if (typeid(*oldEntry.address) != typeid(system::RoutingTypes::WebSocketAddress) &&
+                   typeid(*oldEntry.address) != typeid(UdsAddress)) {
             // old address is WebSocketClientAddress or MqttAddress/ChannelAddress
             if (typeid(newAddress) == typeid(system::RoutingTypes::WebSocketClientAddress)) {
                 return true;
@@ -400,7 +416,66 @@ void LibJoynrMessageRouter::addNextHop(
     addToRoutingTable(participantId, isGloballyVisible, address, expiryDateMs, isSticky);
     sendQueuedMessages(participantId, address, lock);
     lock.unlock();
-    addNextHopToParent(participantId, isGloballyVisible, std::move(onSuccess), std::move(onError));
+    addNextHopToParent(participantId,
+                       isGloballyVisible,
+                       std::move(onSuccess),
+                       createAddNextHopToParentOnError(std::move(onError)));
+}
+
+void LibJoynrMessageRouter::addNextHops(
+        const std::vector<std::string>& participantIds,
+        const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+        bool isGloballyVisible,
+        const std::int64_t expiryDateMs,
+        const bool isSticky,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    assert(address);
+    WriteLocker lock(messageQueueRetryLock);
+    addToRoutingTable(participantIds, isGloballyVisible, address, expiryDateMs, isSticky);
+    for (const std::string& participantId : participantIds) {
+        sendQueuedMessages(participantId, address, lock);
+    }
+    lock.unlock();
+    // add all to parent router with a single call, cluster controllers providing Routing 0.1
+    // do not know this call and are updated with one call per participantId instead
+    auto onParentError = createAddNextHopToParentOnError(std::move(onError));
+    std::function<void(const exceptions::JoynrRuntimeException&)> onBatchError = [
+        thisWeakPtr = joynr::util::as_weak_ptr(
+                std::dynamic_pointer_cast<LibJoynrMessageRouter>(shared_from_this())),
+        participantIds,
+        isGloballyVisible,
+        onSuccess,
+        onParentError
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        auto thisSharedPtr = thisWeakPtr.lock();
+        if (!thisSharedPtr ||
+            error.getTypeName() != exceptions::MethodInvocationException::TYPE_NAME()) {
+            onParentError(error);
+            return;
+        }
+        JOYNR_LOG_INFO(logger(),
+                       "parent router does not support adding several next hops with a single "
+                       "call, adding {} next hops one by one",
+                       participantIds.size());
+        if (participantIds.empty()) {
+            if (onSuccess) {
+                onSuccess();
+            }
+            return;
+        }
+        auto batch = BatchCompletion::create(participantIds.size(), onSuccess, onParentError);
+        for (const std::string& participantId : participantIds) {
+            thisSharedPtr->addNextHopToParent(participantId,
+                                              isGloballyVisible,
+                                              batch->successCallback(batch),
+                                              batch->errorCallback(batch));
+        }
+    };
+    addNextHopToParent(
+            participantIds, isGloballyVisible, std::move(onSuccess), std::move(onBatchError));
 }
 
 void LibJoynrMessageRouter::removeNextHop(
@@ -442,6 +517,73 @@ void LibJoynrMessageRouter::removeNextHop(
             participantId, std::move(onSuccess), std::move(onErrorWrapper));
 }
 
+void LibJoynrMessageRouter::removeNextHops(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    {
+        WriteLocker lock(routingTableLock);
+        for (const std::string& participantId : participantIds) {
+            routingTable.remove(participantId);
+        }
+    }
+
+    saveRoutingTable();
+
+    if (!isParentMessageRouterSet()) {
+        if (onError) {
+            onError(exceptions::ProviderRuntimeException(
+                    "unable to removeNextHops since parentRouter is not available"));
+        }
+        return;
+    }
+
+    std::function<void(const exceptions::JoynrRuntimeException&)> onErrorWrapper =
+            [onError = std::move(onError)](const exceptions::JoynrRuntimeException& error)
+    {
+        JOYNR_LOG_ERROR(logger(),
+                        "error calling parentRouter->removeNextHopAsync: {}",
+                        error.getMessage());
+        if (onError) {
+            onError(exceptions::ProviderRuntimeException(error.getMessage()));
+        }
+    };
+
+    // remove all from parent router with a single call, cluster controllers providing
+    // Routing 0.1 do not know this call and are updated with one call per participantId instead
+    std::function<void(const exceptions::JoynrRuntimeException&)> onBatchError = [
+        parentRouter = joynr::util::as_weak_ptr(this->parentRouter),
+        participantIds,
+        onSuccess,
+        onErrorWrapper
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        auto parentRouterSharedPtr = parentRouter.lock();
+        if (!parentRouterSharedPtr ||
+            error.getTypeName() != exceptions::MethodInvocationException::TYPE_NAME()) {
+            onErrorWrapper(error);
+            return;
+        }
+        JOYNR_LOG_INFO(logger(),
+                       "parent router does not support removing several next hops with a single "
+                       "call, removing {} next hops one by one",
+                       participantIds.size());
+        if (participantIds.empty()) {
+            if (onSuccess) {
+                onSuccess();
+            }
+            return;
+        }
+        auto batch = BatchCompletion::create(participantIds.size(), onSuccess, onErrorWrapper);
+        for (const std::string& participantId : participantIds) {
+            parentRouterSharedPtr->removeNextHopAsync(
+                    participantId, batch->successCallback(batch), batch->errorCallback(batch));
+        }
+    };
+    parentRouter->removeNextHopAsync(participantIds, std::move(onSuccess), std::move(onBatchError));
+}
+
 void LibJoynrMessageRouter::addMulticastReceiver(
         const std::string& multicastId,
         const std::string& subscriberParticipantId,
@@ -0,0 +1,104 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/MessageBatch.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace joynr
+{
+
+constexpr std::size_t MessageBatch::HEADER_SIZE;
+constexpr std::size_t MessageBatch::FRAME_OVERHEAD;
+
+MessageBatch::MessageBatch()
+        : payload(header().cbegin(), header().cend()), numberOfMessages(0)
+{
+}
+
+const std::array<std::uint8_t, MessageBatch::HEADER_SIZE>& MessageBatch::header()
+{
+    static const std::array<std::uint8_t, HEADER_SIZE> value = {{'J', 'M', 'B', 1}};
+    return value;
+}
+
+void MessageBatch::append(const smrf::ByteArrayView& message)
+{
+    const std::uint32_t messageSize = static_cast<std::uint32_t>(message.size());
+    payload.reserve(payload.size() + FRAME_OVERHEAD + message.size());
+    payload.push_back(static_cast<std::uint8_t>(messageSize >> 24));
+    payload.push_back(static_cast<std::uint8_t>(messageSize >> 16));
+    payload.push_back(static_cast<std::uint8_t>(messageSize >> 8));
+    payload.push_back(static_cast<std::uint8_t>(messageSize));
+    payload.insert(payload.end(), message.data(), message.data() + message.size());
+    numberOfMessages++;
+}
+
+std::size_t MessageBatch::getNumberOfMessages() const
+{
+    return numberOfMessages;
+}
+
+std::size_t MessageBatch::getSize() const
+{
+    return payload.size();
+}
+
+const smrf::ByteVector& MessageBatch::getPayload() const
+{
+    return payload;
+}
+
+bool MessageBatch::isBatch(const smrf::ByteVector& payload)
+{
+    return payload.size() >= HEADER_SIZE &&
+           std::equal(header().cbegin(), header().cend(), payload.cbegin());
+}
+
+std::vector<smrf::ByteVector> MessageBatch::split(const smrf::ByteVector& payload)
+{
+    if (!isBatch(payload)) {
+        throw std::invalid_argument("payload is not a message batch");
+    }
+    std::vector<smrf::ByteVector> messages;
+    std::size_t offset = HEADER_SIZE;
+    while (offset < payload.size()) {
+        if (payload.size() - offset < FRAME_OVERHEAD) {
+            throw std::invalid_argument("truncated size of message in batch at offset " +
+                                        std::to_string(offset));
+        }
+        const std::uint32_t messageSize = (static_cast<std::uint32_t>(payload[offset]) << 24) |
+                                          (static_cast<std::uint32_t>(payload[offset + 1]) << 16) |
+                                          (static_cast<std::uint32_t>(payload[offset + 2]) << 8) |
+                                          static_cast<std::uint32_t>(payload[offset + 3]);
+        offset += FRAME_OVERHEAD;
+        if (payload.size() - offset < messageSize) {
+            throw std::invalid_argument("truncated message of size " +
+                                        std::to_string(messageSize) + " in batch");
+        }
+        messages.emplace_back(payload.cbegin() + static_cast<std::ptrdiff_t>(offset),
+                              payload.cbegin() +
+                                      static_cast<std::ptrdiff_t>(offset + messageSize));
+        offset += messageSize;
+    }
+    return messages;
+}
+
+} // namespace joynr
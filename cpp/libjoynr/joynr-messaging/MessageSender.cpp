@@ -21,10 +21,12 @@
 
 #include <cassert>
 
+#include "joynr/BackPressureController.h"
 #include "joynr/BroadcastSubscriptionRequest.h"
 #include "joynr/IDispatcher.h"
 #include "joynr/IKeychain.h"
 #include "joynr/IMessageRouter.h"
+#include "joynr/IReplyCaller.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/MulticastPublication.h"
 #include "joynr/MulticastSubscriptionRequest.h"
@@ -35,6 +37,7 @@
 #include "joynr/SubscriptionRequest.h"
 #include "joynr/SubscriptionReply.h"
 #include "joynr/SubscriptionStop.h"
+#include "joynr/exceptions/JoynrException.h"
 #include "joynr/exceptions/MethodInvocationException.h"
 
 namespace joynr
@@ -42,14 +45,37 @@ namespace joynr
 
 MessageSender::MessageSender(std::shared_ptr<IMessageRouter> messageRouter,
                              std::shared_ptr<IKeychain> keyChain,
-                             std::uint64_t ttlUpliftMs)
+                             std::uint64_t ttlUpliftMs,
+                             std::shared_ptr<BackPressureController> backPressureController)
         : dispatcher(),
           messageRouter(std::move(messageRouter)),
           messageFactory(ttlUpliftMs, std::move(keyChain)),
-          replyToAddress()
+          replyToAddress(),
+          backPressureController(std::move(backPressureController))
 {
 }
 
+bool MessageSender::isBackPressured() const
+{
+    return backPressureController && backPressureController->isSaturated();
+}
+
+void MessageSender::notifyWhenReady(std::function<void()> callback)
+{
+    if (backPressureController) {
+        backPressureController->notifyWhenReady(std::move(callback));
+    } else {
+        callback();
+    }
+}
+
+void MessageSender::admit()
+{
+    if (backPressureController) {
+        backPressureController->admit();
+    }
+}
+
 void MessageSender::setReplyToAddress(const std::string& replyToAddress)
 {
     this->replyToAddress = replyToAddress;
@@ -75,6 +101,16 @@ void MessageSender::sendRequest(const std::string& senderParticipantId,
         return;
     }
 
+    try {
+        admit();
+    } catch (const exceptions::JoynrMessageNotSentException& e) {
+        JOYNR_LOG_WARN(logger(),
+                       "Request with requestReplyId {} not sent: {}",
+                       request.getRequestReplyId(),
+                       e.getMessage());
+        callback->returnError(std::make_shared<exceptions::JoynrMessageNotSentException>(e));
+        return;
+    }
     MutableMessage message = messageFactory.createRequest(
             senderParticipantId, receiverParticipantId, qos, request, isLocalMessage);
     dispatcherSharedPtr->addReplyCaller(request.getRequestReplyId(), std::move(callback), qos);
@@ -102,6 +138,7 @@ void MessageSender::sendOneWayRequest(const std::string& senderParticipantId,
                                       bool isLocalMessage)
 {
     try {
+        admit();
         MutableMessage message = messageFactory.createOneWayRequest(
                 senderParticipantId, receiverParticipantId, qos, request, isLocalMessage);
         JOYNR_LOG_DEBUG(logger(),
@@ -284,6 +321,7 @@ void MessageSender::sendSubscriptionPublication(const std::string& senderPartici
                                                 SubscriptionPublication&& subscriptionPublication)
 {
     try {
+        admit();
         MutableMessage message = messageFactory.createSubscriptionPublication(
                 senderParticipantId, receiverParticipantId, qos, subscriptionPublication);
         assert(messageRouter);
@@ -305,6 +343,7 @@ void MessageSender::sendMulticast(const std::string& fromParticipantId,
                                   const MessagingQos& messagingQos)
 {
     try {
+        admit();
         MutableMessage message = messageFactory.createMulticastPublication(
                 fromParticipantId, messagingQos, multicastPublication);
         assert(messageRouter);
@@ -127,6 +127,36 @@ const std::string& MessagingSettings::SETTING_MQTT_MAX_MESSAGE_SIZE_BYTES()
     return value;
 }
 
+const std::string& MessagingSettings::SETTING_MQTT_PUBLISH_CONNECTIONS()
+{
+    static const std::string value("messaging/mqtt-publish-connections");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES()
+{
+    static const std::string value("messaging/mqtt-publish-batch-max-messages");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES()
+{
+    static const std::string value("messaging/mqtt-publish-batch-max-bytes");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS()
+{
+    static const std::string value("messaging/mqtt-publish-batch-max-delay-ms");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_MQTT_MAX_INFLIGHT_MESSAGES()
+{
+    static const std::string value("messaging/mqtt-max-inflight-messages");
+    return value;
+}
+
 const std::string& MessagingSettings::SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS()
 {
     static const std::string value("messaging/discard-unroutable-replies-and-publications");
@@ -149,6 +179,33 @@ std::int64_t MessagingSettings::NO_MQTT_MAX_MESSAGE_SIZE_BYTES()
     return 0;
 }
 
+std::uint32_t MessagingSettings::DEFAULT_MQTT_PUBLISH_CONNECTIONS()
+{
+    return 0;
+}
+
+std::uint32_t MessagingSettings::DEFAULT_MQTT_PUBLISH_BATCH_MAX_MESSAGES()
+{
+    return 1;
+}
+
+std::uint32_t MessagingSettings::DEFAULT_MQTT_PUBLISH_BATCH_MAX_BYTES()
+{
+    return 65536;
+}
+
+std::chrono::milliseconds MessagingSettings::DEFAULT_MQTT_PUBLISH_BATCH_MAX_DELAY_MS()
+{
+    static const std::chrono::milliseconds value(5);
+    return value;
+}
+
+std::uint32_t MessagingSettings::DEFAULT_MQTT_MAX_INFLIGHT_MESSAGES()
+{
+    // default of mosquitto
+    return 20;
+}
+
 std::chrono::seconds MessagingSettings::DEFAULT_MQTT_RECONNECT_DELAY_TIME_SECONDS()
 {
     static const std::chrono::seconds value(1);
@@ -406,6 +463,51 @@ const std::string& MessagingSettings::SETTING_TTL_UPLIFT_MS()
     return value;
 }
 
+const std::string& MessagingSettings::SETTING_BACK_PRESSURE_POLICY()
+{
+    static const std::string value("messaging/back-pressure-policy");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES()
+{
+    static const std::string value("messaging/back-pressure-high-watermark-bytes");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES()
+{
+    static const std::string value("messaging/back-pressure-low-watermark-bytes");
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS()
+{
+    static const std::string value("messaging/back-pressure-max-blocking-time-ms");
+    return value;
+}
+
+const std::string& MessagingSettings::DEFAULT_BACK_PRESSURE_POLICY()
+{
+    static const std::string value("DISABLED");
+    return value;
+}
+
+std::uint64_t MessagingSettings::DEFAULT_BACK_PRESSURE_HIGH_WATERMARK_BYTES()
+{
+    return 0;
+}
+
+std::uint64_t MessagingSettings::DEFAULT_BACK_PRESSURE_LOW_WATERMARK_BYTES()
+{
+    return 0;
+}
+
+std::int64_t MessagingSettings::DEFAULT_BACK_PRESSURE_MAX_BLOCKING_TIME_MS()
+{
+    return 5000;
+}
+
 BrokerUrl MessagingSettings::getBrokerUrl() const
 {
     return BrokerUrl(settings.get<std::string>(SETTING_BROKER_URL()));
@@ -492,6 +594,57 @@ void MessagingSettings::setMqttMaxMessageSizeBytes(std::int64_t mqttMaxMessageSi
     settings.set(SETTING_MQTT_MAX_MESSAGE_SIZE_BYTES(), mqttMaxMessageSizeBytes);
 }
 
+std::uint32_t MessagingSettings::getMqttPublishConnections() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_PUBLISH_CONNECTIONS());
+}
+
+void MessagingSettings::setMqttPublishConnections(std::uint32_t numberOfConnections)
+{
+    settings.set(SETTING_MQTT_PUBLISH_CONNECTIONS(), numberOfConnections);
+}
+
+std::uint32_t MessagingSettings::getMqttPublishBatchMaxMessages() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES());
+}
+
+void MessagingSettings::setMqttPublishBatchMaxMessages(std::uint32_t maxMessages)
+{
+    settings.set(SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES(), maxMessages);
+}
+
+std::uint32_t MessagingSettings::getMqttPublishBatchMaxBytes() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES());
+}
+
+void MessagingSettings::setMqttPublishBatchMaxBytes(std::uint32_t maxBytes)
+{
+    settings.set(SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES(), maxBytes);
+}
+
+std::chrono::milliseconds MessagingSettings::getMqttPublishBatchMaxDelayMs() const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::int64_t>(SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS()));
+}
+
+void MessagingSettings::setMqttPublishBatchMaxDelayMs(std::chrono::milliseconds maxDelay)
+{
+    settings.set(SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS(), maxDelay.count());
+}
+
+std::uint32_t MessagingSettings::getMqttMaxInflightMessages() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_MAX_INFLIGHT_MESSAGES());
+}
+
+void MessagingSettings::setMqttMaxInflightMessages(std::uint32_t maxInflightMessages)
+{
+    settings.set(SETTING_MQTT_MAX_INFLIGHT_MESSAGES(), maxInflightMessages);
+}
+
 std::int64_t MessagingSettings::getIndex() const
 {
     return settings.get<std::int64_t>(SETTING_INDEX());
@@ -672,6 +825,46 @@ std::uint64_t MessagingSettings::getTtlUpliftMs() const
     return settings.get<std::uint64_t>(SETTING_TTL_UPLIFT_MS());
 }
 
+std::string MessagingSettings::getBackPressurePolicy() const
+{
+    return settings.get<std::string>(SETTING_BACK_PRESSURE_POLICY());
+}
+
+void MessagingSettings::setBackPressurePolicy(const std::string& policy)
+{
+    settings.set(SETTING_BACK_PRESSURE_POLICY(), policy);
+}
+
+std::uint64_t MessagingSettings::getBackPressureHighWatermarkBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES());
+}
+
+void MessagingSettings::setBackPressureHighWatermarkBytes(std::uint64_t highWatermarkBytes)
+{
+    settings.set(SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES(), highWatermarkBytes);
+}
+
+std::uint64_t MessagingSettings::getBackPressureLowWatermarkBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES());
+}
+
+void MessagingSettings::setBackPressureLowWatermarkBytes(std::uint64_t lowWatermarkBytes)
+{
+    settings.set(SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES(), lowWatermarkBytes);
+}
+
+std::int64_t MessagingSettings::getBackPressureMaxBlockingTimeMs() const
+{
+    return settings.get<std::int64_t>(SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS());
+}
+
+void MessagingSettings::setBackPressureMaxBlockingTimeMs(std::int64_t maxBlockingTimeMs)
+{
+    settings.set(SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS(), maxBlockingTimeMs);
+}
+
 std::int64_t MessagingSettings::getDiscoveryDefaultTimeoutMs() const
 {
     return settings.get<std::int64_t>(SETTING_DISCOVERY_DEFAULT_TIMEOUT_MS());
@@ -774,6 +967,24 @@ void MessagingSettings::checkSettings()
     if (!settings.contains(SETTING_MQTT_MAX_MESSAGE_SIZE_BYTES())) {
         settings.set(SETTING_MQTT_MAX_MESSAGE_SIZE_BYTES(), DEFAULT_MQTT_MAX_MESSAGE_SIZE_BYTES());
     }
+    if (!settings.contains(SETTING_MQTT_PUBLISH_CONNECTIONS())) {
+        settings.set(SETTING_MQTT_PUBLISH_CONNECTIONS(), DEFAULT_MQTT_PUBLISH_CONNECTIONS());
+    }
+    if (!settings.contains(SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES())) {
+        settings.set(SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES(),
+                     DEFAULT_MQTT_PUBLISH_BATCH_MAX_MESSAGES());
+    }
+    if (!settings.contains(SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES())) {
+        settings.set(
+                SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES(), DEFAULT_MQTT_PUBLISH_BATCH_MAX_BYTES());
+    }
+    if (!settings.contains(SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS())) {
+        settings.set(SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS(),
+                     DEFAULT_MQTT_PUBLISH_BATCH_MAX_DELAY_MS().count());
+    }
+    if (!settings.contains(SETTING_MQTT_MAX_INFLIGHT_MESSAGES())) {
+        settings.set(SETTING_MQTT_MAX_INFLIGHT_MESSAGES(), DEFAULT_MQTT_MAX_INFLIGHT_MESSAGES());
+    }
     if (!settings.contains(SETTING_INDEX())) {
         settings.set(SETTING_INDEX(), 0);
     }
@@ -826,6 +1037,21 @@ void MessagingSettings::checkSettings()
         settings.set(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS(),
                      DEFAULT_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS());
     }
+    if (!settings.contains(SETTING_BACK_PRESSURE_POLICY())) {
+        settings.set(SETTING_BACK_PRESSURE_POLICY(), DEFAULT_BACK_PRESSURE_POLICY());
+    }
+    if (!settings.contains(SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES())) {
+        settings.set(SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES(),
+                     DEFAULT_BACK_PRESSURE_HIGH_WATERMARK_BYTES());
+    }
+    if (!settings.contains(SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES())) {
+        settings.set(SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES(),
+                     DEFAULT_BACK_PRESSURE_LOW_WATERMARK_BYTES());
+    }
+    if (!settings.contains(SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS())) {
+        settings.set(SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS(),
+                     DEFAULT_BACK_PRESSURE_MAX_BLOCKING_TIME_MS());
+    }
 }
 
 void MessagingSettings::printSettings() const
@@ -866,6 +1092,26 @@ void MessagingSettings::printSettings() const
                    "SETTING: {} = {})",
                    SETTING_MQTT_EXPONENTIAL_BACKOFF_ENABLED(),
                    settings.get<std::string>(SETTING_MQTT_EXPONENTIAL_BACKOFF_ENABLED()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MQTT_PUBLISH_CONNECTIONS(),
+                   settings.get<std::string>(SETTING_MQTT_PUBLISH_CONNECTIONS()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES(),
+                   settings.get<std::string>(SETTING_MQTT_PUBLISH_BATCH_MAX_MESSAGES()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES(),
+                   settings.get<std::string>(SETTING_MQTT_PUBLISH_BATCH_MAX_BYTES()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS(),
+                   settings.get<std::string>(SETTING_MQTT_PUBLISH_BATCH_MAX_DELAY_MS()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MQTT_MAX_INFLIGHT_MESSAGES(),
+                   settings.get<std::string>(SETTING_MQTT_MAX_INFLIGHT_MESSAGES()));
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {})",
                    SETTING_INDEX(),
@@ -921,6 +1167,20 @@ void MessagingSettings::printSettings() const
             "SETTING: {} = {})",
             SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS(),
             settings.get<std::string>(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS()));
+    JOYNR_LOG_INFO(
+            logger(), "SETTING: {} = {})", SETTING_BACK_PRESSURE_POLICY(), getBackPressurePolicy());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_BACK_PRESSURE_HIGH_WATERMARK_BYTES(),
+                   getBackPressureHighWatermarkBytes());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_BACK_PRESSURE_LOW_WATERMARK_BYTES(),
+                   getBackPressureLowWatermarkBytes());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_BACK_PRESSURE_MAX_BLOCKING_TIME_MS(),
+                   getBackPressureMaxBlockingTimeMs());
 }
 
 } // namespace joynr
@@ -57,16 +57,16 @@ std::unique_ptr<ImmutableMessage> MutableMessage::getImmutableMessage() const
     messageSerializer.setRecipient(recipient);
     messageSerializer.setTtlMs(expiryDate.toMilliseconds());
 
-    // key-value pair headers
+    // key-value pair headers, custom headers never override an explicitly set header
     std::unordered_map<std::string, std::string> keyValuePairHeaders;
-    keyValuePairHeaders.insert({Message::HEADER_TYPE(), type});
-    keyValuePairHeaders.insert({Message::HEADER_ID(), id});
-
+    keyValuePairHeaders.reserve(customHeaders.size() + 4);
+    keyValuePairHeaders.emplace(Message::HEADER_TYPE(), type);
+    keyValuePairHeaders.emplace(Message::HEADER_ID(), id);
     if (replyTo) {
-        keyValuePairHeaders.insert({Message::HEADER_REPLY_TO(), *replyTo});
+        keyValuePairHeaders.emplace(Message::HEADER_REPLY_TO(), *replyTo);
     }
     if (effort) {
-        keyValuePairHeaders.insert({Message::HEADER_EFFORT(), *effort});
+        keyValuePairHeaders.emplace(Message::HEADER_EFFORT(), *effort);
     }
     keyValuePairHeaders.insert(customHeaders.cbegin(), customHeaders.cend());
     messageSerializer.setHeaders(keyValuePairHeaders);
@@ -83,8 +83,9 @@ std::unique_ptr<ImmutableMessage> MutableMessage::getImmutableMessage() const
         messageSerializer.setCustomSigningCallback(ownersigningCallback);
     }
 
-    const bool verifyInput = false;
-    return std::make_unique<ImmutableMessage>(messageSerializer.serialize(), verifyInput);
+    // the headers are handed over instead of being decoded from the serialized message again
+    return std::unique_ptr<ImmutableMessage>(new ImmutableMessage(
+            messageSerializer.serialize(), std::move(keyValuePairHeaders), sender, recipient));
 }
 
 const std::string& MutableMessage::getRecipient() const
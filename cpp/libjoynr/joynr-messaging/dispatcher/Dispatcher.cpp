@@ -59,8 +59,7 @@ Dispatcher::Dispatcher(std::shared_ptr<IMessageSender> messageSender,
           subscriptionManager(nullptr),
           handleReceivedMessageThreadPool(std::make_shared<ThreadPool>("Dispatcher", maxThreads)),
           subscriptionHandlingMutex(),
-          isShuttingDown(false),
-          isShuttingDownLock()
+          shutdownGuard()
 {
     handleReceivedMessageThreadPool->init();
 }
@@ -68,15 +67,15 @@ Dispatcher::Dispatcher(std::shared_ptr<IMessageSender> messageSender,
 Dispatcher::~Dispatcher()
 {
     JOYNR_LOG_TRACE(logger(), "Destructing Dispatcher");
-    assert(isShuttingDown);
+    assert(shutdownGuard.isShutDown());
     JOYNR_LOG_TRACE(logger(), "Destructing finished");
 }
 
 void Dispatcher::addRequestCaller(const std::string& participantId,
                                   std::shared_ptr<RequestCaller> requestCaller)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(
                 logger(), "addRequestCaller id= {} cancelled, shutting down", participantId);
         return;
@@ -86,7 +85,7 @@ void Dispatcher::addRequestCaller(const std::string& participantId,
     JOYNR_LOG_TRACE(logger(), "addRequestCaller id= {}", participantId);
 
     requestCallerDirectory.add(participantId, requestCaller);
-    locker.unlock();
+    pass.release();
 
     if (auto publicationManagerSharedPtr = publicationManager.lock()) {
         // publication manager queues received subscription requests, that are
@@ -100,15 +99,15 @@ void Dispatcher::addRequestCaller(const std::string& participantId,
 
 void Dispatcher::removeRequestCaller(const std::string& participantId)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(
                 logger(), "removeRequestCaller id= {} cancelled, shutting down", participantId);
         return;
     }
     std::lock_guard<std::mutex> lock(subscriptionHandlingMutex);
     JOYNR_LOG_TRACE(logger(), "removeRequestCaller id= {}", participantId);
-    locker.unlock();
+    pass.release();
 
     // TODO if a provider is removed, all publication runnables are stopped
     // the subscription request is deleted,
@@ -117,8 +116,8 @@ void Dispatcher::removeRequestCaller(const std::string& participantId)
         publicationManagerSharedPtr->removeAllSubscriptions(participantId);
     }
 
-    locker.lock();
-    if (isShuttingDown) {
+    pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(
                 logger(), "removeRequestCaller id= {} cancelled, shutting down", participantId);
         return;
@@ -130,8 +129,8 @@ void Dispatcher::addReplyCaller(const std::string& requestReplyId,
                                 std::shared_ptr<IReplyCaller> replyCaller,
                                 const MessagingQos& qosSettings)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "addReplyCaller id= {} cancelled, shutting down", requestReplyId);
         return;
     }
@@ -142,8 +141,8 @@ void Dispatcher::addReplyCaller(const std::string& requestReplyId,
 
 void Dispatcher::receive(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(),
                         "received message: {}, operation cancelled, shutting down",
                         message->toLogMessage());
@@ -159,8 +158,8 @@ void Dispatcher::receive(std::shared_ptr<ImmutableMessage> message)
 
 void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleRequestReceived cancelled, shutting down");
         return;
     }
@@ -222,7 +221,7 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
             const std::chrono::milliseconds ttl = requestExpiryDate.relativeFromNow();
             MessagingQos messagingQos(ttl.count());
             messagingQos.setCompress(message->isCompressed());
-            const boost::optional<std::string> effort = message->getEffort();
+            const boost::optional<const std::string&> effort = message->getEffortView();
             if (effort) {
                 try {
                     messagingQos.setEffort(MessagingQosEffort::getEnum(*effort));
@@ -272,7 +271,7 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
                     std::move(reply));
         }
     };
-    locker.unlock();
+    pass.release();
 
     // execute request
     requestInterpreter->execute(
@@ -281,8 +280,8 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
 
 void Dispatcher::handleOneWayRequestReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleOneWayRequestReceived cancelled, shutting down");
         return;
     }
@@ -324,7 +323,7 @@ void Dispatcher::handleOneWayRequestReceived(std::shared_ptr<ImmutableMessage> m
                         e.what());
         return;
     }
-    locker.unlock();
+    pass.release();
 
     // execute request
     requestInterpreter->execute(std::move(caller), request);
@@ -332,8 +331,8 @@ void Dispatcher::handleOneWayRequestReceived(std::shared_ptr<ImmutableMessage> m
 
 void Dispatcher::handleReplyReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleReplyReceived cancelled, shutting down");
         return;
     }
@@ -361,15 +360,15 @@ void Dispatcher::handleReplyReceived(std::shared_ptr<ImmutableMessage> message)
                        requestReplyId);
         return;
     }
-    locker.unlock();
+    pass.release();
 
     caller->execute(std::move(reply));
 }
 
 void Dispatcher::handleSubscriptionRequestReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleSubscriptionRequestReceived cancelled, shutting down");
         return;
     }
@@ -400,7 +399,7 @@ void Dispatcher::handleSubscriptionRequestReceived(std::shared_ptr<ImmutableMess
                         e.what());
         return;
     }
-    locker.unlock();
+    pass.release();
 
     if (!caller) {
         // Provider not registered yet
@@ -421,8 +420,8 @@ void Dispatcher::handleSubscriptionRequestReceived(std::shared_ptr<ImmutableMess
 void Dispatcher::handleMulticastSubscriptionRequestReceived(
         std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(
                 logger(), "handleMulticastSubscriptionRequestReceived cancelled, shutting down");
         return;
@@ -449,7 +448,7 @@ void Dispatcher::handleMulticastSubscriptionRequestReceived(
                 e.what());
         return;
     }
-    locker.unlock();
+    pass.release();
 
     publicationManagerSharedPtr->add(
             message->getSender(), message->getRecipient(), subscriptionRequest, messageSender);
@@ -458,8 +457,8 @@ void Dispatcher::handleMulticastSubscriptionRequestReceived(
 void Dispatcher::handleBroadcastSubscriptionRequestReceived(
         std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(
                 logger(), "handleBroadcastSubscriptionRequestReceived cancelled, shutting down");
         return;
@@ -492,7 +491,7 @@ void Dispatcher::handleBroadcastSubscriptionRequestReceived(
                 e.what());
         return;
     }
-    locker.unlock();
+    pass.release();
 
     if (!caller) {
         // Provider not registered yet
@@ -512,8 +511,8 @@ void Dispatcher::handleBroadcastSubscriptionRequestReceived(
 
 void Dispatcher::handleSubscriptionStopReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleSubscriptionStopReceived cancelled, shutting down");
         return;
     }
@@ -537,15 +536,15 @@ void Dispatcher::handleSubscriptionStopReceived(std::shared_ptr<ImmutableMessage
                         message->toLogMessage());
         return;
     }
-    locker.unlock();
+    pass.release();
 
     publicationManagerSharedPtr->stopPublication(subscriptionStop.getSubscriptionId());
 }
 
 void Dispatcher::handleSubscriptionReplyReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleSubscriptionReplyReceived cancelled, shutting down");
         return;
     }
@@ -573,15 +572,15 @@ void Dispatcher::handleSubscriptionReplyReceived(std::shared_ptr<ImmutableMessag
                         subscriptionId);
         return;
     }
-    locker.unlock();
+    pass.release();
 
     callback->execute(std::move(subscriptionReply));
 }
 
 void Dispatcher::handleMulticastReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handleMulticastReceived cancelled, shutting down");
         return;
     }
@@ -609,7 +608,7 @@ void Dispatcher::handleMulticastReceived(std::shared_ptr<ImmutableMessage> messa
                         multicastId);
         return;
     }
-    locker.unlock();
+    pass.release();
 
     // TODO: enable for periodic attribute subscriptions
     // when MulticastPublication is extended by subscriptionId
@@ -620,8 +619,8 @@ void Dispatcher::handleMulticastReceived(std::shared_ptr<ImmutableMessage> messa
 
 void Dispatcher::handlePublicationReceived(std::shared_ptr<ImmutableMessage> message)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "handlePublicationReceived cancelled, shutting down");
         return;
     }
@@ -652,7 +651,7 @@ void Dispatcher::handlePublicationReceived(std::shared_ptr<ImmutableMessage> mes
     }
 
     subscriptionManager->touchSubscriptionState(subscriptionId);
-    locker.unlock();
+    pass.release();
 
     callback->execute(std::move(subscriptionPublication));
 }
@@ -660,8 +659,8 @@ void Dispatcher::handlePublicationReceived(std::shared_ptr<ImmutableMessage> mes
 void Dispatcher::registerSubscriptionManager(
         std::shared_ptr<ISubscriptionManager> subscriptionManager)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "registerSubscriptionManager cancelled, shutting down");
         return;
     }
@@ -670,8 +669,8 @@ void Dispatcher::registerSubscriptionManager(
 
 void Dispatcher::registerPublicationManager(std::weak_ptr<PublicationManager> publicationManager)
 {
-    ReadLocker locker(isShuttingDownLock);
-    if (isShuttingDown) {
+    ShutdownGuard::Pass pass = shutdownGuard.enter();
+    if (!pass) {
         JOYNR_LOG_TRACE(logger(), "registerPublicationManager cancelled, shutting down");
         return;
     }
@@ -680,11 +679,8 @@ void Dispatcher::registerPublicationManager(std::weak_ptr<PublicationManager> pu
 
 void Dispatcher::shutdown()
 {
-    {
-        WriteLocker locker(isShuttingDownLock);
-        assert(!isShuttingDown);
-        isShuttingDown = true;
-    }
+    assert(!shutdownGuard.isShutDown());
+    shutdownGuard.shutdown();
     handleReceivedMessageThreadPool->shutdown();
     replyCallerDirectory.shutdown();
     requestCallerDirectory.shutdown();
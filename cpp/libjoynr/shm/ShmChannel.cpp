@@ -0,0 +1,213 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shm/ShmChannel.h"
+
+#include <chrono>
+#include <utility>
+
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shm/ShmRingBuffer.h"
+#include "libjoynr/shm/ShmSegment.h"
+
+namespace joynr
+{
+
+namespace
+{
+// number of unsuccessful polls of the ring before the receive thread goes to sleep
+constexpr int IDLE_POLL_COUNT = 1000;
+// upper bound for a single sleep; the thread re-checks whether it has been stopped afterwards
+constexpr std::chrono::milliseconds MAX_IDLE_WAIT(100);
+
+ShmRingBuffer& selectOutgoing(ShmSegment& segment, ShmChannel::Side side)
+{
+    return (side == ShmChannel::Side::LibJoynr) ? segment.getLibJoynrToClusterControllerRing()
+                                                : segment.getClusterControllerToLibJoynrRing();
+}
+
+ShmRingBuffer& selectIncoming(ShmSegment& segment, ShmChannel::Side side)
+{
+    return (side == ShmChannel::Side::LibJoynr) ? segment.getClusterControllerToLibJoynrRing()
+                                                : segment.getLibJoynrToClusterControllerRing();
+}
+} // namespace
+
+ShmChannel::ShmChannel(std::unique_ptr<ShmSegment> segment,
+                       Side side,
+                       std::shared_ptr<IWebSocketSendInterface> fallbackSender)
+        : segment(std::move(segment)),
+          outgoing(selectOutgoing(*this->segment, side)),
+          incoming(selectIncoming(*this->segment, side)),
+          fallbackSender(std::move(fallbackSender)),
+          onMessageReceived(nullptr),
+          outgoingMutex(),
+          stopped(false),
+          faulted(false),
+          receiveThread()
+{
+}
+
+template <typename Function>
+bool ShmChannel::accessSegment(Function&& function)
+{
+    if (faulted) {
+        return false;
+    }
+    if (segment->access(std::forward<Function>(function))) {
+        return true;
+    }
+    if (!faulted.exchange(true)) {
+        JOYNR_LOG_ERROR(logger(),
+                        "shared memory {} was shrunk by the peer, closing it",
+                        segment->getName());
+    }
+    return false;
+}
+
+ShmChannel::~ShmChannel()
+{
+    stop();
+}
+
+void ShmChannel::start(std::function<void(smrf::ByteVector&&)> onMessageReceived)
+{
+    if (receiveThread.joinable() || stopped) {
+        return;
+    }
+    this->onMessageReceived = std::move(onMessageReceived);
+    receiveThread = std::thread(&ShmChannel::receiveLoop, this);
+}
+
+void ShmChannel::stop()
+{
+    if (stopped.exchange(true)) {
+        return;
+    }
+    accessSegment([this]() {
+        outgoing.close();
+        incoming.close();
+    });
+    if (receiveThread.joinable()) {
+        if (receiveThread.get_id() == std::this_thread::get_id()) {
+            // stopped from within onMessageReceived
+            receiveThread.detach();
+        } else {
+            receiveThread.join();
+        }
+    }
+}
+
+void ShmChannel::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    // messages which do not fit into the ring and messages for a peer which has abandoned the
+    // channel are sent via the WebSocket connection
+    const bool useFallback = !isConnected() || message.size() > outgoing.getMaxMessageSize();
+    if (useFallback && fallbackSender) {
+        JOYNR_LOG_TRACE(logger(), "sending message of size {} via fallback", message.size());
+        fallbackSender->send(message, onFailure);
+        return;
+    }
+    if (useFallback) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "shared memory channel not usable. Unable to send message"));
+        return;
+    }
+
+    bool written = false;
+    bool isAccessible;
+    {
+        std::lock_guard<std::mutex> lock(outgoingMutex);
+        isAccessible = accessSegment([this, &message, &written]() {
+            written = outgoing.tryWrite(message.data(), message.size());
+        });
+    }
+    if (!isAccessible && fallbackSender) {
+        fallbackSender->send(message, onFailure);
+        return;
+    }
+    if (!written) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "shared memory ring full. Unable to send message"));
+    }
+}
+
+bool ShmChannel::isInitialized() const
+{
+    return isConnected();
+}
+
+bool ShmChannel::isConnected() const
+{
+    if (stopped || faulted) {
+        return false;
+    }
+    bool isClosed = true;
+    const bool isAccessible = segment->access(
+            [this, &isClosed]() { isClosed = outgoing.isClosed(); });
+    return isAccessible && !isClosed;
+}
+
+void ShmChannel::receiveLoop()
+{
+    smrf::ByteVector message;
+    int idlePolls = 0;
+    while (!stopped) {
+        bool received = false;
+        bool isCorrupted = false;
+        bool isClosed = false;
+        const bool isAccessible =
+                accessSegment([this, &message, &received, &isCorrupted, &isClosed]() {
+                    received = incoming.tryRead(message);
+                    if (!received) {
+                        isCorrupted = incoming.isCorrupted();
+                        isClosed = incoming.isClosed();
+                    }
+                });
+        if (!isAccessible) {
+            return;
+        }
+        if (received) {
+            idlePolls = 0;
+            if (onMessageReceived) {
+                onMessageReceived(std::move(message));
+            }
+            message = smrf::ByteVector();
+            continue;
+        }
+        if (isCorrupted) {
+            // the peer is not trusted any more, further messages are sent via the fallback
+            JOYNR_LOG_ERROR(logger(), "invalid data in shared memory channel, closing it");
+            accessSegment([this]() { outgoing.close(); });
+            return;
+        }
+        if (isClosed) {
+            JOYNR_LOG_INFO(logger(), "shared memory channel closed");
+            return;
+        }
+        if (++idlePolls < IDLE_POLL_COUNT) {
+            continue;
+        }
+        idlePolls = 0;
+        accessSegment([this]() { incoming.waitForMessage(MAX_IDLE_WAIT); });
+    }
+}
+
+} // namespace joynr
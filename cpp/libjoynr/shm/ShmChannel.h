@@ -0,0 +1,106 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHMCHANNEL_H
+#define SHMCHANNEL_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class ShmRingBuffer;
+class ShmSegment;
+
+/**
+ * @brief Sends and receives SMRF messages through the rings of a shared memory segment.
+ *
+ * Outgoing messages are copied directly from the serialized message into the ring. Incoming
+ * messages are consumed by a dedicated thread which polls the ring for a short while before it
+ * sleeps on the futex of the ring, so bursts of messages do not cause any system call.
+ * Messages which are too large for the ring, or which are sent after the peer has closed the
+ * channel, are sent via the fallback sender (the WebSocket connection used for the handshake).
+ */
+class JOYNR_EXPORT ShmChannel : public IWebSocketSendInterface
+{
+public:
+    enum class Side { LibJoynr, ClusterController };
+
+    ShmChannel(std::unique_ptr<ShmSegment> segment,
+               Side side,
+               std::shared_ptr<IWebSocketSendInterface> fallbackSender);
+
+    ~ShmChannel() override;
+
+    /**
+     * @brief Starts the thread which consumes incoming messages; subsequent calls are ignored.
+     */
+    void start(std::function<void(smrf::ByteVector&&)> onMessageReceived);
+
+    /**
+     * @brief Closes both rings and joins the receive thread.
+     */
+    void stop();
+
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ShmChannel);
+
+    void receiveLoop();
+
+    // accesses the segment unless it has been shrunk by the peer before; afterwards the channel
+    // is treated as closed and messages are sent via the fallback
+    template <typename Function>
+    bool accessSegment(Function&& function);
+
+
+    std::unique_ptr<ShmSegment> segment;
+    ShmRingBuffer& outgoing;
+    ShmRingBuffer& incoming;
+    std::shared_ptr<IWebSocketSendInterface> fallbackSender;
+    std::function<void(smrf::ByteVector&&)> onMessageReceived;
+    // the ring has a single producer, senders from different threads are serialized
+    std::mutex outgoingMutex;
+    std::atomic<bool> stopped;
+    std::atomic<bool> faulted;
+    std::thread receiveThread;
+
+    ADD_LOGGER(ShmChannel)
+};
+
+} // namespace joynr
+#endif // SHMCHANNEL_H
@@ -0,0 +1,147 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shm/ShmClient.h"
+
+#include <algorithm>
+#include <string>
+
+#include "joynr/Util.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shm/ShmChannel.h"
+#include "libjoynr/shm/ShmSegment.h"
+
+namespace joynr
+{
+
+ShmClient::ShmClient(std::shared_ptr<IWebSocketSendInterface> webSocketSender,
+                     std::uint64_t ringSize,
+                     std::chrono::milliseconds attachTimeout)
+        : webSocketSender(std::move(webSocketSender)),
+          ringSize(ringSize),
+          attachTimeout(attachTimeout),
+          onMessageReceivedCallback(nullptr),
+          channelMutex(),
+          channel()
+{
+}
+
+ShmClient::~ShmClient()
+{
+    disconnect();
+}
+
+void ShmClient::registerReceiveCallback(std::function<void(smrf::ByteVector&&)> callback)
+{
+    onMessageReceivedCallback = std::move(callback);
+}
+
+bool ShmClient::negotiate()
+{
+    disconnect();
+
+    std::string uuid = util::createUuid();
+    uuid.erase(std::remove(uuid.begin(), uuid.end(), '-'), uuid.end());
+    const std::string name = ShmSegment::NAME_PREFIX() + uuid;
+
+    std::unique_ptr<ShmSegment> segment;
+    try {
+        segment = ShmSegment::create(name, ringSize);
+    } catch (const exceptions::JoynrRuntimeException& e) {
+        JOYNR_LOG_ERROR(logger(), "{}, using WebSocket connection", e.getMessage());
+        return false;
+    }
+
+    const std::string offer = ShmSegment::OFFER_MESSAGE_PREFIX() + name;
+    const smrf::ByteVector offerMessage(offer.cbegin(), offer.cend());
+    webSocketSender->send(
+            smrf::ByteArrayView(offerMessage), [](const exceptions::JoynrRuntimeException& e) {
+                JOYNR_LOG_ERROR(logger(),
+                                "Sending shared memory offer failed. Error: {}",
+                                e.getMessage());
+            });
+
+    if (!segment->waitForAttached(attachTimeout)) {
+        JOYNR_LOG_INFO(logger(),
+                       "cluster controller did not attach to shared memory {} within {} ms, "
+                       "using WebSocket connection",
+                       name,
+                       attachTimeout.count());
+        // a cluster controller attaching late must not use the abandoned rings
+        segment->getLibJoynrToClusterControllerRing().close();
+        segment->getClusterControllerToLibJoynrRing().close();
+        return false;
+    }
+    segment->unlink();
+
+    auto newChannel = std::make_shared<ShmChannel>(
+            std::move(segment), ShmChannel::Side::LibJoynr, webSocketSender);
+    newChannel->start([this](smrf::ByteVector&& message) {
+        if (onMessageReceivedCallback) {
+            onMessageReceivedCallback(std::move(message));
+        }
+    });
+    {
+        std::lock_guard<std::mutex> lock(channelMutex);
+        channel = std::move(newChannel);
+    }
+    JOYNR_LOG_INFO(logger(), "using shared memory channel {}", name);
+    return true;
+}
+
+void ShmClient::disconnect()
+{
+    std::shared_ptr<ShmChannel> oldChannel;
+    {
+        std::lock_guard<std::mutex> lock(channelMutex);
+        oldChannel = std::move(channel);
+        channel.reset();
+    }
+    if (oldChannel) {
+        oldChannel->stop();
+    }
+}
+
+void ShmClient::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    std::shared_ptr<ShmChannel> currentChannel;
+    {
+        std::lock_guard<std::mutex> lock(channelMutex);
+        currentChannel = channel;
+    }
+    if (currentChannel) {
+        currentChannel->send(message, onFailure);
+    } else {
+        webSocketSender->send(message, onFailure);
+    }
+}
+
+bool ShmClient::isInitialized() const
+{
+    return webSocketSender->isInitialized();
+}
+
+bool ShmClient::isConnected() const
+{
+    // the WebSocket connection is the control channel and determines the connection state
+    return webSocketSender->isConnected();
+}
+
+} // namespace joynr
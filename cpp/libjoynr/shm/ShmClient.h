@@ -0,0 +1,96 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHMCLIENT_H
+#define SHMCLIENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class ShmChannel;
+
+/**
+ * @brief Sender of a libjoynr runtime towards its cluster controller which uses a shared memory
+ * channel whenever the cluster controller accepted one, and the WebSocket connection otherwise.
+ *
+ * The channel is negotiated over the WebSocket connection right before the initialization
+ * message is sent: the runtime creates a segment, offers its name and waits until the cluster
+ * controller has attached to it. Cluster controllers without shared memory support ignore the
+ * offer, in which case the WebSocket connection is used after the attach timeout.
+ */
+class JOYNR_EXPORT ShmClient : public IWebSocketSendInterface
+{
+public:
+    ShmClient(std::shared_ptr<IWebSocketSendInterface> webSocketSender,
+              std::uint64_t ringSize,
+              std::chrono::milliseconds attachTimeout);
+
+    ~ShmClient() override;
+
+    void registerReceiveCallback(std::function<void(smrf::ByteVector&&)> callback);
+
+    /**
+     * @brief Offers a new shared memory channel to the cluster controller and blocks until it
+     * has been accepted or the attach timeout expired.
+     * @return true if messages are exchanged via shared memory from now on
+     */
+    bool negotiate();
+
+    /**
+     * @brief Closes the shared memory channel, e.g. because the WebSocket connection was lost.
+     */
+    void disconnect();
+
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ShmClient);
+
+    std::shared_ptr<IWebSocketSendInterface> webSocketSender;
+    const std::uint64_t ringSize;
+    const std::chrono::milliseconds attachTimeout;
+    std::function<void(smrf::ByteVector&&)> onMessageReceivedCallback;
+
+    mutable std::mutex channelMutex;
+    std::shared_ptr<ShmChannel> channel;
+
+    ADD_LOGGER(ShmClient)
+};
+
+} // namespace joynr
+#endif // SHMCLIENT_H
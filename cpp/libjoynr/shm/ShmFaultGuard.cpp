@@ -0,0 +1,95 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shm/ShmFaultGuard.h"
+
+#include <signal.h>
+
+#include <cstdint>
+#include <mutex>
+
+namespace joynr
+{
+
+namespace
+{
+
+// guarded range of the current thread; only read by the signal handler of the same thread
+struct GuardedRange
+{
+    sigjmp_buf* jumpBuffer;
+    const void* begin;
+    std::size_t size;
+};
+thread_local GuardedRange guardedRange = {nullptr, nullptr, 0};
+
+struct sigaction previousAction;
+
+void onBusError(int signalNumber, siginfo_t* info, void* context)
+{
+    const GuardedRange& range = guardedRange;
+    const auto faultAddress = reinterpret_cast<std::uintptr_t>(info->si_addr);
+    const auto begin = reinterpret_cast<std::uintptr_t>(range.begin);
+    if (range.jumpBuffer != nullptr && faultAddress >= begin &&
+        faultAddress - begin < range.size) {
+        siglongjmp(*range.jumpBuffer, 1);
+    }
+
+    // not caused by a guarded access
+    if ((previousAction.sa_flags & SA_SIGINFO) != 0) {
+        previousAction.sa_sigaction(signalNumber, info, context);
+    } else if (previousAction.sa_handler != SIG_DFL && previousAction.sa_handler != SIG_IGN) {
+        previousAction.sa_handler(signalNumber);
+    } else {
+        // the faulting access is repeated after returning and terminates the process
+        signal(signalNumber, SIG_DFL);
+    }
+}
+
+} // namespace
+
+ShmFaultGuard::Scope::Scope(sigjmp_buf* jumpBuffer, const void* begin, std::size_t size)
+        : previousJumpBuffer(guardedRange.jumpBuffer),
+          previousBegin(guardedRange.begin),
+          previousSize(guardedRange.size)
+{
+    guardedRange.begin = begin;
+    guardedRange.size = size;
+    guardedRange.jumpBuffer = jumpBuffer;
+}
+
+ShmFaultGuard::Scope::~Scope()
+{
+    guardedRange.jumpBuffer = previousJumpBuffer;
+    guardedRange.begin = previousBegin;
+    guardedRange.size = previousSize;
+}
+
+void ShmFaultGuard::installHandler()
+{
+    static std::once_flag installed;
+    std::call_once(installed, []() {
+        struct sigaction action = {};
+        action.sa_sigaction = &onBusError;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_SIGINFO | SA_NODEFER | SA_ONSTACK;
+        sigaction(SIGBUS, &action, &previousAction);
+    });
+}
+
+} // namespace joynr
@@ -0,0 +1,78 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHMFAULTGUARD_H
+#define SHMFAULTGUARD_H
+
+#include <csetjmp>
+#include <cstddef>
+
+#include "joynr/JoynrExport.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Turns a SIGBUS raised by an access to a shared memory segment into a return value.
+ *
+ * Every process which can write to a segment can also shrink it; afterwards each access to the
+ * removed pages raises SIGBUS. run() leaves such an access with siglongjmp, so the function it
+ * calls must not own resources like locks or temporaries with destructors. SIGBUS outside of a
+ * guarded access is passed on to the previously installed handler.
+ */
+class JOYNR_EXPORT ShmFaultGuard
+{
+public:
+    /**
+     * @brief Calls function.
+     * @return false if function raised SIGBUS within [begin, begin + size)
+     */
+    template <typename Function>
+    static bool run(const void* begin, std::size_t size, Function&& function)
+    {
+        installHandler();
+        sigjmp_buf jumpBuffer;
+        Scope scope(&jumpBuffer, begin, size);
+        // the signal mask is not saved, this would cost a system call per access; the handler
+        // is installed with SA_NODEFER and leaves SIGBUS unblocked
+        if (sigsetjmp(jumpBuffer, 0) != 0) {
+            return false;
+        }
+        function();
+        return true;
+    }
+
+private:
+    // registers the guarded range of the calling thread, restores the enclosing one on exit
+    class JOYNR_EXPORT Scope
+    {
+    public:
+        Scope(sigjmp_buf* jumpBuffer, const void* begin, std::size_t size);
+        ~Scope();
+
+    private:
+        sigjmp_buf* previousJumpBuffer;
+        const void* previousBegin;
+        std::size_t previousSize;
+    };
+
+    static void installHandler();
+};
+
+} // namespace joynr
+#endif // SHMFAULTGUARD_H
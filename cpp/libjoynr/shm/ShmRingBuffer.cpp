@@ -0,0 +1,217 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shm/ShmRingBuffer.h"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+#include <ctime>
+
+namespace joynr
+{
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "futex word must be a plain 32 bit integer");
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "64 bit atomics must be lock free to be shared between processes");
+
+constexpr std::uint64_t ShmRingBuffer::RECORD_ALIGNMENT;
+constexpr std::uint32_t ShmRingBuffer::WRAP_MARKER;
+
+namespace
+{
+
+int futex(std::atomic<std::uint32_t>* address,
+          int operation,
+          std::uint32_t value,
+          const struct timespec* timeout)
+{
+    // no FUTEX_PRIVATE_FLAG: the futex word is shared with another process
+    return static_cast<int>(syscall(SYS_futex,
+                                    reinterpret_cast<std::uint32_t*>(address),
+                                    operation,
+                                    value,
+                                    timeout,
+                                    nullptr,
+                                    0));
+}
+
+} // namespace
+
+ShmRingBuffer::ShmRingBuffer(ShmRingHeader* header, std::uint8_t* data, std::uint64_t capacity)
+        : header(header), data(data), capacity(capacity), corrupted(false)
+{
+    // positions are computed with a mask and records never cross the end of the ring
+    assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    assert(capacity % RECORD_ALIGNMENT == 0);
+}
+
+void ShmRingBuffer::reset()
+{
+    header->writeIndex.store(0, std::memory_order_relaxed);
+    header->readIndex.store(0, std::memory_order_relaxed);
+    header->consumerWaiting.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_release);
+}
+
+bool ShmRingBuffer::tryWrite(const std::uint8_t* message, std::size_t size)
+{
+    if (size > getMaxMessageSize()) {
+        return false;
+    }
+    const std::uint64_t recordSize = getRecordSize(size);
+    std::uint64_t writeIndex = header->writeIndex.load(std::memory_order_relaxed);
+    const std::uint64_t readIndex = header->readIndex.load(std::memory_order_acquire);
+
+    std::uint64_t position = writeIndex & (capacity - 1);
+    const std::uint64_t spaceUntilEnd = capacity - position;
+    const std::uint64_t paddingSize = (recordSize > spaceUntilEnd) ? spaceUntilEnd : 0;
+    if (capacity - (writeIndex - readIndex) < recordSize + paddingSize) {
+        return false;
+    }
+
+    if (paddingSize > 0) {
+        const std::uint32_t wrapMarker = WRAP_MARKER;
+        std::memcpy(data + position, &wrapMarker, sizeof(wrapMarker));
+        writeIndex += paddingSize;
+        position = 0;
+    }
+    const std::uint32_t messageSize = static_cast<std::uint32_t>(size);
+    std::memcpy(data + position, &messageSize, sizeof(messageSize));
+    std::memcpy(data + position + sizeof(messageSize), message, size);
+
+    // sequentially consistent, pairs with waitForMessage: either the consumer sees the new write
+    // index or this thread sees the waiting flag
+    header->writeIndex.store(writeIndex + recordSize, std::memory_order_seq_cst);
+    wakeConsumer();
+    return true;
+}
+
+bool ShmRingBuffer::tryRead(smrf::ByteVector& message)
+{
+    if (corrupted) {
+        return false;
+    }
+    // both indices and the record are written by the peer process and must not be trusted
+    std::uint64_t readIndex = header->readIndex.load(std::memory_order_relaxed);
+    const std::uint64_t writeIndex = header->writeIndex.load(std::memory_order_acquire);
+    if (readIndex == writeIndex) {
+        return false;
+    }
+    std::uint64_t available = writeIndex - readIndex;
+    if (available > capacity) {
+        return rejectRecord("inconsistent ring indices");
+    }
+
+    std::uint64_t position = readIndex & (capacity - 1);
+    if (position + sizeof(std::uint32_t) > capacity || available < sizeof(std::uint32_t)) {
+        return rejectRecord("truncated record header");
+    }
+    std::uint32_t messageSize;
+    std::memcpy(&messageSize, data + position, sizeof(messageSize));
+    if (messageSize == WRAP_MARKER) {
+        const std::uint64_t paddingSize = capacity - position;
+        if (paddingSize + sizeof(std::uint32_t) > available) {
+            return rejectRecord("truncated record after wrap marker");
+        }
+        readIndex += paddingSize;
+        available -= paddingSize;
+        position = 0;
+        std::memcpy(&messageSize, data, sizeof(messageSize));
+    }
+    const std::uint64_t recordSize = getRecordSize(messageSize);
+    if (position + sizeof(std::uint32_t) + messageSize > capacity || recordSize > available) {
+        return rejectRecord("record exceeds ring");
+    }
+    const std::uint8_t* payload = data + position + sizeof(messageSize);
+    message.assign(payload, payload + messageSize);
+
+    header->readIndex.store(readIndex + recordSize, std::memory_order_release);
+    return true;
+}
+
+bool ShmRingBuffer::waitForMessage(std::chrono::milliseconds timeout)
+{
+    header->consumerWaiting.store(1, std::memory_order_seq_cst);
+    const bool isEmptyAfterAnnouncement = header->readIndex.load(std::memory_order_relaxed) ==
+                                          header->writeIndex.load(std::memory_order_seq_cst);
+    if (!isEmptyAfterAnnouncement || header->closed.load(std::memory_order_seq_cst) != 0) {
+        header->consumerWaiting.store(0, std::memory_order_relaxed);
+        return !isEmpty();
+    }
+
+    struct timespec relativeTimeout;
+    relativeTimeout.tv_sec = static_cast<std::time_t>(timeout.count() / 1000);
+    relativeTimeout.tv_nsec = static_cast<long>((timeout.count() % 1000) * 1000000);
+    futex(&header->consumerWaiting, FUTEX_WAIT, 1, &relativeTimeout);
+
+    header->consumerWaiting.store(0, std::memory_order_relaxed);
+    return !isEmpty();
+}
+
+void ShmRingBuffer::close()
+{
+    header->closed.store(1, std::memory_order_seq_cst);
+    header->consumerWaiting.store(0, std::memory_order_seq_cst);
+    futex(&header->consumerWaiting, FUTEX_WAKE, 1, nullptr);
+}
+
+bool ShmRingBuffer::isCorrupted() const
+{
+    return corrupted;
+}
+
+bool ShmRingBuffer::isClosed() const
+{
+    return header->closed.load(std::memory_order_acquire) != 0;
+}
+
+bool ShmRingBuffer::isEmpty() const
+{
+    return header->readIndex.load(std::memory_order_relaxed) ==
+           header->writeIndex.load(std::memory_order_acquire);
+}
+
+std::size_t ShmRingBuffer::getMaxMessageSize() const
+{
+    // a record may need to be preceded by padding up to its own size, so only half of the ring
+    // is guaranteed to be usable for a single message
+    return static_cast<std::size_t>(capacity / 2 - sizeof(std::uint32_t));
+}
+
+bool ShmRingBuffer::rejectRecord(const char* reason)
+{
+    JOYNR_LOG_ERROR(logger(), "closing shared memory ring: {}", reason);
+    corrupted = true;
+    close();
+    return false;
+}
+
+void ShmRingBuffer::wakeConsumer()
+{
+    if (header->consumerWaiting.load(std::memory_order_seq_cst) != 0 &&
+        header->consumerWaiting.exchange(0, std::memory_order_seq_cst) != 0) {
+        futex(&header->consumerWaiting, FUTEX_WAKE, 1, nullptr);
+    }
+}
+
+} // namespace joynr
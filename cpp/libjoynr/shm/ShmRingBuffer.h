@@ -0,0 +1,136 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHMRINGBUFFER_H
+#define SHMRINGBUFFER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <smrf/ByteVector.h>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Control block of a ring which is placed in shared memory. Producer and consumer index
+ * are kept on separate cache lines. The indices grow monotonically; the position within the
+ * ring is the index modulo the capacity.
+ */
+struct ShmRingHeader
+{
+    alignas(64) std::atomic<std::uint64_t> writeIndex;
+    alignas(64) std::atomic<std::uint64_t> readIndex;
+    // futex word, set by the consumer before it goes to sleep
+    alignas(64) std::atomic<std::uint32_t> consumerWaiting;
+    std::atomic<std::uint32_t> closed;
+};
+
+/**
+ * @brief Single producer / single consumer ring of length-prefixed messages which lives in
+ * memory shared between two processes.
+ *
+ * Every message is stored as 4 byte length followed by the payload, padded to 8 bytes. A message
+ * which does not fit into the remaining space at the end of the ring is preceded by a wrap
+ * marker and stored at the beginning of the ring. The producer only issues a futex wake-up if
+ * the consumer announced that it is about to sleep, so neither side needs a system call while
+ * messages keep flowing.
+ *
+ * The object itself only references the shared memory and must not be used concurrently by
+ * more than one producer and one consumer.
+ */
+class JOYNR_EXPORT ShmRingBuffer
+{
+public:
+    ShmRingBuffer(ShmRingHeader* header, std::uint8_t* data, std::uint64_t capacity);
+
+    /**
+     * @brief Initializes the control block; only called by the creator of the shared memory.
+     */
+    void reset();
+
+    /**
+     * @brief Copies a message into the ring.
+     * @return false if there is currently not enough free space
+     */
+    bool tryWrite(const std::uint8_t* message, std::size_t size);
+
+    /**
+     * @brief Moves the oldest message out of the ring. The indices and the record are validated
+     * since they are written by the peer process; an invalid record closes the ring.
+     * @return false if the ring is empty or corrupted
+     */
+    bool tryRead(smrf::ByteVector& message);
+
+    /**
+     * @brief Blocks the consumer until a message is available, the ring is closed or the
+     * timeout expires.
+     * @return true if a message is available
+     */
+    bool waitForMessage(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Marks the ring as closed and wakes up a waiting consumer.
+     */
+    void close();
+
+    bool isClosed() const;
+
+    /**
+     * @brief Whether the consumer found an invalid record and closed the ring.
+     */
+    bool isCorrupted() const;
+
+    bool isEmpty() const;
+
+    /**
+     * @brief Size of the largest message which fits into the ring.
+     */
+    std::size_t getMaxMessageSize() const;
+
+    static constexpr std::uint64_t getRecordSize(std::size_t messageSize)
+    {
+        return (sizeof(std::uint32_t) + messageSize + RECORD_ALIGNMENT - 1) &
+               ~(RECORD_ALIGNMENT - 1);
+    }
+
+    static constexpr std::uint64_t RECORD_ALIGNMENT = 8;
+
+private:
+    static constexpr std::uint32_t WRAP_MARKER = 0xFFFFFFFF;
+
+    void wakeConsumer();
+    // takes a literal, tryRead() must not create objects with destructors (see ShmFaultGuard)
+    bool rejectRecord(const char* reason);
+
+    ShmRingHeader* header;
+    std::uint8_t* data;
+    const std::uint64_t capacity;
+    bool corrupted;
+
+    ADD_LOGGER(ShmRingBuffer)
+};
+
+} // namespace joynr
+#endif // SHMRINGBUFFER_H
@@ -0,0 +1,263 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shm/ShmSegment.h"
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+namespace
+{
+constexpr std::uint32_t SEGMENT_MAGIC = 0x4A534D31; // "JSM1"
+constexpr std::uint32_t SEGMENT_VERSION = 1;
+constexpr std::uint64_t MIN_RING_CAPACITY = 4096;
+constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+std::string errnoToString(int error)
+{
+    return std::string(std::strerror(error));
+}
+} // namespace
+
+struct ShmSegment::Header
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t ringCapacity;
+    // futex word, set by the cluster controller once it has mapped the segment
+    alignas(CACHE_LINE_SIZE) std::atomic<std::uint32_t> attached;
+    ShmRingHeader libJoynrToClusterController;
+    ShmRingHeader clusterControllerToLibJoynr;
+};
+
+const std::string& ShmSegment::OFFER_MESSAGE_PREFIX()
+{
+    static const std::string value("joynr.SharedMemoryOffer:");
+    return value;
+}
+
+const std::string& ShmSegment::NAME_PREFIX()
+{
+    static const std::string value("/joynr-shm-");
+    return value;
+}
+
+ShmSegment::ShmSegment(std::string name,
+                       void* address,
+                       std::size_t size,
+                       std::uint64_t ringCapacity,
+                       bool isLinked)
+        : name(std::move(name)),
+          address(address),
+          size(size),
+          isLinked(isLinked),
+          header(static_cast<Header*>(address)),
+          libJoynrToClusterControllerRing(),
+          clusterControllerToLibJoynrRing()
+{
+    std::uint8_t* data = static_cast<std::uint8_t*>(address) + getSegmentSize(0);
+    libJoynrToClusterControllerRing = std::make_unique<ShmRingBuffer>(
+            &header->libJoynrToClusterController, data, ringCapacity);
+    clusterControllerToLibJoynrRing = std::make_unique<ShmRingBuffer>(
+            &header->clusterControllerToLibJoynr, data + ringCapacity, ringCapacity);
+}
+
+ShmSegment::~ShmSegment()
+{
+    if (isLinked) {
+        unlink();
+    }
+    if (munmap(address, size) != 0) {
+        JOYNR_LOG_ERROR(logger(),
+                        "unmapping shared memory {} failed: {}",
+                        name,
+                        errnoToString(errno));
+    }
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::create(const std::string& name,
+                                               std::uint64_t ringCapacity)
+{
+    std::uint64_t capacity = MIN_RING_CAPACITY;
+    while (capacity < ringCapacity) {
+        capacity <<= 1;
+    }
+    const std::size_t segmentSize = getSegmentSize(capacity);
+
+    // group access allows a cluster controller which runs as different user of the same group
+    const int fd = shm_open(
+            name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
+    if (fd < 0) {
+        throw exceptions::JoynrRuntimeException("Unable to create shared memory " + name + ": " +
+                                                errnoToString(errno));
+    }
+    if (ftruncate(fd, static_cast<off_t>(segmentSize)) != 0) {
+        const int error = errno;
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw exceptions::JoynrRuntimeException("Unable to resize shared memory " + name + ": " +
+                                                errnoToString(error));
+    }
+    void* address = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw exceptions::JoynrRuntimeException("Unable to map shared memory " + name + ": " +
+                                                errnoToString(error));
+    }
+
+    // the new object is zero-filled which is a valid initial state for all atomics
+    Header* header = static_cast<Header*>(address);
+    header->magic = SEGMENT_MAGIC;
+    header->version = SEGMENT_VERSION;
+    header->ringCapacity = capacity;
+    header->attached.store(0, std::memory_order_release);
+
+    std::unique_ptr<ShmSegment> segment(new ShmSegment(name, address, segmentSize, capacity, true));
+    segment->libJoynrToClusterControllerRing->reset();
+    segment->clusterControllerToLibJoynrRing->reset();
+    return segment;
+}
+
+std::unique_ptr<ShmSegment> ShmSegment::open(const std::string& name)
+{
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw exceptions::JoynrRuntimeException("Unable to open shared memory " + name + ": " +
+                                                errnoToString(errno));
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(getSegmentSize(0))) {
+        ::close(fd);
+        throw exceptions::JoynrRuntimeException("Shared memory " + name + " is too small");
+    }
+    if ((status.st_mode & S_IWOTH) != 0) {
+        ::close(fd);
+        throw exceptions::JoynrRuntimeException("Shared memory " + name +
+                                                " is writable by other users");
+    }
+    const std::size_t segmentSize = static_cast<std::size_t>(status.st_size);
+    void* address = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw exceptions::JoynrRuntimeException("Unable to map shared memory " + name + ": " +
+                                                errnoToString(error));
+    }
+
+    // the creator may already have shrunk the segment again
+    const Header* header = static_cast<const Header*>(address);
+    std::uint64_t capacity = 0;
+    bool isValid = false;
+    const bool isAccessible =
+            ShmFaultGuard::run(address, segmentSize, [header, &capacity, &isValid]() {
+                capacity = header->ringCapacity;
+                isValid = header->magic == SEGMENT_MAGIC && header->version == SEGMENT_VERSION;
+            });
+    if (!isAccessible || !isValid || capacity < MIN_RING_CAPACITY ||
+        (capacity & (capacity - 1)) != 0 || getSegmentSize(capacity) != segmentSize) {
+        munmap(address, segmentSize);
+        throw exceptions::JoynrRuntimeException("Shared memory " + name +
+                                                " has an unexpected layout");
+    }
+    return std::unique_ptr<ShmSegment>(
+            new ShmSegment(name, address, segmentSize, capacity, false));
+}
+
+const std::string& ShmSegment::getName() const
+{
+    return name;
+}
+
+void ShmSegment::unlink()
+{
+    isLinked = false;
+    // the name is removed by whichever side comes first
+    if (shm_unlink(name.c_str()) != 0 && errno != ENOENT) {
+        JOYNR_LOG_ERROR(
+                logger(), "removing shared memory {} failed: {}", name, errnoToString(errno));
+    }
+}
+
+void ShmSegment::markAttached()
+{
+    header->attached.store(1, std::memory_order_release);
+    syscall(SYS_futex,
+            reinterpret_cast<std::uint32_t*>(&header->attached),
+            FUTEX_WAKE,
+            1,
+            nullptr,
+            nullptr,
+            0);
+}
+
+bool ShmSegment::waitForAttached(std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (header->attached.load(std::memory_order_acquire) == 0) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        struct timespec relativeTimeout;
+        relativeTimeout.tv_sec = static_cast<std::time_t>(remaining.count() / 1000000000);
+        relativeTimeout.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+        syscall(SYS_futex,
+                reinterpret_cast<std::uint32_t*>(&header->attached),
+                FUTEX_WAIT,
+                0,
+                &relativeTimeout,
+                nullptr,
+                0);
+    }
+    return true;
+}
+
+ShmRingBuffer& ShmSegment::getLibJoynrToClusterControllerRing()
+{
+    return *libJoynrToClusterControllerRing;
+}
+
+ShmRingBuffer& ShmSegment::getClusterControllerToLibJoynrRing()
+{
+    return *clusterControllerToLibJoynrRing;
+}
+
+std::size_t ShmSegment::getSegmentSize(std::uint64_t ringCapacity)
+{
+    const std::size_t headerSize =
+            (sizeof(Header) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+    return headerSize + 2 * static_cast<std::size_t>(ringCapacity);
+}
+
+} // namespace joynr
@@ -0,0 +1,129 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHMSEGMENT_H
+#define SHMSEGMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "libjoynr/shm/ShmFaultGuard.h"
+#include "libjoynr/shm/ShmRingBuffer.h"
+
+namespace joynr
+{
+
+/**
+ * @brief POSIX shared memory object holding one ring per direction between a libjoynr runtime
+ * and its cluster controller.
+ *
+ * The libjoynr runtime creates the segment and offers its name to the cluster controller over
+ * the already established WebSocket connection. The cluster controller opens the segment, removes
+ * its name and marks it as attached; from then on the segment lives only as long as both
+ * mappings exist.
+ */
+class JOYNR_EXPORT ShmSegment
+{
+public:
+    /**
+     * @brief Prefix of the WebSocket message which offers a segment; followed by its name.
+     */
+    static const std::string& OFFER_MESSAGE_PREFIX();
+
+    /**
+     * @brief Prefix of all segment names; names offered by a client must start with it.
+     */
+    static const std::string& NAME_PREFIX();
+
+    ~ShmSegment();
+
+    /**
+     * @brief Creates a new segment.
+     * @param name name of the shared memory object, must start with NAME_PREFIX()
+     * @param ringCapacity size of each ring in bytes, rounded up to the next power of two
+     * @throw JoynrRuntimeException if the segment cannot be created
+     */
+    static std::unique_ptr<ShmSegment> create(const std::string& name,
+                                              std::uint64_t ringCapacity);
+
+    /**
+     * @brief Maps an existing segment which was created by create(). The creator keeps the
+     * ability to shrink the segment, so all later accesses are made with access().
+     * @throw JoynrRuntimeException if the segment cannot be opened, is writable by other users
+     * or has an unexpected layout
+     */
+    static std::unique_ptr<ShmSegment> open(const std::string& name);
+
+    const std::string& getName() const;
+
+    /**
+     * @brief Removes the name of the segment; existing mappings stay valid.
+     */
+    void unlink();
+
+    void markAttached();
+    bool waitForAttached(std::chrono::milliseconds timeout);
+
+    ShmRingBuffer& getLibJoynrToClusterControllerRing();
+    ShmRingBuffer& getClusterControllerToLibJoynrRing();
+
+    /**
+     * @brief Calls function, which accesses the segment, guarded by ShmFaultGuard.
+     * @return false if the segment has been shrunk by the peer
+     */
+    template <typename Function>
+    bool access(Function&& function)
+    {
+        return ShmFaultGuard::run(address, size, std::forward<Function>(function));
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ShmSegment);
+
+    struct Header;
+
+    // ringCapacity is passed in since the copy in the header may be changed by the peer
+    ShmSegment(std::string name,
+               void* address,
+               std::size_t size,
+               std::uint64_t ringCapacity,
+               bool isLinked);
+
+    static std::size_t getSegmentSize(std::uint64_t ringCapacity);
+
+    std::string name;
+    void* address;
+    std::size_t size;
+    bool isLinked;
+    Header* header;
+    std::unique_ptr<ShmRingBuffer> libJoynrToClusterControllerRing;
+    std::unique_ptr<ShmRingBuffer> clusterControllerToLibJoynrRing;
+
+    ADD_LOGGER(ShmSegment)
+};
+
+} // namespace joynr
+#endif // SHMSEGMENT_H
@@ -0,0 +1,219 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/uds/UdsClient.h"
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include "joynr/Util.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/uds/UdsConnection.h"
+
+namespace joynr
+{
+
+UdsClient::UdsClient(boost::asio::io_service& ioService,
+                     std::chrono::milliseconds reconnectSleepTime,
+                     std::chrono::milliseconds reconnectMaxSleepTime)
+        : ioService(ioService),
+          reconnectTimer(ioService),
+          reconnectBackoff(reconnectSleepTime, reconnectMaxSleepTime),
+          address(),
+          onConnectionOpenedCallback(nullptr),
+          onReconnectedCallback(nullptr),
+          onConnectionClosedCallback(nullptr),
+          onMessageReceivedCallback(nullptr),
+          connectionMutex(),
+          connection(),
+          isRunning(true),
+          hasBeenConnected(false)
+{
+}
+
+UdsClient::~UdsClient()
+{
+    stop();
+}
+
+void UdsClient::registerConnectCallback(std::function<void()> callback)
+{
+    onConnectionOpenedCallback = std::move(callback);
+}
+
+void UdsClient::registerReconnectCallback(std::function<void()> callback)
+{
+    onReconnectedCallback = std::move(callback);
+}
+
+void UdsClient::registerDisconnectCallback(std::function<void()> callback)
+{
+    onConnectionClosedCallback = std::move(callback);
+}
+
+void UdsClient::registerReceiveCallback(std::function<void(smrf::ByteVector&&)> callback)
+{
+    onMessageReceivedCallback = std::move(callback);
+}
+
+void UdsClient::connect(const UdsAddress& address)
+{
+    this->address = address;
+    doConnect();
+}
+
+void UdsClient::stop()
+{
+    if (!isRunning.exchange(false)) {
+        return;
+    }
+    boost::system::error_code ignored;
+    reconnectTimer.cancel(ignored);
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    if (connection) {
+        connection->close();
+        connection.reset();
+    }
+}
+
+void UdsClient::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    std::shared_ptr<UdsConnection> currentConnection;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        currentConnection = connection;
+    }
+    if (!currentConnection) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "UDS connection not established. Unable to send message"));
+        return;
+    }
+    currentConnection->send(message, onFailure);
+}
+
+bool UdsClient::isInitialized() const
+{
+    return isConnected();
+}
+
+bool UdsClient::isConnected() const
+{
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    return connection && connection->isConnected();
+}
+
+std::shared_ptr<IWebSocketSendInterface> UdsClient::getSender()
+{
+    return shared_from_this();
+}
+
+void UdsClient::doConnect()
+{
+    if (!isRunning) {
+        return;
+    }
+    JOYNR_LOG_DEBUG(logger(), "connecting to {}", address.toString());
+    auto socket = std::make_shared<UdsConnection::Socket>(ioService);
+    socket->async_connect(
+            boost::asio::local::stream_protocol::endpoint(address.getPath()),
+            [thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
+             socket](const boost::system::error_code& error) {
+                auto thisSharedPtr = thisWeakPtr.lock();
+                if (!thisSharedPtr || !thisSharedPtr->isRunning) {
+                    return;
+                }
+                if (error) {
+                    JOYNR_LOG_ERROR(logger(),
+                                    "connection to {} failed: {}",
+                                    thisSharedPtr->address.toString(),
+                                    error.message());
+                    thisSharedPtr->scheduleReconnect();
+                    return;
+                }
+
+                auto newConnection = std::make_shared<UdsConnection>(
+                        thisSharedPtr->ioService,
+                        std::move(*socket),
+                        [thisWeakPtr](smrf::ByteVector&& message) {
+                            auto thisSharedPtr = thisWeakPtr.lock();
+                            if (thisSharedPtr && thisSharedPtr->onMessageReceivedCallback) {
+                                thisSharedPtr->onMessageReceivedCallback(std::move(message));
+                            }
+                        },
+                        [thisWeakPtr]() {
+                            if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                                thisSharedPtr->onConnectionClosed();
+                            }
+                        });
+                {
+                    std::lock_guard<std::mutex> lock(thisSharedPtr->connectionMutex);
+                    thisSharedPtr->connection = newConnection;
+                }
+                newConnection->start();
+                JOYNR_LOG_INFO(logger(), "connected to {}", thisSharedPtr->address.toString());
+                thisSharedPtr->reconnectBackoff.reset();
+
+                if (thisSharedPtr->hasBeenConnected) {
+                    if (thisSharedPtr->onReconnectedCallback) {
+                        thisSharedPtr->onReconnectedCallback();
+                    }
+                } else {
+                    thisSharedPtr->hasBeenConnected = true;
+                    if (thisSharedPtr->onConnectionOpenedCallback) {
+                        thisSharedPtr->onConnectionOpenedCallback();
+                    }
+                }
+            });
+}
+
+void UdsClient::onConnectionClosed()
+{
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        connection.reset();
+    }
+    if (!isRunning) {
+        return;
+    }
+    if (onConnectionClosedCallback) {
+        onConnectionClosedCallback();
+    }
+    scheduleReconnect();
+}
+
+void UdsClient::scheduleReconnect()
+{
+    if (!isRunning) {
+        return;
+    }
+    const std::chrono::milliseconds reconnectSleepTime = reconnectBackoff.nextSleepTime();
+    JOYNR_LOG_DEBUG(logger(), "reconnecting in {}ms", reconnectSleepTime.count());
+    reconnectTimer.expires_from_now(reconnectSleepTime);
+    reconnectTimer.async_wait([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+            const boost::system::error_code& error) {
+        if (error == boost::asio::error::operation_aborted) {
+            return;
+        }
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->doConnect();
+        }
+    });
+}
+
+} // namespace joynr
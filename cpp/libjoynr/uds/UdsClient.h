@@ -0,0 +1,108 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef UDSCLIENT_H
+#define UDSCLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/UdsAddress.h"
+#include "libjoynr/websocket/WebSocketReconnectBackoff.h"
+
+namespace joynr
+{
+
+class UdsConnection;
+
+/**
+ * @brief Connects a libjoynr runtime to the unix domain socket of a cluster controller and
+ * reconnects whenever the connection is lost. Offers the same callbacks as the WebSocket client.
+ */
+class JOYNR_EXPORT UdsClient : public IWebSocketSendInterface,
+                               public std::enable_shared_from_this<UdsClient>
+{
+public:
+    /**
+     * @param reconnectSleepTime initial sleep time before reconnecting
+     * @param reconnectMaxSleepTime the sleep time backs off up to this limit, see
+     * WebSocketReconnectBackoff
+     */
+    UdsClient(boost::asio::io_service& ioService,
+              std::chrono::milliseconds reconnectSleepTime,
+              std::chrono::milliseconds reconnectMaxSleepTime);
+
+    ~UdsClient() override;
+
+    void registerConnectCallback(std::function<void()> callback);
+    void registerReconnectCallback(std::function<void()> callback);
+    void registerDisconnectCallback(std::function<void()> callback);
+    void registerReceiveCallback(std::function<void(smrf::ByteVector&&)> callback);
+
+    void connect(const UdsAddress& address);
+    void stop();
+
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+    std::shared_ptr<IWebSocketSendInterface> getSender();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(UdsClient);
+
+    void doConnect();
+    void onConnectionClosed();
+    void scheduleReconnect();
+
+    boost::asio::io_service& ioService;
+    boost::asio::steady_timer reconnectTimer;
+    WebSocketReconnectBackoff reconnectBackoff;
+    UdsAddress address;
+
+    std::function<void()> onConnectionOpenedCallback;
+    std::function<void()> onReconnectedCallback;
+    std::function<void()> onConnectionClosedCallback;
+    std::function<void(smrf::ByteVector&&)> onMessageReceivedCallback;
+
+    mutable std::mutex connectionMutex;
+    std::shared_ptr<UdsConnection> connection;
+    std::atomic<bool> isRunning;
+    bool hasBeenConnected;
+
+    ADD_LOGGER(UdsClient)
+};
+
+} // namespace joynr
+#endif // UDSCLIENT_H
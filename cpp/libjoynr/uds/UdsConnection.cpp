@@ -0,0 +1,245 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/uds/UdsConnection.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+constexpr std::uint32_t UdsConnection::MAX_MESSAGE_SIZE;
+
+UdsConnection::UdsConnection(boost::asio::io_service& ioService,
+                             Socket&& socket,
+                             std::function<void(smrf::ByteVector&&)> onMessageReceived,
+                             std::function<void()> onClosed)
+        : socket(std::move(socket)),
+          strand(ioService),
+          onMessageReceived(std::move(onMessageReceived)),
+          onClosed(std::move(onClosed)),
+          connected(true),
+          readHeaderBuffer(),
+          readBodyBuffer(),
+          pendingMessagesMutex(),
+          pendingMessages(),
+          messagesInFlight(),
+          isWriting(false)
+{
+}
+
+void UdsConnection::start()
+{
+    strand.dispatch([thisSharedPtr = shared_from_this()]() { thisSharedPtr->readHeader(); });
+}
+
+void UdsConnection::close()
+{
+    if (!connected.exchange(false)) {
+        return;
+    }
+    strand.post([thisSharedPtr = shared_from_this()]() {
+        boost::system::error_code ignored;
+        thisSharedPtr->socket.shutdown(Socket::shutdown_both, ignored);
+        thisSharedPtr->socket.close(ignored);
+    });
+}
+
+void UdsConnection::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    if (!connected) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "UDS connection not established. Unable to send message"));
+        return;
+    }
+    if (message.size() > MAX_MESSAGE_SIZE) {
+        onFailure(exceptions::JoynrRuntimeException(
+                "Message exceeds maximum size of UDS messages. Unable to send message"));
+        return;
+    }
+
+    const std::uint32_t messageSize = static_cast<std::uint32_t>(message.size());
+    PendingMessage pendingMessage;
+    pendingMessage.frame.reserve(sizeof(messageSize) + message.size());
+    pendingMessage.frame.push_back(static_cast<std::uint8_t>(messageSize >> 24));
+    pendingMessage.frame.push_back(static_cast<std::uint8_t>(messageSize >> 16));
+    pendingMessage.frame.push_back(static_cast<std::uint8_t>(messageSize >> 8));
+    pendingMessage.frame.push_back(static_cast<std::uint8_t>(messageSize));
+    pendingMessage.frame.insert(
+            pendingMessage.frame.end(), message.data(), message.data() + message.size());
+    pendingMessage.onFailure = onFailure;
+
+    bool startWriting = false;
+    {
+        std::lock_guard<std::mutex> lock(pendingMessagesMutex);
+        pendingMessages.push_back(std::move(pendingMessage));
+        if (!isWriting) {
+            isWriting = true;
+            startWriting = true;
+        }
+    }
+    if (startWriting) {
+        strand.post([thisSharedPtr = shared_from_this()]() { thisSharedPtr->writePending(); });
+    }
+}
+
+bool UdsConnection::isInitialized() const
+{
+    return connected;
+}
+
+bool UdsConnection::isConnected() const
+{
+    return connected;
+}
+
+void UdsConnection::readHeader()
+{
+    boost::asio::async_read(
+            socket,
+            boost::asio::buffer(readHeaderBuffer),
+            strand.wrap([thisSharedPtr = shared_from_this()](
+                    const boost::system::error_code& error, std::size_t) {
+                if (error) {
+                    thisSharedPtr->onError(error);
+                    return;
+                }
+                const HeaderBuffer& header = thisSharedPtr->readHeaderBuffer;
+                const std::uint32_t messageSize = (static_cast<std::uint32_t>(header[0]) << 24) |
+                                                  (static_cast<std::uint32_t>(header[1]) << 16) |
+                                                  (static_cast<std::uint32_t>(header[2]) << 8) |
+                                                  static_cast<std::uint32_t>(header[3]);
+                if (messageSize > MAX_MESSAGE_SIZE) {
+                    JOYNR_LOG_ERROR(logger(),
+                                    "received UDS message of size {} exceeds maximum size {}, "
+                                    "closing connection",
+                                    messageSize,
+                                    MAX_MESSAGE_SIZE);
+                    thisSharedPtr->onError(boost::asio::error::message_size);
+                    return;
+                }
+                thisSharedPtr->readBody(messageSize);
+            }));
+}
+
+void UdsConnection::readBody(std::uint32_t messageSize)
+{
+    readBodyBuffer.resize(messageSize);
+    boost::asio::async_read(
+            socket,
+            boost::asio::buffer(readBodyBuffer),
+            strand.wrap([thisSharedPtr = shared_from_this()](
+                    const boost::system::error_code& error, std::size_t) {
+                if (error) {
+                    thisSharedPtr->onError(error);
+                    return;
+                }
+                JOYNR_LOG_TRACE(logger(),
+                                "incoming UDS message of size {}",
+                                thisSharedPtr->readBodyBuffer.size());
+                if (thisSharedPtr->onMessageReceived) {
+                    thisSharedPtr->onMessageReceived(std::move(thisSharedPtr->readBodyBuffer));
+                }
+                thisSharedPtr->readBodyBuffer = smrf::ByteVector();
+                thisSharedPtr->readHeader();
+            }));
+}
+
+void UdsConnection::writePending()
+{
+    {
+        std::lock_guard<std::mutex> lock(pendingMessagesMutex);
+        messagesInFlight.swap(pendingMessages);
+    }
+    std::vector<boost::asio::const_buffer> buffers;
+    buffers.reserve(messagesInFlight.size());
+    for (const PendingMessage& pendingMessage : messagesInFlight) {
+        buffers.push_back(boost::asio::buffer(pendingMessage.frame));
+    }
+    boost::asio::async_write(socket,
+                             buffers,
+                             strand.wrap([thisSharedPtr = shared_from_this()](
+                                     const boost::system::error_code& error, std::size_t) {
+                                 thisSharedPtr->onWriteCompleted(error);
+                             }));
+}
+
+void UdsConnection::onWriteCompleted(const boost::system::error_code& error)
+{
+    if (!error) {
+        messagesInFlight.clear();
+        {
+            std::lock_guard<std::mutex> lock(pendingMessagesMutex);
+            if (pendingMessages.empty()) {
+                isWriting = false;
+                return;
+            }
+        }
+        writePending();
+        return;
+    }
+
+    std::vector<PendingMessage> failedMessages;
+    failedMessages.swap(messagesInFlight);
+    {
+        std::lock_guard<std::mutex> lock(pendingMessagesMutex);
+        std::move(pendingMessages.begin(),
+                  pendingMessages.end(),
+                  std::back_inserter(failedMessages));
+        pendingMessages.clear();
+        isWriting = false;
+    }
+    const exceptions::JoynrDelayMessageException exception(
+            "Error sending message via UDS connection: " + error.message());
+    for (const PendingMessage& failedMessage : failedMessages) {
+        if (failedMessage.onFailure) {
+            failedMessage.onFailure(exception);
+        }
+    }
+    onError(error);
+}
+
+void UdsConnection::onError(const boost::system::error_code& error)
+{
+    if (!connected.exchange(false)) {
+        // closed locally
+        return;
+    }
+    if (error == boost::asio::error::eof) {
+        JOYNR_LOG_INFO(logger(), "UDS connection closed by peer");
+    } else {
+        JOYNR_LOG_ERROR(logger(), "UDS connection error: {}", error.message());
+    }
+    boost::system::error_code ignored;
+    socket.close(ignored);
+    if (onClosed) {
+        onClosed();
+    }
+}
+
+} // namespace joynr
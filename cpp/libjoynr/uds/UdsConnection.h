@@ -0,0 +1,125 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef UDSCONNECTION_H
+#define UDSCONNECTION_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/strand.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief A connected unix domain stream socket which exchanges length-prefixed messages.
+ *
+ * Every message is preceded by its size as 4 byte unsigned integer in network byte order.
+ * Messages may be sent from any thread; all socket operations run on a strand of the
+ * io_service of the socket. Messages which are queued while a write is in progress are
+ * written together with a single gather write.
+ */
+class JOYNR_EXPORT UdsConnection : public IWebSocketSendInterface,
+                                   public std::enable_shared_from_this<UdsConnection>
+{
+public:
+    using Socket = boost::asio::local::stream_protocol::socket;
+
+    /*
+     * Same limit as the default maximum message size of WebSocket++. A peer announcing a larger
+     * message is considered broken and the connection is closed.
+     */
+    static constexpr std::uint32_t MAX_MESSAGE_SIZE = 32000000;
+
+    UdsConnection(boost::asio::io_service& ioService,
+                  Socket&& socket,
+                  std::function<void(smrf::ByteVector&&)> onMessageReceived,
+                  std::function<void()> onClosed);
+
+    ~UdsConnection() override = default;
+
+    /**
+     * @brief Starts receiving messages. Must be called once after construction.
+     */
+    void start();
+
+    /**
+     * @brief Closes the socket. The onClosed callback is not invoked for a connection which is
+     * closed locally.
+     */
+    void close();
+
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(UdsConnection);
+
+    using HeaderBuffer = std::array<std::uint8_t, sizeof(std::uint32_t)>;
+
+    struct PendingMessage
+    {
+        smrf::ByteVector frame;
+        std::function<void(const exceptions::JoynrRuntimeException&)> onFailure;
+    };
+
+    void readHeader();
+    void readBody(std::uint32_t messageSize);
+    void writePending();
+    void onWriteCompleted(const boost::system::error_code& error);
+    void onError(const boost::system::error_code& error);
+
+    Socket socket;
+    boost::asio::io_service::strand strand;
+    std::function<void(smrf::ByteVector&&)> onMessageReceived;
+    std::function<void()> onClosed;
+    std::atomic<bool> connected;
+
+    HeaderBuffer readHeaderBuffer;
+    smrf::ByteVector readBodyBuffer;
+
+    std::mutex pendingMessagesMutex;
+    std::vector<PendingMessage> pendingMessages;
+    std::vector<PendingMessage> messagesInFlight;
+    bool isWriting;
+
+    ADD_LOGGER(UdsConnection)
+};
+
+} // namespace joynr
+#endif // UDSCONNECTION_H
@@ -0,0 +1,78 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/uds/UdsMessagingStubFactory.h"
+
+#include "libjoynr/websocket/WebSocketMessagingStub.h"
+
+namespace joynr
+{
+
+UdsMessagingStubFactory::UdsMessagingStubFactory()
+        : serverStubMap(), serverStubMapMutex(), onMessagingStubClosedCallback(nullptr)
+{
+}
+
+bool UdsMessagingStubFactory::canCreate(const joynr::system::RoutingTypes::Address& destAddress)
+{
+    return dynamic_cast<const UdsAddress*>(&destAddress) != nullptr;
+}
+
+std::shared_ptr<IMessagingStub> UdsMessagingStubFactory::create(
+        const joynr::system::RoutingTypes::Address& destAddress)
+{
+    if (auto udsAddress = dynamic_cast<const UdsAddress*>(&destAddress)) {
+        std::lock_guard<std::mutex> lock(serverStubMapMutex);
+        auto stub = serverStubMap.find(udsAddress->getPath());
+        if (stub == serverStubMap.cend()) {
+            JOYNR_LOG_ERROR(
+                    logger(), "No UDS connection found for address {}", udsAddress->toString());
+            return std::shared_ptr<IMessagingStub>();
+        }
+        return stub->second;
+    }
+    return std::shared_ptr<IMessagingStub>();
+}
+
+void UdsMessagingStubFactory::addServer(const UdsAddress& serverAddress,
+                                        std::shared_ptr<IWebSocketSendInterface> udsSender)
+{
+    // the WebSocket messaging stub only depends on the generic send interface
+    auto serverStub = std::make_shared<WebSocketMessagingStub>(std::move(udsSender));
+    std::lock_guard<std::mutex> lock(serverStubMapMutex);
+    serverStubMap[serverAddress.getPath()] = std::move(serverStub);
+}
+
+void UdsMessagingStubFactory::onMessagingStubClosed(const UdsAddress& address)
+{
+    // the stub is kept since the UDS client reconnects on its own; messages sent in the
+    // meantime are delayed by the stub
+    JOYNR_LOG_INFO(logger(), "connection closed for address: {}", address.toString());
+    if (onMessagingStubClosedCallback) {
+        onMessagingStubClosedCallback(std::make_shared<const UdsAddress>(address));
+    }
+}
+
+void UdsMessagingStubFactory::registerOnMessagingStubClosedCallback(
+        std::function<void(std::shared_ptr<const joynr::system::RoutingTypes::Address>
+                                   destinationAddress)> onMessagingStubClosedCallback)
+{
+    this->onMessagingStubClosedCallback = std::move(onMessagingStubClosedCallback);
+}
+
+} // namespace joynr
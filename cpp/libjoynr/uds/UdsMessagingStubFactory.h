@@ -0,0 +1,65 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef UDSMESSAGINGSTUBFACTORY_H
+#define UDSMESSAGINGSTUBFACTORY_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "joynr/IMiddlewareMessagingStubFactory.h"
+#include "joynr/Logger.h"
+#include "joynr/UdsAddress.h"
+
+namespace joynr
+{
+
+class IWebSocketSendInterface;
+class IMessagingStub;
+
+/**
+ * @brief Creates the messaging stubs towards cluster controllers which are connected via a
+ * unix domain socket.
+ */
+class UdsMessagingStubFactory : public IMiddlewareMessagingStubFactory
+{
+public:
+    UdsMessagingStubFactory();
+    std::shared_ptr<IMessagingStub> create(
+            const joynr::system::RoutingTypes::Address& destAddress) override;
+    bool canCreate(const joynr::system::RoutingTypes::Address& destAddress) override;
+    void addServer(const UdsAddress& serverAddress,
+                   std::shared_ptr<IWebSocketSendInterface> udsSender);
+    void onMessagingStubClosed(const UdsAddress& address);
+    void registerOnMessagingStubClosedCallback(std::function<
+            void(std::shared_ptr<const joynr::system::RoutingTypes::Address> destinationAddress)>
+                                                       onMessagingStubClosedCallback) override;
+
+private:
+    std::unordered_map<std::string, std::shared_ptr<IMessagingStub>> serverStubMap;
+    std::mutex serverStubMapMutex;
+    std::function<void(std::shared_ptr<const joynr::system::RoutingTypes::Address>
+                               destinationAddress)> onMessagingStubClosedCallback;
+
+    ADD_LOGGER(UdsMessagingStubFactory)
+};
+
+} // namespace joynr
+#endif // UDSMESSAGINGSTUBFACTORY_H
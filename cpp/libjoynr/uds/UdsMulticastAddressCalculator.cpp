@@ -0,0 +1,39 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/uds/UdsMulticastAddressCalculator.h"
+
+#include <tuple>
+
+#include "joynr/UdsAddress.h"
+
+namespace joynr
+{
+UdsMulticastAddressCalculator::UdsMulticastAddressCalculator(
+        std::shared_ptr<const UdsAddress> clusterControllerAddress)
+        : clusterControllerAddress(std::move(clusterControllerAddress))
+{
+}
+
+std::shared_ptr<const system::RoutingTypes::Address> UdsMulticastAddressCalculator::compute(
+        const ImmutableMessage& message)
+{
+    std::ignore = message;
+    return clusterControllerAddress;
+}
+} // namespace joynr
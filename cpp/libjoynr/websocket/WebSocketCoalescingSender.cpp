@@ -0,0 +1,225 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/websocket/WebSocketCoalescingSender.h"
+
+#include <stdexcept>
+
+#include <boost/asio/error.hpp>
+
+#include "joynr/Util.h"
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+const std::string& WebSocketCoalescingSender::OFFER_MESSAGE_PREFIX()
+{
+    static const std::string value("joynr.CoalescingOffer:");
+    return value;
+}
+
+const std::string& WebSocketCoalescingSender::ACCEPT_MESSAGE()
+{
+    static const std::string value("joynr.CoalescingAccept");
+    return value;
+}
+
+std::string WebSocketCoalescingSender::createOfferMessage(std::uint32_t maxBytes,
+                                                          std::chrono::microseconds maxDelay)
+{
+    return OFFER_MESSAGE_PREFIX() + std::to_string(maxBytes) + ":" +
+           std::to_string(maxDelay.count());
+}
+
+bool WebSocketCoalescingSender::parseOfferMessage(const std::string& message,
+                                                  std::uint32_t& maxBytes,
+                                                  std::chrono::microseconds& maxDelay)
+{
+    if (message.compare(0, OFFER_MESSAGE_PREFIX().size(), OFFER_MESSAGE_PREFIX()) != 0) {
+        return false;
+    }
+    const std::string parameters = message.substr(OFFER_MESSAGE_PREFIX().size());
+    const std::size_t separator = parameters.find(':');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    try {
+        std::size_t parsed = 0;
+        const unsigned long long bytes = std::stoull(parameters.substr(0, separator), &parsed);
+        if (parsed != separator || bytes == 0 || bytes > UINT32_MAX) {
+            return false;
+        }
+        const std::string delay = parameters.substr(separator + 1);
+        const long long delayUs = std::stoll(delay, &parsed);
+        if (parsed != delay.size() || delayUs < 0) {
+            return false;
+        }
+        maxBytes = static_cast<std::uint32_t>(bytes);
+        maxDelay = std::chrono::microseconds(delayUs);
+    } catch (const std::logic_error&) {
+        // std::invalid_argument or std::out_of_range
+        return false;
+    }
+    return true;
+}
+
+WebSocketCoalescingSender::WebSocketCoalescingSender(
+        boost::asio::io_service& ioService,
+        std::shared_ptr<IWebSocketSendInterface> sender,
+        std::uint32_t maxBytes,
+        std::chrono::microseconds maxDelay,
+        bool enabled)
+        : sender(std::move(sender)),
+          maxBytes(maxBytes),
+          maxDelay(maxDelay),
+          pendingMutex(),
+          flushTimer(ioService),
+          pendingBatch(),
+          pendingOnFailures(),
+          enabled(enabled)
+{
+}
+
+WebSocketCoalescingSender::~WebSocketCoalescingSender()
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        sendPending(failures);
+    }
+    notifyFailures(failures);
+}
+
+void WebSocketCoalescingSender::setEnabled(bool enabled)
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (!enabled) {
+            sendPending(failures);
+        }
+        this->enabled = enabled;
+    }
+    notifyFailures(failures);
+}
+
+void WebSocketCoalescingSender::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        if (!enabled) {
+            // messages sent before coalescing was disabled have been sent already
+            sender->send(message, onFailure);
+            return;
+        }
+        const std::size_t sizeWithMessage =
+                pendingBatch.getSize() + MessageBatch::FRAME_OVERHEAD + message.size();
+        // send what is pending first so that the messages stay in order
+        if (pendingBatch.getNumberOfMessages() > 0 && sizeWithMessage > maxBytes) {
+            sendPending(failures);
+        }
+        const bool isFirstMessage = pendingBatch.getNumberOfMessages() == 0;
+        pendingBatch.append(message);
+        pendingOnFailures.push_back(onFailure);
+        if (pendingBatch.getSize() >= maxBytes) {
+            sendPending(failures);
+        } else if (isFirstMessage) {
+            flushTimer.expires_from_now(maxDelay);
+            flushTimer.async_wait(
+                    [thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+                            const boost::system::error_code& error) {
+                        if (error == boost::asio::error::operation_aborted) {
+                            return;
+                        }
+                        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                            thisSharedPtr->onFlushTimerExpired();
+                        }
+                    });
+        }
+    }
+    notifyFailures(failures);
+}
+
+bool WebSocketCoalescingSender::isInitialized() const
+{
+    return sender->isInitialized();
+}
+
+bool WebSocketCoalescingSender::isConnected() const
+{
+    return sender->isConnected();
+}
+
+void WebSocketCoalescingSender::sendPending(std::vector<Failure>& failures)
+{
+    const std::size_t numberOfMessages = pendingBatch.getNumberOfMessages();
+    if (numberOfMessages == 0) {
+        return;
+    }
+    boost::system::error_code ignored;
+    flushTimer.cancel(ignored);
+
+    const smrf::ByteVector& payload = pendingBatch.getPayload();
+    std::size_t offset = 0;
+    if (numberOfMessages == 1) {
+        // a single message is sent without the envelope
+        offset = MessageBatch::HEADER_SIZE + MessageBatch::FRAME_OVERHEAD;
+    } else {
+        JOYNR_LOG_TRACE(logger(), "sending frame of {} messages", numberOfMessages);
+    }
+
+    // failures are reported after the lock is released since the callbacks may send again
+    std::shared_ptr<exceptions::JoynrRuntimeException> exception;
+    sender->send(smrf::ByteArrayView(payload.data() + offset, payload.size() - offset),
+                 [&exception](const exceptions::JoynrRuntimeException& error) {
+                     exception.reset(error.clone());
+                 });
+    if (exception) {
+        failures.push_back(Failure{std::move(pendingOnFailures), std::move(exception)});
+    }
+    pendingBatch = MessageBatch();
+    pendingOnFailures.clear();
+}
+
+void WebSocketCoalescingSender::onFlushTimerExpired()
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        // a frame which has already been sent because of its size leaves nothing pending
+        sendPending(failures);
+    }
+    notifyFailures(failures);
+}
+
+void WebSocketCoalescingSender::notifyFailures(const std::vector<Failure>& failures)
+{
+    for (const Failure& failure : failures) {
+        for (const OnFailure& onFailure : failure.onFailures) {
+            if (onFailure) {
+                onFailure(*failure.exception);
+            }
+        }
+    }
+}
+
+} // namespace joynr
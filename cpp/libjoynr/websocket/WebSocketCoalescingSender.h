@@ -0,0 +1,135 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef WEBSOCKETCOALESCINGSENDER_H
+#define WEBSOCKETCOALESCINGSENDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Sender which packs messages that are sent in short succession over the same WebSocket
+ * connection into one frame, see MessageBatch.
+ *
+ * The pending frame is sent as soon as the next message would make it exceed maxBytes, or at
+ * the latest maxDelay after its first message was queued. A frame which holds only a single
+ * message is sent as plain message. Coalescing has to be negotiated with the peer: the libjoynr
+ * runtime sends an offer right before its initialization message and enables coalescing once
+ * the cluster controller has answered with the accept message. While disabled, messages are
+ * passed on to the wrapped sender immediately.
+ */
+class JOYNR_EXPORT WebSocketCoalescingSender
+        : public IWebSocketSendInterface,
+          public std::enable_shared_from_this<WebSocketCoalescingSender>
+{
+public:
+    /**
+     * @brief Prefix of the offer sent to the cluster controller, followed by the maximum frame
+     * size in bytes and the maximum delay in microseconds, separated by ':'.
+     */
+    static const std::string& OFFER_MESSAGE_PREFIX();
+
+    /**
+     * @brief Answer of a cluster controller which coalesces the messages it sends to the client.
+     */
+    static const std::string& ACCEPT_MESSAGE();
+
+    static std::string createOfferMessage(std::uint32_t maxBytes,
+                                          std::chrono::microseconds maxDelay);
+
+    /**
+     * @return false if the message is not a valid offer
+     */
+    static bool parseOfferMessage(const std::string& message,
+                                  std::uint32_t& maxBytes,
+                                  std::chrono::microseconds& maxDelay);
+
+    WebSocketCoalescingSender(boost::asio::io_service& ioService,
+                              std::shared_ptr<IWebSocketSendInterface> sender,
+                              std::uint32_t maxBytes,
+                              std::chrono::microseconds maxDelay,
+                              bool enabled);
+
+    ~WebSocketCoalescingSender() override;
+
+    /**
+     * @brief Enables or disables coalescing. Messages which are pending when coalescing is
+     * disabled are sent right away.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @param onFailure called for the message if sending its frame fails; it is never called
+     * from within send for another message
+     */
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(WebSocketCoalescingSender);
+
+    using OnFailure = std::function<void(const exceptions::JoynrRuntimeException&)>;
+
+    struct Failure
+    {
+        std::vector<OnFailure> onFailures;
+        std::shared_ptr<exceptions::JoynrRuntimeException> exception;
+    };
+
+    void sendPending(std::vector<Failure>& failures);
+    void onFlushTimerExpired();
+    static void notifyFailures(const std::vector<Failure>& failures);
+
+    std::shared_ptr<IWebSocketSendInterface> sender;
+    const std::uint32_t maxBytes;
+    const std::chrono::microseconds maxDelay;
+
+    std::mutex pendingMutex;
+    boost::asio::steady_timer flushTimer;
+    MessageBatch pendingBatch;
+    std::vector<OnFailure> pendingOnFailures;
+    bool enabled;
+
+    ADD_LOGGER(WebSocketCoalescingSender)
+};
+
+} // namespace joynr
+#endif // WEBSOCKETCOALESCINGSENDER_H
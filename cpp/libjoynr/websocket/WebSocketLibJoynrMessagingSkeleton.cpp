@@ -18,12 +18,16 @@
  */
 #include "WebSocketLibJoynrMessagingSkeleton.h"
 
+#include <stdexcept>
+#include <vector>
+
 #include <smrf/ByteVector.h>
 #include <smrf/exceptions.h>
 
 #include "joynr/IMessageRouter.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
+#include "joynr/MessageBatch.h"
 #include "joynr/exceptions/JoynrException.h"
 #include "joynr/serializer/Serializer.h"
 
@@ -50,6 +54,26 @@ void WebSocketLibJoynrMessagingSkeleton::transmit(
 }
 
 void WebSocketLibJoynrMessagingSkeleton::onMessageReceived(smrf::ByteVector&& message)
+{
+    if (!MessageBatch::isBatch(message)) {
+        onSingleMessageReceived(std::move(message));
+        return;
+    }
+
+    std::vector<smrf::ByteVector> messages;
+    try {
+        messages = MessageBatch::split(message);
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_ERROR(logger(), "Unable to unpack message batch - error: {}", e.what());
+        return;
+    }
+    JOYNR_LOG_TRACE(logger(), "received batch of {} messages", messages.size());
+    for (smrf::ByteVector& singleMessage : messages) {
+        onSingleMessageReceived(std::move(singleMessage));
+    }
+}
+
+void WebSocketLibJoynrMessagingSkeleton::onSingleMessageReceived(smrf::ByteVector&& message)
 {
     // deserialize message and transmit
     std::shared_ptr<ImmutableMessage> immutableMessage;
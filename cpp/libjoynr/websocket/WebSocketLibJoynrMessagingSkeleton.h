@@ -49,12 +49,17 @@ public:
     void transmit(std::shared_ptr<ImmutableMessage> message,
                   const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
 
+    /**
+     * @brief Handles a single serialized message or a batch of messages, see MessageBatch
+     */
     void onMessageReceived(smrf::ByteVector&& message);
 
 private:
     DISALLOW_COPY_AND_ASSIGN(WebSocketLibJoynrMessagingSkeleton);
     ADD_LOGGER(WebSocketLibJoynrMessagingSkeleton)
 
+    void onSingleMessageReceived(smrf::ByteVector&& message);
+
     std::weak_ptr<IMessageRouter> messageRouter;
 };
 
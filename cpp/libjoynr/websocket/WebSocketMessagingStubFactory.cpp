@@ -82,14 +82,13 @@ void WebSocketMessagingStubFactory::addClient(
         const system::RoutingTypes::WebSocketClientAddress& clientAddress,
         std::shared_ptr<IWebSocketSendInterface> webSocket)
 {
+    // clients of different connections may be added concurrently by the io threads of the
+    // WebSocket server
+    std::lock_guard<std::mutex> lock(clientStubMapMutex);
     if (clientStubMap.count(clientAddress) == 0) {
         auto wsClientStub = std::make_shared<WebSocketMessagingStub>(std::move(webSocket));
-        {
-            std::lock_guard<std::mutex> lock(clientStubMapMutex);
-            JOYNR_LOG_INFO(
-                    logger(), "adding messaging stub for address: {}", clientAddress.toString());
-            clientStubMap[clientAddress] = std::move(wsClientStub);
-        }
+        JOYNR_LOG_INFO(logger(), "adding messaging stub for address: {}", clientAddress.toString());
+        clientStubMap[clientAddress] = std::move(wsClientStub);
     } else {
         JOYNR_LOG_ERROR(logger(),
                         "Client with address {} already exists in the clientStubMap",
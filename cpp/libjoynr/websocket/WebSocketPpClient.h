@@ -40,6 +40,7 @@
 #include "joynr/system/RoutingTypes/WebSocketProtocol.h"
 #include "libjoynr/websocket/WebSocketPpReceiver.h"
 #include "libjoynr/websocket/WebSocketPpSender.h"
+#include "libjoynr/websocket/WebSocketReconnectBackoff.h"
 
 namespace joynr
 {
@@ -61,7 +62,8 @@ public:
               state(State::Disconnected),
               performingInitialConnect(true),
               address(),
-              reconnectSleepTimeMs(wsSettings.getReconnectSleepTimeMs()),
+              reconnectBackoff(wsSettings.getReconnectSleepTimeMs(),
+                               wsSettings.getReconnectMaxSleepTimeMs()),
               sender(nullptr),
               receiver(),
               isShuttingDown(false),
@@ -248,6 +250,8 @@ private:
 
     void delayedReconnect()
     {
+        const std::chrono::milliseconds reconnectSleepTimeMs = reconnectBackoff.nextSleepTime();
+        JOYNR_LOG_DEBUG(logger(), "reconnecting in {} ms", reconnectSleepTimeMs.count());
         boost::system::error_code reconnectTimerError;
         reconnectTimer.expires_from_now(reconnectSleepTimeMs, reconnectTimerError);
         if (reconnectTimerError) {
@@ -279,6 +283,7 @@ private:
         connection = hdl;
         sender->setConnectionHandle(connection);
         state = State::Connected;
+        reconnectBackoff.reset();
         JOYNR_LOG_INFO(logger(), "connection established");
 
         if (performingInitialConnect) {
@@ -337,7 +342,7 @@ private:
 
     // store address for reconnect
     system::RoutingTypes::WebSocketAddress address;
-    std::chrono::milliseconds reconnectSleepTimeMs;
+    WebSocketReconnectBackoff reconnectBackoff;
 
     std::function<void()> onConnectionOpenedCallback;
     std::function<void()> onConnectionClosedCallback;
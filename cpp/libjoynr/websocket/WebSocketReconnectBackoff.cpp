@@ -0,0 +1,57 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/websocket/WebSocketReconnectBackoff.h"
+
+#include <algorithm>
+
+namespace joynr
+{
+
+WebSocketReconnectBackoff::WebSocketReconnectBackoff(std::chrono::milliseconds minSleepTime,
+                                                     std::chrono::milliseconds maxSleepTime)
+        : minSleepTime(minSleepTime),
+          maxSleepTime(std::max(minSleepTime, maxSleepTime)),
+          attempts(0),
+          jitterEngine(std::random_device{}())
+{
+}
+
+std::chrono::milliseconds WebSocketReconnectBackoff::nextSleepTime()
+{
+    if (maxSleepTime <= minSleepTime || minSleepTime.count() <= 0) {
+        return minSleepTime;
+    }
+    std::chrono::milliseconds upperBound = minSleepTime;
+    for (std::uint32_t i = 0; i < attempts && upperBound < maxSleepTime; ++i) {
+        upperBound *= 2;
+    }
+    upperBound = std::min(upperBound, maxSleepTime);
+    if (upperBound < maxSleepTime) {
+        ++attempts;
+    }
+    std::uniform_int_distribution<std::int64_t> jitter(0, upperBound.count() / 2);
+    return upperBound - std::chrono::milliseconds(jitter(jitterEngine));
+}
+
+void WebSocketReconnectBackoff::reset()
+{
+    attempts = 0;
+}
+
+} // namespace joynr
@@ -0,0 +1,63 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef WEBSOCKETRECONNECTBACKOFF_H
+#define WEBSOCKETRECONNECTBACKOFF_H
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+#include "joynr/JoynrExport.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Computes the sleep time before the next attempt to reconnect to the cluster controller.
+ *
+ * The upper bound doubles with every failed attempt, starting at minSleepTime and limited by
+ * maxSleepTime. The sleep time is chosen randomly between half of the upper bound and the upper
+ * bound, so that clients which lost their connection at the same time, e.g. because the cluster
+ * controller was restarted, do not reconnect in lockstep. If maxSleepTime is not greater than
+ * minSleepTime or minSleepTime is zero, minSleepTime is always returned.
+ *
+ * Not thread safe; used from the io thread of the WebSocket or unix domain socket client only.
+ */
+class JOYNR_EXPORT WebSocketReconnectBackoff
+{
+public:
+    WebSocketReconnectBackoff(std::chrono::milliseconds minSleepTime,
+                              std::chrono::milliseconds maxSleepTime);
+
+    std::chrono::milliseconds nextSleepTime();
+
+    /**
+     * @brief Starts again with minSleepTime, to be called once a connection has been established.
+     */
+    void reset();
+
+private:
+    const std::chrono::milliseconds minSleepTime;
+    const std::chrono::milliseconds maxSleepTime;
+    std::uint32_t attempts;
+    std::mt19937 jitterEngine;
+};
+
+} // namespace joynr
+#endif // WEBSOCKETRECONNECTBACKOFF_H
@@ -0,0 +1,138 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/websocket/WebSocketSendQueue.h"
+
+#include <smrf/MessageDeserializer.h>
+#include <smrf/exceptions.h>
+
+#include "joynr/TimePoint.h"
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+WebSocketSendQueue::WebSocketSendQueue(std::shared_ptr<IWebSocketSendInterface> sender,
+                                       std::size_t maxQueuedMessages)
+        : sender(std::move(sender)),
+          maxQueuedMessages(maxQueuedMessages),
+          queueMutex(),
+          queuedMessages(),
+          isPassingThrough(false)
+{
+}
+
+WebSocketSendQueue::~WebSocketSendQueue()
+{
+    if (!queuedMessages.empty()) {
+        JOYNR_LOG_DEBUG(logger(), "discarding {} queued messages", queuedMessages.size());
+    }
+}
+
+void WebSocketSendQueue::send(
+        const smrf::ByteArrayView& message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    bool isQueueFull = true;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!isPassingThrough || !sender->isInitialized()) {
+            // queue until the next flush so that no message is overtaken by a later one
+            isPassingThrough = false;
+            if (queuedMessages.size() < maxQueuedMessages) {
+                queuedMessages.push_back(QueuedMessage{
+                        smrf::ByteVector(message.data(), message.data() + message.size()),
+                        onFailure});
+                return;
+            }
+        } else {
+            isQueueFull = false;
+        }
+    }
+    // the sender and onFailure are called without the lock since a failing send may be
+    // rescheduled and sent again synchronously
+    if (isQueueFull) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "WebSocket send queue is full. Unable to send message"));
+    } else {
+        sender->send(message, onFailure);
+    }
+}
+
+void WebSocketSendQueue::suspend()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    isPassingThrough = false;
+}
+
+void WebSocketSendQueue::flush()
+{
+    while (true) {
+        std::deque<QueuedMessage> messages;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (queuedMessages.empty()) {
+                isPassingThrough = true;
+                return;
+            }
+            messages.swap(queuedMessages);
+        }
+        // messages sent meanwhile are queued and sent in the next iteration
+        JOYNR_LOG_DEBUG(logger(), "sending {} queued messages", messages.size());
+        for (const QueuedMessage& queuedMessage : messages) {
+            if (isExpired(queuedMessage.message)) {
+                JOYNR_LOG_DEBUG(logger(), "dropping expired queued message");
+                continue;
+            }
+            // a failure reschedules the message in the message router
+            sender->send(smrf::ByteArrayView(queuedMessage.message), queuedMessage.onFailure);
+        }
+    }
+}
+
+bool WebSocketSendQueue::isExpired(const smrf::ByteVector& message)
+{
+    try {
+        const smrf::MessageDeserializer deserializer(smrf::ByteArrayView(message), false);
+        return deserializer.isTtlAbsolute() &&
+               TimePoint::fromAbsoluteMs(deserializer.getTtlMs()) < TimePoint::now();
+    } catch (const smrf::EncodingException& e) {
+        // not a joynr message, it is sent anyway
+        JOYNR_LOG_TRACE(logger(), "unable to read expiry date of queued message: {}", e.what());
+        return false;
+    }
+}
+
+bool WebSocketSendQueue::isInitialized() const
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queuedMessages.size() < maxQueuedMessages || sender->isInitialized();
+}
+
+bool WebSocketSendQueue::isConnected() const
+{
+    return sender->isConnected();
+}
+
+std::size_t WebSocketSendQueue::getNumberOfQueuedMessages() const
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queuedMessages.size();
+}
+
+} // namespace joynr
@@ -0,0 +1,109 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef WEBSOCKETSENDQUEUE_H
+#define WEBSOCKETSENDQUEUE_H
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Holds the messages a libjoynr runtime sends while its connection to the cluster
+ * controller is not established and sends them in order as soon as it is.
+ *
+ * Messages are queued until flush() is called, i.e. after the initialization message has been
+ * sent over a new connection, and again after suspend() or once the wrapped sender reports that
+ * it is not initialized any more. Without a queue every message sent in the meantime would fail
+ * and be rescheduled by the message router on its own timer. If maxQueuedMessages messages are
+ * queued already, further messages fail with a JoynrDelayMessageException as before.
+ *
+ * A queued message keeps its onFailure callback, so a message which fails during flush() is
+ * rescheduled by the message router; messages which expired while queued are dropped.
+ */
+class JOYNR_EXPORT WebSocketSendQueue : public IWebSocketSendInterface
+{
+public:
+    WebSocketSendQueue(std::shared_ptr<IWebSocketSendInterface> sender,
+                       std::size_t maxQueuedMessages);
+
+    ~WebSocketSendQueue() override;
+
+    void send(const smrf::ByteArrayView& message,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override;
+
+    /**
+     * @brief Sends all queued messages in order. Messages sent afterwards are passed on to the
+     * wrapped sender directly until it is not initialized any more.
+     */
+    void flush();
+
+    /**
+     * @brief Queues all messages sent from now on until the next flush(), e.g. because the
+     * connection has been closed.
+     */
+    void suspend();
+
+    /**
+     * @return true if messages are either passed on or queued
+     */
+    bool isInitialized() const override;
+
+    bool isConnected() const override;
+
+    std::size_t getNumberOfQueuedMessages() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(WebSocketSendQueue);
+
+    using OnFailure = std::function<void(const exceptions::JoynrRuntimeException&)>;
+
+    static bool isExpired(const smrf::ByteVector& message);
+
+    struct QueuedMessage
+    {
+        smrf::ByteVector message;
+        OnFailure onFailure;
+    };
+
+    std::shared_ptr<IWebSocketSendInterface> sender;
+    const std::size_t maxQueuedMessages;
+
+    mutable std::mutex queueMutex;
+    std::deque<QueuedMessage> queuedMessages;
+    bool isPassingThrough;
+
+    ADD_LOGGER(WebSocketSendQueue)
+};
+
+} // namespace joynr
+#endif // WEBSOCKETSENDQUEUE_H
@@ -36,7 +36,14 @@ WebSocketSettings::WebSocketSettings(Settings& settings) : settings(settings)
 void WebSocketSettings::checkSettings() const
 {
     assert(settings.contains(SETTING_CC_MESSAGING_URL()));
+    assert(settings.contains(SETTING_CC_MESSAGING_UDS_PATH()));
     assert(settings.contains(SETTING_RECONNECT_SLEEP_TIME_MS()));
+    assert(settings.contains(SETTING_RECONNECT_MAX_SLEEP_TIME_MS()));
+    assert(settings.contains(SETTING_SEND_QUEUE_SIZE()));
+    assert(settings.contains(SETTING_SHARED_MEMORY_RING_SIZE()));
+    assert(settings.contains(SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS()));
+    assert(settings.contains(SETTING_COALESCING_MAX_BYTES()));
+    assert(settings.contains(SETTING_COALESCING_MAX_DELAY_US()));
 }
 
 const std::string& WebSocketSettings::SETTING_CC_MESSAGING_URL()
@@ -45,12 +52,54 @@ const std::string& WebSocketSettings::SETTING_CC_MESSAGING_URL()
     return value;
 }
 
+const std::string& WebSocketSettings::SETTING_CC_MESSAGING_UDS_PATH()
+{
+    static const std::string value("websocket/cluster-controller-messaging-uds-path");
+    return value;
+}
+
 const std::string& WebSocketSettings::SETTING_RECONNECT_SLEEP_TIME_MS()
 {
     static const std::string value("websocket/reconnect-sleep-time-ms");
     return value;
 }
 
+const std::string& WebSocketSettings::SETTING_RECONNECT_MAX_SLEEP_TIME_MS()
+{
+    static const std::string value("websocket/reconnect-max-sleep-time-ms");
+    return value;
+}
+
+const std::string& WebSocketSettings::SETTING_SEND_QUEUE_SIZE()
+{
+    static const std::string value("websocket/send-queue-size");
+    return value;
+}
+
+const std::string& WebSocketSettings::SETTING_SHARED_MEMORY_RING_SIZE()
+{
+    static const std::string value("websocket/shared-memory-ring-size");
+    return value;
+}
+
+const std::string& WebSocketSettings::SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS()
+{
+    static const std::string value("websocket/shared-memory-attach-timeout-ms");
+    return value;
+}
+
+const std::string& WebSocketSettings::SETTING_COALESCING_MAX_BYTES()
+{
+    static const std::string value("websocket/coalescing-max-bytes");
+    return value;
+}
+
+const std::string& WebSocketSettings::SETTING_COALESCING_MAX_DELAY_US()
+{
+    static const std::string value("websocket/coalescing-max-delay-us");
+    return value;
+}
+
 const std::string& WebSocketSettings::SETTING_CERTIFICATE_AUTHORITY_PEM_FILENAME()
 {
     static const std::string value("websocket/certificate-authority-pem-filename");
@@ -111,6 +160,16 @@ joynr::system::RoutingTypes::WebSocketAddress WebSocketSettings::
             protocol, url.getHost(), url.getPort(), url.getPath());
 }
 
+std::string WebSocketSettings::getClusterControllerMessagingUdsPath() const
+{
+    return settings.get<std::string>(WebSocketSettings::SETTING_CC_MESSAGING_UDS_PATH());
+}
+
+void WebSocketSettings::setClusterControllerMessagingUdsPath(const std::string& path)
+{
+    settings.set(WebSocketSettings::SETTING_CC_MESSAGING_UDS_PATH(), path);
+}
+
 bool WebSocketSettings::getEncryptedTlsUsage() const
 {
     return settings.get<bool>(WebSocketSettings::SETTING_TLS_ENCRYPTION());
@@ -134,6 +193,73 @@ void WebSocketSettings::setReconnectSleepTimeMs(
             WebSocketSettings::SETTING_RECONNECT_SLEEP_TIME_MS(), reconnectSleepTimeMs.count());
 }
 
+std::chrono::milliseconds WebSocketSettings::getReconnectMaxSleepTimeMs() const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::int64_t>(WebSocketSettings::SETTING_RECONNECT_MAX_SLEEP_TIME_MS()));
+}
+
+void WebSocketSettings::setReconnectMaxSleepTimeMs(
+        const std::chrono::milliseconds reconnectMaxSleepTimeMs)
+{
+    settings.set(WebSocketSettings::SETTING_RECONNECT_MAX_SLEEP_TIME_MS(),
+                 reconnectMaxSleepTimeMs.count());
+}
+
+std::uint32_t WebSocketSettings::getSendQueueSize() const
+{
+    return settings.get<std::uint32_t>(WebSocketSettings::SETTING_SEND_QUEUE_SIZE());
+}
+
+void WebSocketSettings::setSendQueueSize(std::uint32_t sendQueueSize)
+{
+    settings.set(WebSocketSettings::SETTING_SEND_QUEUE_SIZE(), sendQueueSize);
+}
+
+std::uint64_t WebSocketSettings::getSharedMemoryRingSize() const
+{
+    return settings.get<std::uint64_t>(WebSocketSettings::SETTING_SHARED_MEMORY_RING_SIZE());
+}
+
+void WebSocketSettings::setSharedMemoryRingSize(std::uint64_t ringSize)
+{
+    settings.set(WebSocketSettings::SETTING_SHARED_MEMORY_RING_SIZE(), ringSize);
+}
+
+std::chrono::milliseconds WebSocketSettings::getSharedMemoryAttachTimeoutMs() const
+{
+    return std::chrono::milliseconds(settings.get<std::int64_t>(
+            WebSocketSettings::SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS()));
+}
+
+void WebSocketSettings::setSharedMemoryAttachTimeoutMs(
+        const std::chrono::milliseconds attachTimeoutMs)
+{
+    settings.set(WebSocketSettings::SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS(),
+                 attachTimeoutMs.count());
+}
+
+std::uint32_t WebSocketSettings::getCoalescingMaxBytes() const
+{
+    return settings.get<std::uint32_t>(WebSocketSettings::SETTING_COALESCING_MAX_BYTES());
+}
+
+void WebSocketSettings::setCoalescingMaxBytes(std::uint32_t maxBytes)
+{
+    settings.set(WebSocketSettings::SETTING_COALESCING_MAX_BYTES(), maxBytes);
+}
+
+std::chrono::microseconds WebSocketSettings::getCoalescingMaxDelayUs() const
+{
+    return std::chrono::microseconds(
+            settings.get<std::int64_t>(WebSocketSettings::SETTING_COALESCING_MAX_DELAY_US()));
+}
+
+void WebSocketSettings::setCoalescingMaxDelayUs(const std::chrono::microseconds maxDelayUs)
+{
+    settings.set(WebSocketSettings::SETTING_COALESCING_MAX_DELAY_US(), maxDelayUs.count());
+}
+
 void WebSocketSettings::setCertificateAuthorityPemFilename(const std::string& filename)
 {
     settings.set(WebSocketSettings::SETTING_CERTIFICATE_AUTHORITY_PEM_FILENAME(), filename);
@@ -177,6 +303,41 @@ void WebSocketSettings::printSettings() const
                    SETTING_CC_MESSAGING_URL(),
                    settings.get<std::string>(SETTING_CC_MESSAGING_URL()));
 
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_CC_MESSAGING_UDS_PATH(),
+                   settings.get<std::string>(SETTING_CC_MESSAGING_UDS_PATH()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_RECONNECT_MAX_SLEEP_TIME_MS(),
+                   settings.get<std::string>(SETTING_RECONNECT_MAX_SLEEP_TIME_MS()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_SEND_QUEUE_SIZE(),
+                   settings.get<std::string>(SETTING_SEND_QUEUE_SIZE()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_SHARED_MEMORY_RING_SIZE(),
+                   settings.get<std::string>(SETTING_SHARED_MEMORY_RING_SIZE()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS(),
+                   settings.get<std::string>(SETTING_SHARED_MEMORY_ATTACH_TIMEOUT_MS()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_COALESCING_MAX_BYTES(),
+                   settings.get<std::string>(SETTING_COALESCING_MAX_BYTES()));
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_COALESCING_MAX_DELAY_US(),
+                   settings.get<std::string>(SETTING_COALESCING_MAX_DELAY_US()));
+
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {}",
                    SETTING_CERTIFICATE_AUTHORITY_PEM_FILENAME(),
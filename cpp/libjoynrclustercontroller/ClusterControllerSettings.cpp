@@ -84,6 +84,10 @@ void ClusterControllerSettings::checkSettings()
         setMessageQueueLimitBytes(DEFAULT_MESSAGE_QUEUE_LIMIT_BYTES());
     }
 
+    if (!settings.contains(SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES())) {
+        setPerClientMessageQuotaBytes(DEFAULT_PER_CLIENT_MESSAGE_QUOTA_BYTES());
+    }
+
     if (!settings.contains(SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES())) {
         setTransportNotAvailableQueueLimitBytes(
                 DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES());
@@ -105,11 +109,55 @@ void ClusterControllerSettings::checkSettings()
                 DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS());
     }
 
+    if (!settings.contains(SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE())) {
+        setPurgeExpiredDiscoveryEntriesBatchSize(
+                DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE());
+    }
+
+    if (!settings.contains(SETTING_WS_IO_THREADS())) {
+        setWsIoThreads(DEFAULT_WS_IO_THREADS());
+    }
+
+    if (!settings.contains(SETTING_WS_MESSAGE_PROCESSING_THREADS())) {
+        setWsMessageProcessingThreads(DEFAULT_WS_MESSAGE_PROCESSING_THREADS());
+    }
+
+    if (!settings.contains(SETTING_MQTT_INGRESS_QUEUE_SIZE())) {
+        setMqttIngressQueueSize(DEFAULT_MQTT_INGRESS_QUEUE_SIZE());
+    }
+
+    if (!settings.contains(SETTING_MQTT_INGRESS_WORKER_THREADS())) {
+        setMqttIngressWorkerThreads(DEFAULT_MQTT_INGRESS_WORKER_THREADS());
+    }
+
+    if (!settings.contains(SETTING_MQTT_INGRESS_OVERFLOW_POLICY())) {
+        setMqttIngressOverflowPolicy(DEFAULT_MQTT_INGRESS_OVERFLOW_POLICY());
+    }
+
+    if (!settings.contains(SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS())) {
+        setDiscoveryCacheMaxStalenessMs(
+                std::chrono::milliseconds(DEFAULT_DISCOVERY_CACHE_MAX_STALENESS_MS()));
+    }
+
+    if (!settings.contains(SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT())) {
+        setDiscoveryCacheRefreshAheadPercent(DEFAULT_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT());
+    }
+
     if (!settings.contains(SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS())) {
         settings.set(SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS(),
                      DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS().count());
     }
 
+    if (!settings.contains(SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT())) {
+        setCapabilitiesFreshnessUpdateJitterPercent(
+                DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT());
+    }
+
+    if (!settings.contains(SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS())) {
+        setGlobalCapabilitiesDirectoryBatchWindowMs(
+                DEFAULT_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS());
+    }
+
     if (!settings.contains(SETTING_MQTT_TLS_ENABLED())) {
         settings.set(SETTING_MQTT_TLS_ENABLED(), DEFAULT_MQTT_TLS_ENABLED());
     }
@@ -233,6 +281,68 @@ const std::string& ClusterControllerSettings::SETTING_WS_PORT()
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_UDS_PATH()
+{
+    static const std::string value("cluster-controller/uds-path");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::SETTING_WS_IO_THREADS()
+{
+    static const std::string value("cluster-controller/ws-io-threads");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_WS_IO_THREADS()
+{
+    return 2;
+}
+
+const std::string& ClusterControllerSettings::SETTING_WS_MESSAGE_PROCESSING_THREADS()
+{
+    static const std::string value("cluster-controller/ws-message-processing-threads");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_WS_MESSAGE_PROCESSING_THREADS()
+{
+    return 4;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MQTT_INGRESS_QUEUE_SIZE()
+{
+    static const std::string value("cluster-controller/mqtt-ingress-queue-size");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_MQTT_INGRESS_QUEUE_SIZE()
+{
+    return 10000;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MQTT_INGRESS_WORKER_THREADS()
+{
+    static const std::string value("cluster-controller/mqtt-ingress-worker-threads");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_MQTT_INGRESS_WORKER_THREADS()
+{
+    return 1;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MQTT_INGRESS_OVERFLOW_POLICY()
+{
+    static const std::string value("cluster-controller/mqtt-ingress-overflow-policy");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::DEFAULT_MQTT_INGRESS_OVERFLOW_POLICY()
+{
+    static const std::string value("BLOCK");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::SETTING_USE_ONLY_LDAS()
 {
     static const std::string value("access-control/use-ldas-only");
@@ -352,11 +462,71 @@ const std::string& ClusterControllerSettings::SETTING_CAPABILITIES_FRESHNESS_UPD
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT()
+{
+    static const std::string value(
+            "cluster-controller/capabilities-freshness-update-jitter-percent");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT()
+{
+    return 10;
+}
+
+const std::string& ClusterControllerSettings::
+        SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS()
+{
+    static const std::string value(
+            "cluster-controller/global-capabilities-directory-batch-window-ms");
+    return value;
+}
+
+std::chrono::milliseconds ClusterControllerSettings::
+        DEFAULT_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS()
+{
+    return std::chrono::milliseconds(0);
+}
+
 int ClusterControllerSettings::DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS()
 {
     return 60 * 60 * 1000; // 1 hour
 }
 
+const std::string& ClusterControllerSettings::SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE()
+{
+    static const std::string value(
+            "cluster-controller/purge-expired-discovery-entries-batch-size");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE()
+{
+    return 1000;
+}
+
+const std::string& ClusterControllerSettings::SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS()
+{
+    static const std::string value("cluster-controller/discovery-cache-max-staleness-ms");
+    return value;
+}
+
+std::int64_t ClusterControllerSettings::DEFAULT_DISCOVERY_CACHE_MAX_STALENESS_MS()
+{
+    return 0;
+}
+
+const std::string& ClusterControllerSettings::SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT()
+{
+    static const std::string value("cluster-controller/discovery-cache-refresh-ahead-percent");
+    return value;
+}
+
+std::uint32_t ClusterControllerSettings::DEFAULT_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT()
+{
+    return 0;
+}
+
 std::chrono::milliseconds ClusterControllerSettings::
         DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS()
 {
@@ -412,6 +582,11 @@ std::uint64_t ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_LIMIT_BYTES()
     return 0;
 }
 
+std::uint64_t ClusterControllerSettings::DEFAULT_PER_CLIENT_MESSAGE_QUOTA_BYTES()
+{
+    return 0;
+}
+
 std::uint64_t ClusterControllerSettings::DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES()
 {
     return 0;
@@ -508,6 +683,71 @@ void ClusterControllerSettings::setWsPort(std::uint16_t port)
     settings.set(SETTING_WS_PORT(), port);
 }
 
+bool ClusterControllerSettings::isUdsPathSet() const
+{
+    return settings.contains(SETTING_UDS_PATH()) && !getUdsPath().empty();
+}
+
+std::string ClusterControllerSettings::getUdsPath() const
+{
+    return settings.get<std::string>(SETTING_UDS_PATH());
+}
+
+void ClusterControllerSettings::setUdsPath(const std::string& path)
+{
+    settings.set(SETTING_UDS_PATH(), path);
+}
+
+std::uint32_t ClusterControllerSettings::getWsIoThreads() const
+{
+    return settings.get<std::uint32_t>(SETTING_WS_IO_THREADS());
+}
+
+void ClusterControllerSettings::setWsIoThreads(std::uint32_t numberOfThreads)
+{
+    settings.set(SETTING_WS_IO_THREADS(), numberOfThreads);
+}
+
+std::uint32_t ClusterControllerSettings::getWsMessageProcessingThreads() const
+{
+    return settings.get<std::uint32_t>(SETTING_WS_MESSAGE_PROCESSING_THREADS());
+}
+
+void ClusterControllerSettings::setWsMessageProcessingThreads(std::uint32_t numberOfThreads)
+{
+    settings.set(SETTING_WS_MESSAGE_PROCESSING_THREADS(), numberOfThreads);
+}
+
+std::uint32_t ClusterControllerSettings::getMqttIngressQueueSize() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_INGRESS_QUEUE_SIZE());
+}
+
+void ClusterControllerSettings::setMqttIngressQueueSize(std::uint32_t queueSize)
+{
+    settings.set(SETTING_MQTT_INGRESS_QUEUE_SIZE(), queueSize);
+}
+
+std::uint32_t ClusterControllerSettings::getMqttIngressWorkerThreads() const
+{
+    return settings.get<std::uint32_t>(SETTING_MQTT_INGRESS_WORKER_THREADS());
+}
+
+void ClusterControllerSettings::setMqttIngressWorkerThreads(std::uint32_t numberOfThreads)
+{
+    settings.set(SETTING_MQTT_INGRESS_WORKER_THREADS(), numberOfThreads);
+}
+
+std::string ClusterControllerSettings::getMqttIngressOverflowPolicy() const
+{
+    return settings.get<std::string>(SETTING_MQTT_INGRESS_OVERFLOW_POLICY());
+}
+
+void ClusterControllerSettings::setMqttIngressOverflowPolicy(const std::string& policy)
+{
+    settings.set(SETTING_MQTT_INGRESS_OVERFLOW_POLICY(), policy);
+}
+
 bool ClusterControllerSettings::isMqttClientIdPrefixSet() const
 {
     return settings.contains(SETTING_MQTT_CLIENT_ID_PREFIX());
@@ -525,6 +765,39 @@ void ClusterControllerSettings::setPurgeExpiredDiscoveryEntriesIntervalMs(
             SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS(), purgeExpiredEntriesIntervalMs);
 }
 
+std::uint32_t ClusterControllerSettings::getPurgeExpiredDiscoveryEntriesBatchSize() const
+{
+    return settings.get<std::uint32_t>(SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE());
+}
+
+void ClusterControllerSettings::setPurgeExpiredDiscoveryEntriesBatchSize(std::uint32_t batchSize)
+{
+    settings.set(SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE(), batchSize);
+}
+
+std::chrono::milliseconds ClusterControllerSettings::getDiscoveryCacheMaxStalenessMs() const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::int64_t>(SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS()));
+}
+
+void ClusterControllerSettings::setDiscoveryCacheMaxStalenessMs(
+        std::chrono::milliseconds maxStalenessMs)
+{
+    settings.set(SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS(), maxStalenessMs.count());
+}
+
+std::uint32_t ClusterControllerSettings::getDiscoveryCacheRefreshAheadPercent() const
+{
+    return settings.get<std::uint32_t>(SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT());
+}
+
+void ClusterControllerSettings::setDiscoveryCacheRefreshAheadPercent(
+        std::uint32_t refreshAheadPercent)
+{
+    settings.set(SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT(), refreshAheadPercent);
+}
+
 std::string ClusterControllerSettings::getMqttClientIdPrefix() const
 {
     return settings.get<std::string>(SETTING_MQTT_CLIENT_ID_PREFIX());
@@ -699,6 +972,12 @@ const std::string& ClusterControllerSettings::SETTING_MESSAGE_QUEUE_LIMIT_BYTES(
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES()
+{
+    static const std::string value("cluster-controller/per-client-message-quota-bytes");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES()
 {
     static const std::string value("cluster-controller/transport-not-available-queue-limit-bytes");
@@ -777,6 +1056,16 @@ void ClusterControllerSettings::setMessageQueueLimitBytes(std::uint64_t limitByt
     settings.set(SETTING_MESSAGE_QUEUE_LIMIT_BYTES(), limitBytes);
 }
 
+std::uint64_t ClusterControllerSettings::getPerClientMessageQuotaBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES());
+}
+
+void ClusterControllerSettings::setPerClientMessageQuotaBytes(std::uint64_t quotaBytes)
+{
+    settings.set(SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES(), quotaBytes);
+}
+
 std::uint64_t ClusterControllerSettings::getTransportNotAvailableQueueLimitBytes() const
 {
     return settings.get<std::uint64_t>(SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES());
@@ -874,6 +1163,30 @@ void ClusterControllerSettings::setCapabilitiesFreshnessUpdateIntervalMs(
                         capabilitiesFreshnessUpdateIntervalMs.count());
 }
 
+std::uint32_t ClusterControllerSettings::getCapabilitiesFreshnessUpdateJitterPercent() const
+{
+    return settings.get<std::uint32_t>(SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT());
+}
+
+void ClusterControllerSettings::setCapabilitiesFreshnessUpdateJitterPercent(
+        std::uint32_t jitterPercent)
+{
+    settings.set(SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT(), jitterPercent);
+}
+
+std::chrono::milliseconds ClusterControllerSettings::getGlobalCapabilitiesDirectoryBatchWindowMs()
+        const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::uint64_t>(SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS()));
+}
+
+void ClusterControllerSettings::setGlobalCapabilitiesDirectoryBatchWindowMs(
+        std::chrono::milliseconds batchWindowMs)
+{
+    settings.set(SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS(), batchWindowMs.count());
+}
+
 void ClusterControllerSettings::printSettings() const
 {
     JOYNR_LOG_INFO(logger(),
@@ -902,6 +1215,10 @@ void ClusterControllerSettings::printSettings() const
                    "SETTING: {} = {}",
                    SETTING_MESSAGE_QUEUE_LIMIT_BYTES(),
                    getMessageQueueLimitBytes());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES(),
+                   getPerClientMessageQuotaBytes());
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {}",
                    SETTING_PER_PARTICIPANTID_MESSAGE_QUEUE_LIMIT(),
@@ -940,6 +1257,30 @@ void ClusterControllerSettings::printSettings() const
         JOYNR_LOG_INFO(logger(), "SETTING: {} = NOT SET", SETTING_WS_PORT());
     }
 
+    if (isUdsPathSet()) {
+        JOYNR_LOG_INFO(logger(), "SETTING: {} = {}", SETTING_UDS_PATH(), getUdsPath());
+    } else {
+        JOYNR_LOG_INFO(logger(), "SETTING: {} = NOT SET", SETTING_UDS_PATH());
+    }
+
+    JOYNR_LOG_INFO(logger(), "SETTING: {} = {}", SETTING_WS_IO_THREADS(), getWsIoThreads());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_WS_MESSAGE_PROCESSING_THREADS(),
+                   getWsMessageProcessingThreads());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MQTT_INGRESS_QUEUE_SIZE(),
+                   getMqttIngressQueueSize());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MQTT_INGRESS_WORKER_THREADS(),
+                   getMqttIngressWorkerThreads());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MQTT_INGRESS_OVERFLOW_POLICY(),
+                   getMqttIngressOverflowPolicy());
+
     JOYNR_LOG_INFO(logger(), "SETTING: {} = {}", SETTING_MQTT_TLS_ENABLED(), isMqttTlsEnabled());
 
     if (isMqttCertificateAuthorityPemFilenameSet()) {
@@ -1013,6 +1354,14 @@ void ClusterControllerSettings::printSettings() const
                    "SETTING: {} = {})",
                    SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS(),
                    getCapabilitiesFreshnessUpdateIntervalMs().count());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT(),
+                   getCapabilitiesFreshnessUpdateJitterPercent());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS(),
+                   getGlobalCapabilitiesDirectoryBatchWindowMs().count());
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {})",
                    SETTING_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED(),
@@ -1022,6 +1371,18 @@ void ClusterControllerSettings::printSettings() const
                    "SETTING: {} = {})",
                    SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS(),
                    getPurgeExpiredDiscoveryEntriesIntervalMs());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE(),
+                   getPurgeExpiredDiscoveryEntriesBatchSize());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS(),
+                   getDiscoveryCacheMaxStalenessMs().count());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT(),
+                   getDiscoveryCacheRefreshAheadPercent());
 
     if (settings.get<bool>(SETTING_ACCESS_CONTROL_ENABLE())) {
         JOYNR_LOG_INFO(logger(),
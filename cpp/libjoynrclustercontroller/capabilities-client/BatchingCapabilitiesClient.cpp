@@ -0,0 +1,250 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/capabilities-client/BatchingCapabilitiesClient.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "joynr/Util.h"
+
+namespace joynr
+{
+
+BatchingCapabilitiesClient::BatchingCapabilitiesClient(
+        std::shared_ptr<ICapabilitiesClient> capabilitiesClient,
+        boost::asio::io_service& ioService,
+        std::chrono::milliseconds batchWindow)
+        : capabilitiesClient(std::move(capabilitiesClient)),
+          batchWindow(batchWindow),
+          pendingLock(),
+          pendingAdds(),
+          pendingRemoves(),
+          isFlushScheduled(false),
+          batchWindowTimer(ioService)
+{
+}
+
+BatchingCapabilitiesClient::~BatchingCapabilitiesClient()
+{
+    batchWindowTimer.cancel();
+}
+
+void BatchingCapabilitiesClient::add(
+        const types::GlobalDiscoveryEntry& entry,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+{
+    addPending({entry}, std::move(onSuccess), std::move(onError));
+}
+
+void BatchingCapabilitiesClient::add(
+        const std::vector<joynr::types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError)
+{
+    addPending(globalDiscoveryEntries, std::move(onSuccess), std::move(onRuntimeError));
+}
+
+void BatchingCapabilitiesClient::remove(const std::string& participantId)
+{
+    removePending({participantId});
+}
+
+void BatchingCapabilitiesClient::remove(std::vector<std::string> participantIds)
+{
+    removePending(participantIds);
+}
+
+void BatchingCapabilitiesClient::lookup(
+        const std::vector<std::string>& domains,
+        const std::string& interfaceName,
+        std::int64_t messagingTtl,
+        std::function<void(const std::vector<types::GlobalDiscoveryEntry>& result)> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+{
+    capabilitiesClient->lookup(
+            domains, interfaceName, messagingTtl, std::move(onSuccess), std::move(onError));
+}
+
+void BatchingCapabilitiesClient::lookup(
+        const std::string& participantId,
+        std::function<void(const std::vector<joynr::types::GlobalDiscoveryEntry>& result)>
+                onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+{
+    capabilitiesClient->lookup(participantId, std::move(onSuccess), std::move(onError));
+}
+
+void BatchingCapabilitiesClient::touch(
+        const std::string& clusterControllerId,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError)
+{
+    flush();
+    capabilitiesClient->touch(clusterControllerId, std::move(onSuccess), std::move(onError));
+}
+
+void BatchingCapabilitiesClient::flush()
+{
+    std::vector<PendingAdd> adds;
+    std::vector<std::string> removes;
+    {
+        std::lock_guard<std::mutex> lock(pendingLock);
+        adds.swap(pendingAdds);
+        removes.swap(pendingRemoves);
+        isFlushScheduled = false;
+    }
+
+    // a participantId is never pending for add and remove at the same time,
+    // hence the order of both requests does not matter
+    if (!removes.empty()) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "Sending {} batched removes to the global capabilities directory",
+                        removes.size());
+        capabilitiesClient->remove(std::move(removes));
+    }
+    if (!adds.empty()) {
+        sendAdds(std::move(adds));
+    }
+}
+
+void BatchingCapabilitiesClient::shutdown()
+{
+    batchWindowTimer.cancel();
+    flush();
+}
+
+void BatchingCapabilitiesClient::addPending(
+        std::vector<types::GlobalDiscoveryEntry> entries,
+        std::function<void()> onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+{
+    std::lock_guard<std::mutex> lock(pendingLock);
+    for (const auto& entry : entries) {
+        util::removeAll(pendingRemoves, entry.getParticipantId());
+    }
+    pendingAdds.push_back({std::move(entries), std::move(onSuccess), std::move(onError)});
+    scheduleFlushLocked();
+}
+
+void BatchingCapabilitiesClient::removePending(const std::vector<std::string>& participantIds)
+{
+    std::lock_guard<std::mutex> lock(pendingLock);
+    for (const auto& participantId : participantIds) {
+        for (auto& pendingAdd : pendingAdds) {
+            auto& entries = pendingAdd.entries;
+            entries.erase(std::remove_if(entries.begin(),
+                                         entries.end(),
+                                         [&participantId](const types::GlobalDiscoveryEntry& e) {
+                                             return e.getParticipantId() == participantId;
+                                         }),
+                          entries.end());
+        }
+        if (std::find(pendingRemoves.cbegin(), pendingRemoves.cend(), participantId) ==
+            pendingRemoves.cend()) {
+            pendingRemoves.push_back(participantId);
+        }
+    }
+    scheduleFlushLocked();
+}
+
+void BatchingCapabilitiesClient::scheduleFlushLocked()
+{
+    if (isFlushScheduled) {
+        return;
+    }
+    isFlushScheduled = true;
+
+    boost::system::error_code timerError;
+    batchWindowTimer.expires_from_now(batchWindow, timerError);
+    if (timerError) {
+        JOYNR_LOG_ERROR(logger(),
+                        "Error from batch window timer: {}: {}",
+                        timerError.value(),
+                        timerError.message());
+    }
+    batchWindowTimer.async_wait([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+            const boost::system::error_code& timerError) {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->onBatchWindowExpired(timerError);
+        }
+    });
+}
+
+void BatchingCapabilitiesClient::onBatchWindowExpired(const boost::system::error_code& timerError)
+{
+    if (timerError == boost::asio::error::operation_aborted) {
+        // rescheduled after an explicit flush or shut down
+        return;
+    } else if (timerError) {
+        JOYNR_LOG_ERROR(
+                logger(), "Batch window timer expired with error: {}", timerError.message());
+    }
+    flush();
+}
+
+void BatchingCapabilitiesClient::sendAdds(std::vector<PendingAdd> adds)
+{
+    std::vector<types::GlobalDiscoveryEntry> entries;
+    for (auto& pendingAdd : adds) {
+        std::move(pendingAdd.entries.begin(),
+                  pendingAdd.entries.end(),
+                  std::back_inserter(entries));
+        pendingAdd.entries.clear();
+    }
+
+    if (entries.empty()) {
+        // all adds were superseded by removes
+        for (const auto& pendingAdd : adds) {
+            if (pendingAdd.onSuccess) {
+                pendingAdd.onSuccess();
+            }
+        }
+        return;
+    }
+
+    JOYNR_LOG_DEBUG(logger(),
+                    "Sending {} batched adds to the global capabilities directory",
+                    entries.size());
+    if (adds.size() == 1) {
+        capabilitiesClient->add(
+                entries, std::move(adds.front().onSuccess), std::move(adds.front().onError));
+        return;
+    }
+
+    auto batchedAdds = std::make_shared<std::vector<PendingAdd>>(std::move(adds));
+    auto onSuccess = [batchedAdds]() {
+        for (const auto& pendingAdd : *batchedAdds) {
+            if (pendingAdd.onSuccess) {
+                pendingAdd.onSuccess();
+            }
+        }
+    };
+    auto onError = [batchedAdds](const exceptions::JoynrRuntimeException& error) {
+        for (const auto& pendingAdd : *batchedAdds) {
+            if (pendingAdd.onError) {
+                pendingAdd.onError(error);
+            }
+        }
+    };
+    capabilitiesClient->add(entries, std::move(onSuccess), std::move(onError));
+}
+
+} // namespace joynr
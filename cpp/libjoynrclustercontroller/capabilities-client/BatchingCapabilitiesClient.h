@@ -0,0 +1,132 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef BATCHINGCAPABILITIESCLIENT_H
+#define BATCHINGCAPABILITIESCLIENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/types/GlobalDiscoveryEntry.h"
+#include "libjoynrclustercontroller/capabilities-client/ICapabilitiesClient.h"
+
+namespace joynr
+{
+
+/*
+ * Collects add and remove requests to the global capabilities directory for a batch window
+ * and forwards them as one add and one remove request. Pending requests are also forwarded
+ * right before a touch, so that all maintenance traffic of an interval is sent together.
+ *
+ * Within a window only the last request per participantId is forwarded: a remove drops a
+ * pending add of the same participant and vice versa. If a batched add fails, the error
+ * callbacks of all adds in the batch are called.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT BatchingCapabilitiesClient
+        : public ICapabilitiesClient,
+          public std::enable_shared_from_this<BatchingCapabilitiesClient>
+{
+public:
+    BatchingCapabilitiesClient(std::shared_ptr<ICapabilitiesClient> capabilitiesClient,
+                               boost::asio::io_service& ioService,
+                               std::chrono::milliseconds batchWindow);
+
+    ~BatchingCapabilitiesClient() override;
+
+    void add(const types::GlobalDiscoveryEntry& entry,
+             std::function<void()> onSuccess,
+             std::function<void(const exceptions::JoynrRuntimeException& error)> onError) override;
+
+    void add(const std::vector<joynr::types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
+             std::function<void()> onSuccess,
+             std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                     onRuntimeError) override;
+
+    void remove(const std::string& participantId) override;
+
+    void remove(std::vector<std::string> participantIds) override;
+
+    void lookup(const std::vector<std::string>& domains,
+                const std::string& interfaceName,
+                std::int64_t messagingTtl,
+                std::function<void(const std::vector<joynr::types::GlobalDiscoveryEntry>& result)>
+                        onSuccess,
+                std::function<void(const exceptions::JoynrRuntimeException& error)> onError =
+                        nullptr) override;
+
+    void lookup(const std::string& participantId,
+                std::function<void(const std::vector<joynr::types::GlobalDiscoveryEntry>& result)>
+                        onSuccess,
+                std::function<void(const exceptions::JoynrRuntimeException& error)> onError =
+                        nullptr) override;
+
+    void touch(const std::string& clusterControllerId,
+               std::function<void()> onSuccess = nullptr,
+               std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError =
+                       nullptr) override;
+
+    /*
+     * Forwards all pending add and remove requests immediately.
+     */
+    void flush();
+
+    void shutdown();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BatchingCapabilitiesClient);
+
+    struct PendingAdd
+    {
+        std::vector<types::GlobalDiscoveryEntry> entries;
+        std::function<void()> onSuccess;
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError;
+    };
+
+    void addPending(std::vector<types::GlobalDiscoveryEntry> entries,
+                    std::function<void()> onSuccess,
+                    std::function<void(const exceptions::JoynrRuntimeException& error)> onError);
+    void removePending(const std::vector<std::string>& participantIds);
+    void scheduleFlushLocked();
+    void onBatchWindowExpired(const boost::system::error_code& timerError);
+    void sendAdds(std::vector<PendingAdd> adds);
+
+    std::shared_ptr<ICapabilitiesClient> capabilitiesClient;
+    const std::chrono::milliseconds batchWindow;
+    std::mutex pendingLock;
+    std::vector<PendingAdd> pendingAdds;
+    std::vector<std::string> pendingRemoves;
+    bool isFlushScheduled;
+    boost::asio::steady_timer batchWindowTimer;
+
+    ADD_LOGGER(BatchingCapabilitiesClient)
+};
+
+} // namespace joynr
+#endif // BATCHINGCAPABILITIESCLIENT_H
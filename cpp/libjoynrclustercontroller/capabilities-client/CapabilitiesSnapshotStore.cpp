@@ -0,0 +1,589 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/CapabilitiesSnapshotStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "joynr/types/CustomParameter.h"
+#include "joynr/types/DiscoveryEntry.h"
+#include "joynr/types/ProviderQos.h"
+#include "joynr/types/ProviderScope.h"
+#include "joynr/types/Version.h"
+
+namespace joynr
+{
+
+namespace capabilities
+{
+
+namespace
+{
+
+const char SNAPSHOT_MAGIC[4] = {'J', 'C', 'S', 'S'};
+const char JOURNAL_MAGIC[4] = {'J', 'C', 'S', 'J'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+constexpr std::size_t FILE_HEADER_SIZE = sizeof(SNAPSHOT_MAGIC) + sizeof(std::uint32_t);
+constexpr std::size_t RECORD_HEADER_SIZE = 2 * sizeof(std::uint32_t);
+
+constexpr std::uint8_t RECORD_ADD = 1;
+constexpr std::uint8_t RECORD_REMOVE = 2;
+
+std::uint32_t checksum(const char* data, std::size_t size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+class Encoder
+{
+public:
+    template <typename T>
+    void write(T value)
+    {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write(const std::string& value)
+    {
+        write(static_cast<std::uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    void write(const types::DiscoveryEntry& entry)
+    {
+        write(entry.getProviderVersion().getMajorVersion());
+        write(entry.getProviderVersion().getMinorVersion());
+        write(entry.getDomain());
+        write(entry.getInterfaceName());
+        write(entry.getParticipantId());
+        const types::ProviderQos& qos = entry.getQos();
+        write(static_cast<std::uint32_t>(qos.getCustomParameters().size()));
+        for (const types::CustomParameter& parameter : qos.getCustomParameters()) {
+            write(parameter.getName());
+            write(parameter.getValue());
+        }
+        write(qos.getPriority());
+        write(static_cast<std::uint32_t>(qos.getScope()));
+        write(static_cast<std::uint8_t>(qos.getSupportsOnChangeSubscriptions()));
+        write(entry.getLastSeenDateMs());
+        write(entry.getExpiryDateMs());
+        write(entry.getPublicKeyId());
+    }
+
+    std::string& get()
+    {
+        return buffer;
+    }
+
+private:
+    std::string buffer;
+};
+
+class Decoder
+{
+public:
+    Decoder(const char* data, std::size_t size) : position(data), end(data + size)
+    {
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, consume(sizeof(value)), sizeof(value));
+        return value;
+    }
+
+    std::string readString()
+    {
+        const auto size = read<std::uint32_t>();
+        return std::string(consume(size), size);
+    }
+
+    types::DiscoveryEntry readDiscoveryEntry()
+    {
+        const auto majorVersion = read<std::int32_t>();
+        const auto minorVersion = read<std::int32_t>();
+        std::string domain = readString();
+        std::string interfaceName = readString();
+        std::string participantId = readString();
+        std::vector<types::CustomParameter> customParameters(read<std::uint32_t>());
+        for (types::CustomParameter& parameter : customParameters) {
+            std::string name = readString();
+            parameter = types::CustomParameter(std::move(name), readString());
+        }
+        const auto priority = read<std::int64_t>();
+        const auto scope = static_cast<types::ProviderScope::Enum>(read<std::uint32_t>());
+        const bool supportsOnChangeSubscriptions = read<std::uint8_t>() != 0;
+        const auto lastSeenDateMs = read<std::int64_t>();
+        const auto expiryDateMs = read<std::int64_t>();
+        return types::DiscoveryEntry(
+                types::Version(majorVersion, minorVersion),
+                std::move(domain),
+                std::move(interfaceName),
+                std::move(participantId),
+                types::ProviderQos(std::move(customParameters),
+                                   priority,
+                                   scope,
+                                   supportsOnChangeSubscriptions),
+                lastSeenDateMs,
+                expiryDateMs,
+                readString());
+    }
+
+    bool atEnd() const
+    {
+        return position == end;
+    }
+
+private:
+    const char* consume(std::size_t size)
+    {
+        if (static_cast<std::size_t>(end - position) < size) {
+            throw std::runtime_error("unexpected end of record");
+        }
+        const char* data = position;
+        position += size;
+        return data;
+    }
+
+    const char* position;
+    const char* end;
+};
+
+/**
+ * @brief Read only view of a whole file. Empty files cannot be mapped and are represented by an
+ * empty view.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& fileName) : region()
+    {
+        if (boost::filesystem::file_size(fileName) > 0) {
+            boost::interprocess::file_mapping mapping(
+                    fileName.c_str(), boost::interprocess::read_only);
+            region = boost::interprocess::mapped_region(mapping, boost::interprocess::read_only);
+        }
+    }
+
+    const char* data() const
+    {
+        return static_cast<const char*>(region.get_address());
+    }
+
+    std::size_t size() const
+    {
+        return region.get_size();
+    }
+
+private:
+    boost::interprocess::mapped_region region;
+};
+
+/**
+ * @brief Finds the next record in [position, end). Returns false if there is no complete record
+ * with a valid checksum.
+ */
+bool nextRecord(const char*& position,
+                const char* end,
+                const char*& payload,
+                std::uint32_t& payloadSize)
+{
+    if (static_cast<std::size_t>(end - position) < RECORD_HEADER_SIZE) {
+        return false;
+    }
+    std::uint32_t crc;
+    std::memcpy(&payloadSize, position, sizeof(payloadSize));
+    std::memcpy(&crc, position + sizeof(payloadSize), sizeof(crc));
+    if (static_cast<std::size_t>(end - position) - RECORD_HEADER_SIZE < payloadSize) {
+        return false;
+    }
+    payload = position + RECORD_HEADER_SIZE;
+    if (checksum(payload, payloadSize) != crc) {
+        return false;
+    }
+    position = payload + payloadSize;
+    return true;
+}
+
+/**
+ * @brief Flushes a file or directory to the disk, so a rename is not persisted before the
+ * content of the renamed file.
+ */
+void syncToDisk(const std::string& fileName)
+{
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot open " + fileName + " for syncing");
+    }
+    const int result = ::fsync(fd);
+    ::close(fd);
+    if (result != 0) {
+        throw std::runtime_error("cannot sync " + fileName);
+    }
+}
+
+bool hasValidHeader(const char* data, std::size_t size, const char (&magic)[4])
+{
+    if (size < FILE_HEADER_SIZE || std::memcmp(data, magic, sizeof(magic)) != 0) {
+        return false;
+    }
+    std::uint32_t version;
+    std::memcpy(&version, data + sizeof(magic), sizeof(version));
+    return version == FORMAT_VERSION;
+}
+
+void writeRecord(std::ostream& stream, const std::string& payload)
+{
+    const auto payloadSize = static_cast<std::uint32_t>(payload.size());
+    const std::uint32_t crc = checksum(payload.data(), payload.size());
+    stream.write(reinterpret_cast<const char*>(&payloadSize), sizeof(payloadSize));
+    stream.write(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    stream.write(payload.data(), payload.size());
+}
+
+/**
+ * @brief Entries in load order, keyed by participantId.
+ */
+class EntryList
+{
+public:
+    explicit EntryList(std::vector<types::DiscoveryEntry>& entries)
+            : entries(entries), positions(), removed(entries.size(), false)
+    {
+        positions.reserve(entries.size());
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            positions[entries[i].getParticipantId()] = i;
+        }
+    }
+
+    void add(types::DiscoveryEntry entry)
+    {
+        auto it = positions.find(entry.getParticipantId());
+        if (it == positions.end()) {
+            positions.emplace(entry.getParticipantId(), entries.size());
+            entries.push_back(std::move(entry));
+            removed.push_back(false);
+        } else {
+            entries[it->second] = std::move(entry);
+            removed[it->second] = false;
+        }
+    }
+
+    void remove(const std::string& participantId)
+    {
+        auto it = positions.find(participantId);
+        if (it != positions.end()) {
+            removed[it->second] = true;
+        }
+    }
+
+    /**
+     * @brief erases the removed entries from the underlying vector
+     */
+    void compact()
+    {
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (!removed[i]) {
+                if (kept != i) {
+                    entries[kept] = std::move(entries[i]);
+                }
+                ++kept;
+            }
+        }
+        entries.resize(kept);
+    }
+
+private:
+    std::vector<types::DiscoveryEntry>& entries;
+    std::unordered_map<std::string, std::size_t> positions;
+    std::vector<bool> removed;
+};
+
+} // namespace
+
+SnapshotStore::SnapshotStore(const std::string& fileName,
+                             std::size_t minJournalRecordsBeforeCompaction)
+        : snapshotFileName(fileName + ".snapshot"),
+          journalFileName(fileName + ".journal"),
+          minJournalRecordsBeforeCompaction(minJournalRecordsBeforeCompaction),
+          mutex(),
+          journal(),
+          journalRecords(0),
+          snapshotEntries(0)
+{
+}
+
+SnapshotStore::~SnapshotStore()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (journal.is_open()) {
+        journal.close();
+    }
+}
+
+bool SnapshotStore::load(std::vector<types::DiscoveryEntry>& entries)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    const bool hasSnapshot = boost::filesystem::exists(snapshotFileName);
+    const bool hasJournal = boost::filesystem::exists(journalFileName);
+    if (!hasSnapshot && !hasJournal) {
+        return false;
+    }
+
+    snapshotEntries = hasSnapshot ? loadSnapshot(entries) : 0;
+    if (journal.is_open()) {
+        journal.close();
+    }
+    journalRecords = hasJournal ? replayJournal(entries) : 0;
+    openJournal(false);
+    JOYNR_LOG_INFO(logger(),
+                   "Loaded {} discovery entries from {} snapshot entries and {} journal records",
+                   entries.size(),
+                   snapshotEntries,
+                   journalRecords);
+    return true;
+}
+
+std::size_t SnapshotStore::loadSnapshot(std::vector<types::DiscoveryEntry>& entries)
+{
+    try {
+        MappedFile file(snapshotFileName);
+        const char* position = file.data();
+        const char* end = position + file.size();
+        if (!hasValidHeader(position, file.size(), SNAPSHOT_MAGIC) ||
+            file.size() < FILE_HEADER_SIZE + sizeof(std::uint64_t)) {
+            throw std::runtime_error("invalid header");
+        }
+        position += FILE_HEADER_SIZE;
+        std::uint64_t count;
+        std::memcpy(&count, position, sizeof(count));
+        position += sizeof(count);
+
+        entries.reserve(std::min(count, static_cast<std::uint64_t>(file.size())));
+        const char* payload;
+        std::uint32_t payloadSize;
+        while (entries.size() < count && nextRecord(position, end, payload, payloadSize)) {
+            Decoder decoder(payload, payloadSize);
+            entries.push_back(decoder.readDiscoveryEntry());
+        }
+        if (entries.size() != count) {
+            throw std::runtime_error("snapshot is truncated or corrupt");
+        }
+        return entries.size();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("cannot load capabilities snapshot " + snapshotFileName + ": " +
+                                 e.what());
+    }
+}
+
+std::size_t SnapshotStore::replayJournal(std::vector<types::DiscoveryEntry>& entries)
+{
+    std::size_t validSize = 0;
+    std::size_t records = 0;
+    std::size_t fileSize = 0;
+    {
+        MappedFile file(journalFileName);
+        fileSize = file.size();
+        if (fileSize == 0) {
+            return 0;
+        }
+        if (!hasValidHeader(file.data(), file.size(), JOURNAL_MAGIC)) {
+            throw std::runtime_error("cannot load capabilities journal " + journalFileName +
+                                     ": invalid header");
+        }
+        EntryList entryList(entries);
+        const char* begin = file.data();
+        const char* position = begin + FILE_HEADER_SIZE;
+        const char* end = begin + file.size();
+        const char* payload;
+        std::uint32_t payloadSize;
+        validSize = FILE_HEADER_SIZE;
+        while (nextRecord(position, end, payload, payloadSize)) {
+            // a complete record with a valid checksum was written as it is, so a record which
+            // cannot be decoded is not a torn write and must not be dropped
+            try {
+                Decoder decoder(payload, payloadSize);
+                const auto type = decoder.read<std::uint8_t>();
+                if (type == RECORD_ADD) {
+                    entryList.add(decoder.readDiscoveryEntry());
+                } else if (type == RECORD_REMOVE) {
+                    entryList.remove(decoder.readString());
+                } else {
+                    throw std::runtime_error("unknown record type");
+                }
+            } catch (const std::runtime_error& e) {
+                throw std::runtime_error("cannot load capabilities journal " + journalFileName +
+                                         ": " + e.what());
+            }
+            validSize = static_cast<std::size_t>(position - begin);
+            ++records;
+        }
+        entryList.compact();
+    }
+
+    if (validSize < fileSize) {
+        // drop the partially written tail, otherwise later records would be unreachable
+        JOYNR_LOG_WARN(logger(),
+                       "Dropping {} bytes of incomplete or corrupt records from {}",
+                       fileSize - validSize,
+                       journalFileName);
+        boost::filesystem::resize_file(journalFileName, validSize);
+    }
+    return records;
+}
+
+void SnapshotStore::add(const std::vector<types::DiscoveryEntry>& entries)
+{
+    if (entries.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const types::DiscoveryEntry& entry : entries) {
+        Encoder encoder;
+        encoder.write(RECORD_ADD);
+        encoder.write(entry);
+        appendRecord(encoder.get());
+    }
+    flushJournal();
+}
+
+void SnapshotStore::remove(const std::vector<std::string>& participantIds)
+{
+    if (participantIds.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::string& participantId : participantIds) {
+        Encoder encoder;
+        encoder.write(RECORD_REMOVE);
+        encoder.write(participantId);
+        appendRecord(encoder.get());
+    }
+    flushJournal();
+}
+
+void SnapshotStore::writeSnapshot(const std::vector<types::DiscoveryEntry>& entries)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::string temporaryFileName = snapshotFileName + ".tmp";
+    {
+        std::ofstream snapshot(temporaryFileName,
+                               std::ios::out | std::ios::binary | std::ios::trunc);
+        snapshot.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        snapshot.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+        const auto count = static_cast<std::uint64_t>(entries.size());
+        snapshot.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        Encoder encoder;
+        for (const types::DiscoveryEntry& entry : entries) {
+            encoder.get().clear();
+            encoder.write(entry);
+            writeRecord(snapshot, encoder.get());
+        }
+        snapshot.close();
+        if (!snapshot) {
+            throw std::runtime_error("cannot write capabilities snapshot " + temporaryFileName);
+        }
+    }
+    // without the sync the rename may reach the disk before the content, so a power loss
+    // could replace the old snapshot by an empty or partial one
+    syncToDisk(temporaryFileName);
+    // the journal is emptied only after the new snapshot is in place. If this is interrupted,
+    // the old journal is replayed on top of the new snapshot, which yields the same state.
+    boost::filesystem::rename(temporaryFileName, snapshotFileName);
+    const boost::filesystem::path directory =
+            boost::filesystem::path(snapshotFileName).parent_path();
+    syncToDisk(directory.empty() ? "." : directory.string());
+    if (journal.is_open()) {
+        journal.close();
+    }
+    openJournal(true);
+    snapshotEntries = entries.size();
+    journalRecords = 0;
+}
+
+bool SnapshotStore::isCompactionRequired() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return journalRecords >= std::max(minJournalRecordsBeforeCompaction, snapshotEntries);
+}
+
+const std::string& SnapshotStore::getSnapshotFileName() const
+{
+    return snapshotFileName;
+}
+
+const std::string& SnapshotStore::getJournalFileName() const
+{
+    return journalFileName;
+}
+
+void SnapshotStore::openJournal(bool truncate)
+{
+    const bool writeHeader = truncate || !boost::filesystem::exists(journalFileName) ||
+                             boost::filesystem::file_size(journalFileName) == 0;
+    journal.open(journalFileName,
+                 std::ios::out | std::ios::binary | (truncate ? std::ios::trunc : std::ios::app));
+    if (!journal) {
+        throw std::runtime_error("cannot open capabilities journal " + journalFileName);
+    }
+    if (writeHeader) {
+        journal.write(JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        journal.write(reinterpret_cast<const char*>(&FORMAT_VERSION), sizeof(FORMAT_VERSION));
+        flushJournal();
+    }
+}
+
+void SnapshotStore::appendRecord(const std::string& payload)
+{
+    if (!journal.is_open()) {
+        openJournal(false);
+    }
+    writeRecord(journal, payload);
+    ++journalRecords;
+}
+
+void SnapshotStore::flushJournal()
+{
+    journal.flush();
+    if (!journal) {
+        journal.close();
+        throw std::runtime_error("cannot write capabilities journal " + journalFileName);
+    }
+}
+
+} // namespace capabilities
+
+} // namespace joynr
@@ -23,9 +23,9 @@
 #include <unordered_set>
 #include <ostream>
 
+#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio/io_service.hpp>
-#include <boost/range/join.hpp>
 #include <spdlog/fmt/fmt.h>
 
 #include "joynr/access-control/IAccessController.h"
@@ -84,13 +84,31 @@ LocalCapabilitiesDirectory::LocalCapabilitiesDirectory(
           messageRouter(messageRouter),
           observers(),
           pendingLookups(),
+          inFlightGlobalLookupsLock(),
+          inFlightGlobalLookups(),
+          globalLookupCount(0),
+          coalescedGlobalLookupCount(0),
+          discoveryCacheMaxStaleness(clusterControllerSettings.getDiscoveryCacheMaxStalenessMs()),
+          discoveryCacheRefreshAheadPercent(
+                  clusterControllerSettings.getDiscoveryCacheRefreshAheadPercent()),
+          staleGlobalLookupCacheHitCount(0),
+          globalLookupCacheRefreshCount(0),
           accessController(),
           checkExpiredDiscoveryEntriesTimer(ioService),
           isLocalCapabilitiesDirectoryPersistencyEnabled(
                   clusterControllerSettings.isLocalCapabilitiesDirectoryPersistencyEnabled()),
+          snapshotStore(),
           freshnessUpdateTimer(ioService),
-          clusterControllerId(clusterControllerId)
+          clusterControllerId(clusterControllerId),
+          freshnessUpdateJitterPercent(
+                  clusterControllerSettings.getCapabilitiesFreshnessUpdateJitterPercent()),
+          freshnessUpdateJitterEngine(std::random_device{}())
 {
+    const std::string persistencyFile =
+            clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename();
+    if (isLocalCapabilitiesDirectoryPersistencyEnabled && !persistencyFile.empty()) {
+        snapshotStore = std::make_unique<capabilities::SnapshotStore>(persistencyFile);
+    }
 }
 
 void LocalCapabilitiesDirectory::init()
@@ -108,8 +126,7 @@ void LocalCapabilitiesDirectory::shutdown()
 void LocalCapabilitiesDirectory::scheduleFreshnessUpdate()
 {
     boost::system::error_code timerError = boost::system::error_code();
-    freshnessUpdateTimer.expires_from_now(
-            clusterControllerSettings.getCapabilitiesFreshnessUpdateIntervalMs(), timerError);
+    freshnessUpdateTimer.expires_from_now(getNextFreshnessUpdateInterval(), timerError);
     if (timerError) {
         JOYNR_LOG_ERROR(logger(),
                         "Error from freshness update timer: {}: {}",
@@ -124,6 +141,19 @@ void LocalCapabilitiesDirectory::scheduleFreshnessUpdate()
     });
 }
 
+std::chrono::milliseconds LocalCapabilitiesDirectory::getNextFreshnessUpdateInterval()
+{
+    const std::chrono::milliseconds interval =
+            clusterControllerSettings.getCapabilitiesFreshnessUpdateIntervalMs();
+    const std::int64_t maxJitterMs =
+            interval.count() * std::min<std::uint32_t>(freshnessUpdateJitterPercent, 100) / 100;
+    if (maxJitterMs == 0) {
+        return interval;
+    }
+    std::uniform_int_distribution<std::int64_t> jitterMs(-maxJitterMs, maxJitterMs);
+    return interval + std::chrono::milliseconds(jitterMs(freshnessUpdateJitterEngine));
+}
+
 void LocalCapabilitiesDirectory::sendAndRescheduleFreshnessUpdate(
         const boost::system::error_code& timerError)
 {
@@ -172,7 +202,6 @@ void LocalCapabilitiesDirectory::addInternal(
         // Inform observers
         informObserversOnAdd(discoveryEntry);
 
-        updatePersistedFile();
         {
             std::lock_guard<std::mutex> lock(pendingLookupsLock);
             callPendingLookups(InterfaceAddress(
@@ -233,7 +262,6 @@ void LocalCapabilitiesDirectory::addInternal(
                     // Inform observers
                     thisSharedPtr->informObserversOnAdd(globalDiscoveryEntry);
 
-                    thisSharedPtr->updatePersistedFile();
                     {
                         std::lock_guard<std::mutex> lock(thisSharedPtr->pendingLookupsLock);
                         thisSharedPtr->callPendingLookups(
@@ -253,6 +281,117 @@ void LocalCapabilitiesDirectory::addInternal(
     }
 }
 
+void LocalCapabilitiesDirectory::addInternal(
+        const std::vector<types::DiscoveryEntry>& entries,
+        bool awaitGlobalRegistration,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    std::vector<types::DiscoveryEntry> localEntries;
+    std::vector<types::DiscoveryEntry> globalEntries;
+    std::vector<types::GlobalDiscoveryEntry> globalDiscoveryEntries;
+    for (const types::DiscoveryEntry& entry : entries) {
+        if (isGlobal(entry)) {
+            globalEntries.push_back(entry);
+            globalDiscoveryEntries.push_back(toGlobalDiscoveryEntry(entry));
+            if (awaitGlobalRegistration) {
+                continue;
+            }
+        }
+        localEntries.push_back(entry);
+    }
+
+    insertInLocalCaches(localEntries);
+
+    if (globalDiscoveryEntries.empty()) {
+        onSuccess();
+        return;
+    }
+
+    auto onErrorWrapper = [
+        numberOfEntries = globalDiscoveryEntries.size(),
+        awaitGlobalRegistration,
+        onError
+    ](const exceptions::JoynrRuntimeException& error)
+    {
+        JOYNR_LOG_ERROR(logger(),
+                        "Error occurred during the execution of capabilitiesProxy->add for {} "
+                        "entries. Error: {}",
+                        numberOfEntries,
+                        error.getMessage());
+        if (awaitGlobalRegistration && onError) {
+            onError(exceptions::ProviderRuntimeException(error.getMessage()));
+        }
+    };
+
+    auto onSuccessWrapper = [
+        thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
+        globalEntries = std::move(globalEntries),
+        awaitGlobalRegistration,
+        onSuccess
+    ]()
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            JOYNR_LOG_INFO(logger(),
+                           "{} global capabilities added successfully",
+                           globalEntries.size());
+            if (awaitGlobalRegistration) {
+                thisSharedPtr->insertInLocalCaches(globalEntries);
+                if (onSuccess) {
+                    onSuccess();
+                }
+            }
+        }
+    };
+
+    capabilitiesClient->add(
+            globalDiscoveryEntries, std::move(onSuccessWrapper), std::move(onErrorWrapper));
+
+    if (!awaitGlobalRegistration) {
+        onSuccess();
+    }
+}
+
+void LocalCapabilitiesDirectory::insertInLocalCaches(
+        const std::vector<types::DiscoveryEntry>& entries)
+{
+    if (entries.empty()) {
+        return;
+    }
+
+    std::vector<InterfaceAddress> interfaceAddresses;
+    {
+        std::lock_guard<std::mutex> lock(cacheLock);
+        for (const types::DiscoveryEntry& entry : entries) {
+            locallyRegisteredCapabilities.insert(entry);
+            if (isGlobal(entry)) {
+                globalLookupCache.insert(entry);
+            }
+            interfaceAddresses.emplace_back(entry.getDomain(), entry.getInterfaceName());
+        }
+        // one journal update for the whole batch
+        persistAdded(entries);
+        JOYNR_LOG_INFO(logger(),
+                       "Added {} local capabilities to cache, #localCapabilities: {}, "
+                       "#globalLookupCache: {}",
+                       entries.size(),
+                       locallyRegisteredCapabilities.size(),
+                       globalLookupCache.size());
+    }
+
+    for (const types::DiscoveryEntry& entry : entries) {
+        informObserversOnAdd(entry);
+    }
+
+    std::sort(interfaceAddresses.begin(), interfaceAddresses.end());
+    interfaceAddresses.erase(std::unique(interfaceAddresses.begin(), interfaceAddresses.end()),
+                             interfaceAddresses.end());
+    std::lock_guard<std::mutex> lock(pendingLookupsLock);
+    for (const InterfaceAddress& interfaceAddress : interfaceAddresses) {
+        callPendingLookups(interfaceAddress);
+    }
+}
+
 types::GlobalDiscoveryEntry LocalCapabilitiesDirectory::toGlobalDiscoveryEntry(
         const types::DiscoveryEntry& discoveryEntry) const
 {
@@ -303,6 +442,7 @@ void LocalCapabilitiesDirectory::remove(const std::string& participantId,
                        participantId,
                        locallyRegisteredCapabilities.size());
         locallyRegisteredCapabilities.removeByParticipantId(participantId);
+        persistRemoved({participantId});
         informObserversOnRemove(entry);
 
         if (auto messageRouterSharedPtr = messageRouter.lock()) {
@@ -313,7 +453,76 @@ void LocalCapabilitiesDirectory::remove(const std::string& participantId,
                             participantId);
         }
     }
-    updatePersistedFile();
+}
+
+// inherited method from joynr::system::DiscoveryProvider
+void LocalCapabilitiesDirectory::remove(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    std::vector<types::DiscoveryEntry> removedEntries;
+    std::vector<std::string> removedParticipantIds;
+    std::vector<std::string> globalParticipantIds;
+    {
+        std::lock_guard<std::mutex> lock(cacheLock);
+        for (const std::string& participantId : participantIds) {
+            boost::optional<types::DiscoveryEntry> optionalEntry =
+                    locallyRegisteredCapabilities.lookupByParticipantId(participantId);
+            if (!optionalEntry) {
+                JOYNR_LOG_INFO(logger(),
+                               "participantId '{}' not found, cannot be removed",
+                               participantId);
+                continue;
+            }
+            if (isGlobal(*optionalEntry)) {
+                globalLookupCache.removeByParticipantId(participantId);
+                globalParticipantIds.push_back(participantId);
+            }
+            locallyRegisteredCapabilities.removeByParticipantId(participantId);
+            removedParticipantIds.push_back(participantId);
+            removedEntries.push_back(std::move(*optionalEntry));
+        }
+        persistRemoved(removedParticipantIds);
+        JOYNR_LOG_INFO(logger(),
+                       "Removed {} locally registered participantIds, #localCapabilities: {}, "
+                       "#registeredGlobalCapabilities: {}",
+                       removedEntries.size(),
+                       locallyRegisteredCapabilities.size(),
+                       countGlobalCapabilities());
+    }
+
+    for (const types::DiscoveryEntry& entry : removedEntries) {
+        informObserversOnRemove(entry);
+    }
+
+    if (!globalParticipantIds.empty()) {
+        try {
+            capabilitiesClient->remove(std::move(globalParticipantIds));
+        } catch (const exceptions::JoynrRuntimeException& e) {
+            onError(joynr::exceptions::ProviderRuntimeException(
+                    "Unable to remove the providers from the global capabilities directory: " +
+                    e.getMessage()));
+            return;
+        }
+    }
+
+    if (removedParticipantIds.empty()) {
+        onSuccess();
+        return;
+    }
+
+    if (auto messageRouterSharedPtr = messageRouter.lock()) {
+        messageRouterSharedPtr->removeNextHops(
+                removedParticipantIds, std::move(onSuccess), std::move(onError));
+    } else {
+        JOYNR_LOG_FATAL(logger(),
+                        "could not removeNextHops for {} participants because messageRouter "
+                        "is not available",
+                        removedParticipantIds.size());
+        onError(joynr::exceptions::ProviderRuntimeException(
+                "Unable to remove the routing entries since the message router is not available"));
+    }
 }
 
 void LocalCapabilitiesDirectory::triggerGlobalProviderReregistration(
@@ -356,14 +565,27 @@ std::size_t LocalCapabilitiesDirectory::countGlobalCapabilities() const
 bool LocalCapabilitiesDirectory::getLocalAndCachedCapabilities(
         const std::vector<InterfaceAddress>& interfaceAddresses,
         const joynr::types::DiscoveryQos& discoveryQos,
-        std::shared_ptr<ILocalCapabilitiesCallback> callback)
+        std::shared_ptr<ILocalCapabilitiesCallback> callback,
+        std::chrono::milliseconds& oldestCachedEntryAge)
 {
     joynr::types::DiscoveryScope::Enum scope = discoveryQos.getDiscoveryScope();
 
-    std::vector<types::DiscoveryEntry> localCapabilities =
+    std::vector<DiscoveryEntryPtr> localCapabilities =
             searchCache(interfaceAddresses, std::chrono::milliseconds(-1), true);
-    std::vector<types::DiscoveryEntry> globalCapabilities = searchCache(
-            interfaceAddresses, std::chrono::milliseconds(discoveryQos.getCacheMaxAge()), false);
+
+    // entries older than cacheMaxAge may be served while they are refreshed in the background
+    std::chrono::milliseconds maxCacheAge(discoveryQos.getCacheMaxAge());
+    if (maxCacheAge.count() > 0 &&
+        maxCacheAge <= std::chrono::milliseconds::max() - discoveryCacheMaxStaleness) {
+        maxCacheAge += discoveryCacheMaxStaleness;
+    }
+    std::vector<DiscoveryEntryPtr> globalCapabilities =
+            searchGlobalCache(interfaceAddresses, maxCacheAge, oldestCachedEntryAge);
+    if (globalCapabilities.empty() || scope == joynr::types::DiscoveryScope::LOCAL_ONLY ||
+        (scope == joynr::types::DiscoveryScope::LOCAL_THEN_GLOBAL && !localCapabilities.empty())) {
+        // cached global entries are not part of the result
+        oldestCachedEntryAge = std::chrono::milliseconds(-1);
+    }
 
     return callReceiverIfPossible(scope,
                                   std::move(localCapabilities),
@@ -378,12 +600,12 @@ bool LocalCapabilitiesDirectory::getLocalAndCachedCapabilities(
 {
     joynr::types::DiscoveryScope::Enum scope = discoveryQos.getDiscoveryScope();
 
-    boost::optional<types::DiscoveryEntry> globalCapability =
+    DiscoveryEntryPtr globalCapability =
             searchCache(participantId, std::chrono::milliseconds(discoveryQos.getCacheMaxAge()));
 
     return callReceiverIfPossible(scope,
                                   getCachedLocalCapabilities(participantId),
-                                  optionalToVector(std::move(globalCapability)),
+                                  pointerToVector(std::move(globalCapability)),
                                   std::move(callback));
 }
 
@@ -407,8 +629,8 @@ std::vector<types::DiscoveryEntryWithMetaInfo> LocalCapabilitiesDirectory::filte
 
 bool LocalCapabilitiesDirectory::callReceiverIfPossible(
         joynr::types::DiscoveryScope::Enum& scope,
-        std::vector<types::DiscoveryEntry>&& localCapabilities,
-        std::vector<types::DiscoveryEntry>&& globalCapabilities,
+        std::vector<DiscoveryEntryPtr>&& localCapabilities,
+        std::vector<DiscoveryEntryPtr>&& globalCapabilities,
         std::shared_ptr<ILocalCapabilitiesCallback> callback)
 {
     // return only local capabilities
@@ -481,9 +703,18 @@ bool LocalCapabilitiesDirectory::callReceiverIfPossible(
 
 void LocalCapabilitiesDirectory::capabilitiesReceived(
         const std::vector<types::GlobalDiscoveryEntry>& results,
-        std::vector<types::DiscoveryEntry>&& localEntries,
+        std::vector<DiscoveryEntryPtr>&& localEntries,
         std::shared_ptr<ILocalCapabilitiesCallback> callback,
         joynr::types::DiscoveryScope::Enum discoveryScope)
+{
+    globalCapabilitiesReceived(registerGlobalCapabilities(results),
+                               std::move(localEntries),
+                               std::move(callback),
+                               discoveryScope);
+}
+
+std::vector<types::DiscoveryEntryWithMetaInfo> LocalCapabilitiesDirectory::
+        registerGlobalCapabilities(const std::vector<types::GlobalDiscoveryEntry>& results)
 {
     std::unordered_multimap<std::string, types::DiscoveryEntry> capabilitiesMap;
     std::vector<types::DiscoveryEntryWithMetaInfo> globalEntries;
@@ -496,7 +727,15 @@ void LocalCapabilitiesDirectory::capabilitiesReceived(
         globalEntries.push_back(std::move(convertedEntry));
     }
     registerReceivedCapabilities(std::move(capabilitiesMap));
+    return globalEntries;
+}
 
+void LocalCapabilitiesDirectory::globalCapabilitiesReceived(
+        std::vector<types::DiscoveryEntryWithMetaInfo> globalEntries,
+        std::vector<DiscoveryEntryPtr>&& localEntries,
+        std::shared_ptr<ILocalCapabilitiesCallback> callback,
+        joynr::types::DiscoveryScope::Enum discoveryScope)
+{
     if (discoveryScope == joynr::types::DiscoveryScope::LOCAL_THEN_GLOBAL ||
         discoveryScope == joynr::types::DiscoveryScope::LOCAL_AND_GLOBAL) {
         std::vector<types::DiscoveryEntryWithMetaInfo> localEntriesWithMetaInfo =
@@ -562,60 +801,194 @@ void LocalCapabilitiesDirectory::lookup(const std::vector<std::string>& domains,
         interfaceAddresses.push_back(InterfaceAddress(domains.at(i), interfaceName));
     }
 
+    // identical lookups are identified by the set of domains and the interface
+    std::vector<std::string> sortedDomains(domains);
+    std::sort(sortedDomains.begin(), sortedDomains.end());
+    sortedDomains.erase(
+            std::unique(sortedDomains.begin(), sortedDomains.end()), sortedDomains.end());
+    GlobalLookupKey key(std::move(sortedDomains), interfaceName);
+
     // get the local and cached entries
-    bool receiverCalled = getLocalAndCachedCapabilities(interfaceAddresses, discoveryQos, callback);
+    std::chrono::milliseconds oldestCachedEntryAge(-1);
+    bool receiverCalled = getLocalAndCachedCapabilities(
+            interfaceAddresses, discoveryQos, callback, oldestCachedEntryAge);
+
+    if (receiverCalled) {
+        if (isGlobalLookupCacheRefreshRequired(oldestCachedEntryAge, discoveryQos)) {
+            refreshGlobalLookupCache(key, discoveryQos.getDiscoveryTimeout());
+        }
+        return;
+    }
 
     // if no receiver is called, use the global capabilities directory
-    if (!receiverCalled) {
-        // search for global entires in the global capabilities directory
-        auto onSuccess = [
-            thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
-            interfaceAddresses,
-            callback,
-            discoveryQos
-        ](std::vector<joynr::types::GlobalDiscoveryEntry> capabilities)
-        {
-            if (auto thisSharedPtr = thisWeakPtr.lock()) {
-                std::lock_guard<std::mutex> lock(thisSharedPtr->pendingLookupsLock);
-                if (!(thisSharedPtr->isCallbackCalled(
-                            interfaceAddresses, callback, discoveryQos))) {
-                    thisSharedPtr->capabilitiesReceived(
-                            capabilities,
-                            thisSharedPtr->getCachedLocalCapabilities(interfaceAddresses),
-                            callback,
-                            discoveryQos.getDiscoveryScope());
-                }
-                thisSharedPtr->callbackCalled(interfaceAddresses, callback);
-            }
-        };
+    if (discoveryQos.getDiscoveryScope() == joynr::types::DiscoveryScope::LOCAL_THEN_GLOBAL) {
+        std::lock_guard<std::mutex> lock(pendingLookupsLock);
+        registerPendingLookup(interfaceAddresses, callback);
+    }
 
-        auto onError = [
-            thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
-            interfaceAddresses,
-            callback,
-            discoveryQos
-        ](const exceptions::JoynrRuntimeException& error)
-        {
-            if (auto thisSharedPtr = thisWeakPtr.lock()) {
-                std::lock_guard<std::mutex> lock(thisSharedPtr->pendingLookupsLock);
-                if (!(thisSharedPtr->isCallbackCalled(
-                            interfaceAddresses, callback, discoveryQos))) {
-                    callback->onError(error);
-                }
-                thisSharedPtr->callbackCalled(interfaceAddresses, callback);
-            }
-        };
+    // identical lookups which are already in flight are not sent again, the callback is
+    // served with the result of the request in flight
+    {
+        std::lock_guard<std::mutex> lock(inFlightGlobalLookupsLock);
+        auto inFlight = inFlightGlobalLookups.find(key);
+        if (inFlight != inFlightGlobalLookups.end()) {
+            inFlight->second.push_back(
+                    GlobalLookupWaiter{std::move(interfaceAddresses), callback, discoveryQos});
+            ++coalescedGlobalLookupCount;
+            JOYNR_LOG_DEBUG(logger(),
+                            "Global lookup for domains {}, interface {} already in flight, "
+                            "{} callers waiting",
+                            boost::algorithm::join(key.first, ", "),
+                            interfaceName,
+                            inFlight->second.size());
+            return;
+        }
+        inFlightGlobalLookups[key].push_back(
+                GlobalLookupWaiter{std::move(interfaceAddresses), callback, discoveryQos});
+        ++globalLookupCount;
+    }
 
-        if (discoveryQos.getDiscoveryScope() == joynr::types::DiscoveryScope::LOCAL_THEN_GLOBAL) {
-            std::lock_guard<std::mutex> lock(pendingLookupsLock);
-            registerPendingLookup(interfaceAddresses, callback);
+    sendGlobalLookup(key, domains, discoveryQos.getDiscoveryTimeout());
+}
+
+void LocalCapabilitiesDirectory::sendGlobalLookup(const GlobalLookupKey& key,
+                                                  const std::vector<std::string>& domains,
+                                                  std::int64_t discoveryTimeout)
+{
+    // search for global entires in the global capabilities directory
+    auto onSuccess = [ thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()), key ](
+            std::vector<joynr::types::GlobalDiscoveryEntry> capabilities)
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->globalLookupSucceeded(key, capabilities);
         }
-        capabilitiesClient->lookup(domains,
-                                   interfaceName,
-                                   discoveryQos.getDiscoveryTimeout(),
-                                   std::move(onSuccess),
-                                   std::move(onError));
+    };
+
+    auto onError = [ thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()), key ](
+            const exceptions::JoynrRuntimeException& error)
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->globalLookupFailed(key, error);
+        }
+    };
+
+    // the waiters registered for key are only released by onSuccess or onError, which are never
+    // called if the request cannot even be sent
+    try {
+        capabilitiesClient->lookup(
+                domains, key.second, discoveryTimeout, std::move(onSuccess), std::move(onError));
+    } catch (const exceptions::JoynrRuntimeException& e) {
+        globalLookupFailed(key, e);
+    } catch (const std::exception& e) {
+        globalLookupFailed(key, exceptions::JoynrRuntimeException(e.what()));
+    }
+}
+
+bool LocalCapabilitiesDirectory::isGlobalLookupCacheRefreshRequired(
+        std::chrono::milliseconds oldestCachedEntryAge,
+        const joynr::types::DiscoveryQos& discoveryQos)
+{
+    if (oldestCachedEntryAge.count() < 0) {
+        // the result did not contain entries of the globalLookupCache
+        return false;
+    }
+    const std::int64_t maxCacheAge = discoveryQos.getCacheMaxAge();
+    if (oldestCachedEntryAge.count() > maxCacheAge) {
+        ++staleGlobalLookupCacheHitCount;
+        return true;
+    }
+    return discoveryCacheRefreshAheadPercent > 0 &&
+           oldestCachedEntryAge.count() >=
+                   maxCacheAge / 100.0 * discoveryCacheRefreshAheadPercent;
+}
+
+void LocalCapabilitiesDirectory::refreshGlobalLookupCache(const GlobalLookupKey& key,
+                                                          std::int64_t discoveryTimeout)
+{
+    {
+        std::lock_guard<std::mutex> lock(inFlightGlobalLookupsLock);
+        if (inFlightGlobalLookups.find(key) != inFlightGlobalLookups.end()) {
+            return;
+        }
+        // nobody waits for the result, it only updates the globalLookupCache
+        inFlightGlobalLookups[key];
+        ++globalLookupCount;
+        ++globalLookupCacheRefreshCount;
     }
+    JOYNR_LOG_DEBUG(logger(),
+                    "Refreshing globalLookupCache for domains {}, interface {}",
+                    boost::algorithm::join(key.first, ", "),
+                    key.second);
+    sendGlobalLookup(key, key.first, discoveryTimeout);
+}
+
+std::vector<LocalCapabilitiesDirectory::GlobalLookupWaiter> LocalCapabilitiesDirectory::
+        takeGlobalLookupWaiters(const GlobalLookupKey& key)
+{
+    std::vector<GlobalLookupWaiter> waiters;
+    std::lock_guard<std::mutex> lock(inFlightGlobalLookupsLock);
+    auto inFlight = inFlightGlobalLookups.find(key);
+    if (inFlight != inFlightGlobalLookups.end()) {
+        waiters = std::move(inFlight->second);
+        inFlightGlobalLookups.erase(inFlight);
+    }
+    return waiters;
+}
+
+void LocalCapabilitiesDirectory::globalLookupSucceeded(
+        const GlobalLookupKey& key,
+        const std::vector<types::GlobalDiscoveryEntry>& capabilities)
+{
+    // the waiters are taken before the cache is populated; later lookups either find the
+    // result in the cache or start a new request
+    std::vector<GlobalLookupWaiter> waiters = takeGlobalLookupWaiters(key);
+    std::vector<types::DiscoveryEntryWithMetaInfo> globalEntries =
+            registerGlobalCapabilities(capabilities);
+
+    std::lock_guard<std::mutex> lock(pendingLookupsLock);
+    for (GlobalLookupWaiter& waiter : waiters) {
+        if (!isCallbackCalled(waiter.interfaceAddresses, waiter.callback, waiter.discoveryQos)) {
+            globalCapabilitiesReceived(globalEntries,
+                                       getCachedLocalCapabilities(waiter.interfaceAddresses),
+                                       waiter.callback,
+                                       waiter.discoveryQos.getDiscoveryScope());
+        }
+        callbackCalled(waiter.interfaceAddresses, waiter.callback);
+    }
+}
+
+void LocalCapabilitiesDirectory::globalLookupFailed(const GlobalLookupKey& key,
+                                                    const exceptions::JoynrRuntimeException& error)
+{
+    std::vector<GlobalLookupWaiter> waiters = takeGlobalLookupWaiters(key);
+
+    std::lock_guard<std::mutex> lock(pendingLookupsLock);
+    for (GlobalLookupWaiter& waiter : waiters) {
+        if (!isCallbackCalled(waiter.interfaceAddresses, waiter.callback, waiter.discoveryQos)) {
+            waiter.callback->onError(error);
+        }
+        callbackCalled(waiter.interfaceAddresses, waiter.callback);
+    }
+}
+
+std::uint64_t LocalCapabilitiesDirectory::getNumberOfGlobalLookups() const
+{
+    return globalLookupCount;
+}
+
+std::uint64_t LocalCapabilitiesDirectory::getNumberOfCoalescedGlobalLookups() const
+{
+    return coalescedGlobalLookupCount;
+}
+
+std::uint64_t LocalCapabilitiesDirectory::getNumberOfStaleGlobalLookupCacheHits() const
+{
+    return staleGlobalLookupCacheHitCount;
+}
+
+std::uint64_t LocalCapabilitiesDirectory::getNumberOfGlobalLookupCacheRefreshes() const
+{
+    return globalLookupCacheRefreshCount;
 }
 
 void LocalCapabilitiesDirectory::callPendingLookups(const InterfaceAddress& interfaceAddress)
@@ -623,7 +996,7 @@ void LocalCapabilitiesDirectory::callPendingLookups(const InterfaceAddress& inte
     if (pendingLookups.find(interfaceAddress) == pendingLookups.cend()) {
         return;
     }
-    std::vector<types::DiscoveryEntry> localCapabilities =
+    std::vector<DiscoveryEntryPtr> localCapabilities =
             searchCache({interfaceAddress}, std::chrono::milliseconds(-1), true);
     if (localCapabilities.empty()) {
         return;
@@ -692,14 +1065,24 @@ void LocalCapabilitiesDirectory::callbackCalled(
     }
 }
 
-std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedLocalCapabilities(
+// inherited method from joynr::ILocalParticipantLookup
+boost::optional<types::DiscoveryEntryWithMetaInfo> LocalCapabilitiesDirectory::lookupLocally(
         const std::string& participantId)
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
-    return optionalToVector(locallyRegisteredCapabilities.lookupByParticipantId(participantId));
+    if (auto entry = locallyRegisteredCapabilities.findByParticipantId(participantId)) {
+        return util::convert(true, *entry);
+    }
+    return boost::none;
 }
 
-std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedLocalCapabilities(
+std::vector<LocalCapabilitiesDirectory::DiscoveryEntryPtr> LocalCapabilitiesDirectory::
+        getCachedLocalCapabilities(const std::string& participantId)
+{
+    return pointerToVector(locallyRegisteredCapabilities.findByParticipantId(participantId));
+}
+
+std::vector<LocalCapabilitiesDirectory::DiscoveryEntryPtr> LocalCapabilitiesDirectory::
+        getCachedLocalCapabilities(
         const std::vector<InterfaceAddress>& interfaceAddresses)
 {
     return searchCache(interfaceAddresses, std::chrono::milliseconds(-1), true);
@@ -777,6 +1160,27 @@ void LocalCapabilitiesDirectory::add(
                         discoveryEntry.getDomain())));
 }
 
+// inherited method from joynr::system::DiscoveryProvider
+void LocalCapabilitiesDirectory::add(
+        const std::vector<types::DiscoveryEntry>& discoveryEntries,
+        const bool& awaitGlobalRegistration,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    // the batch is all or nothing, so every permission is checked before anything is added
+    for (const types::DiscoveryEntry& discoveryEntry : discoveryEntries) {
+        if (!hasProviderPermission(discoveryEntry)) {
+            onError(joynr::exceptions::ProviderRuntimeException(fmt::format(
+                    "Provider does not have permissions to register interface {} on domain {}.",
+                    discoveryEntry.getInterfaceName(),
+                    discoveryEntry.getDomain())));
+            return;
+        }
+    }
+    addInternal(
+            discoveryEntries, awaitGlobalRegistration, std::move(onSuccess), std::move(onError));
+}
+
 bool LocalCapabilitiesDirectory::hasProviderPermission(const types::DiscoveryEntry& discoveryEntry)
 {
     if (!clusterControllerSettings.enableAccessController()) {
@@ -817,12 +1221,12 @@ bool LocalCapabilitiesDirectory::hasProviderPermission(const types::DiscoveryEnt
     return false;
 }
 
-std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::optionalToVector(
-        boost::optional<types::DiscoveryEntry> optionalEntry)
+std::vector<LocalCapabilitiesDirectory::DiscoveryEntryPtr> LocalCapabilitiesDirectory::
+        pointerToVector(DiscoveryEntryPtr entry)
 {
-    std::vector<types::DiscoveryEntry> vec;
-    if (optionalEntry) {
-        vec.push_back(std::move(*optionalEntry));
+    std::vector<DiscoveryEntryPtr> vec;
+    if (entry) {
+        vec.push_back(std::move(entry));
     }
     return vec;
 }
@@ -915,8 +1319,51 @@ void LocalCapabilitiesDirectory::removeProviderRegistrationObserver(
 
 void LocalCapabilitiesDirectory::updatePersistedFile()
 {
-    saveLocalCapabilitiesToFile(
-            clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename());
+    std::lock_guard<std::mutex> lock(cacheLock);
+    writeSnapshot();
+}
+
+void LocalCapabilitiesDirectory::persistAdded(const std::vector<types::DiscoveryEntry>& entries)
+{
+    if (!snapshotStore) {
+        return;
+    }
+    try {
+        snapshotStore->add(entries);
+        if (snapshotStore->isCompactionRequired()) {
+            writeSnapshot();
+        }
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(), ex.what());
+    }
+}
+
+void LocalCapabilitiesDirectory::persistRemoved(const std::vector<std::string>& participantIds)
+{
+    if (!snapshotStore) {
+        return;
+    }
+    try {
+        snapshotStore->remove(participantIds);
+        if (snapshotStore->isCompactionRequired()) {
+            writeSnapshot();
+        }
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(), ex.what());
+    }
+}
+
+void LocalCapabilitiesDirectory::writeSnapshot()
+{
+    if (!snapshotStore) {
+        return;
+    }
+    try {
+        snapshotStore->writeSnapshot(std::vector<types::DiscoveryEntry>(
+                locallyRegisteredCapabilities.cbegin(), locallyRegisteredCapabilities.cend()));
+    } catch (const std::exception& ex) {
+        JOYNR_LOG_ERROR(logger(), ex.what());
+    }
 }
 
 void LocalCapabilitiesDirectory::saveLocalCapabilitiesToFile(const std::string& fileName)
@@ -940,42 +1387,60 @@ void LocalCapabilitiesDirectory::saveLocalCapabilitiesToFile(const std::string&
 
 void LocalCapabilitiesDirectory::loadPersistedFile()
 {
-    if (!isLocalCapabilitiesDirectoryPersistencyEnabled) {
+    if (!snapshotStore) { // Persistency disabled
         return;
     }
 
-    const std::string persistencyFile =
-            clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename();
-
-    if (persistencyFile.empty()) { // Persistency disabled
+    std::vector<types::DiscoveryEntry> persistedEntries;
+    bool isSnapshotLoaded = false;
+    try {
+        isSnapshotLoaded = snapshotStore->load(persistedEntries);
+    } catch (const std::exception& ex) {
+        // neither restore a part of the entries nor compact or import over the unreadable files,
+        // they are kept as they are until they have been repaired or removed
+        JOYNR_LOG_ERROR(logger(),
+                        "{}. Persistency of local capabilities is disabled.",
+                        ex.what());
+        std::lock_guard<std::mutex> lock(cacheLock);
+        snapshotStore.reset();
         return;
     }
 
-    std::string jsonString;
-    try {
-        jsonString = joynr::util::loadStringFromFile(persistencyFile);
-    } catch (const std::runtime_error& ex) {
-        JOYNR_LOG_INFO(logger(), ex.what());
-    }
+    if (!isSnapshotLoaded) {
+        // import the JSON file written by earlier versions
+        const std::string persistencyFile =
+                clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename();
+        std::string jsonString;
+        try {
+            jsonString = joynr::util::loadStringFromFile(persistencyFile);
+        } catch (const std::runtime_error& ex) {
+            JOYNR_LOG_INFO(logger(), ex.what());
+        }
 
-    if (jsonString.empty()) {
-        return;
+        if (!jsonString.empty()) {
+            capabilities::Storage legacyCapabilities;
+            try {
+                joynr::serializer::deserializeFromJson(legacyCapabilities, jsonString);
+            } catch (const std::invalid_argument& ex) {
+                JOYNR_LOG_ERROR(logger(), ex.what());
+            }
+            persistedEntries.assign(legacyCapabilities.cbegin(), legacyCapabilities.cend());
+        }
     }
 
     std::lock_guard<std::mutex> lock(cacheLock);
 
-    try {
-        joynr::serializer::deserializeFromJson(locallyRegisteredCapabilities, jsonString);
-    } catch (const std::invalid_argument& ex) {
-        JOYNR_LOG_ERROR(logger(), ex.what());
-    }
-
-    // insert all global capability entries into global cache
-    for (const auto& entry : locallyRegisteredCapabilities) {
+    locallyRegisteredCapabilities.insert(persistedEntries.cbegin(), persistedEntries.cend());
+    for (const auto& entry : persistedEntries) {
+        // insert all global capability entries into global cache
         if (entry.getQos().getScope() == types::ProviderScope::GLOBAL) {
             globalLookupCache.insert(entry);
         }
     }
+
+    if (!isSnapshotLoaded && !persistedEntries.empty()) {
+        writeSnapshot();
+    }
 }
 
 void LocalCapabilitiesDirectory::injectGlobalCapabilitiesFromFile(const std::string& fileName)
@@ -1031,6 +1496,7 @@ void LocalCapabilitiesDirectory::insertInLocallyRegisteredCapabilitiesCache(
     std::lock_guard<std::mutex> lock(cacheLock);
 
     locallyRegisteredCapabilities.insert(entry);
+    persistAdded({entry});
     JOYNR_LOG_INFO(logger(),
                    "Added local capability to cache {}, #localCapabilities: {}",
                    entry.toString(),
@@ -1051,48 +1517,64 @@ void LocalCapabilitiesDirectory::insertInGlobalLookupCache(const types::Discover
                    globalLookupCache.size());
 }
 
-std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
-        const std::vector<InterfaceAddress>& interfaceAddresses,
-        std::chrono::milliseconds maxCacheAge,
-        bool localEntries)
+std::vector<LocalCapabilitiesDirectory::DiscoveryEntryPtr> LocalCapabilitiesDirectory::
+        searchCache(const std::vector<InterfaceAddress>& interfaceAddresses,
+                    std::chrono::milliseconds maxCacheAge,
+                    bool localEntries)
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
-
-    std::vector<types::DiscoveryEntry> result;
+    // the storages are read through their sharded index, cacheLock is not needed
+    std::vector<DiscoveryEntryPtr> result;
     for (std::size_t i = 0; i < interfaceAddresses.size(); i++) {
         const InterfaceAddress& interfaceAddress = interfaceAddresses.at(i);
         const std::string& domain = interfaceAddress.getDomain();
         const std::string& interface = interfaceAddress.getInterface();
 
-        std::vector<types::DiscoveryEntry> entries =
-                localEntries
-                        ? locallyRegisteredCapabilities.lookupByDomainAndInterface(
-                                  domain, interface)
-                        : globalLookupCache.lookupCacheByDomainAndInterface(
-                                  domain, interface, maxCacheAge);
-        result.insert(result.end(),
-                      std::make_move_iterator(entries.begin()),
-                      std::make_move_iterator(entries.end()));
+        if (localEntries) {
+            for (const auto& entry :
+                 locallyRegisteredCapabilities.findByDomainAndInterface(domain, interface)) {
+                result.push_back(entry);
+            }
+        } else {
+            std::chrono::milliseconds ignoredAge(0);
+            for (const auto& entry : globalLookupCache.findCacheByDomainAndInterface(
+                         domain, interface, maxCacheAge, ignoredAge)) {
+                result.push_back(entry);
+            }
+        }
     }
     return result;
 }
 
-boost::optional<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
+std::vector<LocalCapabilitiesDirectory::DiscoveryEntryPtr> LocalCapabilitiesDirectory::
+        searchGlobalCache(const std::vector<InterfaceAddress>& interfaceAddresses,
+                          std::chrono::milliseconds maxCacheAge,
+                          std::chrono::milliseconds& oldestCachedEntryAge)
+{
+    std::vector<DiscoveryEntryPtr> result;
+    for (const InterfaceAddress& interfaceAddress : interfaceAddresses) {
+        for (const auto& entry :
+             globalLookupCache.findCacheByDomainAndInterface(interfaceAddress.getDomain(),
+                                                             interfaceAddress.getInterface(),
+                                                             maxCacheAge,
+                                                             oldestCachedEntryAge)) {
+            result.push_back(entry);
+        }
+    }
+    return result;
+}
+
+LocalCapabilitiesDirectory::DiscoveryEntryPtr LocalCapabilitiesDirectory::searchCache(
         const std::string& participantId,
         std::chrono::milliseconds maxCacheAge)
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
-
     // first search locally
-    auto entry = locallyRegisteredCapabilities.lookupByParticipantId(participantId);
-    if (!entry) {
-        if (maxCacheAge == std::chrono::milliseconds(-1)) {
-            entry = globalLookupCache.lookupByParticipantId(participantId);
-        } else {
-            entry = globalLookupCache.lookupCacheByParticipantId(participantId, maxCacheAge);
-        }
+    if (auto localEntry = locallyRegisteredCapabilities.findByParticipantId(participantId)) {
+        return localEntry;
     }
-    return entry;
+    if (maxCacheAge == std::chrono::milliseconds(-1)) {
+        return globalLookupCache.findByParticipantId(participantId);
+    }
+    return globalLookupCache.findCacheByParticipantId(participantId, maxCacheAge);
 }
 
 void LocalCapabilitiesDirectory::informObserversOnAdd(const types::DiscoveryEntry& discoveryEntry)
@@ -1115,10 +1597,14 @@ bool LocalCapabilitiesDirectory::isGlobal(const types::DiscoveryEntry& discovery
     return discoveryEntry.getQos().getScope() == types::ProviderScope::GLOBAL;
 }
 
-void LocalCapabilitiesDirectory::scheduleCleanupTimer()
+void LocalCapabilitiesDirectory::scheduleCleanupTimer(bool expiredEntriesRemaining)
 {
     boost::system::error_code timerError;
     auto intervalMs = clusterControllerSettings.getPurgeExpiredDiscoveryEntriesIntervalMs();
+    if (expiredEntriesRemaining) {
+        // remove the next batch as soon as the handlers queued in the meantime have run
+        intervalMs = 0;
+    }
     checkExpiredDiscoveryEntriesTimer.expires_from_now(
             std::chrono::milliseconds(intervalMs), timerError);
     if (timerError) {
@@ -1153,15 +1639,38 @@ void LocalCapabilitiesDirectory::checkExpiredDiscoveryEntries(
                         errorCode.message());
     }
 
-    bool fileUpdateRequired = false;
+    const std::size_t batchSize =
+            clusterControllerSettings.getPurgeExpiredDiscoveryEntriesBatchSize();
+    bool expiredEntriesRemaining = false;
     {
         std::lock_guard<std::mutex> lock(cacheLock);
 
-        auto removedLocalCapabilities = locallyRegisteredCapabilities.removeExpired();
-        auto removedGlobalCapabilities = globalLookupCache.removeExpired();
+        auto removedLocalCapabilities = locallyRegisteredCapabilities.removeExpired(batchSize);
+        std::vector<types::DiscoveryEntry> removedGlobalCapabilities;
+        if (batchSize == 0) {
+            removedGlobalCapabilities = globalLookupCache.removeExpired();
+        } else if (removedLocalCapabilities.size() < batchSize) {
+            removedGlobalCapabilities =
+                    globalLookupCache.removeExpired(batchSize - removedLocalCapabilities.size());
+        }
+        expiredEntriesRemaining =
+                batchSize > 0 &&
+                removedLocalCapabilities.size() + removedGlobalCapabilities.size() == batchSize;
+
+        std::vector<std::string> removedParticipantIds;
+        removedParticipantIds.reserve(removedLocalCapabilities.size() +
+                                      removedGlobalCapabilities.size());
+        for (const auto& capability : removedLocalCapabilities) {
+            removedParticipantIds.push_back(capability.getParticipantId());
+        }
+        if (!removedParticipantIds.empty()) {
+            persistRemoved(removedParticipantIds);
+        }
+        for (const auto& capability : removedGlobalCapabilities) {
+            removedParticipantIds.push_back(capability.getParticipantId());
+        }
 
-        if (!removedLocalCapabilities.empty() || !removedGlobalCapabilities.empty()) {
-            fileUpdateRequired = true;
+        if (!removedParticipantIds.empty()) {
             if (auto messageRouterSharedPtr = messageRouter.lock()) {
                 JOYNR_LOG_INFO(logger(),
                                "Following discovery entries expired: local: {}, "
@@ -1171,23 +1680,17 @@ void LocalCapabilitiesDirectory::checkExpiredDiscoveryEntries(
                                joinToString(removedGlobalCapabilities),
                                globalLookupCache.size());
 
-                for (const auto& capability :
-                     boost::join(removedLocalCapabilities, removedGlobalCapabilities)) {
-                    messageRouterSharedPtr->removeNextHop(capability.getParticipantId());
-                }
+                // one routing table update for the whole batch
+                messageRouterSharedPtr->removeNextHops(removedParticipantIds);
             } else {
                 JOYNR_LOG_FATAL(logger(),
-                                "could not call removeNextHop because messageRouter is "
+                                "could not call removeNextHops because messageRouter is "
                                 "not available");
             }
         }
     }
 
-    if (fileUpdateRequired) {
-        updatePersistedFile();
-    }
-
-    scheduleCleanupTimer();
+    scheduleCleanupTimer(expiredEntriesRemaining);
 }
 
 std::string LocalCapabilitiesDirectory::joinToString(
@@ -0,0 +1,131 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef CAPABILITIESSNAPSHOTSTORE_H
+#define CAPABILITIESSNAPSHOTSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+namespace types
+{
+class DiscoveryEntry;
+} // namespace types
+
+namespace capabilities
+{
+
+/**
+ * @brief Persists discovery entries as a binary snapshot plus an append-only journal.
+ *
+ * The snapshot holds all entries at the time it was written. It is memory mapped and decoded in
+ * place when loading. Every later change is appended to the journal as a single record, so the
+ * cost of a change does not depend on the number of persisted entries. Loading replays the
+ * journal on top of the snapshot. Once the journal has grown larger than the snapshot, the owner
+ * writes a new snapshot, which empties the journal.
+ *
+ * Records carry their length and a CRC32. A journal record which was only partially written
+ * (e.g. due to a crash) is dropped when loading, any other damage fails the load. A new snapshot
+ * is synced to the disk before it replaces the old one. The files use the byte order of the host
+ * and are not meant to be moved to another machine.
+ *
+ * The store is thread safe, but it does not order concurrent changes of the same entry: callers
+ * have to persist a change while they hold the lock which protects the change in memory.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT SnapshotStore
+{
+public:
+    /**
+     * @param fileName the snapshot is stored as fileName.snapshot and the journal as
+     * fileName.journal
+     * @param minJournalRecordsBeforeCompaction compaction is never requested for smaller journals
+     */
+    explicit SnapshotStore(const std::string& fileName,
+                           std::size_t minJournalRecordsBeforeCompaction = 1024);
+    ~SnapshotStore();
+
+    /**
+     * @brief Loads the snapshot and replays the journal.
+     * @return false if neither a snapshot nor a journal exists
+     * @throw std::runtime_error if the snapshot or the journal is corrupt or cannot be read,
+     * the files are left unchanged in this case
+     */
+    bool load(std::vector<types::DiscoveryEntry>& entries);
+
+    /**
+     * @brief Appends the added or replaced entries to the journal.
+     * @throw std::runtime_error if the journal cannot be written
+     */
+    void add(const std::vector<types::DiscoveryEntry>& entries);
+
+    /**
+     * @brief Appends the removal of the participants to the journal.
+     * @throw std::runtime_error if the journal cannot be written
+     */
+    void remove(const std::vector<std::string>& participantIds);
+
+    /**
+     * @brief Replaces the snapshot by the given entries and empties the journal.
+     * @throw std::runtime_error if the snapshot cannot be written
+     */
+    void writeSnapshot(const std::vector<types::DiscoveryEntry>& entries);
+
+    /**
+     * @return true if the journal has grown large enough that a new snapshot should be written
+     */
+    bool isCompactionRequired() const;
+
+    const std::string& getSnapshotFileName() const;
+    const std::string& getJournalFileName() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SnapshotStore);
+
+    void openJournal(bool truncate);
+    void appendRecord(const std::string& payload);
+    void flushJournal();
+    std::size_t loadSnapshot(std::vector<types::DiscoveryEntry>& entries);
+    std::size_t replayJournal(std::vector<types::DiscoveryEntry>& entries);
+
+    const std::string snapshotFileName;
+    const std::string journalFileName;
+    const std::size_t minJournalRecordsBeforeCompaction;
+    mutable std::mutex mutex;
+    std::ofstream journal;
+    std::size_t journalRecords;
+    std::size_t snapshotEntries;
+
+    ADD_LOGGER(SnapshotStore)
+};
+
+} // namespace capabilities
+
+} // namespace joynr
+
+#endif // CAPABILITIESSNAPSHOTSTORE_H
@@ -19,7 +19,12 @@
 #ifndef CAPABILITIESSTORAGE_H
 #define CAPABILITIESSTORAGE_H
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/composite_key.hpp>
@@ -33,6 +38,7 @@
 
 #include <muesli/Traits.h>
 
+#include "joynr/ShardedCapabilitiesIndex.h"
 #include "joynr/types/DiscoveryEntry.h"
 
 namespace joynr
@@ -93,10 +99,30 @@ using CacheContainerIndices =
 
 using CachingContainer = bmi::multi_index_container<CachedDiscoveryEntry, CacheContainerIndices>;
 
+/**
+ * The multi index container is the authoritative store and must be guarded by the caller.
+ * Every entry is additionally published in a ShardedCapabilitiesIndex, the find* methods read
+ * only from this index and may be called concurrently with writers without holding the caller's
+ * lock, they only take the shared lock of the shard they read.
+ */
 template <typename C>
 class BaseStorage
 {
 public:
+    using Entry = typename C::value_type;
+    using EntryPtr = typename ShardedCapabilitiesIndex<Entry>::EntryPtr;
+
+    std::vector<EntryPtr> findByDomainAndInterface(const std::string& domain,
+                                                   const std::string& interface) const
+    {
+        return index.findByDomainAndInterface(domain, interface);
+    }
+
+    EntryPtr findByParticipantId(const std::string& participantId) const
+    {
+        return index.findByParticipantId(participantId);
+    }
+
     std::vector<DiscoveryEntry> lookupByDomainAndInterface(const std::string& domain,
                                                            const std::string& interface) const
     {
@@ -110,24 +136,33 @@ public:
 
     void removeByParticipantId(const std::string& participantId)
     {
-        auto& index = container.template get<tags::ParticipantId>();
-        auto it = index.find(participantId);
-        if (it != index.end()) {
-            index.erase(it);
+        auto& participantIdIndex = container.template get<tags::ParticipantId>();
+        auto it = participantIdIndex.find(participantId);
+        if (it != participantIdIndex.end()) {
+            participantIdIndex.erase(it);
+            index.remove(participantId);
         }
     }
 
     void clear()
     {
         container.clear();
+        index.clear();
     }
 
     template <typename Archive>
-    void serialize(Archive& archive)
+    void save(Archive& archive)
     {
         archive(container);
     }
 
+    template <typename Archive>
+    void load(Archive& archive)
+    {
+        archive(container);
+        rebuildIndex();
+    }
+
     auto begin()
     {
         return container.begin();
@@ -164,21 +199,41 @@ public:
     }
 
     /**
-     * @brief removes expired entries based on expiryDate
+     * @brief removes expired entries based on expiryDate, at most maxCount of them if maxCount
+     * is not 0
      * @return expired/removed entries
      */
-    std::vector<DiscoveryEntry> removeExpired()
+    std::vector<DiscoveryEntry> removeExpired(std::size_t maxCount = 0)
     {
-        auto& index = container.template get<tags::ExpiryDate>();
+        auto& expiryDateIndex = container.template get<tags::ExpiryDate>();
         auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
                            std::chrono::system_clock::now().time_since_epoch()).count();
-        auto last = index.lower_bound(now);
-        std::vector<DiscoveryEntry> removedEntries(index.begin(), last);
-        index.erase(index.begin(), last);
+        auto firstNotExpired = expiryDateIndex.lower_bound(now);
+        auto last = expiryDateIndex.begin();
+        for (std::size_t count = 0; last != firstNotExpired && (maxCount == 0 || count < maxCount);
+             ++count) {
+            ++last;
+        }
+        std::vector<DiscoveryEntry> removedEntries(expiryDateIndex.begin(), last);
+        expiryDateIndex.erase(expiryDateIndex.begin(), last);
+        for (const auto& removedEntry : removedEntries) {
+            index.remove(removedEntry.getParticipantId());
+        }
         return removedEntries;
     }
 
 protected:
+    void rebuildIndex()
+    {
+        index.clear();
+        std::vector<EntryPtr> entries;
+        entries.reserve(container.size());
+        for (const auto& entry : container) {
+            entries.push_back(std::make_shared<const Entry>(entry));
+        }
+        index.insert(entries.begin(), entries.end());
+    }
+
     template <typename FilterFun>
     std::vector<DiscoveryEntry> lookupByDomainAndInterfaceFiltered(const std::string& domain,
                                                                    const std::string& interface,
@@ -186,8 +241,8 @@ protected:
     {
         std::vector<DiscoveryEntry> result;
 
-        auto& index = container.template get<tags::DomainAndInterface>();
-        auto range = index.equal_range(std::tie(domain, interface));
+        auto& domainAndInterfaceIndex = container.template get<tags::DomainAndInterface>();
+        auto range = domainAndInterfaceIndex.equal_range(std::tie(domain, interface));
         std::copy_if(range.first, range.second, std::back_inserter(result), filterFun);
 
         return result;
@@ -199,9 +254,9 @@ protected:
     {
         boost::optional<DiscoveryEntry> result;
 
-        auto& index = container.template get<tags::ParticipantId>();
-        auto it = index.find(participantId);
-        if (it != index.end()) {
+        auto& participantIdIndex = container.template get<tags::ParticipantId>();
+        auto it = participantIdIndex.find(participantId);
+        if (it != participantIdIndex.end()) {
             if (filterFun(*it)) {
                 result = *it;
             }
@@ -219,6 +274,7 @@ protected:
     };
 
     C container;
+    ShardedCapabilitiesIndex<Entry> index;
 };
 
 class Storage : public BaseStorage<Container>
@@ -226,8 +282,8 @@ class Storage : public BaseStorage<Container>
 public:
     void insert(const DiscoveryEntry& entry)
     {
-        auto& index = container.get<tags::ParticipantId>();
-        auto insertResult = index.insert(entry);
+        auto& participantIdIndex = container.get<tags::ParticipantId>();
+        auto insertResult = participantIdIndex.insert(entry);
 
         // entry already existed
         if (!insertResult.second) {
@@ -235,9 +291,30 @@ public:
             auto existingIt = insertResult.first;
 
             // replace
-            bool replaceResult = index.replace(existingIt, entry);
+            bool replaceResult = participantIdIndex.replace(existingIt, entry);
             assert(replaceResult);
         }
+        index.insert(std::make_shared<const DiscoveryEntry>(entry));
+    }
+
+    /**
+     * Inserts all entries of the range, the index is updated once for the whole range.
+     */
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        auto& participantIdIndex = container.get<tags::ParticipantId>();
+        std::vector<EntryPtr> entries;
+        for (; first != last; ++first) {
+            const DiscoveryEntry& entry = *first;
+            auto insertResult = participantIdIndex.insert(entry);
+            if (!insertResult.second) {
+                bool replaceResult = participantIdIndex.replace(insertResult.first, entry);
+                assert(replaceResult);
+            }
+            entries.push_back(std::make_shared<const DiscoveryEntry>(entry));
+        }
+        index.insert(entries.begin(), entries.end());
     }
 };
 
@@ -261,11 +338,12 @@ public:
 
     void insert(const DiscoveryEntry& entry)
     {
-        auto& index = container.get<tags::ParticipantId>();
+        auto& participantIdIndex = container.get<tags::ParticipantId>();
 
         auto now = std::chrono::system_clock::now();
         CachedDiscoveryEntry cachedEntry(entry, now);
-        auto insertResult = index.insert(cachedEntry);
+        auto insertResult = participantIdIndex.insert(cachedEntry);
+        index.insert(std::make_shared<const CachedDiscoveryEntry>(cachedEntry));
 
         // entry already existed
         if (!insertResult.second) {
@@ -273,13 +351,14 @@ public:
             auto existingIt = insertResult.first;
 
             // replace
-            bool replaceResult = index.replace(existingIt, cachedEntry);
+            bool replaceResult = participantIdIndex.replace(existingIt, cachedEntry);
             assert(replaceResult);
 
             // rank to top
             auto sequencedIt = container.project<0>(existingIt);
             container.relocate(container.begin(), sequencedIt);
         } else if (container.size() > maxElementCount) {
+            index.remove(container.back().getParticipantId());
             container.pop_back();
         }
     }
@@ -299,6 +378,44 @@ public:
         return lookupByDomainAndInterfaceFiltered(domain, interface, filterByAge(maxAge));
     }
 
+    /**
+     * @brief variant of lookupCacheByParticipantId which only takes the shared lock of a shard of
+     * the index instead of requiring the caller's lock
+     */
+    EntryPtr findCacheByParticipantId(const std::string& participantId,
+                                      std::chrono::milliseconds maxAge) const
+    {
+        EntryPtr entry = index.findByParticipantId(participantId);
+        if (entry && !filterByAge(maxAge)(*entry)) {
+            return nullptr;
+        }
+        return entry;
+    }
+
+    /**
+     * @brief variant of lookupCacheByDomainAndInterface which only takes the shared lock of a
+     * shard of the index instead of requiring the caller's lock, additionally raises oldestAge to
+     * the age of the oldest returned entry
+     */
+    std::vector<EntryPtr> findCacheByDomainAndInterface(const std::string& domain,
+                                                        const std::string& interface,
+                                                        std::chrono::milliseconds maxAge,
+                                                        std::chrono::milliseconds& oldestAge) const
+    {
+        std::vector<EntryPtr> result;
+        auto now = std::chrono::system_clock::now();
+
+        for (auto& entry : index.findByDomainAndInterface(domain, interface)) {
+            auto age =
+                    std::chrono::duration_cast<std::chrono::milliseconds>(now - entry->timestamp);
+            if (age <= maxAge) {
+                oldestAge = std::max(oldestAge, age);
+                result.push_back(std::move(entry));
+            }
+        }
+        return result;
+    }
+
 private:
     std::size_t maxElementCount;
 };
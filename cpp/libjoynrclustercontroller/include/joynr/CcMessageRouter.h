@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "joynr/JoynrExport.h"
 #include "joynr/Logger.h"
@@ -111,6 +112,15 @@ public:
                     std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
                             onError = nullptr) final;
 
+    void addNextHops(const std::vector<std::string>& participantIds,
+                     const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+                     bool isGloballyVisible,
+                     const std::int64_t expiryDateMs,
+                     const bool isSticky,
+                     std::function<void()> onSuccess = nullptr,
+                     std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
+                             onError = nullptr) final;
+
     /*
      * Implement methods from RoutingAbstractProvider
      */
@@ -149,11 +159,56 @@ public:
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
 
+    void addNextHop(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::ChannelAddress& channelAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
+    void addNextHop(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::MqttAddress& mqttAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
+    void addNextHop(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::BrowserAddress& browserAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
+    void addNextHop(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::WebSocketAddress& webSocketAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
+    void addNextHop(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::WebSocketClientAddress& webSocketClientAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
     void removeNextHop(const std::string& participantId,
                        std::function<void()> onSuccess = nullptr,
                        std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
                                onError = nullptr) final;
 
+    void removeNextHops(const std::vector<std::string>& participantIds,
+                        std::function<void()> onSuccess = nullptr,
+                        std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
+                                onError = nullptr) final;
+
+    void removeNextHop(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
     void resolveNextHop(
             const std::string& participantId,
             std::function<void(const bool& resolved)> onSuccess,
@@ -226,7 +281,8 @@ private:
     void doAccessControlCheckOrScheduleMessage(
             std::shared_ptr<ImmutableMessage> message,
             std::shared_ptr<const system::RoutingTypes::Address> destAddress,
-            std::uint32_t tryCount = 0) final;
+            std::uint32_t tryCount = 0,
+            std::shared_ptr<CachedMessagingStub> cachedStub = nullptr) final;
     void queueMessage(std::shared_ptr<ImmutableMessage> message,
                       const ReadLocker& messageQueueRetryReadLock) final;
 
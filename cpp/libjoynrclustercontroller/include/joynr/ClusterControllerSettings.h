@@ -34,6 +34,8 @@ class JOYNR_EXPORT ClusterControllerSettings
 {
 public:
     static const std::string& SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS();
+    static const std::string& SETTING_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT();
+    static const std::string& SETTING_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS();
     static const std::string& SETTING_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCE_FILENAME();
     static const std::string& SETTING_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCY_ENABLED();
     static const std::string& SETTING_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME();
@@ -41,6 +43,7 @@ public:
     static const std::string& SETTING_PER_PARTICIPANTID_MESSAGE_QUEUE_LIMIT();
     static const std::string& SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT();
     static const std::string& SETTING_MESSAGE_QUEUE_LIMIT_BYTES();
+    static const std::string& SETTING_PER_CLIENT_MESSAGE_QUOTA_BYTES();
     static const std::string& SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES();
     static const std::string& SETTING_MQTT_CLIENT_ID_PREFIX();
     static const std::string& SETTING_MQTT_TLS_ENABLED();
@@ -57,8 +60,17 @@ public:
     static const std::string& SETTING_MULTICAST_RECEIVER_DIRECTORY_PERSISTENCE_FILENAME();
     static const std::string& SETTING_MULTICAST_RECEIVER_DIRECTORY_PERSISTENCY_ENABLED();
     static const std::string& SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS();
+    static const std::string& SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE();
+    static const std::string& SETTING_DISCOVERY_CACHE_MAX_STALENESS_MS();
+    static const std::string& SETTING_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT();
     static const std::string& SETTING_WS_TLS_PORT();
     static const std::string& SETTING_WS_PORT();
+    static const std::string& SETTING_UDS_PATH();
+    static const std::string& SETTING_WS_IO_THREADS();
+    static const std::string& SETTING_WS_MESSAGE_PROCESSING_THREADS();
+    static const std::string& SETTING_MQTT_INGRESS_QUEUE_SIZE();
+    static const std::string& SETTING_MQTT_INGRESS_WORKER_THREADS();
+    static const std::string& SETTING_MQTT_INGRESS_OVERFLOW_POLICY();
     static const std::string& SETTING_USE_ONLY_LDAS();
     static const std::string& SETTING_ACCESS_CONTROL_AUDIT();
 
@@ -70,6 +82,8 @@ public:
     static const std::string& SETTING_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED();
 
     static std::chrono::milliseconds DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS();
+    static std::uint32_t DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_JITTER_PERCENT();
+    static std::chrono::milliseconds DEFAULT_GLOBAL_CAPABILITIES_DIRECTORY_BATCH_WINDOW_MS();
     static const std::string& DEFAULT_CLUSTERCONTROLLER_SETTINGS_FILENAME();
     static const std::string& DEFAULT_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCE_FILENAME();
     static bool DEFAULT_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCY_ENABLED();
@@ -83,6 +97,14 @@ public:
     static const std::string& DEFAULT_MULTICAST_RECEIVER_DIRECTORY_PERSISTENCE_FILENAME();
     static bool DEFAULT_MULTICAST_RECEIVER_DIRECTORY_PERSISTENCY_ENABLED();
     static int DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS();
+    static std::uint32_t DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_BATCH_SIZE();
+    static std::int64_t DEFAULT_DISCOVERY_CACHE_MAX_STALENESS_MS();
+    static std::uint32_t DEFAULT_DISCOVERY_CACHE_REFRESH_AHEAD_PERCENT();
+    static std::uint32_t DEFAULT_WS_IO_THREADS();
+    static std::uint32_t DEFAULT_WS_MESSAGE_PROCESSING_THREADS();
+    static std::uint32_t DEFAULT_MQTT_INGRESS_QUEUE_SIZE();
+    static std::uint32_t DEFAULT_MQTT_INGRESS_WORKER_THREADS();
+    static const std::string& DEFAULT_MQTT_INGRESS_OVERFLOW_POLICY();
     static bool DEFAULT_ENABLE_ACCESS_CONTROLLER();
     static bool DEFAULT_USE_ONLY_LDAS();
     static bool DEFAULT_ACCESS_CONTROL_AUDIT();
@@ -90,6 +112,7 @@ public:
     static std::uint64_t DEFAULT_PER_PARTICIPANTID_MESSAGE_QUEUE_LIMIT();
     static std::uint64_t DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT();
     static std::uint64_t DEFAULT_MESSAGE_QUEUE_LIMIT_BYTES();
+    static std::uint64_t DEFAULT_PER_CLIENT_MESSAGE_QUOTA_BYTES();
     static std::uint64_t DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES();
     static bool DEFAULT_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED();
 
@@ -112,6 +135,39 @@ public:
     std::uint16_t getWsPort() const;
     void setWsPort(std::uint16_t port);
 
+    bool isUdsPathSet() const;
+    std::string getUdsPath() const;
+    void setUdsPath(const std::string& path);
+
+    /**
+     * @brief Number of threads serving the network I/O of the WebSocket servers.
+     */
+    std::uint32_t getWsIoThreads() const;
+    void setWsIoThreads(std::uint32_t numberOfThreads);
+
+    /**
+     * @brief Number of threads which parse, validate and route messages received by the
+     * WebSocket servers; messages of one connection are still processed in order.
+     */
+    std::uint32_t getWsMessageProcessingThreads() const;
+    void setWsMessageProcessingThreads(std::uint32_t numberOfThreads);
+
+    /**
+     * @brief Maximum number of messages received from the MQTT broker which wait for a worker
+     * thread; 0 routes messages synchronously on the mosquitto loop thread.
+     */
+    std::uint32_t getMqttIngressQueueSize() const;
+    void setMqttIngressQueueSize(std::uint32_t queueSize);
+
+    std::uint32_t getMqttIngressWorkerThreads() const;
+    void setMqttIngressWorkerThreads(std::uint32_t numberOfThreads);
+
+    /**
+     * @brief One of BLOCK, DROP_NEWEST or DROP_OLDEST, see MqttIngressOverflowPolicy
+     */
+    std::string getMqttIngressOverflowPolicy() const;
+    void setMqttIngressOverflowPolicy(const std::string& policy);
+
     bool isMqttClientIdPrefixSet() const;
     std::string getMqttClientIdPrefix() const;
     void setMqttClientIdPrefix(const std::string& mqttClientId);
@@ -164,6 +220,13 @@ public:
     std::uint64_t getMessageQueueLimitBytes() const;
     void setMessageQueueLimitBytes(std::uint64_t limitBytes);
 
+    /**
+     * @brief Maximum number of bytes a single local WebSocket client may have pending in the
+     * cluster controller; messages beyond the quota are dropped. 0 disables the quota.
+     */
+    std::uint64_t getPerClientMessageQuotaBytes() const;
+    void setPerClientMessageQuotaBytes(std::uint64_t quotaBytes);
+
     std::uint64_t getTransportNotAvailableQueueLimitBytes() const;
     void setTransportNotAvailableQueueLimitBytes(std::uint64_t limitBytes);
 
@@ -190,10 +253,47 @@ public:
     int getPurgeExpiredDiscoveryEntriesIntervalMs() const;
     void setPurgeExpiredDiscoveryEntriesIntervalMs(int purgeExpiredEntriesIntervalMs);
 
+    /**
+     * @brief Maximum number of expired discovery entries removed at once. Remaining expired
+     * entries are removed in further batches without waiting for the next purge interval.
+     * 0 removes all expired entries at once.
+     */
+    std::uint32_t getPurgeExpiredDiscoveryEntriesBatchSize() const;
+    void setPurgeExpiredDiscoveryEntriesBatchSize(std::uint32_t batchSize);
+
+    /**
+     * @brief How long cached global discovery entries may be served beyond the cacheMaxAge of
+     * a lookup while they are refreshed in the background. 0 disables serving stale entries.
+     */
+    std::chrono::milliseconds getDiscoveryCacheMaxStalenessMs() const;
+    void setDiscoveryCacheMaxStalenessMs(std::chrono::milliseconds maxStalenessMs);
+
+    /**
+     * @brief Cached global discovery entries older than this percentage of the cacheMaxAge of
+     * a lookup are refreshed in the background. 0 disables refresh-ahead.
+     */
+    std::uint32_t getDiscoveryCacheRefreshAheadPercent() const;
+    void setDiscoveryCacheRefreshAheadPercent(std::uint32_t refreshAheadPercent);
+
     std::chrono::milliseconds getCapabilitiesFreshnessUpdateIntervalMs() const;
     void setCapabilitiesFreshnessUpdateIntervalMs(
             std::chrono::milliseconds capabilitiesFreshnessUpdateIntervalMs);
 
+    /**
+     * @brief Each freshness update interval is randomly shortened or extended by up to this
+     * percentage, so that cluster controllers started at the same time do not touch the global
+     * capabilities directory in lockstep. 0 disables the jitter.
+     */
+    std::uint32_t getCapabilitiesFreshnessUpdateJitterPercent() const;
+    void setCapabilitiesFreshnessUpdateJitterPercent(std::uint32_t jitterPercent);
+
+    /**
+     * @brief Time for which add and remove requests to the global capabilities directory are
+     * collected before they are sent as one batch. 0 sends every request immediately.
+     */
+    std::chrono::milliseconds getGlobalCapabilitiesDirectoryBatchWindowMs() const;
+    void setGlobalCapabilitiesDirectoryBatchWindowMs(std::chrono::milliseconds batchWindowMs);
+
     void setAclEntriesDirectory(const std::string& directoryPath);
     std::string getAclEntriesDirectory() const;
 
@@ -19,19 +19,26 @@
 #ifndef LOCALCAPABILITIESDIRECTORY_H
 #define LOCALCAPABILITIESDIRECTORY_H
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <random>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <boost/asio/steady_timer.hpp>
 
+#include "joynr/CapabilitiesSnapshotStore.h"
 #include "joynr/CapabilitiesStorage.h"
 #include "joynr/ClusterControllerDirectories.h"
 #include "joynr/ILocalCapabilitiesCallback.h"
+#include "joynr/ILocalParticipantLookup.h"
 #include "joynr/InterfaceAddress.h"
 #include "joynr/JoynrClusterControllerExport.h"
 #include "joynr/Logger.h"
@@ -74,9 +81,12 @@ class IMessageRouter;
 class JOYNRCLUSTERCONTROLLER_EXPORT LocalCapabilitiesDirectory
         : public joynr::system::DiscoveryAbstractProvider,
           public joynr::system::ProviderReregistrationControllerProvider,
+          public joynr::ILocalParticipantLookup,
           public std::enable_shared_from_this<LocalCapabilitiesDirectory>
 {
 public:
+    using DiscoveryEntryPtr = std::shared_ptr<const types::DiscoveryEntry>;
+
     // TODO: change shared_ptr to unique_ptr once JoynrClusterControllerRuntime is refactored
     LocalCapabilitiesDirectory(ClusterControllerSettings& messagingSettings,
                                std::shared_ptr<ICapabilitiesClient> capabilitiesClientPtr,
@@ -121,10 +131,11 @@ public:
     /*
       * Returns a list of locally cached capabilitiy entries. This method is used
       * when capabilities from the global directory are received, to check if a new
-      * local provider was registered in the meantime.
+      * local provider was registered in the meantime. The entries are shared with the cache
+      * and must not be modified.
       */
-    std::vector<types::DiscoveryEntry> getCachedLocalCapabilities(const std::string& participantId);
-    std::vector<types::DiscoveryEntry> getCachedLocalCapabilities(
+    std::vector<DiscoveryEntryPtr> getCachedLocalCapabilities(const std::string& participantId);
+    std::vector<DiscoveryEntryPtr> getCachedLocalCapabilities(
             const std::vector<InterfaceAddress>& interfaceAddress);
     /*
      * removes all discovery entries
@@ -171,6 +182,23 @@ public:
                 std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
             override;
 
+    // inherited method from joynr::system::DiscoveryProvider
+    void add(const std::vector<joynr::types::DiscoveryEntry>& discoveryEntries,
+             const bool& awaitGlobalRegistration,
+             std::function<void()> onSuccess,
+             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+            override;
+    // inherited method from joynr::system::DiscoveryProvider
+    void remove(const std::vector<std::string>& participantIds,
+                std::function<void()> onSuccess,
+                std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+            override;
+
+    // inherited method from joynr::ILocalParticipantLookup
+    // only providers registered at this cluster controller are known locally
+    boost::optional<types::DiscoveryEntryWithMetaInfo> lookupLocally(
+            const std::string& participantId) override;
+
     /*
      * Objects that wish to receive provider register/unregister events can attach
      * themselves as observers
@@ -188,12 +216,14 @@ public:
             std::shared_ptr<IProviderRegistrationObserver> observer);
 
     /*
-     * Persist the content of the local capabilities directory to a file.
+     * Persist the content of the local capabilities directory as a new snapshot.
+     * Single changes are journaled as they happen, so this is only needed to compact the journal.
      */
     void updatePersistedFile();
 
     /*
-     * Load persisted capabilities from the specified file.
+     * Load persisted capabilities from the snapshot and journal. A JSON file written by earlier
+     * versions is imported once if no snapshot exists.
      */
     void loadPersistedFile();
 
@@ -224,6 +254,28 @@ public:
 
     std::vector<types::DiscoveryEntry> getCachedGlobalDiscoveryEntries() const;
 
+    /*
+     * Number of lookups by domains and interface sent to the global capabilities directory
+     */
+    std::uint64_t getNumberOfGlobalLookups() const;
+
+    /*
+     * Number of lookups by domains and interface which did not cause a request to the global
+     * capabilities directory because an identical request was already in flight
+     */
+    std::uint64_t getNumberOfCoalescedGlobalLookups() const;
+
+    /*
+     * Number of lookups served with globalLookupCache entries older than the requested
+     * cacheMaxAge, see ClusterControllerSettings::getDiscoveryCacheMaxStalenessMs
+     */
+    std::uint64_t getNumberOfStaleGlobalLookupCacheHits() const;
+
+    /*
+     * Number of background lookups sent to refresh the globalLookupCache
+     */
+    std::uint64_t getNumberOfGlobalLookupCacheRefreshes() const;
+
 private:
     DISALLOW_COPY_AND_ASSIGN(LocalCapabilitiesDirectory);
     ClusterControllerSettings& clusterControllerSettings; // to retrieve info about persistency
@@ -231,34 +283,46 @@ private:
     types::GlobalDiscoveryEntry toGlobalDiscoveryEntry(
             const types::DiscoveryEntry& discoveryEntry) const;
     void capabilitiesReceived(const std::vector<types::GlobalDiscoveryEntry>& results,
-                              std::vector<types::DiscoveryEntry>&& localEntries,
+                              std::vector<DiscoveryEntryPtr>&& localEntries,
                               std::shared_ptr<ILocalCapabilitiesCallback> callback,
                               joynr::types::DiscoveryScope::Enum discoveryScope);
+    std::vector<types::DiscoveryEntryWithMetaInfo> registerGlobalCapabilities(
+            const std::vector<types::GlobalDiscoveryEntry>& results);
+    void globalCapabilitiesReceived(std::vector<types::DiscoveryEntryWithMetaInfo> globalEntries,
+                                    std::vector<DiscoveryEntryPtr>&& localEntries,
+                                    std::shared_ptr<ILocalCapabilitiesCallback> callback,
+                                    joynr::types::DiscoveryScope::Enum discoveryScope);
 
     bool getLocalAndCachedCapabilities(const std::vector<InterfaceAddress>& interfaceAddress,
                                        const joynr::types::DiscoveryQos& discoveryQos,
-                                       std::shared_ptr<ILocalCapabilitiesCallback> callback);
+                                       std::shared_ptr<ILocalCapabilitiesCallback> callback,
+                                       std::chrono::milliseconds& oldestCachedEntryAge);
     bool getLocalAndCachedCapabilities(const std::string& participantId,
                                        const joynr::types::DiscoveryQos& discoveryQos,
                                        std::shared_ptr<ILocalCapabilitiesCallback> callback);
     bool callReceiverIfPossible(joynr::types::DiscoveryScope::Enum& scope,
-                                std::vector<types::DiscoveryEntry>&& localCapabilities,
-                                std::vector<types::DiscoveryEntry>&& globalCapabilities,
+                                std::vector<DiscoveryEntryPtr>&& localCapabilities,
+                                std::vector<DiscoveryEntryPtr>&& globalCapabilities,
                                 std::shared_ptr<ILocalCapabilitiesCallback> callback);
 
     void insertInLocallyRegisteredCapabilitiesCache(const types::DiscoveryEntry& entry);
     void insertInGlobalLookupCache(const types::DiscoveryEntry& entry);
 
-    std::vector<types::DiscoveryEntry> searchCache(
+    std::vector<DiscoveryEntryPtr> searchCache(
             const std::vector<InterfaceAddress>& interfaceAddress,
             std::chrono::milliseconds maxCacheAge,
             bool localEntries);
-    boost::optional<types::DiscoveryEntry> searchCache(const std::string& participantId,
-                                                       std::chrono::milliseconds maxCacheAge);
+    DiscoveryEntryPtr searchCache(const std::string& participantId,
+                                  std::chrono::milliseconds maxCacheAge);
+    std::vector<DiscoveryEntryPtr> searchGlobalCache(
+            const std::vector<InterfaceAddress>& interfaceAddresses,
+            std::chrono::milliseconds maxCacheAge,
+            std::chrono::milliseconds& oldestCachedEntryAge);
 
     ADD_LOGGER(LocalCapabilitiesDirectory)
     std::shared_ptr<ICapabilitiesClient> capabilitiesClient;
     std::string localAddress;
+    // serializes modifications of the storages, lookups only take the shard locks of their index
     mutable std::mutex cacheLock;
     std::mutex pendingLookupsLock;
 
@@ -271,18 +335,42 @@ private:
     std::unordered_map<InterfaceAddress, std::vector<std::shared_ptr<ILocalCapabilitiesCallback>>>
             pendingLookups;
 
+    // a caller waiting for the result of a global lookup by domains and interface
+    struct GlobalLookupWaiter
+    {
+        std::vector<InterfaceAddress> interfaceAddresses;
+        std::shared_ptr<ILocalCapabilitiesCallback> callback;
+        joynr::types::DiscoveryQos discoveryQos;
+    };
+    // sorted domains and interface name of a global lookup
+    using GlobalLookupKey = std::pair<std::vector<std::string>, std::string>;
+
+    std::mutex inFlightGlobalLookupsLock;
+    std::map<GlobalLookupKey, std::vector<GlobalLookupWaiter>> inFlightGlobalLookups;
+    std::atomic<std::uint64_t> globalLookupCount;
+    std::atomic<std::uint64_t> coalescedGlobalLookupCount;
+
+    const std::chrono::milliseconds discoveryCacheMaxStaleness;
+    const std::uint32_t discoveryCacheRefreshAheadPercent;
+    std::atomic<std::uint64_t> staleGlobalLookupCacheHitCount;
+    std::atomic<std::uint64_t> globalLookupCacheRefreshCount;
+
     std::weak_ptr<IAccessController> accessController;
 
     boost::asio::steady_timer checkExpiredDiscoveryEntriesTimer;
     const bool isLocalCapabilitiesDirectoryPersistencyEnabled;
+    std::unique_ptr<capabilities::SnapshotStore> snapshotStore;
 
-    void scheduleCleanupTimer();
+    void scheduleCleanupTimer(bool expiredEntriesRemaining = false);
     void checkExpiredDiscoveryEntries(const boost::system::error_code& errorCode);
     std::string joinToString(const std::vector<types::DiscoveryEntry>& discoveryEntries) const;
     void remove(const types::DiscoveryEntry& discoveryEntry);
     boost::asio::steady_timer freshnessUpdateTimer;
     std::string clusterControllerId;
+    const std::uint32_t freshnessUpdateJitterPercent;
+    std::mt19937 freshnessUpdateJitterEngine;
     void scheduleFreshnessUpdate();
+    std::chrono::milliseconds getNextFreshnessUpdateInterval();
     void sendAndRescheduleFreshnessUpdate(const boost::system::error_code& timerError);
     void informObserversOnAdd(const types::DiscoveryEntry& discoveryEntry);
     void informObserversOnRemove(const types::DiscoveryEntry& discoveryEntry);
@@ -294,17 +382,36 @@ private:
     void callbackCalled(const std::vector<InterfaceAddress>& interfaceAddresses,
                         const std::shared_ptr<ILocalCapabilitiesCallback>& callback);
     void callPendingLookups(const InterfaceAddress& interfaceAddress);
+    void sendGlobalLookup(const GlobalLookupKey& key,
+                          const std::vector<std::string>& domains,
+                          std::int64_t discoveryTimeout);
+    bool isGlobalLookupCacheRefreshRequired(std::chrono::milliseconds oldestCachedEntryAge,
+                                            const joynr::types::DiscoveryQos& discoveryQos);
+    void refreshGlobalLookupCache(const GlobalLookupKey& key, std::int64_t discoveryTimeout);
+    std::vector<GlobalLookupWaiter> takeGlobalLookupWaiters(const GlobalLookupKey& key);
+    void globalLookupSucceeded(const GlobalLookupKey& key,
+                               const std::vector<types::GlobalDiscoveryEntry>& capabilities);
+    void globalLookupFailed(const GlobalLookupKey& key,
+                            const exceptions::JoynrRuntimeException& error);
     bool isGlobal(const types::DiscoveryEntry& discoveryEntry) const;
 
     void addInternal(const joynr::types::DiscoveryEntry& entry,
                      bool awaitGlobalRegistration,
                      std::function<void()> onSuccess,
                      std::function<void(const exceptions::ProviderRuntimeException&)> onError);
+    void addInternal(const std::vector<types::DiscoveryEntry>& entries,
+                     bool awaitGlobalRegistration,
+                     std::function<void()> onSuccess,
+                     std::function<void(const exceptions::ProviderRuntimeException&)> onError);
+    void insertInLocalCaches(const std::vector<types::DiscoveryEntry>& entries);
+    // must be called with cacheLock held, so the journal sees changes in the order they are made
+    void persistAdded(const std::vector<types::DiscoveryEntry>& entries);
+    void persistRemoved(const std::vector<std::string>& participantIds);
+    void writeSnapshot();
     bool hasProviderPermission(const types::DiscoveryEntry& discoveryEntry);
     std::size_t countGlobalCapabilities() const;
 
-    std::vector<types::DiscoveryEntry> optionalToVector(
-            boost::optional<types::DiscoveryEntry> optionalEntry);
+    std::vector<DiscoveryEntryPtr> pointerToVector(DiscoveryEntryPtr entry);
     std::vector<types::DiscoveryEntryWithMetaInfo> filterDuplicates(
             std::vector<types::DiscoveryEntryWithMetaInfo>&& globalCapabilitiesWithMetaInfo,
             std::vector<types::DiscoveryEntryWithMetaInfo>&& localCapabilitiesWithMetaInfo);
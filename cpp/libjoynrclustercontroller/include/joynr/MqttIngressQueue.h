@@ -0,0 +1,135 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef MQTTINGRESSQUEUE_H
+#define MQTTINGRESSQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <smrf/ByteVector.h>
+
+#include "JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief What happens to a message received from the broker while the ingress queue is full
+ */
+struct JOYNRCLUSTERCONTROLLER_EXPORT MqttIngressOverflowPolicy
+{
+    enum class Enum {
+        /*! the mosquitto loop thread waits until a worker has taken a message */
+        BLOCK = 0,
+        /*! the received message is dropped */
+        DROP_NEWEST = 1,
+        /*! the oldest queued message is dropped to make room for the received one */
+        DROP_OLDEST = 2
+    };
+
+    static std::string getLiteral(const MqttIngressOverflowPolicy::Enum& value);
+    static MqttIngressOverflowPolicy::Enum getEnum(const std::string& policyString);
+};
+
+/**
+ * @brief Counters of an MqttIngressQueue, all counted since construction
+ */
+struct MqttIngressQueueStatistics
+{
+    std::uint64_t received;
+    std::uint64_t processed;
+    std::uint64_t dropped;
+    /*! number of messages for which the mosquitto loop thread had to wait for a free slot */
+    std::uint64_t blocked;
+    std::size_t queued;
+    std::size_t maxQueued;
+};
+
+/**
+ * @brief Decouples the mosquitto loop thread from deserializing and routing received messages.
+ *
+ * Messages are pushed by the mosquitto loop thread and passed to the consumer by a pool of
+ * worker threads, so that keep-alives and acknowledgements of the broker connection are not
+ * delayed by routing. The queue holds at most capacity messages; the overflow policy decides
+ * what happens to messages received while it is full. Messages are passed to the consumer in the
+ * order they were received only if a single worker is used, which is the default; more workers
+ * take messages from the same queue and route them concurrently.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT MqttIngressQueue
+{
+public:
+    MqttIngressQueue(std::size_t capacity,
+                     std::size_t numberOfWorkers,
+                     MqttIngressOverflowPolicy::Enum overflowPolicy,
+                     std::function<void(smrf::ByteVector&&)> consumer);
+
+    ~MqttIngressQueue();
+
+    void start();
+
+    /**
+     * @brief Stops the workers. Messages which have not been taken by a worker are discarded
+     * and producers waiting for a free slot return.
+     */
+    void stop();
+
+    void push(smrf::ByteVector&& message);
+
+    MqttIngressQueueStatistics getStatistics() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MqttIngressQueue);
+
+    void work();
+    void countDropped();
+
+    const std::size_t capacity;
+    const std::size_t numberOfWorkers;
+    const MqttIngressOverflowPolicy::Enum overflowPolicy;
+    std::function<void(smrf::ByteVector&&)> consumer;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<smrf::ByteVector> queue;
+    std::size_t maxQueued;
+    bool isRunning;
+    std::vector<std::thread> workers;
+
+    std::atomic<std::uint64_t> received;
+    std::atomic<std::uint64_t> processed;
+    std::atomic<std::uint64_t> dropped;
+    std::atomic<std::uint64_t> blocked;
+
+    ADD_LOGGER(MqttIngressQueue)
+};
+
+} // namespace joynr
+
+#endif // MQTTINGRESSQUEUE_H
@@ -65,12 +65,17 @@ public:
     void registerMulticastSubscription(const std::string& multicastId) override;
     void unregisterMulticastSubscription(const std::string& multicastId) override;
 
+    /**
+     * @brief Handles a single serialized message or a batch of messages, see MessageBatch
+     */
     void onMessageReceived(smrf::ByteVector&& rawMessage) override;
 
 private:
     DISALLOW_COPY_AND_ASSIGN(MqttMessagingSkeleton);
     ADD_LOGGER(MqttMessagingSkeleton)
 
+    void onSingleMessageReceived(smrf::ByteVector&& rawMessage);
+
     std::weak_ptr<IMessageRouter> messageRouter;
     std::shared_ptr<MqttReceiver> mqttReceiver;
 
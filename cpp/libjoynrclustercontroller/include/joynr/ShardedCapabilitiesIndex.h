@@ -0,0 +1,286 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHARDEDCAPABILITIESINDEX_H
+#define SHARDEDCAPABILITIESINDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "joynr/ReadWriteLock.h"
+
+namespace joynr
+{
+
+namespace capabilities
+{
+
+/**
+ * @brief Read optimized index of discovery entries by participantId and by domain and interface.
+ *
+ * Entries are immutable and shared with the readers, which receive pointers instead of copies.
+ * Both indices are split into shards by the hash of their key, every shard is guarded by its
+ * own read-write lock. Readers of different shards never contend, and readers of the same shard
+ * only wait for a writer of that shard, which changes a single map entry in place.
+ *
+ * Writers must be serialized by the caller since an update touches a participantId shard and a
+ * domain and interface shard one after the other.
+ */
+template <typename Entry>
+class ShardedCapabilitiesIndex
+{
+public:
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    static constexpr std::size_t DEFAULT_SHARD_COUNT = 16;
+
+    explicit ShardedCapabilitiesIndex(std::size_t shardCount = DEFAULT_SHARD_COUNT)
+            : participantIdShards(std::max(shardCount, static_cast<std::size_t>(1))),
+              domainAndInterfaceShards(std::max(shardCount, static_cast<std::size_t>(1))),
+              entryCount(0)
+    {
+    }
+
+    ShardedCapabilitiesIndex(const ShardedCapabilitiesIndex& other)
+            : participantIdShards(other.participantIdShards.size()),
+              domainAndInterfaceShards(other.domainAndInterfaceShards.size()),
+              entryCount(other.entryCount.load())
+    {
+        for (std::size_t i = 0; i < participantIdShards.size(); ++i) {
+            ReadLocker lock(other.participantIdShards[i].lock);
+            participantIdShards[i].map = other.participantIdShards[i].map;
+        }
+        for (std::size_t i = 0; i < domainAndInterfaceShards.size(); ++i) {
+            ReadLocker lock(other.domainAndInterfaceShards[i].lock);
+            domainAndInterfaceShards[i].map = other.domainAndInterfaceShards[i].map;
+        }
+    }
+
+    ShardedCapabilitiesIndex& operator=(const ShardedCapabilitiesIndex& other) = delete;
+
+    EntryPtr findByParticipantId(const std::string& participantId) const
+    {
+        const ParticipantIdShard& shard = participantIdShards[participantIdShardOf(participantId)];
+        ReadLocker lock(shard.lock);
+        auto it = shard.map.find(participantId);
+        return it == shard.map.cend() ? nullptr : it->second;
+    }
+
+    std::vector<EntryPtr> findByDomainAndInterface(const std::string& domain,
+                                                   const std::string& interface) const
+    {
+        DomainAndInterfaceKey key(domain, interface);
+        const DomainAndInterfaceShard& shard =
+                domainAndInterfaceShards[domainAndInterfaceShardOf(key)];
+        ReadLocker lock(shard.lock);
+        auto it = shard.map.find(key);
+        return it == shard.map.cend() ? std::vector<EntryPtr>() : it->second;
+    }
+
+    std::size_t size() const
+    {
+        return entryCount;
+    }
+
+    /**
+     * @brief adds the entry, an entry with the same participantId is replaced
+     */
+    void insert(EntryPtr entry)
+    {
+        EntryPtr existing;
+        {
+            ParticipantIdShard& shard =
+                    participantIdShards[participantIdShardOf(entry->getParticipantId())];
+            WriteLocker lock(shard.lock);
+            EntryPtr& slot = shard.map[entry->getParticipantId()];
+            existing = std::move(slot);
+            slot = entry;
+        }
+        if (existing) {
+            removeFromDomainAndInterfaceShard(existing);
+        } else {
+            ++entryCount;
+        }
+
+        DomainAndInterfaceKey key(entry->getDomain(), entry->getInterfaceName());
+        DomainAndInterfaceShard& shard = domainAndInterfaceShards[domainAndInterfaceShardOf(key)];
+        WriteLocker lock(shard.lock);
+        shard.map[std::move(key)].push_back(std::move(entry));
+    }
+
+    /**
+     * @brief adds all entries of the range, every affected shard is locked once
+     *
+     * Entries with the same participantId as an existing entry or a preceding entry of the
+     * range replace that entry.
+     */
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        std::vector<std::vector<EntryPtr>> participantIdShardEntries(participantIdShards.size());
+        for (; first != last; ++first) {
+            const EntryPtr& entry = *first;
+            participantIdShardEntries[participantIdShardOf(entry->getParticipantId())].push_back(
+                    entry);
+        }
+
+        std::vector<std::vector<EntryPtr>> addedEntries(domainAndInterfaceShards.size());
+        std::vector<std::vector<EntryPtr>> replacedEntries(domainAndInterfaceShards.size());
+        for (std::size_t i = 0; i < participantIdShards.size(); ++i) {
+            std::vector<EntryPtr>& entries = participantIdShardEntries[i];
+            if (entries.empty()) {
+                continue;
+            }
+            ParticipantIdShard& shard = participantIdShards[i];
+            WriteLocker lock(shard.lock);
+            shard.map.reserve(shard.map.size() + entries.size());
+            for (EntryPtr& entry : entries) {
+                EntryPtr& slot = shard.map[entry->getParticipantId()];
+                if (slot) {
+                    replacedEntries[domainAndInterfaceShardOf(slot)].push_back(std::move(slot));
+                } else {
+                    ++entryCount;
+                }
+                slot = entry;
+                addedEntries[domainAndInterfaceShardOf(entry)].push_back(std::move(entry));
+            }
+        }
+
+        for (std::size_t i = 0; i < domainAndInterfaceShards.size(); ++i) {
+            if (addedEntries[i].empty() && replacedEntries[i].empty()) {
+                continue;
+            }
+            DomainAndInterfaceShard& shard = domainAndInterfaceShards[i];
+            WriteLocker lock(shard.lock);
+            // entries replaced within the range are added first and removed afterwards
+            for (EntryPtr& entry : addedEntries[i]) {
+                DomainAndInterfaceKey key(entry->getDomain(), entry->getInterfaceName());
+                shard.map[std::move(key)].push_back(std::move(entry));
+            }
+            for (const EntryPtr& entry : replacedEntries[i]) {
+                eraseFromShard(shard, entry);
+            }
+        }
+    }
+
+    void remove(const std::string& participantId)
+    {
+        EntryPtr existing;
+        {
+            ParticipantIdShard& shard = participantIdShards[participantIdShardOf(participantId)];
+            WriteLocker lock(shard.lock);
+            auto it = shard.map.find(participantId);
+            if (it == shard.map.end()) {
+                return;
+            }
+            existing = std::move(it->second);
+            shard.map.erase(it);
+        }
+        removeFromDomainAndInterfaceShard(existing);
+        --entryCount;
+    }
+
+    void clear()
+    {
+        for (ParticipantIdShard& shard : participantIdShards) {
+            WriteLocker lock(shard.lock);
+            shard.map.clear();
+        }
+        for (DomainAndInterfaceShard& shard : domainAndInterfaceShards) {
+            WriteLocker lock(shard.lock);
+            shard.map.clear();
+        }
+        entryCount = 0;
+    }
+
+private:
+    using ParticipantIdMap = std::unordered_map<std::string, EntryPtr>;
+    using DomainAndInterfaceKey = std::pair<std::string, std::string>;
+    using DomainAndInterfaceMap = std::unordered_map<DomainAndInterfaceKey,
+                                                     std::vector<EntryPtr>,
+                                                     boost::hash<DomainAndInterfaceKey>>;
+
+    template <typename Map>
+    struct Shard
+    {
+        mutable ReadWriteLock lock;
+        Map map;
+    };
+    using ParticipantIdShard = Shard<ParticipantIdMap>;
+    using DomainAndInterfaceShard = Shard<DomainAndInterfaceMap>;
+
+    std::size_t participantIdShardOf(const std::string& participantId) const
+    {
+        return std::hash<std::string>()(participantId) % participantIdShards.size();
+    }
+
+    std::size_t domainAndInterfaceShardOf(const DomainAndInterfaceKey& key) const
+    {
+        return boost::hash<DomainAndInterfaceKey>()(key) % domainAndInterfaceShards.size();
+    }
+
+    std::size_t domainAndInterfaceShardOf(const EntryPtr& entry) const
+    {
+        return domainAndInterfaceShardOf(
+                DomainAndInterfaceKey(entry->getDomain(), entry->getInterfaceName()));
+    }
+
+    void removeFromDomainAndInterfaceShard(const EntryPtr& entry)
+    {
+        DomainAndInterfaceShard& shard = domainAndInterfaceShards[domainAndInterfaceShardOf(entry)];
+        WriteLocker lock(shard.lock);
+        eraseFromShard(shard, entry);
+    }
+
+    // the caller holds the write lock of the shard
+    static void eraseFromShard(DomainAndInterfaceShard& shard, const EntryPtr& entry)
+    {
+        DomainAndInterfaceKey key(entry->getDomain(), entry->getInterfaceName());
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return;
+        }
+        std::vector<EntryPtr>& entries = it->second;
+        entries.erase(std::remove(entries.begin(), entries.end(), entry), entries.end());
+        if (entries.empty()) {
+            shard.map.erase(it);
+        }
+    }
+
+    std::vector<ParticipantIdShard> participantIdShards;
+    std::vector<DomainAndInterfaceShard> domainAndInterfaceShards;
+    std::atomic<std::size_t> entryCount;
+};
+
+template <typename Entry>
+constexpr std::size_t ShardedCapabilitiesIndex<Entry>::DEFAULT_SHARD_COUNT;
+
+} // namespace capabilities
+
+} // namespace joynr
+
+#endif // SHARDEDCAPABILITIESINDEX_H
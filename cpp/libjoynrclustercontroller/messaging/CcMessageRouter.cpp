@@ -62,13 +62,15 @@ public:
             std::shared_ptr<ImmutableMessage> message,
             std::shared_ptr<const joynr::system::RoutingTypes::Address> destination,
             bool aclAudit,
-            std::uint32_t tryCount);
+            std::uint32_t tryCount,
+            std::shared_ptr<CachedMessagingStub> cachedStub);
 
     void hasConsumerPermission(IAccessController::Enum hasPermission);
 
     std::weak_ptr<CcMessageRouter> owningMessageRouter;
     std::shared_ptr<ImmutableMessage> message;
     std::shared_ptr<const joynr::system::RoutingTypes::Address> destination;
+    std::shared_ptr<CachedMessagingStub> cachedStub;
 
 private:
     const bool aclAudit;
@@ -308,7 +310,8 @@ void CcMessageRouter::sendQueuedMessages(
 void CcMessageRouter::doAccessControlCheckOrScheduleMessage(
         std::shared_ptr<ImmutableMessage> message,
         std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress,
-        std::uint32_t tryCount)
+        std::uint32_t tryCount,
+        std::shared_ptr<CachedMessagingStub> cachedStub)
 {
     if (auto gotAccessController = accessController.lock()) {
         // Access control checks are asynchronous, callback will send message
@@ -318,11 +321,16 @@ void CcMessageRouter::doAccessControlCheckOrScheduleMessage(
                 message,
                 destAddress,
                 clusterControllerSettings.aclAudit(),
-                tryCount);
+                tryCount,
+                cachedStub);
         gotAccessController->hasConsumerPermission(message, callback);
     } else {
         // If this point is reached, the message can be sent without delay
-        scheduleMessage(message, destAddress, tryCount);
+        scheduleMessage(message,
+                        destAddress,
+                        tryCount,
+                        std::chrono::milliseconds(0),
+                        std::move(cachedStub));
     }
 }
 
@@ -344,7 +352,7 @@ void CcMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> message,
     registerGlobalRoutingEntryIfRequired(*message);
 
     JOYNR_LOG_TRACE(logger(), "Route message with Id {}", message->getId());
-    AbstractMessageRouter::AddressUnorderedSet destAddresses;
+    AbstractMessageRouter::AddressUnorderedMap destAddresses;
     {
         ReadLocker lock(messageQueueRetryLock);
         // search for the destination addresses
@@ -385,8 +393,9 @@ void CcMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> message,
         }
     }
 
-    for (std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress : destAddresses) {
-        doAccessControlCheckOrScheduleMessage(message, destAddress, tryCount);
+    for (const auto& destination : destAddresses) {
+        doAccessControlCheckOrScheduleMessage(
+                message, destination.first, tryCount, destination.second);
     }
 }
 
@@ -479,6 +488,41 @@ void CcMessageRouter::removeNextHop(
     }
 }
 
+void CcMessageRouter::removeNextHops(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    {
+        WriteLocker lock(routingTableLock);
+        for (const std::string& participantId : participantIds) {
+            routingTable.remove(participantId);
+        }
+    }
+
+    if (!saveRoutingTable()) {
+        if (onError) {
+            onError(exceptions::ProviderRuntimeException(
+                    "unable to persist the routing table after removing " +
+                    std::to_string(participantIds.size()) + " next hops"));
+        }
+        return;
+    }
+
+    if (onSuccess) {
+        onSuccess();
+    }
+}
+
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::removeNextHop(
+        const std::vector<std::string>& participantIds,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    removeNextHops(participantIds, std::move(onSuccess), std::move(onError));
+}
+
 void CcMessageRouter::addNextHop(
         const std::string& participantId,
         const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
@@ -499,6 +543,36 @@ void CcMessageRouter::addNextHop(
     }
 }
 
+void CcMessageRouter::addNextHops(
+        const std::vector<std::string>& participantIds,
+        const std::shared_ptr<const joynr::system::RoutingTypes::Address>& address,
+        bool isGloballyVisible,
+        const std::int64_t expiryDateMs,
+        const bool isSticky,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    assert(address);
+    WriteLocker lock(messageQueueRetryLock);
+    const bool isPersisted = addToRoutingTable(
+            participantIds, isGloballyVisible, address, expiryDateMs, isSticky);
+    for (const std::string& participantId : participantIds) {
+        sendQueuedMessages(participantId, address, lock);
+    }
+    lock.unlock();
+    if (!isPersisted) {
+        if (onError) {
+            onError(exceptions::ProviderRuntimeException(
+                    "unable to persist the routing table after adding " +
+                    std::to_string(participantIds.size()) + " next hops"));
+        }
+        return;
+    }
+    if (onSuccess) {
+        onSuccess();
+    }
+}
+
 // inherited from joynr::system::RoutingProvider
 void CcMessageRouter::addNextHop(
         const std::string& participantId,
@@ -603,6 +677,110 @@ void CcMessageRouter::addNextHop(
                std::move(onSuccess));
 }
 
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::vector<std::string>& participantIds,
+        const system::RoutingTypes::ChannelAddress& channelAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::ChannelAddress>(
+            channelAddress);
+    addNextHops(participantIds,
+                std::move(address),
+                isGloballyVisible,
+                expiryDateMs,
+                isSticky,
+                std::move(onSuccess),
+                std::move(onError));
+}
+
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::vector<std::string>& participantIds,
+        const system::RoutingTypes::MqttAddress& mqttAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::MqttAddress>(mqttAddress);
+    addNextHops(participantIds,
+                std::move(address),
+                isGloballyVisible,
+                expiryDateMs,
+                isSticky,
+                std::move(onSuccess),
+                std::move(onError));
+}
+
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::vector<std::string>& participantIds,
+        const system::RoutingTypes::BrowserAddress& browserAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::BrowserAddress>(
+            browserAddress);
+    addNextHops(participantIds,
+                std::move(address),
+                isGloballyVisible,
+                expiryDateMs,
+                isSticky,
+                std::move(onSuccess),
+                std::move(onError));
+}
+
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::vector<std::string>& participantIds,
+        const system::RoutingTypes::WebSocketAddress& webSocketAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::WebSocketAddress>(
+            webSocketAddress);
+    addNextHops(participantIds,
+                std::move(address),
+                isGloballyVisible,
+                expiryDateMs,
+                isSticky,
+                std::move(onSuccess),
+                std::move(onError));
+}
+
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::vector<std::string>& participantIds,
+        const system::RoutingTypes::WebSocketClientAddress& webSocketClientAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::WebSocketClientAddress>(
+            webSocketClientAddress);
+    addNextHops(participantIds,
+                std::move(address),
+                isGloballyVisible,
+                expiryDateMs,
+                isSticky,
+                std::move(onSuccess),
+                std::move(onError));
+}
+
 void CcMessageRouter::resolveNextHop(
         const std::string& participantId,
         std::function<void(const bool& resolved)> onSuccess,
@@ -832,10 +1010,12 @@ ConsumerPermissionCallback::ConsumerPermissionCallback(
         std::shared_ptr<ImmutableMessage> message,
         std::shared_ptr<const joynr::system::RoutingTypes::Address> destination,
         bool aclAudit,
-        std::uint32_t tryCount)
+        std::uint32_t tryCount,
+        std::shared_ptr<CachedMessagingStub> cachedStub)
         : owningMessageRouter(owningMessageRouter),
           message(message),
           destination(destination),
+          cachedStub(std::move(cachedStub)),
           aclAudit(aclAudit),
           tryCount(tryCount)
 {
@@ -858,7 +1038,8 @@ void ConsumerPermissionCallback::hasConsumerPermission(IAccessController::Enum h
     if (hasPermission == IAccessController::Enum::YES) {
         message->setAccessControlChecked();
         if (auto owningMessageRouterSharedPtr = owningMessageRouter.lock()) {
-            owningMessageRouterSharedPtr->scheduleMessage(message, destination);
+            owningMessageRouterSharedPtr->scheduleMessage(
+                    message, destination, 0, std::chrono::milliseconds(0), cachedStub);
         } else {
             JOYNR_LOG_ERROR(logger(),
                             "Message with Id {} could not be sent because messageRouter is not "
@@ -878,7 +1059,8 @@ void ConsumerPermissionCallback::hasConsumerPermission(IAccessController::Enum h
                     owningMessageRouterSharedPtr->createDelayWithExponentialBackoff(
                             owningMessageRouterSharedPtr->messagingSettings
                                     .getSendMsgRetryInterval(),
-                            tryCount));
+                            tryCount),
+                    cachedStub);
         } else {
             JOYNR_LOG_ERROR(logger(),
                             "Message with Id {} could not be sent because messageRouter is not "
@@ -0,0 +1,113 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/messaging/IncomingMessageHelper.h"
+
+#include <stdexcept>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <smrf/exceptions.h>
+
+#include "joynr/BackPressureController.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/serializer/Serializer.h"
+
+namespace joynr
+{
+
+bool IncomingMessageHelper::isInitializationMessage(const std::string& message)
+{
+    return boost::starts_with(
+            message, "{\"_typeName\":\"joynr.system.RoutingTypes.WebSocketClientAddress\"");
+}
+
+std::shared_ptr<system::RoutingTypes::WebSocketClientAddress> IncomingMessageHelper::
+        parseInitializationMessage(const std::string& initMessage)
+{
+    if (!isInitializationMessage(initMessage)) {
+        JOYNR_LOG_ERROR(
+                logger(), "received an initial message with wrong format: \"{}\"", initMessage);
+        return nullptr;
+    }
+    JOYNR_LOG_DEBUG(logger(), "received initialization message: {}", initMessage);
+
+    std::shared_ptr<system::RoutingTypes::WebSocketClientAddress> clientAddress;
+    try {
+        joynr::serializer::deserializeFromJson(clientAddress, initMessage);
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_FATAL(logger(),
+                        "client address must be valid, otherwise libjoynr and CC are deployed "
+                        "in different versions - raw: {} - error: {}",
+                        initMessage,
+                        e.what());
+        return nullptr;
+    }
+    return clientAddress;
+}
+
+std::shared_ptr<ImmutableMessage> IncomingMessageHelper::deserialize(smrf::ByteVector&& message)
+{
+    std::shared_ptr<ImmutableMessage> immutableMessage;
+    try {
+        immutableMessage = std::make_shared<ImmutableMessage>(std::move(message));
+    } catch (const smrf::EncodingException& e) {
+        JOYNR_LOG_ERROR(logger(), "Unable to deserialize message - error: {}", e.what());
+        return nullptr;
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_ERROR(logger(), "deserialized message is not valid - error: {}", e.what());
+        return nullptr;
+    }
+
+    if (logger().getLogLevel() == LogLevel::Debug) {
+        JOYNR_LOG_DEBUG(logger(), "<<< INCOMING <<< {}", immutableMessage->getTrackingInfo());
+    } else {
+        JOYNR_LOG_TRACE(logger(), "<<< INCOMING <<< {}", immutableMessage->toLogMessage());
+    }
+    return immutableMessage;
+}
+
+bool IncomingMessageHelper::reserve(BackPressureController& backPressureController,
+                                    const std::string& clientId,
+                                    ImmutableMessage& message)
+{
+    auto reservation = backPressureController.reserve(clientId, message.getMessageSize());
+    if (!reservation) {
+        JOYNR_LOG_ERROR(logger(),
+                        "Dropping message {}: quota of client {} exceeded",
+                        message.getTrackingInfo(),
+                        clientId);
+        return false;
+    }
+    message.setBackPressureReservation(std::move(reservation));
+    return true;
+}
+
+std::function<void(const exceptions::JoynrRuntimeException&)> IncomingMessageHelper::
+        createOnFailure(const ImmutableMessage& message)
+{
+    return [trackingInfo = message.getTrackingInfo()](const exceptions::JoynrRuntimeException& e)
+    {
+        JOYNR_LOG_ERROR(logger(),
+                        "Incoming Message {} could not be sent! reason: {}",
+                        trackingInfo,
+                        e.getMessage());
+    };
+}
+
+} // namespace joynr
@@ -0,0 +1,87 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef INCOMINGMESSAGEHELPER_H
+#define INCOMINGMESSAGEHELPER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <smrf/ByteVector.h>
+
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+
+namespace joynr
+{
+
+class BackPressureController;
+class ImmutableMessage;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * Handling of incoming messages shared by the messaging skeletons which libjoynr runtimes
+ * connect to, i.e. the WebSocket and the unix domain socket skeleton.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT IncomingMessageHelper
+{
+public:
+    /**
+     * @return true if the message is the initialization message of a libjoynr runtime
+     */
+    static bool isInitializationMessage(const std::string& message);
+
+    /**
+     * @brief Parse the initialization message, which carries the address of the libjoynr runtime
+     * @return the address of the runtime, nullptr if the message is invalid
+     */
+    static std::shared_ptr<system::RoutingTypes::WebSocketClientAddress> parseInitializationMessage(
+            const std::string& initMessage);
+
+    /**
+     * @brief Deserialize an incoming message
+     * @return the message, nullptr if it cannot be deserialized
+     */
+    static std::shared_ptr<ImmutableMessage> deserialize(smrf::ByteVector&& message);
+
+    /**
+     * @brief Account the size of the message against the quota of the client
+     * @return false if the quota is exceeded; the message has to be dropped then
+     */
+    static bool reserve(BackPressureController& backPressureController,
+                        const std::string& clientId,
+                        ImmutableMessage& message);
+
+    /**
+     * @return a callback which logs that the message could not be routed
+     */
+    static std::function<void(const exceptions::JoynrRuntimeException&)> createOnFailure(
+            const ImmutableMessage& message);
+
+private:
+    ADD_LOGGER(IncomingMessageHelper)
+};
+
+} // namespace joynr
+#endif // INCOMINGMESSAGEHELPER_H
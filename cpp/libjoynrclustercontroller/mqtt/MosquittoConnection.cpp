@@ -31,11 +31,13 @@ namespace joynr
 
 MosquittoConnection::MosquittoConnection(const MessagingSettings& messagingSettings,
                                          const ClusterControllerSettings& ccSettings,
-                                         const std::string& clientId)
+                                         const std::string& clientId,
+                                         bool isPublishOnly)
         : mosquittopp(clientId.c_str(), false),
           messagingSettings(messagingSettings),
           host(messagingSettings.getBrokerUrl().getBrokerChannelsBaseUrl().getHost()),
           port(messagingSettings.getBrokerUrl().getBrokerChannelsBaseUrl().getPort()),
+          isPublishOnly(isPublishOnly),
           channelId(),
           subscribeChannelMid(),
           topic(),
@@ -126,6 +128,15 @@ MosquittoConnection::MosquittoConnection(const MessagingSettings& messagingSetti
     } else {
         JOYNR_LOG_DEBUG(logger(), "MQTT connection not encrypted");
     }
+
+    const std::uint32_t maxInflightMessages = messagingSettings.getMqttMaxInflightMessages();
+    int rc = max_inflight_messages_set(maxInflightMessages);
+    if (rc != MOSQ_ERR_SUCCESS) {
+        JOYNR_LOG_ERROR(logger(),
+                        "unable to set maximum number of inflight messages to {} - {}",
+                        maxInflightMessages,
+                        getErrorString(rc));
+    }
 }
 
 MosquittoConnection::~MosquittoConnection()
@@ -304,6 +315,10 @@ void MosquittoConnection::on_connect(int rc)
         JOYNR_LOG_INFO(logger(), "Mosquitto Connection established");
         isConnected = true;
 
+        if (isPublishOnly) {
+            setReadyToSend(true);
+            return;
+        }
         createSubscriptions();
     } else {
         const std::string errorString(getErrorString(rc));
@@ -47,9 +47,15 @@ class MosquittoConnection : public mosqpp::mosquittopp
 {
 
 public:
+    /**
+     * @param isPublishOnly a publish only connection does not subscribe to any topic and is
+     * ready to send as soon as it is connected; it is used to spread outgoing messages over
+     * additional broker connections
+     */
     explicit MosquittoConnection(const MessagingSettings& messagingSettings,
                                  const ClusterControllerSettings& ccSettings,
-                                 const std::string& clientId);
+                                 const std::string& clientId,
+                                 bool isPublishOnly = false);
 
     ~MosquittoConnection() override;
 
@@ -112,6 +118,7 @@ private:
     const MessagingSettings& messagingSettings;
     const std::string host;
     const std::uint16_t port;
+    const bool isPublishOnly;
 
     const std::uint16_t mqttQos = 1;
     const bool mqttRetain = false;
@@ -0,0 +1,214 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/MqttIngressQueue.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+std::string MqttIngressOverflowPolicy::getLiteral(const MqttIngressOverflowPolicy::Enum& value)
+{
+    switch (value) {
+    case Enum::BLOCK:
+        return "BLOCK";
+    case Enum::DROP_NEWEST:
+        return "DROP_NEWEST";
+    case Enum::DROP_OLDEST:
+        return "DROP_OLDEST";
+    default:
+        throw exceptions::JoynrRuntimeException("Invalid mqtt ingress overflow policy value");
+    }
+}
+
+MqttIngressOverflowPolicy::Enum MqttIngressOverflowPolicy::getEnum(
+        const std::string& policyString)
+{
+    if (policyString == "BLOCK") {
+        return Enum::BLOCK;
+    }
+    if (policyString == "DROP_NEWEST") {
+        return Enum::DROP_NEWEST;
+    }
+    if (policyString == "DROP_OLDEST") {
+        return Enum::DROP_OLDEST;
+    }
+    throw std::invalid_argument(policyString +
+                                " is unknown literal for MqttIngressOverflowPolicy");
+}
+
+MqttIngressQueue::MqttIngressQueue(std::size_t capacity,
+                                   std::size_t numberOfWorkers,
+                                   MqttIngressOverflowPolicy::Enum overflowPolicy,
+                                   std::function<void(smrf::ByteVector&&)> consumer)
+        : capacity(std::max<std::size_t>(capacity, 1)),
+          numberOfWorkers(std::max<std::size_t>(numberOfWorkers, 1)),
+          overflowPolicy(overflowPolicy),
+          consumer(std::move(consumer)),
+          queueMutex(),
+          notEmpty(),
+          notFull(),
+          queue(),
+          maxQueued(0),
+          isRunning(false),
+          workers(),
+          received(0),
+          processed(0),
+          dropped(0),
+          blocked(0)
+{
+}
+
+MqttIngressQueue::~MqttIngressQueue()
+{
+    stop();
+}
+
+void MqttIngressQueue::start()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (isRunning) {
+        return;
+    }
+    isRunning = true;
+    workers.reserve(numberOfWorkers);
+    for (std::size_t i = 0; i < numberOfWorkers; ++i) {
+        workers.emplace_back(&MqttIngressQueue::work, this);
+    }
+}
+
+void MqttIngressQueue::stop()
+{
+    std::vector<std::thread> workersToJoin;
+    std::size_t discarded = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!isRunning) {
+            return;
+        }
+        isRunning = false;
+        workersToJoin.swap(workers);
+        discarded = queue.size();
+        queue.clear();
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+    for (std::thread& worker : workersToJoin) {
+        worker.join();
+    }
+
+    const MqttIngressQueueStatistics statistics = getStatistics();
+    JOYNR_LOG_INFO(logger(),
+                   "stopped: received {}, processed {}, dropped {}, blocked {}, max queued {}, "
+                   "discarded on stop {}",
+                   statistics.received,
+                   statistics.processed,
+                   statistics.dropped,
+                   statistics.blocked,
+                   statistics.maxQueued,
+                   discarded);
+}
+
+void MqttIngressQueue::push(smrf::ByteVector&& message)
+{
+    received++;
+    bool droppedOldest = false;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (!isRunning) {
+            dropped++;
+            return;
+        }
+        if (queue.size() >= capacity) {
+            switch (overflowPolicy) {
+            case MqttIngressOverflowPolicy::Enum::BLOCK:
+                blocked++;
+                notFull.wait(lock, [this]() { return !isRunning || queue.size() < capacity; });
+                if (!isRunning) {
+                    dropped++;
+                    return;
+                }
+                break;
+            case MqttIngressOverflowPolicy::Enum::DROP_NEWEST:
+                lock.unlock();
+                countDropped();
+                return;
+            case MqttIngressOverflowPolicy::Enum::DROP_OLDEST:
+                queue.pop_front();
+                droppedOldest = true;
+                break;
+            }
+        }
+        queue.push_back(std::move(message));
+        maxQueued = std::max(maxQueued, queue.size());
+    }
+    notEmpty.notify_one();
+    if (droppedOldest) {
+        countDropped();
+    }
+}
+
+MqttIngressQueueStatistics MqttIngressQueue::getStatistics() const
+{
+    MqttIngressQueueStatistics statistics;
+    statistics.received = received;
+    statistics.processed = processed;
+    statistics.dropped = dropped;
+    statistics.blocked = blocked;
+    std::lock_guard<std::mutex> lock(queueMutex);
+    statistics.queued = queue.size();
+    statistics.maxQueued = maxQueued;
+    return statistics;
+}
+
+void MqttIngressQueue::work()
+{
+    while (true) {
+        smrf::ByteVector message;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notEmpty.wait(lock, [this]() { return !isRunning || !queue.empty(); });
+            if (!isRunning) {
+                return;
+            }
+            message = std::move(queue.front());
+            queue.pop_front();
+        }
+        notFull.notify_one();
+        consumer(std::move(message));
+        processed++;
+    }
+}
+
+void MqttIngressQueue::countDropped()
+{
+    const std::uint64_t droppedSoFar = ++dropped;
+    // avoid flooding the log while the broker keeps delivering faster than messages are routed
+    if (droppedSoFar % 1000 == 1) {
+        JOYNR_LOG_ERROR(logger(),
+                        "ingress queue of capacity {} is full, {} received messages dropped so far",
+                        capacity,
+                        droppedSoFar);
+    }
+}
+
+} // namespace joynr
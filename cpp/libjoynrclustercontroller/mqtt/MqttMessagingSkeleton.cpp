@@ -18,11 +18,15 @@
  */
 #include "joynr/MqttMessagingSkeleton.h"
 
+#include <stdexcept>
+#include <vector>
+
 #include <smrf/exceptions.h>
 
 #include "joynr/IMessageRouter.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
+#include "joynr/MessageBatch.h"
 #include "joynr/Util.h"
 #include "joynr/exceptions/JoynrException.h"
 
@@ -102,6 +106,26 @@ void MqttMessagingSkeleton::transmit(
 }
 
 void MqttMessagingSkeleton::onMessageReceived(smrf::ByteVector&& rawMessage)
+{
+    if (!MessageBatch::isBatch(rawMessage)) {
+        onSingleMessageReceived(std::move(rawMessage));
+        return;
+    }
+
+    std::vector<smrf::ByteVector> messages;
+    try {
+        messages = MessageBatch::split(rawMessage);
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_ERROR(logger(), "Unable to unpack message batch - error: {}", e.what());
+        return;
+    }
+    JOYNR_LOG_TRACE(logger(), "received batch of {} messages", messages.size());
+    for (smrf::ByteVector& message : messages) {
+        onSingleMessageReceived(std::move(message));
+    }
+}
+
+void MqttMessagingSkeleton::onSingleMessageReceived(smrf::ByteVector&& rawMessage)
 {
     std::shared_ptr<ImmutableMessage> immutableMessage;
     try {
@@ -0,0 +1,220 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/mqtt/MqttPublishBatcher.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+
+namespace joynr
+{
+
+MqttPublishBatcher::MqttPublishBatcher(std::size_t maxMessages,
+                                       std::size_t maxBytes,
+                                       std::chrono::milliseconds maxDelay)
+        : maxMessages(std::max<std::size_t>(maxMessages, 1)),
+          maxBytes(maxBytes),
+          maxDelay(maxDelay),
+          batchesMutex(),
+          batchAdded(),
+          batches(),
+          isRunning(false),
+          flushThread()
+{
+}
+
+MqttPublishBatcher::~MqttPublishBatcher()
+{
+    stop();
+}
+
+void MqttPublishBatcher::start()
+{
+    std::lock_guard<std::mutex> lock(batchesMutex);
+    if (isRunning) {
+        return;
+    }
+    isRunning = true;
+    flushThread = std::thread(&MqttPublishBatcher::run, this);
+}
+
+void MqttPublishBatcher::stop()
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(batchesMutex);
+        if (!isRunning) {
+            return;
+        }
+        isRunning = false;
+        for (auto& entry : batches) {
+            publish(entry.first, entry.second, failures);
+        }
+        batches.clear();
+    }
+    batchAdded.notify_all();
+    if (flushThread.joinable()) {
+        flushThread.join();
+    }
+    notifyFailures(failures);
+}
+
+void MqttPublishBatcher::add(std::shared_ptr<MosquittoConnection> connection,
+                             const std::string& topic,
+                             int qosLevel,
+                             const smrf::ByteArrayView& message,
+                             const OnFailure& onFailure)
+{
+    std::vector<Failure> failures;
+    {
+        std::lock_guard<std::mutex> lock(batchesMutex);
+        if (!isRunning) {
+            PendingBatch single{
+                    std::move(connection), qosLevel, MessageBatch(), {onFailure}, {}};
+            single.batch.append(message);
+            publish(topic, single, failures);
+        } else {
+            auto it = batches.find(topic);
+            if (it != batches.end()) {
+                const PendingBatch& pendingBatch = it->second;
+                const std::size_t sizeWithMessage = pendingBatch.batch.getSize() +
+                                                    MessageBatch::FRAME_OVERHEAD +
+                                                    message.size();
+                // publish what is pending first so that messages to the topic stay in order
+                if (pendingBatch.connection != connection || pendingBatch.qosLevel != qosLevel ||
+                    sizeWithMessage > maxBytes) {
+                    publish(topic, it->second, failures);
+                    batches.erase(it);
+                    it = batches.end();
+                }
+            }
+            bool isNewBatch = false;
+            if (it == batches.end()) {
+                PendingBatch pendingBatch{std::move(connection),
+                                          qosLevel,
+                                          MessageBatch(),
+                                          {},
+                                          std::chrono::steady_clock::now() + maxDelay};
+                it = batches.emplace(topic, std::move(pendingBatch)).first;
+                isNewBatch = true;
+            }
+            PendingBatch& pendingBatch = it->second;
+            pendingBatch.batch.append(message);
+            pendingBatch.onFailures.push_back(onFailure);
+            if (pendingBatch.batch.getNumberOfMessages() >= maxMessages ||
+                pendingBatch.batch.getSize() >= maxBytes) {
+                publish(topic, pendingBatch, failures);
+                batches.erase(it);
+            } else if (isNewBatch) {
+                batchAdded.notify_one();
+            }
+        }
+    }
+    notifyFailures(failures);
+}
+
+void MqttPublishBatcher::publish(const std::string& topic,
+                                 PendingBatch& pendingBatch,
+                                 std::vector<Failure>& failures)
+{
+    const smrf::ByteVector& payload = pendingBatch.batch.getPayload();
+    const std::uint8_t* data = payload.data();
+    std::size_t size = payload.size();
+    if (pendingBatch.batch.getNumberOfMessages() == 1) {
+        // a single message is published without the envelope
+        constexpr std::size_t envelopeSize =
+                MessageBatch::HEADER_SIZE + MessageBatch::FRAME_OVERHEAD;
+        data += envelopeSize;
+        size -= envelopeSize;
+    } else {
+        JOYNR_LOG_TRACE(logger(),
+                        "publish batch of {} messages to {}",
+                        pendingBatch.batch.getNumberOfMessages(),
+                        topic);
+    }
+
+    // failures are reported after the lock is released since the callbacks may send again
+    std::shared_ptr<exceptions::JoynrRuntimeException> exception;
+    pendingBatch.connection->publishMessage(
+            topic,
+            pendingBatch.qosLevel,
+            [&exception](const exceptions::JoynrRuntimeException& error) {
+                exception.reset(error.clone());
+            },
+            static_cast<std::uint32_t>(size),
+            data);
+    if (exception) {
+        failures.push_back(Failure{std::move(pendingBatch.onFailures), std::move(exception)});
+    }
+}
+
+void MqttPublishBatcher::publishExpired(std::vector<Failure>& failures)
+{
+    const auto now = std::chrono::steady_clock::now();
+    for (auto it = batches.begin(); it != batches.end();) {
+        if (it->second.deadline <= now) {
+            publish(it->first, it->second, failures);
+            it = batches.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MqttPublishBatcher::notifyFailures(const std::vector<Failure>& failures)
+{
+    for (const Failure& failure : failures) {
+        for (const OnFailure& onFailure : failure.onFailures) {
+            if (onFailure) {
+                onFailure(*failure.exception);
+            }
+        }
+    }
+}
+
+void MqttPublishBatcher::run()
+{
+    std::vector<Failure> failures;
+    std::unique_lock<std::mutex> lock(batchesMutex);
+    while (isRunning) {
+        if (batches.empty()) {
+            batchAdded.wait(lock, [this]() { return !isRunning || !batches.empty(); });
+            continue;
+        }
+        auto earliestDeadline = std::chrono::steady_clock::time_point::max();
+        for (const auto& entry : batches) {
+            earliestDeadline = std::min(earliestDeadline, entry.second.deadline);
+        }
+        if (std::chrono::steady_clock::now() < earliestDeadline) {
+            batchAdded.wait_until(lock, earliestDeadline);
+            continue;
+        }
+        publishExpired(failures);
+        if (!failures.empty()) {
+            lock.unlock();
+            notifyFailures(failures);
+            failures.clear();
+            lock.lock();
+        }
+    }
+}
+
+} // namespace joynr
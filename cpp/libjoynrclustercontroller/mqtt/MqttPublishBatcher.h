@@ -0,0 +1,126 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef MQTTPUBLISHBATCHER_H
+#define MQTTPUBLISHBATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/Logger.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class MosquittoConnection;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @brief Collects messages to the same topic and publishes them together as MessageBatch.
+ *
+ * A batch is published as soon as it holds maxMessages messages, before it would exceed
+ * maxBytes, or at the latest maxDelay after its first message was added. A batch which holds
+ * only a single message is published as plain message. Messages to the same topic are
+ * published in the order they were added.
+ */
+class MqttPublishBatcher
+{
+public:
+    using OnFailure = std::function<void(const exceptions::JoynrRuntimeException&)>;
+
+    MqttPublishBatcher(std::size_t maxMessages,
+                       std::size_t maxBytes,
+                       std::chrono::milliseconds maxDelay);
+
+    ~MqttPublishBatcher();
+
+    void start();
+
+    /**
+     * @brief Publishes all pending batches and stops the flush thread. Messages added
+     * afterwards are published immediately.
+     */
+    void stop();
+
+    /**
+     * @param onFailure called for the message if publishing its batch fails; it is never called
+     * from within add for another message
+     */
+    void add(std::shared_ptr<MosquittoConnection> connection,
+             const std::string& topic,
+             int qosLevel,
+             const smrf::ByteArrayView& message,
+             const OnFailure& onFailure);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MqttPublishBatcher);
+
+    struct PendingBatch
+    {
+        std::shared_ptr<MosquittoConnection> connection;
+        int qosLevel;
+        MessageBatch batch;
+        std::vector<OnFailure> onFailures;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    struct Failure
+    {
+        std::vector<OnFailure> onFailures;
+        std::shared_ptr<exceptions::JoynrRuntimeException> exception;
+    };
+
+    void publish(const std::string& topic,
+                 PendingBatch& pendingBatch,
+                 std::vector<Failure>& failures);
+    void publishExpired(std::vector<Failure>& failures);
+    static void notifyFailures(const std::vector<Failure>& failures);
+    void run();
+
+    const std::size_t maxMessages;
+    const std::size_t maxBytes;
+    const std::chrono::milliseconds maxDelay;
+
+    std::mutex batchesMutex;
+    std::condition_variable batchAdded;
+    std::unordered_map<std::string, PendingBatch> batches;
+    bool isRunning;
+    std::thread flushThread;
+
+    ADD_LOGGER(MqttPublishBatcher)
+};
+
+} // namespace joynr
+
+#endif // MQTTPUBLISHBATCHER_H
@@ -18,6 +18,9 @@
  */
 #include "libjoynrclustercontroller/mqtt/MqttSender.h"
 
+#include <algorithm>
+#include <functional>
+
 #include "joynr/ITransportMessageReceiver.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
@@ -28,16 +31,39 @@
 #include "joynr/system/RoutingTypes/MqttAddress.h"
 
 #include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+#include "libjoynrclustercontroller/mqtt/MqttPublishBatcher.h"
 
 namespace joynr
 {
 
 MqttSender::MqttSender(std::shared_ptr<MosquittoConnection> mosquittoConnection,
-                       const MessagingSettings& settings)
+                       const MessagingSettings& settings,
+                       std::vector<std::shared_ptr<MosquittoConnection>> publishConnections)
         : mosquittoConnection(mosquittoConnection),
+          publishConnections(std::move(publishConnections)),
           receiver(),
-          mqttMaxMessageSizeBytes(settings.getMqttMaxMessageSizeBytes())
+          mqttMaxMessageSizeBytes(settings.getMqttMaxMessageSizeBytes()),
+          publishBatcher()
 {
+    if (settings.getMqttPublishBatchMaxMessages() > 1) {
+        std::size_t maxBatchBytes = settings.getMqttPublishBatchMaxBytes();
+        if (mqttMaxMessageSizeBytes != MessagingSettings::NO_MQTT_MAX_MESSAGE_SIZE_BYTES()) {
+            maxBatchBytes =
+                    std::min(maxBatchBytes, static_cast<std::size_t>(mqttMaxMessageSizeBytes));
+        }
+        publishBatcher = std::make_unique<MqttPublishBatcher>(
+                settings.getMqttPublishBatchMaxMessages(),
+                maxBatchBytes,
+                settings.getMqttPublishBatchMaxDelayMs());
+        publishBatcher->start();
+    }
+}
+
+MqttSender::~MqttSender()
+{
+    if (publishBatcher) {
+        publishBatcher->stop();
+    }
 }
 
 void MqttSender::sendMessage(
@@ -61,16 +87,26 @@ void MqttSender::sendMessage(
         return;
     }
     std::string topic;
-    if (message->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+    const bool isMulticast = message->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST();
+    if (isMulticast) {
         topic = mqttAddress->getTopic();
     } else {
         topic = mqttAddress->getTopic() + "/" + mosquittoConnection->getMqttPrio() + "/" +
                 message->getRecipient();
     }
 
+    const std::shared_ptr<MosquittoConnection>& publishConnection = getPublishConnection(topic);
+    if (publishConnection != mosquittoConnection && !publishConnection->isReadyToSend()) {
+        // do not fall back to another connection, this could reorder messages of the topic
+        const std::string msg = "MQTT publish connection is not connected, delaying message";
+        JOYNR_LOG_DEBUG(logger(), msg);
+        onFailure(exceptions::JoynrDelayMessageException(std::chrono::seconds(2), msg));
+        return;
+    }
+
     int qosLevel = mosquittoConnection->getMqttQos();
 
-    boost::optional<std::string> optionalEffort = message->getEffort();
+    boost::optional<const std::string&> optionalEffort = message->getEffortView();
     if (optionalEffort &&
         *optionalEffort == MessagingQosEffort::getLiteral(MessagingQosEffort::Enum::BEST_EFFORT)) {
         qosLevel = 0;
@@ -90,8 +126,27 @@ void MqttSender::sendMessage(
         return;
     }
 
-    mosquittoConnection->publishMessage(
+    // multicasts are not batched since their subscribers are not known
+    if (publishBatcher && !isMulticast) {
+        publishBatcher->add(publishConnection,
+                            topic,
+                            qosLevel,
+                            smrf::ByteArrayView(rawMessage),
+                            onFailure);
+        return;
+    }
+
+    publishConnection->publishMessage(
             topic, qosLevel, onFailure, rawMessage.size(), rawMessage.data());
 }
 
+const std::shared_ptr<MosquittoConnection>& MqttSender::getPublishConnection(
+        const std::string& topic) const
+{
+    if (publishConnections.empty()) {
+        return mosquittoConnection;
+    }
+    return publishConnections[std::hash<std::string>()(topic) % publishConnections.size()];
+}
+
 } // namespace joynr
@@ -19,6 +19,10 @@
 #ifndef MQTTSENDER_H
 #define MQTTSENDER_H
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "joynr/PrivateCopyAssign.h"
 
 #include "joynr/ITransportMessageSender.h"
@@ -29,15 +33,23 @@ namespace joynr
 
 class MessagingSettings;
 class MosquittoConnection;
+class MqttPublishBatcher;
 
 class MqttSender : public ITransportMessageSender
 {
 
 public:
-    explicit MqttSender(std::shared_ptr<MosquittoConnection> mosquittoConnection,
-                        const MessagingSettings& settings);
+    /**
+     * @param publishConnections if not empty, messages are published via these connections
+     * instead of mosquittoConnection; all messages to the same topic use the same connection so
+     * that their order is preserved
+     */
+    explicit MqttSender(
+            std::shared_ptr<MosquittoConnection> mosquittoConnection,
+            const MessagingSettings& settings,
+            std::vector<std::shared_ptr<MosquittoConnection>> publishConnections = {});
 
-    ~MqttSender() override = default;
+    ~MqttSender() override;
 
     /**
     * @brief Sends the message to the given channel.
@@ -50,9 +62,15 @@ public:
 private:
     DISALLOW_COPY_AND_ASSIGN(MqttSender);
 
+    const std::shared_ptr<MosquittoConnection>& getPublishConnection(
+            const std::string& topic) const;
+
     std::shared_ptr<MosquittoConnection> mosquittoConnection;
+    const std::vector<std::shared_ptr<MosquittoConnection>> publishConnections;
     std::shared_ptr<ITransportMessageReceiver> receiver;
     const std::int64_t mqttMaxMessageSizeBytes;
+    // only set if batching is enabled, see MessagingSettings::getMqttPublishBatchMaxMessages
+    std::unique_ptr<MqttPublishBatcher> publishBatcher;
 
     ADD_LOGGER(MqttSender)
 };
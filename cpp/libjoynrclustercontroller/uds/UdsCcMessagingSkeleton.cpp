@@ -0,0 +1,282 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/uds/UdsCcMessagingSkeleton.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+
+#include <sys/stat.h>
+
+#include "joynr/BackPressureController.h"
+#include "joynr/IMessageRouter.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/Util.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/uds/UdsConnection.h"
+#include "libjoynr/websocket/WebSocketMessagingStubFactory.h"
+#include "libjoynrclustercontroller/messaging/IncomingMessageHelper.h"
+
+namespace joynr
+{
+
+UdsCcMessagingSkeleton::UdsCcMessagingSkeleton(
+        std::shared_ptr<IMessageRouter> messageRouter,
+        std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory,
+        const UdsAddress& serverAddress)
+        : udsSingleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+          acceptor(udsSingleThreadedIOService->getIOService()),
+          serverAddress(serverAddress),
+          clientsMutex(),
+          clients(),
+          nextConnectionId(0),
+          messageRouter(std::move(messageRouter)),
+          messagingStubFactory(std::move(messagingStubFactory)),
+          shuttingDown(false),
+          backPressureController()
+{
+}
+
+UdsCcMessagingSkeleton::~UdsCcMessagingSkeleton()
+{
+    // make sure shutdown() has been invoked earlier
+    assert(shuttingDown);
+}
+
+void UdsCcMessagingSkeleton::init()
+{
+    udsSingleThreadedIOService->start();
+
+    // a socket file left behind by a previous cluster controller would prevent the bind
+    removeSocketFile();
+
+    boost::system::error_code error;
+    const boost::asio::local::stream_protocol::endpoint endpoint(serverAddress.getPath());
+    acceptor.open(endpoint.protocol(), error);
+    if (!error) {
+        acceptor.bind(endpoint, error);
+    }
+    // the socket file is created according to the umask; only the user and the group of the
+    // cluster controller may connect. Connecting fails until listen, so there is no window.
+    if (!error && ::chmod(serverAddress.getPath().c_str(), 0660) != 0) {
+        error = boost::system::error_code(errno, boost::system::system_category());
+    }
+    if (!error) {
+        acceptor.listen(boost::asio::socket_base::max_connections, error);
+    }
+    if (error) {
+        JOYNR_LOG_FATAL(logger(),
+                        "UDS server could not be started on {}: \"{}\"",
+                        serverAddress.getPath(),
+                        error.message());
+        return;
+    }
+    JOYNR_LOG_INFO(logger(), "UDS server listening on {}", serverAddress.getPath());
+    startAccept();
+}
+
+void UdsCcMessagingSkeleton::shutdown()
+{
+    // make sure shutdown() is called only once
+    assert(!shuttingDown);
+    shuttingDown = true;
+
+    boost::system::error_code ignored;
+    acceptor.close(ignored);
+
+    std::map<ConnectionId, Client> clientsToClose;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clientsToClose.swap(clients);
+    }
+    for (const auto& client : clientsToClose) {
+        client.second.connection->close();
+    }
+
+    udsSingleThreadedIOService->stop();
+    removeSocketFile();
+}
+
+void UdsCcMessagingSkeleton::transmit(
+        std::shared_ptr<ImmutableMessage> message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    try {
+        messageRouter->route(std::move(message));
+    } catch (exceptions::JoynrRuntimeException& e) {
+        onFailure(e);
+    }
+}
+
+void UdsCcMessagingSkeleton::setBackPressureController(
+        std::shared_ptr<BackPressureController> backPressureController)
+{
+    this->backPressureController = std::move(backPressureController);
+}
+
+void UdsCcMessagingSkeleton::removeSocketFile()
+{
+    // any other file at the path is not owned by the cluster controller; the bind reports it
+    struct stat fileStatus;
+    if (::stat(serverAddress.getPath().c_str(), &fileStatus) == 0 &&
+        S_ISSOCK(fileStatus.st_mode)) {
+        std::remove(serverAddress.getPath().c_str());
+    }
+}
+
+void UdsCcMessagingSkeleton::startAccept()
+{
+    auto socket = std::make_shared<boost::asio::local::stream_protocol::socket>(
+            udsSingleThreadedIOService->getIOService());
+    acceptor.async_accept(
+            *socket,
+            [thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
+             socket](const boost::system::error_code& error) {
+                auto thisSharedPtr = thisWeakPtr.lock();
+                if (!thisSharedPtr || thisSharedPtr->shuttingDown) {
+                    return;
+                }
+                if (error) {
+                    JOYNR_LOG_ERROR(
+                            logger(), "accepting UDS connection failed: {}", error.message());
+                } else {
+                    thisSharedPtr->onConnectionAccepted(
+                            thisSharedPtr->nextConnectionId++, std::move(socket));
+                }
+                thisSharedPtr->startAccept();
+            });
+}
+
+void UdsCcMessagingSkeleton::onConnectionAccepted(
+        ConnectionId connectionId,
+        std::shared_ptr<boost::asio::local::stream_protocol::socket> socket)
+{
+    auto thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this());
+    auto connection = std::make_shared<UdsConnection>(
+            udsSingleThreadedIOService->getIOService(),
+            std::move(*socket),
+            [thisWeakPtr, connectionId](smrf::ByteVector&& message) {
+                if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                    thisSharedPtr->onMessageReceived(connectionId, std::move(message));
+                }
+            },
+            [thisWeakPtr, connectionId]() {
+                if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                    thisSharedPtr->onConnectionClosed(connectionId);
+                }
+            });
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients[connectionId] = Client{connection, nullptr};
+    }
+    connection->start();
+}
+
+void UdsCcMessagingSkeleton::onConnectionClosed(ConnectionId connectionId)
+{
+    std::lock_guard<std::mutex> lock(clientsMutex);
+    if (shuttingDown) {
+        return;
+    }
+    auto it = clients.find(connectionId);
+    if (it == clients.cend()) {
+        return;
+    }
+    if (it->second.clientAddress) {
+        JOYNR_LOG_INFO(logger(),
+                       "Closed connection for UDS client id: {}",
+                       it->second.clientAddress->getId());
+        messagingStubFactory->onMessagingStubClosed(*it->second.clientAddress);
+    }
+    clients.erase(it);
+}
+
+void UdsCcMessagingSkeleton::onMessageReceived(ConnectionId connectionId,
+                                               smrf::ByteVector&& message)
+{
+    std::shared_ptr<UdsConnection> connection;
+    std::string clientId;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(connectionId);
+        if (it == clients.cend()) {
+            return;
+        }
+        connection = it->second.connection;
+        if (it->second.clientAddress) {
+            clientId = it->second.clientAddress->getId();
+        }
+    }
+
+    // the first message of a connection is the initialization message; reads of a connection
+    // are sequential, so no further message is processed before it has been handled
+    if (clientId.empty()) {
+        onInitMessageReceived(connectionId, connection, message);
+        return;
+    }
+
+    // deserialize message and transmit
+    std::shared_ptr<ImmutableMessage> immutableMessage =
+            IncomingMessageHelper::deserialize(std::move(message));
+    if (!immutableMessage) {
+        return;
+    }
+
+    if (backPressureController &&
+        !IncomingMessageHelper::reserve(*backPressureController, clientId, *immutableMessage)) {
+        return;
+    }
+
+    auto onFailure = IncomingMessageHelper::createOnFailure(*immutableMessage);
+    transmit(std::move(immutableMessage), std::move(onFailure));
+}
+
+void UdsCcMessagingSkeleton::onInitMessageReceived(ConnectionId connectionId,
+                                                   const std::shared_ptr<UdsConnection>& connection,
+                                                   const smrf::ByteVector& message)
+{
+    const std::string initMessage(message.cbegin(), message.cend());
+    std::shared_ptr<joynr::system::RoutingTypes::WebSocketClientAddress> clientAddress =
+            IncomingMessageHelper::parseInitializationMessage(initMessage);
+    if (!clientAddress) {
+        // no message of the connection could be routed back to the client
+        JOYNR_LOG_ERROR(logger(),
+                        "Closing UDS connection {} after invalid initialization message",
+                        connectionId);
+        connection->close();
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients.erase(connectionId);
+        return;
+    }
+
+    JOYNR_LOG_INFO(logger(), "Init connection for UDS client id: {}", clientAddress->getId());
+    messagingStubFactory->addClient(*clientAddress, connection);
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(connectionId);
+        if (it != clients.cend()) {
+            it->second.clientAddress = clientAddress;
+        }
+    }
+
+    messageRouter->sendQueuedMessages(std::move(clientAddress));
+}
+
+} // namespace joynr
@@ -0,0 +1,126 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef UDSCCMESSAGINGSKELETON_H
+#define UDSCCMESSAGINGSKELETON_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <smrf/ByteVector.h>
+
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/UdsAddress.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+
+namespace joynr
+{
+
+class BackPressureController;
+class IMessageRouter;
+class ImmutableMessage;
+class SingleThreadedIOService;
+class UdsConnection;
+class WebSocketMessagingStubFactory;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class UdsCcMessagingSkeleton
+ * @brief Messaging skeleton of the cluster controller for libjoynr runtimes which connect via a
+ * unix domain socket.
+ *
+ * The protocol on top of the length-prefixed messages equals the one of the WebSocket skeleton:
+ * the first message of each connection is the serialized WebSocketClientAddress of the libjoynr
+ * runtime. Since this address type is also known to the routing provider, connected runtimes are
+ * registered with the WebSocketMessagingStubFactory and routed like WebSocket clients.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT UdsCcMessagingSkeleton
+        : public std::enable_shared_from_this<UdsCcMessagingSkeleton>
+{
+public:
+    UdsCcMessagingSkeleton(std::shared_ptr<IMessageRouter> messageRouter,
+                           std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory,
+                           const UdsAddress& serverAddress);
+
+    ~UdsCcMessagingSkeleton();
+
+    void init();
+    void shutdown();
+
+    void transmit(std::shared_ptr<ImmutableMessage> message,
+                  const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+
+    /**
+     * @brief Account the bytes of incoming messages per client; messages of a client which
+     * exceeds its quota are dropped.
+     */
+    void setBackPressureController(std::shared_ptr<BackPressureController> backPressureController);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(UdsCcMessagingSkeleton);
+
+    using ConnectionId = std::uint64_t;
+
+    struct Client
+    {
+        std::shared_ptr<UdsConnection> connection;
+        std::shared_ptr<const system::RoutingTypes::WebSocketClientAddress> clientAddress;
+    };
+
+    void startAccept();
+    void onConnectionAccepted(ConnectionId connectionId,
+                              std::shared_ptr<boost::asio::local::stream_protocol::socket> socket);
+    void onConnectionClosed(ConnectionId connectionId);
+    void onMessageReceived(ConnectionId connectionId, smrf::ByteVector&& message);
+    void onInitMessageReceived(ConnectionId connectionId,
+                               const std::shared_ptr<UdsConnection>& connection,
+                               const smrf::ByteVector& message);
+    void removeSocketFile();
+
+    std::shared_ptr<SingleThreadedIOService> udsSingleThreadedIOService;
+    boost::asio::local::stream_protocol::acceptor acceptor;
+    const UdsAddress serverAddress;
+
+    std::mutex clientsMutex;
+    std::map<ConnectionId, Client> clients;
+    ConnectionId nextConnectionId;
+
+    /*! Router for incoming messages */
+    std::shared_ptr<IMessageRouter> messageRouter;
+    /*! Factory to build outgoing messaging stubs */
+    std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory;
+    std::atomic<bool> shuttingDown;
+    std::shared_ptr<BackPressureController> backPressureController;
+
+    ADD_LOGGER(UdsCcMessagingSkeleton)
+};
+
+} // namespace joynr
+#endif // UDSCCMESSAGINGSKELETON_H
@@ -19,30 +19,38 @@
 #ifndef WEBSOCKETCCMESSAGINGSKELETON_H
 #define WEBSOCKETCCMESSAGINGSKELETON_H
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/optional.hpp>
 
 #include <websocketpp/server.hpp>
 
-#include <smrf/exceptions.h>
-
+#include "joynr/BackPressureController.h"
 #include "joynr/IMessageRouter.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Logger.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/Semaphore.h"
-#include "joynr/SingleThreadedIOService.h"
-#include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
 #include "joynr/Util.h"
+#include "libjoynr/shm/ShmChannel.h"
+#include "libjoynr/shm/ShmSegment.h"
+#include "libjoynr/websocket/WebSocketCoalescingSender.h"
 #include "libjoynr/websocket/WebSocketMessagingStubFactory.h"
 #include "libjoynr/websocket/WebSocketPpReceiver.h"
 #include "libjoynr/websocket/WebSocketPpSender.h"
+#include "libjoynrclustercontroller/messaging/IncomingMessageHelper.h"
 
 namespace joynr
 {
@@ -59,11 +67,20 @@ public:
             const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) = 0;
     virtual void init() = 0;
     virtual void shutdown() = 0;
+    virtual void setBackPressureController(
+            std::shared_ptr<BackPressureController> backPressureController) = 0;
 };
 
 /**
  * @class WebSocketCcMessagingSkeleton
  * @brief Messaging skeleton for the cluster controller
+ *
+ * The WebSocket server runs on a pool of io threads; WebSocket++ serializes the handlers of
+ * each connection on a strand of its own. Incoming messages are handed off to a separate pool
+ * of message processing threads so that reading from the network never waits for routing.
+ * Messages of one client are processed in order on a strand per client. Clients which offer
+ * coalescing before their initialization message may send several messages in one frame and
+ * receive them that way.
  */
 template <typename Config>
 class WebSocketCcMessagingSkeleton
@@ -75,32 +92,48 @@ public:
      * @brief Constructor
      * @param messageRouter Router
      * @param messagingStubFactory Factory
+     * @param port Port of the WebSocket server
+     * @param numberOfIoThreads Number of threads serving the WebSocket connections
+     * @param numberOfMessageProcessingThreads Number of threads deserializing and routing
+     * incoming messages; if 0, messages are processed on the io threads
      */
     WebSocketCcMessagingSkeleton(
             boost::asio::io_service& ioService,
             std::shared_ptr<IMessageRouter> messageRouter,
             std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory,
-            std::uint16_t port)
+            std::uint16_t port,
+            std::size_t numberOfIoThreads,
+            std::size_t numberOfMessageProcessingThreads)
             : IWebsocketCcMessagingSkeleton(),
               std::enable_shared_from_this<WebSocketCcMessagingSkeleton<Config>>(),
               ioService(ioService),
-              webSocketPpSingleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              webSocketPpIOService(std::make_shared<MultiThreadedIOService>(numberOfIoThreads)),
+              messageProcessingIOService(
+                      numberOfMessageProcessingThreads > 0
+                              ? std::make_shared<MultiThreadedIOService>(
+                                        numberOfMessageProcessingThreads)
+                              : nullptr),
               endpoint(),
               clientsMutex(),
               clients(),
+              sharedMemoryChannels(),
+              coalescingOffers(),
               receiver(),
               messageRouter(std::move(messageRouter)),
               messagingStubFactory(std::move(messagingStubFactory)),
               port(port),
-              shuttingDown(false)
+              shuttingDown(false),
+              backPressureController()
     {
     }
 
     virtual void init() override
     {
-        webSocketPpSingleThreadedIOService->start();
-        boost::asio::io_service& endpointIoService =
-                webSocketPpSingleThreadedIOService->getIOService();
+        webSocketPpIOService->start();
+        if (messageProcessingIOService) {
+            messageProcessingIOService->start();
+        }
+        boost::asio::io_service& endpointIoService = webSocketPpIOService->getIOService();
         websocketpp::lib::error_code initializationError;
 
         endpoint.init_asio(&endpointIoService, initializationError);
@@ -151,11 +184,17 @@ public:
 
     void shutdown() override
     {
+        std::map<ConnectionHandle, std::shared_ptr<ShmChannel>, std::owner_less<ConnectionHandle>>
+                channelsToStop;
         // make sure shutdown() is called only once
         {
             std::lock_guard<std::mutex> lock(clientsMutex);
             assert(!shuttingDown);
             shuttingDown = true;
+            channelsToStop.swap(sharedMemoryChannels);
+        }
+        for (const auto& elem : channelsToStop) {
+            elem.second->stop();
         }
 
         websocketpp::lib::error_code shutdownError;
@@ -178,14 +217,19 @@ public:
             }
         }
 
-        // prior to destruction of the endpoint, the background thread
-        // under direct control of the webSocketPpSingleThreadedIOService
-        // must have finished its work, thus wait for it here;
+        // prior to destruction of the endpoint, the background threads
+        // under direct control of the webSocketPpIOService
+        // must have finished their work, thus wait for them here;
         // however do not destruct the ioService since it is still
         // referenced within the endpoint by an internally created
         // thread from tcp::resolver which is joined by the endpoint
         // destructor
-        webSocketPpSingleThreadedIOService->stop();
+        webSocketPpIOService->stop();
+
+        // messages which have not been processed yet are dropped
+        if (messageProcessingIOService) {
+            messageProcessingIOService->stop();
+        }
     }
 
     void transmit(
@@ -199,6 +243,16 @@ public:
         }
     }
 
+    /**
+     * @brief Account the bytes of incoming messages per websocket client; messages of a client
+     * which exceeds its quota are dropped.
+     */
+    void setBackPressureController(
+            std::shared_ptr<BackPressureController> backPressureController) override
+    {
+        this->backPressureController = std::move(backPressureController);
+    }
+
 protected:
     using MessagePtr = typename Config::message_type::ptr;
     using Server = websocketpp::server<Config>;
@@ -206,7 +260,8 @@ protected:
 
     ADD_LOGGER(WebSocketCcMessagingSkeleton)
     boost::asio::io_service& ioService;
-    std::shared_ptr<SingleThreadedIOService> webSocketPpSingleThreadedIOService;
+    std::shared_ptr<MultiThreadedIOService> webSocketPpIOService;
+    std::shared_ptr<MultiThreadedIOService> messageProcessingIOService;
     Server endpoint;
 
     virtual bool validateIncomingMessage(const ConnectionHandle& hdl,
@@ -227,41 +282,127 @@ protected:
     // List of client connections
     struct CertEntry
     {
-        CertEntry() : webSocketClientAddress(), ownerId()
+        CertEntry() : webSocketClientAddress(), ownerId(), processingStrand()
         {
         }
         explicit CertEntry(
                 const joynr::system::RoutingTypes::WebSocketClientAddress& webSocketClientAddress,
                 std::string ownerId)
-                : webSocketClientAddress(webSocketClientAddress), ownerId(std::move(ownerId))
+                : webSocketClientAddress(webSocketClientAddress),
+                  ownerId(std::move(ownerId)),
+                  processingStrand()
         {
         }
         CertEntry(CertEntry&&) = default;
         CertEntry& operator=(CertEntry&&) = default;
         joynr::system::RoutingTypes::WebSocketClientAddress webSocketClientAddress;
         std::string ownerId;
+        // keeps the incoming messages of the client in order on the message processing threads
+        std::shared_ptr<boost::asio::io_service::strand> processingStrand;
     };
 
     std::mutex clientsMutex;
     std::map<ConnectionHandle, CertEntry, std::owner_less<ConnectionHandle>> clients;
+    // shared memory channels offered by clients, used instead of the connection once initialized
+    std::map<ConnectionHandle, std::shared_ptr<ShmChannel>, std::owner_less<ConnectionHandle>>
+            sharedMemoryChannels;
+
+    struct CoalescingOffer
+    {
+        std::uint32_t maxBytes;
+        std::chrono::microseconds maxDelay;
+    };
+    // coalescing offered by clients, applied to the sender of the connection once initialized
+    std::map<ConnectionHandle, CoalescingOffer, std::owner_less<ConnectionHandle>>
+            coalescingOffers;
 
 private:
     void onConnectionClosed(ConnectionHandle hdl)
     {
-        std::lock_guard<std::mutex> lock(clientsMutex);
-        if (shuttingDown) {
+        std::shared_ptr<ShmChannel> sharedMemoryChannel;
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            if (shuttingDown) {
+                return;
+            }
+            auto channelIt = sharedMemoryChannels.find(hdl);
+            if (channelIt != sharedMemoryChannels.cend()) {
+                sharedMemoryChannel = std::move(channelIt->second);
+                sharedMemoryChannels.erase(channelIt);
+            }
+            coalescingOffers.erase(hdl);
+            auto it = clients.find(hdl);
+            if (it != clients.cend()) {
+                JOYNR_LOG_INFO(logger(),
+                               "Closed connection for websocket client id: {}",
+                               it->second.webSocketClientAddress.getId());
+                messagingStubFactory->onMessagingStubClosed(it->second.webSocketClientAddress);
+                clients.erase(it);
+            }
+        }
+        // joins the receive thread of the channel which may itself need clientsMutex
+        if (sharedMemoryChannel) {
+            sharedMemoryChannel->stop();
+        }
+    }
+
+    void onSharedMemoryOfferReceived(ConnectionHandle hdl, const std::string& offerMessage)
+    {
+        const std::string name = offerMessage.substr(ShmSegment::OFFER_MESSAGE_PREFIX().size());
+        if (!boost::starts_with(name, ShmSegment::NAME_PREFIX()) ||
+            name.find('/', 1) != std::string::npos) {
+            JOYNR_LOG_ERROR(logger(), "received shared memory offer with invalid name: {}", name);
             return;
         }
-        auto it = clients.find(hdl);
-        if (it != clients.cend()) {
-            JOYNR_LOG_INFO(logger(),
-                           "Closed connection for websocket client id: {}",
-                           it->second.webSocketClientAddress.getId());
-            messagingStubFactory->onMessagingStubClosed(it->second.webSocketClientAddress);
-            clients.erase(it);
+
+        std::unique_ptr<ShmSegment> segment;
+        try {
+            segment = ShmSegment::open(name);
+        } catch (const exceptions::JoynrRuntimeException& e) {
+            JOYNR_LOG_ERROR(logger(), "{}, client keeps using websocket", e.getMessage());
+            return;
+        }
+        segment->unlink();
+        // the client sends its initialization message as soon as it is woken up; it is handled
+        // by this thread after the channel has been stored below
+        ShmSegment& attachedSegment = *segment;
+        if (!segment->access([&attachedSegment]() { attachedSegment.markAttached(); })) {
+            JOYNR_LOG_ERROR(logger(),
+                            "shared memory {} was shrunk by the client, client keeps using "
+                            "websocket",
+                            name);
+            return;
+        }
+
+        auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
+        sender->setConnectionHandle(hdl);
+        auto sharedMemoryChannel = std::make_shared<ShmChannel>(
+                std::move(segment), ShmChannel::Side::ClusterController, std::move(sender));
+
+        JOYNR_LOG_INFO(logger(), "attached to shared memory {}", name);
+        std::shared_ptr<ShmChannel> replacedChannel;
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            replacedChannel = std::move(sharedMemoryChannels[hdl]);
+            sharedMemoryChannels[hdl] = std::move(sharedMemoryChannel);
+        }
+        if (replacedChannel) {
+            replacedChannel->stop();
         }
     }
 
+    void onCoalescingOfferReceived(ConnectionHandle hdl, const std::string& offerMessage)
+    {
+        CoalescingOffer offer;
+        if (!WebSocketCoalescingSender::parseOfferMessage(
+                    offerMessage, offer.maxBytes, offer.maxDelay)) {
+            JOYNR_LOG_ERROR(logger(), "received invalid coalescing offer: {}", offerMessage);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        coalescingOffers[hdl] = offer;
+    }
+
     void onInitMessageReceived(ConnectionHandle hdl, MessagePtr message)
     {
         using websocketpp::frame::opcode::value;
@@ -274,32 +415,80 @@ private:
             return;
         }
         const std::string& initMessage = message->get_payload();
-        if (isInitializationMessage(initMessage)) {
-            JOYNR_LOG_DEBUG(logger(),
-                            "received initialization message from websocket client: {}",
-                            initMessage);
-            // register client with messaging stub factory
-            std::shared_ptr<joynr::system::RoutingTypes::WebSocketClientAddress> clientAddress;
-            try {
-                joynr::serializer::deserializeFromJson(clientAddress, initMessage);
-            } catch (const std::invalid_argument& e) {
-                JOYNR_LOG_FATAL(
-                        logger(),
-                        "client address must be valid, otherwise libjoynr and CC are deployed "
-                        "in different versions - raw: {} - error: {}",
-                        initMessage,
-                        e.what());
-                return;
-            }
-
+        if (boost::starts_with(initMessage, ShmSegment::OFFER_MESSAGE_PREFIX())) {
+            onSharedMemoryOfferReceived(hdl, initMessage);
+            return;
+        }
+        if (boost::starts_with(initMessage, WebSocketCoalescingSender::OFFER_MESSAGE_PREFIX())) {
+            onCoalescingOfferReceived(hdl, initMessage);
+            return;
+        }
+        // register client with messaging stub factory
+        std::shared_ptr<joynr::system::RoutingTypes::WebSocketClientAddress> clientAddress =
+                IncomingMessageHelper::parseInitializationMessage(initMessage);
+        if (clientAddress) {
             JOYNR_LOG_INFO(logger(),
                            "Init connection for websocket client id: {}",
                            clientAddress->getId());
 
-            auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
-            sender->setConnectionHandle(hdl);
-
-            messagingStubFactory->addClient(*clientAddress, std::move(sender));
+            std::shared_ptr<ShmChannel> sharedMemoryChannel;
+            boost::optional<CoalescingOffer> coalescingOffer;
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                auto channelIt = sharedMemoryChannels.find(hdl);
+                if (channelIt != sharedMemoryChannels.cend()) {
+                    sharedMemoryChannel = channelIt->second;
+                }
+                auto offerIt = coalescingOffers.find(hdl);
+                if (offerIt != coalescingOffers.cend()) {
+                    coalescingOffer = offerIt->second;
+                    coalescingOffers.erase(offerIt);
+                }
+            }
+            if (sharedMemoryChannel) {
+                sharedMemoryChannel->start([
+                    thisWeakPtr = joynr::util::as_weak_ptr(this->shared_from_this()),
+                    hdl
+                ](smrf::ByteVector && msg) {
+                    if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                        ConnectionHandle connectionHandle = hdl;
+                        thisSharedPtr->onMessageReceived(std::move(connectionHandle),
+                                                         std::move(msg));
+                    }
+                });
+                messagingStubFactory->addClient(*clientAddress, std::move(sharedMemoryChannel));
+            } else if (coalescingOffer) {
+                auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
+                sender->setConnectionHandle(hdl);
+                // the accept message has to reach the client before the first coalesced frame
+                const std::string& acceptMessage = WebSocketCoalescingSender::ACCEPT_MESSAGE();
+                const smrf::ByteVector rawAcceptMessage(acceptMessage.cbegin(),
+                                                        acceptMessage.cend());
+                sender->send(smrf::ByteArrayView(rawAcceptMessage),
+                             [](const exceptions::JoynrRuntimeException& e) {
+                                 JOYNR_LOG_ERROR(logger(),
+                                                 "Sending coalescing accept message failed. "
+                                                 "Error: {}",
+                                                 e.getMessage());
+                             });
+                JOYNR_LOG_DEBUG(logger(),
+                                "coalescing messages for websocket client id {} in frames of at "
+                                "most {} bytes",
+                                clientAddress->getId(),
+                                coalescingOffer->maxBytes);
+                auto coalescingSender = std::make_shared<WebSocketCoalescingSender>(
+                        webSocketPpIOService->getIOService(),
+                        std::move(sender),
+                        coalescingOffer->maxBytes,
+                        coalescingOffer->maxDelay,
+                        true);
+                messagingStubFactory->addClient(*clientAddress, std::move(coalescingSender));
+            } else {
+                auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
+                sender->setConnectionHandle(hdl);
+
+                messagingStubFactory->addClient(*clientAddress, std::move(sender));
+            }
 
             typename Server::connection_ptr connection = endpoint.get_con_from_hdl(hdl);
             connection->set_message_handler(
@@ -319,35 +508,89 @@ private:
                 } else {
                     // insecure connection, no CN exists
                     auto certEntry = CertEntry(*clientAddress, std::string());
-                    clients[hdl] = std::move(certEntry);
+                    it = clients.emplace(hdl, std::move(certEntry)).first;
+                }
+                if (messageProcessingIOService && !it->second.processingStrand) {
+                    it->second.processingStrand = std::make_shared<boost::asio::io_service::strand>(
+                            messageProcessingIOService->getIOService());
                 }
             }
 
             messageRouter->sendQueuedMessages(std::move(clientAddress));
-        } else {
-            JOYNR_LOG_ERROR(
-                    logger(), "received an initial message with wrong format: \"{}\"", initMessage);
         }
     }
 
     void onMessageReceived(ConnectionHandle&& hdl, smrf::ByteVector&& message)
     {
-        // deserialize message and transmit
-        std::shared_ptr<ImmutableMessage> immutableMessage;
-        try {
-            immutableMessage = std::make_shared<ImmutableMessage>(std::move(message));
-        } catch (const smrf::EncodingException& e) {
-            JOYNR_LOG_ERROR(logger(), "Unable to deserialize message - error: {}", e.what());
+        std::shared_ptr<boost::asio::io_service::strand> processingStrand;
+        std::string clientId;
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            auto it = clients.find(hdl);
+            if (it != clients.cend()) {
+                processingStrand = it->second.processingStrand;
+                clientId = it->second.webSocketClientAddress.getId();
+            }
+        }
+        if (!processingStrand) {
+            processMessage(std::move(hdl), std::move(message));
+            return;
+        }
+
+        // frames waiting on the strand count against the quota of the client, otherwise a
+        // client could queue an unbounded number of frames before any of them is accounted
+        std::shared_ptr<BackPressureReservation> reservation;
+        if (backPressureController) {
+            reservation = backPressureController->reserve(clientId, message.size());
+            if (!reservation) {
+                JOYNR_LOG_ERROR(logger(),
+                                "Dropping received frame of {} bytes: quota of client {} exceeded",
+                                message.size(),
+                                clientId);
+                return;
+            }
+        }
+        processingStrand->post([
+            thisWeakPtr = joynr::util::as_weak_ptr(this->shared_from_this()),
+            hdl = std::move(hdl),
+            message = std::move(message),
+            reservation = std::move(reservation)
+        ]() mutable {
+            // the messages of the frame are accounted individually from now on
+            reservation.reset();
+            if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                thisSharedPtr->processMessage(std::move(hdl), std::move(message));
+            }
+        });
+    }
+
+    void processMessage(ConnectionHandle&& hdl, smrf::ByteVector&& message)
+    {
+        if (!MessageBatch::isBatch(message)) {
+            processSingleMessage(hdl, std::move(message));
             return;
+        }
+
+        std::vector<smrf::ByteVector> messages;
+        try {
+            messages = MessageBatch::split(message);
         } catch (const std::invalid_argument& e) {
-            JOYNR_LOG_ERROR(logger(), "deserialized message is not valid - error: {}", e.what());
+            JOYNR_LOG_ERROR(logger(), "Unable to unpack message batch - error: {}", e.what());
             return;
         }
+        JOYNR_LOG_TRACE(logger(), "received batch of {} messages", messages.size());
+        for (smrf::ByteVector& singleMessage : messages) {
+            processSingleMessage(hdl, std::move(singleMessage));
+        }
+    }
 
-        if (logger().getLogLevel() == LogLevel::Debug) {
-            JOYNR_LOG_DEBUG(logger(), "<<< INCOMING <<< {}", immutableMessage->getTrackingInfo());
-        } else {
-            JOYNR_LOG_TRACE(logger(), "<<< INCOMING <<< {}", immutableMessage->toLogMessage());
+    void processSingleMessage(const ConnectionHandle& hdl, smrf::ByteVector&& message)
+    {
+        // deserialize message and transmit
+        std::shared_ptr<ImmutableMessage> immutableMessage =
+                IncomingMessageHelper::deserialize(std::move(message));
+        if (!immutableMessage) {
+            return;
         }
 
         if (!preprocessIncomingMessage(immutableMessage)) {
@@ -360,24 +603,26 @@ private:
             return;
         }
 
-        auto onFailure = [trackingInfo = immutableMessage->getTrackingInfo()](
-                const exceptions::JoynrRuntimeException& e)
-        {
-            JOYNR_LOG_ERROR(logger(),
-                            "Incoming Message {} could not be sent! reason: {}",
-                            trackingInfo,
-                            e.getMessage());
-        };
-        transmit(std::move(immutableMessage), std::move(onFailure));
-    }
+        if (backPressureController) {
+            std::string clientId;
+            {
+                std::lock_guard<std::mutex> lock(clientsMutex);
+                auto it = clients.find(hdl);
+                if (it != clients.cend()) {
+                    clientId = it->second.webSocketClientAddress.getId();
+                }
+            }
+            if (!IncomingMessageHelper::reserve(
+                        *backPressureController, clientId, *immutableMessage)) {
+                return;
+            }
+        }
 
-    bool isInitializationMessage(const std::string& message)
-    {
-        return boost::starts_with(
-                message, "{\"_typeName\":\"joynr.system.RoutingTypes.WebSocketClientAddress\"");
+        auto onFailure = IncomingMessageHelper::createOnFailure(*immutableMessage);
+        transmit(std::move(immutableMessage), std::move(onFailure));
     }
 
-    std::shared_ptr<Semaphore> webSocketPpSingleThreadedIOServiceDestructed;
+    std::shared_ptr<Semaphore> webSocketPpIOServiceDestructed;
     WebSocketPpReceiver<Server> receiver;
 
     /*! Router for incoming messages */
@@ -386,6 +631,7 @@ private:
     std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory;
     std::uint16_t port;
     std::atomic<bool> shuttingDown;
+    std::shared_ptr<BackPressureController> backPressureController;
 
     DISALLOW_COPY_AND_ASSIGN(WebSocketCcMessagingSkeleton);
 };
@@ -34,11 +34,16 @@ public:
             boost::asio::io_service& ioService,
             std::shared_ptr<IMessageRouter> messageRouter,
             std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory,
-            const system::RoutingTypes::WebSocketAddress& serverAddress)
-            : WebSocketCcMessagingSkeleton<websocketpp::config::asio>(ioService,
-                                                                      messageRouter,
-                                                                      messagingStubFactory,
-                                                                      serverAddress.getPort())
+            const system::RoutingTypes::WebSocketAddress& serverAddress,
+            std::size_t numberOfIoThreads,
+            std::size_t numberOfMessageProcessingThreads)
+            : WebSocketCcMessagingSkeleton<websocketpp::config::asio>(
+                      ioService,
+                      messageRouter,
+                      messagingStubFactory,
+                      serverAddress.getPort(),
+                      numberOfIoThreads,
+                      numberOfMessageProcessingThreads)
     {
     }
 
@@ -32,12 +32,16 @@ WebSocketCcMessagingSkeletonTLS::WebSocketCcMessagingSkeletonTLS(
         const std::string& caPemFile,
         const std::string& certPemFile,
         const std::string& privateKeyPemFile,
-        bool useEncryptedTls)
+        bool useEncryptedTls,
+        std::size_t numberOfIoThreads,
+        std::size_t numberOfMessageProcessingThreads)
         : WebSocketCcMessagingSkeleton<websocketpp::config::asio_tls>(
                   ioService,
                   std::move(messageRouter),
                   std::move(messagingStubFactory),
-                  serverAddress.getPort()),
+                  serverAddress.getPort(),
+                  numberOfIoThreads,
+                  numberOfMessageProcessingThreads),
           useEncryptedTls{useEncryptedTls},
           caPemFile(caPemFile),
           certPemFile(certPemFile),
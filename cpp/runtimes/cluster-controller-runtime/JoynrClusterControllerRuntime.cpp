@@ -27,6 +27,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem.hpp>
 
+#include "joynr/BackPressureController.h"
 #include "joynr/BrokerUrl.h"
 #include "joynr/CapabilitiesRegistrar.h"
 #include "joynr/CcMessageRouter.h"
@@ -55,6 +56,7 @@
 #include "joynr/PublicationManager.h"
 #include "joynr/Settings.h"
 #include "joynr/SingleThreadedIOService.h"
+#include "joynr/StartupStages.h"
 #include "joynr/SubscriptionManager.h"
 #include "joynr/SystemServicesSettings.h"
 #include "joynr/exceptions/JoynrException.h"
@@ -82,6 +84,7 @@
 #include "libjoynrclustercontroller/access-control/AccessControlListEditor.h"
 #include "libjoynrclustercontroller/access-control/LocalDomainAccessController.h"
 #include "libjoynrclustercontroller/access-control/LocalDomainAccessStore.h"
+#include "libjoynrclustercontroller/capabilities-client/BatchingCapabilitiesClient.h"
 #include "libjoynrclustercontroller/capabilities-client/CapabilitiesClient.h"
 #include "libjoynrclustercontroller/http-communication-manager/HttpMessagingSkeleton.h"
 #include "libjoynrclustercontroller/http-communication-manager/HttpReceiver.h"
@@ -90,12 +93,14 @@
 #include "libjoynrclustercontroller/messaging/joynr-messaging/HttpMessagingStubFactory.h"
 #include "libjoynrclustercontroller/messaging/joynr-messaging/MqttMessagingStubFactory.h"
 #include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+#include "joynr/MqttIngressQueue.h"
 #include "joynr/MqttMessagingSkeleton.h"
 #include "joynr/MqttReceiver.h"
 #include "libjoynrclustercontroller/mqtt/MqttSender.h"
 #include "libjoynrclustercontroller/mqtt/MqttTransportStatus.h"
 #include "libjoynrclustercontroller/websocket/WebSocketCcMessagingSkeletonNonTLS.h"
 #include "libjoynrclustercontroller/websocket/WebSocketCcMessagingSkeletonTLS.h"
+#include "libjoynrclustercontroller/uds/UdsCcMessagingSkeleton.h"
 #include "libjoynrclustercontroller/ClusterControllerCallContextStorage.h"
 #include "libjoynrclustercontroller/ClusterControllerCallContext.h"
 
@@ -120,10 +125,12 @@ JoynrClusterControllerRuntime::JoynrClusterControllerRuntime(
           httpMessageSender(httpMessageSender),
           httpMessagingSkeleton(nullptr),
           mosquittoConnection(nullptr),
+          mqttPublishConnections(),
           mqttMessageReceiver(mqttMessageReceiver),
           mqttMessageSender(mqttMessageSender),
           mqttMessagingSkeletonFactory(std::move(mqttMessagingSkeletonFactory)),
           mqttMessagingSkeleton(nullptr),
+          mqttIngressQueue(nullptr),
           dispatcherList(),
           settings(std::move(settings)),
           libjoynrSettings(*(this->settings)),
@@ -132,6 +139,8 @@ JoynrClusterControllerRuntime::JoynrClusterControllerRuntime(
           wsSettings(*(this->settings)),
           wsCcMessagingSkeleton(nullptr),
           wsTLSCcMessagingSkeleton(nullptr),
+          udsCcMessagingSkeleton(nullptr),
+          backPressureController(nullptr),
           httpMessagingIsRunning(false),
           mqttMessagingIsRunning(false),
           doMqttMessaging(false),
@@ -251,11 +260,6 @@ void JoynrClusterControllerRuntime::init()
                 brokerProtocol);
     }
 
-    std::string capabilitiesDirectoryChannelId =
-            messagingSettings.getCapabilitiesDirectoryChannelId();
-    std::string capabilitiesDirectoryParticipantId =
-            messagingSettings.getCapabilitiesDirectoryParticipantId();
-
     // Initialise security manager
     std::unique_ptr<IPlatformSecurityManager> securityManager =
             std::make_unique<DummyPlatformSecurityManager>();
@@ -295,6 +299,16 @@ void JoynrClusterControllerRuntime::init()
                 mosquittoConnection = std::make_shared<MosquittoConnection>(
                         messagingSettings, clusterControllerSettings, mqttCliendId);
 
+                for (std::uint32_t i = 0; i < messagingSettings.getMqttPublishConnections();
+                     ++i) {
+                    const bool isPublishOnly = true;
+                    mqttPublishConnections.push_back(std::make_shared<MosquittoConnection>(
+                            messagingSettings,
+                            clusterControllerSettings,
+                            mqttCliendId + "-pub" + std::to_string(i),
+                            isPublishOnly));
+                }
+
                 auto mqttTransportStatus =
                         std::make_unique<MqttTransportStatus>(mosquittoConnection);
                 transportStatuses.emplace_back(std::move(mqttTransportStatus));
@@ -351,38 +365,19 @@ void JoynrClusterControllerRuntime::init()
             getGlobalClusterControllerAddress());
 
     ccMessageRouter->init();
-    if (libjoynrSettings.isMessageRouterPersistencyEnabled()) {
-        ccMessageRouter->loadRoutingTable(libjoynrSettings.getMessageRouterPersistenceFilename());
-    }
-    ccMessageRouter->loadMulticastReceiverDirectory(
-            clusterControllerSettings.getMulticastReceiverDirectoryPersistenceFilename());
 
-    // provision global capabilities directory
-    bool isGloballyVisible = true;
-    if (boost::starts_with(capabilitiesDirectoryChannelId, "{")) {
-        try {
-            using system::RoutingTypes::MqttAddress;
-            auto globalCapabilitiesDirectoryAddress = std::make_shared<MqttAddress>();
-            joynr::serializer::deserializeFromJson(
-                    *globalCapabilitiesDirectoryAddress, capabilitiesDirectoryChannelId);
-            ccMessageRouter->addProvisionedNextHop(capabilitiesDirectoryParticipantId,
-                                                   std::move(globalCapabilitiesDirectoryAddress),
-                                                   isGloballyVisible);
-        } catch (const std::invalid_argument& e) {
-            JOYNR_LOG_FATAL(logger(),
-                            "could not deserialize MqttAddress from {} - error: {}",
-                            capabilitiesDirectoryChannelId,
-                            e.what());
-        }
-    } else {
-        auto globalCapabilitiesDirectoryAddress =
-                std::make_shared<const joynr::system::RoutingTypes::ChannelAddress>(
-                        messagingSettings.getCapabilitiesDirectoryUrl() +
-                                capabilitiesDirectoryChannelId + "/",
-                        capabilitiesDirectoryChannelId);
-        ccMessageRouter->addProvisionedNextHop(capabilitiesDirectoryParticipantId,
-                                               std::move(globalCapabilitiesDirectoryAddress),
-                                               isGloballyVisible);
+    const BackPressurePolicy::Enum backPressurePolicy =
+            BackPressurePolicy::getEnum(messagingSettings.getBackPressurePolicy());
+    if (backPressurePolicy != BackPressurePolicy::Enum::DISABLED ||
+        clusterControllerSettings.getPerClientMessageQuotaBytes() > 0) {
+        backPressureController = std::make_shared<BackPressureController>(
+                backPressurePolicy,
+                messagingSettings.getBackPressureHighWatermarkBytes(),
+                messagingSettings.getBackPressureLowWatermarkBytes(),
+                std::chrono::milliseconds(messagingSettings.getBackPressureMaxBlockingTimeMs()),
+                singleThreadIOService->getIOService(),
+                clusterControllerSettings.getPerClientMessageQuotaBytes());
+        ccMessageRouter->setBackPressureController(backPressureController);
     }
 
     // setup CC WebSocket interface
@@ -396,8 +391,10 @@ void JoynrClusterControllerRuntime::init()
 
     /* LibJoynr */
     assert(ccMessageRouter);
-    messageSender = std::make_shared<MessageSender>(
-            ccMessageRouter, keyChain, messagingSettings.getTtlUpliftMs());
+    messageSender = std::make_shared<MessageSender>(ccMessageRouter,
+                                                    keyChain,
+                                                    messagingSettings.getTtlUpliftMs(),
+                                                    backPressureController);
     joynrDispatcher =
             std::make_shared<Dispatcher>(messageSender, singleThreadIOService->getIOService());
     messageSender->registerDispatcher(joynrDispatcher);
@@ -460,11 +457,29 @@ void JoynrClusterControllerRuntime::init()
                     messagingSettings.getTtlUpliftMs());
 
             auto mqttMessagingSkeletonCopyForCapturing = mqttMessagingSkeleton;
-            mqttMessageReceiver
-                    ->registerReceiveCallback([mqttMessagingSkeleton =
-                                                       mqttMessagingSkeletonCopyForCapturing](
-                            smrf::ByteVector &&
-                            msg) { mqttMessagingSkeleton->onMessageReceived(std::move(msg)); });
+            if (clusterControllerSettings.getMqttIngressQueueSize() > 0) {
+                // keep the mosquitto loop thread free from routing
+                mqttIngressQueue = std::make_shared<MqttIngressQueue>(
+                        clusterControllerSettings.getMqttIngressQueueSize(),
+                        clusterControllerSettings.getMqttIngressWorkerThreads(),
+                        MqttIngressOverflowPolicy::getEnum(
+                                clusterControllerSettings.getMqttIngressOverflowPolicy()),
+                        [mqttMessagingSkeleton = mqttMessagingSkeletonCopyForCapturing](
+                                smrf::ByteVector && msg) {
+                            mqttMessagingSkeleton->onMessageReceived(std::move(msg));
+                        });
+                mqttIngressQueue->start();
+                mqttMessageReceiver->registerReceiveCallback(
+                        [mqttIngressQueue = mqttIngressQueue](smrf::ByteVector && msg) {
+                            mqttIngressQueue->push(std::move(msg));
+                        });
+            } else {
+                mqttMessageReceiver->registerReceiveCallback(
+                        [mqttMessagingSkeleton = mqttMessagingSkeletonCopyForCapturing](
+                                smrf::ByteVector && msg) {
+                            mqttMessagingSkeleton->onMessageReceived(std::move(msg));
+                        });
+            }
             multicastMessagingSkeletonDirectory
                     ->registerSkeleton<system::RoutingTypes::MqttAddress>(mqttMessagingSkeleton);
         }
@@ -475,8 +490,8 @@ void JoynrClusterControllerRuntime::init()
                             "The mqtt message sender supplied is NULL, creating the default "
                             "mqtt MessageSender");
 
-            mqttMessageSender =
-                    std::make_shared<MqttSender>(mosquittoConnection, messagingSettings);
+            mqttMessageSender = std::make_shared<MqttSender>(
+                    mosquittoConnection, messagingSettings, mqttPublishConnections);
         }
 
         messagingStubFactory->registerStubFactory(
@@ -492,10 +507,6 @@ void JoynrClusterControllerRuntime::init()
             messageSender,
             libjoynrSettings.isSubscriptionPersistencyEnabled(),
             messagingSettings.getTtlUpliftMs());
-    publicationManager->loadSavedAttributeSubscriptionRequestsMap(
-            libjoynrSettings.getSubscriptionRequestPersistenceFilename());
-    publicationManager->loadSavedBroadcastSubscriptionRequestsMap(
-            libjoynrSettings.getBroadcastSubscriptionRequestPersistenceFilename());
 
     subscriptionManager = std::make_shared<SubscriptionManager>(
             singleThreadIOService->getIOService(), ccMessageRouter);
@@ -509,23 +520,71 @@ void JoynrClusterControllerRuntime::init()
 
     dispatcherList.push_back(joynrDispatcher);
 
-    // Set up the persistence file for storing provider participant ids
-    std::string persistenceFilename = libjoynrSettings.getParticipantIdsPersistenceFilename();
-    participantIdStorage = std::make_shared<ParticipantIdStorage>(persistenceFilename);
-
     auto provisionedDiscoveryEntries = getProvisionedEntries();
     discoveryProxy = std::make_shared<LocalDiscoveryAggregator>(provisionedDiscoveryEntries);
 
     auto capabilitiesClient = std::make_shared<CapabilitiesClient>(clusterControllerSettings);
+    std::shared_ptr<ICapabilitiesClient> globalCapabilitiesClient = capabilitiesClient;
+    const std::chrono::milliseconds globalCapabilitiesDirectoryBatchWindow =
+            clusterControllerSettings.getGlobalCapabilitiesDirectoryBatchWindowMs();
+    if (globalCapabilitiesDirectoryBatchWindow.count() > 0) {
+        batchingCapabilitiesClient = std::make_shared<BatchingCapabilitiesClient>(
+                capabilitiesClient,
+                singleThreadIOService->getIOService(),
+                globalCapabilitiesDirectoryBatchWindow);
+        globalCapabilitiesClient = batchingCapabilitiesClient;
+    }
     localCapabilitiesDirectory =
             std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
-                                                         capabilitiesClient,
+                                                         globalCapabilitiesClient,
                                                          globalClusterControllerAddress,
                                                          ccMessageRouter,
                                                          singleThreadIOService->getIOService(),
                                                          clusterControllerId);
     localCapabilitiesDirectory->init();
-    localCapabilitiesDirectory->loadPersistedFile();
+
+    // the persisted state is spread over independent files, which are loaded in parallel
+    std::shared_ptr<LocalDomainAccessStore> localDomainAccessStore;
+    StartupStages persistenceStages(
+            "ClusterControllerRuntime", StartupStages::getDefaultMaxParallelStages());
+    persistenceStages.add("routingTable", {}, [this]() {
+        if (libjoynrSettings.isMessageRouterPersistencyEnabled()) {
+            ccMessageRouter->loadRoutingTable(
+                    libjoynrSettings.getMessageRouterPersistenceFilename());
+        }
+    });
+    // provisioned addresses replace persisted ones
+    persistenceStages.add("globalCapabilitiesDirectoryAddress",
+                          {"routingTable"},
+                          [this]() { provisionGlobalCapabilitiesDirectoryAddress(); });
+    persistenceStages.add("multicastReceiverDirectory", {"routingTable"}, [this]() {
+        ccMessageRouter->loadMulticastReceiverDirectory(
+                clusterControllerSettings.getMulticastReceiverDirectoryPersistenceFilename());
+    });
+    persistenceStages.add("attributeSubscriptions", {}, [this]() {
+        publicationManager->loadSavedAttributeSubscriptionRequestsMap(
+                libjoynrSettings.getSubscriptionRequestPersistenceFilename());
+    });
+    persistenceStages.add("broadcastSubscriptions", {}, [this]() {
+        publicationManager->loadSavedBroadcastSubscriptionRequestsMap(
+                libjoynrSettings.getBroadcastSubscriptionRequestPersistenceFilename());
+    });
+    persistenceStages.add("participantIds", {}, [this]() {
+        // Set up the persistence file for storing provider participant ids
+        participantIdStorage = std::make_shared<ParticipantIdStorage>(
+                libjoynrSettings.getParticipantIdsPersistenceFilename());
+    });
+    persistenceStages.add(
+            "localCapabilities", {}, [this]() { localCapabilitiesDirectory->loadPersistedFile(); });
+    if (clusterControllerSettings.enableAccessController()) {
+        persistenceStages.add("accessControlEntries", {}, [this, &localDomainAccessStore]() {
+            localDomainAccessStore = loadLocalDomainAccessStore();
+        });
+    }
+    persistenceStages.run();
+
+    // proxies for providers registered at this cluster controller are built without arbitration
+    discoveryProxy->setLocalParticipantLookup(localCapabilitiesDirectory);
     // importPersistedLocalCapabilitiesDirectory();
 
     std::string discoveryProviderParticipantId(
@@ -585,11 +644,46 @@ void JoynrClusterControllerRuntime::init()
     capabilitiesClient->setProxy(capabilitiesProxyBuilder->build(), messagingQos);
 
     // Do this after local capabilities directory and message router have been initialized.
-    enableAccessController(provisionedDiscoveryEntries);
+    enableAccessController(provisionedDiscoveryEntries, std::move(localDomainAccessStore));
 
     registerInternalSystemServiceProviders();
 }
 
+void JoynrClusterControllerRuntime::provisionGlobalCapabilitiesDirectoryAddress()
+{
+    const std::string capabilitiesDirectoryChannelId =
+            messagingSettings.getCapabilitiesDirectoryChannelId();
+    const std::string capabilitiesDirectoryParticipantId =
+            messagingSettings.getCapabilitiesDirectoryParticipantId();
+
+    bool isGloballyVisible = true;
+    if (boost::starts_with(capabilitiesDirectoryChannelId, "{")) {
+        try {
+            using system::RoutingTypes::MqttAddress;
+            auto globalCapabilitiesDirectoryAddress = std::make_shared<MqttAddress>();
+            joynr::serializer::deserializeFromJson(
+                    *globalCapabilitiesDirectoryAddress, capabilitiesDirectoryChannelId);
+            ccMessageRouter->addProvisionedNextHop(capabilitiesDirectoryParticipantId,
+                                                   std::move(globalCapabilitiesDirectoryAddress),
+                                                   isGloballyVisible);
+        } catch (const std::invalid_argument& e) {
+            JOYNR_LOG_FATAL(logger(),
+                            "could not deserialize MqttAddress from {} - error: {}",
+                            capabilitiesDirectoryChannelId,
+                            e.what());
+        }
+    } else {
+        auto globalCapabilitiesDirectoryAddress =
+                std::make_shared<const joynr::system::RoutingTypes::ChannelAddress>(
+                        messagingSettings.getCapabilitiesDirectoryUrl() +
+                                capabilitiesDirectoryChannelId + "/",
+                        capabilitiesDirectoryChannelId);
+        ccMessageRouter->addProvisionedNextHop(capabilitiesDirectoryParticipantId,
+                                               std::move(globalCapabilitiesDirectoryAddress),
+                                               isGloballyVisible);
+    }
+}
+
 std::shared_ptr<IMessageRouter> JoynrClusterControllerRuntime::getMessageRouter()
 {
     return ccMessageRouter;
@@ -642,13 +736,8 @@ std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo> JoynrClusterCont
     return provisionedDiscoveryEntries;
 }
 
-void JoynrClusterControllerRuntime::enableAccessController(
-        const std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo>& provisionedEntries)
+std::shared_ptr<LocalDomainAccessStore> JoynrClusterControllerRuntime::loadLocalDomainAccessStore()
 {
-    if (!clusterControllerSettings.enableAccessController()) {
-        return;
-    }
-
     JOYNR_LOG_INFO(logger(),
                    "Access control was enabled attempting to load entries from {}.",
                    clusterControllerSettings.getAclEntriesDirectory());
@@ -672,6 +761,17 @@ void JoynrClusterControllerRuntime::enableAccessController(
         JOYNR_LOG_ERROR(
                 logger(), "Access control directory: {} does not exist.", aclEntriesPath.string());
     }
+    return localDomainAccessStore;
+}
+
+void JoynrClusterControllerRuntime::enableAccessController(
+        const std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo>& provisionedEntries,
+        std::shared_ptr<LocalDomainAccessStore> localDomainAccessStore)
+{
+    if (!clusterControllerSettings.enableAccessController()) {
+        return;
+    }
+    assert(localDomainAccessStore);
 
     localDomainAccessController = std::make_shared<joynr::LocalDomainAccessController>(
             localDomainAccessStore, clusterControllerSettings.getUseOnlyLDAS());
@@ -749,26 +849,37 @@ void JoynrClusterControllerRuntime::registerInternalSystemServiceProviders()
 
     ClusterControllerCallContextStorage::set(std::move(clusterControllerCallContext));
 
-    discoveryProviderParticipantId = registerInternalSystemServiceProvider(
+    // all internal providers are registered as one batch
+    std::vector<ProviderRegistration> registrations;
+    registrations.push_back(createInternalSystemServiceProviderRegistration(
             std::dynamic_pointer_cast<joynr::system::DiscoveryProvider>(localCapabilitiesDirectory),
-            systemServicesSettings.getCcDiscoveryProviderParticipantId());
-    routingProviderParticipantId = registerInternalSystemServiceProvider(
+            systemServicesSettings.getCcDiscoveryProviderParticipantId()));
+    registrations.push_back(createInternalSystemServiceProviderRegistration(
             std::dynamic_pointer_cast<joynr::system::RoutingProvider>(ccMessageRouter),
-            systemServicesSettings.getCcRoutingProviderParticipantId());
-    providerReregistrationControllerParticipantId = registerInternalSystemServiceProvider(
+            systemServicesSettings.getCcRoutingProviderParticipantId()));
+    registrations.push_back(createInternalSystemServiceProviderRegistration(
             std::dynamic_pointer_cast<joynr::system::ProviderReregistrationControllerProvider>(
                     localCapabilitiesDirectory),
-            providerReregistrationControllerParticipantId);
-    messageNotificationProviderParticipantId = registerInternalSystemServiceProvider(
+            providerReregistrationControllerParticipantId));
+    registrations.push_back(createInternalSystemServiceProviderRegistration(
             std::dynamic_pointer_cast<joynr::system::MessageNotificationProvider>(
                     ccMessageRouter->getMessageNotificationProvider()),
-            systemServicesSettings.getCcMessageNotificationProviderParticipantId());
+            systemServicesSettings.getCcMessageNotificationProviderParticipantId()));
 
     if (clusterControllerSettings.enableAccessController()) {
-        accessControlListEditorProviderParticipantId = registerInternalSystemServiceProvider(
+        registrations.push_back(createInternalSystemServiceProviderRegistration(
                 std::dynamic_pointer_cast<joynr::infrastructure::AccessControlListEditorProvider>(
                         aclEditor),
-                systemServicesSettings.getCcAccessControlListEditorProviderParticipantId());
+                systemServicesSettings.getCcAccessControlListEditorProviderParticipantId()));
+    }
+
+    const std::vector<std::string> participantIds = registerProviders(std::move(registrations));
+    discoveryProviderParticipantId = participantIds[0];
+    routingProviderParticipantId = participantIds[1];
+    providerReregistrationControllerParticipantId = participantIds[2];
+    messageNotificationProviderParticipantId = participantIds[3];
+    if (clusterControllerSettings.enableAccessController()) {
+        accessControlListEditorProviderParticipantId = participantIds[4];
     }
 
     ClusterControllerCallContextStorage::invalidate();
@@ -825,7 +936,10 @@ void JoynrClusterControllerRuntime::startLocalCommunication()
                     certificateAuthorityPemFilename,
                     certificatePemFilename,
                     privateKeyPemFilename,
-                    useEncryptedTls);
+                    useEncryptedTls,
+                    clusterControllerSettings.getWsIoThreads(),
+                    clusterControllerSettings.getWsMessageProcessingThreads());
+            wsTLSCcMessagingSkeleton->setBackPressureController(backPressureController);
             wsTLSCcMessagingSkeleton->init();
         }
     }
@@ -841,9 +955,23 @@ void JoynrClusterControllerRuntime::startLocalCommunication()
                 singleThreadIOService->getIOService(),
                 ccMessageRouter,
                 wsMessagingStubFactory,
-                wsAddress);
+                wsAddress,
+                clusterControllerSettings.getWsIoThreads(),
+                clusterControllerSettings.getWsMessageProcessingThreads());
+        wsCcMessagingSkeleton->setBackPressureController(backPressureController);
         wsCcMessagingSkeleton->init();
     }
+
+    if (clusterControllerSettings.isUdsPathSet()) {
+        // libjoynr runtimes connected via UDS are addressed by their WebSocketClientAddress,
+        // hence they share the WebSocket messaging stub factory
+        udsCcMessagingSkeleton = std::make_shared<UdsCcMessagingSkeleton>(
+                ccMessageRouter,
+                wsMessagingStubFactory,
+                UdsAddress(clusterControllerSettings.getUdsPath()));
+        udsCcMessagingSkeleton->setBackPressureController(backPressureController);
+        udsCcMessagingSkeleton->init();
+    }
 }
 
 JoynrClusterControllerRuntime::~JoynrClusterControllerRuntime()
@@ -867,7 +995,17 @@ void JoynrClusterControllerRuntime::startExternalCommunication()
     }
     if (doMqttMessaging) {
         if (mosquittoConnection && !mqttMessagingIsRunning) {
-            mosquittoConnection->start();
+            // starting a connection blocks while the broker is resolved and connected
+            StartupStages connectionStages("MqttConnections", 1 + mqttPublishConnections.size());
+            connectionStages.add("mqttConnection", {}, [this]() { mosquittoConnection->start(); });
+            for (std::size_t i = 0; i < mqttPublishConnections.size(); ++i) {
+                connectionStages.add("mqttPublishConnection" + std::to_string(i),
+                                     {},
+                                     [mqttPublishConnection = mqttPublishConnections[i]]() {
+                                         mqttPublishConnection->start();
+                                     });
+            }
+            connectionStages.run();
             mqttMessagingIsRunning = true;
         }
     }
@@ -885,6 +1023,9 @@ void JoynrClusterControllerRuntime::stopExternalCommunication()
     if (doMqttMessaging) {
         if (mosquittoConnection && mqttMessagingIsRunning) {
             mosquittoConnection->stop();
+            for (const auto& mqttPublishConnection : mqttPublishConnections) {
+                mqttPublishConnection->stop();
+            }
             mqttMessagingIsRunning = false;
         }
     }
@@ -907,9 +1048,23 @@ void JoynrClusterControllerRuntime::shutdown()
     if (wsTLSCcMessagingSkeleton) {
         wsTLSCcMessagingSkeleton->shutdown();
     }
+    if (udsCcMessagingSkeleton) {
+        udsCcMessagingSkeleton->shutdown();
+    }
 
     unregisterInternalSystemServiceProviders();
 
+    // the requests still pending in the batch window must be sent while the message router runs
+    if (batchingCapabilitiesClient) {
+        batchingCapabilitiesClient->shutdown();
+    }
+
+    // the workers must not route into the stopped message router, messages received until the
+    // broker connection is stopped are dropped
+    if (mqttIngressQueue) {
+        mqttIngressQueue->stop();
+    }
+
     if (ccMessageRouter) {
         ccMessageRouter->shutdown();
     }
@@ -968,8 +1123,11 @@ std::shared_ptr<JoynrClusterControllerRuntime> JoynrClusterControllerRuntime::cr
 void JoynrClusterControllerRuntime::start()
 {
     singleThreadIOService->start();
-    startLocalCommunication();
-    startExternalCommunication();
+    // the servers for local runtimes and the broker connections do not depend on each other
+    StartupStages transportStages("ClusterControllerRuntime", 2);
+    transportStages.add("localCommunication", {}, [this]() { startLocalCommunication(); });
+    transportStages.add("externalCommunication", {}, [this]() { startExternalCommunication(); });
+    transportStages.run();
 }
 
 void JoynrClusterControllerRuntime::stop(bool deleteHttpChannel)
@@ -44,6 +44,7 @@ namespace joynr
 class AccessController;
 class AccessControlListEditor;
 class LocalCapabilitiesDirectory;
+class BatchingCapabilitiesClient;
 class ILocalChannelUrlDirectory;
 class ITransportMessageReceiver;
 class ITransportMessageSender;
@@ -53,6 +54,7 @@ class IDispatcher;
 class InProcessMessagingSkeleton;
 class HttpMessagingSkeleton;
 class IMqttMessagingSkeleton;
+class MqttIngressQueue;
 class MqttReceiver;
 class MulticastMessagingSkeletonDirectory;
 class IPlatformSecurityManager;
@@ -60,10 +62,13 @@ class Settings;
 class IMessageRouter;
 class IMessageSender;
 class IWebsocketCcMessagingSkeleton;
+class UdsCcMessagingSkeleton;
+class BackPressureController;
 class CcMessageRouter;
 class WebSocketMessagingStubFactory;
 class MosquittoConnection;
 class LocalDomainAccessController;
+class LocalDomainAccessStore;
 
 namespace infrastructure
 {
@@ -147,6 +152,7 @@ protected:
     std::shared_ptr<IMessageSender> messageSender;
 
     std::shared_ptr<LocalCapabilitiesDirectory> localCapabilitiesDirectory;
+    std::shared_ptr<BatchingCapabilitiesClient> batchingCapabilitiesClient;
 
     std::shared_ptr<InProcessMessagingSkeleton> libJoynrMessagingSkeleton;
 
@@ -155,10 +161,13 @@ protected:
     std::shared_ptr<HttpMessagingSkeleton> httpMessagingSkeleton;
 
     std::shared_ptr<MosquittoConnection> mosquittoConnection;
+    // additional connections for publishing only, see MessagingSettings::getMqttPublishConnections
+    std::vector<std::shared_ptr<MosquittoConnection>> mqttPublishConnections;
     std::shared_ptr<ITransportMessageReceiver> mqttMessageReceiver;
     std::shared_ptr<ITransportMessageSender> mqttMessageSender;
     MqttMessagingSkeletonFactory mqttMessagingSkeletonFactory;
     std::shared_ptr<IMqttMessagingSkeleton> mqttMessagingSkeleton;
+    std::shared_ptr<MqttIngressQueue> mqttIngressQueue;
 
     std::vector<std::shared_ptr<IDispatcher>> dispatcherList;
 
@@ -170,6 +179,8 @@ protected:
     WebSocketSettings wsSettings;
     std::shared_ptr<IWebsocketCcMessagingSkeleton> wsCcMessagingSkeleton;
     std::shared_ptr<IWebsocketCcMessagingSkeleton> wsTLSCcMessagingSkeleton;
+    std::shared_ptr<UdsCcMessagingSkeleton> udsCcMessagingSkeleton;
+    std::shared_ptr<BackPressureController> backPressureController;
     bool httpMessagingIsRunning;
     bool mqttMessagingIsRunning;
     bool doMqttMessaging;
@@ -180,8 +191,9 @@ protected:
 
 private:
     template <typename T>
-    std::string registerInternalSystemServiceProvider(std::shared_ptr<T> provider,
-                                                      const std::string& participantId)
+    ProviderRegistration createInternalSystemServiceProviderRegistration(
+            std::shared_ptr<T> provider,
+            const std::string& participantId)
     {
         const std::string domain(systemServicesSettings.getDomain());
         const std::string interfaceName(T::INTERFACE_NAME());
@@ -198,7 +210,7 @@ private:
         systemProviderQos.setScope(joynr::types::ProviderScope::LOCAL);
         systemProviderQos.setSupportsOnChangeSubscriptions(false);
 
-        return registerProvider(domain, provider, systemProviderQos);
+        return createProviderRegistration(domain, provider, systemProviderQos);
     }
 
     void registerInternalSystemServiceProviders();
@@ -208,6 +220,7 @@ private:
     std::shared_ptr<joynr::infrastructure::GlobalDomainAccessControllerProxy>
     createGlobalDomainAccessControllerProxy();
     std::string getSerializedGlobalClusterControllerAddress() const;
+    void provisionGlobalCapabilitiesDirectoryAddress();
     const system::RoutingTypes::Address& getGlobalClusterControllerAddress() const;
 
     DISALLOW_COPY_AND_ASSIGN(JoynrClusterControllerRuntime);
@@ -216,8 +229,10 @@ private:
     std::shared_ptr<CcMessageRouter> ccMessageRouter;
     std::shared_ptr<AccessControlListEditor> aclEditor;
 
+    std::shared_ptr<LocalDomainAccessStore> loadLocalDomainAccessStore();
     void enableAccessController(
-            const std::map<std::string, types::DiscoveryEntryWithMetaInfo>& provisionedEntries);
+            const std::map<std::string, types::DiscoveryEntryWithMetaInfo>& provisionedEntries,
+            std::shared_ptr<LocalDomainAccessStore> localDomainAccessStore);
     friend class ::JoynrClusterControllerRuntimeTest;
 
     Semaphore lifetimeSemaphore;
@@ -125,6 +125,101 @@ public:
         return participiantId;
     }
 
+    /**
+     * @brief Prepares the registration of a provider as part of a batch, see
+     * registerProvidersAsync.
+     * @tparam TIntfProvider The interface class of the provider to register. The corresponding
+     * template parameter of a Franca interface called "MyDemoIntf" is "MyDemoIntfProvider".
+     * @param domain The domain to register the provider on. Has to be
+     * identical at the client to be able to find the provider.
+     * @param provider The provider instance to register.
+     * @param providerQos The qos associated with the registered provider.
+     */
+    template <class TIntfProvider>
+    ProviderRegistration createProviderRegistration(const std::string& domain,
+                                                    std::shared_ptr<TIntfProvider> provider,
+                                                    const joynr::types::ProviderQos& providerQos)
+    {
+        return runtimeImpl->createProviderRegistration(domain, std::move(provider), providerQos);
+    }
+
+    /**
+     * @brief Registers many providers with the joynr communication framework asynchronously.
+     *
+     * Compared to registering the providers one by one, the participant IDs are persisted, the
+     * routing entries are added and the discovery entries are registered once for the whole batch.
+     * If any provider of the batch cannot be registered, onError is invoked for the batch.
+     * @param registrations The providers to register, see createProviderRegistration.
+     * @param onSucess: Will be invoked when all providers have been registered.
+     * @param onError: Will be invoked when the providers could not be registered. An exception,
+     * which describes the error, is passed as the parameter.
+     * @param persist if set to true, participant IDs of the providers will be persisted,
+     * otherwise they will not; default is true
+     * @param awaitGlobalRegistration if set to true, onSuccess will be invoked only after global
+     * registration succeeded, respectively onError will be invoked only after global registration
+     * failed; default is false
+     * @return The globally unique participant IDs of the providers in the order of the
+     * registrations.
+     */
+    std::vector<std::string> registerProvidersAsync(
+            std::vector<ProviderRegistration> registrations,
+            std::function<void()> onSuccess,
+            std::function<void(const exceptions::JoynrRuntimeException&)> onError,
+            bool persist = true,
+            bool awaitGlobalRegistration = false) noexcept
+    {
+        return runtimeImpl->registerProvidersAsync(std::move(registrations),
+                                                   std::move(onSuccess),
+                                                   std::move(onError),
+                                                   persist,
+                                                   awaitGlobalRegistration);
+    }
+
+    /**
+     * @brief Registers many providers with the joynr communication framework, see
+     * registerProvidersAsync.
+     * @param registrations The providers to register, see createProviderRegistration.
+     * @param persist if set to true, participant IDs of the providers will be persisted,
+     * otherwise they will not; default is true
+     * @param awaitGlobalRegistration if set to true, method will block until global registration
+     * succeeded, respectively it will throw an exception in case global registration failed;
+     * default is false
+     * @return The globally unique participant IDs of the providers in the order of the
+     * registrations.
+     */
+    std::vector<std::string> registerProviders(std::vector<ProviderRegistration> registrations,
+                                               bool persist = true,
+                                               bool awaitGlobalRegistration = false)
+    {
+        return runtimeImpl->registerProviders(
+                std::move(registrations), persist, awaitGlobalRegistration);
+    }
+
+    /**
+     * @brief Unregisters many providers from the joynr communication framework as one batch.
+     * @param participantIds The participantIds of the providers which shall be unregistered
+     * @param onSucess: Will be invoked when all providers have been unregistered.
+     * @param onError: Will be invoked when the providers could not be unregistered. An exception,
+     * which describes the error, is passed as the parameter.
+     */
+    void unregisterProvidersAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const exceptions::JoynrRuntimeException&)> onError) noexcept
+    {
+        runtimeImpl->unregisterProvidersAsync(
+                participantIds, std::move(onSuccess), std::move(onError));
+    }
+
+    /**
+     * @brief Unregisters many providers from the joynr communication framework as one batch.
+     * @param participantIds The participantIds of the providers which shall be unregistered
+     */
+    void unregisterProviders(const std::vector<std::string>& participantIds)
+    {
+        runtimeImpl->unregisterProviders(participantIds);
+    }
+
     /**
      * @brief Unregisters the provider from the joynr communication framework.
      *
@@ -24,6 +24,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "joynr/CapabilitiesRegistrar.h"
 #include "joynr/IKeychain.h"
@@ -133,6 +134,111 @@ public:
         return participiantId;
     }
 
+    /**
+     * @brief Prepares the registration of a provider as part of a batch, see
+     * registerProvidersAsync.
+     * @tparam TIntfProvider The interface class of the provider to register.
+     * @param domain The domain to register the provider on.
+     * @param provider The provider instance to register.
+     * @param providerQos The qos associated with the registered provider.
+     */
+    template <class TIntfProvider>
+    ProviderRegistration createProviderRegistration(const std::string& domain,
+                                                    std::shared_ptr<TIntfProvider> provider,
+                                                    const joynr::types::ProviderQos& providerQos)
+    {
+        assert(capabilitiesRegistrar);
+        assert(!domain.empty());
+        return capabilitiesRegistrar->createProviderRegistration(
+                domain, std::move(provider), providerQos);
+    }
+
+    /**
+     * @brief Registers many providers with the joynr communication framework asynchronously.
+     *
+     * Compared to registering the providers one by one, the participant IDs are persisted, the
+     * routing entries are added and the discovery entries are registered once for the whole batch.
+     * @param registrations The providers to register, see createProviderRegistration.
+     * @param onSucess: Will be invoked when all providers have been registered.
+     * @param onError: Will be invoked when the providers could not be registered. An exception,
+     * which describes the error, is passed as the parameter.
+     * @param persist if set to true, participant IDs of the providers will be persisted,
+     * otherwise they will not; default is true
+     * @return The participant IDs of the providers in the order of the registrations.
+     */
+    std::vector<std::string> registerProvidersAsync(
+            std::vector<ProviderRegistration> registrations,
+            std::function<void()> onSuccess,
+            std::function<void(const exceptions::JoynrRuntimeException&)> onError,
+            bool persist = true,
+            bool awaitGlobalRegistration = false) noexcept
+    {
+        assert(capabilitiesRegistrar);
+        return capabilitiesRegistrar->addAsync(std::move(registrations),
+                                               std::move(onSuccess),
+                                               std::move(onError),
+                                               persist,
+                                               awaitGlobalRegistration);
+    }
+
+    /**
+     * @brief Registers many providers with the joynr communication framework, see
+     * registerProvidersAsync.
+     * @return The participant IDs of the providers in the order of the registrations.
+     */
+    std::vector<std::string> registerProviders(std::vector<ProviderRegistration> registrations,
+                                               bool persist = true,
+                                               bool awaitGlobalRegistration = false)
+    {
+        Future<void> future;
+        auto onSuccess = [&future]() { future.onSuccess(); };
+        auto onError = [&future](const exceptions::JoynrRuntimeException& exception) {
+            future.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+        };
+
+        std::vector<std::string> participantIds =
+                registerProvidersAsync(std::move(registrations),
+                                       std::move(onSuccess),
+                                       std::move(onError),
+                                       persist,
+                                       awaitGlobalRegistration);
+        future.get();
+        return participantIds;
+    }
+
+    /**
+     * @brief Unregisters many providers identified by their participant IDs as one batch.
+     * @param participantIds The participantIds of the providers which shall be unregistered
+     * @param onSucess: Will be invoked when all providers have been unregistered.
+     * @param onError: Will be invoked when the providers could not be unregistered. An exception,
+     * which describes the error, is passed as the parameter.
+     */
+    void unregisterProvidersAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const exceptions::JoynrRuntimeException&)> onError) noexcept
+    {
+        assert(capabilitiesRegistrar);
+        capabilitiesRegistrar->removeAsync(
+                participantIds, std::move(onSuccess), std::move(onError));
+    }
+
+    /**
+     * @brief Unregisters many providers identified by their participant IDs as one batch.
+     * @param participantIds The participantIds of the providers which shall be unregistered
+     */
+    void unregisterProviders(const std::vector<std::string>& participantIds)
+    {
+        Future<void> future;
+        auto onSuccess = [&future]() { future.onSuccess(); };
+        auto onError = [&future](const exceptions::JoynrRuntimeException& exception) {
+            future.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+        };
+
+        unregisterProvidersAsync(participantIds, std::move(onSuccess), std::move(onError));
+        future.get();
+    }
+
     /**
      * @brief Unregisters the provider from the joynr communication framework.
      *
@@ -22,6 +22,8 @@
 #include <memory>
 #include <vector>
 
+#include "joynr/BackPressureController.h"
+#include "joynr/BatchCompletion.h"
 #include "joynr/Dispatcher.h"
 #include "joynr/CapabilitiesRegistrar.h"
 #include "joynr/IMulticastAddressCalculator.h"
@@ -35,6 +37,7 @@
 #include "joynr/ProxyBuilder.h"
 #include "joynr/Settings.h"
 #include "joynr/SingleThreadedIOService.h"
+#include "joynr/StartupStages.h"
 #include "joynr/SubscriptionManager.h"
 #include "joynr/Util.h"
 #include "joynr/system/DiscoveryProxy.h"
@@ -138,13 +141,23 @@ void LibJoynrRuntime::init(
             std::make_unique<MessageQueue<std::shared_ptr<ITransportStatus>>>());
     libJoynrMessageRouter->init();
 
-    libJoynrMessageRouter->loadRoutingTable(
-            libjoynrSettings->getMessageRouterPersistenceFilename());
-    libJoynrMessageRouter->setParentAddress(routingProviderParticipantId, ccMessagingAddress);
-    startLibJoynrMessagingSkeleton(libJoynrMessageRouter);
+    std::shared_ptr<BackPressureController> backPressureController;
+    const BackPressurePolicy::Enum backPressurePolicy =
+            BackPressurePolicy::getEnum(messagingSettings.getBackPressurePolicy());
+    if (backPressurePolicy != BackPressurePolicy::Enum::DISABLED) {
+        backPressureController = std::make_shared<BackPressureController>(
+                backPressurePolicy,
+                messagingSettings.getBackPressureHighWatermarkBytes(),
+                messagingSettings.getBackPressureLowWatermarkBytes(),
+                std::chrono::milliseconds(messagingSettings.getBackPressureMaxBlockingTimeMs()),
+                singleThreadIOService->getIOService());
+        libJoynrMessageRouter->setBackPressureController(backPressureController);
+    }
 
-    messageSender = std::make_shared<MessageSender>(
-            libJoynrMessageRouter, keyChain, messagingSettings.getTtlUpliftMs());
+    messageSender = std::make_shared<MessageSender>(libJoynrMessageRouter,
+                                                    keyChain,
+                                                    messagingSettings.getTtlUpliftMs(),
+                                                    std::move(backPressureController));
     joynrDispatcher =
             std::make_shared<Dispatcher>(messageSender, singleThreadIOService->getIOService());
     messageSender->registerDispatcher(joynrDispatcher);
@@ -158,10 +171,31 @@ void LibJoynrRuntime::init(
             messageSender,
             libjoynrSettings->isSubscriptionPersistencyEnabled(),
             messagingSettings.getTtlUpliftMs());
-    publicationManager->loadSavedAttributeSubscriptionRequestsMap(
-            libjoynrSettings->getSubscriptionRequestPersistenceFilename());
-    publicationManager->loadSavedBroadcastSubscriptionRequestsMap(
-            libjoynrSettings->getBroadcastSubscriptionRequestPersistenceFilename());
+
+    // the persistence files are independent of each other and are loaded in parallel
+    StartupStages persistenceStages(
+            "LibJoynrRuntime", StartupStages::getDefaultMaxParallelStages());
+    persistenceStages.add("routingTable", {}, [this]() {
+        libJoynrMessageRouter->loadRoutingTable(
+                libjoynrSettings->getMessageRouterPersistenceFilename());
+    });
+    persistenceStages.add("attributeSubscriptions", {}, [this]() {
+        publicationManager->loadSavedAttributeSubscriptionRequestsMap(
+                libjoynrSettings->getSubscriptionRequestPersistenceFilename());
+    });
+    persistenceStages.add("broadcastSubscriptions", {}, [this]() {
+        publicationManager->loadSavedBroadcastSubscriptionRequestsMap(
+                libjoynrSettings->getBroadcastSubscriptionRequestPersistenceFilename());
+    });
+    persistenceStages.add("participantIds", {}, [this]() {
+        // Set up the persistence file for storing provider participant ids
+        participantIdStorage = std::make_shared<ParticipantIdStorage>(
+                libjoynrSettings->getParticipantIdsPersistenceFilename());
+    });
+    persistenceStages.run();
+
+    libJoynrMessageRouter->setParentAddress(routingProviderParticipantId, ccMessagingAddress);
+    startLibJoynrMessagingSkeleton(libJoynrMessageRouter);
 
     subscriptionManager = std::make_shared<SubscriptionManager>(
             singleThreadIOService->getIOService(), libJoynrMessageRouter);
@@ -171,71 +205,33 @@ void LibJoynrRuntime::init(
 
     proxyFactory = std::make_unique<ProxyFactory>(joynrMessagingConnectorFactory);
 
-    // Set up the persistence file for storing provider participant ids
-    std::string persistenceFilename = libjoynrSettings->getParticipantIdsPersistenceFilename();
-    participantIdStorage = std::make_shared<ParticipantIdStorage>(persistenceFilename);
-
     // initialize the dispatchers
     joynrDispatcher->registerPublicationManager(publicationManager);
     joynrDispatcher->registerSubscriptionManager(subscriptionManager);
 
     discoveryProxy = std::make_shared<LocalDiscoveryAggregator>(getProvisionedEntries());
 
-    auto onSuccessBuildInternalProxies =
-            [ thisSharedPtr = shared_from_this(), this, onSuccess, onError ]()
+    auto onSuccessBuildInternalProxies = [ thisSharedPtr = shared_from_this(), this, onSuccess ](
+            const std::string& globalAddress, const std::string& replyToAddress)
     {
-        auto onSuccessGetGlobalAddress =
-                [thisSharedPtr, this, onSuccess, onError](const std::string& globalAddress) {
-            const std::string savedGlobalAddress(globalAddress);
-
-            auto onSuccessGetReplyToAddress = [thisSharedPtr, this, onSuccess, savedGlobalAddress](
-                    const std::string& replyAddress) {
-
-                messageSender->setReplyToAddress(replyAddress);
-
-                std::vector<std::shared_ptr<IDispatcher>> dispatcherList;
-                dispatcherList.push_back(joynrDispatcher);
-
-                capabilitiesRegistrar = std::make_unique<CapabilitiesRegistrar>(
-                        dispatcherList,
-                        discoveryProxy,
-                        participantIdStorage,
-                        dispatcherAddress,
-                        libJoynrMessageRouter,
-                        messagingSettings.getDiscoveryEntryExpiryIntervalMs(),
-                        publicationManager,
-                        savedGlobalAddress);
-
-                if (onSuccess) {
-                    onSuccess();
-                }
-            };
-
-            auto onErrorGetReplyToAddress =
-                    [onError](const joynr::exceptions::JoynrRuntimeException& error) {
-                JOYNR_LOG_FATAL(logger(),
-                                "onErrorGetReplyToAddress: got exception: {}",
-                                error.getMessage());
-                if (onError) {
-                    onError(error);
-                }
-            };
-
-            ccRoutingProxy->getReplyToAddressAsync(
-                    std::move(onSuccessGetReplyToAddress), std::move(onErrorGetReplyToAddress));
-        };
-
-        auto onErrorGetGlobalAddress =
-                [onError](const joynr::exceptions::JoynrRuntimeException& error) {
-            JOYNR_LOG_FATAL(
-                    logger(), "onErrorGetGlobalAddress: got exception: {}", error.getMessage());
-            if (onError) {
-                onError(error);
-            }
-        };
-
-        ccRoutingProxy->getGlobalAddressAsync(
-                std::move(onSuccessGetGlobalAddress), std::move(onErrorGetGlobalAddress));
+        messageSender->setReplyToAddress(replyToAddress);
+
+        std::vector<std::shared_ptr<IDispatcher>> dispatcherList;
+        dispatcherList.push_back(joynrDispatcher);
+
+        capabilitiesRegistrar = std::make_unique<CapabilitiesRegistrar>(
+                dispatcherList,
+                discoveryProxy,
+                participantIdStorage,
+                dispatcherAddress,
+                libJoynrMessageRouter,
+                messagingSettings.getDiscoveryEntryExpiryIntervalMs(),
+                publicationManager,
+                globalAddress);
+
+        if (onSuccess) {
+            onSuccess();
+        }
     };
 
     auto onErrorBuildInternalProxies =
@@ -254,7 +250,8 @@ void LibJoynrRuntime::init(
 
 void LibJoynrRuntime::buildInternalProxies(
         std::shared_ptr<JoynrMessagingConnectorFactory> connectorFactory,
-        std::function<void()> onSuccess,
+        std::function<void(const std::string& globalAddress, const std::string& replyToAddress)>
+                onSuccess,
         std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError)
 {
     /*
@@ -320,19 +317,27 @@ void LibJoynrRuntime::buildInternalProxies(
                     getProvisionedEntries()[ccDiscoveryProviderParticipantId];
             clusterControllerDiscovery->handleArbitrationFinished(ccDiscoveryEntry);
 
-            auto onSuccessAddNextHopDiscoveryProxy =
-                    [onSuccess, clusterControllerDiscovery, thisSharedPtr, this]() {
-                discoveryProxy->setDiscoveryProxy(clusterControllerDiscovery);
-                onSuccess();
-            };
+            // the routing proxy is known to the cluster controller now, hence the discovery
+            // proxy and the queries for the addresses of the cluster controller do not have to
+            // wait for each other
+            auto globalAddress = std::make_shared<std::string>();
+            auto replyToAddress = std::make_shared<std::string>();
+            auto completion = BatchCompletion::create(
+                    3,
+                    [onSuccess, clusterControllerDiscovery, globalAddress, replyToAddress,
+                     thisSharedPtr, this]() {
+                        discoveryProxy->setDiscoveryProxy(clusterControllerDiscovery);
+                        onSuccess(*globalAddress, *replyToAddress);
+                    },
+                    onError);
 
             auto onErrorAddNextHopDiscoveryProxy =
-                    [onError](const joynr::exceptions::ProviderRuntimeException& error) {
+                    [completion](const joynr::exceptions::ProviderRuntimeException& error) {
                 JOYNR_LOG_FATAL(logger(),
                                 "Failed to call add next hop for "
                                 "clusterControllerDiscovery: {}",
                                 error.getMessage());
-                onError(error);
+                completion->fail(error);
             };
 
             libJoynrMessageRouter->addNextHop(clusterControllerDiscovery->getProxyParticipantId(),
@@ -340,8 +345,32 @@ void LibJoynrRuntime::buildInternalProxies(
                                               isGloballyVisible,
                                               expiryDateMs,
                                               isSticky,
-                                              onSuccessAddNextHopDiscoveryProxy,
+                                              completion->successCallback(completion),
                                               onErrorAddNextHopDiscoveryProxy);
+
+            ccRoutingProxy->getGlobalAddressAsync(
+                    [completion, globalAddress](const std::string& address) {
+                        *globalAddress = address;
+                        completion->succeeded();
+                    },
+                    [completion](const joynr::exceptions::JoynrRuntimeException& error) {
+                        JOYNR_LOG_FATAL(logger(),
+                                        "onErrorGetGlobalAddress: got exception: {}",
+                                        error.getMessage());
+                        completion->fail(error);
+                    });
+
+            ccRoutingProxy->getReplyToAddressAsync(
+                    [completion, replyToAddress](const std::string& address) {
+                        *replyToAddress = address;
+                        completion->succeeded();
+                    },
+                    [completion](const joynr::exceptions::JoynrRuntimeException& error) {
+                        JOYNR_LOG_FATAL(logger(),
+                                        "onErrorGetReplyToAddress: got exception: {}",
+                                        error.getMessage());
+                        completion->fail(error);
+                    });
         };
 
         auto onErrorSetParentRouter =
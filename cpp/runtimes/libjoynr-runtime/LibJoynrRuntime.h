@@ -60,9 +60,15 @@ public:
     void shutdown() override;
 
 protected:
+    /**
+     * @brief Builds the proxies for the routing and discovery providers of the cluster controller.
+     * The proxies are registered while the addresses of the cluster controller, which onSuccess
+     * receives, are queried in parallel.
+     */
     void buildInternalProxies(
             std::shared_ptr<JoynrMessagingConnectorFactory> connectorFactory,
-            std::function<void()> onSuccess,
+            std::function<void(const std::string& globalAddress,
+                               const std::string& replyToAddress)> onSuccess,
             std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError);
 
     std::shared_ptr<IMessageRouter> getMessageRouter() final;
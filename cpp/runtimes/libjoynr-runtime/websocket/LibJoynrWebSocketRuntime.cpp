@@ -18,6 +18,7 @@
  */
 #include "runtimes/libjoynr-runtime/websocket/LibJoynrWebSocketRuntime.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include <websocketpp/common/connection_hdl.hpp>
@@ -29,10 +30,17 @@
 #include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
 #include "joynr/IKeychain.h"
+#include "joynr/UdsAddress.h"
+#include "libjoynr/shm/ShmClient.h"
+#include "libjoynr/uds/UdsClient.h"
+#include "libjoynr/uds/UdsMessagingStubFactory.h"
+#include "libjoynr/uds/UdsMulticastAddressCalculator.h"
+#include "libjoynr/websocket/WebSocketCoalescingSender.h"
 #include "libjoynr/websocket/WebSocketLibJoynrMessagingSkeleton.h"
 #include "libjoynr/websocket/WebSocketMessagingStubFactory.h"
 #include "libjoynr/websocket/WebSocketPpClientNonTLS.h"
 #include "libjoynr/websocket/WebSocketPpClientTLS.h"
+#include "libjoynr/websocket/WebSocketSendQueue.h"
 
 namespace joynr
 {
@@ -42,6 +50,10 @@ LibJoynrWebSocketRuntime::LibJoynrWebSocketRuntime(std::unique_ptr<Settings> set
         : LibJoynrRuntime(std::move(settings), std::move(keyChain)),
           wsSettings(*this->settings),
           websocket(nullptr),
+          udsClient(nullptr),
+          shmClient(nullptr),
+          coalescingSender(nullptr),
+          sendQueue(nullptr),
           initializationMsg(),
           isShuttingDown(false)
 {
@@ -57,8 +69,15 @@ void LibJoynrWebSocketRuntime::shutdown()
 {
     assert(!isShuttingDown);
     isShuttingDown = true;
-    assert(websocket);
-    websocket->stop();
+    if (udsClient) {
+        udsClient->stop();
+    } else {
+        assert(websocket);
+        if (shmClient) {
+            shmClient->disconnect();
+        }
+        websocket->stop();
+    }
 
     // synchronously stop the underlying boost::asio::io_service
     // this ensures all asynchronous operations are stopped now
@@ -87,15 +106,48 @@ void LibJoynrWebSocketRuntime::connect(
                     initializationMsg,
                     libjoynrMessagingAddress->toString());
 
+    if (udsClient) {
+        connectUds(std::move(libjoynrMessagingAddress), std::move(onSuccess), std::move(onError));
+        return;
+    }
+
     // create connection to parent routing service
     auto ccMessagingAddress = std::make_shared<const joynr::system::RoutingTypes::WebSocketAddress>(
             wsSettings.createClusterControllerMessagingAddress());
 
+    std::shared_ptr<IWebSocketSendInterface> sender = websocket->getSender();
+    if (sendQueue) {
+        sender = sendQueue;
+    } else if (shmClient) {
+        sender = shmClient;
+    } else if (coalescingSender) {
+        sender = coalescingSender;
+    }
     auto factory = std::make_shared<WebSocketMessagingStubFactory>();
-    factory->addServer(*ccMessagingAddress, websocket->getSender());
+    factory->addServer(*ccMessagingAddress, std::move(sender));
 
     std::weak_ptr<WebSocketMessagingStubFactory> weakFactoryRef(factory);
-    websocket->registerDisconnectCallback([weakFactoryRef, ccMessagingAddress]() {
+    std::weak_ptr<ShmClient> weakShmClientRef(shmClient);
+    std::weak_ptr<WebSocketCoalescingSender> weakCoalescingSenderRef(coalescingSender);
+    std::weak_ptr<WebSocketSendQueue> weakSendQueueRef(sendQueue);
+    websocket->registerDisconnectCallback([
+        weakFactoryRef,
+        weakShmClientRef,
+        weakCoalescingSenderRef,
+        weakSendQueueRef,
+        ccMessagingAddress
+    ]() {
+        // messages are queued again until the next initialization message has been sent
+        if (auto sendQueue = weakSendQueueRef.lock()) {
+            sendQueue->suspend();
+        }
+        if (auto shmClient = weakShmClientRef.lock()) {
+            shmClient->disconnect();
+        }
+        // coalescing has to be accepted again by the cluster controller after reconnect
+        if (auto coalescingSender = weakCoalescingSenderRef.lock()) {
+            coalescingSender->setEnabled(false);
+        }
         if (auto factory = weakFactoryRef.lock()) {
             factory->onMessagingStubClosed(*ccMessagingAddress);
         }
@@ -139,6 +191,62 @@ void LibJoynrWebSocketRuntime::connect(
     websocket->connect(*ccMessagingAddress);
 }
 
+void LibJoynrWebSocketRuntime::connectUds(
+        std::shared_ptr<const system::RoutingTypes::Address> libjoynrMessagingAddress,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::JoynrRuntimeException&)> onError)
+{
+    // create connection to parent routing service
+    auto ccMessagingAddress =
+            std::make_shared<const UdsAddress>(wsSettings.getClusterControllerMessagingUdsPath());
+
+    auto factory = std::make_shared<UdsMessagingStubFactory>();
+    factory->addServer(*ccMessagingAddress, udsClient->getSender());
+
+    std::weak_ptr<UdsMessagingStubFactory> weakFactoryRef(factory);
+    udsClient->registerDisconnectCallback([weakFactoryRef, ccMessagingAddress]() {
+        if (auto factory = weakFactoryRef.lock()) {
+            factory->onMessagingStubClosed(*ccMessagingAddress);
+        }
+    });
+
+    auto connectCallback = [
+        thisWeakPtr = joynr::util::as_weak_ptr(
+                std::dynamic_pointer_cast<LibJoynrWebSocketRuntime>(this->shared_from_this())),
+        onSuccess = std::move(onSuccess),
+        onError = std::move(onError),
+        factory,
+        libjoynrMessagingAddress,
+        ccMessagingAddress
+    ]() mutable
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->sendInitializationMsg();
+
+            std::unique_ptr<IMulticastAddressCalculator> addressCalculator =
+                    std::make_unique<UdsMulticastAddressCalculator>(ccMessagingAddress);
+            thisSharedPtr->init(factory,
+                                libjoynrMessagingAddress,
+                                ccMessagingAddress,
+                                std::move(addressCalculator),
+                                std::move(onSuccess),
+                                std::move(onError));
+        }
+    };
+
+    auto reconnectCallback = [thisWeakPtr = joynr::util::as_weak_ptr(std::dynamic_pointer_cast<
+                                      LibJoynrWebSocketRuntime>(this->shared_from_this()))]()
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->sendInitializationMsg();
+        }
+    };
+
+    udsClient->registerConnectCallback(connectCallback);
+    udsClient->registerReconnectCallback(reconnectCallback);
+    udsClient->connect(*ccMessagingAddress);
+}
+
 void LibJoynrWebSocketRuntime::sendInitializationMsg()
 {
     auto onFailure = [](const exceptions::JoynrRuntimeException& e) {
@@ -148,11 +256,40 @@ void LibJoynrWebSocketRuntime::sendInitializationMsg()
                         e.getMessage());
     };
     smrf::ByteVector rawMessage(initializationMsg.begin(), initializationMsg.end());
-    websocket->send(smrf::ByteArrayView(rawMessage), std::move(onFailure));
+    if (udsClient) {
+        udsClient->send(smrf::ByteArrayView(rawMessage), std::move(onFailure));
+    } else {
+        if (shmClient) {
+            // the shared memory channel has to be attached before the cluster controller
+            // registers this runtime
+            shmClient->negotiate();
+        } else if (coalescingSender) {
+            // coalescing is enabled once the cluster controller accepted the offer
+            coalescingSender->setEnabled(false);
+            const std::string offerMsg = WebSocketCoalescingSender::createOfferMessage(
+                    wsSettings.getCoalescingMaxBytes(), wsSettings.getCoalescingMaxDelayUs());
+            smrf::ByteVector rawOfferMessage(offerMsg.begin(), offerMsg.end());
+            websocket->send(smrf::ByteArrayView(rawOfferMessage), onFailure);
+        }
+        websocket->send(smrf::ByteArrayView(rawMessage), std::move(onFailure));
+        if (sendQueue) {
+            // the cluster controller accepts messages from this runtime only after the
+            // initialization message
+            sendQueue->flush();
+        }
+    }
 }
 
 void LibJoynrWebSocketRuntime::createWebsocketClient()
 {
+    if (!wsSettings.getClusterControllerMessagingUdsPath().empty()) {
+        JOYNR_LOG_INFO(logger(), "Using unix domain socket connection");
+        udsClient = std::make_shared<UdsClient>(singleThreadIOService->getIOService(),
+                                                wsSettings.getReconnectSleepTimeMs(),
+                                                wsSettings.getReconnectMaxSleepTimeMs());
+        return;
+    }
+
     system::RoutingTypes::WebSocketAddress webSocketAddress =
             wsSettings.createClusterControllerMessagingAddress();
 
@@ -175,6 +312,33 @@ void LibJoynrWebSocketRuntime::createWebsocketClient()
         throw exceptions::JoynrRuntimeException(
                 "Unknown protocol used for settings property 'cluster-controller-messaging-url'");
     }
+
+    const std::uint64_t sharedMemoryRingSize = wsSettings.getSharedMemoryRingSize();
+    if (sharedMemoryRingSize > 0) {
+        JOYNR_LOG_INFO(logger(), "Offering shared memory channel to cluster controller");
+        shmClient = std::make_shared<ShmClient>(websocket->getSender(),
+                                                sharedMemoryRingSize,
+                                                wsSettings.getSharedMemoryAttachTimeoutMs());
+    } else if (wsSettings.getCoalescingMaxBytes() > 0) {
+        JOYNR_LOG_INFO(logger(), "Offering coalescing of messages to cluster controller");
+        coalescingSender =
+                std::make_shared<WebSocketCoalescingSender>(singleThreadIOService->getIOService(),
+                                                            websocket->getSender(),
+                                                            wsSettings.getCoalescingMaxBytes(),
+                                                            wsSettings.getCoalescingMaxDelayUs(),
+                                                            false);
+    }
+
+    const std::uint32_t sendQueueSize = wsSettings.getSendQueueSize();
+    if (sendQueueSize > 0) {
+        std::shared_ptr<IWebSocketSendInterface> sender = websocket->getSender();
+        if (shmClient) {
+            sender = shmClient;
+        } else if (coalescingSender) {
+            sender = coalescingSender;
+        }
+        sendQueue = std::make_shared<WebSocketSendQueue>(std::move(sender), sendQueueSize);
+    }
 }
 
 void LibJoynrWebSocketRuntime::startLibJoynrMessagingSkeleton(
@@ -182,12 +346,35 @@ void LibJoynrWebSocketRuntime::startLibJoynrMessagingSkeleton(
 {
     auto wsLibJoynrMessagingSkeleton =
             std::make_shared<WebSocketLibJoynrMessagingSkeleton>(util::as_weak_ptr(messageRouter));
+    if (udsClient) {
+        udsClient->registerReceiveCallback([wsLibJoynrMessagingSkeleton](smrf::ByteVector&& msg) {
+            wsLibJoynrMessagingSkeleton->onMessageReceived(std::move(msg));
+        });
+        return;
+    }
+    if (shmClient) {
+        shmClient->registerReceiveCallback([wsLibJoynrMessagingSkeleton](smrf::ByteVector&& msg) {
+            wsLibJoynrMessagingSkeleton->onMessageReceived(std::move(msg));
+        });
+    }
     using ConnectionHandle = websocketpp::connection_hdl;
-    websocket->registerReceiveCallback(
-            [wsLibJoynrMessagingSkeleton](ConnectionHandle&& hdl, smrf::ByteVector&& msg) {
-                std::ignore = hdl;
-                wsLibJoynrMessagingSkeleton->onMessageReceived(std::move(msg));
-            });
+    websocket->registerReceiveCallback([
+        wsLibJoynrMessagingSkeleton,
+        weakCoalescingSenderRef = std::weak_ptr<WebSocketCoalescingSender>(coalescingSender)
+    ](ConnectionHandle && hdl, smrf::ByteVector && msg) {
+        std::ignore = hdl;
+        if (auto coalescingSender = weakCoalescingSenderRef.lock()) {
+            const std::string& acceptMessage = WebSocketCoalescingSender::ACCEPT_MESSAGE();
+            if (msg.size() == acceptMessage.size() &&
+                std::equal(acceptMessage.cbegin(), acceptMessage.cend(), msg.cbegin())) {
+                JOYNR_LOG_DEBUG(LibJoynrWebSocketRuntime::logger(),
+                                "cluster controller accepted coalescing of messages");
+                coalescingSender->setEnabled(true);
+                return;
+            }
+        }
+        wsLibJoynrMessagingSkeleton->onMessageReceived(std::move(msg));
+    });
 }
 
 } // namespace joynr
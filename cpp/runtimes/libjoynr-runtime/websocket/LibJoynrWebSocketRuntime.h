@@ -36,6 +36,10 @@ namespace joynr
 class IWebSocketPpClient;
 class WebSocketLibJoynrMessagingSkeleton;
 class IWebSocketPpClient;
+class UdsClient;
+class ShmClient;
+class WebSocketCoalescingSender;
+class WebSocketSendQueue;
 
 class LibJoynrWebSocketRuntime : public LibJoynrRuntime
 {
@@ -54,11 +58,22 @@ protected:
 private:
     DISALLOW_COPY_AND_ASSIGN(LibJoynrWebSocketRuntime);
 
+    void connectUds(std::shared_ptr<const system::RoutingTypes::Address> libjoynrMessagingAddress,
+                    std::function<void()> onSuccess,
+                    std::function<void(const joynr::exceptions::JoynrRuntimeException&)> onError);
     void sendInitializationMsg();
     void createWebsocketClient();
 
     WebSocketSettings wsSettings;
     std::shared_ptr<IWebSocketPpClient> websocket;
+    // set instead of websocket if the cluster controller is connected via a unix domain socket
+    std::shared_ptr<UdsClient> udsClient;
+    // set in addition to websocket if a shared memory channel is offered to the cluster controller
+    std::shared_ptr<ShmClient> shmClient;
+    // set in addition to websocket if coalescing of messages is offered to the cluster controller
+    std::shared_ptr<WebSocketCoalescingSender> coalescingSender;
+    // set in addition to websocket if messages are queued while the connection is not established
+    std::shared_ptr<WebSocketSendQueue> sendQueue;
     std::string initializationMsg;
     bool isShuttingDown;
     ADD_LOGGER(LibJoynrWebSocketRuntime)
@@ -51,6 +51,7 @@ void removeFileInCurrentDirectory(const std::string& filePattern)
 void removeAllCreatedSettingsAndPersistencyFiles() {
     removeFileInCurrentDirectory(".*\\.settings");
     removeFileInCurrentDirectory(".*\\.persist");
+    removeFileInCurrentDirectory(".*\\.persist\\.(snapshot|journal)");
     removeFileInCurrentDirectory(".*\\.entries");
 }
 
@@ -262,7 +262,10 @@ TEST_F(JoynrClusterControllerRuntimeTest, injectCustomMqttMessagingSkeleton)
     EXPECT_CALL(*mockMqttMessageReceiver, getGlobalClusterControllerAddress())
             .WillOnce(::testing::ReturnRef(mqttGlobalAddress));
 
-    EXPECT_CALL(*mockMqttMessagingSkeleton, onMessageReceivedMock(msg));
+    // received messages are passed to the skeleton by a worker of the mqtt ingress queue
+    Semaphore messageReceived(0);
+    EXPECT_CALL(*mockMqttMessagingSkeleton, onMessageReceivedMock(msg))
+            .WillOnce(ReleaseSemaphore(&messageReceived));
 
     runtime = std::make_shared<JoynrClusterControllerRuntime>(
             std::make_unique<Settings>(settingsFilenameMqtt),
@@ -273,6 +276,7 @@ TEST_F(JoynrClusterControllerRuntimeTest, injectCustomMqttMessagingSkeleton)
             mockMqttMessageReceiver,
             mockMqttMessageSender);
     runtime->init();
+    EXPECT_TRUE(messageReceived.waitFor(std::chrono::seconds(5)));
 }
 
 void JoynrClusterControllerRuntimeTest::startExternalCommunicationDoesNotThrow()
@@ -40,6 +40,14 @@ public:
                 boost::optional<joynr::MessagingQos> qos
             )
     );
+    MOCK_METHOD3(
+            add,
+            void(
+                const std::vector<joynr::types::DiscoveryEntry>& entries,
+                const bool& awaitGlobalRegistration,
+                boost::optional<joynr::MessagingQos> qos
+            )
+    );
     MOCK_METHOD3(
             lookup,
             void(
@@ -65,6 +73,13 @@ public:
                 boost::optional<joynr::MessagingQos> qos
             )
     );
+    MOCK_METHOD2(
+            remove,
+            void(
+                const std::vector<std::string>& participantIds,
+                boost::optional<joynr::MessagingQos> qos
+            )
+    );
     std::shared_ptr<joynr::Future<void>> addAsync (
                 const joynr::types::DiscoveryEntry& discoveryEntry,
                 std::function<void(void)> onSuccess,
@@ -103,6 +118,30 @@ public:
                 boost::optional<joynr::MessagingQos> qos
             )
     );
+    std::shared_ptr<joynr::Future<void>> addAsync (
+                const std::vector<joynr::types::DiscoveryEntry>& discoveryEntries,
+                const bool& awaitGlobalRegistration,
+                std::function<void(void)> onSuccess,
+                std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+                boost::optional<joynr::MessagingQos> qos
+            ) noexcept override
+    {
+        return addEntriesAsyncMock(discoveryEntries,
+                                   awaitGlobalRegistration,
+                                   std::move(onSuccess),
+                                   std::move(onRuntimeError),
+                                   std::move(qos));
+    }
+    MOCK_METHOD5(
+            addEntriesAsyncMock,
+            std::shared_ptr<joynr::Future<void>>(
+                const std::vector<joynr::types::DiscoveryEntry>& discoveryEntries,
+                const bool& awaitGlobalRegistration,
+                std::function<void(void)> onSuccess,
+                std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+                boost::optional<joynr::MessagingQos> qos
+            )
+    );
     std::shared_ptr<joynr::Future<joynr::types::DiscoveryEntryWithMetaInfo>> lookupAsync(
                 const std::string& participantId,
                 std::function<void(const joynr::types::DiscoveryEntryWithMetaInfo& result)>
@@ -165,6 +204,24 @@ public:
                 boost::optional<joynr::MessagingQos> qos
             )
     );
+    std::shared_ptr<joynr::Future<void>> removeAsync(
+                const std::vector<std::string>& participantIds,
+                std::function<void(void)> onSuccess,
+                std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+                boost::optional<joynr::MessagingQos> qos
+            ) noexcept override
+    {
+        return removeEntriesAsyncMock(participantIds, std::move(onSuccess), std::move(onRuntimeError), std::move(qos));
+    }
+    MOCK_METHOD4(
+            removeEntriesAsyncMock,
+            std::shared_ptr<joynr::Future<void>>(
+                const std::vector<std::string>& participantIds,
+                std::function<void(void)> onSuccess,
+                std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+                boost::optional<joynr::MessagingQos> qos
+            )
+    );
 };
 
 #endif // TESTS_MOCK_MOCKDISCOVERY_H
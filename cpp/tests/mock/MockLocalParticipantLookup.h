@@ -0,0 +1,32 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef TESTS_MOCK_MOCKLOCALPARTICIPANTLOOKUP_H
+#define TESTS_MOCK_MOCKLOCALPARTICIPANTLOOKUP_H
+
+#include <gmock/gmock.h>
+
+#include "joynr/ILocalParticipantLookup.h"
+
+class MockLocalParticipantLookup : public joynr::ILocalParticipantLookup {
+public:
+    MOCK_METHOD1(lookupLocally, boost::optional<joynr::types::DiscoveryEntryWithMetaInfo>(
+                     const std::string& participantId));
+};
+
+#endif // TESTS_MOCK_MOCKLOCALPARTICIPANTLOOKUP_H
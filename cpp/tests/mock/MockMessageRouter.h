@@ -40,6 +40,17 @@ public:
             onSuccess();
         }
     }
+    void invokeAddNextHopsOnSuccessFct(const std::vector<std::string>& participantIds,
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& inprocessAddress,
+            const bool& isGloballyVisible,
+            const std::int64_t expiryDateMs,
+            const bool isSticky,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) {
+        if (onSuccess) {
+            onSuccess();
+        }
+    }
     void invokeRemoveNextHopOnSuccessFct(const std::string& participantId,
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) {
@@ -48,6 +59,14 @@ public:
         }
     }
 
+    void invokeRemoveNextHopsOnSuccessFct(const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) {
+        if (onSuccess) {
+            onSuccess();
+        }
+    }
+
     MockMessageRouter(boost::asio::io_service& ioService)
     {
         std::ignore = ioService;
@@ -57,11 +76,21 @@ public:
                 addNextHop(_,_,_,_,_,_,_)
         )
                 .WillRepeatedly(testing::Invoke(this, &MockMessageRouter::invokeAddNextHopOnSuccessFct));
+        EXPECT_CALL(
+                *this,
+                addNextHops(_,_,_,_,_,_,_)
+        )
+                .WillRepeatedly(testing::Invoke(this, &MockMessageRouter::invokeAddNextHopsOnSuccessFct));
         EXPECT_CALL(
                 *this,
                 removeNextHop(_,_,_)
         )
                 .WillRepeatedly(testing::Invoke(this, &MockMessageRouter::invokeRemoveNextHopOnSuccessFct));
+        EXPECT_CALL(
+                *this,
+                removeNextHops(_,_,_)
+        )
+                .WillRepeatedly(testing::Invoke(this, &MockMessageRouter::invokeRemoveNextHopsOnSuccessFct));
     }
 
     MOCK_METHOD2(route, void(std::shared_ptr<joynr::ImmutableMessage> message, std::uint32_t tryCount));
@@ -84,11 +113,25 @@ public:
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError));
 
+    MOCK_METHOD7(addNextHops, void(
+            const std::vector<std::string>& participantIds,
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& inprocessAddress,
+            bool isGloballyVisible,
+            const std::int64_t expiryDateMs,
+            const bool isSticky,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError));
+
     MOCK_METHOD3(removeNextHop, void(
             const std::string& participantId,
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError));
 
+    MOCK_METHOD3(removeNextHops, void(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError));
+
     MOCK_METHOD5(addMulticastReceiver, void(
             const std::string& multicastId,
             const std::string& subscriberParticipantId,
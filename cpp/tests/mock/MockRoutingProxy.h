@@ -84,6 +84,63 @@ public:
             std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
             boost::optional<joynr::MessagingQos> qos));
 
+    std::shared_ptr<joynr::Future<void>> addNextHopAsync(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::WebSocketClientAddress& webSocketClientAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return addNextHopsAsyncMock(
+                participantIds,
+                webSocketClientAddress,
+                isGloballyVisible,
+                std::move(onSuccess),
+                std::move(onRuntimeError),
+                std::move(qos));
+    }
+    MOCK_METHOD6(addNextHopsAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::vector<std::string>& participantIds,
+            const joynr::system::RoutingTypes::WebSocketClientAddress& webSocketClientAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
+    std::shared_ptr<joynr::Future<void>> removeNextHopAsync(
+            const std::string& participantId,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return removeNextHopAsyncMock(
+                participantId, std::move(onSuccess), std::move(onRuntimeError), std::move(qos));
+    }
+    MOCK_METHOD4(removeNextHopAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::string& participantId,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
+    std::shared_ptr<joynr::Future<void>> removeNextHopAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return removeNextHopsAsyncMock(
+                participantIds, std::move(onSuccess), std::move(onRuntimeError), std::move(qos));
+    }
+    MOCK_METHOD4(removeNextHopsAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
     std::shared_ptr<joynr::Future<bool>> resolveNextHopAsync(
              const std::string& participantId,
              std::function<void(const bool& resolved)> onSuccess,
@@ -0,0 +1,168 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <boost/asio/io_service.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/BackPressureController.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using namespace joynr;
+
+class BackPressureControllerTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<BackPressureController> createController(
+            BackPressurePolicy::Enum policy,
+            std::uint64_t perClientQuotaBytes = 0,
+            std::chrono::milliseconds maxBlockingTime = std::chrono::milliseconds(100))
+    {
+        return std::make_shared<BackPressureController>(
+                policy, 100, 50, maxBlockingTime, ioService, perClientQuotaBytes);
+    }
+
+    boost::asio::io_service ioService;
+};
+
+TEST_F(BackPressureControllerTest, saturationHasHysteresis)
+{
+    auto controller = createController(BackPressurePolicy::Enum::NOTIFY);
+    auto first = controller->reserve("", 60);
+    EXPECT_FALSE(controller->isSaturated());
+    auto second = controller->reserve("", 40);
+    EXPECT_TRUE(controller->isSaturated());
+    EXPECT_EQ(100, controller->getPendingBytes());
+
+    // 60 bytes are still above the low watermark
+    second.reset();
+    EXPECT_TRUE(controller->isSaturated());
+    EXPECT_EQ(60, controller->getPendingBytes());
+
+    first.reset();
+    EXPECT_FALSE(controller->isSaturated());
+    EXPECT_EQ(0, controller->getPendingBytes());
+}
+
+TEST_F(BackPressureControllerTest, failFastThrowsWhenSaturated)
+{
+    auto controller = createController(BackPressurePolicy::Enum::FAIL_FAST);
+    EXPECT_NO_THROW(controller->admit());
+    auto reservation = controller->reserve("", 100);
+    EXPECT_THROW(controller->admit(), exceptions::JoynrMessageNotSentException);
+    reservation.reset();
+    EXPECT_NO_THROW(controller->admit());
+}
+
+TEST_F(BackPressureControllerTest, blockTimesOut)
+{
+    auto controller = createController(BackPressurePolicy::Enum::BLOCK);
+    auto reservation = controller->reserve("", 100);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_THROW(controller->admit(), exceptions::JoynrMessageNotSentException);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+}
+
+TEST_F(BackPressureControllerTest, blockReturnsOnceDrained)
+{
+    auto controller = createController(
+            BackPressurePolicy::Enum::BLOCK, 0, std::chrono::milliseconds(5000));
+    auto reservation = controller->reserve("", 100);
+    std::thread releaser([&reservation]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        reservation.reset();
+    });
+    EXPECT_NO_THROW(controller->admit());
+    releaser.join();
+}
+
+TEST_F(BackPressureControllerTest, notifyWhenReadyIsCalledAfterDrain)
+{
+    auto controller = createController(BackPressurePolicy::Enum::NOTIFY);
+    std::atomic<int> calls(0);
+    controller->notifyWhenReady([&calls]() { ++calls; });
+    EXPECT_EQ(1, calls);
+
+    auto reservation = controller->reserve("", 100);
+    EXPECT_NO_THROW(controller->admit());
+    controller->notifyWhenReady([&calls]() { ++calls; });
+    EXPECT_EQ(1, calls);
+    // the callback is not invoked by the thread which releases the reservation
+    reservation.reset();
+    EXPECT_EQ(1, calls);
+    ioService.poll();
+    EXPECT_EQ(2, calls);
+}
+
+TEST_F(BackPressureControllerTest, blockFailsFastOnInternalThread)
+{
+    auto controller = createController(
+            BackPressurePolicy::Enum::BLOCK, 0, std::chrono::milliseconds(5000));
+    auto reservation = controller->reserve("", 100);
+    bool thrown = false;
+    std::thread internalThread([&controller, &thrown]() {
+        BackPressureController::markCurrentThreadAsInternal();
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            controller->admit();
+        } catch (const exceptions::JoynrMessageNotSentException&) {
+            thrown = std::chrono::steady_clock::now() - start < std::chrono::milliseconds(1000);
+        }
+    });
+    internalThread.join();
+    EXPECT_TRUE(thrown);
+}
+
+TEST_F(BackPressureControllerTest, perClientQuotaIsEnforced)
+{
+    auto controller = createController(BackPressurePolicy::Enum::DISABLED, 30);
+    auto first = controller->reserve("client1", 20);
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(nullptr, controller->reserve("client1", 20));
+    auto other = controller->reserve("client2", 20);
+    EXPECT_NE(nullptr, other);
+    // local producers are not subject to the quota
+    EXPECT_NE(nullptr, controller->reserve("", 50));
+    EXPECT_EQ(20, controller->getPendingBytes("client1"));
+
+    first.reset();
+    EXPECT_EQ(0, controller->getPendingBytes("client1"));
+    EXPECT_NE(nullptr, controller->reserve("client1", 20));
+}
+
+TEST_F(BackPressureControllerTest, reservationOutlivingControllerIsHarmless)
+{
+    auto controller = createController(BackPressurePolicy::Enum::NOTIFY);
+    auto reservation = controller->reserve("", 10);
+    controller.reset();
+    EXPECT_NO_FATAL_FAILURE(reservation.reset());
+}
+
+TEST(BackPressurePolicyTest, literalRoundTrip)
+{
+    for (auto policy : {BackPressurePolicy::Enum::DISABLED,
+                        BackPressurePolicy::Enum::BLOCK,
+                        BackPressurePolicy::Enum::FAIL_FAST,
+                        BackPressurePolicy::Enum::NOTIFY}) {
+        EXPECT_EQ(policy, BackPressurePolicy::getEnum(BackPressurePolicy::getLiteral(policy)));
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/types/GlobalDiscoveryEntry.h"
+#include "libjoynrclustercontroller/capabilities-client/BatchingCapabilitiesClient.h"
+
+#include "tests/JoynrTest.h"
+#include "tests/mock/MockCapabilitiesClient.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+MATCHER_P(ContainsParticipantIds, participantIds, "")
+{
+    if (arg.size() != participantIds.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < arg.size(); ++i) {
+        if (arg[i].getParticipantId() != participantIds[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+class BatchingCapabilitiesClientTest : public ::testing::Test
+{
+public:
+    BatchingCapabilitiesClientTest()
+            : singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              mockCapabilitiesClient(std::make_shared<MockCapabilitiesClient>()),
+              batchWindow(100),
+              batchingCapabilitiesClient(std::make_shared<BatchingCapabilitiesClient>(
+                      mockCapabilitiesClient,
+                      singleThreadedIOService->getIOService(),
+                      batchWindow))
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~BatchingCapabilitiesClientTest() override
+    {
+        singleThreadedIOService->stop();
+        batchingCapabilitiesClient.reset();
+    }
+
+protected:
+    types::GlobalDiscoveryEntry createEntry(const std::string& participantId)
+    {
+        types::GlobalDiscoveryEntry entry;
+        entry.setParticipantId(participantId);
+        return entry;
+    }
+
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    std::shared_ptr<MockCapabilitiesClient> mockCapabilitiesClient;
+    const std::chrono::milliseconds batchWindow;
+    std::shared_ptr<BatchingCapabilitiesClient> batchingCapabilitiesClient;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(BatchingCapabilitiesClientTest);
+};
+
+TEST_F(BatchingCapabilitiesClientTest, addsWithinBatchWindowAreSentOnce)
+{
+    Semaphore semaphore(0);
+    const std::vector<std::string> expectedParticipantIds{"p1", "p2", "p3"};
+    EXPECT_CALL(*mockCapabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(
+                            ContainsParticipantIds(expectedParticipantIds)),
+                    _,
+                    _)).WillOnce(DoAll(InvokeArgument<1>(), ReleaseSemaphore(&semaphore)));
+
+    int successCount = 0;
+    auto onSuccess = [&successCount]() { ++successCount; };
+    batchingCapabilitiesClient->add(createEntry("p1"), onSuccess, nullptr);
+    batchingCapabilitiesClient->add({createEntry("p2"), createEntry("p3")}, onSuccess, nullptr);
+
+    EXPECT_TRUE(semaphore.waitFor(batchWindow * 10));
+    EXPECT_EQ(2, successCount);
+}
+
+TEST_F(BatchingCapabilitiesClientTest, removesWithinBatchWindowAreSentOnce)
+{
+    Semaphore semaphore(0);
+    const std::vector<std::string> expectedParticipantIds{"p1", "p2"};
+    EXPECT_CALL(*mockCapabilitiesClient,
+                remove(Matcher<std::vector<std::string>>(Eq(expectedParticipantIds))))
+            .WillOnce(ReleaseSemaphore(&semaphore));
+
+    batchingCapabilitiesClient->remove("p1");
+    batchingCapabilitiesClient->remove(std::vector<std::string>{"p2", "p1"});
+
+    EXPECT_TRUE(semaphore.waitFor(batchWindow * 10));
+}
+
+TEST_F(BatchingCapabilitiesClientTest, removeSupersedesPendingAdd)
+{
+    Semaphore semaphore(0);
+    EXPECT_CALL(*mockCapabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(_), _, _)).Times(0);
+    EXPECT_CALL(*mockCapabilitiesClient,
+                remove(Matcher<std::vector<std::string>>(
+                        Eq(std::vector<std::string>{"p1"})))).WillOnce(ReleaseSemaphore(&semaphore));
+
+    bool addSucceeded = false;
+    batchingCapabilitiesClient->add(
+            createEntry("p1"), [&addSucceeded]() { addSucceeded = true; }, nullptr);
+    batchingCapabilitiesClient->remove("p1");
+
+    EXPECT_TRUE(semaphore.waitFor(batchWindow * 10));
+    EXPECT_TRUE(addSucceeded);
+}
+
+TEST_F(BatchingCapabilitiesClientTest, touchSendsPendingRequestsImmediately)
+{
+    InSequence inSequence;
+    EXPECT_CALL(*mockCapabilitiesClient,
+                remove(Matcher<std::vector<std::string>>(Eq(std::vector<std::string>{"p1"}))));
+    EXPECT_CALL(*mockCapabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(
+                            ContainsParticipantIds(std::vector<std::string>{"p2"})),
+                    _,
+                    _));
+    EXPECT_CALL(*mockCapabilitiesClient, touch(Eq("clusterControllerId"), _, _));
+
+    batchingCapabilitiesClient->remove("p1");
+    batchingCapabilitiesClient->add(createEntry("p2"), nullptr, nullptr);
+    batchingCapabilitiesClient->touch("clusterControllerId", nullptr, nullptr);
+}
+
+TEST_F(BatchingCapabilitiesClientTest, failedBatchCallsAllErrorCallbacks)
+{
+    Semaphore semaphore(0);
+    EXPECT_CALL(*mockCapabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(_), _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(exceptions::JoynrRuntimeException("failed")),
+                            ReleaseSemaphore(&semaphore)));
+
+    int errorCount = 0;
+    auto onError = [&errorCount](const exceptions::JoynrRuntimeException&) { ++errorCount; };
+    batchingCapabilitiesClient->add(createEntry("p1"), nullptr, onError);
+    batchingCapabilitiesClient->add(createEntry("p2"), nullptr, onError);
+
+    EXPECT_TRUE(semaphore.waitFor(batchWindow * 10));
+    EXPECT_EQ(2, errorCount);
+}
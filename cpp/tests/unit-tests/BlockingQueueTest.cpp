@@ -0,0 +1,177 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/BlockingQueue.h"
+#include "joynr/Runnable.h"
+#include "joynr/SchedulingPriority.h"
+#include "joynr/TimePoint.h"
+
+using namespace joynr;
+
+namespace
+{
+
+class PrioritizedRunnable : public Runnable
+{
+public:
+    PrioritizedRunnable(SchedulingPriority::Enum priority, TimePoint deadline)
+            : Runnable(), priority(priority), deadline(deadline)
+    {
+    }
+
+    void shutdown() override
+    {
+    }
+
+    void run() override
+    {
+    }
+
+    SchedulingPriority::Enum getPriority() const override
+    {
+        return priority;
+    }
+
+    TimePoint getDeadline() const override
+    {
+        return deadline;
+    }
+
+private:
+    const SchedulingPriority::Enum priority;
+    const TimePoint deadline;
+};
+
+std::shared_ptr<Runnable> createRunnable(SchedulingPriority::Enum priority,
+                                         TimePoint deadline = TimePoint::max())
+{
+    return std::make_shared<PrioritizedRunnable>(priority, deadline);
+}
+
+} // namespace
+
+TEST(BlockingQueueTest, takesRunnablesOfSamePriorityInFifoOrder)
+{
+    BlockingQueue queue;
+    std::vector<std::shared_ptr<Runnable>> runnables;
+    for (int i = 0; i < 5; ++i) {
+        runnables.push_back(createRunnable(SchedulingPriority::Enum::NORMAL));
+        queue.add(runnables.back());
+    }
+    EXPECT_EQ(5, queue.getQueueLength());
+
+    for (const auto& runnable : runnables) {
+        EXPECT_EQ(runnable, queue.take());
+    }
+    EXPECT_EQ(0, queue.getQueueLength());
+}
+
+TEST(BlockingQueueTest, takesHigherPriorityFirst)
+{
+    BlockingQueue queue;
+    auto low = createRunnable(SchedulingPriority::Enum::LOW);
+    auto normal = createRunnable(SchedulingPriority::Enum::NORMAL);
+    auto high = createRunnable(SchedulingPriority::Enum::HIGH);
+    queue.add(low);
+    queue.add(normal);
+    queue.add(high);
+
+    EXPECT_EQ(high, queue.take());
+    EXPECT_EQ(normal, queue.take());
+    EXPECT_EQ(low, queue.take());
+}
+
+TEST(BlockingQueueTest, takesEarliestDeadlineFirstWithinPriority)
+{
+    BlockingQueue queue;
+    const TimePoint now = TimePoint::now();
+    auto late = createRunnable(SchedulingPriority::Enum::NORMAL, now + 3000);
+    auto early = createRunnable(SchedulingPriority::Enum::NORMAL, now + 1000);
+    auto middle = createRunnable(SchedulingPriority::Enum::NORMAL, now + 2000);
+    queue.add(late);
+    queue.add(early);
+    queue.add(middle);
+
+    EXPECT_EQ(early, queue.take());
+    EXPECT_EQ(middle, queue.take());
+    EXPECT_EQ(late, queue.take());
+}
+
+TEST(BlockingQueueTest, lowerPrioritiesDoNotStarve)
+{
+    const std::uint32_t maxBypassCount = 3;
+    BlockingQueue queue(maxBypassCount);
+    auto low = createRunnable(SchedulingPriority::Enum::LOW);
+    auto normal = createRunnable(SchedulingPriority::Enum::NORMAL);
+    queue.add(low);
+    queue.add(normal);
+    for (int i = 0; i < 10; ++i) {
+        queue.add(createRunnable(SchedulingPriority::Enum::HIGH));
+    }
+
+    // LOW and NORMAL are both passed over three times, NORMAL is served first
+    for (std::uint32_t i = 0; i < maxBypassCount; ++i) {
+        EXPECT_EQ(SchedulingPriority::Enum::HIGH, queue.take()->getPriority());
+    }
+    EXPECT_EQ(normal, queue.take());
+    EXPECT_EQ(low, queue.take());
+    EXPECT_EQ(SchedulingPriority::Enum::HIGH, queue.take()->getPriority());
+}
+
+TEST(BlockingQueueTest, tasksWithoutDeadlineDoNotStarveWithinPriority)
+{
+    const std::uint32_t maxBypassCount = 3;
+    BlockingQueue queue(maxBypassCount);
+    const TimePoint now = TimePoint::now();
+    auto withoutDeadline = createRunnable(SchedulingPriority::Enum::NORMAL);
+    queue.add(withoutDeadline);
+    for (int i = 0; i < 10; ++i) {
+        queue.add(createRunnable(SchedulingPriority::Enum::NORMAL, now + 1000 + i));
+    }
+
+    for (std::uint32_t i = 0; i < maxBypassCount; ++i) {
+        EXPECT_NE(withoutDeadline, queue.take());
+    }
+    EXPECT_EQ(withoutDeadline, queue.take());
+    // the earliest deadline is served again afterwards
+    EXPECT_EQ(now + 1000 + maxBypassCount, queue.take()->getDeadline());
+}
+
+TEST(BlockingQueueTest, takeReturnsNullAfterShutdown)
+{
+    BlockingQueue queue;
+    queue.add(createRunnable(SchedulingPriority::Enum::NORMAL));
+
+    std::thread waitingThread([&queue]() {
+        // drains the queued runnable, then blocks until shutdown
+        EXPECT_NE(nullptr, queue.take());
+        EXPECT_EQ(nullptr, queue.take());
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.shutdown();
+    waitingThread.join();
+    EXPECT_EQ(0, queue.getQueueLength());
+}
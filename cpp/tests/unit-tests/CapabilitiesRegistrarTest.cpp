@@ -46,6 +46,7 @@ using ::testing::Return;
 using ::testing::Eq;
 using ::testing::_;
 using ::testing::Property;
+using ::testing::SizeIs;
 
 using namespace joynr;
 
@@ -361,3 +362,136 @@ TEST_F(CapabilitiesRegistrarTest, removeDispatcher)
 
     EXPECT_EQ(expectedParticipantId, participantId);
 }
+
+TEST_F(CapabilitiesRegistrarTest, addAndRemoveBatchUseSingleRoutingAndDiscoveryCalls)
+{
+    const std::string otherDomain = "otherTestDomain";
+    const std::string otherParticipantId = "otherTestParticipantId";
+    types::ProviderQos testQos;
+    EXPECT_CALL(*mockParticipantIdStorage,
+                getProviderParticipantId(domain, MockProvider::INTERFACE_NAME(), MockProvider::MAJOR_VERSION))
+            .WillOnce(Return(expectedParticipantId));
+    EXPECT_CALL(*mockParticipantIdStorage,
+                getProviderParticipantId(otherDomain, MockProvider::INTERFACE_NAME(), MockProvider::MAJOR_VERSION))
+            .WillOnce(Return(otherParticipantId));
+    EXPECT_CALL(*mockDispatcher, addRequestCaller(expectedParticipantId, _)).Times(1);
+    EXPECT_CALL(*mockDispatcher, addRequestCaller(otherParticipantId, _)).Times(1);
+
+    const std::vector<std::string> expectedParticipantIds{expectedParticipantId, otherParticipantId};
+    EXPECT_CALL(*mockMessageRouter, addNextHop(_, _, _, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mockMessageRouter, addNextHops(expectedParticipantIds, _, _, _, _, _, _))
+            .WillOnce(InvokeArgument<5>());
+    auto mockFuture = std::make_shared<joynr::Future<void>>();
+    mockFuture->onSuccess();
+    EXPECT_CALL(*mockDiscovery, addAsyncMock(_, _, _, _, _)).Times(0);
+    EXPECT_CALL(*mockDiscovery, addEntriesAsyncMock(SizeIs(2), false, _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(), Return(mockFuture)));
+
+    std::vector<ProviderRegistration> registrations;
+    registrations.push_back(
+            capabilitiesRegistrar->createProviderRegistration(domain, mockProvider, testQos));
+    registrations.push_back(
+            capabilitiesRegistrar->createProviderRegistration(otherDomain, mockProvider, testQos));
+
+    Future<void> future;
+    auto onSuccess = [&future]() { future.onSuccess(); };
+    auto onError = [&future](const exceptions::JoynrRuntimeException& exception) {
+        future.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+    };
+
+    std::vector<std::string> participantIds =
+            capabilitiesRegistrar->addAsync(std::move(registrations), onSuccess, onError);
+    future.get();
+    EXPECT_EQ(expectedParticipantIds, participantIds);
+
+    EXPECT_CALL(*mockDiscovery, removeAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockDiscovery, removeEntriesAsyncMock(participantIds, _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(mockFuture)));
+    EXPECT_CALL(*mockDispatcher, removeRequestCaller(expectedParticipantId)).Times(1);
+    EXPECT_CALL(*mockDispatcher, removeRequestCaller(otherParticipantId)).Times(1);
+    EXPECT_CALL(*mockMessageRouter, removeNextHops(participantIds, _, _))
+            .WillOnce(InvokeArgument<1>());
+
+    Future<void> removeFuture;
+    auto onRemoveSuccess = [&removeFuture]() { removeFuture.onSuccess(); };
+    auto onRemoveError = [&removeFuture](const exceptions::JoynrRuntimeException& exception) {
+        removeFuture.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+    };
+
+    capabilitiesRegistrar->removeAsync(participantIds, onRemoveSuccess, onRemoveError);
+    removeFuture.get();
+}
+
+TEST_F(CapabilitiesRegistrarTest, addBatchRemovesNextHopsIfDiscoveryFails)
+{
+    types::ProviderQos testQos;
+    EXPECT_CALL(*mockParticipantIdStorage,
+                getProviderParticipantId(domain, MockProvider::INTERFACE_NAME(), MockProvider::MAJOR_VERSION))
+            .WillOnce(Return(expectedParticipantId));
+
+    auto mockFuture = std::make_shared<joynr::Future<void>>();
+    EXPECT_CALL(*mockDiscovery, addEntriesAsyncMock(SizeIs(1), _, _, _, _))
+            .WillOnce(DoAll(InvokeArgument<3>(exceptions::JoynrRuntimeException("testError")),
+                            Return(mockFuture)));
+    EXPECT_CALL(*mockMessageRouter,
+                removeNextHops(std::vector<std::string>{expectedParticipantId}, _, _))
+            .Times(1);
+
+    std::vector<ProviderRegistration> registrations;
+    registrations.push_back(
+            capabilitiesRegistrar->createProviderRegistration(domain, mockProvider, testQos));
+
+    Future<void> future;
+    auto onSuccess = [&future]() { future.onSuccess(); };
+    auto onError = [&future](const exceptions::JoynrRuntimeException& exception) {
+        future.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+    };
+
+    capabilitiesRegistrar->addAsync(std::move(registrations), onSuccess, onError);
+    EXPECT_THROW(future.get(), exceptions::JoynrRuntimeException);
+}
+
+TEST_F(CapabilitiesRegistrarTest, addBatchRemovesAddedNextHopsIfRoutingFails)
+{
+    const std::string otherDomain = "otherTestDomain";
+    const std::string otherParticipantId = "otherTestParticipantId";
+    types::ProviderQos globalQos;
+    globalQos.setScope(types::ProviderScope::GLOBAL);
+    types::ProviderQos localQos;
+    localQos.setScope(types::ProviderScope::LOCAL);
+    EXPECT_CALL(*mockParticipantIdStorage,
+                getProviderParticipantId(domain, MockProvider::INTERFACE_NAME(), MockProvider::MAJOR_VERSION))
+            .WillOnce(Return(expectedParticipantId));
+    EXPECT_CALL(*mockParticipantIdStorage,
+                getProviderParticipantId(otherDomain, MockProvider::INTERFACE_NAME(), MockProvider::MAJOR_VERSION))
+            .WillOnce(Return(otherParticipantId));
+
+    // the hops of the global provider are added, the ones of the local provider fail
+    EXPECT_CALL(*mockMessageRouter,
+                addNextHops(std::vector<std::string>{expectedParticipantId}, _, true, _, _, _, _))
+            .WillOnce(InvokeArgument<5>());
+    EXPECT_CALL(*mockMessageRouter,
+                addNextHops(std::vector<std::string>{otherParticipantId}, _, false, _, _, _, _))
+            .WillOnce(InvokeArgument<6>(exceptions::ProviderRuntimeException("testError")));
+    EXPECT_CALL(*mockMessageRouter,
+                removeNextHops(std::vector<std::string>{expectedParticipantId, otherParticipantId},
+                               _,
+                               _))
+            .Times(1);
+    EXPECT_CALL(*mockDiscovery, addEntriesAsyncMock(_, _, _, _, _)).Times(0);
+
+    std::vector<ProviderRegistration> registrations;
+    registrations.push_back(
+            capabilitiesRegistrar->createProviderRegistration(domain, mockProvider, globalQos));
+    registrations.push_back(
+            capabilitiesRegistrar->createProviderRegistration(otherDomain, mockProvider, localQos));
+
+    Future<void> future;
+    auto onSuccess = [&future]() { future.onSuccess(); };
+    auto onError = [&future](const exceptions::JoynrRuntimeException& exception) {
+        future.onError(std::make_shared<exceptions::JoynrRuntimeException>(exception));
+    };
+
+    capabilitiesRegistrar->addAsync(std::move(registrations), onSuccess, onError);
+    EXPECT_THROW(future.get(), exceptions::JoynrRuntimeException);
+}
@@ -0,0 +1,180 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/CapabilitiesSnapshotStore.h"
+#include "joynr/types/CustomParameter.h"
+#include "joynr/types/DiscoveryEntry.h"
+#include "joynr/types/ProviderQos.h"
+#include "joynr/types/Version.h"
+
+using namespace joynr;
+
+class CapabilitiesSnapshotStoreTest : public ::testing::Test
+{
+public:
+    CapabilitiesSnapshotStoreTest() : fileName("CapabilitiesSnapshotStoreTest.persist")
+    {
+        removeFiles();
+    }
+
+    ~CapabilitiesSnapshotStoreTest() override
+    {
+        removeFiles();
+    }
+
+protected:
+    types::DiscoveryEntry createEntry(const std::string& participantId,
+                                      std::int64_t priority = 1)
+    {
+        types::ProviderQos qos({types::CustomParameter("name", "value")},
+                               priority,
+                               types::ProviderScope::LOCAL,
+                               true);
+        return types::DiscoveryEntry(types::Version(47, 11),
+                                     "domain",
+                                     "interface",
+                                     participantId,
+                                     qos,
+                                     1000,
+                                     10000,
+                                     "publicKeyId");
+    }
+
+    std::vector<types::DiscoveryEntry> load()
+    {
+        capabilities::SnapshotStore store(fileName);
+        std::vector<types::DiscoveryEntry> entries;
+        EXPECT_TRUE(store.load(entries));
+        return entries;
+    }
+
+    void removeFiles()
+    {
+        std::remove((fileName + ".snapshot").c_str());
+        std::remove((fileName + ".journal").c_str());
+    }
+
+    const std::string fileName;
+};
+
+TEST_F(CapabilitiesSnapshotStoreTest, loadWithoutFilesReturnsFalse)
+{
+    capabilities::SnapshotStore store(fileName);
+    std::vector<types::DiscoveryEntry> entries;
+    EXPECT_FALSE(store.load(entries));
+    EXPECT_TRUE(entries.empty());
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, journaledChangesAreReplayed)
+{
+    {
+        capabilities::SnapshotStore store(fileName);
+        store.add({createEntry("p1"), createEntry("p2"), createEntry("p3")});
+        store.remove({"p2"});
+        store.add({createEntry("p1", 42)});
+    }
+
+    const std::vector<types::DiscoveryEntry> entries = load();
+    ASSERT_EQ(2, entries.size());
+    EXPECT_EQ(createEntry("p1", 42), entries[0]);
+    EXPECT_EQ(createEntry("p3"), entries[1]);
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, snapshotEmptiesJournal)
+{
+    {
+        capabilities::SnapshotStore store(fileName);
+        store.add({createEntry("p1"), createEntry("p2")});
+        store.writeSnapshot({createEntry("p1"), createEntry("p2")});
+        store.remove({"p1"});
+    }
+
+    EXPECT_EQ(std::vector<types::DiscoveryEntry>({createEntry("p2")}), load());
+    std::ifstream journal(fileName + ".journal", std::ios::binary | std::ios::ate);
+    EXPECT_LT(journal.tellg(), 64);
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, compactionIsRequiredWhenJournalOutgrowsSnapshot)
+{
+    capabilities::SnapshotStore store(fileName, 2);
+    store.writeSnapshot({createEntry("p1"), createEntry("p2"), createEntry("p3")});
+    store.add({createEntry("p4"), createEntry("p5")});
+    EXPECT_FALSE(store.isCompactionRequired());
+    store.remove({"p4"});
+    EXPECT_TRUE(store.isCompactionRequired());
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, incompleteJournalRecordIsDropped)
+{
+    {
+        capabilities::SnapshotStore store(fileName);
+        store.add({createEntry("p1")});
+    }
+    {
+        std::ofstream journal(fileName + ".journal", std::ios::binary | std::ios::app);
+        journal << "incomplete record";
+    }
+    {
+        capabilities::SnapshotStore store(fileName);
+        std::vector<types::DiscoveryEntry> entries;
+        ASSERT_TRUE(store.load(entries));
+        EXPECT_EQ(1, entries.size());
+        // records appended after the dropped tail must be readable
+        store.add({createEntry("p2")});
+    }
+
+    EXPECT_EQ(2, load().size());
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, corruptSnapshotThrows)
+{
+    {
+        std::ofstream snapshot(fileName + ".snapshot", std::ios::binary);
+        snapshot << "not a snapshot";
+    }
+    capabilities::SnapshotStore store(fileName);
+    std::vector<types::DiscoveryEntry> entries;
+    EXPECT_THROW(store.load(entries), std::runtime_error);
+}
+
+TEST_F(CapabilitiesSnapshotStoreTest, corruptJournalThrowsAndIsKept)
+{
+    const std::string content = "not a journal";
+    {
+        std::ofstream journal(fileName + ".journal", std::ios::binary);
+        journal << content;
+    }
+    {
+        capabilities::SnapshotStore store(fileName);
+        std::vector<types::DiscoveryEntry> entries;
+        EXPECT_THROW(store.load(entries), std::runtime_error);
+    }
+    std::ifstream journal(fileName + ".journal", std::ios::binary);
+    const std::string persistedContent(
+            (std::istreambuf_iterator<char>(journal)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, persistedContent);
+}
@@ -17,9 +17,11 @@
  * #L%
  */
 
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <thread>
+#include <vector>
 #include <chrono>
 
 #include <gtest/gtest.h>
@@ -29,6 +31,7 @@
 #include "joynr/types/Version.h"
 #include "joynr/types/DiscoveryQos.h"
 #include "joynr/types/DiscoveryEntry.h"
+#include "joynr/serializer/Serializer.h"
 
 using namespace ::testing;
 using namespace joynr;
@@ -144,3 +147,198 @@ TYPED_TEST(CapabilitiesStorageTest, removeExpiredEntries)
     EXPECT_THAT(removedEntries, Contains(entry1));
     EXPECT_THAT(removedEntries, Not(Contains(entry2)));
 }
+
+TYPED_TEST(CapabilitiesStorageTest, findReflectsInsertReplaceAndRemove)
+{
+    TypeParam storage;
+    EXPECT_EQ(nullptr, storage.findByParticipantId(this->participantId));
+    EXPECT_TRUE(storage.findByDomainAndInterface(this->domain, this->interface).empty());
+
+    storage.insert(this->entry);
+    auto found = storage.findByParticipantId(this->participantId);
+    ASSERT_NE(nullptr, found);
+    EXPECT_EQ(this->entry, static_cast<const types::DiscoveryEntry&>(*found));
+    EXPECT_EQ(1, storage.findByDomainAndInterface(this->domain, this->interface).size());
+
+    this->entry.setDomain("new-domain");
+    storage.insert(this->entry);
+    EXPECT_TRUE(storage.findByDomainAndInterface(this->domain, this->interface).empty());
+    EXPECT_EQ(1, storage.findByDomainAndInterface("new-domain", this->interface).size());
+    // entries handed out before stay valid and unchanged
+    EXPECT_EQ(this->domain, found->getDomain());
+
+    storage.removeByParticipantId(this->participantId);
+    EXPECT_EQ(nullptr, storage.findByParticipantId(this->participantId));
+    EXPECT_TRUE(storage.findByDomainAndInterface("new-domain", this->interface).empty());
+
+    storage.insert(this->entry);
+    storage.clear();
+    EXPECT_EQ(nullptr, storage.findByParticipantId(this->participantId));
+}
+
+TYPED_TEST(CapabilitiesStorageTest, removeExpiredEntriesAreNotFound)
+{
+    TypeParam storage;
+    this->entry.setExpiryDateMs(0);
+    storage.insert(this->entry);
+    ASSERT_NE(nullptr, storage.findByParticipantId(this->participantId));
+
+    storage.removeExpired();
+    EXPECT_EQ(nullptr, storage.findByParticipantId(this->participantId));
+    EXPECT_TRUE(storage.findByDomainAndInterface(this->domain, this->interface).empty());
+}
+
+TYPED_TEST(CapabilitiesStorageTest, removeExpiredRemovesAtMostMaxCountEntries)
+{
+    TypeParam storage;
+    for (int i = 0; i < 5; ++i) {
+        this->entry.setParticipantId("participantId" + std::to_string(i));
+        this->entry.setExpiryDateMs(i + 1);
+        storage.insert(this->entry);
+    }
+
+    auto removedEntries = storage.removeExpired(2);
+    ASSERT_EQ(2, removedEntries.size());
+    // the entries which expired first are removed first
+    EXPECT_EQ("participantId0", removedEntries[0].getParticipantId());
+    EXPECT_EQ("participantId1", removedEntries[1].getParticipantId());
+    EXPECT_EQ(3, storage.size());
+
+    EXPECT_EQ(3, storage.removeExpired(0).size());
+    EXPECT_EQ(0, storage.size());
+}
+
+TYPED_TEST(CapabilitiesStorageTest, findIsSafeWhileWriting)
+{
+    TypeParam storage;
+    std::atomic<bool> stop(false);
+    std::atomic<std::uint64_t> inconsistentEntries(0);
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([this, &storage, &stop, &inconsistentEntries]() {
+            while (!stop) {
+                for (const auto& found :
+                     storage.findByDomainAndInterface(this->domain, this->interface)) {
+                    if (found->getDomain() != this->domain) {
+                        ++inconsistentEntries;
+                    }
+                }
+                auto found = storage.findByParticipantId("participantId7");
+                if (found && found->getParticipantId() != "participantId7") {
+                    ++inconsistentEntries;
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            this->entry.setParticipantId("participantId" + std::to_string(i));
+            storage.insert(this->entry);
+        }
+        for (int i = 0; i < 20; i += 2) {
+            storage.removeByParticipantId("participantId" + std::to_string(i));
+        }
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, inconsistentEntries);
+    EXPECT_EQ(10, storage.findByDomainAndInterface(this->domain, this->interface).size());
+}
+
+TEST(CachingStorageTest, evictedEntriesAreNotFound)
+{
+    capabilities::CachingStorage storage(2);
+    types::DiscoveryEntry entry;
+    entry.setDomain("domain");
+    entry.setInterfaceName("interface");
+    for (const std::string participantId : {"participantId1", "participantId2", "participantId3"}) {
+        entry.setParticipantId(participantId);
+        storage.insert(entry);
+    }
+
+    EXPECT_EQ(2, storage.size());
+    std::size_t found = 0;
+    for (const auto& cachedEntry : storage) {
+        EXPECT_NE(nullptr, storage.findByParticipantId(cachedEntry.getParticipantId()));
+        ++found;
+    }
+    EXPECT_EQ(2, found);
+    EXPECT_EQ(2, storage.findByDomainAndInterface("domain", "interface").size());
+}
+
+TEST(CachingStorageTest, findCacheFiltersByAge)
+{
+    capabilities::CachingStorage storage;
+    types::DiscoveryEntry entry;
+    entry.setParticipantId("participantId");
+    entry.setDomain("domain");
+    entry.setInterfaceName("interface");
+    storage.insert(entry);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(nullptr,
+              storage.findCacheByParticipantId("participantId", std::chrono::milliseconds(5)));
+    EXPECT_NE(nullptr, storage.findCacheByParticipantId("participantId", std::chrono::hours(1)));
+
+    std::chrono::milliseconds oldestAge(-1);
+    EXPECT_TRUE(storage.findCacheByDomainAndInterface(
+                               "domain", "interface", std::chrono::milliseconds(5), oldestAge)
+                        .empty());
+    EXPECT_EQ(std::chrono::milliseconds(-1), oldestAge);
+    EXPECT_EQ(1,
+              storage.findCacheByDomainAndInterface(
+                             "domain", "interface", std::chrono::hours(1), oldestAge)
+                      .size());
+    EXPECT_GE(oldestAge, std::chrono::milliseconds(20));
+}
+
+TEST(StorageTest, insertRangeReplacesEntriesWithSameParticipantId)
+{
+    capabilities::Storage storage;
+    types::DiscoveryEntry entry;
+    entry.setParticipantId("participantId1");
+    entry.setDomain("domain");
+    entry.setInterfaceName("interface");
+    storage.insert(entry);
+
+    std::vector<types::DiscoveryEntry> entries;
+    for (const std::string participantId : {"participantId1", "participantId2"}) {
+        entry.setParticipantId(participantId);
+        entry.setDomain("otherDomain");
+        entries.push_back(entry);
+    }
+    entry.setParticipantId("participantId2");
+    entry.setDomain("domain");
+    entries.push_back(entry);
+    storage.insert(entries.cbegin(), entries.cend());
+
+    EXPECT_EQ(2, storage.size());
+    EXPECT_EQ("otherDomain", storage.findByParticipantId("participantId1")->getDomain());
+    EXPECT_EQ("domain", storage.findByParticipantId("participantId2")->getDomain());
+    EXPECT_EQ(1, storage.findByDomainAndInterface("domain", "interface").size());
+    EXPECT_EQ(1, storage.findByDomainAndInterface("otherDomain", "interface").size());
+}
+
+TEST(StorageTest, deserializedEntriesAreFound)
+{
+    capabilities::Storage storage;
+    types::DiscoveryEntry entry;
+    entry.setParticipantId("participantId");
+    entry.setDomain("domain");
+    entry.setInterfaceName("interface");
+    storage.insert(entry);
+
+    capabilities::Storage deserializedStorage;
+    joynr::serializer::deserializeFromJson(
+            deserializedStorage, joynr::serializer::serializeToJson(storage));
+
+    EXPECT_EQ(1, deserializedStorage.size());
+    ASSERT_NE(nullptr, deserializedStorage.findByParticipantId("participantId"));
+    EXPECT_EQ(entry, *deserializedStorage.findByParticipantId("participantId"));
+    EXPECT_EQ(1, deserializedStorage.findByDomainAndInterface("domain", "interface").size());
+}
@@ -0,0 +1,141 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/DistributedReadWriteLock.h"
+#include "joynr/Semaphore.h"
+
+using joynr::DistributedReadWriteLock;
+using joynr::Semaphore;
+
+TEST(DistributedReadWriteLockTest, readersDoNotExcludeEachOther)
+{
+    DistributedReadWriteLock lock;
+    boost::shared_lock<DistributedReadWriteLock> firstReader(lock);
+
+    std::thread secondReader([&lock]() {
+        EXPECT_TRUE(lock.try_lock_shared());
+        lock.unlock_shared();
+    });
+    secondReader.join();
+}
+
+TEST(DistributedReadWriteLockTest, readerExcludesWriter)
+{
+    DistributedReadWriteLock lock;
+    boost::shared_lock<DistributedReadWriteLock> reader(lock);
+
+    std::thread writer([&lock]() { EXPECT_FALSE(lock.try_lock()); });
+    writer.join();
+}
+
+TEST(DistributedReadWriteLockTest, writerExcludesReadersAndWriters)
+{
+    DistributedReadWriteLock lock;
+    boost::unique_lock<DistributedReadWriteLock> writer(lock);
+
+    std::thread other([&lock]() {
+        EXPECT_FALSE(lock.try_lock_shared());
+        EXPECT_FALSE(lock.try_lock());
+    });
+    other.join();
+}
+
+TEST(DistributedReadWriteLockTest, writerWaitsForReaders)
+{
+    DistributedReadWriteLock lock;
+    Semaphore readerLocked(0);
+    Semaphore releaseReader(0);
+    std::atomic<bool> readerReleased(false);
+
+    std::thread reader([&]() {
+        boost::shared_lock<DistributedReadWriteLock> locker(lock);
+        readerLocked.notify();
+        releaseReader.wait();
+        readerReleased = true;
+    });
+    readerLocked.wait();
+
+    std::thread writer([&]() {
+        boost::unique_lock<DistributedReadWriteLock> locker(lock);
+        EXPECT_TRUE(readerReleased);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    releaseReader.notify();
+
+    reader.join();
+    writer.join();
+}
+
+TEST(DistributedReadWriteLockTest, readerWaitsForWriter)
+{
+    DistributedReadWriteLock lock;
+    Semaphore writerLocked(0);
+    std::atomic<bool> writerReleased(false);
+
+    std::thread writer([&]() {
+        boost::unique_lock<DistributedReadWriteLock> locker(lock);
+        writerLocked.notify();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        writerReleased = true;
+    });
+    writerLocked.wait();
+
+    {
+        boost::shared_lock<DistributedReadWriteLock> locker(lock);
+        EXPECT_TRUE(writerReleased);
+    }
+    writer.join();
+}
+
+TEST(DistributedReadWriteLockTest, concurrentReadersAndWritersSeeConsistentState)
+{
+    DistributedReadWriteLock lock;
+    const int numberOfThreads = 8;
+    const int iterations = 2000;
+    std::int64_t first = 0;
+    std::int64_t second = 0;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; ++i) {
+        threads.emplace_back([&, i]() {
+            for (int j = 0; j < iterations; ++j) {
+                if (j % 10 == i % 10) {
+                    boost::unique_lock<DistributedReadWriteLock> locker(lock);
+                    ++first;
+                    ++second;
+                } else {
+                    boost::shared_lock<DistributedReadWriteLock> locker(lock);
+                    EXPECT_EQ(first, second);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(numberOfThreads * iterations / 10, first);
+}
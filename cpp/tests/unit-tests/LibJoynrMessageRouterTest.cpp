@@ -26,6 +26,7 @@
 #include <gmock/gmock.h>
 
 #include "joynr/InProcessMessagingAddress.h"
+#include "joynr/exceptions/MethodInvocationException.h"
 #include "joynr/system/RoutingTypes/Address.h"
 #include "joynr/system/RoutingTypes/BrowserAddress.h"
 #include "joynr/system/RoutingTypes/ChannelAddress.h"
@@ -45,6 +46,7 @@ using ::testing::Eq;
 using ::testing::InSequence;
 using ::testing::InvokeArgument;
 using ::testing::Mock;
+using ::testing::Ne;
 using ::testing::Pointee;
 using ::testing::Return;
 
@@ -388,6 +390,128 @@ TEST_F(LibJoynrMessageRouterTest, addNextHop_callsAddNextHopInRoutingProxy)
     testAddNextHopCallsRoutingProxyCorrectly(isGloballyVisible, providerAddress2);
 }
 
+TEST_F(LibJoynrMessageRouterTest, addNextHops_callsRoutingProxyOnceForAllParticipants)
+{
+    const std::vector<std::string> providerParticipantIds{"provider1", "provider2", "provider3"};
+    const bool isProviderGloballyVisible = true;
+    auto mockRoutingProxy = std::make_unique<MockRoutingProxy>(runtime);
+    const std::string proxyParticipantId = mockRoutingProxy->getProxyParticipantId();
+    EXPECT_CALL(*mockRoutingProxy, addNextHopAsyncMock(Eq(proxyParticipantId), _, _, _, _, _));
+    EXPECT_CALL(*mockRoutingProxy, addNextHopAsyncMock(Ne(proxyParticipantId), _, _, _, _, _))
+            .Times(0);
+    EXPECT_CALL(*mockRoutingProxy,
+                addNextHopsAsyncMock(Eq(providerParticipantIds),
+                                     Eq(*webSocketClientAddress),
+                                     Eq(isProviderGloballyVisible),
+                                     _,
+                                     _,
+                                     _))
+            .WillOnce(DoAll(InvokeArgument<3>(), Return(nullptr)));
+
+    messageRouter->setParentAddress(std::string("parentParticipantId"), localTransport);
+    messageRouter->setParentRouter(std::move(mockRoutingProxy));
+
+    auto dispatcher = std::make_shared<MockDispatcher>();
+    auto mockSkeleton = std::make_shared<MockInProcessMessagingSkeleton>(dispatcher);
+    const auto providerAddress =
+            std::make_shared<const joynr::InProcessMessagingAddress>(mockSkeleton);
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    Semaphore successCallbackCalled;
+    messageRouter->addNextHops(
+            providerParticipantIds,
+            providerAddress,
+            isProviderGloballyVisible,
+            expiryDateMs,
+            isSticky,
+            [&successCallbackCalled]() { successCallbackCalled.notify(); },
+            [](const joynr::exceptions::ProviderRuntimeException&) { FAIL() << "onError called"; });
+    EXPECT_TRUE(successCallbackCalled.waitFor(std::chrono::milliseconds(5000)));
+}
+
+TEST_F(LibJoynrMessageRouterTest, removeNextHops_reportsErrorOfRoutingProxy)
+{
+    const std::vector<std::string> providerParticipantIds{"provider1", "provider2"};
+    MockRoutingProxy* mockRoutingProxyRef = setParentRouter();
+    EXPECT_CALL(*mockRoutingProxyRef, removeNextHopsAsyncMock(Eq(providerParticipantIds), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(exceptions::JoynrRuntimeException("testError")),
+                            Return(nullptr)));
+
+    Semaphore errorCallbackCalled;
+    messageRouter->removeNextHops(
+            providerParticipantIds,
+            []() { FAIL() << "onSuccess called"; },
+            [&errorCallbackCalled](const joynr::exceptions::ProviderRuntimeException&) {
+                errorCallbackCalled.notify();
+            });
+    EXPECT_TRUE(errorCallbackCalled.waitFor(std::chrono::milliseconds(5000)));
+}
+
+TEST_F(LibJoynrMessageRouterTest, addNextHops_addsParticipantsOneByOneIfParentRouterIsOlder)
+{
+    const std::vector<std::string> providerParticipantIds{"provider1", "provider2"};
+    const bool isProviderGloballyVisible = false;
+    auto mockRoutingProxy = std::make_unique<MockRoutingProxy>(runtime);
+    const std::string proxyParticipantId = mockRoutingProxy->getProxyParticipantId();
+    EXPECT_CALL(*mockRoutingProxy, addNextHopAsyncMock(Eq(proxyParticipantId), _, _, _, _, _));
+    EXPECT_CALL(*mockRoutingProxy, addNextHopsAsyncMock(Eq(providerParticipantIds), _, _, _, _, _))
+            .WillOnce(DoAll(InvokeArgument<4>(exceptions::MethodInvocationException(
+                                    "unknown method name for interface system/Routing")),
+                            Return(nullptr)));
+    for (const std::string& providerParticipantId : providerParticipantIds) {
+        EXPECT_CALL(*mockRoutingProxy,
+                    addNextHopAsyncMock(Eq(providerParticipantId),
+                                        Eq(*webSocketClientAddress),
+                                        Eq(isProviderGloballyVisible),
+                                        _,
+                                        _,
+                                        _))
+                .WillOnce(DoAll(InvokeArgument<3>(), Return(nullptr)));
+    }
+
+    messageRouter->setParentAddress(std::string("parentParticipantId"), localTransport);
+    messageRouter->setParentRouter(std::move(mockRoutingProxy));
+
+    auto dispatcher = std::make_shared<MockDispatcher>();
+    auto mockSkeleton = std::make_shared<MockInProcessMessagingSkeleton>(dispatcher);
+    const auto providerAddress =
+            std::make_shared<const joynr::InProcessMessagingAddress>(mockSkeleton);
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    Semaphore successCallbackCalled;
+    messageRouter->addNextHops(
+            providerParticipantIds,
+            providerAddress,
+            isProviderGloballyVisible,
+            expiryDateMs,
+            isSticky,
+            [&successCallbackCalled]() { successCallbackCalled.notify(); },
+            [](const joynr::exceptions::ProviderRuntimeException&) { FAIL() << "onError called"; });
+    EXPECT_TRUE(successCallbackCalled.waitFor(std::chrono::milliseconds(5000)));
+}
+
+TEST_F(LibJoynrMessageRouterTest, removeNextHops_removesParticipantsOneByOneIfParentRouterIsOlder)
+{
+    const std::vector<std::string> providerParticipantIds{"provider1", "provider2"};
+    MockRoutingProxy* mockRoutingProxyRef = setParentRouter();
+    EXPECT_CALL(*mockRoutingProxyRef, removeNextHopsAsyncMock(Eq(providerParticipantIds), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(exceptions::MethodInvocationException(
+                                    "unknown method name for interface system/Routing")),
+                            Return(nullptr)));
+    for (const std::string& providerParticipantId : providerParticipantIds) {
+        EXPECT_CALL(*mockRoutingProxyRef,
+                    removeNextHopAsyncMock(Eq(providerParticipantId), _, _, _))
+                .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    }
+
+    Semaphore successCallbackCalled;
+    messageRouter->removeNextHops(
+            providerParticipantIds,
+            [&successCallbackCalled]() { successCallbackCalled.notify(); },
+            [](const joynr::exceptions::ProviderRuntimeException&) { FAIL() << "onError called"; });
+    EXPECT_TRUE(successCallbackCalled.waitFor(std::chrono::milliseconds(5000)));
+}
+
 TEST_F(LibJoynrMessageRouterTest, setToKnown_addsParentAddress)
 {
     auto mockRoutingProxy = std::make_unique<MockRoutingProxy>(runtime);
@@ -18,8 +18,12 @@
  */
 
 #include <cstdint>
+#include <fstream>
 #include <functional>
+#include <iterator>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 
@@ -151,6 +155,7 @@ public:
 
         joynr::test::util::removeFileInCurrentDirectory(".*\\.settings");
         joynr::test::util::removeFileInCurrentDirectory(".*\\.persist");
+        joynr::test::util::removeFileInCurrentDirectory(".*\\.persist\\.(snapshot|journal)");
     }
 
     void fakeLookupZeroResultsForInterfaceAddress(
@@ -612,6 +617,115 @@ TEST_F(LocalCapabilitiesDirectoryTest, addLocallyDoesNotCallCapabilitiesClient)
     EXPECT_EQ(1, callback->getResults(TIMEOUT).size());
 }
 
+TEST_F(LocalCapabilitiesDirectoryTest, addBatchCallsCapabilitiesClientOnce)
+{
+    types::ProviderQos localProviderQos;
+    localProviderQos.setScope(types::ProviderScope::LOCAL);
+    const std::vector<types::DiscoveryEntry> entries{
+            types::DiscoveryEntry(defaultProviderVersion,
+                                  DOMAIN_1_NAME,
+                                  INTERFACE_1_NAME,
+                                  dummyParticipantId1,
+                                  types::ProviderQos(),
+                                  lastSeenDateMs,
+                                  expiryDateMs,
+                                  PUBLIC_KEY_ID),
+            types::DiscoveryEntry(defaultProviderVersion,
+                                  DOMAIN_2_NAME,
+                                  INTERFACE_2_NAME,
+                                  dummyParticipantId2,
+                                  types::ProviderQos(),
+                                  lastSeenDateMs,
+                                  expiryDateMs,
+                                  PUBLIC_KEY_ID),
+            types::DiscoveryEntry(defaultProviderVersion,
+                                  DOMAIN_3_NAME,
+                                  INTERFACE_3_NAME,
+                                  dummyParticipantId3,
+                                  localProviderQos,
+                                  lastSeenDateMs,
+                                  expiryDateMs,
+                                  PUBLIC_KEY_ID)};
+
+    EXPECT_CALL(*capabilitiesClient,
+                add(Matcher<const types::GlobalDiscoveryEntry&>(_), _, _)).Times(0);
+    EXPECT_CALL(*capabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(SizeIs(2)), _, _))
+            .Times(1);
+
+    bool onSuccessCalled = false;
+    localCapabilitiesDirectory->add(entries,
+                                    false,
+                                    [&onSuccessCalled]() { onSuccessCalled = true; },
+                                    [](const exceptions::ProviderRuntimeException&) { FAIL(); });
+    EXPECT_TRUE(onSuccessCalled);
+
+    for (const types::DiscoveryEntry& entry : entries) {
+        localCapabilitiesDirectory->lookup(entry.getParticipantId(), callback);
+        EXPECT_EQ(1, callback->getResults(TIMEOUT).size());
+        callback->clearResults();
+    }
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, removeBatchRemovesNextHopsOnce)
+{
+    const std::vector<std::string> participantIds{dummyParticipantId1, dummyParticipantId2};
+    for (const std::string& participantId : participantIds) {
+        types::DiscoveryEntry entry(defaultProviderVersion,
+                                    DOMAIN_1_NAME,
+                                    INTERFACE_1_NAME,
+                                    participantId,
+                                    types::ProviderQos(),
+                                    lastSeenDateMs,
+                                    expiryDateMs,
+                                    PUBLIC_KEY_ID);
+        localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+    }
+
+    EXPECT_CALL(*capabilitiesClient, remove(Matcher<std::vector<std::string>>(participantIds)))
+            .Times(1);
+    EXPECT_CALL(*mockMessageRouter, removeNextHop(_, _, _)).Times(0);
+    EXPECT_CALL(*mockMessageRouter, removeNextHops(participantIds, _, _)).Times(1);
+
+    bool onSuccessCalled = false;
+    localCapabilitiesDirectory->remove(participantIds,
+                                       [&onSuccessCalled]() { onSuccessCalled = true; },
+                                       defaultOnError);
+    EXPECT_TRUE(onSuccessCalled);
+
+    discoveryQos.setDiscoveryScope(types::DiscoveryScope::LOCAL_ONLY);
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(0, callback->getResults(TIMEOUT).size());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, removeBatchReportsErrorOfMessageRouter)
+{
+    const std::vector<std::string> participantIds{dummyParticipantId1, dummyParticipantId2};
+    for (const std::string& participantId : participantIds) {
+        types::DiscoveryEntry entry(defaultProviderVersion,
+                                    DOMAIN_1_NAME,
+                                    INTERFACE_1_NAME,
+                                    participantId,
+                                    types::ProviderQos(),
+                                    lastSeenDateMs,
+                                    expiryDateMs,
+                                    PUBLIC_KEY_ID);
+        localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+    }
+
+    EXPECT_CALL(*mockMessageRouter, removeNextHops(participantIds, _, _))
+            .WillOnce(InvokeArgument<2>(exceptions::ProviderRuntimeException("testError")));
+
+    bool onErrorCalled = false;
+    localCapabilitiesDirectory->remove(
+            participantIds,
+            []() { FAIL() << "onSuccess called"; },
+            [&onErrorCalled](const exceptions::ProviderRuntimeException&) {
+                onErrorCalled = true;
+            });
+    EXPECT_TRUE(onErrorCalled);
+}
+
 TEST_F(LocalCapabilitiesDirectoryTest, lookupForInterfaceAddressReturnsCachedValues)
 {
 
@@ -666,6 +780,194 @@ TEST_F(LocalCapabilitiesDirectoryTest, lookupForInterfaceAddressDelegatesToCapab
     EXPECT_TRUE(secondParticipantIdFound);
 }
 
+TEST_F(LocalCapabilitiesDirectoryTest, identicalGlobalLookupsInFlightAreCoalesced)
+{
+    std::function<void(const std::vector<types::GlobalDiscoveryEntry>&)> onGlobalLookupSuccess;
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(1)
+            .WillOnce(SaveArg<3>(&onGlobalLookupSuccess));
+
+    auto secondCallback = std::make_shared<MockLocalCapabilitiesDirectoryCallback>();
+    auto thirdCallback = std::make_shared<MockLocalCapabilitiesDirectoryCallback>();
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::GLOBAL_ONLY);
+    localCapabilitiesDirectory->lookup(
+            {DOMAIN_1_NAME, DOMAIN_2_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    localCapabilitiesDirectory->lookup(
+            {DOMAIN_2_NAME, DOMAIN_1_NAME}, INTERFACE_1_NAME, secondCallback, discoveryQos);
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::LOCAL_AND_GLOBAL);
+    localCapabilitiesDirectory->lookup(
+            {DOMAIN_1_NAME, DOMAIN_2_NAME}, INTERFACE_1_NAME, thirdCallback, discoveryQos);
+
+    EXPECT_EQ(1, localCapabilitiesDirectory->getNumberOfGlobalLookups());
+    EXPECT_EQ(2, localCapabilitiesDirectory->getNumberOfCoalescedGlobalLookups());
+
+    ASSERT_TRUE(onGlobalLookupSuccess);
+    fakeLookupWithResults({DOMAIN_1_NAME, DOMAIN_2_NAME},
+                          INTERFACE_1_NAME,
+                          discoveryQos.getDiscoveryTimeout(),
+                          onGlobalLookupSuccess,
+                          nullptr);
+
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    EXPECT_EQ(2, secondCallback->getResults(TIMEOUT).size());
+    EXPECT_EQ(2, thirdCallback->getResults(TIMEOUT).size());
+    EXPECT_EQ(2, localCapabilitiesDirectory->getCachedGlobalDiscoveryEntries().size());
+
+    // the lookup is no longer in flight, the next one is served from the cache
+    auto fourthCallback = std::make_shared<MockLocalCapabilitiesDirectoryCallback>();
+    localCapabilitiesDirectory->lookup(
+            {DOMAIN_1_NAME}, INTERFACE_1_NAME, fourthCallback, discoveryQos);
+    EXPECT_EQ(2, fourthCallback->getResults(TIMEOUT).size());
+    EXPECT_EQ(1, localCapabilitiesDirectory->getNumberOfGlobalLookups());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, failedCoalescedGlobalLookupInformsAllCallers)
+{
+    std::function<void(const exceptions::JoynrRuntimeException&)> onGlobalLookupError;
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(1)
+            .WillOnce(SaveArg<4>(&onGlobalLookupError));
+
+    auto secondCallback = std::make_shared<MockLocalCapabilitiesDirectoryCallback>();
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::GLOBAL_ONLY);
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    localCapabilitiesDirectory->lookup(
+            {DOMAIN_1_NAME}, INTERFACE_1_NAME, secondCallback, discoveryQos);
+
+    ASSERT_TRUE(onGlobalLookupError);
+    onGlobalLookupError(exceptions::DiscoveryException("fakeDiscoveryException"));
+
+    EXPECT_EQ(0, callback->getResults(100).size());
+    EXPECT_EQ(0, secondCallback->getResults(100).size());
+
+    Mock::VerifyAndClearExpectations(capabilitiesClient.get());
+    // a failed lookup is not in flight anymore, the next caller retries
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _)).Times(1);
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, localCapabilitiesDirectory->getNumberOfGlobalLookups());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, globalLookupThrowingSynchronouslyInformsCaller)
+{
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(1)
+            .WillOnce(Throw(exceptions::JoynrRuntimeException("fakeSendFailure")));
+
+    bool errorReported = false;
+    auto failingCallback = std::make_shared<LocalCapabilitiesCallback>(
+            [](const std::vector<types::DiscoveryEntryWithMetaInfo>&) {
+                FAIL() << "lookup must not succeed";
+            },
+            [&errorReported](const exceptions::ProviderRuntimeException&) {
+                errorReported = true;
+            });
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::GLOBAL_ONLY);
+    EXPECT_NO_THROW(localCapabilitiesDirectory->lookup(
+            {DOMAIN_1_NAME}, INTERFACE_1_NAME, failingCallback, discoveryQos));
+    EXPECT_TRUE(errorReported);
+
+    Mock::VerifyAndClearExpectations(capabilitiesClient.get());
+    // the failed lookup is not in flight anymore, the next caller retries
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _)).Times(1);
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, localCapabilitiesDirectory->getNumberOfGlobalLookups());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, staleGlobalEntriesAreServedWhileRefreshing)
+{
+    clusterControllerSettings.setDiscoveryCacheMaxStalenessMs(std::chrono::milliseconds(10000));
+    auto staleCachingDirectory =
+            std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
+                                                         capabilitiesClient,
+                                                         LOCAL_ADDRESS,
+                                                         mockMessageRouter,
+                                                         singleThreadedIOService->getIOService(),
+                                                         clusterControllerId);
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::LOCAL_AND_GLOBAL);
+    discoveryQos.setCacheMaxAge(100);
+
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &LocalCapabilitiesDirectoryTest::fakeLookupWithResults));
+    staleCachingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    // served from the cache although older than cacheMaxAge, refreshed in the background
+    staleCachingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+    EXPECT_EQ(1, staleCachingDirectory->getNumberOfStaleGlobalLookupCacheHits());
+    EXPECT_EQ(1, staleCachingDirectory->getNumberOfGlobalLookupCacheRefreshes());
+
+    // the refreshed entries are fresh again
+    staleCachingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    EXPECT_EQ(1, staleCachingDirectory->getNumberOfStaleGlobalLookupCacheHits());
+    EXPECT_EQ(2, staleCachingDirectory->getNumberOfGlobalLookups());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, staleGlobalEntriesAreNotServedWithoutStalenessBound)
+{
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::LOCAL_AND_GLOBAL);
+    discoveryQos.setCacheMaxAge(100);
+
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &LocalCapabilitiesDirectoryTest::fakeLookupWithResults));
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    EXPECT_EQ(0, localCapabilitiesDirectory->getNumberOfStaleGlobalLookupCacheHits());
+    EXPECT_EQ(0, localCapabilitiesDirectory->getNumberOfGlobalLookupCacheRefreshes());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, popularGlobalEntriesAreRefreshedAhead)
+{
+    clusterControllerSettings.setDiscoveryCacheRefreshAheadPercent(50);
+    auto refreshingDirectory =
+            std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
+                                                         capabilitiesClient,
+                                                         LOCAL_ADDRESS,
+                                                         mockMessageRouter,
+                                                         singleThreadedIOService->getIOService(),
+                                                         clusterControllerId);
+    discoveryQos.setDiscoveryScope(joynr::types::DiscoveryScope::GLOBAL_ONLY);
+    discoveryQos.setCacheMaxAge(1000);
+
+    EXPECT_CALL(*capabilitiesClient, lookup(_, INTERFACE_1_NAME, _, _, _))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &LocalCapabilitiesDirectoryTest::fakeLookupWithResults));
+    refreshingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+
+    // young entries are served without refresh
+    refreshingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+    EXPECT_EQ(0, refreshingDirectory->getNumberOfGlobalLookupCacheRefreshes());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+    refreshingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+    EXPECT_EQ(1, refreshingDirectory->getNumberOfGlobalLookupCacheRefreshes());
+    EXPECT_EQ(0, refreshingDirectory->getNumberOfStaleGlobalLookupCacheHits());
+
+    refreshingDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(2, callback->getResults(TIMEOUT).size());
+    EXPECT_EQ(1, refreshingDirectory->getNumberOfGlobalLookupCacheRefreshes());
+}
+
 TEST_F(LocalCapabilitiesDirectoryTest, lookupForParticipantIdReturnsCachedValues)
 {
 
@@ -1348,6 +1650,54 @@ TEST_F(LocalCapabilitiesDirectoryTest, removeGlobalExpiredEntires_ReturnNonExpir
     EXPECT_EQ(0, callback->getResults(100).size());
 }
 
+TEST_F(LocalCapabilitiesDirectoryTest, expiredEntriesAreRemovedInBatches)
+{
+    const std::size_t batchSize = 2;
+    const std::size_t numberOfEntries = 5;
+    clusterControllerSettings.setPurgeExpiredDiscoveryEntriesBatchSize(batchSize);
+
+    types::ProviderQos providerQos;
+    providerQos.setScope(types::ProviderScope::LOCAL);
+
+    std::mutex removedParticipantIdsMutex;
+    std::vector<std::string> removedParticipantIds;
+    EXPECT_CALL(*mockMessageRouter, removeNextHop(_, _, _)).Times(0);
+    EXPECT_CALL(*mockMessageRouter, removeNextHops(SizeIs(Le(batchSize)), _, _))
+            .Times(AtLeast(numberOfEntries / batchSize + 1))
+            .WillRepeatedly(Invoke([&removedParticipantIdsMutex, &removedParticipantIds](
+                    const std::vector<std::string>& participantIds,
+                    std::function<void()>,
+                    std::function<void(const exceptions::ProviderRuntimeException&)>) {
+                std::lock_guard<std::mutex> lock(removedParticipantIdsMutex);
+                removedParticipantIds.insert(
+                        removedParticipantIds.end(), participantIds.cbegin(), participantIds.cend());
+            }));
+
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        types::DiscoveryEntry entry(defaultProviderVersion,
+                                    DOMAIN_1_NAME,
+                                    INTERFACE_1_NAME,
+                                    util::createUuid(),
+                                    providerQos,
+                                    lastSeenDateMs,
+                                    10,
+                                    PUBLIC_KEY_ID);
+        localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+    }
+
+    // all batches are removed within one purge interval after the first one
+    std::this_thread::sleep_for(
+            std::chrono::milliseconds(purgeExpiredDiscoveryEntriesIntervalMs * 2));
+
+    {
+        std::lock_guard<std::mutex> lock(removedParticipantIdsMutex);
+        EXPECT_EQ(numberOfEntries, removedParticipantIds.size());
+    }
+    discoveryQos.setDiscoveryScope(types::DiscoveryScope::LOCAL_ONLY);
+    localCapabilitiesDirectory->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(0, callback->getResults(TIMEOUT).size());
+}
+
 TEST_F(LocalCapabilitiesDirectoryTest, lookupGlobalOnly_GlobalFailsNoLocalEntries_ReturnsNoEntries)
 {
     joynr::types::DiscoveryQos discoveryQos;
@@ -1762,6 +2112,114 @@ TEST_F(LocalCapabilitiesDirectoryTest, persistencyTest)
     EXPECT_EQ(entry3, globalDiscoveryEntries[1]);
 }
 
+TEST_F(LocalCapabilitiesDirectoryTest, persistedRemovalIsNotRestored)
+{
+    localCapabilitiesDirectory->loadPersistedFile();
+
+    types::ProviderQos localProviderQos;
+    localProviderQos.setScope(types::ProviderScope::LOCAL);
+    for (const std::string& participantId : {dummyParticipantId1, dummyParticipantId2}) {
+        joynr::types::DiscoveryEntry entry(defaultProviderVersion,
+                                           DOMAIN_1_NAME,
+                                           INTERFACE_1_NAME,
+                                           participantId,
+                                           localProviderQos,
+                                           lastSeenDateMs,
+                                           expiryDateMs,
+                                           PUBLIC_KEY_ID);
+        localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+    }
+    localCapabilitiesDirectory->remove(dummyParticipantId1);
+
+    auto localCapabilitiesDirectory2 =
+            std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
+                                                         capabilitiesClient,
+                                                         LOCAL_ADDRESS,
+                                                         mockMessageRouter,
+                                                         singleThreadedIOService->getIOService(),
+                                                         "clusterControllerId");
+    localCapabilitiesDirectory2->init();
+    localCapabilitiesDirectory2->loadPersistedFile();
+
+    localCapabilitiesDirectory2->lookup(dummyParticipantId2, callback);
+    EXPECT_EQ(1, callback->getResults(TIMEOUT).size());
+    callback->clearResults();
+
+    discoveryQos.setDiscoveryScope(types::DiscoveryScope::LOCAL_ONLY);
+    localCapabilitiesDirectory2->lookup({DOMAIN_1_NAME}, INTERFACE_1_NAME, callback, discoveryQos);
+    EXPECT_EQ(1, callback->getResults(TIMEOUT).size());
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, persistedJsonFileIsImported)
+{
+    types::ProviderQos localProviderQos;
+    localProviderQos.setScope(types::ProviderScope::LOCAL);
+    joynr::types::DiscoveryEntry entry(defaultProviderVersion,
+                                       DOMAIN_1_NAME,
+                                       INTERFACE_1_NAME,
+                                       dummyParticipantId1,
+                                       localProviderQos,
+                                       lastSeenDateMs,
+                                       expiryDateMs,
+                                       PUBLIC_KEY_ID);
+    localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+
+    // write the JSON file of earlier versions instead of the snapshot and journal
+    const std::string persistencyFile =
+            clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename();
+    localCapabilitiesDirectory->saveLocalCapabilitiesToFile(persistencyFile);
+    joynr::test::util::removeFileInCurrentDirectory(".*\\.persist\\.(snapshot|journal)");
+
+    auto localCapabilitiesDirectory2 =
+            std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
+                                                         capabilitiesClient,
+                                                         LOCAL_ADDRESS,
+                                                         mockMessageRouter,
+                                                         singleThreadedIOService->getIOService(),
+                                                         "clusterControllerId");
+    localCapabilitiesDirectory2->init();
+    localCapabilitiesDirectory2->loadPersistedFile();
+
+    localCapabilitiesDirectory2->lookup(dummyParticipantId1, callback);
+    EXPECT_EQ(1, callback->getResults(TIMEOUT).size());
+
+    // the import is written as snapshot
+    capabilities::SnapshotStore store(persistencyFile);
+    std::vector<types::DiscoveryEntry> persistedEntries;
+    ASSERT_TRUE(store.load(persistedEntries));
+    EXPECT_EQ(std::vector<types::DiscoveryEntry>{entry}, persistedEntries);
+}
+
+TEST_F(LocalCapabilitiesDirectoryTest, unreadableSnapshotIsNotOverwritten)
+{
+    const std::string persistencyFile =
+            clusterControllerSettings.getLocalCapabilitiesDirectoryPersistenceFilename();
+    const std::string content = "not a snapshot";
+    {
+        std::ofstream snapshot(persistencyFile + ".snapshot", std::ios::binary);
+        snapshot << content;
+    }
+    localCapabilitiesDirectory->loadPersistedFile();
+
+    types::ProviderQos localProviderQos;
+    localProviderQos.setScope(types::ProviderScope::LOCAL);
+    joynr::types::DiscoveryEntry entry(defaultProviderVersion,
+                                       DOMAIN_1_NAME,
+                                       INTERFACE_1_NAME,
+                                       dummyParticipantId1,
+                                       localProviderQos,
+                                       lastSeenDateMs,
+                                       expiryDateMs,
+                                       PUBLIC_KEY_ID);
+    localCapabilitiesDirectory->add(entry, defaultOnSuccess, defaultOnError);
+    localCapabilitiesDirectory->updatePersistedFile();
+
+    std::ifstream snapshot(persistencyFile + ".snapshot", std::ios::binary);
+    const std::string persistedContent((std::istreambuf_iterator<char>(snapshot)),
+                                       std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, persistedContent);
+}
+
 TEST_F(LocalCapabilitiesDirectoryTest, loadCapabilitiesFromFile)
 {
     const std::string fileName = "test-resources/ListOfCapabilitiesToInject.json";
@@ -2074,6 +2532,50 @@ TEST_F(LocalCapabilitiesDirectoryACTest, checkPermissionToAdd)
     CallContextStorage::invalidate();
 }
 
+TEST_F(LocalCapabilitiesDirectoryACTest, addBatchIsRejectedAsAWholeWithoutPermission)
+{
+    const std::vector<types::DiscoveryEntry> entries{
+            types::DiscoveryEntry(defaultProviderVersion,
+                                  "domain-1234",
+                                  "my/favourite/interface/Name",
+                                  dummyParticipantId1,
+                                  types::ProviderQos(),
+                                  lastSeenDateMs,
+                                  expiryDateMs,
+                                  PUBLIC_KEY_ID),
+            types::DiscoveryEntry(defaultProviderVersion,
+                                  "domain-123",
+                                  "my/favourite/interface/Name",
+                                  dummyParticipantId2,
+                                  types::ProviderQos(),
+                                  lastSeenDateMs,
+                                  expiryDateMs,
+                                  PUBLIC_KEY_ID)};
+
+    CallContext callContext;
+    callContext.setPrincipal("testUser");
+    CallContextStorage::set(std::move(callContext));
+
+    EXPECT_CALL(*capabilitiesClient,
+                add(Matcher<const std::vector<types::GlobalDiscoveryEntry>&>(_), _, _))
+            .Times(0);
+    bool onErrorCalled = false;
+    localCapabilitiesDirectory->add(entries,
+                                    false,
+                                    []() { FAIL(); },
+                                    [&onErrorCalled](const exceptions::ProviderRuntimeException&) {
+                                        onErrorCalled = true;
+                                    });
+    EXPECT_TRUE(onErrorCalled);
+
+    CallContextStorage::invalidate();
+
+    EXPECT_CALL(*capabilitiesClient, lookup(dummyParticipantId1, _, _))
+            .WillOnce(InvokeWithoutArgs(this, &LocalCapabilitiesDirectoryTest::simulateTimeout));
+    EXPECT_THROW(localCapabilitiesDirectory->lookup(dummyParticipantId1, callback),
+                 exceptions::JoynrTimeOutException);
+}
+
 class LocalCapabilitiesDirectoryWithProviderScope
         : public LocalCapabilitiesDirectoryTest,
           public ::testing::WithParamInterface<types::ProviderScope::Enum>
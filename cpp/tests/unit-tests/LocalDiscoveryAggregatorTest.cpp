@@ -29,10 +29,12 @@
 
 #include "joynr/Future.h"
 #include "joynr/Semaphore.h"
+#include "joynr/exceptions/MethodInvocationException.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
 #include "joynr/types/DiscoveryQos.h"
 
 #include "tests/mock/MockDiscovery.h"
+#include "tests/mock/MockLocalParticipantLookup.h"
 
 using namespace ::testing;
 using namespace joynr;
@@ -134,6 +136,80 @@ TEST_F(LocalDiscoveryAggregatorTest, removeAsync_callsProxy)
     localDiscoveryAggregator.removeAsync(participantId, nullptr, nullptr);
 }
 
+TEST_F(LocalDiscoveryAggregatorTest, addAsyncEntries_olderProvider_addsEntriesOneByOne)
+{
+    localDiscoveryAggregator.setDiscoveryProxy(discoveryMock);
+
+    std::vector<types::DiscoveryEntry> discoveryEntries(2);
+    discoveryEntries[0].setParticipantId("testParticipantId1");
+    discoveryEntries[1].setParticipantId("testParticipantId2");
+    const bool awaitGlobalRegistration = true;
+    EXPECT_CALL(*discoveryMock,
+                addEntriesAsyncMock(Eq(discoveryEntries), Eq(awaitGlobalRegistration), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<3>(exceptions::MethodInvocationException(
+                                    "unknown method name for interface system/Discovery")),
+                            Return(nullptr)));
+    for (const types::DiscoveryEntry& discoveryEntry : discoveryEntries) {
+        EXPECT_CALL(*discoveryMock,
+                    addAsyncMock(Eq(discoveryEntry), Eq(awaitGlobalRegistration), _, _, _))
+                .WillOnce(DoAll(InvokeArgument<2>(), Return(nullptr)));
+    }
+
+    Semaphore successCallbackCalled;
+    auto future = localDiscoveryAggregator.addAsync(
+            discoveryEntries,
+            awaitGlobalRegistration,
+            [&successCallbackCalled]() { successCallbackCalled.notify(); },
+            [](const exceptions::JoynrRuntimeException&) { FAIL() << "onError called"; });
+    EXPECT_TRUE(successCallbackCalled.waitFor(std::chrono::milliseconds(0)));
+    EXPECT_NO_THROW(future->get(0));
+}
+
+TEST_F(LocalDiscoveryAggregatorTest, addAsyncEntries_otherErrorIsReported)
+{
+    localDiscoveryAggregator.setDiscoveryProxy(discoveryMock);
+
+    std::vector<types::DiscoveryEntry> discoveryEntries(1);
+    discoveryEntries[0].setParticipantId("testParticipantId");
+    EXPECT_CALL(*discoveryMock, addEntriesAsyncMock(Eq(discoveryEntries), _, _, _, _))
+            .WillOnce(DoAll(
+                    InvokeArgument<3>(exceptions::ProviderRuntimeException("not permitted")),
+                    Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, addAsyncMock(_, _, _, _, _)).Times(0);
+
+    Semaphore errorCallbackCalled;
+    localDiscoveryAggregator.addAsync(
+            discoveryEntries,
+            false,
+            []() { FAIL() << "onSuccess called"; },
+            [&errorCallbackCalled](const exceptions::JoynrRuntimeException&) {
+                errorCallbackCalled.notify();
+            });
+    EXPECT_TRUE(errorCallbackCalled.waitFor(std::chrono::milliseconds(0)));
+}
+
+TEST_F(LocalDiscoveryAggregatorTest, removeAsyncEntries_olderProvider_removesEntriesOneByOne)
+{
+    localDiscoveryAggregator.setDiscoveryProxy(discoveryMock);
+
+    const std::vector<std::string> participantIds{"testParticipantId1", "testParticipantId2"};
+    EXPECT_CALL(*discoveryMock, removeEntriesAsyncMock(Eq(participantIds), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(exceptions::MethodInvocationException(
+                                    "unknown method name for interface system/Discovery")),
+                            Return(nullptr)));
+    for (const std::string& participantId : participantIds) {
+        EXPECT_CALL(*discoveryMock, removeAsyncMock(Eq(participantId), _, _, _))
+                .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    }
+
+    Semaphore successCallbackCalled;
+    localDiscoveryAggregator.removeAsync(
+            participantIds,
+            [&successCallbackCalled]() { successCallbackCalled.notify(); },
+            [](const exceptions::JoynrRuntimeException&) { FAIL() << "onError called"; });
+    EXPECT_TRUE(successCallbackCalled.waitFor(std::chrono::milliseconds(0)));
+}
+
 TEST_F(LocalDiscoveryAggregatorTest, lookupAsyncParticipantId_provisionedEntry_doesNotCallProxy)
 {
     Semaphore semaphore(0);
@@ -162,3 +238,47 @@ TEST_F(LocalDiscoveryAggregatorTest, lookupAsyncParticipantId_provisionedEntry_d
 
     EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
 }
+
+TEST_F(LocalDiscoveryAggregatorTest, lookupLocally_provisionedEntry_doesNotCallLocalLookup)
+{
+    const std::string participantId("testProvisionedParticipantId");
+    types::DiscoveryEntryWithMetaInfo provisionedDiscoveryEntry;
+    provisionedDiscoveryEntry.setParticipantId(participantId);
+    provisionedDiscoveryEntries.insert(std::make_pair(participantId, provisionedDiscoveryEntry));
+    LocalDiscoveryAggregator localDiscoveryAggregator(provisionedDiscoveryEntries);
+    auto localParticipantLookupMock = std::make_shared<MockLocalParticipantLookup>();
+    localDiscoveryAggregator.setLocalParticipantLookup(localParticipantLookupMock);
+
+    EXPECT_CALL(*localParticipantLookupMock, lookupLocally(_)).Times(0);
+
+    auto result = localDiscoveryAggregator.lookupLocally(participantId);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(provisionedDiscoveryEntry, *result);
+}
+
+TEST_F(LocalDiscoveryAggregatorTest, lookupLocally_callsLocalParticipantLookup)
+{
+    const std::string participantId("testParticipantId");
+    types::DiscoveryEntryWithMetaInfo localDiscoveryEntry;
+    localDiscoveryEntry.setParticipantId(participantId);
+    auto localParticipantLookupMock = std::make_shared<MockLocalParticipantLookup>();
+    localDiscoveryAggregator.setLocalParticipantLookup(localParticipantLookupMock);
+
+    EXPECT_CALL(*localParticipantLookupMock, lookupLocally(Eq(participantId)))
+            .WillOnce(Return(boost::make_optional(localDiscoveryEntry)));
+
+    auto result = localDiscoveryAggregator.lookupLocally(participantId);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(localDiscoveryEntry, *result);
+}
+
+TEST_F(LocalDiscoveryAggregatorTest, lookupLocally_unknownParticipant_returnsNone)
+{
+    EXPECT_FALSE(localDiscoveryAggregator.lookupLocally("unknownParticipantId"));
+
+    auto localParticipantLookupMock = std::make_shared<MockLocalParticipantLookup>();
+    localDiscoveryAggregator.setLocalParticipantLookup(localParticipantLookupMock);
+    EXPECT_CALL(*localParticipantLookupMock, lookupLocally(_)).WillOnce(Return(boost::none));
+
+    EXPECT_FALSE(localDiscoveryAggregator.lookupLocally("unknownParticipantId"));
+}
@@ -0,0 +1,81 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/MessageBatch.h"
+
+using namespace joynr;
+
+namespace
+{
+
+smrf::ByteVector toByteVector(const std::string& value)
+{
+    return smrf::ByteVector(value.cbegin(), value.cend());
+}
+
+} // namespace
+
+TEST(MessageBatchTest, splitReturnsAppendedMessagesInOrder)
+{
+    const std::vector<smrf::ByteVector> messages = {
+            toByteVector("first"), toByteVector(""), toByteVector(std::string(1000, 'x'))};
+    MessageBatch batch;
+    for (const smrf::ByteVector& message : messages) {
+        batch.append(smrf::ByteArrayView(message));
+    }
+
+    EXPECT_EQ(messages.size(), batch.getNumberOfMessages());
+    EXPECT_EQ(batch.getPayload().size(), batch.getSize());
+    EXPECT_TRUE(MessageBatch::isBatch(batch.getPayload()));
+    EXPECT_EQ(messages, MessageBatch::split(batch.getPayload()));
+}
+
+TEST(MessageBatchTest, emptyBatchContainsNoMessages)
+{
+    MessageBatch batch;
+    EXPECT_EQ(MessageBatch::HEADER_SIZE, batch.getSize());
+    EXPECT_TRUE(MessageBatch::split(batch.getPayload()).empty());
+}
+
+TEST(MessageBatchTest, smrfMessageIsNoBatch)
+{
+    // the first byte of a SMRF message is its version
+    EXPECT_FALSE(MessageBatch::isBatch(smrf::ByteVector{1, 0, 0, 0, 0}));
+    EXPECT_FALSE(MessageBatch::isBatch(smrf::ByteVector{}));
+    EXPECT_THROW(MessageBatch::split(smrf::ByteVector{1, 0, 0, 0, 0}), std::invalid_argument);
+}
+
+TEST(MessageBatchTest, splitThrowsOnTruncatedBatch)
+{
+    MessageBatch batch;
+    batch.append(smrf::ByteArrayView(toByteVector("message")));
+    const smrf::ByteVector& payload = batch.getPayload();
+
+    smrf::ByteVector truncatedMessage(payload.cbegin(), payload.cend() - 1);
+    EXPECT_THROW(MessageBatch::split(truncatedMessage), std::invalid_argument);
+
+    smrf::ByteVector truncatedSize(
+            payload.cbegin(), payload.cbegin() + MessageBatch::HEADER_SIZE + 2);
+    EXPECT_THROW(MessageBatch::split(truncatedSize), std::invalid_argument);
+}
@@ -24,6 +24,7 @@
 #include <gmock/gmock.h>
 
 #include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
 #include "joynr/MessageQueue.h"
 #include "joynr/MutableMessage.h"
 #include "joynr/PrivateCopyAssign.h"
@@ -173,6 +174,38 @@ TEST_F(MessageQueueTest, dequeueInvalidParticipantId)
     EXPECT_EQ(messageQueue.getNextMessageFor("TEST"), nullptr);
 }
 
+TEST_F(MessageQueueTest, dequeueByPriorityThenEarliestExpiry)
+{
+    const std::string participantId("TEST");
+    auto queueMessage = [this, &participantId](const std::string& type, const TimePoint& expiry) {
+        MutableMessage mutableMessage;
+        mutableMessage.setType(type);
+        mutableMessage.setRecipient(participantId);
+        mutableMessage.setExpiryDate(expiry);
+        auto immutableMessage = mutableMessage.getImmutableMessage();
+        const std::string id = immutableMessage->getId();
+        messageQueue.queueMessage(participantId, std::move(immutableMessage));
+        return id;
+    };
+
+    const std::string latePublication =
+            queueMessage(Message::VALUE_MESSAGE_TYPE_PUBLICATION(), expiryDate + 20);
+    const std::string earlyPublication =
+            queueMessage(Message::VALUE_MESSAGE_TYPE_PUBLICATION(), expiryDate + 10);
+    const std::string lateRequest =
+            queueMessage(Message::VALUE_MESSAGE_TYPE_REQUEST(), expiryDate + 20);
+    const std::string earlyRequest =
+            queueMessage(Message::VALUE_MESSAGE_TYPE_REQUEST(), expiryDate + 10);
+    const std::string reply = queueMessage(Message::VALUE_MESSAGE_TYPE_REPLY(), expiryDate + 30);
+
+    EXPECT_EQ(reply, messageQueue.getNextMessageFor(participantId)->getId());
+    EXPECT_EQ(earlyRequest, messageQueue.getNextMessageFor(participantId)->getId());
+    EXPECT_EQ(lateRequest, messageQueue.getNextMessageFor(participantId)->getId());
+    EXPECT_EQ(earlyPublication, messageQueue.getNextMessageFor(participantId)->getId());
+    EXPECT_EQ(latePublication, messageQueue.getNextMessageFor(participantId)->getId());
+    EXPECT_EQ(nullptr, messageQueue.getNextMessageFor(participantId));
+}
+
 class MessageQueueWithLimitTest : public ::testing::Test
 {
 public:
@@ -23,6 +23,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "joynr/BackPressureController.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
 #include "joynr/MessagingQos.h"
@@ -38,6 +39,7 @@
 #include "joynr/MulticastSubscriptionRequest.h"
 #include "joynr/SubscriptionPublication.h"
 #include "joynr/PeriodicSubscriptionQos.h"
+#include "joynr/ReplyCaller.h"
 #include "joynr/OnChangeSubscriptionQos.h"
 #include "joynr/SingleThreadedIOService.h"
 
@@ -133,6 +135,35 @@ TEST_F(MessageSenderTest, sendRequest_normal)
     messageSender.sendRequest(senderID, receiverID, qosSettings, request, callBack, isLocalMessage);
 }
 
+TEST_F(MessageSenderTest, sendRequestNotAdmittedFailsThroughReplyCaller)
+{
+    auto backPressureController =
+            std::make_shared<BackPressureController>(BackPressurePolicy::Enum::FAIL_FAST,
+                                                     100,
+                                                     50,
+                                                     std::chrono::milliseconds(100),
+                                                     singleThreadedIOService->getIOService());
+    auto reservation = backPressureController->reserve("", 100);
+    Request request;
+    request.setMethodName("methodName");
+
+    std::shared_ptr<exceptions::JoynrException> error;
+    auto replyCaller = std::make_shared<ReplyCaller<int>>(
+            [](const int&) { ADD_FAILURE() << "unexpected reply"; },
+            [&error](const std::shared_ptr<exceptions::JoynrException>& exception) {
+                error = exception;
+            });
+    EXPECT_CALL(*mockMessageRouter, route(_, _)).Times(0);
+    EXPECT_CALL(*mockDispatcher, addReplyCaller(_, _, _)).Times(0);
+
+    MessageSender messageSender(mockMessageRouter, nullptr, 0, backPressureController);
+    messageSender.registerDispatcher(mockDispatcher);
+    EXPECT_NO_THROW(messageSender.sendRequest(
+            senderID, receiverID, qosSettings, request, replyCaller, isLocalMessage));
+    ASSERT_NE(nullptr, error);
+    EXPECT_NE(nullptr, std::dynamic_pointer_cast<exceptions::JoynrMessageNotSentException>(error));
+}
+
 TEST_F(MessageSenderTest, sendOneWayRequest_normal)
 {
     OneWayRequest oneWayRequest;
@@ -21,8 +21,10 @@
 
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
+#include "joynr/MessagingQosEffort.h"
 #include "joynr/MutableMessage.h"
 #include "joynr/PrivateCopyAssign.h"
+#include "joynr/SchedulingPriority.h"
 #include "joynr/TimePoint.h"
 
 #include "tests/mock/MockKeychain.h"
@@ -147,3 +149,87 @@ TEST_F(ImmutableMessageTest, isCompressed)
     auto immutableMessage = mutableMessage.getImmutableMessage();
     EXPECT_EQ(immutableMessage->isCompressed(), expectedValue);
 }
+
+TEST_F(ImmutableMessageTest, headerViewsReferToMessageHeaders)
+{
+    auto immutableMessage = mutableMessage.getImmutableMessage();
+
+    boost::optional<const std::string&> replyTo = immutableMessage->getReplyToView();
+    boost::optional<const std::string&> effort = immutableMessage->getEffortView();
+    ASSERT_TRUE(replyTo);
+    ASSERT_TRUE(effort);
+    EXPECT_EQ(mutableMessage.getReplyTo(), *replyTo);
+    EXPECT_EQ(mutableMessage.getEffort(), *effort);
+    EXPECT_EQ(&(*immutableMessage->getHeaderView(Message::HEADER_REPLY_TO())), &(*replyTo));
+    EXPECT_FALSE(immutableMessage->getHeaderView("unknown-header"));
+}
+
+TEST_F(ImmutableMessageTest, headerViewsAreEmptyForMissingOptionalHeaders)
+{
+    MutableMessage message;
+    auto immutableMessage = message.getImmutableMessage();
+
+    EXPECT_FALSE(immutableMessage->getReplyToView());
+    EXPECT_FALSE(immutableMessage->getEffortView());
+    EXPECT_FALSE(immutableMessage->getReplyTo());
+    EXPECT_FALSE(immutableMessage->getEffort());
+}
+
+TEST_F(ImmutableMessageTest, headersRemainValidAfterMove)
+{
+    const std::string prefixedHeaderKey = joynr::Message::CUSTOM_HEADER_PREFIX() + "key";
+    mutableMessage.setPrefixedCustomHeaders({{prefixedHeaderKey, "value"}});
+    auto immutableMessage = mutableMessage.getImmutableMessage();
+
+    ImmutableMessage movedMessage(std::move(*immutableMessage));
+
+    EXPECT_EQ(mutableMessage.getId(), movedMessage.getId());
+    EXPECT_EQ(mutableMessage.getType(), movedMessage.getType());
+    EXPECT_EQ(mutableMessage.getSender(), movedMessage.getSender());
+    EXPECT_EQ(mutableMessage.getRecipient(), movedMessage.getRecipient());
+    EXPECT_EQ(mutableMessage.getReplyTo(), *movedMessage.getReplyToView());
+    auto prefixedCustomHeaders = movedMessage.getPrefixedCustomHeaders();
+    ASSERT_EQ(1, prefixedCustomHeaders.size());
+    EXPECT_EQ("value", prefixedCustomHeaders[prefixedHeaderKey]);
+}
+
+TEST_F(ImmutableMessageTest, schedulingPriorityDependsOnTypeAndEffort)
+{
+    auto priorityOf = [](const std::string& type, const std::string& effort) {
+        MutableMessage message;
+        message.setType(type);
+        message.setEffort(effort);
+        return message.getImmutableMessage()->getSchedulingPriority();
+    };
+    const std::string normal = MessagingQosEffort::getLiteral(MessagingQosEffort::Enum::NORMAL);
+    const std::string bestEffort =
+            MessagingQosEffort::getLiteral(MessagingQosEffort::Enum::BEST_EFFORT);
+
+    EXPECT_EQ(SchedulingPriority::Enum::HIGH,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_REPLY(), normal));
+    EXPECT_EQ(SchedulingPriority::Enum::HIGH,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY(), bestEffort));
+    EXPECT_EQ(SchedulingPriority::Enum::NORMAL,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_REQUEST(), normal));
+    EXPECT_EQ(SchedulingPriority::Enum::LOW,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_REQUEST(), bestEffort));
+    EXPECT_EQ(SchedulingPriority::Enum::LOW,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_PUBLICATION(), normal));
+    EXPECT_EQ(SchedulingPriority::Enum::LOW,
+              priorityOf(Message::VALUE_MESSAGE_TYPE_MULTICAST(), normal));
+}
+
+TEST_F(ImmutableMessageTest, handedOverHeadersEqualDecodedHeaders)
+{
+    mutableMessage.setCustomHeader("key", "value");
+    // a custom header never overrides an explicitly set header
+    mutableMessage.setPrefixedCustomHeaders({{Message::HEADER_EFFORT(), "other"}});
+    std::unique_ptr<ImmutableMessage> message = mutableMessage.getImmutableMessage();
+    ImmutableMessage decodedMessage(message->getSerializedMessage());
+
+    EXPECT_EQ(decodedMessage.getHeaders(), message->getHeaders());
+    EXPECT_EQ(decodedMessage.getSender(), message->getSender());
+    EXPECT_EQ(decodedMessage.getRecipient(), message->getRecipient());
+    EXPECT_EQ("effort", *message->getEffort());
+    EXPECT_EQ(1, message->getCustomHeaders().size());
+}
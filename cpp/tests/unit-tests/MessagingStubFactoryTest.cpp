@@ -122,3 +122,28 @@ TEST_F(MessagingStubFactoryTest, emptyAfterRemove)
     EXPECT_FALSE(messagingStubFactory.contains(address));
     EXPECT_FALSE(messagingStubFactory.contains(addressCopy));
 }
+
+TEST_F(MessagingStubFactoryTest, createCachedResolvesStubOnlyOnce)
+{
+    EXPECT_CALL(*mockMiddlewareMessagingStubFactory, canCreate(_)).Times(1);
+    EXPECT_CALL(*mockMiddlewareMessagingStubFactory, create(_)).Times(1);
+    CachedMessagingStub cachedStub;
+    EXPECT_EQ(expectedStub, messagingStubFactory.createCached(address, cachedStub));
+    // served from cachedStub without a lookup in the factory
+    messagingStubFactory.shutdown();
+    EXPECT_EQ(expectedStub, messagingStubFactory.createCached(address, cachedStub));
+}
+
+TEST_F(MessagingStubFactoryTest, removeInvalidatesCachedStubs)
+{
+    auto newStub = std::make_shared<MockMessagingStub>();
+    EXPECT_CALL(*mockMiddlewareMessagingStubFactory, create(_))
+            .WillOnce(Return(expectedStub))
+            .WillOnce(Return(newStub));
+    CachedMessagingStub cachedStub;
+    EXPECT_EQ(expectedStub, messagingStubFactory.createCached(address, cachedStub));
+
+    messagingStubFactory.remove(addressCopy);
+    EXPECT_EQ(newStub, messagingStubFactory.createCached(address, cachedStub));
+    EXPECT_EQ(newStub, messagingStubFactory.create(addressCopy));
+}
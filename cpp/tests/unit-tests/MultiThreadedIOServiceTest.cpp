@@ -0,0 +1,88 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "joynr/MultiThreadedIOService.h"
+#include "joynr/Semaphore.h"
+
+using namespace joynr;
+
+TEST(MultiThreadedIOServiceTest, handlersRunConcurrentlyOnAllThreads)
+{
+    constexpr std::size_t numberOfThreads = 3;
+    auto ioService = std::make_shared<MultiThreadedIOService>(numberOfThreads);
+    ioService->start();
+
+    // every handler blocks until all threads have entered a handler
+    std::mutex threadIdsMutex;
+    std::set<std::thread::id> threadIds;
+    Semaphore entered(0);
+    Semaphore release(0);
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        ioService->getIOService().post([&]() {
+            {
+                std::lock_guard<std::mutex> lock(threadIdsMutex);
+                threadIds.insert(std::this_thread::get_id());
+            }
+            entered.notify();
+            release.wait();
+        });
+    }
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        EXPECT_TRUE(entered.waitFor(std::chrono::seconds(5)));
+    }
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        release.notify();
+    }
+    ioService->stop();
+    EXPECT_EQ(numberOfThreads, threadIds.size());
+}
+
+TEST(MultiThreadedIOServiceTest, atLeastOneThreadIsStarted)
+{
+    auto ioService = std::make_shared<MultiThreadedIOService>(0);
+    EXPECT_EQ(1, ioService->getNumberOfThreads());
+    ioService->start();
+    Semaphore executed(0);
+    ioService->getIOService().post([&executed]() { executed.notify(); });
+    EXPECT_TRUE(executed.waitFor(std::chrono::seconds(5)));
+    ioService->stop();
+}
+
+TEST(MultiThreadedIOServiceTest, stopFromOwnThreadDoesNotDeadlock)
+{
+    auto destructed = std::make_shared<Semaphore>(0);
+    auto ioService = std::make_shared<MultiThreadedIOService>(2, destructed);
+    ioService->start();
+    ioService->getIOService().post(
+            [ioServiceWeakPtr = std::weak_ptr<MultiThreadedIOService>(ioService)]() {
+                if (auto ioServicePtr = ioServiceWeakPtr.lock()) {
+                    ioServicePtr->stop();
+                }
+            });
+    ioService.reset();
+    EXPECT_TRUE(destructed->waitFor(std::chrono::seconds(5)));
+}
@@ -24,6 +24,7 @@
 #include <string>
 #include <thread>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -150,22 +151,79 @@ INSTANTIATE_TEST_CASE_P(failingStrings,
                         ParticipantIdStorageAssertTest,
                         ::testing::ValuesIn(failingStrings));
 
-TEST(ParticipantIdStorageTest, writeIniFile)
+TEST(ParticipantIdStorageTest, entriesAreRestoredFromFile)
 {
     std::remove(storageFile.c_str());
-    ParticipantIdStorage store(storageFile);
 
     const int entriesToWrite = 100;
+    std::vector<std::string> participantIds;
+    {
+        ParticipantIdStorage store(storageFile);
+        for (int i = 0; i < entriesToWrite; ++i) {
+            participantIds.push_back(joynr::util::createUuid());
+            store.setProviderParticipantId(
+                    "domain" + std::to_string(i), "interface", 1234567890, participantIds.back());
+        }
+    }
+
+    ParticipantIdStorage store(storageFile);
     for (int i = 0; i < entriesToWrite; ++i) {
-        store.setProviderParticipantId(
-                joynr::util::createUuid(), joynr::util::createUuid(), 1234567890, joynr::util::createUuid());
+        EXPECT_EQ(participantIds[i],
+                  store.getProviderParticipantId(
+                          "domain" + std::to_string(i), "interface", 1234567890, "default"));
     }
+}
 
-    std::ifstream fileStream(storageFile.c_str());
-    size_t numberOfEntriesInFile = std::count(
-            std::istreambuf_iterator<char>(fileStream), std::istreambuf_iterator<char>(), '\n');
+TEST(ParticipantIdStorageTest, iniFileIsImported)
+{
+    std::remove(storageFile.c_str());
+    {
+        std::ofstream file(storageFile);
+        file << "joynr.participant.domain.interface.v5=INI_PARTICIPANT_ID" << std::endl;
+        file << "joynr.participant.other.interface.v1=OTHER_PARTICIPANT_ID" << std::endl;
+    }
+
+    {
+        ParticipantIdStorage store(storageFile);
+        EXPECT_EQ("INI_PARTICIPANT_ID", store.getProviderParticipantId("domain", "interface", 5));
+        store.setProviderParticipantId("new", "interface", 2, "NEW_PARTICIPANT_ID");
+    }
 
-    EXPECT_EQ(entriesToWrite, numberOfEntriesInFile);
+    // the file was converted, hence it is no INI file anymore and still contains all entries
+    const std::string content = joynr::util::loadStringFromFile(storageFile);
+    EXPECT_EQ(std::string::npos, content.find("=INI_PARTICIPANT_ID"));
+
+    ParticipantIdStorage store(storageFile);
+    EXPECT_EQ("INI_PARTICIPANT_ID", store.getProviderParticipantId("domain", "interface", 5));
+    EXPECT_EQ("OTHER_PARTICIPANT_ID", store.getProviderParticipantId("other", "interface", 1));
+    EXPECT_EQ("NEW_PARTICIPANT_ID", store.getProviderParticipantId("new", "interface", 2));
+}
+
+TEST(ParticipantIdStorageTest, partiallyWrittenEntryIsDiscarded)
+{
+    std::remove(storageFile.c_str());
+    {
+        ParticipantIdStorage store(storageFile);
+        store.setProviderParticipantId("domain", "interface", 1, "FIRST_PARTICIPANT_ID");
+        store.setProviderParticipantId("domain", "interface", 2, "SECOND_PARTICIPANT_ID");
+    }
+
+    // cut off the last bytes of the second entry
+    std::string content = joynr::util::loadStringFromFile(storageFile);
+    content.resize(content.size() - 3);
+    joynr::util::saveStringToFile(storageFile, content);
+
+    {
+        ParticipantIdStorage store(storageFile);
+        EXPECT_EQ("FIRST_PARTICIPANT_ID", store.getProviderParticipantId("domain", "interface", 1));
+        EXPECT_EQ("DEFAULT", store.getProviderParticipantId("domain", "interface", 2, "DEFAULT"));
+        store.setProviderParticipantId("domain", "interface", 3, "THIRD_PARTICIPANT_ID");
+    }
+
+    // entries appended after the corrupt tail was discarded are readable
+    ParticipantIdStorage store(storageFile);
+    EXPECT_EQ("FIRST_PARTICIPANT_ID", store.getProviderParticipantId("domain", "interface", 1));
+    EXPECT_EQ("THIRD_PARTICIPANT_ID", store.getProviderParticipantId("domain", "interface", 3));
 }
 
 TEST(ParticipantIdStorageTest, deleteCorruptedFile)
@@ -174,6 +232,8 @@ TEST(ParticipantIdStorageTest, deleteCorruptedFile)
     const std::string wrongParticipantID = "WRONG_PARTICIPANT_ID";
     const std::string expectedParticipantId = "EXPECTED_PARTICIPANT_ID";
 
+    // start from an empty file, leftovers of a previous test must not hide the corruption
+    std::remove(storageFile.c_str());
     {
         std::ofstream file(storageFile, std::ios_base::out | std::ios_base::app);
         const std::string header = "joynr.participant";
@@ -0,0 +1,158 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2011 - 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/optional.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/DiscoveryQos.h"
+#include "joynr/Future.h"
+#include "joynr/JoynrMessagingConnectorFactory.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/ProxyBuilder.h"
+#include "joynr/ProxyFactory.h"
+#include "joynr/Semaphore.h"
+#include "joynr/Settings.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+#include "joynr/tests/testProxy.h"
+#include "joynr/types/DiscoveryEntryWithMetaInfo.h"
+#include "joynr/types/Version.h"
+
+#include "tests/mock/MockDiscovery.h"
+#include "tests/mock/MockJoynrRuntime.h"
+#include "tests/mock/MockLocalParticipantLookup.h"
+#include "tests/mock/MockMessageRouter.h"
+#include "tests/mock/MockMessageSender.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+/**
+ * Discovery which also knows participants locally, like the LocalDiscoveryAggregator
+ */
+class MockDiscoveryWithLocalLookup : public MockDiscovery, public MockLocalParticipantLookup
+{
+};
+
+class ProxyBuilderTest : public ::testing::Test
+{
+public:
+    ProxyBuilderTest()
+            : settings(),
+              messagingSettings(settings),
+              ioService(),
+              runtime(std::make_shared<MockJoynrRuntime>(settings)),
+              mockMessageSender(std::make_shared<MockMessageSender>()),
+              proxyFactory(std::make_shared<JoynrMessagingConnectorFactory>(mockMessageSender,
+                                                                            nullptr)),
+              mockDiscovery(std::make_shared<MockDiscoveryWithLocalLookup>()),
+              mockMessageRouter(std::make_shared<MockMessageRouter>(ioService)),
+              proxyBuilder(std::make_shared<ProxyBuilder<tests::testProxy>>(
+                      runtime,
+                      proxyFactory,
+                      nullptr,
+                      mockDiscovery,
+                      domain,
+                      std::make_shared<const system::RoutingTypes::WebSocketClientAddress>(),
+                      mockMessageRouter,
+                      messagingSettings)),
+              discoveryEntry()
+    {
+        DiscoveryQos discoveryQos;
+        discoveryQos.setArbitrationStrategy(DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT);
+        discoveryQos.addCustomParameter("fixedParticipantId", providerParticipantId);
+        proxyBuilder->setDiscoveryQos(discoveryQos);
+
+        discoveryEntry.setParticipantId(providerParticipantId);
+        discoveryEntry.setDomain(domain);
+        discoveryEntry.setInterfaceName(tests::testProxy::INTERFACE_NAME());
+        discoveryEntry.setProviderVersion(types::Version(
+                tests::testProxy::MAJOR_VERSION, tests::testProxy::MINOR_VERSION));
+        discoveryEntry.setIsLocal(true);
+    }
+
+    ~ProxyBuilderTest() override
+    {
+        proxyBuilder->stop();
+    }
+
+protected:
+    const std::string domain = "ProxyBuilderTestDomain";
+    const std::string providerParticipantId = "ProxyBuilderTestProviderParticipantId";
+    Settings settings;
+    MessagingSettings messagingSettings;
+    boost::asio::io_service ioService;
+    std::shared_ptr<MockJoynrRuntime> runtime;
+    std::shared_ptr<MockMessageSender> mockMessageSender;
+    ProxyFactory proxyFactory;
+    std::shared_ptr<MockDiscoveryWithLocalLookup> mockDiscovery;
+    std::shared_ptr<MockMessageRouter> mockMessageRouter;
+    std::shared_ptr<ProxyBuilder<tests::testProxy>> proxyBuilder;
+    types::DiscoveryEntryWithMetaInfo discoveryEntry;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ProxyBuilderTest);
+};
+
+TEST_F(ProxyBuilderTest, fixedParticipantKnownLocallyIsBuiltWithoutArbitration)
+{
+    EXPECT_CALL(*mockDiscovery, lookupLocally(providerParticipantId))
+            .WillOnce(Return(boost::optional<types::DiscoveryEntryWithMetaInfo>(discoveryEntry)));
+    EXPECT_CALL(*mockDiscovery, lookupAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockMessageRouter, setToKnown(providerParticipantId)).Times(1);
+
+    std::shared_ptr<tests::testProxy> builtProxy;
+    auto onSuccess = [&builtProxy](std::shared_ptr<tests::testProxy> proxy) {
+        builtProxy = std::move(proxy);
+    };
+    auto onError = [](const exceptions::DiscoveryException& exception) {
+        ADD_FAILURE() << "unexpected error: " << exception.getMessage();
+    };
+
+    proxyBuilder->buildAsync(onSuccess, onError);
+    // the proxy is created on the calling thread
+    EXPECT_TRUE(builtProxy);
+}
+
+TEST_F(ProxyBuilderTest, fixedParticipantUnknownLocallyFallsBackToArbitration)
+{
+    auto lookupFuture = std::make_shared<Future<types::DiscoveryEntryWithMetaInfo>>();
+    lookupFuture->onSuccess(discoveryEntry);
+    EXPECT_CALL(*mockDiscovery, lookupLocally(providerParticipantId))
+            .WillOnce(Return(boost::none));
+    EXPECT_CALL(*mockDiscovery, lookupAsyncMock(providerParticipantId, _, _, _))
+            .WillOnce(Return(lookupFuture));
+    EXPECT_CALL(*mockMessageRouter, setToKnown(providerParticipantId)).Times(1);
+
+    Semaphore semaphore(0);
+    auto onSuccess = [&semaphore](std::shared_ptr<tests::testProxy> proxy) {
+        EXPECT_TRUE(proxy);
+        semaphore.notify();
+    };
+    auto onError = [](const exceptions::DiscoveryException& exception) {
+        ADD_FAILURE() << "unexpected error: " << exception.getMessage();
+    };
+
+    proxyBuilder->buildAsync(onSuccess, onError);
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::seconds(5)));
+}
@@ -0,0 +1,288 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shm/ShmChannel.h"
+#include "libjoynr/shm/ShmRingBuffer.h"
+#include "libjoynr/shm/ShmSegment.h"
+
+#include "tests/mock/MockWebSocketSendInterface.h"
+
+using namespace joynr;
+using ::testing::_;
+
+namespace
+{
+smrf::ByteVector createMessage(std::size_t size, std::uint8_t seed)
+{
+    smrf::ByteVector message(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        message[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return message;
+}
+
+// the ring may be full while the receiving side is still busy
+void sendWithRetry(ShmChannel& channel, const smrf::ByteVector& message)
+{
+    bool failed;
+    do {
+        failed = false;
+        channel.send(smrf::ByteArrayView(message),
+                     [&failed](const exceptions::JoynrRuntimeException&) { failed = true; });
+    } while (failed);
+}
+} // namespace
+
+class ShmTransportTest : public ::testing::Test
+{
+public:
+    ShmTransportTest()
+            : segmentName(ShmSegment::NAME_PREFIX() + "test-" + std::to_string(::getpid())),
+              receivedMessagesMutex(),
+              receivedMessages(),
+              messageReceived(std::make_shared<Semaphore>(0))
+    {
+    }
+
+protected:
+    std::function<void(smrf::ByteVector&&)> createReceiveCallback()
+    {
+        return [this, messageReceived = messageReceived](smrf::ByteVector&& message) {
+            {
+                std::lock_guard<std::mutex> lock(receivedMessagesMutex);
+                receivedMessages.push_back(std::move(message));
+            }
+            messageReceived->notify();
+        };
+    }
+
+    const std::string segmentName;
+    std::mutex receivedMessagesMutex;
+    std::vector<smrf::ByteVector> receivedMessages;
+    std::shared_ptr<Semaphore> messageReceived;
+};
+
+TEST_F(ShmTransportTest, ringPreservesMessagesAcrossWrapAround)
+{
+    auto segment = ShmSegment::create(segmentName, 4096);
+    ShmRingBuffer& ring = segment->getLibJoynrToClusterControllerRing();
+
+    // sizes are chosen such that records regularly end close to the end of the ring
+    const std::vector<std::size_t> sizes = {0, 1, 7, 300, 1021, 2000, 13, 1500, 1, 2044};
+    smrf::ByteVector received;
+    for (int round = 0; round < 20; ++round) {
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            const smrf::ByteVector message =
+                    createMessage(sizes[i], static_cast<std::uint8_t>(round + i));
+            ASSERT_TRUE(ring.tryWrite(message.data(), message.size()));
+            ASSERT_TRUE(ring.tryRead(received));
+            EXPECT_EQ(message, received);
+        }
+    }
+    EXPECT_TRUE(ring.isEmpty());
+    EXPECT_FALSE(ring.tryRead(received));
+}
+
+TEST_F(ShmTransportTest, ringRejectsMessagesWhichDoNotFit)
+{
+    auto segment = ShmSegment::create(segmentName, 4096);
+    ShmRingBuffer& ring = segment->getLibJoynrToClusterControllerRing();
+
+    const smrf::ByteVector tooLarge = createMessage(ring.getMaxMessageSize() + 1, 0);
+    EXPECT_FALSE(ring.tryWrite(tooLarge.data(), tooLarge.size()));
+
+    const smrf::ByteVector message = createMessage(1000, 1);
+    std::uint64_t numberOfWrittenMessages = 0;
+    while (ring.tryWrite(message.data(), message.size())) {
+        ++numberOfWrittenMessages;
+    }
+    EXPECT_EQ(4096 / ShmRingBuffer::getRecordSize(message.size()), numberOfWrittenMessages);
+
+    // space becomes available again once the consumer has read a message
+    smrf::ByteVector received;
+    ASSERT_TRUE(ring.tryRead(received));
+    EXPECT_TRUE(ring.tryWrite(message.data(), message.size()));
+}
+
+TEST_F(ShmTransportTest, ringClosesOnRecordExceedingRing)
+{
+    ShmRingHeader header;
+    alignas(ShmRingBuffer::RECORD_ALIGNMENT) std::uint8_t data[4096] = {};
+    ShmRingBuffer ring(&header, data, sizeof(data));
+    ring.reset();
+
+    const smrf::ByteVector message = createMessage(100, 0);
+    ASSERT_TRUE(ring.tryWrite(message.data(), message.size()));
+    // a peer announcing a message larger than what it has written
+    const std::uint32_t corruptedSize = 4000;
+    std::memcpy(data, &corruptedSize, sizeof(corruptedSize));
+
+    smrf::ByteVector received;
+    EXPECT_FALSE(ring.tryRead(received));
+    EXPECT_TRUE(ring.isCorrupted());
+    EXPECT_TRUE(ring.isClosed());
+    EXPECT_TRUE(received.empty());
+}
+
+TEST_F(ShmTransportTest, ringClosesOnInconsistentIndices)
+{
+    ShmRingHeader header;
+    alignas(ShmRingBuffer::RECORD_ALIGNMENT) std::uint8_t data[4096] = {};
+    ShmRingBuffer ring(&header, data, sizeof(data));
+    ring.reset();
+
+    header.writeIndex.store(2 * sizeof(data));
+    smrf::ByteVector received;
+    EXPECT_FALSE(ring.tryRead(received));
+    EXPECT_TRUE(ring.isCorrupted());
+
+    // a wrap marker at the end of the ring without a record behind it
+    ShmRingHeader wrappedHeader;
+    ShmRingBuffer wrappedRing(&wrappedHeader, data, sizeof(data));
+    wrappedRing.reset();
+    const std::uint32_t wrapMarker = 0xFFFFFFFF;
+    std::memcpy(data + sizeof(data) - 8, &wrapMarker, sizeof(wrapMarker));
+    wrappedHeader.readIndex.store(sizeof(data) - 8);
+    wrappedHeader.writeIndex.store(sizeof(data));
+    EXPECT_FALSE(wrappedRing.tryRead(received));
+    EXPECT_TRUE(wrappedRing.isCorrupted());
+}
+
+TEST_F(ShmTransportTest, attachIsSignalledToCreator)
+{
+    auto segment = ShmSegment::create(segmentName, 4096);
+    EXPECT_FALSE(segment->waitForAttached(std::chrono::milliseconds(10)));
+
+    auto attachedSegment = ShmSegment::open(segmentName);
+    attachedSegment->unlink();
+    attachedSegment->markAttached();
+    EXPECT_TRUE(segment->waitForAttached(std::chrono::milliseconds(10)));
+
+    // the name has been removed, the segment cannot be opened again
+    EXPECT_THROW(ShmSegment::open(segmentName), exceptions::JoynrRuntimeException);
+}
+
+TEST_F(ShmTransportTest, channelsExchangeMessagesInBothDirections)
+{
+    auto libJoynrChannel = std::make_shared<ShmChannel>(
+            ShmSegment::create(segmentName, 64 * 1024), ShmChannel::Side::LibJoynr, nullptr);
+    auto clusterControllerChannel = std::make_shared<ShmChannel>(
+            ShmSegment::open(segmentName), ShmChannel::Side::ClusterController, nullptr);
+
+    libJoynrChannel->start(createReceiveCallback());
+    clusterControllerChannel->start([clusterControllerChannel =
+                                             std::weak_ptr<ShmChannel>(clusterControllerChannel)](
+            smrf::ByteVector&& message) {
+        if (auto channel = clusterControllerChannel.lock()) {
+            sendWithRetry(*channel, message);
+        }
+    });
+
+    const std::size_t numberOfMessages = 1000;
+    std::vector<smrf::ByteVector> sentMessages;
+    for (std::size_t i = 0; i < numberOfMessages; ++i) {
+        sentMessages.push_back(createMessage(i % 500, static_cast<std::uint8_t>(i)));
+        sendWithRetry(*libJoynrChannel, sentMessages.back());
+    }
+    for (std::size_t i = 0; i < numberOfMessages; ++i) {
+        ASSERT_TRUE(messageReceived->waitFor(std::chrono::seconds(5)));
+    }
+
+    std::lock_guard<std::mutex> lock(receivedMessagesMutex);
+    EXPECT_EQ(sentMessages, receivedMessages);
+
+    clusterControllerChannel->stop();
+    EXPECT_FALSE(libJoynrChannel->isConnected());
+    libJoynrChannel->stop();
+}
+
+TEST_F(ShmTransportTest, oversizedMessagesAndClosedChannelsUseFallback)
+{
+    auto fallbackSender = std::make_shared<MockWebSocketSendInterface>();
+    auto libJoynrChannel = std::make_shared<ShmChannel>(
+            ShmSegment::create(segmentName, 4096), ShmChannel::Side::LibJoynr, fallbackSender);
+    auto clusterControllerChannel = std::make_shared<ShmChannel>(
+            ShmSegment::open(segmentName), ShmChannel::Side::ClusterController, nullptr);
+    clusterControllerChannel->start(createReceiveCallback());
+
+    auto onFailure = [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    const smrf::ByteVector smallMessage = createMessage(100, 0);
+    const smrf::ByteVector largeMessage = createMessage(4096, 0);
+
+    EXPECT_CALL(*fallbackSender, send(_, _)).Times(1);
+    libJoynrChannel->send(smrf::ByteArrayView(largeMessage), onFailure);
+    libJoynrChannel->send(smrf::ByteArrayView(smallMessage), onFailure);
+    ASSERT_TRUE(messageReceived->waitFor(std::chrono::seconds(5)));
+    ::testing::Mock::VerifyAndClearExpectations(fallbackSender.get());
+
+    clusterControllerChannel->stop();
+    EXPECT_CALL(*fallbackSender, send(_, _)).Times(1);
+    libJoynrChannel->send(smrf::ByteArrayView(smallMessage), onFailure);
+    libJoynrChannel->stop();
+}
+
+TEST_F(ShmTransportTest, segmentWritableByOtherUsersIsRejected)
+{
+    auto segment = ShmSegment::create(segmentName, 4096);
+    const int fd = shm_open(segmentName.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, fchmod(fd, S_IRUSR | S_IWUSR | S_IROTH | S_IWOTH));
+    ::close(fd);
+
+    EXPECT_THROW(ShmSegment::open(segmentName), exceptions::JoynrRuntimeException);
+}
+
+TEST_F(ShmTransportTest, segmentShrunkByCreatorClosesChannelOfClusterController)
+{
+    auto segment = ShmSegment::create(segmentName, 4096);
+    auto fallbackSender = std::make_shared<MockWebSocketSendInterface>();
+    auto clusterControllerChannel = std::make_shared<ShmChannel>(
+            ShmSegment::open(segmentName), ShmChannel::Side::ClusterController, fallbackSender);
+    clusterControllerChannel->start(createReceiveCallback());
+
+    // the pages of the mapping disappear, accessing them raises SIGBUS
+    const int fd = shm_open(segmentName.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, ftruncate(fd, 0));
+    ::close(fd);
+
+    auto onFailure = [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    const smrf::ByteVector message = createMessage(100, 0);
+    EXPECT_CALL(*fallbackSender, send(_, _)).Times(1);
+    clusterControllerChannel->send(smrf::ByteArrayView(message), onFailure);
+    EXPECT_FALSE(clusterControllerChannel->isConnected());
+    clusterControllerChannel->stop();
+}
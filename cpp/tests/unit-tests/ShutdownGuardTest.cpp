@@ -0,0 +1,125 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/ShutdownGuard.h"
+
+using joynr::Semaphore;
+using joynr::ShutdownGuard;
+
+TEST(ShutdownGuardTest, enterSucceedsBeforeShutdown)
+{
+    ShutdownGuard guard;
+    ShutdownGuard::Pass pass = guard.enter();
+    EXPECT_TRUE(pass);
+    EXPECT_FALSE(guard.isShutDown());
+}
+
+TEST(ShutdownGuardTest, enterFailsAfterShutdown)
+{
+    ShutdownGuard guard;
+    guard.shutdown();
+    EXPECT_TRUE(guard.isShutDown());
+    EXPECT_FALSE(guard.enter());
+}
+
+TEST(ShutdownGuardTest, releasedAndMovedPassesDoNotBlockShutdown)
+{
+    ShutdownGuard guard;
+    ShutdownGuard::Pass released = guard.enter();
+    released.release();
+    EXPECT_FALSE(released);
+
+    ShutdownGuard::Pass moved = guard.enter();
+    ShutdownGuard::Pass target = std::move(moved);
+    EXPECT_FALSE(moved);
+    EXPECT_TRUE(target);
+    target = guard.enter();
+    EXPECT_TRUE(target);
+    target.release();
+
+    guard.shutdown();
+    EXPECT_TRUE(guard.isShutDown());
+}
+
+TEST(ShutdownGuardTest, shutdownWaitsForPasses)
+{
+    ShutdownGuard guard;
+    Semaphore entered(0);
+    Semaphore leave(0);
+    std::atomic<bool> left(false);
+
+    std::thread user([&]() {
+        ShutdownGuard::Pass pass = guard.enter();
+        EXPECT_TRUE(pass);
+        entered.notify();
+        leave.wait();
+        left = true;
+    });
+    entered.wait();
+
+    std::thread shutdown([&]() {
+        guard.shutdown();
+        EXPECT_TRUE(left);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(guard.isShutDown());
+    leave.notify();
+
+    user.join();
+    shutdown.join();
+    EXPECT_TRUE(guard.isShutDown());
+}
+
+TEST(ShutdownGuardTest, noPassIsGrantedDuringOrAfterConcurrentShutdown)
+{
+    ShutdownGuard guard;
+    std::atomic<bool> isShutDown(false);
+    std::atomic<int> passesAfterShutdown(0);
+
+    std::vector<std::thread> users;
+    for (int i = 0; i < 8; ++i) {
+        users.emplace_back([&]() {
+            while (true) {
+                ShutdownGuard::Pass pass = guard.enter();
+                if (!pass) {
+                    return;
+                }
+                if (isShutDown) {
+                    passesAfterShutdown++;
+                }
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    guard.shutdown();
+    isShutDown = true;
+
+    for (std::thread& user : users) {
+        user.join();
+    }
+    EXPECT_EQ(0, passesAfterShutdown);
+}
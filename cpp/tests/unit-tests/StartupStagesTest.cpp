@@ -0,0 +1,157 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/StartupStages.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using namespace joynr;
+
+class StartupStagesTest : public ::testing::Test
+{
+protected:
+    std::function<void()> recordStage(const std::string& stageName)
+    {
+        return [this, stageName]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            stageOrder.push_back(stageName);
+        };
+    }
+
+    std::size_t positionOf(const std::string& stageName) const
+    {
+        return static_cast<std::size_t>(
+                std::find(stageOrder.cbegin(), stageOrder.cend(), stageName) - stageOrder.cbegin());
+    }
+
+    std::mutex mutex;
+    std::vector<std::string> stageOrder;
+};
+
+TEST_F(StartupStagesTest, runsStagesAfterTheirDependencies)
+{
+    StartupStages stages("test", 4);
+    stages.add("a", {}, recordStage("a"));
+    stages.add("b", {}, recordStage("b"));
+    stages.add("c", {"a"}, recordStage("c"));
+    stages.add("d", {"b", "c"}, recordStage("d"));
+
+    stages.run();
+
+    ASSERT_EQ(4, stageOrder.size());
+    EXPECT_LT(positionOf("a"), positionOf("c"));
+    EXPECT_LT(positionOf("c"), positionOf("d"));
+    EXPECT_LT(positionOf("b"), positionOf("d"));
+    EXPECT_EQ(4, stages.getStageDurations().size());
+}
+
+TEST_F(StartupStagesTest, runsIndependentStagesInParallel)
+{
+    Semaphore firstStarted(0);
+    Semaphore secondStarted(0);
+    StartupStages stages("test", 2);
+    // each stage waits for the other one, which only succeeds if both run at the same time
+    stages.add("first", {}, [&]() {
+        firstStarted.notify();
+        if (!secondStarted.waitFor(std::chrono::seconds(5))) {
+            throw std::runtime_error("second stage did not run in parallel");
+        }
+    });
+    stages.add("second", {}, [&]() {
+        secondStarted.notify();
+        if (!firstStarted.waitFor(std::chrono::seconds(5))) {
+            throw std::runtime_error("first stage did not run in parallel");
+        }
+    });
+
+    EXPECT_NO_THROW(stages.run());
+}
+
+TEST_F(StartupStagesTest, limitsNumberOfParallelStages)
+{
+    std::atomic<int> runningStages(0);
+    std::atomic<int> maxRunningStages(0);
+    auto stage = [&]() {
+        const int running = ++runningStages;
+        int max = maxRunningStages;
+        while (running > max && !maxRunningStages.compare_exchange_weak(max, running)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --runningStages;
+    };
+    StartupStages stages("test", 2);
+    for (int i = 0; i < 6; ++i) {
+        stages.add("stage" + std::to_string(i), {}, stage);
+    }
+
+    stages.run();
+
+    EXPECT_LE(maxRunningStages, 2);
+}
+
+TEST_F(StartupStagesTest, failedStageSkipsDependentsAndIsRethrown)
+{
+    StartupStages stages("test", 4);
+    stages.add("failing", {}, []() { throw exceptions::JoynrRuntimeException("failed"); });
+    stages.add("independent", {}, recordStage("independent"));
+    stages.add("dependent", {"failing"}, recordStage("dependent"));
+    stages.add("transitive", {"dependent", "independent"}, recordStage("transitive"));
+
+    EXPECT_THROW(stages.run(), exceptions::JoynrRuntimeException);
+
+    ASSERT_EQ(1, stageOrder.size());
+    EXPECT_EQ("independent", stageOrder.front());
+}
+
+TEST_F(StartupStagesTest, rejectsUnknownDependenciesAndDuplicates)
+{
+    StartupStages stages("test", 1);
+    stages.add("a", {}, recordStage("a"));
+
+    EXPECT_THROW(stages.add("b", {"unknown"}, recordStage("b")), exceptions::JoynrRuntimeException);
+    EXPECT_THROW(stages.add("a", {}, recordStage("a")), exceptions::JoynrRuntimeException);
+}
+
+TEST_F(StartupStagesTest, canOnlyBeRunOnce)
+{
+    StartupStages stages("test", 1);
+    stages.add("a", {}, recordStage("a"));
+
+    stages.run();
+
+    EXPECT_THROW(stages.run(), exceptions::JoynrRuntimeException);
+    EXPECT_EQ(1, stageOrder.size());
+}
+
+TEST_F(StartupStagesTest, emptyStagesReturnImmediately)
+{
+    StartupStages stages("test", 1);
+    EXPECT_NO_THROW(stages.run());
+}
@@ -0,0 +1,211 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/UdsAddress.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/uds/UdsClient.h"
+#include "libjoynr/uds/UdsConnection.h"
+#include "libjoynr/uds/UdsMessagingStubFactory.h"
+
+using namespace joynr;
+
+namespace
+{
+smrf::ByteVector createMessage(std::size_t size, std::uint8_t seed)
+{
+    smrf::ByteVector message(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        message[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return message;
+}
+} // namespace
+
+class UdsTransportTest : public ::testing::Test
+{
+public:
+    UdsTransportTest()
+            : singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              ioService(singleThreadedIOService->getIOService()),
+              socketPath("UdsTransportTest-" + std::to_string(::getpid()) + ".sock"),
+              receivedMessagesMutex(),
+              receivedMessages(),
+              messageReceived(0)
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~UdsTransportTest() override
+    {
+        singleThreadedIOService->stop();
+        std::remove(socketPath.c_str());
+    }
+
+protected:
+    std::shared_ptr<UdsConnection> createConnection(UdsConnection::Socket&& socket,
+                                                    std::function<void()> onClosed = nullptr)
+    {
+        auto connection = std::make_shared<UdsConnection>(
+                ioService,
+                std::move(socket),
+                [this](smrf::ByteVector&& message) { onMessageReceived(std::move(message)); },
+                std::move(onClosed));
+        connection->start();
+        return connection;
+    }
+
+    void onMessageReceived(smrf::ByteVector&& message)
+    {
+        {
+            std::lock_guard<std::mutex> lock(receivedMessagesMutex);
+            receivedMessages.push_back(std::move(message));
+        }
+        messageReceived.notify();
+    }
+
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    boost::asio::io_service& ioService;
+    const std::string socketPath;
+    std::mutex receivedMessagesMutex;
+    std::vector<smrf::ByteVector> receivedMessages;
+    Semaphore messageReceived;
+    const std::chrono::milliseconds timeout{2000};
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(UdsTransportTest);
+};
+
+TEST_F(UdsTransportTest, messagesAreReceivedCompletelyAndInOrder)
+{
+    UdsConnection::Socket senderSocket(ioService);
+    UdsConnection::Socket receiverSocket(ioService);
+    boost::asio::local::connect_pair(senderSocket, receiverSocket);
+    auto sender = createConnection(std::move(senderSocket));
+    auto receiver = createConnection(std::move(receiverSocket));
+
+    const std::vector<smrf::ByteVector> messages{
+            createMessage(10, 0), createMessage(0, 1), createMessage(1024 * 1024, 2)};
+    auto onFailure = [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    for (const smrf::ByteVector& message : messages) {
+        sender->send(smrf::ByteArrayView(message), onFailure);
+    }
+
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        ASSERT_TRUE(messageReceived.waitFor(timeout));
+    }
+    std::lock_guard<std::mutex> lock(receivedMessagesMutex);
+    EXPECT_EQ(messages, receivedMessages);
+
+    sender->close();
+    receiver->close();
+}
+
+TEST_F(UdsTransportTest, peerCloseInvokesOnClosedAndFailsFurtherSends)
+{
+    UdsConnection::Socket socket1(ioService);
+    UdsConnection::Socket socket2(ioService);
+    boost::asio::local::connect_pair(socket1, socket2);
+    auto closed = std::make_shared<Semaphore>(0);
+    auto connection1 = createConnection(std::move(socket1), [closed]() { closed->notify(); });
+    auto connection2 = createConnection(std::move(socket2));
+
+    connection2->close();
+    ASSERT_TRUE(closed->waitFor(timeout));
+    EXPECT_FALSE(connection1->isConnected());
+
+    bool sendFailed = false;
+    const smrf::ByteVector message = createMessage(10, 0);
+    connection1->send(smrf::ByteArrayView(message),
+                      [&sendFailed](const exceptions::JoynrRuntimeException& e) {
+                          sendFailed = dynamic_cast<const exceptions::JoynrDelayMessageException*>(
+                                               &e) != nullptr;
+                      });
+    EXPECT_TRUE(sendFailed);
+}
+
+TEST_F(UdsTransportTest, clientConnectsAndReconnects)
+{
+    boost::asio::local::stream_protocol::acceptor acceptor(
+            ioService, boost::asio::local::stream_protocol::endpoint(socketPath));
+    std::shared_ptr<UdsConnection> serverConnection;
+    auto accept = [this, &acceptor, &serverConnection]() {
+        UdsConnection::Socket socket(ioService);
+        acceptor.accept(socket);
+        serverConnection = createConnection(std::move(socket));
+    };
+
+    auto client = std::make_shared<UdsClient>(
+            ioService, std::chrono::milliseconds(10), std::chrono::milliseconds(10));
+    auto connected = std::make_shared<Semaphore>(0);
+    auto disconnected = std::make_shared<Semaphore>(0);
+    auto reconnected = std::make_shared<Semaphore>(0);
+    client->registerConnectCallback([connected]() { connected->notify(); });
+    client->registerDisconnectCallback([disconnected]() { disconnected->notify(); });
+    client->registerReconnectCallback([reconnected]() { reconnected->notify(); });
+    client->connect(UdsAddress(socketPath));
+
+    accept();
+    ASSERT_TRUE(connected->waitFor(timeout));
+    EXPECT_TRUE(client->isConnected());
+
+    const smrf::ByteVector message = createMessage(100, 0);
+    client->send(smrf::ByteArrayView(message), [](const exceptions::JoynrRuntimeException& e) {
+        FAIL() << e.getMessage();
+    });
+    ASSERT_TRUE(messageReceived.waitFor(timeout));
+
+    serverConnection->close();
+    ASSERT_TRUE(disconnected->waitFor(timeout));
+    accept();
+    ASSERT_TRUE(reconnected->waitFor(timeout));
+    EXPECT_TRUE(client->isConnected());
+
+    client->stop();
+    serverConnection->close();
+}
+
+TEST_F(UdsTransportTest, messagingStubFactoryCreatesStubForUdsAddressOnly)
+{
+    UdsMessagingStubFactory factory;
+    const UdsAddress address(socketPath);
+    auto client = std::make_shared<UdsClient>(
+            ioService, std::chrono::milliseconds(10), std::chrono::milliseconds(10));
+    factory.addServer(address, client->getSender());
+
+    EXPECT_TRUE(factory.canCreate(address));
+    EXPECT_NE(nullptr, factory.create(address));
+    EXPECT_EQ(nullptr, factory.create(UdsAddress("unknown")));
+    EXPECT_FALSE(factory.canCreate(system::RoutingTypes::Address()));
+
+    client->stop();
+}
@@ -0,0 +1,209 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/MqttIngressQueue.h"
+#include "joynr/Semaphore.h"
+
+using namespace joynr;
+
+namespace
+{
+
+smrf::ByteVector createMessage(std::uint8_t id)
+{
+    return smrf::ByteVector{id};
+}
+
+} // namespace
+
+class MqttIngressQueueTest : public ::testing::Test
+{
+public:
+    MqttIngressQueueTest()
+            : consumedMutex(), consumed(), consumerEntered(0), releaseConsumer(0)
+    {
+    }
+
+protected:
+    std::unique_ptr<MqttIngressQueue> createQueue(std::size_t capacity,
+                                                  std::size_t numberOfWorkers,
+                                                  MqttIngressOverflowPolicy::Enum policy,
+                                                  bool blockConsumer)
+    {
+        return std::make_unique<MqttIngressQueue>(
+                capacity, numberOfWorkers, policy, [this, blockConsumer](smrf::ByteVector&& msg) {
+                    if (blockConsumer) {
+                        consumerEntered.notify();
+                        releaseConsumer.wait();
+                    }
+                    std::lock_guard<std::mutex> lock(consumedMutex);
+                    consumed.push_back(msg.at(0));
+                });
+    }
+
+    void waitForConsumed(std::size_t count)
+    {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::lock_guard<std::mutex> lock(consumedMutex);
+                if (consumed.size() >= count) {
+                    return;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        FAIL() << "messages not consumed";
+    }
+
+    std::mutex consumedMutex;
+    std::vector<std::uint8_t> consumed;
+    Semaphore consumerEntered;
+    Semaphore releaseConsumer;
+};
+
+TEST_F(MqttIngressQueueTest, messagesArePassedToConsumer)
+{
+    auto queue = createQueue(10, 2, MqttIngressOverflowPolicy::Enum::BLOCK, false);
+    queue->start();
+    for (std::uint8_t i = 0; i < 5; ++i) {
+        queue->push(createMessage(i));
+    }
+    waitForConsumed(5);
+    queue->stop();
+
+    const MqttIngressQueueStatistics statistics = queue->getStatistics();
+    EXPECT_EQ(5, statistics.received);
+    EXPECT_EQ(5, statistics.processed);
+    EXPECT_EQ(0, statistics.dropped);
+}
+
+TEST_F(MqttIngressQueueTest, dropNewestDropsReceivedMessageWhenFull)
+{
+    auto queue = createQueue(2, 1, MqttIngressOverflowPolicy::Enum::DROP_NEWEST, true);
+    queue->start();
+    queue->push(createMessage(0));
+    // the worker holds message 0, messages 1 and 2 fill the queue
+    ASSERT_TRUE(consumerEntered.waitFor(std::chrono::seconds(5)));
+    queue->push(createMessage(1));
+    queue->push(createMessage(2));
+    queue->push(createMessage(3));
+
+    for (int i = 0; i < 3; ++i) {
+        releaseConsumer.notify();
+    }
+    waitForConsumed(3);
+    queue->stop();
+
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 1, 2}), consumed);
+    const MqttIngressQueueStatistics statistics = queue->getStatistics();
+    EXPECT_EQ(4, statistics.received);
+    EXPECT_EQ(1, statistics.dropped);
+    EXPECT_EQ(2, statistics.maxQueued);
+}
+
+TEST_F(MqttIngressQueueTest, dropOldestReplacesOldestQueuedMessageWhenFull)
+{
+    auto queue = createQueue(2, 1, MqttIngressOverflowPolicy::Enum::DROP_OLDEST, true);
+    queue->start();
+    queue->push(createMessage(0));
+    ASSERT_TRUE(consumerEntered.waitFor(std::chrono::seconds(5)));
+    queue->push(createMessage(1));
+    queue->push(createMessage(2));
+    queue->push(createMessage(3));
+
+    for (int i = 0; i < 3; ++i) {
+        releaseConsumer.notify();
+    }
+    waitForConsumed(3);
+    queue->stop();
+
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 2, 3}), consumed);
+    EXPECT_EQ(1, queue->getStatistics().dropped);
+}
+
+TEST_F(MqttIngressQueueTest, blockWaitsForFreeSlot)
+{
+    auto queue = createQueue(1, 1, MqttIngressOverflowPolicy::Enum::BLOCK, true);
+    queue->start();
+    queue->push(createMessage(0));
+    ASSERT_TRUE(consumerEntered.waitFor(std::chrono::seconds(5)));
+    queue->push(createMessage(1));
+
+    Semaphore pushed(0);
+    std::thread producer([&queue, &pushed]() {
+        queue->push(createMessage(2));
+        pushed.notify();
+    });
+    EXPECT_FALSE(pushed.waitFor(std::chrono::milliseconds(100)));
+
+    releaseConsumer.notify();
+    EXPECT_TRUE(pushed.waitFor(std::chrono::seconds(5)));
+    producer.join();
+
+    releaseConsumer.notify();
+    releaseConsumer.notify();
+    waitForConsumed(3);
+    queue->stop();
+
+    EXPECT_EQ((std::vector<std::uint8_t>{0, 1, 2}), consumed);
+    const MqttIngressQueueStatistics statistics = queue->getStatistics();
+    EXPECT_EQ(0, statistics.dropped);
+    EXPECT_EQ(1, statistics.blocked);
+}
+
+TEST_F(MqttIngressQueueTest, stopReleasesBlockedProducer)
+{
+    auto queue = createQueue(1, 1, MqttIngressOverflowPolicy::Enum::BLOCK, true);
+    queue->start();
+    queue->push(createMessage(0));
+    ASSERT_TRUE(consumerEntered.waitFor(std::chrono::seconds(5)));
+    queue->push(createMessage(1));
+
+    std::thread producer([&queue]() { queue->push(createMessage(2)); });
+    std::thread stopper([&queue]() { queue->stop(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // the worker is still in the consumer, stop() joins it once it returns
+    releaseConsumer.notify();
+    producer.join();
+    stopper.join();
+
+    // message 1 is discarded on stop, message 2 either dropped or discarded
+    EXPECT_EQ((std::vector<std::uint8_t>{0}), consumed);
+    queue->push(createMessage(3));
+    EXPECT_EQ(1, consumed.size());
+}
+
+TEST(MqttIngressOverflowPolicyTest, literalsRoundTrip)
+{
+    for (auto policy : {MqttIngressOverflowPolicy::Enum::BLOCK,
+                        MqttIngressOverflowPolicy::Enum::DROP_NEWEST,
+                        MqttIngressOverflowPolicy::Enum::DROP_OLDEST}) {
+        EXPECT_EQ(policy,
+                  MqttIngressOverflowPolicy::getEnum(MqttIngressOverflowPolicy::getLiteral(policy)));
+    }
+    EXPECT_THROW(MqttIngressOverflowPolicy::getEnum("UNKNOWN"), std::invalid_argument);
+}
@@ -20,10 +20,12 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "joynr/MessageBatch.h"
 #include "joynr/MqttMessagingSkeleton.h"
 #include "joynr/MqttReceiver.h"
 #include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
@@ -218,6 +220,43 @@ TEST_F(MqttMessagingSkeletonTest, onMessageReceivedTest)
     mqttMessagingSkeleton.onMessageReceived(std::move(serializedMessage));
 }
 
+TEST_F(MqttMessagingSkeletonTest, onMessageReceivedRoutesAllMessagesOfBatch)
+{
+    MqttMessagingSkeleton mqttMessagingSkeleton(
+            mockMessageRouter, nullptr, ccSettings.getMqttMulticastTopicPrefix());
+
+    MessageBatch batch;
+    std::vector<std::string> payloads = {"payload1", "payload2", "payload3"};
+    for (const std::string& payload : payloads) {
+        mutableMessage.setPayload(payload);
+        batch.append(smrf::ByteArrayView(
+                mutableMessage.getImmutableMessage()->getSerializedMessage()));
+    }
+
+    Sequence sequence;
+    for (const std::string& payload : payloads) {
+        EXPECT_CALL(*mockMessageRouter, route(ImmutableMessageHasPayload(payload), _))
+                .InSequence(sequence);
+    }
+
+    smrf::ByteVector serializedBatch = batch.getPayload();
+    mqttMessagingSkeleton.onMessageReceived(std::move(serializedBatch));
+}
+
+TEST_F(MqttMessagingSkeletonTest, onMessageReceivedDropsTruncatedBatch)
+{
+    MqttMessagingSkeleton mqttMessagingSkeleton(
+            mockMessageRouter, nullptr, ccSettings.getMqttMulticastTopicPrefix());
+
+    MessageBatch batch;
+    batch.append(smrf::ByteArrayView(mutableMessage.getImmutableMessage()->getSerializedMessage()));
+    smrf::ByteVector serializedBatch = batch.getPayload();
+    serializedBatch.pop_back();
+
+    EXPECT_CALL(*mockMessageRouter, route(_, _)).Times(0);
+    mqttMessagingSkeleton.onMessageReceived(std::move(serializedBatch));
+}
+
 TEST_F(MqttMessagingSkeletonTest, registerMulticastSubscription_subscribesToMqttTopic)
 {
     std::string multicastId = "multicastId";
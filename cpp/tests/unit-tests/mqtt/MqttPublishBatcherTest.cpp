@@ -0,0 +1,288 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/Settings.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynrclustercontroller/mqtt/MqttPublishBatcher.h"
+#include "tests/mock/MockMosquittoConnection.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+namespace
+{
+
+smrf::ByteVector createMessage(const std::string& content)
+{
+    return smrf::ByteVector(content.cbegin(), content.cend());
+}
+
+struct PublishedPayload
+{
+    std::string topic;
+    int qosLevel;
+    smrf::ByteVector payload;
+};
+
+} // namespace
+
+class MqttPublishBatcherTest : public ::testing::Test
+{
+public:
+    MqttPublishBatcherTest()
+            : settings(),
+              messagingSettings(settings),
+              ccSettings(settings),
+              mockMosquittoConnection(std::make_shared<MockMosquittoConnection>(
+                      messagingSettings, ccSettings, "clientId")),
+              publishedMutex(),
+              published()
+    {
+        ON_CALL(*mockMosquittoConnection, publishMessage(_, _, _, _, _))
+                .WillByDefault(Invoke(this, &MqttPublishBatcherTest::recordPublish));
+        EXPECT_CALL(*mockMosquittoConnection, publishMessage(_, _, _, _, _))
+                .Times(AnyNumber());
+    }
+
+protected:
+    void recordPublish(const std::string& topic,
+                       const int qosLevel,
+                       const std::function<void(const exceptions::JoynrRuntimeException&)>&,
+                       std::uint32_t payloadlen,
+                       const void* payload)
+    {
+        const std::uint8_t* payloadBytes = static_cast<const std::uint8_t*>(payload);
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        published.push_back(PublishedPayload{
+                topic, qosLevel, smrf::ByteVector(payloadBytes, payloadBytes + payloadlen)});
+    }
+
+    void add(MqttPublishBatcher& batcher,
+             const std::string& topic,
+             const smrf::ByteVector& message,
+             int qosLevel = 1)
+    {
+        batcher.add(mockMosquittoConnection,
+                    topic,
+                    qosLevel,
+                    smrf::ByteArrayView(message),
+                    [](const exceptions::JoynrRuntimeException& exception) {
+                        FAIL() << "unexpected failure: " << exception.getMessage();
+                    });
+    }
+
+    std::vector<PublishedPayload> waitForPublished(std::size_t count)
+    {
+        for (int i = 0; i < 500; ++i) {
+            {
+                std::lock_guard<std::mutex> lock(publishedMutex);
+                if (published.size() >= count) {
+                    return published;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        ADD_FAILURE() << "messages not published";
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        return published;
+    }
+
+    std::size_t getNumberOfPublished()
+    {
+        std::lock_guard<std::mutex> lock(publishedMutex);
+        return published.size();
+    }
+
+    Settings settings;
+    MessagingSettings messagingSettings;
+    ClusterControllerSettings ccSettings;
+    std::shared_ptr<MockMosquittoConnection> mockMosquittoConnection;
+    std::mutex publishedMutex;
+    std::vector<PublishedPayload> published;
+};
+
+TEST_F(MqttPublishBatcherTest, publishesBatchWhenMaxMessagesReached)
+{
+    MqttPublishBatcher batcher(3, 65536, std::chrono::seconds(10));
+    batcher.start();
+    const std::vector<smrf::ByteVector> messages = {
+            createMessage("m1"), createMessage("m2"), createMessage("m3")};
+
+    add(batcher, "topic", messages[0]);
+    add(batcher, "topic", messages[1]);
+    EXPECT_EQ(0, getNumberOfPublished());
+    add(batcher, "topic", messages[2]);
+
+    const std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ("topic", result[0].topic);
+    EXPECT_EQ(1, result[0].qosLevel);
+    ASSERT_TRUE(MessageBatch::isBatch(result[0].payload));
+    EXPECT_EQ(messages, MessageBatch::split(result[0].payload));
+    batcher.stop();
+}
+
+TEST_F(MqttPublishBatcherTest, publishesBatchAfterMaxDelay)
+{
+    MqttPublishBatcher batcher(100, 65536, std::chrono::milliseconds(20));
+    batcher.start();
+    const std::vector<smrf::ByteVector> messages = {createMessage("m1"), createMessage("m2")};
+
+    add(batcher, "topic", messages[0]);
+    add(batcher, "topic", messages[1]);
+
+    const std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(messages, MessageBatch::split(result[0].payload));
+    batcher.stop();
+}
+
+TEST_F(MqttPublishBatcherTest, singleMessageIsPublishedWithoutEnvelope)
+{
+    MqttPublishBatcher batcher(100, 65536, std::chrono::milliseconds(1));
+    batcher.start();
+    const smrf::ByteVector message = createMessage("single");
+
+    add(batcher, "topic", message);
+
+    const std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(message, result[0].payload);
+    batcher.stop();
+}
+
+TEST_F(MqttPublishBatcherTest, batchDoesNotExceedMaxBytes)
+{
+    const smrf::ByteVector message = createMessage("0123456789");
+    const std::size_t maxBytes =
+            MessageBatch::HEADER_SIZE + 2 * (MessageBatch::FRAME_OVERHEAD + message.size());
+    MqttPublishBatcher batcher(100, maxBytes + 1, std::chrono::seconds(10));
+    batcher.start();
+
+    add(batcher, "topic", message);
+    add(batcher, "topic", message);
+    EXPECT_EQ(0, getNumberOfPublished());
+    add(batcher, "topic", message);
+
+    std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(2, MessageBatch::split(result[0].payload).size());
+
+    batcher.stop();
+    result = waitForPublished(2);
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(message, result[1].payload);
+}
+
+TEST_F(MqttPublishBatcherTest, topicsAreBatchedSeparately)
+{
+    MqttPublishBatcher batcher(2, 65536, std::chrono::seconds(10));
+    batcher.start();
+
+    add(batcher, "topic1", createMessage("a1"));
+    add(batcher, "topic2", createMessage("b1"));
+    EXPECT_EQ(0, getNumberOfPublished());
+    add(batcher, "topic2", createMessage("b2"));
+
+    const std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ("topic2", result[0].topic);
+    const std::vector<smrf::ByteVector> expected = {createMessage("b1"), createMessage("b2")};
+    EXPECT_EQ(expected, MessageBatch::split(result[0].payload));
+    batcher.stop();
+}
+
+TEST_F(MqttPublishBatcherTest, changedQosPublishesPendingBatchFirst)
+{
+    MqttPublishBatcher batcher(100, 65536, std::chrono::seconds(10));
+    batcher.start();
+
+    add(batcher, "topic", createMessage("m1"), 1);
+    add(batcher, "topic", createMessage("m2"), 1);
+    add(batcher, "topic", createMessage("m3"), 0);
+
+    std::vector<PublishedPayload> result = waitForPublished(1);
+    ASSERT_EQ(1, result.size());
+    EXPECT_EQ(1, result[0].qosLevel);
+    EXPECT_EQ(2, MessageBatch::split(result[0].payload).size());
+
+    batcher.stop();
+    result = waitForPublished(2);
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ(0, result[1].qosLevel);
+    EXPECT_EQ(createMessage("m3"), result[1].payload);
+}
+
+TEST_F(MqttPublishBatcherTest, failureIsReportedForAllMessagesOfBatch)
+{
+    ON_CALL(*mockMosquittoConnection, publishMessage(_, _, _, _, _))
+            .WillByDefault(Invoke([](const std::string&,
+                                     const int,
+                                     const std::function<void(
+                                             const exceptions::JoynrRuntimeException&)>& onFailure,
+                                     std::uint32_t,
+                                     const void*) {
+                onFailure(exceptions::JoynrDelayMessageException("not connected"));
+            }));
+    MqttPublishBatcher batcher(2, 65536, std::chrono::seconds(10));
+    batcher.start();
+
+    int delayedMessages = 0;
+    auto onFailure = [&delayedMessages](const exceptions::JoynrRuntimeException& exception) {
+        if (dynamic_cast<const exceptions::JoynrDelayMessageException*>(&exception)) {
+            delayedMessages++;
+        }
+    };
+    const smrf::ByteVector message = createMessage("message");
+    batcher.add(mockMosquittoConnection, "topic", 1, smrf::ByteArrayView(message), onFailure);
+    batcher.add(mockMosquittoConnection, "topic", 1, smrf::ByteArrayView(message), onFailure);
+
+    EXPECT_EQ(2, delayedMessages);
+    batcher.stop();
+}
+
+TEST_F(MqttPublishBatcherTest, messagesAreNotBatchedWhenStopped)
+{
+    MqttPublishBatcher batcher(100, 65536, std::chrono::seconds(10));
+    const smrf::ByteVector message = createMessage("message");
+
+    add(batcher, "topic", message);
+    EXPECT_EQ(1, getNumberOfPublished());
+
+    batcher.start();
+    add(batcher, "topic", message);
+    EXPECT_EQ(1, getNumberOfPublished());
+    batcher.stop();
+    EXPECT_EQ(2, getNumberOfPublished());
+
+    add(batcher, "topic", message);
+    EXPECT_EQ(3, getNumberOfPublished());
+}
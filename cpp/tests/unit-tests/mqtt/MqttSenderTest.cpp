@@ -16,10 +16,16 @@
  * limitations under the License.
  * #L%
  */
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "joynr/ClusterControllerSettings.h"
 #include "joynr/exceptions/JoynrException.h"
+#include "joynr/MessageBatch.h"
 #include "joynr/MessagingSettings.h"
 #include "joynr/MutableMessage.h"
 #include "joynr/ImmutableMessage.h"
@@ -152,4 +158,159 @@ TEST_F(MqttSenderTest, TestWithDisabledMessageSizeCheck)
     EXPECT_FALSE(gotCalled);
 }
 
+class MqttSenderPublishConnectionsTest : public MqttSenderTest
+{
+protected:
+    void createMqttSenderWithPublishConnections(std::size_t numberOfPublishConnections)
+    {
+        const std::string clientId("testClientId");
+        Settings testSettings("test-resources/MqttSenderTestWithMaxMessageSizeLimits2.settings");
+        MessagingSettings messagingSettings(testSettings);
+        ClusterControllerSettings ccSettings(testSettings);
+        mockMosquittoConnection =
+                std::make_shared<MockMosquittoConnection>(messagingSettings, ccSettings, clientId);
+        ON_CALL(*mockMosquittoConnection, isSubscribedToChannelTopic()).WillByDefault(Return(true));
+        ON_CALL(*mockMosquittoConnection, getMqttQos()).WillByDefault(Return(1));
+        ON_CALL(*mockMosquittoConnection, getMqttPrio()).WillByDefault(Return("low"));
+        EXPECT_CALL(*mockMosquittoConnection, publishMessage(_, _, _, _, _)).Times(0);
+
+        std::vector<std::shared_ptr<MosquittoConnection>> publishConnections;
+        for (std::size_t i = 0; i < numberOfPublishConnections; ++i) {
+            auto publishConnection = std::make_shared<MockMosquittoConnection>(
+                    messagingSettings, ccSettings, clientId + "-pub" + std::to_string(i));
+            ON_CALL(*publishConnection, isReadyToSend()).WillByDefault(Return(true));
+            mockPublishConnections.push_back(publishConnection);
+            publishConnections.push_back(std::move(publishConnection));
+        }
+        mqttSender = std::make_shared<MqttSender>(
+                mockMosquittoConnection, messagingSettings, std::move(publishConnections));
+    }
+
+    std::shared_ptr<ImmutableMessage> createMessage(const std::string& recipient)
+    {
+        MutableMessage mutableMessage;
+        mutableMessage.setType(joynr::Message::VALUE_MESSAGE_TYPE_REQUEST());
+        mutableMessage.setSender("testSender");
+        mutableMessage.setRecipient(recipient);
+        mutableMessage.setPayload("payload");
+        return mutableMessage.getImmutableMessage();
+    }
+
+    std::vector<std::shared_ptr<MockMosquittoConnection>> mockPublishConnections;
+};
+
+TEST_F(MqttSenderPublishConnectionsTest, messagesToSameTopicUseSameConnection)
+{
+    createMqttSenderWithPublishConnections(4);
+
+    std::map<std::string, MockMosquittoConnection*> connectionPerTopic;
+    for (const auto& publishConnection : mockPublishConnections) {
+        MockMosquittoConnection* connection = publishConnection.get();
+        ON_CALL(*publishConnection, publishMessage(_, _, _, _, _))
+                .WillByDefault(Invoke([&connectionPerTopic, connection](
+                        const std::string& topic,
+                        const int,
+                        const std::function<void(const exceptions::JoynrRuntimeException&)>&,
+                        std::uint32_t,
+                        const void*) {
+                    auto it = connectionPerTopic.find(topic);
+                    if (it == connectionPerTopic.cend()) {
+                        connectionPerTopic[topic] = connection;
+                    } else {
+                        EXPECT_EQ(it->second, connection) << "topic " << topic;
+                    }
+                }));
+        EXPECT_CALL(*publishConnection, publishMessage(_, _, _, _, _)).Times(AnyNumber());
+    }
+
+    auto onFailure = [](const exceptions::JoynrRuntimeException& exception) {
+        FAIL() << "unexpected failure: " << exception.getMessage();
+    };
+    for (int round = 0; round < 3; ++round) {
+        for (int recipient = 0; recipient < 32; ++recipient) {
+            mqttSender->sendMessage(mqttAddress,
+                                    createMessage("recipient" + std::to_string(recipient)),
+                                    onFailure);
+        }
+    }
+    EXPECT_EQ(32, connectionPerTopic.size());
+
+    std::set<MockMosquittoConnection*> usedConnections;
+    for (const auto& entry : connectionPerTopic) {
+        usedConnections.insert(entry.second);
+    }
+    EXPECT_LT(1, usedConnections.size());
+}
+
+TEST_F(MqttSenderPublishConnectionsTest, messageIsDelayedIfPublishConnectionIsNotReady)
+{
+    createMqttSenderWithPublishConnections(1);
+    ON_CALL(*mockPublishConnections[0], isReadyToSend()).WillByDefault(Return(false));
+    EXPECT_CALL(*mockPublishConnections[0], publishMessage(_, _, _, _, _)).Times(0);
+
+    bool gotDelayException = false;
+    mqttSender->sendMessage(
+            mqttAddress,
+            createMessage("recipient"),
+            [&gotDelayException](const exceptions::JoynrRuntimeException& exception) {
+                gotDelayException =
+                        dynamic_cast<const exceptions::JoynrDelayMessageException*>(&exception) !=
+                        nullptr;
+            });
+    EXPECT_TRUE(gotDelayException);
+}
+
+TEST_F(MqttSenderTest, unicastMessagesAreBatchedWhenEnabled)
+{
+    Settings testSettings("test-resources/MqttSenderTestWithMaxMessageSizeLimits2.settings");
+    MessagingSettings messagingSettings(testSettings);
+    messagingSettings.setMqttPublishBatchMaxMessages(2);
+    ClusterControllerSettings ccSettings(testSettings);
+    mockMosquittoConnection =
+            std::make_shared<MockMosquittoConnection>(messagingSettings, ccSettings, "clientId");
+    ON_CALL(*mockMosquittoConnection, isSubscribedToChannelTopic()).WillByDefault(Return(true));
+    ON_CALL(*mockMosquittoConnection, getMqttQos()).WillByDefault(Return(1));
+    ON_CALL(*mockMosquittoConnection, getMqttPrio()).WillByDefault(Return("low"));
+    mqttSender = std::make_shared<MqttSender>(mockMosquittoConnection, messagingSettings);
+
+    MutableMessage mutableMessage;
+    mutableMessage.setSender("testSender");
+    mutableMessage.setPayload("payload");
+    auto onFailure = [](const exceptions::JoynrRuntimeException& exception) {
+        FAIL() << "unexpected failure: " << exception.getMessage();
+    };
+
+    // multicasts are published immediately
+    mutableMessage.setType(joynr::Message::VALUE_MESSAGE_TYPE_MULTICAST());
+    mutableMessage.setRecipient("testMulticastId");
+    const smrf::ByteVector multicast =
+            mutableMessage.getImmutableMessage()->getSerializedMessage();
+    EXPECT_CALL(*mockMosquittoConnection,
+                publishMessage(mqttAddress.getTopic(), _, _, multicast.size(), _));
+    mqttSender->sendMessage(mqttAddress, mutableMessage.getImmutableMessage(), onFailure);
+    Mock::VerifyAndClearExpectations(mockMosquittoConnection.get());
+
+    mutableMessage.setType(joynr::Message::VALUE_MESSAGE_TYPE_REQUEST());
+    mutableMessage.setRecipient("testRecipient");
+    const smrf::ByteVector request = mutableMessage.getImmutableMessage()->getSerializedMessage();
+    std::vector<smrf::ByteVector> publishedMessages;
+    EXPECT_CALL(*mockMosquittoConnection, publishMessage(_, 1, _, _, _))
+            .WillOnce(Invoke([&publishedMessages](
+                    const std::string&,
+                    const int,
+                    const std::function<void(const exceptions::JoynrRuntimeException&)>&,
+                    std::uint32_t payloadlen,
+                    const void* payload) {
+                const smrf::Byte* payloadBytes = static_cast<const smrf::Byte*>(payload);
+                publishedMessages = MessageBatch::split(
+                        smrf::ByteVector(payloadBytes, payloadBytes + payloadlen));
+            }));
+    mqttSender->sendMessage(mqttAddress, mutableMessage.getImmutableMessage(), onFailure);
+    mqttSender->sendMessage(mqttAddress, mutableMessage.getImmutableMessage(), onFailure);
+
+    const std::vector<smrf::ByteVector> expectedMessages = {request, request};
+    EXPECT_EQ(expectedMessages, publishedMessages);
+    mqttSender.reset();
+}
+
 } // namespace joynr
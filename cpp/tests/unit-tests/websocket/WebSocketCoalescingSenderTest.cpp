@@ -0,0 +1,226 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/MessageBatch.h"
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/websocket/WebSocketCoalescingSender.h"
+#include "tests/mock/MockWebSocketSendInterface.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class WebSocketCoalescingSenderTest : public ::testing::Test
+{
+public:
+    WebSocketCoalescingSenderTest()
+            : singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              mockSender(std::make_shared<NiceMock<MockWebSocketSendInterface>>()),
+              sentFramesMutex(),
+              sentFrames(),
+              frameSent(0),
+              failOnSend(false)
+    {
+        singleThreadedIOService->start();
+        ON_CALL(*mockSender, send(_, _))
+                .WillByDefault(Invoke(this, &WebSocketCoalescingSenderTest::recordFrame));
+    }
+
+    ~WebSocketCoalescingSenderTest() override
+    {
+        singleThreadedIOService->stop();
+    }
+
+protected:
+    std::shared_ptr<WebSocketCoalescingSender> createSender(
+            std::uint32_t maxBytes,
+            std::chrono::microseconds maxDelay = std::chrono::seconds(10),
+            bool enabled = true)
+    {
+        return std::make_shared<WebSocketCoalescingSender>(singleThreadedIOService->getIOService(),
+                                                           mockSender,
+                                                           maxBytes,
+                                                           maxDelay,
+                                                           enabled);
+    }
+
+    void recordFrame(
+            const smrf::ByteArrayView& frame,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+    {
+        {
+            std::lock_guard<std::mutex> lock(sentFramesMutex);
+            sentFrames.emplace_back(frame.data(), frame.data() + frame.size());
+        }
+        if (failOnSend) {
+            onFailure(exceptions::JoynrDelayMessageException("connection lost"));
+        }
+        frameSent.notify();
+    }
+
+    std::vector<smrf::ByteVector> getSentFrames()
+    {
+        std::lock_guard<std::mutex> lock(sentFramesMutex);
+        return sentFrames;
+    }
+
+    static void send(WebSocketCoalescingSender& sender, const smrf::ByteVector& message)
+    {
+        sender.send(smrf::ByteArrayView(message),
+                    [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); });
+    }
+
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    std::shared_ptr<NiceMock<MockWebSocketSendInterface>> mockSender;
+    std::mutex sentFramesMutex;
+    std::vector<smrf::ByteVector> sentFrames;
+    Semaphore frameSent;
+    bool failOnSend;
+    const std::chrono::milliseconds timeout{2000};
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(WebSocketCoalescingSenderTest);
+};
+
+TEST_F(WebSocketCoalescingSenderTest, disabledSenderPassesMessagesOn)
+{
+    auto sender = createSender(1024, std::chrono::seconds(10), false);
+    const smrf::ByteVector message1{1, 2, 3};
+    const smrf::ByteVector message2{4, 5};
+
+    send(*sender, message1);
+    send(*sender, message2);
+
+    EXPECT_EQ((std::vector<smrf::ByteVector>{message1, message2}), getSentFrames());
+}
+
+TEST_F(WebSocketCoalescingSenderTest, messagesAreSentInOneFrameAfterDelay)
+{
+    auto sender = createSender(1024, std::chrono::microseconds(500));
+    const std::vector<smrf::ByteVector> messages{{1, 2, 3}, {4, 5}, {6}};
+
+    for (const smrf::ByteVector& message : messages) {
+        send(*sender, message);
+    }
+
+    ASSERT_TRUE(frameSent.waitFor(timeout));
+    const std::vector<smrf::ByteVector> frames = getSentFrames();
+    ASSERT_EQ(1, frames.size());
+    EXPECT_EQ(messages, MessageBatch::split(frames[0]));
+}
+
+TEST_F(WebSocketCoalescingSenderTest, singleMessageIsSentWithoutEnvelope)
+{
+    auto sender = createSender(1024, std::chrono::microseconds(500));
+    const smrf::ByteVector message{1, 2, 3};
+
+    send(*sender, message);
+
+    ASSERT_TRUE(frameSent.waitFor(timeout));
+    EXPECT_EQ(std::vector<smrf::ByteVector>{message}, getSentFrames());
+}
+
+TEST_F(WebSocketCoalescingSenderTest, frameIsSentBeforeItWouldExceedMaxBytes)
+{
+    const smrf::ByteVector message(10, 1);
+    const std::size_t sizeOfTwoMessages =
+            MessageBatch::HEADER_SIZE + 2 * (MessageBatch::FRAME_OVERHEAD + message.size());
+    auto sender = createSender(static_cast<std::uint32_t>(sizeOfTwoMessages + 1));
+
+    send(*sender, message);
+    send(*sender, message);
+    EXPECT_TRUE(getSentFrames().empty());
+    send(*sender, message);
+
+    const std::vector<smrf::ByteVector> frames = getSentFrames();
+    ASSERT_EQ(1, frames.size());
+    EXPECT_EQ(2, MessageBatch::split(frames[0]).size());
+}
+
+TEST_F(WebSocketCoalescingSenderTest, disablingSendsPendingMessages)
+{
+    auto sender = createSender(1024);
+    const smrf::ByteVector message1{1, 2, 3};
+    const smrf::ByteVector message2{4, 5};
+
+    send(*sender, message1);
+    send(*sender, message2);
+    sender->setEnabled(false);
+
+    const std::vector<smrf::ByteVector> frames = getSentFrames();
+    ASSERT_EQ(1, frames.size());
+    EXPECT_EQ((std::vector<smrf::ByteVector>{message1, message2}), MessageBatch::split(frames[0]));
+}
+
+TEST_F(WebSocketCoalescingSenderTest, failureIsReportedForAllMessagesOfFrame)
+{
+    failOnSend = true;
+    auto sender = createSender(1024);
+    const smrf::ByteVector message{1, 2, 3};
+    int failures = 0;
+    auto onFailure = [&failures](const exceptions::JoynrRuntimeException&) { failures++; };
+
+    sender->send(smrf::ByteArrayView(message), onFailure);
+    sender->send(smrf::ByteArrayView(message), onFailure);
+    EXPECT_EQ(0, failures);
+    sender->setEnabled(false);
+
+    EXPECT_EQ(2, failures);
+}
+
+TEST_F(WebSocketCoalescingSenderTest, offerMessageContainsParameters)
+{
+    std::uint32_t maxBytes = 0;
+    std::chrono::microseconds maxDelay(0);
+    const std::string offer =
+            WebSocketCoalescingSender::createOfferMessage(4096, std::chrono::microseconds(200));
+
+    ASSERT_TRUE(WebSocketCoalescingSender::parseOfferMessage(offer, maxBytes, maxDelay));
+    EXPECT_EQ(4096, maxBytes);
+    EXPECT_EQ(std::chrono::microseconds(200), maxDelay);
+}
+
+TEST_F(WebSocketCoalescingSenderTest, invalidOfferMessagesAreRejected)
+{
+    std::uint32_t maxBytes = 0;
+    std::chrono::microseconds maxDelay(0);
+    const std::string& prefix = WebSocketCoalescingSender::OFFER_MESSAGE_PREFIX();
+
+    EXPECT_FALSE(WebSocketCoalescingSender::parseOfferMessage("4096:200", maxBytes, maxDelay));
+    EXPECT_FALSE(WebSocketCoalescingSender::parseOfferMessage(prefix, maxBytes, maxDelay));
+    EXPECT_FALSE(
+            WebSocketCoalescingSender::parseOfferMessage(prefix + "4096", maxBytes, maxDelay));
+    EXPECT_FALSE(
+            WebSocketCoalescingSender::parseOfferMessage(prefix + "0:200", maxBytes, maxDelay));
+    EXPECT_FALSE(
+            WebSocketCoalescingSender::parseOfferMessage(prefix + "x:200", maxBytes, maxDelay));
+    EXPECT_FALSE(WebSocketCoalescingSender::parseOfferMessage(
+            prefix + "4096:200x", maxBytes, maxDelay));
+    EXPECT_FALSE(WebSocketCoalescingSender::parseOfferMessage(
+            prefix + "99999999999:200", maxBytes, maxDelay));
+}
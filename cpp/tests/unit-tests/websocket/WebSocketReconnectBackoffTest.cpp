@@ -0,0 +1,64 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+#include "libjoynr/websocket/WebSocketReconnectBackoff.h"
+
+using namespace joynr;
+
+TEST(WebSocketReconnectBackoffTest, sleepTimeGrowsExponentiallyWithJitter)
+{
+    const std::chrono::milliseconds minSleepTime(100);
+    const std::chrono::milliseconds maxSleepTime(1000);
+    WebSocketReconnectBackoff backoff(minSleepTime, maxSleepTime);
+
+    std::chrono::milliseconds upperBound = minSleepTime;
+    for (int attempt = 0; attempt < 10; ++attempt) {
+        const std::chrono::milliseconds sleepTime = backoff.nextSleepTime();
+        EXPECT_GE(sleepTime, upperBound / 2);
+        EXPECT_LE(sleepTime, upperBound);
+        upperBound = std::min(upperBound * 2, maxSleepTime);
+    }
+}
+
+TEST(WebSocketReconnectBackoffTest, resetStartsWithMinSleepTime)
+{
+    const std::chrono::milliseconds minSleepTime(100);
+    WebSocketReconnectBackoff backoff(minSleepTime, std::chrono::milliseconds(10000));
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        backoff.nextSleepTime();
+    }
+
+    backoff.reset();
+
+    EXPECT_LE(backoff.nextSleepTime(), minSleepTime);
+}
+
+TEST(WebSocketReconnectBackoffTest, fixedSleepTimeIfMaxIsNotGreaterThanMin)
+{
+    const std::chrono::milliseconds sleepTime(100);
+    WebSocketReconnectBackoff backoff(sleepTime, sleepTime);
+
+    for (int attempt = 0; attempt < 5; ++attempt) {
+        EXPECT_EQ(sleepTime, backoff.nextSleepTime());
+    }
+}
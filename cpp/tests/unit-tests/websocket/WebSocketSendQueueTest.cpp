@@ -0,0 +1,242 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/TimePoint.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/websocket/WebSocketSendQueue.h"
+#include "tests/mock/MockWebSocketSendInterface.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class WebSocketSendQueueTest : public ::testing::Test
+{
+public:
+    WebSocketSendQueueTest()
+            : mockSender(std::make_shared<NiceMock<MockWebSocketSendInterface>>()),
+              sentMessages(),
+              isSenderInitialized(false),
+              failures(0)
+    {
+        ON_CALL(*mockSender, send(_, _))
+                .WillByDefault(Invoke([this](const smrf::ByteArrayView& message,
+                                             const std::function<void(
+                                                     const exceptions::JoynrRuntimeException&)>&) {
+                    sentMessages.emplace_back(message.data(), message.data() + message.size());
+                }));
+        ON_CALL(*mockSender, isInitialized()).WillByDefault(Invoke([this]() {
+            return isSenderInitialized;
+        }));
+    }
+
+protected:
+    void send(WebSocketSendQueue& queue, const smrf::ByteVector& message)
+    {
+        queue.send(smrf::ByteArrayView(message),
+                   [this](const exceptions::JoynrRuntimeException&) { ++failures; });
+    }
+
+    static smrf::ByteVector createJoynrMessage(const TimePoint& expiryDate)
+    {
+        MutableMessage mutableMessage;
+        mutableMessage.setSender("sender");
+        mutableMessage.setRecipient("recipient");
+        mutableMessage.setExpiryDate(expiryDate);
+        return mutableMessage.getImmutableMessage()->getSerializedMessage();
+    }
+
+    std::shared_ptr<NiceMock<MockWebSocketSendInterface>> mockSender;
+    std::vector<smrf::ByteVector> sentMessages;
+    bool isSenderInitialized;
+    int failures;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(WebSocketSendQueueTest);
+};
+
+TEST_F(WebSocketSendQueueTest, messagesAreQueuedUntilFlush)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    const smrf::ByteVector message1{1, 2, 3};
+    const smrf::ByteVector message2{4, 5};
+
+    EXPECT_TRUE(queue.isInitialized());
+    send(queue, message1);
+    send(queue, message2);
+    EXPECT_TRUE(sentMessages.empty());
+    EXPECT_EQ(2, queue.getNumberOfQueuedMessages());
+
+    isSenderInitialized = true;
+    queue.flush();
+
+    EXPECT_EQ((std::vector<smrf::ByteVector>{message1, message2}), sentMessages);
+    EXPECT_EQ(0, queue.getNumberOfQueuedMessages());
+    EXPECT_EQ(0, failures);
+}
+
+TEST_F(WebSocketSendQueueTest, messagesArePassedOnAfterFlush)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    isSenderInitialized = true;
+    queue.flush();
+    const smrf::ByteVector message{1, 2, 3};
+
+    send(queue, message);
+
+    EXPECT_EQ(std::vector<smrf::ByteVector>{message}, sentMessages);
+    EXPECT_EQ(0, queue.getNumberOfQueuedMessages());
+}
+
+TEST_F(WebSocketSendQueueTest, messagesAreQueuedAgainAfterConnectionLoss)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    isSenderInitialized = true;
+    queue.flush();
+    const smrf::ByteVector message1{1};
+    const smrf::ByteVector message2{2};
+
+    isSenderInitialized = false;
+    send(queue, message1);
+    // the connection is established again, but the queue must not be overtaken before flush
+    isSenderInitialized = true;
+    send(queue, message2);
+    EXPECT_TRUE(sentMessages.empty());
+
+    queue.flush();
+
+    EXPECT_EQ((std::vector<smrf::ByteVector>{message1, message2}), sentMessages);
+}
+
+TEST_F(WebSocketSendQueueTest, messagesFailIfQueueIsFull)
+{
+    WebSocketSendQueue queue(mockSender, 2);
+
+    send(queue, {1});
+    send(queue, {2});
+    EXPECT_FALSE(queue.isInitialized());
+    send(queue, {3});
+
+    EXPECT_EQ(1, failures);
+    EXPECT_EQ(2, queue.getNumberOfQueuedMessages());
+}
+
+TEST_F(WebSocketSendQueueTest, messagesSentDuringFlushAreSentAfterQueuedMessages)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    const smrf::ByteVector message1{1};
+    const smrf::ByteVector message2{2};
+    send(queue, message1);
+    isSenderInitialized = true;
+
+    // e.g. a reply which is sent while the queued request is written
+    EXPECT_CALL(*mockSender, send(_, _))
+            .WillOnce(Invoke([&](const smrf::ByteArrayView& message,
+                                 const std::function<void(
+                                         const exceptions::JoynrRuntimeException&)>&) {
+                sentMessages.emplace_back(message.data(), message.data() + message.size());
+                send(queue, message2);
+            }))
+            .WillRepeatedly(Invoke([this](const smrf::ByteArrayView& sentMessage,
+                                          const std::function<void(
+                                                  const exceptions::JoynrRuntimeException&)>&) {
+                sentMessages.emplace_back(
+                        sentMessage.data(), sentMessage.data() + sentMessage.size());
+            }));
+
+    queue.flush();
+
+    EXPECT_EQ((std::vector<smrf::ByteVector>{message1, message2}), sentMessages);
+    EXPECT_EQ(0, queue.getNumberOfQueuedMessages());
+}
+
+TEST_F(WebSocketSendQueueTest, messagesAreQueuedAgainAfterSuspend)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    isSenderInitialized = true;
+    queue.flush();
+    const smrf::ByteVector message{1};
+
+    // the connection has been closed, the sender does not know yet
+    queue.suspend();
+    send(queue, message);
+    EXPECT_TRUE(sentMessages.empty());
+
+    queue.flush();
+
+    EXPECT_EQ(std::vector<smrf::ByteVector>{message}, sentMessages);
+}
+
+TEST_F(WebSocketSendQueueTest, expiredMessagesAreDroppedOnFlush)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    const smrf::ByteVector expiredMessage =
+            createJoynrMessage(TimePoint::fromRelativeMs(-1000));
+    const smrf::ByteVector validMessage = createJoynrMessage(TimePoint::fromRelativeMs(60000));
+    send(queue, expiredMessage);
+    send(queue, validMessage);
+
+    isSenderInitialized = true;
+    queue.flush();
+
+    EXPECT_EQ(std::vector<smrf::ByteVector>{validMessage}, sentMessages);
+    EXPECT_EQ(0, failures);
+}
+
+TEST_F(WebSocketSendQueueTest, failedMessagesCanBeSentAgainFromOnFailure)
+{
+    WebSocketSendQueue queue(mockSender, 10);
+    isSenderInitialized = true;
+    queue.flush();
+    const smrf::ByteVector message{1};
+
+    // the sender reports failures synchronously, the message router may send again right away
+    EXPECT_CALL(*mockSender, send(_, _))
+            .WillOnce(Invoke([](const smrf::ByteArrayView&,
+                                const std::function<void(
+                                        const exceptions::JoynrRuntimeException&)>& onFailure) {
+                onFailure(exceptions::JoynrDelayMessageException("connection lost"));
+            }))
+            .WillRepeatedly(Invoke([this](const smrf::ByteArrayView& sentMessage,
+                                          const std::function<void(
+                                                  const exceptions::JoynrRuntimeException&)>&) {
+                sentMessages.emplace_back(
+                        sentMessage.data(), sentMessage.data() + sentMessage.size());
+            }));
+
+    bool isResent = false;
+    queue.send(smrf::ByteArrayView(message),
+               [this, &queue, &message, &isResent](const exceptions::JoynrRuntimeException&) {
+                   ++failures;
+                   if (!isResent) {
+                       isResent = true;
+                       send(queue, message);
+                   }
+               });
+
+    EXPECT_EQ(1, failures);
+    EXPECT_EQ(std::vector<smrf::ByteVector>{message}, sentMessages);
+}
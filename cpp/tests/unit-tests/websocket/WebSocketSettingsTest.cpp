@@ -52,6 +52,12 @@ TEST_F(WebSocketSettingsTest, intializedWithDefaultSettings)
 
     EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_CC_MESSAGING_URL()));
     EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_RECONNECT_SLEEP_TIME_MS()));
+    EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_RECONNECT_MAX_SLEEP_TIME_MS()));
+    EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_SEND_QUEUE_SIZE()));
+    EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_COALESCING_MAX_BYTES()));
+    EXPECT_TRUE(wsSettings.contains(WebSocketSettings::SETTING_COALESCING_MAX_DELAY_US()));
+    // coalescing is disabled by default
+    EXPECT_EQ(0, wsSettings.getCoalescingMaxBytes());
 }
 
 TEST_F(WebSocketSettingsTest, overrideDefaultSettings)
@@ -69,6 +69,16 @@ public class DummyCapabilitiesDirectory extends AbstractLocalCapabilitiesDirecto
         return add(discoveryEntry);
     }
 
+    @Override
+    public Promise<DeferredVoid> add(DiscoveryEntry[] discoveryEntries, Boolean awaitGlobalRegistration) {
+        for (DiscoveryEntry discoveryEntry : discoveryEntries) {
+            add(discoveryEntry);
+        }
+        DeferredVoid deferred = new DeferredVoid();
+        deferred.resolve();
+        return new Promise<DeferredVoid>(deferred);
+    }
+
     @Override
     public Promise<Lookup1Deferred> lookup(String[] domains,
                                            String interfaceName,
@@ -114,6 +124,14 @@ public class DummyCapabilitiesDirectory extends AbstractLocalCapabilitiesDirecto
         return new Promise<DeferredVoid>(deferred);
     }
 
+    @Override
+    public Promise<DeferredVoid> remove(String[] participantIds) {
+        DeferredVoid deferred = new DeferredVoid();
+        logger.info("!!!!!!!!!!!!!!!removeCapabilities");
+        deferred.resolve();
+        return new Promise<DeferredVoid>(deferred);
+    }
+
     @Override
     public void remove(DiscoveryEntry interfaces) {
         logger.info("!!!!!!!!!!!!!!!removeCapabilities");
@@ -30,6 +30,8 @@ import java.util.Objects;
 import java.util.Set;
 import java.util.concurrent.ScheduledExecutorService;
 import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicReference;
 import java.util.stream.Collectors;
 
 import javax.annotation.CheckForNull;
@@ -46,12 +48,14 @@ import io.joynr.arbitration.ArbitrationStrategy;
 import io.joynr.arbitration.DiscoveryQos;
 import io.joynr.arbitration.DiscoveryScope;
 import io.joynr.exceptions.DiscoveryException;
+import io.joynr.exceptions.JoynrException;
 import io.joynr.exceptions.JoynrRuntimeException;
 import io.joynr.messaging.ConfigurableMessagingSettings;
 import io.joynr.messaging.routing.MessageRouter;
 import io.joynr.messaging.routing.TransportReadyListener;
 import io.joynr.provider.DeferredVoid;
 import io.joynr.provider.Promise;
+import io.joynr.provider.PromiseListener;
 import io.joynr.proxy.Callback;
 import io.joynr.proxy.Future;
 import io.joynr.runtime.GlobalAddressProvider;
@@ -231,6 +235,58 @@ public class LocalCapabilitiesDirectoryImpl extends AbstractLocalCapabilitiesDir
         return new Promise<>(deferred);
     }
 
+    /**
+     * Adds all entries or none of them: if a single add fails, the entries added by this call are removed again
+     * after all single adds have completed and the returned promise is rejected with the first failure
+     */
+    @Override
+    public Promise<DeferredVoid> add(final DiscoveryEntry[] discoveryEntries, final Boolean awaitGlobalRegistration) {
+        final DeferredVoid deferred = new DeferredVoid();
+        if (discoveryEntries.length == 0) {
+            deferred.resolve();
+            return new Promise<>(deferred);
+        }
+        final List<DiscoveryEntry> addedDiscoveryEntries = new ArrayList<>();
+        for (DiscoveryEntry discoveryEntry : discoveryEntries) {
+            if (!localDiscoveryEntryStore.hasDiscoveryEntry(discoveryEntry)) {
+                addedDiscoveryEntries.add(discoveryEntry);
+            }
+        }
+        final AtomicInteger pendingAdds = new AtomicInteger(discoveryEntries.length);
+        final AtomicReference<JoynrException> firstError = new AtomicReference<>();
+        PromiseListener addListener = new PromiseListener() {
+            @Override
+            public void onFulfillment(Object... values) {
+                addCompleted();
+            }
+
+            @Override
+            public void onRejection(JoynrException error) {
+                firstError.compareAndSet(null, error);
+                addCompleted();
+            }
+
+            private void addCompleted() {
+                if (pendingAdds.decrementAndGet() > 0) {
+                    return;
+                }
+                JoynrException error = firstError.get();
+                if (error == null) {
+                    deferred.resolve();
+                    return;
+                }
+                for (DiscoveryEntry addedDiscoveryEntry : addedDiscoveryEntries) {
+                    remove(addedDiscoveryEntry);
+                }
+                deferred.reject(new ProviderRuntimeException(error.toString()));
+            }
+        };
+        for (DiscoveryEntry discoveryEntry : discoveryEntries) {
+            add(discoveryEntry, awaitGlobalRegistration).then(addListener);
+        }
+        return new Promise<>(deferred);
+    }
+
     private void registerGlobal(final DiscoveryEntry discoveryEntry,
                                 final DeferredVoid deferred,
                                 final boolean awaitGlobalRegistration) {
@@ -734,6 +790,24 @@ public class LocalCapabilitiesDirectoryImpl extends AbstractLocalCapabilitiesDir
         return new Promise<>(deferred);
     }
 
+    /**
+     * Removes all entries, unknown participantIds are ignored
+     */
+    @Override
+    public Promise<DeferredVoid> remove(String[] participantIds) {
+        DeferredVoid deferred = new DeferredVoid();
+        for (String participantId : participantIds) {
+            DiscoveryEntry entryToRemove = localDiscoveryEntryStore.lookup(participantId, Long.MAX_VALUE);
+            if (entryToRemove != null) {
+                remove(entryToRemove);
+            } else {
+                logger.debug("ignoring removal of unknown participantId {}", participantId);
+            }
+        }
+        deferred.resolve();
+        return new Promise<>(deferred);
+    }
+
     @Override
     public Set<DiscoveryEntry> listLocalCapabilities() {
         return localDiscoveryEntryStore.getAllDiscoveryEntries();
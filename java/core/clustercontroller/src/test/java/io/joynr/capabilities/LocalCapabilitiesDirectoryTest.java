@@ -43,6 +43,7 @@ import java.util.Arrays;
 import java.util.Collection;
 import java.util.HashSet;
 import java.util.List;
+import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ScheduledExecutorService;
 import java.util.concurrent.TimeUnit;
 
@@ -400,6 +401,120 @@ public class LocalCapabilitiesDirectoryTest {
 
     }
 
+    @SuppressWarnings("unchecked")
+    @Test(timeout = 1000)
+    public void addEntriesGlobalRegistrationFails_addsNoneOfTheEntries() throws InterruptedException {
+        when(globalAddressProvider.get()).thenReturn(channelAddress);
+
+        ProviderQos providerQos = new ProviderQos();
+        providerQos.setScope(ProviderScope.GLOBAL);
+        final DiscoveryEntry succeedingDiscoveryEntry = new DiscoveryEntry(new Version(47, 11),
+                                                                           "testDomain",
+                                                                           TestInterface.INTERFACE_NAME,
+                                                                           "succeedingParticipantId",
+                                                                           providerQos,
+                                                                           System.currentTimeMillis(),
+                                                                           expiryDateMs,
+                                                                           publicKeyId);
+        final DiscoveryEntry failingDiscoveryEntry = new DiscoveryEntry(new Version(47, 11),
+                                                                        "testDomain",
+                                                                        TestInterface.INTERFACE_NAME,
+                                                                        "failingParticipantId",
+                                                                        providerQos,
+                                                                        System.currentTimeMillis(),
+                                                                        expiryDateMs,
+                                                                        publicKeyId);
+        doAnswer(new Answer<Void>() {
+            @Override
+            public Void answer(InvocationOnMock invocation) throws Throwable {
+                Object[] args = invocation.getArguments();
+                GlobalDiscoveryEntry addedGlobalDiscoveryEntry = (GlobalDiscoveryEntry) args[1];
+                if (failingDiscoveryEntry.getParticipantId().equals(addedGlobalDiscoveryEntry.getParticipantId())) {
+                    ((Callback<Void>) args[0]).onFailure(new JoynrRuntimeException("Simulating a failed registration"));
+                } else {
+                    ((Callback<Void>) args[0]).onSuccess(null);
+                }
+                return null;
+            }
+        }).when(globalCapabilitiesClient).add(any(Callback.class), any(GlobalDiscoveryEntry.class));
+
+        final CountDownLatch rejected = new CountDownLatch(1);
+        final boolean awaitGlobalRegistration = true;
+        DiscoveryEntry[] discoveryEntries = { succeedingDiscoveryEntry, failingDiscoveryEntry };
+        localCapabilitiesDirectory.add(discoveryEntries, awaitGlobalRegistration).then(new PromiseListener() {
+            @Override
+            public void onFulfillment(Object... values) {
+                Assert.fail("adding capabilities succeeded although one registration failed");
+            }
+
+            @Override
+            public void onRejection(JoynrException error) {
+                rejected.countDown();
+            }
+        });
+
+        assertTrue(rejected.await(500, TimeUnit.MILLISECONDS));
+        verify(localDiscoveryEntryStoreMock).remove(eq(succeedingDiscoveryEntry.getParticipantId()));
+        verify(globalCapabilitiesClient).remove(any(Callback.class),
+                                                eq(Arrays.asList(succeedingDiscoveryEntry.getParticipantId())));
+        verify(messageRouter).removeNextHop(eq(succeedingDiscoveryEntry.getParticipantId()));
+        verify(messageRouter).removeNextHop(eq(failingDiscoveryEntry.getParticipantId()));
+    }
+
+    @SuppressWarnings("unchecked")
+    @Test(timeout = 1000)
+    public void addEntriesAlreadyKnown_failedRegistrationKeepsKnownEntries() throws InterruptedException {
+        when(globalAddressProvider.get()).thenReturn(channelAddress);
+        when(localDiscoveryEntryStoreMock.hasDiscoveryEntry(discoveryEntry)).thenReturn(true);
+        doAnswer(createAddAnswerWithError()).when(globalCapabilitiesClient).add(any(Callback.class),
+                                                                                any(GlobalDiscoveryEntry.class));
+
+        final CountDownLatch rejected = new CountDownLatch(1);
+        final boolean awaitGlobalRegistration = true;
+        DiscoveryEntry[] discoveryEntries = { discoveryEntry };
+        localCapabilitiesDirectory.add(discoveryEntries, awaitGlobalRegistration).then(new PromiseListener() {
+            @Override
+            public void onFulfillment(Object... values) {
+                Assert.fail("adding capabilities succeeded although the registration failed");
+            }
+
+            @Override
+            public void onRejection(JoynrException error) {
+                rejected.countDown();
+            }
+        });
+
+        assertTrue(rejected.await(500, TimeUnit.MILLISECONDS));
+        verify(messageRouter, never()).removeNextHop(anyString());
+    }
+
+    @SuppressWarnings("unchecked")
+    @Test(timeout = 1000)
+    public void removeEntries_ignoresUnknownParticipantIds() throws InterruptedException {
+        String unknownParticipantId = "unknownParticipantId";
+        when(localDiscoveryEntryStoreMock.lookup(eq(discoveryEntry.getParticipantId()),
+                                                 anyLong())).thenReturn(discoveryEntry);
+
+        final CountDownLatch fulfilled = new CountDownLatch(1);
+        String[] participantIds = { unknownParticipantId, discoveryEntry.getParticipantId() };
+        localCapabilitiesDirectory.remove(participantIds).then(new PromiseListener() {
+            @Override
+            public void onFulfillment(Object... values) {
+                fulfilled.countDown();
+            }
+
+            @Override
+            public void onRejection(JoynrException error) {
+                Assert.fail("removing capabilities failed: " + error);
+            }
+        });
+
+        assertTrue(fulfilled.await(500, TimeUnit.MILLISECONDS));
+        verify(localDiscoveryEntryStoreMock).remove(eq(discoveryEntry.getParticipantId()));
+        verify(localDiscoveryEntryStoreMock, never()).remove(eq(unknownParticipantId));
+        verify(messageRouter).removeNextHop(eq(discoveryEntry.getParticipantId()));
+    }
+
     private Answer<Future<List<GlobalDiscoveryEntry>>> createAnswer(final List<GlobalDiscoveryEntry> caps) {
         return new Answer<Future<List<GlobalDiscoveryEntry>>>() {
 
@@ -105,6 +105,13 @@ public class LocalDiscoveryAggregator implements DiscoveryAsync {
         return getDefaultDiscoveryProxy().add(callback, discoveryEntry, awaitGlobalRegistration);
     }
 
+    @Override
+    public Future<Void> add(Callback<Void> callback,
+                            DiscoveryEntry[] discoveryEntries,
+                            Boolean awaitGlobalRegistration) {
+        return getDefaultDiscoveryProxy().add(callback, discoveryEntries, awaitGlobalRegistration);
+    }
+
     @Override
     public Future<DiscoveryEntryWithMetaInfo[]> lookup(final Callback<DiscoveryEntryWithMetaInfo[]> callback,
                                                        String[] domains,
@@ -177,6 +184,11 @@ public class LocalDiscoveryAggregator implements DiscoveryAsync {
         return getDefaultDiscoveryProxy().remove(callback, participantId);
     }
 
+    @Override
+    public Future<Void> remove(Callback<Void> callback, String[] participantIds) {
+        return getDefaultDiscoveryProxy().remove(callback, participantIds);
+    }
+
     public void forceQueryOfDiscoveryProxy() {
         getDefaultDiscoveryProxy();
     }
@@ -129,6 +129,64 @@ public class RoutingProviderImpl extends RoutingAbstractProvider {
         return resolvedDeferred();
     }
 
+    @Override
+    public Promise<DeferredVoid> addNextHop(String[] participantIds,
+                                            ChannelAddress address,
+                                            Boolean isGloballyVisible) {
+        for (String participantId : participantIds) {
+            messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        }
+        return resolvedDeferred();
+    }
+
+    @Override
+    public Promise<DeferredVoid> addNextHop(String[] participantIds,
+                                            MqttAddress address,
+                                            Boolean isGloballyVisible) {
+        for (String participantId : participantIds) {
+            messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        }
+        return resolvedDeferred();
+    }
+
+    @Override
+    public Promise<DeferredVoid> addNextHop(String[] participantIds,
+                                            BrowserAddress address,
+                                            Boolean isGloballyVisible) {
+        for (String participantId : participantIds) {
+            messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        }
+        return resolvedDeferred();
+    }
+
+    @Override
+    public Promise<DeferredVoid> addNextHop(String[] participantIds,
+                                            WebSocketAddress address,
+                                            Boolean isGloballyVisible) {
+        for (String participantId : participantIds) {
+            messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        }
+        return resolvedDeferred();
+    }
+
+    @Override
+    public Promise<DeferredVoid> addNextHop(String[] participantIds,
+                                            WebSocketClientAddress address,
+                                            Boolean isGloballyVisible) {
+        for (String participantId : participantIds) {
+            messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        }
+        return resolvedDeferred();
+    }
+
+    @Override
+    public Promise<DeferredVoid> removeNextHop(String[] participantIds) {
+        for (String participantId : participantIds) {
+            messageRouter.removeNextHop(participantId);
+        }
+        return resolvedDeferred();
+    }
+
     @Override
     public Promise<ResolveNextHopDeferred> resolveNextHop(String participantId) {
         boolean resolved = messageRouter.resolveNextHop(participantId);
@@ -85,6 +85,16 @@ PENDING_REQUESTS=500 # Used only with CONSTANT_NUMBER_OF_PENDING_REQUESTS
 
 NUM_THREADS=1 # Used only with CONSTANT_NUMBER_OF_PENDING_REQUESTS
 
+OPEN_LOOP_RATE=1000 # Used only with CPP_OPEN_LOOP, total requests per second
+
+OPEN_LOOP_CONCURRENCY=4 # Used only with CPP_OPEN_LOOP, number of sender threads
+
+OPEN_LOOP_PAYLOAD_MIX="STRING:50,BYTEARRAY:30,STRUCT:20" # Used only with CPP_OPEN_LOOP
+
+OPEN_LOOP_BASELINE="" # Used only with CPP_OPEN_LOOP, JSON result of a previous run
+
+TEST_EXITCODE=0 # Exit code of the script, set if a test reports a failure
+
 
 ### Constants ###
 
@@ -437,6 +447,45 @@ function performCppConsumerTest {
     wait $TEST_PIDS
 }
 
+function performCppOpenLoopTest {
+    STDOUT_PARAM=$1
+    REPORTFILE_PARAM=$2
+    NUM_RUNS=$3
+
+    cd $PERFORMANCETESTS_BIN_DIR
+    if [ "$USE_EMBEDDED_CC" != "ON" ]
+    then
+        PERFORMCPPBINARY="performance-consumer-app-ws"
+        TRANSPORT="WEBSOCKET"
+    else
+        # the embedded cluster controller reaches the provider's cluster controller via MQTT
+        PERFORMCPPBINARY="performance-consumer-app-cc"
+        TRANSPORT="MQTT"
+    fi
+
+    # a timestamped name keeps earlier results, which may serve as baseline of this run
+    RESULTFILE=$PERFORMANCETESTS_RESULTS_DIR/open-loop-$TRANSPORT-$(date "+%Y-%m-%d_%H-%M-%S").json
+    if [ -n "$OPEN_LOOP_BASELINE" ] && [ "$OPEN_LOOP_BASELINE" == "$(realpath -m $RESULTFILE)" ]
+    then
+        echo "Baseline $OPEN_LOOP_BASELINE must not be the result file" | tee -a $REPORTFILE_PARAM
+        return 1
+    fi
+    CONSUMERARGS="-r $NUM_RUNS -t SEND_PAYLOAD_MIX -d $DOMAINNAME -s OPEN_LOOP \
+                  -l $INPUTDATA_STRINGLENGTH -b $INPUTDATA_BYTEARRAYSIZE \
+                  --rate $OPEN_LOOP_RATE --concurrency $OPEN_LOOP_CONCURRENCY \
+                  --payloadMix $OPEN_LOOP_PAYLOAD_MIX --transport $TRANSPORT \
+                  --outputFormat JSON --outputFile $RESULTFILE"
+    if [ -n "$OPEN_LOOP_BASELINE" ]
+    then
+        CONSUMERARGS+=" --baseline $OPEN_LOOP_BASELINE"
+    fi
+
+    ./$PERFORMCPPBINARY $CONSUMERARGS 1>>$STDOUT_PARAM 2>>$REPORTFILE_PARAM
+    CONSUMER_EXITCODE=$?
+    echo "Open loop results written to $RESULTFILE" | tee -a $REPORTFILE_PARAM
+    return $CONSUMER_EXITCODE
+}
+
 function performJsPerformanceTest {
     STDOUT_PARAM=$1
     REPORTFILE_PARAM=$2
@@ -611,6 +660,7 @@ function echoUsage {
     echo "       JAVA_MULTICONSUMER_CPP_PROVIDER|"
     echo "       JS_CONSUMER|OAP_TO_BACKEND_MOSQ|JS_CONSUMER_CPP_PROVIDER|"
     echo "       CPP_SYNC|CPP_ASYNC|CPP_MULTICONSUMER|CPP_SERIALIZER|CPP_SHORTCIRCUIT|CPP_PROVIDER|CPP_CONSUMER_JS_PROVIDER|"
+    echo "       CPP_OPEN_LOOP|"
     echo "       JEE_PROVIDER|ALL> (type of tests)"
     echo "   -c <number-of-consumers> (optional, used for MULTICONSUMER tests, default $MULTICONSUMER_NUMINSTANCES)"
     echo "   -x <number-of-runs> (optional, defaults to $SINGLECONSUMER_RUNS single- / $MULTICONSUMER_RUNS multi-consumer runs)"
@@ -622,6 +672,12 @@ function echoUsage {
     echo "      Only implemented for test case JAVA_ASYNC SEND_STRING."
     echo "   -P <number-of-pending-requests-if-cnr-is-enabled> (optional, defaults to $PENDING_REQUESTS)"
     echo "   -T <number-of-threads-if-cnr-is-enabled> (optional, defaults to $NUM_THREADS)"
+    echo "   -R <requests-per-second> (optional, CPP_OPEN_LOOP only, defaults to $OPEN_LOOP_RATE)"
+    echo "   -N <number-of-sender-threads> (optional, CPP_OPEN_LOOP only, defaults to $OPEN_LOOP_CONCURRENCY)"
+    echo "   -M <payload-mix> (optional, CPP_OPEN_LOOP only, defaults to $OPEN_LOOP_PAYLOAD_MIX)"
+    echo "   -b <baseline-json> (optional, CPP_OPEN_LOOP only)"
+    echo "      Result of a previous CPP_OPEN_LOOP run; the test fails if the latency regressed."
+    echo "      Use -e ON to measure the path via MQTT instead of WebSocket."
 }
 
 function checkDirExists {
@@ -637,11 +693,16 @@ function checkIfBackendServicesAreNeeded {
     case "$1" in
         JAVA_*)
             return 1;;
+        CPP_OPEN_LOOP)
+            if [ "$USE_EMBEDDED_CC" == "ON" ]
+            then
+                return 1
+            fi;;
     esac
     return 0
 }
 
-while getopts "p:s:r:y:j:S:B:m:n:z:e:d:a:t:c:x:k:I:CP:T:h" OPTIONS;
+while getopts "p:s:r:y:j:S:B:m:n:z:e:d:a:t:c:x:k:I:CP:T:R:N:M:b:h" OPTIONS;
 do
     case $OPTIONS in
 # paths
@@ -711,6 +772,18 @@ do
         T)
             NUM_THREADS=$OPTARG
             ;;
+        R)
+            OPEN_LOOP_RATE=$OPTARG
+            ;;
+        N)
+            OPEN_LOOP_CONCURRENCY=$OPTARG
+            ;;
+        M)
+            OPEN_LOOP_PAYLOAD_MIX=$OPTARG
+            ;;
+        b)
+            OPEN_LOOP_BASELINE=$(realpath $OPTARG)
+            ;;
 # usage
         h)
             echoUsage
@@ -730,7 +803,7 @@ if [ "$TESTTYPE" != "JAVA_SYNC" ] && [ "$TESTTYPE" != "JAVA_ASYNC" ] && \
    [ "$TESTTYPE" != "CPP_SYNC" ] && [ "$TESTTYPE" != "CPP_ASYNC" ] && \
    [ "$TESTTYPE" != "CPP_MULTICONSUMER" ] && [ "$TESTTYPE" != "CPP_SERIALIZER" ] && \
    [ "$TESTTYPE" != "CPP_SHORTCIRCUIT" ] && [ "$TESTTYPE" != "CPP_PROVIDER" ] && \
-   [ "$TESTTYPE" != "CPP_CONSUMER_JS_PROVIDER" ] && \
+   [ "$TESTTYPE" != "CPP_CONSUMER_JS_PROVIDER" ] && [ "$TESTTYPE" != "CPP_OPEN_LOOP" ] && \
    [ "$TESTTYPE" != "JEE_PROVIDER" ]
 then
     echo "\"$TESTTYPE\" is not a valid test type"
@@ -738,7 +811,7 @@ then
 JAVA_CONSUMER_CPP_PROVIDER_ASYNC, JAVA_MULTICONSUMER_CPP_PROVIDER, \
 JS_CONSUMER, OAP_TO_BACKEND_MOSQ, JS_CONSUMER_CPP_PROVIDER, \
 CPP_SYNC, CPP_ASYNC, CPP_MULTICONSUMER, CPP_SERIALIZER, CPP_SHORTCIRCUIT, CPP_PROVIDER, CPP_CONSUMER_JS_PROVIDER, \
-JEE_PROVIDER"
+CPP_OPEN_LOOP, JEE_PROVIDER"
     echoUsage
     exit 1
 fi
@@ -852,6 +925,18 @@ then
         performCppSerializerTest $STDOUT $REPORTFILE
     fi
 
+    if [ "$TESTTYPE" == "CPP_OPEN_LOOP" ]
+    then
+        startCppPerformanceTestProvider
+        echo "Testcase: CPP_OPEN_LOOP" | tee -a $REPORTFILE
+        performCppOpenLoopTest $STDOUT $REPORTFILE $SINGLECONSUMER_RUNS
+        if [ "$?" -ne 0 ]
+        then
+            echo "Testcase CPP_OPEN_LOOP failed" | tee -a $REPORTFILE
+            TEST_EXITCODE=1
+        fi
+    fi
+
     if [ "$TESTTYPE" == "CPP_MULTICONSUMER" ]
     then
         startCppPerformanceTestProvider
@@ -937,3 +1022,5 @@ then
     stopCppClusterController
     stopServices
 fi
+
+exit $TEST_EXITCODE
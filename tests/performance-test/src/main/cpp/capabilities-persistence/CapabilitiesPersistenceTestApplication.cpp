@@ -0,0 +1,140 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "joynr/CapabilitiesSnapshotStore.h"
+#include "joynr/CapabilitiesStorage.h"
+#include "joynr/Util.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/types/DiscoveryEntry.h"
+#include "joynr/types/ProviderQos.h"
+#include "joynr/types/Version.h"
+
+#include "../common/PerformanceTest.h"
+
+using namespace joynr;
+
+types::DiscoveryEntry createEntry(std::size_t index)
+{
+    return types::DiscoveryEntry(types::Version(1, 0),
+                                 "domain" + std::to_string(index % 1000),
+                                 "interface",
+                                 "participantId" + std::to_string(index),
+                                 types::ProviderQos(),
+                                 0,
+                                 std::numeric_limits<std::int64_t>::max(),
+                                 "publicKeyId");
+}
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void removeFiles(const std::string& fileName)
+{
+    std::remove(fileName.c_str());
+    std::remove((fileName + ".snapshot").c_str());
+    std::remove((fileName + ".journal").c_str());
+}
+
+/**
+ * Compares the JSON file, which was rewritten on every change, with the binary snapshot and
+ * journal of capabilities::SnapshotStore: startup (load numberOfEntries entries of which
+ * journalRecords were changed after the last snapshot and insert them into the capabilities
+ * storage) and the cost of persisting one change.
+ */
+void run(std::size_t numberOfEntries, std::size_t journalRecords, std::size_t changes)
+{
+    const std::string fileName = "performance-capabilities-persistence.persist";
+    removeFiles(fileName);
+
+    capabilities::Storage storage;
+    std::vector<types::DiscoveryEntry> entries;
+    entries.reserve(numberOfEntries);
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        entries.push_back(createEntry(i));
+    }
+    storage.insert(entries.cbegin(), entries.cend());
+
+    // JSON: one change rewrites the whole file, startup parses the whole file
+    auto start = Clock::now();
+    for (std::size_t i = 0; i < changes; ++i) {
+        util::saveStringToFile(fileName, serializer::serializeToJson(storage));
+    }
+    const double jsonWriteMs = elapsedMs(start) / changes;
+
+    start = Clock::now();
+    capabilities::Storage loadedStorage;
+    serializer::deserializeFromJson(loadedStorage, util::loadStringFromFile(fileName));
+    const double jsonLoadMs = elapsedMs(start);
+
+    // snapshot and journal: one change appends one record, startup maps the snapshot, replays
+    // the journal and fills the storage like LocalCapabilitiesDirectory::loadPersistedFile
+    double journalWriteMs = 0;
+    {
+        capabilities::SnapshotStore store(fileName, std::numeric_limits<std::size_t>::max());
+        store.writeSnapshot(entries);
+        start = Clock::now();
+        for (std::size_t i = 0; i < journalRecords; ++i) {
+            store.add({createEntry(i)});
+        }
+        journalWriteMs = elapsedMs(start) / std::max<std::size_t>(journalRecords, 1);
+    }
+
+    start = Clock::now();
+    std::vector<types::DiscoveryEntry> loadedEntries;
+    capabilities::SnapshotStore store(fileName);
+    store.load(loadedEntries);
+    capabilities::Storage snapshotStorage;
+    snapshotStorage.insert(loadedEntries.cbegin(), loadedEntries.cend());
+    const double snapshotLoadMs = elapsedMs(start);
+
+    std::cerr << "entries: " << numberOfEntries << std::endl;
+    std::cerr << "JSON:\t\tstartup " << jsonLoadMs << " [ms], per change " << jsonWriteMs
+              << " [ms] (" << loadedStorage.size() << " entries loaded)" << std::endl;
+    std::cerr << "SNAPSHOT:\tstartup " << snapshotLoadMs << " [ms] incl. " << journalRecords
+              << " journal records, per change " << journalWriteMs << " [ms] ("
+              << snapshotStorage.size() << " entries loaded)" << std::endl;
+
+    removeFiles(fileName);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t journalRecords = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    const std::size_t changes = 5;
+
+    try {
+        run(10000, journalRecords, changes);
+        run(100000, journalRecords, changes);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
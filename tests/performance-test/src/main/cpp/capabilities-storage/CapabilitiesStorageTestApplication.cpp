@@ -0,0 +1,162 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "joynr/CapabilitiesStorage.h"
+#include "joynr/types/DiscoveryEntry.h"
+#include "joynr/types/ProviderQos.h"
+#include "joynr/types/Version.h"
+
+#include "../common/PerformanceTest.h"
+
+using namespace joynr;
+
+types::DiscoveryEntry createEntry(std::size_t index, std::size_t numberOfInterfaces)
+{
+    return types::DiscoveryEntry(types::Version(1, 0),
+                                 "domain" + std::to_string(index % numberOfInterfaces),
+                                 "interface",
+                                 "participantId" + std::to_string(index),
+                                 types::ProviderQos(),
+                                 0,
+                                 std::numeric_limits<std::int64_t>::max(),
+                                 "publicKeyId");
+}
+
+/**
+ * Every reader thread resolves participantIds (as done by the access controller for each
+ * message) and domain/interface pairs (as done by proxy creation) in batches, while one writer
+ * re-registers a provider every millisecond. The latency of each batch is recorded.
+ */
+template <typename LookupFun>
+void runLookups(const std::string& testCase,
+                capabilities::Storage& storage,
+                std::mutex& mutex,
+                std::size_t numberOfThreads,
+                std::size_t numberOfEntries,
+                std::size_t numberOfInterfaces,
+                std::size_t batchesPerThread,
+                LookupFun lookup)
+{
+    const std::size_t lookupsPerBatch = 1000;
+    std::atomic<bool> writing(true);
+    std::thread writer([&]() {
+        std::size_t index = 0;
+        while (writing) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                storage.insert(createEntry(index++ % numberOfEntries, numberOfInterfaces));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::vector<std::vector<ClockResolution>> durations(numberOfThreads);
+    std::atomic<std::size_t> found(0);
+    const auto startLoop = Clock::now();
+    std::vector<std::thread> readers;
+    for (std::size_t thread = 0; thread < numberOfThreads; ++thread) {
+        readers.emplace_back([&, thread]() {
+            std::size_t localFound = 0;
+            durations[thread].reserve(batchesPerThread);
+            for (std::size_t batch = 0; batch < batchesPerThread; ++batch) {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < lookupsPerBatch; ++i) {
+                    const std::size_t index = (thread * 7919 + batch * lookupsPerBatch + i);
+                    localFound += lookup(
+                            "participantId" + std::to_string(index % numberOfEntries),
+                            "domain" + std::to_string(index % numberOfInterfaces));
+                }
+                durations[thread].push_back(
+                        std::chrono::duration_cast<ClockResolution>(Clock::now() - start));
+            }
+            found += localFound;
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    const auto endLoop = Clock::now();
+    writing = false;
+    writer.join();
+
+    std::vector<ClockResolution> allDurations;
+    for (const auto& threadDurations : durations) {
+        allDurations.insert(allDurations.end(), threadDurations.cbegin(), threadDurations.cend());
+    }
+    const auto totalDuration = std::chrono::duration_cast<ClockResolution>(endLoop - startLoop);
+    const double totalLookups =
+            static_cast<double>(numberOfThreads * batchesPerThread * lookupsPerBatch);
+    std::cerr << "Testcase: " << testCase << " threads: " << numberOfThreads
+              << " lookups/sec: " << totalLookups * 1e6 / totalDuration.count()
+              << " (latency per batch of " << lookupsPerBatch << " lookups, found " << found
+              << ")" << std::endl;
+    PerformanceTest::printStatistics(allDurations, totalDuration);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t numberOfThreads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 16;
+    const std::size_t numberOfEntries = 10000;
+    const std::size_t numberOfInterfaces = 1000;
+    const std::size_t batchesPerThread = 200;
+
+    capabilities::Storage storage;
+    std::mutex mutex;
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        storage.insert(createEntry(i, numberOfInterfaces));
+    }
+
+    runLookups("LOOKUP_UNDER_LOCK",
+               storage,
+               mutex,
+               numberOfThreads,
+               numberOfEntries,
+               numberOfInterfaces,
+               batchesPerThread,
+               [&](const std::string& participantId, const std::string& domain) {
+                   std::lock_guard<std::mutex> lock(mutex);
+                   return static_cast<std::size_t>(
+                                  storage.lookupByParticipantId(participantId).is_initialized()) +
+                          storage.lookupByDomainAndInterface(domain, "interface").size();
+               });
+
+    runLookups("LOOKUP_SHARD_LOCKED",
+               storage,
+               mutex,
+               numberOfThreads,
+               numberOfEntries,
+               numberOfInterfaces,
+               batchesPerThread,
+               [&](const std::string& participantId, const std::string& domain) {
+                   return static_cast<std::size_t>(
+                                  storage.findByParticipantId(participantId) != nullptr) +
+                          storage.findByDomainAndInterface(domain, "interface").size();
+               });
+    return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#ifndef LATENCY_STATISTICS_H
+#define LATENCY_STATISTICS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+/**
+ * @brief Summary of a set of latency samples: percentiles, a log2 histogram and throughput.
+ *
+ * All latencies are reported in milliseconds, histogram bucket bounds in microseconds.
+ */
+class LatencyStatistics
+{
+public:
+    using Microseconds = std::chrono::microseconds;
+    using DoubleMilliSeconds = std::chrono::duration<double, std::milli>;
+    using DoubleSeconds = std::chrono::duration<double>;
+
+    struct HistogramBucket
+    {
+        std::uint64_t upperBoundUs;
+        std::uint64_t count;
+    };
+
+    /**
+     * @brief computes the statistics for the given samples
+     * @param samples the measured latencies, order does not matter
+     * @param totalDuration wall clock time of the whole measurement
+     * @param errors number of calls which did not return successfully (not part of samples)
+     */
+    LatencyStatistics(std::vector<Microseconds> samples,
+                      Microseconds totalDuration,
+                      std::uint64_t errors = 0)
+            : count(samples.size()),
+              errors(errors),
+              totalDurationSec(std::chrono::duration_cast<DoubleSeconds>(totalDuration).count()),
+              metrics(),
+              histogram()
+    {
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+
+        const Microseconds sum = std::accumulate(samples.cbegin(), samples.cend(), Microseconds(0));
+        metrics["min"] = toMs(samples.front());
+        metrics["max"] = toMs(samples.back());
+        metrics["mean"] = toMs(sum) / samples.size();
+        metrics["p50"] = toMs(percentile(samples, 50.0));
+        metrics["p90"] = toMs(percentile(samples, 90.0));
+        metrics["p99"] = toMs(percentile(samples, 99.0));
+        metrics["p999"] = toMs(percentile(samples, 99.9));
+
+        std::uint64_t upperBoundUs = 1;
+        auto it = samples.cbegin();
+        while (it != samples.cend()) {
+            auto bucketEnd = std::upper_bound(it, samples.cend(), Microseconds(upperBoundUs));
+            histogram.push_back({upperBoundUs, static_cast<std::uint64_t>(bucketEnd - it)});
+            it = bucketEnd;
+            upperBoundUs *= 2;
+        }
+    }
+
+    /**
+     * @brief nearest-rank percentile of an ascending sorted, non-empty sample vector
+     */
+    static Microseconds percentile(const std::vector<Microseconds>& sortedSamples, double pct)
+    {
+        const double rank = std::ceil(pct / 100.0 * sortedSamples.size());
+        const std::size_t index =
+                std::min(sortedSamples.size() - 1,
+                         static_cast<std::size_t>(std::max(rank, 1.0)) - static_cast<std::size_t>(1));
+        return sortedSamples[index];
+    }
+
+    double getMetric(const std::string& name) const
+    {
+        auto it = metrics.find(name);
+        return it == metrics.cend() ? 0.0 : it->second;
+    }
+
+    double getMessagesPerSecond() const
+    {
+        return totalDurationSec > 0 ? count / totalDurationSec : 0.0;
+    }
+
+    void printText(std::ostream& out) const
+    {
+        out << "----- statistics -----" << std::endl;
+        out << "totalDuration:\t" << totalDurationSec << " [s]" << std::endl;
+        out << "count:\t\t" << count << std::endl;
+        out << "errors:\t\t" << errors << std::endl;
+        for (const auto& name : metricNames()) {
+            out << name << ":\t\t" << getMetric(name) << " [ms]" << std::endl;
+        }
+        out << "msg/sec:\t\t" << getMessagesPerSecond() << std::endl;
+    }
+
+    /**
+     * @brief writes one JSON document; additional key/value pairs describing the
+     *        test configuration are written into the top-level "parameters" object
+     */
+    void writeJson(std::ostream& out,
+                   const std::string& testName,
+                   const std::map<std::string, std::string>& parameters = {}) const
+    {
+        boost::property_tree::ptree root;
+        root.put("testCase", testName);
+        boost::property_tree::ptree parameterTree;
+        for (const auto& parameter : parameters) {
+            parameterTree.put(parameter.first, parameter.second);
+        }
+        root.add_child("parameters", parameterTree);
+        root.put("count", count);
+        root.put("errors", errors);
+        root.put("totalDurationSec", totalDurationSec);
+        root.put("msgPerSec", getMessagesPerSecond());
+        for (const auto& name : metricNames()) {
+            root.put("latencyMs." + name, getMetric(name));
+        }
+        boost::property_tree::ptree histogramTree;
+        for (const auto& bucket : histogram) {
+            boost::property_tree::ptree bucketTree;
+            bucketTree.put("upperBoundUs", bucket.upperBoundUs);
+            bucketTree.put("count", bucket.count);
+            histogramTree.push_back(std::make_pair("", bucketTree));
+        }
+        root.add_child("histogram", histogramTree);
+        boost::property_tree::write_json(out, root);
+    }
+
+    /**
+     * @brief writes one CSV row; the header is written if @param withHeader is true
+     */
+    void writeCsv(std::ostream& out, const std::string& testName, bool withHeader = true) const
+    {
+        if (withHeader) {
+            out << "testCase,count,errors,totalDurationSec,msgPerSec";
+            for (const auto& name : metricNames()) {
+                out << "," << name << "Ms";
+            }
+            out << std::endl;
+        }
+        out << testName << "," << count << "," << errors << "," << totalDurationSec << ","
+            << getMessagesPerSecond();
+        for (const auto& name : metricNames()) {
+            out << "," << getMetric(name);
+        }
+        out << std::endl;
+    }
+
+    /**
+     * @brief compares against a result previously stored with writeJson
+     * @param baselineFile path of the JSON baseline
+     * @param maxRegressionPercent tolerated relative increase of each latency metric
+     * @return true if no latency metric regressed by more than maxRegressionPercent
+     */
+    bool compareToBaseline(const std::string& baselineFile,
+                           double maxRegressionPercent,
+                           std::ostream& out) const
+    {
+        boost::property_tree::ptree baseline;
+        boost::property_tree::read_json(baselineFile, baseline);
+
+        bool withinTolerance = true;
+        out << "----- comparison to baseline " << baselineFile << " -----" << std::endl;
+        for (const auto& name : metricNames()) {
+            const double base = baseline.get<double>("latencyMs." + name, 0.0);
+            const double current = getMetric(name);
+            const double changePercent = base > 0 ? (current - base) / base * 100.0 : 0.0;
+            const bool regressed = changePercent > maxRegressionPercent;
+            withinTolerance = withinTolerance && !regressed;
+            out << name << ":\t\t" << base << " -> " << current << " [ms] (" << changePercent
+                << "%)" << (regressed ? " REGRESSION" : "") << std::endl;
+        }
+        const double baseRate = baseline.get<double>("msgPerSec", 0.0);
+        out << "msg/sec:\t\t" << baseRate << " -> " << getMessagesPerSecond() << std::endl;
+        return withinTolerance;
+    }
+
+    static const std::vector<std::string>& metricNames()
+    {
+        static const std::vector<std::string> names = {
+                "min", "mean", "p50", "p90", "p99", "p999", "max"};
+        return names;
+    }
+
+    const std::vector<HistogramBucket>& getHistogram() const
+    {
+        return histogram;
+    }
+
+private:
+    static double toMs(Microseconds duration)
+    {
+        return std::chrono::duration_cast<DoubleMilliSeconds>(duration).count();
+    }
+
+    std::size_t count;
+    std::uint64_t errors;
+    double totalDurationSec;
+    std::map<std::string, double> metrics;
+    std::vector<HistogramBucket> histogram;
+};
+
+#endif // LATENCY_STATISTICS_H
@@ -28,6 +28,8 @@
 #include <utility>
 #include <vector>
 
+#include "LatencyStatistics.h"
+
 using Clock = std::chrono::steady_clock;
 using ClockResolution = std::chrono::microseconds;
 
@@ -106,6 +108,13 @@ struct PerformanceTest
         std::cerr << "maxDelay:\t\t" << maxDelayDuration.count() << " [ms]" << std::endl;
         std::cerr << "minDelay:\t\t" << minDelayDuration.count() << " [ms]" << std::endl;
         std::cerr << "meanDelay:\t\t" << meanDelay << " [ms]" << std::endl;
+
+        LatencyStatistics latencyStatistics(durationVector, totalDuration);
+        std::cerr << "p50Delay:\t\t" << latencyStatistics.getMetric("p50") << " [ms]" << std::endl;
+        std::cerr << "p90Delay:\t\t" << latencyStatistics.getMetric("p90") << " [ms]" << std::endl;
+        std::cerr << "p99Delay:\t\t" << latencyStatistics.getMetric("p99") << " [ms]" << std::endl;
+        std::cerr << "p99.9Delay:\t\t" << latencyStatistics.getMetric("p999") << " [ms]"
+                  << std::endl;
         std::cerr << "msg/sec:\t\t" << msgPerSec << std::endl;
     }
 
@@ -0,0 +1,323 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#ifndef OPENLOOPECHOCONSUMER_H
+#define OPENLOOPECHOCONSUMER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include "../common/LatencyStatistics.h"
+#include "PerformanceConsumer.h"
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+/**
+ * @brief parameters of the open loop load generator
+ *
+ * requestRate is the total number of requests per second over all senders; a value of 0
+ * sends as fast as possible. payloadMix is a comma separated list of weighted payload types,
+ * e.g. "STRING:50,BYTEARRAY:30,STRUCT:20".
+ */
+struct OpenLoopParameters
+{
+    double requestRate = 0;
+    std::size_t concurrency = 1;
+    std::string payloadMix = "STRING:1";
+    std::string outputFormat = "TEXT";
+    std::string outputFile;
+    std::string baselineFile;
+    double maxRegressionPercent = 10.0;
+    std::string transport;
+};
+
+/**
+ * @brief Consumer which issues async echo requests at a fixed rate from several sender threads
+ * independently of the reply latency (open loop).
+ *
+ * Latency is measured from the scheduled send time so that a slow system is not hidden by
+ * delayed sending (coordinated omission).
+ */
+class OpenLoopEchoConsumer : public PerformanceConsumer<OpenLoopEchoConsumer>
+{
+public:
+    // requests are paced and their latencies measured against a monotonic clock, which
+    // high_resolution_clock does not guarantee to be
+    using Clock = std::chrono::steady_clock;
+
+    enum class PayloadType { STRING, BYTEARRAY, STRUCT };
+
+    OpenLoopEchoConsumer(std::shared_ptr<JoynrRuntime> joynrRuntime,
+                         std::size_t messageCount,
+                         std::size_t stringLength,
+                         std::size_t byteArraySize,
+                         const std::string& domain,
+                         OpenLoopParameters parameters)
+            : PerformanceConsumer(std::move(joynrRuntime),
+                                  messageCount,
+                                  stringLength,
+                                  byteArraySize,
+                                  domain),
+              parameters(std::move(parameters)),
+              mutex(),
+              cv(),
+              samples(),
+              completed(0),
+              errors(0),
+              withinBaseline(true)
+    {
+        if (this->parameters.concurrency == 0) {
+            throw std::invalid_argument("concurrency must be >= 1");
+        }
+        if (this->parameters.requestRate < 0) {
+            throw std::invalid_argument("requestRate must be >= 0");
+        }
+    }
+
+    void loopByteArray(const ByteArray& data)
+    {
+        testName = "SEND_BYTEARRAY";
+        loop([this, &data](std::size_t, auto onSuccess, auto onError) {
+            echoProxy->echoByteArrayAsync(data, onSuccess, onError);
+        });
+    }
+
+    void loopString(const std::string& data)
+    {
+        testName = "SEND_STRING";
+        loop([this, &data](std::size_t, auto onSuccess, auto onError) {
+            echoProxy->echoStringAsync(data, onSuccess, onError);
+        });
+    }
+
+    void loopStruct(const ComplexStruct& data)
+    {
+        testName = "SEND_STRUCT";
+        loop([this, &data](std::size_t, auto onSuccess, auto onError) {
+            echoProxy->echoComplexStructAsync(data, onSuccess, onError);
+        });
+    }
+
+    void runPayloadMix()
+    {
+        run(&OpenLoopEchoConsumer::loopPayloadMix);
+    }
+
+    void loopPayloadMix()
+    {
+        testName = "SEND_PAYLOAD_MIX(" + parameters.payloadMix + ")";
+        const std::vector<PayloadType> payloadSequence = createPayloadSequence();
+        const std::string stringData = getFilledString();
+        const ByteArray byteArrayData = getFilledByteArray();
+        const ComplexStruct structData = getFilledStruct();
+
+        loop([&](std::size_t index, auto onSuccess, auto onError) {
+            switch (payloadSequence[index]) {
+            case PayloadType::STRING:
+                echoProxy->echoStringAsync(stringData, onSuccess, onError);
+                break;
+            case PayloadType::BYTEARRAY:
+                echoProxy->echoByteArrayAsync(byteArrayData, onSuccess, onError);
+                break;
+            case PayloadType::STRUCT:
+                echoProxy->echoComplexStructAsync(structData, onSuccess, onError);
+                break;
+            }
+        });
+    }
+
+    /**
+     * @return false if a baseline was given and one of the latency metrics regressed by more
+     * than the configured tolerance
+     */
+    bool isWithinBaseline() const
+    {
+        return withinBaseline;
+    }
+
+private:
+    template <typename Fun>
+    void loop(Fun&& fun)
+    {
+        samples.clear();
+        samples.reserve(messageCount);
+        completed = 0;
+        errors = 0;
+
+        const std::size_t concurrency = parameters.concurrency;
+        const auto interval =
+                parameters.requestRate > 0
+                        ? std::chrono::nanoseconds(static_cast<std::int64_t>(
+                                  1e9 * static_cast<double>(concurrency) / parameters.requestRate))
+                        : std::chrono::nanoseconds(0);
+        const auto startLoop = Clock::now();
+
+        std::vector<std::thread> senders;
+        senders.reserve(concurrency);
+        for (std::size_t sender = 0; sender < concurrency; ++sender) {
+            senders.emplace_back([this, sender, concurrency, interval, startLoop, &fun]() {
+                // senders are phase shifted so that the aggregate rate is evenly spaced
+                const auto phase = interval * sender / concurrency;
+                for (std::size_t i = sender; i < messageCount; i += concurrency) {
+                    auto start = Clock::now();
+                    if (interval.count() > 0) {
+                        start = startLoop + phase + interval * (i / concurrency);
+                        std::this_thread::sleep_until(start);
+                    }
+                    auto onSuccess = [this, start](const auto&) {
+                        this->onReplyReceived(start);
+                    };
+                    auto onError = [this](const exceptions::JoynrRuntimeException&) {
+                        this->onErrorReceived();
+                    };
+                    fun(i, onSuccess, onError);
+                }
+            });
+        }
+        for (auto& sender : senders) {
+            sender.join();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return completed == messageCount; });
+        const auto endLoop = Clock::now();
+
+        if (samples.empty()) {
+            throw std::runtime_error("no request was answered successfully");
+        }
+        // only successful calls are reported by the generic statistics
+        durationVector = samples;
+        report(std::chrono::duration_cast<ClockResolution>(endLoop - startLoop));
+    }
+
+    void onReplyReceived(Clock::time_point start)
+    {
+        const auto end = Clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(std::chrono::duration_cast<ClockResolution>(end - start));
+        notifyIfDone();
+    }
+
+    void onErrorReceived()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++errors;
+        notifyIfDone();
+    }
+
+    void notifyIfDone()
+    {
+        if (++completed == messageCount) {
+            cv.notify_one();
+        }
+    }
+
+    void report(ClockResolution totalDuration)
+    {
+        LatencyStatistics statistics(samples, totalDuration, errors);
+        const std::map<std::string, std::string> reportParameters = {
+                {"transport", parameters.transport},
+                {"requestRate", std::to_string(parameters.requestRate)},
+                {"concurrency", std::to_string(parameters.concurrency)},
+                {"stringLength", std::to_string(stringLength)},
+                {"byteArraySize", std::to_string(byteArraySize)}};
+
+        // compare first, the output file may not be opened before the baseline is read
+        if (!parameters.baselineFile.empty()) {
+            withinBaseline = statistics.compareToBaseline(
+                    parameters.baselineFile, parameters.maxRegressionPercent, std::cerr);
+        }
+
+        std::ofstream outputFileStream;
+        if (!parameters.outputFile.empty()) {
+            outputFileStream.open(parameters.outputFile);
+            if (!outputFileStream) {
+                throw std::runtime_error("cannot open output file " + parameters.outputFile);
+            }
+        }
+        std::ostream& out = parameters.outputFile.empty() ? std::cout : outputFileStream;
+
+        if (parameters.outputFormat == "JSON") {
+            statistics.writeJson(out, testName, reportParameters);
+        } else if (parameters.outputFormat == "CSV") {
+            statistics.writeCsv(out, testName);
+        } else {
+            out << "Testcase: " << testName << std::endl;
+            statistics.printText(out);
+        }
+    }
+
+    std::vector<PayloadType> createPayloadSequence() const
+    {
+        static const std::map<std::string, PayloadType> payloadTypes = {
+                {"STRING", PayloadType::STRING},
+                {"BYTEARRAY", PayloadType::BYTEARRAY},
+                {"STRUCT", PayloadType::STRUCT}};
+
+        std::vector<std::string> entries;
+        boost::split(entries, parameters.payloadMix, boost::is_any_of(","));
+        std::vector<PayloadType> types;
+        std::vector<double> weights;
+        for (const auto& entry : entries) {
+            std::vector<std::string> typeAndWeight;
+            boost::split(typeAndWeight, entry, boost::is_any_of(":"));
+            auto type = payloadTypes.find(typeAndWeight[0]);
+            if (type == payloadTypes.cend() || typeAndWeight.size() > 2) {
+                throw std::invalid_argument("invalid payload mix entry: " + entry);
+            }
+            types.push_back(type->second);
+            weights.push_back(typeAndWeight.size() == 2 ? std::stod(typeAndWeight[1]) : 1.0);
+        }
+
+        // fixed seed: the same mix yields the same request sequence in every run
+        std::mt19937 rng(42);
+        std::discrete_distribution<std::size_t> distribution(weights.cbegin(), weights.cend());
+        std::vector<PayloadType> sequence(messageCount);
+        for (auto& payloadType : sequence) {
+            payloadType = types[distribution(rng)];
+        }
+        return sequence;
+    }
+
+    OpenLoopParameters parameters;
+    std::string testName;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<ClockResolution> samples;
+    std::size_t completed;
+    std::uint64_t errors;
+    bool withinBaseline;
+};
+
+} // namespace joynr
+
+#endif // OPENLOOPECHOCONSUMER_H
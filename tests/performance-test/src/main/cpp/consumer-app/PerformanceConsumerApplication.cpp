@@ -33,13 +33,16 @@
 #include <joynr/tests/DummyKeyChainParameters.h>
 
 #include "../common/Enum.h"
+#include "OpenLoopEchoConsumer.h"
 #include "PerformanceConsumer.h"
 #ifdef JOYNR_ENABLE_DLT_LOGGING
 #include <dlt/dlt.h>
 #endif // JOYNR_ENABLE_DLT_LOGGING
 
-JOYNR_ENUM(SyncMode, (SYNC)(ASYNC));
-JOYNR_ENUM(TestCase, (SEND_STRING)(SEND_BYTEARRAY)(SEND_BYTEARRAY_WITH_SIZE_TIMES_K)(SEND_STRUCT));
+JOYNR_ENUM(SyncMode, (SYNC)(ASYNC)(OPEN_LOOP));
+JOYNR_ENUM(TestCase,
+           (SEND_STRING)(SEND_BYTEARRAY)(SEND_BYTEARRAY_WITH_SIZE_TIMES_K)(SEND_STRUCT)(
+                   SEND_PAYLOAD_MIX));
 
 int main(int argc, char* argv[])
 {
@@ -59,6 +62,7 @@ int main(int argc, char* argv[])
     bool useKeyChain = false;
     const std::string ccUrlForTLS("wss://localhost:4243");
     joynr::tests::DummyKeyChainParameters keyChainInputParams;
+    joynr::OpenLoopParameters openLoopParameters;
 
     auto validateRuns = [](std::size_t value) {
         if (value == 0) {
@@ -73,8 +77,9 @@ int main(int argc, char* argv[])
             "runs,r", po::value(&runs)->required()->notifier(validateRuns), "number of runs")(
             "testCase,t",
             po::value(&testCase)->required(),
-            "SEND_STRING|SEND_BYTEARRAY|SEND_BYTEARRAY_WITH_SIZE_TIMES_K|SEND_STRUCT")(
-            "syncMode,s", po::value(&syncMode)->required(), "SYNC|ASYNC")(
+            "SEND_STRING|SEND_BYTEARRAY|SEND_BYTEARRAY_WITH_SIZE_TIMES_K|SEND_STRUCT|"
+            "SEND_PAYLOAD_MIX (OPEN_LOOP only)")(
+            "syncMode,s", po::value(&syncMode)->required(), "SYNC|ASYNC|OPEN_LOOP")(
             "stringLength,l", po::value(&stringLength)->required(), "length of string")(
             "byteArraySize,b", po::value(&byteArraySize)->required(), "size of bytearray")(
             "useKeychain",
@@ -91,7 +96,32 @@ int main(int argc, char* argv[])
             "Private key in PEM encoded format.")(
             "private-key-pwd",
             po::value(&keyChainInputParams.privKeyPassword)->default_value(""),
-            "Passsword of private key. Default: empty string.");
+            "Passsword of private key. Default: empty string.")(
+            "rate",
+            po::value(&openLoopParameters.requestRate)->default_value(0),
+            "OPEN_LOOP: total requests per second, 0 sends as fast as possible. Default: 0.")(
+            "concurrency",
+            po::value(&openLoopParameters.concurrency)->default_value(1),
+            "OPEN_LOOP: number of sender threads. Default: 1.")(
+            "payloadMix",
+            po::value(&openLoopParameters.payloadMix)->default_value("STRING:1"),
+            "OPEN_LOOP: weighted payload types for SEND_PAYLOAD_MIX, "
+            "e.g. STRING:50,BYTEARRAY:30,STRUCT:20")(
+            "outputFormat",
+            po::value(&openLoopParameters.outputFormat)->default_value("TEXT"),
+            "OPEN_LOOP: TEXT|JSON|CSV. Default: TEXT.")(
+            "outputFile",
+            po::value(&openLoopParameters.outputFile),
+            "OPEN_LOOP: file the results are written to. Default: stdout.")(
+            "baseline",
+            po::value(&openLoopParameters.baselineFile),
+            "OPEN_LOOP: JSON result of a previous run to compare with.")(
+            "maxRegressionPercent",
+            po::value(&openLoopParameters.maxRegressionPercent)->default_value(10.0),
+            "OPEN_LOOP: tolerated latency increase compared to the baseline. Default: 10.")(
+            "transport",
+            po::value(&openLoopParameters.transport)->default_value(""),
+            "OPEN_LOOP: label of the transport under test, written to the results.");
 
     try {
         po::variables_map vm;
@@ -104,6 +134,13 @@ int main(int argc, char* argv[])
 
         po::notify(vm);
 
+        if (!openLoopParameters.baselineFile.empty() && !openLoopParameters.outputFile.empty() &&
+            boost::filesystem::exists(openLoopParameters.outputFile) &&
+            boost::filesystem::equivalent(
+                    openLoopParameters.baselineFile, openLoopParameters.outputFile)) {
+            throw std::invalid_argument("baseline and outputFile must not be the same file");
+        }
+
         boost::filesystem::path appFilename = boost::filesystem::path(argv[0]);
         std::string appDirectory =
                 boost::filesystem::system_complete(appFilename).parent_path().string();
@@ -122,9 +159,24 @@ int main(int argc, char* argv[])
         std::shared_ptr<joynr::JoynrRuntime> runtime(
                 joynr::JoynrRuntime::createRuntime(std::move(joynrSettings), std::move(keyChain)));
 
-        std::unique_ptr<joynr::IPerformanceConsumer> consumer;
+        if (testCase == TestCase::SEND_PAYLOAD_MIX && syncMode != SyncMode::OPEN_LOOP) {
+            throw std::invalid_argument("SEND_PAYLOAD_MIX requires syncMode OPEN_LOOP");
+        }
 
-        if (syncMode == SyncMode::SYNC) {
+        std::unique_ptr<joynr::IPerformanceConsumer> consumer;
+        joynr::OpenLoopEchoConsumer* openLoopConsumer = nullptr;
+
+        if (syncMode == SyncMode::OPEN_LOOP) {
+            auto openLoopEchoConsumer =
+                    std::make_unique<joynr::OpenLoopEchoConsumer>(std::move(runtime),
+                                                                  runs,
+                                                                  stringLength,
+                                                                  byteArraySize,
+                                                                  domain,
+                                                                  openLoopParameters);
+            openLoopConsumer = openLoopEchoConsumer.get();
+            consumer = std::move(openLoopEchoConsumer);
+        } else if (syncMode == SyncMode::SYNC) {
             consumer = std::make_unique<joynr::SyncEchoConsumer>(
                     std::move(runtime), runs, stringLength, byteArraySize, domain);
         } else {
@@ -145,6 +197,14 @@ int main(int argc, char* argv[])
         case TestCase::SEND_STRUCT:
             consumer->runStruct();
             break;
+        case TestCase::SEND_PAYLOAD_MIX:
+            openLoopConsumer->runPayloadMix();
+            break;
+        }
+
+        if (openLoopConsumer && !openLoopConsumer->isWithinBaseline()) {
+            std::cerr << "latency regression compared to baseline" << std::endl;
+            return EXIT_FAILURE;
         }
     } catch (const std::exception& e) {
         std::cerr << e.what();
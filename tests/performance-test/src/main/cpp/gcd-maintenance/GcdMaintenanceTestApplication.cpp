@@ -0,0 +1,259 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+
+#include "joynr/types/GlobalDiscoveryEntry.h"
+#include "libjoynrclustercontroller/capabilities-client/BatchingCapabilitiesClient.h"
+#include "libjoynrclustercontroller/capabilities-client/ICapabilitiesClient.h"
+
+using namespace joynr;
+
+/**
+ * Counts the requests which a cluster controller sends to the global capabilities directory,
+ * grouped by the simulated time slot in which they are sent.
+ */
+struct RequestCounter
+{
+    explicit RequestCounter(std::size_t numberOfSlots)
+            : currentSlot(0), requestsPerSlot(numberOfSlots, 0), totalRequests(0)
+    {
+    }
+
+    void count()
+    {
+        ++requestsPerSlot[currentSlot];
+        ++totalRequests;
+    }
+
+    std::size_t currentSlot;
+    std::vector<std::size_t> requestsPerSlot;
+    std::size_t totalRequests;
+};
+
+class CountingCapabilitiesClient : public ICapabilitiesClient
+{
+public:
+    explicit CountingCapabilitiesClient(RequestCounter& counter) : counter(counter)
+    {
+    }
+
+    void add(const types::GlobalDiscoveryEntry& entry,
+             std::function<void()> onSuccess,
+             std::function<void(const exceptions::JoynrRuntimeException& error)> onError) override
+    {
+        std::ignore = entry;
+        std::ignore = onError;
+        counter.count();
+        if (onSuccess) {
+            onSuccess();
+        }
+    }
+
+    void add(const std::vector<types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
+             std::function<void()> onSuccess,
+             std::function<void(const exceptions::JoynrRuntimeException& error)> onRuntimeError)
+            override
+    {
+        std::ignore = globalDiscoveryEntries;
+        std::ignore = onRuntimeError;
+        counter.count();
+        if (onSuccess) {
+            onSuccess();
+        }
+    }
+
+    void remove(const std::string& participantId) override
+    {
+        std::ignore = participantId;
+        counter.count();
+    }
+
+    void remove(std::vector<std::string> participantIds) override
+    {
+        std::ignore = participantIds;
+        counter.count();
+    }
+
+    void lookup(const std::vector<std::string>& domains,
+                const std::string& interfaceName,
+                std::int64_t messagingTtl,
+                std::function<void(const std::vector<types::GlobalDiscoveryEntry>& result)>
+                        onSuccess,
+                std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+            override
+    {
+        std::ignore = domains;
+        std::ignore = interfaceName;
+        std::ignore = messagingTtl;
+        std::ignore = onError;
+        counter.count();
+        onSuccess({});
+    }
+
+    void lookup(const std::string& participantId,
+                std::function<void(const std::vector<types::GlobalDiscoveryEntry>& result)>
+                        onSuccess,
+                std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+            override
+    {
+        std::ignore = participantId;
+        std::ignore = onError;
+        counter.count();
+        onSuccess({});
+    }
+
+    void touch(const std::string& clusterControllerId,
+               std::function<void()> onSuccess,
+               std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
+            override
+    {
+        std::ignore = clusterControllerId;
+        std::ignore = onError;
+        counter.count();
+        if (onSuccess) {
+            onSuccess();
+        }
+    }
+
+private:
+    RequestCounter& counter;
+};
+
+struct Scenario
+{
+    std::string name;
+    bool isBatched;
+    std::uint32_t freshnessUpdateJitterPercent;
+};
+
+/**
+ * All cluster controllers are started at the same time. In every time slot each of them
+ * registers or unregisters some providers and touches its entries once per freshness update
+ * interval. Batched cluster controllers send their pending requests at the end of each slot,
+ * which is the batch window.
+ */
+void runScenario(const Scenario& scenario,
+                 std::size_t numberOfClusterControllers,
+                 std::size_t providersPerClusterController)
+{
+    const std::chrono::milliseconds slotDuration(100);
+    const std::size_t freshnessUpdateIntervalSlots = 600; // 1 minute
+    const std::size_t numberOfSlots = 10 * freshnessUpdateIntervalSlots;
+    const double changeProbability = 0.2;
+    const std::size_t maxChangesPerSlot = 5;
+
+    boost::asio::io_service ioService;
+    RequestCounter counter(numberOfSlots);
+    std::mt19937 random(42);
+    std::bernoulli_distribution hasChange(changeProbability);
+    std::uniform_int_distribution<std::size_t> numberOfChanges(1, maxChangesPerSlot);
+    std::uniform_int_distribution<std::size_t> provider(0, providersPerClusterController - 1);
+    const std::int64_t maxJitterSlots = static_cast<std::int64_t>(
+            freshnessUpdateIntervalSlots * scenario.freshnessUpdateJitterPercent / 100);
+    std::uniform_int_distribution<std::int64_t> jitterSlots(-maxJitterSlots, maxJitterSlots);
+    auto nextFreshnessUpdateInterval = [&]() {
+        return static_cast<std::size_t>(freshnessUpdateIntervalSlots + jitterSlots(random));
+    };
+
+    std::vector<std::shared_ptr<ICapabilitiesClient>> clients;
+    std::vector<std::shared_ptr<BatchingCapabilitiesClient>> batchingClients;
+    std::vector<std::size_t> nextTouchSlot;
+    std::vector<std::vector<bool>> isRegistered;
+    for (std::size_t cc = 0; cc < numberOfClusterControllers; ++cc) {
+        auto client = std::make_shared<CountingCapabilitiesClient>(counter);
+        if (scenario.isBatched) {
+            auto batchingClient =
+                    std::make_shared<BatchingCapabilitiesClient>(client, ioService, slotDuration);
+            batchingClients.push_back(batchingClient);
+            clients.push_back(batchingClient);
+        } else {
+            clients.push_back(client);
+        }
+        nextTouchSlot.push_back(nextFreshnessUpdateInterval());
+        isRegistered.emplace_back(providersPerClusterController, false);
+    }
+
+    std::size_t numberOfChangedProviders = 0;
+    for (std::size_t slot = 0; slot < numberOfSlots; ++slot) {
+        counter.currentSlot = slot;
+        for (std::size_t cc = 0; cc < numberOfClusterControllers; ++cc) {
+            if (hasChange(random)) {
+                const std::size_t changes = numberOfChanges(random);
+                for (std::size_t i = 0; i < changes; ++i) {
+                    const std::size_t providerIndex = provider(random);
+                    const std::string participantId = "cc" + std::to_string(cc) + "-provider" +
+                                                      std::to_string(providerIndex);
+                    if (isRegistered[cc][providerIndex]) {
+                        clients[cc]->remove(participantId);
+                    } else {
+                        types::GlobalDiscoveryEntry entry;
+                        entry.setParticipantId(participantId);
+                        clients[cc]->add(entry, nullptr, nullptr);
+                    }
+                    isRegistered[cc][providerIndex] = !isRegistered[cc][providerIndex];
+                    ++numberOfChangedProviders;
+                }
+            }
+            if (slot == nextTouchSlot[cc]) {
+                clients[cc]->touch("cc" + std::to_string(cc), nullptr, nullptr);
+                nextTouchSlot[cc] += nextFreshnessUpdateInterval();
+            }
+        }
+        for (const auto& batchingClient : batchingClients) {
+            batchingClient->flush();
+        }
+    }
+
+    const auto peakSlot =
+            std::max_element(counter.requestsPerSlot.cbegin(), counter.requestsPerSlot.cend());
+    std::cerr << "Testcase: " << scenario.name
+              << " clusterControllers: " << numberOfClusterControllers
+              << " providerChanges: " << numberOfChangedProviders
+              << " requests: " << counter.totalRequests << " peak requests per "
+              << slotDuration.count() << "ms: " << *peakSlot << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t numberOfClusterControllers =
+            argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+    const std::size_t providersPerClusterController = 20;
+
+    const std::vector<Scenario> scenarios{{"EAGER_IN_LOCKSTEP", false, 0},
+                                          {"EAGER_JITTERED", false, 10},
+                                          {"BATCHED_JITTERED", true, 10}};
+    for (const auto& scenario : scenarios) {
+        runScenario(scenario, numberOfClusterControllers, providersPerClusterController);
+    }
+
+    return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "joynr/IMessageRouter.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
+#include "joynr/MqttIngressQueue.h"
+#include "joynr/MqttMessagingSkeleton.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Semaphore.h"
+#include "joynr/TimePoint.h"
+
+using namespace joynr;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Emulates the mosquitto loop thread of a broker connection which delivers bursts of messages
+ * to MqttMessagingSkeleton, either synchronously or through an MqttIngressQueue. The router
+ * only counts the messages and spends a configurable time per message to simulate routing.
+ *
+ * Reported are the ingress throughput and how long the loop thread was occupied per delivered
+ * message, which is the time keep-alives and acknowledgements of the connection are delayed.
+ */
+namespace
+{
+
+class CountingMessageRouter : public IMessageRouter
+{
+public:
+    explicit CountingMessageRouter(std::chrono::microseconds routingTime)
+            : routingTime(routingTime), routedMessages(0)
+    {
+    }
+
+    void route(std::shared_ptr<ImmutableMessage> message, std::uint32_t tryCount) override
+    {
+        std::ignore = message;
+        std::ignore = tryCount;
+        const auto end = Clock::now() + routingTime;
+        while (Clock::now() < end) {
+            // busy wait to simulate the CPU time of routing
+        }
+        routedMessages++;
+    }
+
+    void addNextHop(const std::string&,
+                    const std::shared_ptr<const system::RoutingTypes::Address>&,
+                    bool,
+                    const std::int64_t,
+                    const bool,
+                    std::function<void()>,
+                    std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void addNextHops(const std::vector<std::string>&,
+                     const std::shared_ptr<const system::RoutingTypes::Address>&,
+                     bool,
+                     const std::int64_t,
+                     const bool,
+                     std::function<void()>,
+                     std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeNextHop(const std::string&,
+                       std::function<void()>,
+                       std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeNextHops(const std::vector<std::string>&,
+                        std::function<void()>,
+                        std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void addMulticastReceiver(
+            const std::string&,
+            const std::string&,
+            const std::string&,
+            std::function<void()>,
+            std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeMulticastReceiver(
+            const std::string&,
+            const std::string&,
+            const std::string&,
+            std::function<void()>,
+            std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void sendQueuedMessages(std::shared_ptr<const system::RoutingTypes::Address>) override
+    {
+    }
+
+    void setToKnown(const std::string&) override
+    {
+    }
+
+    std::uint64_t getRoutedMessages() const
+    {
+        return routedMessages;
+    }
+
+private:
+    const std::chrono::microseconds routingTime;
+    std::atomic<std::uint64_t> routedMessages;
+};
+
+smrf::ByteVector createSerializedMessage()
+{
+    MutableMessage mutableMessage;
+    mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
+    mutableMessage.setSender("sender");
+    mutableMessage.setRecipient("recipient");
+    mutableMessage.setExpiryDate(TimePoint::fromRelativeMs(3600000));
+    mutableMessage.setPayload(R"({"_typeName":"joynr.OneWayRequest","methodName":"m"})");
+    return mutableMessage.getImmutableMessage()->getSerializedMessage();
+}
+
+double toUs(std::chrono::nanoseconds duration)
+{
+    return static_cast<double>(duration.count()) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    int numberOfBursts = 0;
+    int burstSize = 0;
+    int burstIntervalMs = 0;
+    int routingTimeUs = 0;
+    std::uint32_t queueSize = 0;
+    std::uint32_t workerThreads = 0;
+    std::string overflowPolicy;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "bursts,b", po::value<int>(&numberOfBursts)->default_value(20), "number of bursts")(
+            "burstsize,s",
+            po::value<int>(&burstSize)->default_value(5000),
+            "messages delivered back to back per burst")(
+            "interval,i",
+            po::value<int>(&burstIntervalMs)->default_value(100),
+            "time between the start of two bursts in milliseconds")(
+            "routingtime,r",
+            po::value<int>(&routingTimeUs)->default_value(20),
+            "simulated routing time per message in microseconds")(
+            "queuesize,q",
+            po::value<std::uint32_t>(&queueSize)->default_value(10000),
+            "capacity of the ingress queue, 0 routes on the loop thread")(
+            "workers,w",
+            po::value<std::uint32_t>(&workerThreads)->default_value(2),
+            "number of worker threads of the ingress queue")(
+            "policy,p",
+            po::value<std::string>(&overflowPolicy)->default_value("BLOCK"),
+            "overflow policy: BLOCK, DROP_NEWEST or DROP_OLDEST");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    auto messageRouter =
+            std::make_shared<CountingMessageRouter>(std::chrono::microseconds(routingTimeUs));
+    auto skeleton = std::make_shared<MqttMessagingSkeleton>(messageRouter, nullptr, "");
+
+    std::shared_ptr<MqttIngressQueue> ingressQueue;
+    std::function<void(smrf::ByteVector&&)> onMessageReceived;
+    if (queueSize > 0) {
+        ingressQueue = std::make_shared<MqttIngressQueue>(
+                queueSize,
+                workerThreads,
+                MqttIngressOverflowPolicy::getEnum(overflowPolicy),
+                [skeleton](smrf::ByteVector&& msg) {
+                    skeleton->onMessageReceived(std::move(msg));
+                });
+        ingressQueue->start();
+        onMessageReceived = [ingressQueue](smrf::ByteVector&& msg) {
+            ingressQueue->push(std::move(msg));
+        };
+    } else {
+        onMessageReceived = [skeleton](smrf::ByteVector&& msg) {
+            skeleton->onMessageReceived(std::move(msg));
+        };
+    }
+
+    const smrf::ByteVector message = createSerializedMessage();
+    const std::size_t totalMessages =
+            static_cast<std::size_t>(numberOfBursts) * static_cast<std::size_t>(burstSize);
+    std::vector<std::chrono::nanoseconds> callbackTimes;
+    callbackTimes.reserve(totalMessages);
+    std::vector<std::chrono::nanoseconds> burstTimes;
+    burstTimes.reserve(static_cast<std::size_t>(numberOfBursts));
+
+    // the broker stand-in: one thread delivering like the mosquitto loop thread does
+    const auto start = Clock::now();
+    std::thread loopThread([&]() {
+        auto nextBurst = Clock::now();
+        for (int burst = 0; burst < numberOfBursts; burst++) {
+            std::this_thread::sleep_until(nextBurst);
+            nextBurst += std::chrono::milliseconds(burstIntervalMs);
+            const auto burstStart = Clock::now();
+            for (int i = 0; i < burstSize; i++) {
+                smrf::ByteVector rawMessage(message);
+                const auto callbackStart = Clock::now();
+                onMessageReceived(std::move(rawMessage));
+                callbackTimes.push_back(Clock::now() - callbackStart);
+            }
+            burstTimes.push_back(Clock::now() - burstStart);
+        }
+    });
+    loopThread.join();
+
+    // wait until the workers have routed or dropped everything
+    std::uint64_t dropped = 0;
+    while (true) {
+        dropped = ingressQueue ? ingressQueue->getStatistics().dropped : 0;
+        if (messageRouter->getRoutedMessages() + dropped >= totalMessages) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto duration = Clock::now() - start;
+
+    MqttIngressQueueStatistics statistics{};
+    if (ingressQueue) {
+        statistics = ingressQueue->getStatistics();
+        ingressQueue->stop();
+    }
+
+    std::sort(callbackTimes.begin(), callbackTimes.end());
+    std::sort(burstTimes.begin(), burstTimes.end());
+    const double seconds =
+            static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) /
+            1000000.0;
+
+    std::cout << "Queue size: " << queueSize << std::endl;
+    std::cout << "Worker threads: " << (queueSize > 0 ? workerThreads : 0) << std::endl;
+    std::cout << "Overflow policy: " << (queueSize > 0 ? overflowPolicy : "-") << std::endl;
+    std::cout << "Messages routed: " << messageRouter->getRoutedMessages() << std::endl;
+    std::cout << "Messages dropped: " << dropped << std::endl;
+    std::cout << "Producer blocked: " << statistics.blocked << std::endl;
+    std::cout << "Max queued: " << statistics.maxQueued << std::endl;
+    std::cout << "Throughput (msgs/s): "
+              << static_cast<double>(messageRouter->getRoutedMessages()) / seconds << std::endl;
+    if (!callbackTimes.empty()) {
+        std::cout << "Loop thread per message median (us): "
+                  << toUs(callbackTimes[callbackTimes.size() / 2]) << std::endl;
+        std::cout << "Loop thread per message P99 (us): "
+                  << toUs(callbackTimes[callbackTimes.size() * 99 / 100]) << std::endl;
+        std::cout << "Loop thread per message max (us): " << toUs(callbackTimes.back())
+                  << std::endl;
+    }
+    if (!burstTimes.empty()) {
+        std::cout << "Loop thread busy per burst max (us): " << toUs(burstTimes.back())
+                  << std::endl;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,348 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Settings.h"
+#include "joynr/TimePoint.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/system/RoutingTypes/MqttAddress.h"
+#include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+#include "libjoynrclustercontroller/mqtt/MqttSender.h"
+
+using namespace joynr;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Measures how publish batching and the in-flight window affect the MQTT publish throughput of
+ * MqttSender. The broker connection is replaced by a stand-in which never connects to a broker:
+ * each publish costs a fixed amount of CPU time, at most max-inflight publishes are
+ * unacknowledged at a time and each one is acknowledged one round trip time after it was sent.
+ * Further publishes wait in a queue like they do in mosquitto.
+ *
+ * Reported are the time until all messages were acknowledged and the number of publishes.
+ */
+namespace
+{
+
+class BrokerStandIn : public MosquittoConnection
+{
+public:
+    BrokerStandIn(const MessagingSettings& messagingSettings,
+                  const ClusterControllerSettings& ccSettings,
+                  std::chrono::microseconds roundTripTime,
+                  std::chrono::microseconds publishCost)
+            : MosquittoConnection(messagingSettings, ccSettings, "broker-stand-in"),
+              maxInflight(messagingSettings.getMqttMaxInflightMessages()),
+              roundTripTime(roundTripTime),
+              publishCost(publishCost),
+              mutex(),
+              changed(),
+              queued(),
+              inflight(),
+              isRunning(true),
+              publishes(0),
+              acknowledgedMessages(0),
+              ackThread(&BrokerStandIn::acknowledge, this)
+    {
+    }
+
+    ~BrokerStandIn() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isRunning = false;
+        }
+        changed.notify_all();
+        ackThread.join();
+    }
+
+    std::uint16_t getMqttQos() const override
+    {
+        return 1;
+    }
+
+    bool isSubscribedToChannelTopic() const override
+    {
+        return true;
+    }
+
+    bool isReadyToSend() const override
+    {
+        return true;
+    }
+
+    void publishMessage(
+            const std::string& topic,
+            const int qosLevel,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure,
+            std::uint32_t payloadlen,
+            const void* payload) override
+    {
+        std::ignore = topic;
+        std::ignore = qosLevel;
+        std::ignore = onFailure;
+        const auto end = Clock::now() + publishCost;
+        while (Clock::now() < end) {
+            // busy wait to simulate encoding and writing the publish packet
+        }
+
+        const std::size_t messages = countMessages(payloadlen, payload);
+        std::lock_guard<std::mutex> lock(mutex);
+        publishes++;
+        queued.push_back(messages);
+        sendQueued(Clock::now());
+    }
+
+    std::uint64_t getPublishes()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return publishes;
+    }
+
+    void waitForAcknowledged(std::uint64_t messages)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this, messages]() { return acknowledgedMessages >= messages; });
+    }
+
+private:
+    struct InflightPublish
+    {
+        Clock::time_point acknowledgeAt;
+        std::size_t messages;
+    };
+
+    static std::size_t countMessages(std::uint32_t payloadlen, const void* payload)
+    {
+        const smrf::Byte* bytes = static_cast<const smrf::Byte*>(payload);
+        const smrf::ByteVector header(
+                bytes, bytes + std::min<std::size_t>(payloadlen, MessageBatch::HEADER_SIZE));
+        if (!MessageBatch::isBatch(header)) {
+            return 1;
+        }
+        std::size_t messages = 0;
+        std::size_t offset = MessageBatch::HEADER_SIZE;
+        while (offset + MessageBatch::FRAME_OVERHEAD <= payloadlen) {
+            const std::uint32_t size = (static_cast<std::uint32_t>(bytes[offset]) << 24) |
+                                       (static_cast<std::uint32_t>(bytes[offset + 1]) << 16) |
+                                       (static_cast<std::uint32_t>(bytes[offset + 2]) << 8) |
+                                       static_cast<std::uint32_t>(bytes[offset + 3]);
+            offset += MessageBatch::FRAME_OVERHEAD + size;
+            messages++;
+        }
+        return messages;
+    }
+
+    // must be called with mutex locked
+    void sendQueued(Clock::time_point now)
+    {
+        bool sent = false;
+        while (!queued.empty() && (maxInflight == 0 || inflight.size() < maxInflight)) {
+            inflight.push_back(InflightPublish{now + roundTripTime, queued.front()});
+            queued.pop_front();
+            sent = true;
+        }
+        if (sent) {
+            changed.notify_all();
+        }
+    }
+
+    void acknowledge()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (isRunning) {
+            if (inflight.empty()) {
+                changed.wait(lock);
+                continue;
+            }
+            const auto acknowledgeAt = inflight.front().acknowledgeAt;
+            if (Clock::now() < acknowledgeAt) {
+                changed.wait_until(lock, acknowledgeAt);
+                continue;
+            }
+            acknowledgedMessages += inflight.front().messages;
+            inflight.pop_front();
+            sendQueued(Clock::now());
+            changed.notify_all();
+        }
+    }
+
+    const std::size_t maxInflight;
+    const std::chrono::microseconds roundTripTime;
+    const std::chrono::microseconds publishCost;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::size_t> queued;
+    std::deque<InflightPublish> inflight;
+    bool isRunning;
+    std::uint64_t publishes;
+    std::uint64_t acknowledgedMessages;
+    std::thread ackThread;
+};
+
+std::shared_ptr<ImmutableMessage> createMessage(const std::string& recipient,
+                                                const std::string& payload)
+{
+    MutableMessage mutableMessage;
+    mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
+    mutableMessage.setSender("mqtt-publish-batching");
+    mutableMessage.setRecipient(recipient);
+    mutableMessage.setExpiryDate(TimePoint::fromRelativeMs(3600000));
+    mutableMessage.setPayload(payload);
+    return mutableMessage.getImmutableMessage();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    int numberOfMessages = 0;
+    int numberOfRecipients = 0;
+    int numberOfSenders = 0;
+    int payloadSize = 0;
+    std::uint32_t batchMaxMessages = 0;
+    std::uint32_t batchMaxBytes = 0;
+    int batchMaxDelayMs = 0;
+    std::uint32_t maxInflight = 0;
+    int roundTripUs = 0;
+    int publishCostUs = 0;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "messages,n", po::value<int>(&numberOfMessages)->default_value(200000), "messages")(
+            "recipients,r",
+            po::value<int>(&numberOfRecipients)->default_value(16),
+            "number of recipients, each recipient is a separate topic")(
+            "senders,p",
+            po::value<int>(&numberOfSenders)->default_value(4),
+            "number of threads sending messages")(
+            "payload,s", po::value<int>(&payloadSize)->default_value(200), "payload size")(
+            "batchmessages,b",
+            po::value<std::uint32_t>(&batchMaxMessages)->default_value(1),
+            "maximum number of messages per batch, 1 disables batching")(
+            "batchbytes,x",
+            po::value<std::uint32_t>(&batchMaxBytes)->default_value(65536),
+            "maximum size of a batch in bytes")(
+            "batchdelay,d",
+            po::value<int>(&batchMaxDelayMs)->default_value(5),
+            "maximum delay of a message in a batch in milliseconds")(
+            "inflight,i",
+            po::value<std::uint32_t>(&maxInflight)->default_value(20),
+            "maximum number of unacknowledged publishes, 0 is unlimited")(
+            "roundtrip,t",
+            po::value<int>(&roundTripUs)->default_value(500),
+            "round trip time to the broker in microseconds")(
+            "publishcost,c",
+            po::value<int>(&publishCostUs)->default_value(5),
+            "CPU time per publish in microseconds");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || numberOfRecipients <= 0 || numberOfSenders <= 0) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    Settings settings;
+    MessagingSettings messagingSettings(settings);
+    messagingSettings.setMqttPublishBatchMaxMessages(batchMaxMessages);
+    messagingSettings.setMqttPublishBatchMaxBytes(batchMaxBytes);
+    messagingSettings.setMqttPublishBatchMaxDelayMs(std::chrono::milliseconds(batchMaxDelayMs));
+    messagingSettings.setMqttMaxInflightMessages(maxInflight);
+    ClusterControllerSettings ccSettings(settings);
+
+    auto broker = std::make_shared<BrokerStandIn>(messagingSettings,
+                                                  ccSettings,
+                                                  std::chrono::microseconds(roundTripUs),
+                                                  std::chrono::microseconds(publishCostUs));
+    auto mqttSender = std::make_shared<MqttSender>(broker, messagingSettings);
+    const system::RoutingTypes::MqttAddress destination("tcp://localhost:1883", "channel");
+
+    const std::string payload(static_cast<std::size_t>(payloadSize), 'x');
+    std::vector<std::shared_ptr<ImmutableMessage>> messages;
+    for (int i = 0; i < numberOfRecipients; ++i) {
+        messages.push_back(createMessage("recipient" + std::to_string(i), payload));
+    }
+
+    std::atomic<std::uint64_t> failures(0);
+    auto onFailure = [&failures](const exceptions::JoynrRuntimeException&) { failures++; };
+
+    const auto start = Clock::now();
+    std::vector<std::thread> senders;
+    for (int sender = 0; sender < numberOfSenders; ++sender) {
+        senders.emplace_back([&, sender]() {
+            for (int i = sender; i < numberOfMessages; i += numberOfSenders) {
+                mqttSender->sendMessage(destination,
+                                        messages[static_cast<std::size_t>(i % numberOfRecipients)],
+                                        onFailure);
+            }
+        });
+    }
+    for (std::thread& sender : senders) {
+        sender.join();
+    }
+    const auto sent = Clock::now();
+    broker->waitForAcknowledged(static_cast<std::uint64_t>(numberOfMessages) - failures);
+    const auto end = Clock::now();
+    mqttSender.reset();
+
+    auto toSeconds = [](Clock::duration duration) {
+        return static_cast<double>(
+                       std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) /
+               1000000.0;
+    };
+    const std::uint64_t publishes = broker->getPublishes();
+    std::cout << "Batch max messages: " << batchMaxMessages << std::endl;
+    std::cout << "Max inflight: " << maxInflight << std::endl;
+    std::cout << "Messages: " << numberOfMessages << std::endl;
+    std::cout << "Failures: " << failures << std::endl;
+    std::cout << "Publishes: " << publishes << std::endl;
+    std::cout << "Messages per publish: "
+              << static_cast<double>(numberOfMessages) / static_cast<double>(publishes)
+              << std::endl;
+    std::cout << "Send duration (s): " << toSeconds(sent - start) << std::endl;
+    std::cout << "Throughput until acknowledged (msgs/s): "
+              << numberOfMessages / toSeconds(end - start) << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "joynr/BrokerUrl.h"
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Semaphore.h"
+#include "joynr/Settings.h"
+#include "joynr/TimePoint.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/system/RoutingTypes/MqttAddress.h"
+#include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+#include "libjoynrclustercontroller/mqtt/MqttSender.h"
+
+using namespace joynr;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Measures the MQTT publish throughput of MqttSender against a local broker with a
+ * configurable number of additional publish connections. Messages are addressed to a
+ * configurable number of recipients, i.e. topics, and are counted by a separate subscriber
+ * connection. Messages which are delayed because a connection is busy or not yet connected
+ * are retried until they are sent.
+ */
+namespace
+{
+
+bool waitUntil(std::function<bool()> condition, std::chrono::milliseconds timeout)
+{
+    const auto end = Clock::now() + timeout;
+    while (!condition()) {
+        if (Clock::now() > end) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+std::shared_ptr<ImmutableMessage> createMessage(const std::string& recipient,
+                                                const std::string& payload)
+{
+    MutableMessage mutableMessage;
+    mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
+    mutableMessage.setSender("mqtt-publish-throughput");
+    mutableMessage.setRecipient(recipient);
+    mutableMessage.setExpiryDate(TimePoint::fromRelativeMs(3600000));
+    mutableMessage.setPayload(payload);
+    return mutableMessage.getImmutableMessage();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::string brokerUrl;
+    int numberOfMessages = 0;
+    int numberOfRecipients = 0;
+    int payloadSize = 0;
+    std::uint32_t publishConnections = 0;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "broker,b",
+            po::value<std::string>(&brokerUrl)->default_value("tcp://localhost:1883"),
+            "URL of the MQTT broker")(
+            "messages,n", po::value<int>(&numberOfMessages)->default_value(100000), "messages")(
+            "recipients,r",
+            po::value<int>(&numberOfRecipients)->default_value(64),
+            "number of recipients, each recipient is a separate topic")(
+            "payload,s", po::value<int>(&payloadSize)->default_value(200), "payload size")(
+            "connections,c",
+            po::value<std::uint32_t>(&publishConnections)->default_value(0),
+            "additional publish connections, 0 publishes on the receive connection");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help") || numberOfRecipients <= 0) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    Settings settings;
+    MessagingSettings messagingSettings(settings);
+    messagingSettings.setBrokerUrl(BrokerUrl(brokerUrl));
+    messagingSettings.setMqttPublishConnections(publishConnections);
+    ClusterControllerSettings ccSettings(settings);
+
+    const std::string receiverChannelId = "mqtt-publish-throughput-receiver";
+    std::atomic<int> receivedMessages(0);
+    Semaphore allReceived(0);
+    auto receiverConnection = std::make_shared<MosquittoConnection>(
+            messagingSettings, ccSettings, receiverChannelId);
+    receiverConnection->registerChannelId(receiverChannelId);
+    receiverConnection->registerReceiveCallback(
+            [&receivedMessages, &allReceived, numberOfMessages](smrf::ByteVector&&) {
+                if (++receivedMessages == numberOfMessages) {
+                    allReceived.notify();
+                }
+            });
+
+    const std::string senderChannelId = "mqtt-publish-throughput-sender";
+    auto senderConnection =
+            std::make_shared<MosquittoConnection>(messagingSettings, ccSettings, senderChannelId);
+    senderConnection->registerChannelId(senderChannelId);
+    std::vector<std::shared_ptr<MosquittoConnection>> senderPublishConnections;
+    for (std::uint32_t i = 0; i < publishConnections; ++i) {
+        senderPublishConnections.push_back(std::make_shared<MosquittoConnection>(
+                messagingSettings, ccSettings, senderChannelId + "-pub" + std::to_string(i), true));
+    }
+
+    receiverConnection->start();
+    senderConnection->start();
+    for (const auto& connection : senderPublishConnections) {
+        connection->start();
+    }
+
+    const bool connected = waitUntil(
+            [&]() {
+                if (!receiverConnection->isSubscribedToChannelTopic() ||
+                    !senderConnection->isSubscribedToChannelTopic()) {
+                    return false;
+                }
+                for (const auto& connection : senderPublishConnections) {
+                    if (!connection->isReadyToSend()) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            std::chrono::seconds(10));
+    if (!connected) {
+        std::cerr << "unable to connect to broker " << brokerUrl << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    MqttSender mqttSender(senderConnection, messagingSettings, senderPublishConnections);
+    const system::RoutingTypes::MqttAddress destination(brokerUrl, receiverChannelId);
+
+    const std::string payload(static_cast<std::size_t>(payloadSize), 'x');
+    std::vector<std::shared_ptr<ImmutableMessage>> messages;
+    messages.reserve(static_cast<std::size_t>(numberOfRecipients));
+    for (int i = 0; i < numberOfRecipients; ++i) {
+        messages.push_back(createMessage("recipient" + std::to_string(i), payload));
+    }
+
+    std::uint64_t retries = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < numberOfMessages; ++i) {
+        const auto& message = messages[static_cast<std::size_t>(i % numberOfRecipients)];
+        bool sent = false;
+        while (!sent) {
+            sent = true;
+            mqttSender.sendMessage(destination,
+                                   message,
+                                   [&sent](const exceptions::JoynrRuntimeException&) {
+                                       sent = false;
+                                   });
+            if (!sent) {
+                retries++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+    const auto published = Clock::now();
+    const bool complete = allReceived.waitFor(std::chrono::seconds(60));
+    const auto end = Clock::now();
+
+    for (const auto& connection : senderPublishConnections) {
+        connection->stop();
+    }
+    senderConnection->stop();
+    receiverConnection->stop();
+
+    auto toSeconds = [](Clock::duration duration) {
+        return static_cast<double>(
+                       std::chrono::duration_cast<std::chrono::microseconds>(duration).count()) /
+               1000000.0;
+    };
+    std::cout << "Publish connections: " << publishConnections << std::endl;
+    std::cout << "Recipients: " << numberOfRecipients << std::endl;
+    std::cout << "Messages received: " << receivedMessages << " of " << numberOfMessages
+              << std::endl;
+    std::cout << "Send retries: " << retries << std::endl;
+    std::cout << "Publish rate (msgs/s): " << numberOfMessages / toSeconds(published - start)
+              << std::endl;
+    std::cout << "End to end throughput (msgs/s): " << receivedMessages / toSeconds(end - start)
+              << std::endl;
+    return complete ? EXIT_SUCCESS : EXIT_FAILURE;
+}
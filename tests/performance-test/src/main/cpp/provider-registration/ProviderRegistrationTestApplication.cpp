@@ -0,0 +1,250 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "joynr/Future.h"
+#include "joynr/JoynrRuntime.h"
+#include "joynr/Settings.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/types/ProviderQos.h"
+
+#include "../common/Enum.h"
+#include "../common/PerformanceTest.h"
+#include "../provider/PerformanceTestEchoProvider.h"
+
+using namespace joynr;
+
+JOYNR_ENUM(TestCase, (REGISTER_SINGLE)(REGISTER_BATCH));
+
+/**
+ * Registers and unregisters numberOfProviders local providers in an in-process cluster
+ * controller, either with one registerProviderAsync call per provider or in batches of
+ * batchSize providers. The duration of registering and of unregistering all providers is
+ * recorded per run.
+ */
+class ProviderRegistrationTest
+{
+public:
+    ProviderRegistrationTest(std::shared_ptr<JoynrRuntime> runtime,
+                             std::size_t numberOfProviders,
+                             bool persist)
+            : runtime(std::move(runtime)),
+              numberOfProviders(numberOfProviders),
+              persist(persist),
+              provider(std::make_shared<PerformanceTestEchoProvider>())
+    {
+        providerQos.setScope(types::ProviderScope::LOCAL);
+    }
+
+    void registerSingle(std::size_t runs)
+    {
+        std::vector<ClockResolution> registerDurations;
+        std::vector<ClockResolution> unregisterDurations;
+        for (std::size_t run = 0; run < runs; ++run) {
+            std::vector<std::string> participantIds;
+            registerDurations.push_back(measure([this, &participantIds]() {
+                std::vector<std::shared_ptr<Future<void>>> futures;
+                for (std::size_t i = 0; i < numberOfProviders; ++i) {
+                    auto future = std::make_shared<Future<void>>();
+                    participantIds.push_back(
+                            runtime->registerProviderAsync<tests::performance::EchoProvider>(
+                                    domain(i),
+                                    provider,
+                                    providerQos,
+                                    [future]() { future->onSuccess(); },
+                                    onError(future),
+                                    persist));
+                    futures.push_back(std::move(future));
+                }
+                waitFor(futures);
+            }));
+            unregisterDurations.push_back(measure([this, &participantIds]() {
+                std::vector<std::shared_ptr<Future<void>>> futures;
+                for (const std::string& participantId : participantIds) {
+                    auto future = std::make_shared<Future<void>>();
+                    runtime->unregisterProviderAsync(
+                            participantId, [future]() { future->onSuccess(); }, onError(future));
+                    futures.push_back(std::move(future));
+                }
+                waitFor(futures);
+            }));
+        }
+        printStatistics("register", registerDurations);
+        printStatistics("unregister", unregisterDurations);
+    }
+
+    void registerBatch(std::size_t runs, std::size_t batchSize)
+    {
+        std::vector<ClockResolution> registerDurations;
+        std::vector<ClockResolution> unregisterDurations;
+        for (std::size_t run = 0; run < runs; ++run) {
+            std::vector<std::vector<std::string>> participantIdBatches;
+            registerDurations.push_back(measure([this, batchSize, &participantIdBatches]() {
+                std::vector<std::shared_ptr<Future<void>>> futures;
+                for (std::size_t first = 0; first < numberOfProviders; first += batchSize) {
+                    std::vector<ProviderRegistration> registrations;
+                    for (std::size_t i = first; i < std::min(first + batchSize, numberOfProviders);
+                         ++i) {
+                        registrations.push_back(
+                                runtime->createProviderRegistration<
+                                        tests::performance::EchoProvider>(
+                                        domain(i), provider, providerQos));
+                    }
+                    auto future = std::make_shared<Future<void>>();
+                    participantIdBatches.push_back(
+                            runtime->registerProvidersAsync(std::move(registrations),
+                                                            [future]() { future->onSuccess(); },
+                                                            onError(future),
+                                                            persist));
+                    futures.push_back(std::move(future));
+                }
+                waitFor(futures);
+            }));
+            unregisterDurations.push_back(measure([this, &participantIdBatches]() {
+                std::vector<std::shared_ptr<Future<void>>> futures;
+                for (const std::vector<std::string>& participantIds : participantIdBatches) {
+                    auto future = std::make_shared<Future<void>>();
+                    runtime->unregisterProvidersAsync(
+                            participantIds, [future]() { future->onSuccess(); }, onError(future));
+                    futures.push_back(std::move(future));
+                }
+                waitFor(futures);
+            }));
+        }
+        printStatistics("register", registerDurations);
+        printStatistics("unregister", unregisterDurations);
+    }
+
+private:
+    static std::string domain(std::size_t index)
+    {
+        return "performance-registration-domain-" + std::to_string(index);
+    }
+
+    static std::function<void(const exceptions::JoynrRuntimeException&)> onError(
+            std::shared_ptr<Future<void>> future)
+    {
+        return [future](const exceptions::JoynrRuntimeException& error) {
+            future->onError(std::make_shared<exceptions::JoynrRuntimeException>(error));
+        };
+    }
+
+    static void waitFor(const std::vector<std::shared_ptr<Future<void>>>& futures)
+    {
+        for (const auto& future : futures) {
+            future->get();
+        }
+    }
+
+    template <typename Fun>
+    static ClockResolution measure(Fun fun)
+    {
+        const auto start = Clock::now();
+        fun();
+        return std::chrono::duration_cast<ClockResolution>(Clock::now() - start);
+    }
+
+    void printStatistics(const std::string& operation,
+                         const std::vector<ClockResolution>& durations) const
+    {
+        using DoubleMilliSeconds = std::chrono::duration<double, std::milli>;
+        ClockResolution total(0);
+        for (const ClockResolution& duration : durations) {
+            total += duration;
+        }
+        const double meanMs =
+                std::chrono::duration_cast<DoubleMilliSeconds>(total).count() / durations.size();
+        std::cerr << operation << " " << numberOfProviders << " providers:\t" << meanMs
+                  << " [ms], " << (numberOfProviders * 1000.0 / meanMs) << " providers/sec"
+                  << std::endl;
+    }
+
+    std::shared_ptr<JoynrRuntime> runtime;
+    const std::size_t numberOfProviders;
+    const bool persist;
+    std::shared_ptr<PerformanceTestEchoProvider> provider;
+    types::ProviderQos providerQos;
+};
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::size_t runs;
+    std::size_t numberOfProviders;
+    std::size_t batchSize;
+    bool persist;
+    std::string settingsFile;
+    TestCase testCase;
+
+    po::options_description desc("Available options");
+    desc.add_options()("help,h", "produce help message")(
+            "runs,r", po::value(&runs)->default_value(5), "number of runs")(
+            "providers,p",
+            po::value(&numberOfProviders)->default_value(2000),
+            "number of providers registered per run")(
+            "batchSize,b", po::value(&batchSize)->default_value(500), "providers per batch")(
+            "persist", po::value(&persist)->default_value(true), "persist participantIds")(
+            "settings,s",
+            po::value(&settingsFile)->required(),
+            "settings file of the cluster controller")(
+            "testCase,t", po::value(&testCase)->required(), "REGISTER_SINGLE|REGISTER_BATCH");
+
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+        po::notify(vm);
+        if (runs == 0 || numberOfProviders == 0 || batchSize == 0) {
+            std::cerr << "runs, providers and batchSize must be greater than 0" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::shared_ptr<JoynrRuntime> runtime =
+                JoynrRuntime::createRuntime(std::make_unique<Settings>(settingsFile));
+        ProviderRegistrationTest test(runtime, numberOfProviders, persist);
+
+        switch (testCase) {
+        case TestCase::REGISTER_SINGLE:
+            test.registerSingle(runs);
+            break;
+        case TestCase::REGISTER_BATCH:
+            test.registerBatch(runs, batchSize);
+            break;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "joynr/DiscoveryQos.h"
+#include "joynr/JoynrRuntime.h"
+#include "joynr/ProxyBuilder.h"
+#include "joynr/Settings.h"
+#include "joynr/tests/performance/EchoProxy.h"
+#include "joynr/types/ProviderQos.h"
+
+#include "../common/Enum.h"
+#include "../common/PerformanceTest.h"
+#include "../provider/PerformanceTestEchoProvider.h"
+
+using namespace joynr;
+
+JOYNR_ENUM(TestCase, (BUILD_FIXED_PARTICIPANT)(BUILD_ARBITRATED));
+
+/**
+ * Builds and discards numberOfProxies proxies for a provider registered at an in-process
+ * cluster controller, either with the fixed participant arbitration strategy or by arbitrating
+ * domain and interface. The duration of building each proxy is recorded.
+ */
+void buildProxies(std::shared_ptr<JoynrRuntime> runtime,
+                  const std::string& domain,
+                  const DiscoveryQos& discoveryQos,
+                  std::size_t numberOfProxies)
+{
+    std::vector<ClockResolution> durations;
+    durations.reserve(numberOfProxies);
+    const auto startLoop = Clock::now();
+    for (std::size_t i = 0; i < numberOfProxies; ++i) {
+        const auto start = Clock::now();
+        auto proxy = runtime->createProxyBuilder<tests::performance::EchoProxy>(domain)
+                             ->setDiscoveryQos(discoveryQos)
+                             ->build();
+        durations.push_back(std::chrono::duration_cast<ClockResolution>(Clock::now() - start));
+    }
+    const auto totalDuration =
+            std::chrono::duration_cast<ClockResolution>(Clock::now() - startLoop);
+    std::cerr << "proxies/sec: " << numberOfProxies * 1e6 / totalDuration.count() << std::endl;
+    PerformanceTest::printStatistics(durations, totalDuration);
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::size_t numberOfProxies;
+    std::string settingsFile;
+    TestCase testCase;
+
+    po::options_description desc("Available options");
+    desc.add_options()("help,h", "produce help message")(
+            "proxies,p", po::value(&numberOfProxies)->default_value(1000), "number of proxies")(
+            "settings,s",
+            po::value(&settingsFile)->required(),
+            "settings file of the cluster controller")(
+            "testCase,t",
+            po::value(&testCase)->required(),
+            "BUILD_FIXED_PARTICIPANT|BUILD_ARBITRATED");
+
+    try {
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help")) {
+            std::cout << desc << std::endl;
+            return EXIT_SUCCESS;
+        }
+        po::notify(vm);
+
+        std::shared_ptr<JoynrRuntime> runtime =
+                JoynrRuntime::createRuntime(std::make_unique<Settings>(settingsFile));
+
+        const std::string domain("performance-proxy-creation-domain");
+        auto provider = std::make_shared<PerformanceTestEchoProvider>();
+        types::ProviderQos providerQos;
+        providerQos.setScope(types::ProviderScope::LOCAL);
+        const std::string participantId =
+                runtime->registerProvider<tests::performance::EchoProvider>(
+                        domain, provider, providerQos);
+
+        DiscoveryQos discoveryQos;
+        switch (testCase) {
+        case TestCase::BUILD_FIXED_PARTICIPANT:
+            discoveryQos.setArbitrationStrategy(
+                    DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT);
+            discoveryQos.addCustomParameter("fixedParticipantId", participantId);
+            break;
+        case TestCase::BUILD_ARBITRATED:
+            discoveryQos.setCacheMaxAgeMs(std::numeric_limits<std::int64_t>::max());
+            discoveryQos.setArbitrationStrategy(
+                    DiscoveryQos::ArbitrationStrategy::HIGHEST_PRIORITY);
+            break;
+        }
+
+        buildProxies(runtime, domain, discoveryQos, numberOfProxies);
+
+        runtime->unregisterProvider<tests::performance::EchoProvider>(domain, provider);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
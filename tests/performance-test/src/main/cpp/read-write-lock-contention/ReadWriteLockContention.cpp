@@ -0,0 +1,176 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/thread/locks.hpp>
+#include <boost/thread/shared_mutex.hpp>
+
+#include "joynr/DistributedReadWriteLock.h"
+#include "joynr/ShutdownGuard.h"
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Reader threads look up entries of a routing-table-like map under a read lock while a single
+ * writer updates an entry every writeInterval. Prints the read throughput of all readers and
+ * the average time the writer needed to acquire the lock.
+ */
+template <typename Lock>
+void runMapLookups(const std::string& lockName,
+                   std::size_t numberOfReaders,
+                   std::chrono::milliseconds duration,
+                   std::chrono::microseconds writeInterval)
+{
+    const std::size_t numberOfEntries = 1000;
+    std::unordered_map<std::size_t, std::string> routingTable;
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        routingTable[i] = "participant-" + std::to_string(i);
+    }
+    Lock lock;
+
+    std::atomic<bool> running(true);
+    std::atomic<std::uint64_t> totalReads(0);
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < numberOfReaders; ++i) {
+        readers.emplace_back([&, i]() {
+            std::uint64_t reads = 0;
+            std::size_t foundSize = 0;
+            std::size_t key = i;
+            while (running.load(std::memory_order_relaxed)) {
+                boost::shared_lock<Lock> locker(lock);
+                auto entry = routingTable.find(key);
+                if (entry != routingTable.cend()) {
+                    foundSize += entry->second.size();
+                }
+                key = (key + 7) % numberOfEntries;
+                ++reads;
+            }
+            totalReads += reads + (foundSize == 0 ? 1 : 0);
+        });
+    }
+
+    std::uint64_t writes = 0;
+    Clock::duration writeWaitTime(0);
+    const auto start = Clock::now();
+    while (Clock::now() - start < duration) {
+        std::this_thread::sleep_for(writeInterval);
+        const auto writeStart = Clock::now();
+        boost::unique_lock<Lock> locker(lock);
+        writeWaitTime += Clock::now() - writeStart;
+        routingTable[writes % numberOfEntries] = "participant-" + std::to_string(writes);
+        ++writes;
+    }
+    running = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+    std::cerr << "Testcase: MAP_LOOKUPS(" << lockName << ", readers=" << numberOfReaders << ")"
+              << std::endl;
+    std::cerr << "reads/s: " << static_cast<double>(totalReads) / elapsed.count() << std::endl;
+    std::cerr << "average write lock wait [us]: "
+              << std::chrono::duration<double, std::micro>(writeWaitTime).count() /
+                         std::max<std::uint64_t>(writes, 1)
+              << std::endl;
+}
+
+/**
+ * Reader threads repeatedly pass the shutdown check of the Dispatcher, either as flag protected
+ * by a boost::shared_mutex or as ShutdownGuard. Prints the number of checks per second.
+ */
+void runShutdownChecks(const std::string& name,
+                       std::size_t numberOfReaders,
+                       std::chrono::milliseconds duration,
+                       std::function<bool()> enter)
+{
+    std::atomic<bool> running(true);
+    std::atomic<std::uint64_t> totalChecks(0);
+    std::vector<std::thread> readers;
+    for (std::size_t i = 0; i < numberOfReaders; ++i) {
+        readers.emplace_back([&]() {
+            std::uint64_t checks = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                if (enter()) {
+                    ++checks;
+                }
+            }
+            totalChecks += checks;
+        });
+    }
+    const auto start = Clock::now();
+    std::this_thread::sleep_for(duration);
+    running = false;
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+    std::cerr << "Testcase: SHUTDOWN_CHECKS(" << name << ", readers=" << numberOfReaders << ")"
+              << std::endl;
+    std::cerr << "checks/s: " << static_cast<double>(totalChecks) / elapsed.count() << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::chrono::milliseconds duration(1000);
+    if (argc > 1) {
+        duration = std::chrono::milliseconds(std::stoul(argv[1]));
+    }
+    const std::chrono::microseconds writeInterval(1000);
+    const std::size_t maxReaders = std::max(2u, std::thread::hardware_concurrency());
+
+    std::vector<std::size_t> numbersOfReaders;
+    for (std::size_t numberOfReaders = 1; numberOfReaders <= maxReaders; numberOfReaders *= 2) {
+        numbersOfReaders.push_back(numberOfReaders);
+    }
+
+    for (std::size_t numberOfReaders : numbersOfReaders) {
+        runMapLookups<boost::shared_mutex>(
+                "boost::shared_mutex", numberOfReaders, duration, writeInterval);
+        runMapLookups<joynr::DistributedReadWriteLock>(
+                "DistributedReadWriteLock", numberOfReaders, duration, writeInterval);
+    }
+
+    for (std::size_t numberOfReaders : numbersOfReaders) {
+        bool isShuttingDown = false;
+        boost::shared_mutex isShuttingDownLock;
+        runShutdownChecks("boost::shared_mutex", numberOfReaders, duration, [&]() {
+            boost::shared_lock<boost::shared_mutex> locker(isShuttingDownLock);
+            return !isShuttingDown;
+        });
+
+        joynr::ShutdownGuard shutdownGuard;
+        runShutdownChecks("ShutdownGuard", numberOfReaders, duration, [&]() {
+            joynr::ShutdownGuard::Pass pass = shutdownGuard.enter();
+            return static_cast<bool>(pass);
+        });
+        shutdownGuard.shutdown();
+    }
+    return 0;
+}
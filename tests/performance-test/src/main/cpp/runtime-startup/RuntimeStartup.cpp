@@ -0,0 +1,88 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "joynr/JoynrClusterControllerRuntime.h"
+#include "joynr/Settings.h"
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void printStatistics(const std::string& phase, std::vector<double> durationsMs)
+{
+    std::sort(durationsMs.begin(), durationsMs.end());
+    double sum = 0;
+    for (double durationMs : durationsMs) {
+        sum += durationMs;
+    }
+    std::cerr << phase << ":\tmin " << durationsMs.front() << " [ms], median "
+              << durationsMs[durationsMs.size() / 2] << " [ms], mean "
+              << sum / durationsMs.size() << " [ms]" << std::endl;
+}
+
+/**
+ * Repeatedly creates and shuts down a cluster controller runtime with the given settings file and
+ * prints the time needed by create (persistence loading, registration of the internal providers
+ * and start of the local and external transports) and by shutdown. The persistence files of the
+ * settings are kept between iterations so that every iteration after the first one measures a
+ * warm start; the durations of the individual startup stages are logged at DEBUG level.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <cluster-controller settings file> [iterations]"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string settingsFile(argv[1]);
+    const std::size_t iterations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10;
+
+    std::vector<double> createMs;
+    std::vector<double> shutdownMs;
+    try {
+        for (std::size_t i = 0; i < std::max<std::size_t>(iterations, 1); ++i) {
+            auto start = Clock::now();
+            auto runtime = joynr::JoynrClusterControllerRuntime::create(
+                    std::make_unique<joynr::Settings>(settingsFile));
+            createMs.push_back(elapsedMs(start));
+
+            start = Clock::now();
+            runtime->shutdown();
+            shutdownMs.push_back(elapsedMs(start));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cerr << "Testcase: RUNTIME_STARTUP(" << settingsFile << ")" << std::endl;
+    printStatistics("create", createMs);
+    printStatistics("shutdown", shutdownMs);
+    return EXIT_SUCCESS;
+}
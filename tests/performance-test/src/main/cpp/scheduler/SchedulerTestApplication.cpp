@@ -0,0 +1,277 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "joynr/IMessagingStub.h"
+#include "joynr/IMiddlewareMessagingStubFactory.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/LibJoynrMessageRouter.h"
+#include "joynr/Message.h"
+#include "joynr/MessageQueue.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/MessagingStubFactory.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Settings.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/WebSocketMulticastAddressCalculator.h"
+#include "joynr/system/RoutingTypes/WebSocketAddress.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+
+#include "../common/PerformanceTest.h"
+
+using namespace joynr;
+
+/**
+ * Records when each message has been routed and how long it waited until it was transmitted.
+ */
+class LatencyRecorder
+{
+public:
+    LatencyRecorder()
+            : mutex(),
+              repliesTransmitted(),
+              routedAt(),
+              replyLatencies(),
+              publicationLatencies()
+    {
+    }
+
+    void onRouted(const std::string& messageId)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        routedAt.emplace(messageId, Clock::now());
+    }
+
+    void onTransmitted(const ImmutableMessage& message)
+    {
+        const auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = routedAt.find(message.getId());
+        if (it == routedAt.end()) {
+            return;
+        }
+        const auto latency = std::chrono::duration_cast<ClockResolution>(now - it->second);
+        routedAt.erase(it);
+        if (message.getType() == Message::VALUE_MESSAGE_TYPE_REPLY()) {
+            replyLatencies.push_back(latency);
+            repliesTransmitted.notify_one();
+        } else {
+            publicationLatencies.push_back(latency);
+        }
+    }
+
+    void waitForReplies(std::size_t numberOfReplies)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        repliesTransmitted.wait(lock, [&] { return replyLatencies.size() >= numberOfReplies; });
+    }
+
+    std::vector<ClockResolution> getReplyLatencies()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return replyLatencies;
+    }
+
+    std::vector<ClockResolution> getPublicationLatencies()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return publicationLatencies;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable repliesTransmitted;
+    std::unordered_map<std::string, Clock::time_point> routedAt;
+    std::vector<ClockResolution> replyLatencies;
+    std::vector<ClockResolution> publicationLatencies;
+};
+
+/**
+ * Busy-waits for a fixed "transmit" time, i.e. the time needed to hand the message to the
+ * transport, on the thread of the message router.
+ */
+class TransmitDelayMessagingStub : public IMessagingStub
+{
+public:
+    TransmitDelayMessagingStub(std::shared_ptr<LatencyRecorder> recorder,
+                               std::chrono::microseconds transmitDuration)
+            : recorder(std::move(recorder)), transmitDuration(transmitDuration)
+    {
+    }
+
+    void transmit(std::shared_ptr<ImmutableMessage> message,
+                  const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override
+    {
+        std::ignore = onFailure;
+        const auto start = Clock::now();
+        recorder->onTransmitted(*message);
+        while (Clock::now() - start < transmitDuration) {
+            // simulate the time needed to hand the message to the transport
+        }
+    }
+
+private:
+    const std::shared_ptr<LatencyRecorder> recorder;
+    const std::chrono::microseconds transmitDuration;
+};
+
+class TransmitDelayMessagingStubFactory : public IMiddlewareMessagingStubFactory
+{
+public:
+    TransmitDelayMessagingStubFactory(std::shared_ptr<LatencyRecorder> recorder,
+                                      std::chrono::microseconds transmitDuration)
+            : stub(std::make_shared<TransmitDelayMessagingStub>(std::move(recorder),
+                                                                transmitDuration))
+    {
+    }
+
+    std::shared_ptr<IMessagingStub> create(
+            const system::RoutingTypes::Address& destAddress) override
+    {
+        std::ignore = destAddress;
+        return stub;
+    }
+
+    bool canCreate(const system::RoutingTypes::Address& destAddress) override
+    {
+        return dynamic_cast<const system::RoutingTypes::WebSocketAddress*>(&destAddress) !=
+               nullptr;
+    }
+
+    void registerOnMessagingStubClosedCallback(
+            std::function<void(std::shared_ptr<const system::RoutingTypes::Address>
+                                       destinationAddress)> onMessagingStubClosedCallback) override
+    {
+        std::ignore = onMessagingStubClosedCallback;
+    }
+
+private:
+    const std::shared_ptr<IMessagingStub> stub;
+};
+
+std::shared_ptr<ImmutableMessage> createMessage(const std::string& type, std::int64_t ttlMs)
+{
+    MutableMessage message;
+    message.setType(type);
+    message.setSender("sender");
+    message.setRecipient("recipient");
+    message.setExpiryDate(TimePoint::fromRelativeMs(ttlMs));
+    message.setPayload(std::string(100, 'x'));
+    return message.getImmutableMessage();
+}
+
+/**
+ * Measures how long replies and publications wait in the message router of a libjoynr runtime
+ * until they are transmitted while a flood of publications is routed concurrently.
+ */
+void runReplyLatencyUnderPublicationFlood(std::size_t numberOfReplies,
+                                          std::size_t publicationsPerReply,
+                                          std::chrono::microseconds transmitDuration)
+{
+    auto singleThreadedIOService = std::make_shared<SingleThreadedIOService>();
+    singleThreadedIOService->start();
+    Settings settings;
+    MessagingSettings messagingSettings(settings);
+    auto recorder = std::make_shared<LatencyRecorder>();
+    auto messagingStubFactory = std::make_shared<MessagingStubFactory>();
+    messagingStubFactory->registerStubFactory(
+            std::make_shared<TransmitDelayMessagingStubFactory>(recorder, transmitDuration));
+    auto destinationAddress = std::make_shared<const system::RoutingTypes::WebSocketAddress>(
+            system::RoutingTypes::WebSocketProtocol::Enum::WS, "localhost", 4242, "");
+
+    auto messageRouter = std::make_shared<LibJoynrMessageRouter>(
+            messagingSettings,
+            std::make_shared<const system::RoutingTypes::WebSocketClientAddress>("client"),
+            messagingStubFactory,
+            singleThreadedIOService->getIOService(),
+            std::make_unique<WebSocketMulticastAddressCalculator>(destinationAddress),
+            false,
+            std::vector<std::shared_ptr<ITransportStatus>>{},
+            std::make_unique<MessageQueue<std::string>>(),
+            std::make_unique<MessageQueue<std::shared_ptr<ITransportStatus>>>());
+    messageRouter->init();
+    messageRouter->addNextHop("recipient",
+                              destinationAddress,
+                              false,
+                              std::numeric_limits<std::int64_t>::max(),
+                              true);
+
+    auto route = [&](std::shared_ptr<ImmutableMessage> message) {
+        recorder->onRouted(message->getId());
+        messageRouter->route(std::move(message));
+    };
+
+    std::atomic_bool flooding(true);
+    const auto startLoop = Clock::now();
+    std::thread publisher([&]() {
+        while (flooding) {
+            for (std::size_t i = 0; i < publicationsPerReply; ++i) {
+                route(createMessage(Message::VALUE_MESSAGE_TYPE_PUBLICATION(), 3600000));
+            }
+            std::this_thread::sleep_for(transmitDuration * publicationsPerReply);
+        }
+    });
+
+    // replies are sent at a rate the message router could handle on its own
+    for (std::size_t i = 0; i < numberOfReplies; ++i) {
+        route(createMessage(Message::VALUE_MESSAGE_TYPE_REPLY(), 60000));
+        std::this_thread::sleep_for(transmitDuration * 10);
+    }
+
+    recorder->waitForReplies(numberOfReplies);
+    const auto endLoop = Clock::now();
+    flooding = false;
+    publisher.join();
+    messageRouter->shutdown();
+    singleThreadedIOService->stop();
+
+    const auto totalDuration = std::chrono::duration_cast<ClockResolution>(endLoop - startLoop);
+    std::cerr << "Testcase: REPLY_LATENCY_UNDER_PUBLICATION_FLOOD" << std::endl;
+    PerformanceTest::printStatistics(recorder->getReplyLatencies(), totalDuration);
+    // publications have a far deadline and the lowest priority, they must not starve
+    std::cerr << "Testcase: PUBLICATION_LATENCY_UNDER_PUBLICATION_FLOOD" << std::endl;
+    PerformanceTest::printStatistics(recorder->getPublicationLatencies(), totalDuration);
+}
+
+int main()
+{
+    const std::size_t numberOfReplies = 1000;
+    // together with the replies the publisher offers slightly more load than the outbound
+    // thread is able to transmit, so the queue keeps growing during the test
+    const std::size_t publicationsPerReply = 2;
+    const std::chrono::microseconds transmitDuration(50);
+
+    runReplyLatencyUnderPublicationFlood(numberOfReplies, publicationsPerReply, transmitDuration);
+    return 0;
+}
@@ -26,6 +26,7 @@
 #include <boost/type_index.hpp>
 
 #include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
 #include "joynr/MessagingQos.h"
 #include "joynr/MutableMessage.h"
 #include "joynr/Request.h"
@@ -105,6 +106,40 @@ public:
         runAndPrintAverage(runs, getTestName("full message deserialization"), fun);
     }
 
+    /**
+     * @brief decodes a routable message and reads all headers used by router and dispatcher;
+     * msg/sec is the number of messages decoded per second
+     */
+    void runMessageHeaderDecodingBenchmark() const
+    {
+        joynr::MutableMessage mutableMessage = createMessage();
+        mutableMessage.setSender(senderParticipantId);
+        mutableMessage.setRecipient(receiverParticipantId);
+        mutableMessage.setReplyTo("{\"_typeName\":\"joynr.system.RoutingTypes.MqttAddress\"}");
+        mutableMessage.setEffort("BEST_EFFORT");
+        mutableMessage.setPrefixedCustomHeaders(
+                {{joynr::Message::CUSTOM_HEADER_PREFIX() + "trace-id", "0123456789"}});
+        std::unique_ptr<joynr::ImmutableMessage> immutableMessage =
+                mutableMessage.getImmutableMessage();
+        const smrf::ByteVector& rawMessage = immutableMessage->getSerializedMessage();
+        auto fun = [&rawMessage]() {
+            joynr::ImmutableMessage deserializedMessage(rawMessage);
+            std::size_t headerBytes = deserializedMessage.getSender().size() +
+                                      deserializedMessage.getRecipient().size() +
+                                      deserializedMessage.getType().size() +
+                                      deserializedMessage.getId().size();
+            if (auto replyTo = deserializedMessage.getReplyToView()) {
+                headerBytes += replyTo->size();
+            }
+            if (auto effort = deserializedMessage.getEffortView()) {
+                headerBytes += effort->size();
+            }
+            return headerBytes;
+        };
+
+        runAndPrintAverage(runs, getTestName("message header decoding"), fun);
+    }
+
 private:
     joynr::MutableMessage createMessage() const
     {
@@ -42,9 +42,16 @@ int main()
 
         test.runFullMessageSerializationBenchmark();
         test.template runFullMessageDeSerializationBenchmark<ParamType>();
+
+        test.runMessageHeaderDecodingBenchmark();
     };
 
     boost::fusion::for_each(Generators(), fun);
 
+    // small, high-rate messages (e.g. telemetry) where allocations dominate the serialization
+    std::size_t smallLength = 50;
+    SerializerPerformanceTest<String> smallMessageTest(runs, smallLength);
+    smallMessageTest.runFullMessageSerializationBenchmark();
+
     return 0;
 }
@@ -0,0 +1,260 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+#include <websocketpp/client.hpp>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+
+#include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shm/ShmChannel.h"
+#include "libjoynr/shm/ShmSegment.h"
+
+using namespace joynr;
+using Client = websocketpp::client<websocketpp::config::asio_client>;
+using Clock = std::chrono::high_resolution_clock;
+
+/**
+ * Measures the round trip time of single messages (one message in flight at a time) through a
+ * shared memory channel, or through a loopback WebSocket connection to websocket-server-echo.
+ * The payload equals the one of websocket-client-echo.
+ */
+namespace
+{
+
+const std::string payload(R"({)"
+                          R"("_typeName":"joynr.types.TestTypes.TStructExtended",)"
+                          R"("tDouble":0.123456789,)"
+                          R"("tInt64":64,)"
+                          R"("tString":"myTestString",)"
+                          R"("tEnum":"TLITERALA",)"
+                          R"("tInt32":32)"
+                          R"(})");
+
+void printStatistics(std::vector<std::chrono::nanoseconds>& roundTripTimes)
+{
+    if (roundTripTimes.empty()) {
+        std::cout << "no round trips measured" << std::endl;
+        return;
+    }
+    std::sort(roundTripTimes.begin(), roundTripTimes.end());
+    auto toUs = [](std::chrono::nanoseconds duration) {
+        return static_cast<double>(duration.count()) / 1000.0;
+    };
+    const std::size_t count = roundTripTimes.size();
+    std::cout << "Round trips: " << count << std::endl;
+    std::cout << "Min (us): " << toUs(roundTripTimes.front()) << std::endl;
+    std::cout << "Median (us): " << toUs(roundTripTimes[count / 2]) << std::endl;
+    std::cout << "P99 (us): " << toUs(roundTripTimes[count * 99 / 100]) << std::endl;
+    std::cout << "Max (us): " << toUs(roundTripTimes.back()) << std::endl;
+}
+
+// runs in a child process and plays the role of the cluster controller
+int runSharedMemoryEcho(const std::string& segmentName)
+{
+    std::shared_ptr<ShmChannel> channel;
+    try {
+        auto segment = ShmSegment::open(segmentName);
+        segment->unlink();
+        segment->markAttached();
+        channel = std::make_shared<ShmChannel>(
+                std::move(segment), ShmChannel::Side::ClusterController, nullptr);
+    } catch (const exceptions::JoynrRuntimeException& e) {
+        std::cout << e.getMessage() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Semaphore peerClosed(0);
+    channel->start([&channel, &peerClosed](smrf::ByteVector&& message) {
+        channel->send(smrf::ByteArrayView(message),
+                      [&peerClosed](const exceptions::JoynrRuntimeException&) {
+                          peerClosed.notify();
+                      });
+    });
+    while (channel->isConnected()) {
+        peerClosed.waitFor(std::chrono::milliseconds(100));
+    }
+    channel->stop();
+    return EXIT_SUCCESS;
+}
+
+int measureSharedMemory(int numberOfMessages, std::uint64_t ringSize)
+{
+    const std::string segmentName =
+            ShmSegment::NAME_PREFIX() + "latency-" + std::to_string(::getpid());
+    std::unique_ptr<ShmSegment> segment;
+    try {
+        segment = ShmSegment::create(segmentName, ringSize);
+    } catch (const exceptions::JoynrRuntimeException& e) {
+        std::cout << e.getMessage() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // fork before any thread is started
+    const pid_t echoProcess = fork();
+    if (echoProcess < 0) {
+        std::cout << "fork failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (echoProcess == 0) {
+        segment.release(); // the mapping is owned by the parent process
+        std::_Exit(runSharedMemoryEcho(segmentName));
+    }
+
+    if (!segment->waitForAttached(std::chrono::seconds(5))) {
+        std::cout << "echo process did not attach" << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto channel =
+            std::make_shared<ShmChannel>(std::move(segment), ShmChannel::Side::LibJoynr, nullptr);
+    Semaphore echoReceived(0);
+    channel->start([&echoReceived](smrf::ByteVector&&) { echoReceived.notify(); });
+
+    const smrf::ByteVector message(payload.cbegin(), payload.cend());
+    auto onFailure = [](const exceptions::JoynrRuntimeException& e) {
+        std::cout << "Failed to send message: " << e.getMessage() << std::endl;
+    };
+    std::vector<std::chrono::nanoseconds> roundTripTimes;
+    roundTripTimes.reserve(static_cast<std::size_t>(numberOfMessages));
+    for (int i = 0; i < numberOfMessages; i++) {
+        const auto sent = Clock::now();
+        channel->send(smrf::ByteArrayView(message), onFailure);
+        if (!echoReceived.waitFor(std::chrono::seconds(5))) {
+            std::cout << "no echo received" << std::endl;
+            break;
+        }
+        roundTripTimes.push_back(Clock::now() - sent);
+    }
+
+    channel->stop();
+    waitpid(echoProcess, nullptr, 0);
+    printStatistics(roundTripTimes);
+    return EXIT_SUCCESS;
+}
+
+int measureWebSocket(int numberOfMessages, const std::string& hostAddress, int port)
+{
+    Client client;
+    client.init_asio();
+    client.clear_access_channels(websocketpp::log::alevel::all);
+    client.clear_error_channels(websocketpp::log::alevel::all);
+
+    Semaphore connected(0);
+    Semaphore echoReceived(0);
+    client.set_open_handler([&connected](websocketpp::connection_hdl) { connected.notify(); });
+    client.set_message_handler(
+            [&echoReceived](websocketpp::connection_hdl, Client::message_ptr) {
+                echoReceived.notify();
+            });
+
+    websocketpp::lib::error_code errorCode;
+    websocketpp::uri hostUri(false, hostAddress, port, std::string(""));
+    auto connection = client.get_connection(hostUri.str(), errorCode);
+    if (errorCode) {
+        std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+    client.connect(connection);
+    std::thread clientThread(&Client::run, &client);
+
+    std::vector<std::chrono::nanoseconds> roundTripTimes;
+    if (connected.waitFor(std::chrono::seconds(5))) {
+        roundTripTimes.reserve(static_cast<std::size_t>(numberOfMessages));
+        for (int i = 0; i < numberOfMessages; i++) {
+            const auto sent = Clock::now();
+            client.send(connection, payload, websocketpp::frame::opcode::binary, errorCode);
+            if (errorCode || !echoReceived.waitFor(std::chrono::seconds(5))) {
+                std::cout << "no echo received" << std::endl;
+                break;
+            }
+            roundTripTimes.push_back(Clock::now() - sent);
+        }
+        client.close(connection, websocketpp::close::status::normal, std::string(""), errorCode);
+    } else {
+        std::cout << "Failed to connect to websocket-server-echo" << std::endl;
+        client.stop();
+    }
+    clientThread.join();
+
+    printStatistics(roundTripTimes);
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::string transport;
+    int numberOfMessages = 0;
+    std::uint64_t ringSize = 0;
+    std::string hostAddress;
+    int port = 0;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "transport,t",
+            po::value<std::string>(&transport)->default_value("shm"),
+            "shm or websocket (requires a running websocket-server-echo)")(
+            "numberofmessages,n",
+            po::value<int>(&numberOfMessages)->default_value(10000),
+            "number of round trips")(
+            "ringsize,r",
+            po::value<std::uint64_t>(&ringSize)->default_value(1024 * 1024),
+            "size of each shared memory ring in bytes")(
+            "hostaddress,h",
+            po::value<std::string>(&hostAddress)->default_value("localhost"),
+            "address of websocket-server-echo")(
+            "port,p", po::value<int>(&port)->default_value(4220), "port of websocket-server-echo");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    if (transport == "shm") {
+        return measureSharedMemory(numberOfMessages, ringSize);
+    }
+    if (transport == "websocket") {
+        return measureWebSocket(numberOfMessages, hostAddress, port);
+    }
+    std::cout << "unknown transport: " << transport << std::endl;
+    return EXIT_FAILURE;
+}
@@ -91,6 +91,22 @@ public:
         return addAsync(discoveryEntry, onSuccess, onRuntimeError, qos);
     }
 
+    std::shared_ptr<joynr::Future<void>> addAsync(
+            const std::vector<joynr::types::DiscoveryEntry>& discoveryEntries,
+            const bool& awaitGlobalRegistration,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                    onRuntimeError = nullptr,
+            boost::optional<MessagingQos> qos = boost::none) noexcept override
+    {
+        std::ignore = awaitGlobalRegistration;
+        std::ignore = onRuntimeError;
+        if (!discoveryEntries.empty()) {
+            entry = discoveryEntries.back();
+        }
+        return resolve(onSuccess);
+    }
+
     std::shared_ptr<joynr::Future<std::vector<joynr::types::DiscoveryEntryWithMetaInfo>>>
     lookupAsync(
             const std::vector<std::string>& domains,
@@ -128,6 +144,16 @@ public:
         return resolve(onSuccess);
     }
 
+    std::shared_ptr<joynr::Future<void>> removeAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess = nullptr,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
+                    onRuntimeError = nullptr,
+            boost::optional<MessagingQos> qos = boost::none) noexcept override
+    {
+        return resolve(onSuccess);
+    }
+
 private:
     joynr::types::DiscoveryEntry entry;
 };
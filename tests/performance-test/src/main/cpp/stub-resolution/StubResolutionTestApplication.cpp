@@ -0,0 +1,177 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "joynr/CachedMessagingStub.h"
+#include "joynr/IMessagingStub.h"
+#include "joynr/IMiddlewareMessagingStubFactory.h"
+#include "joynr/MessagingStubFactory.h"
+#include "joynr/RoutingTable.h"
+#include "joynr/system/RoutingTypes/MqttAddress.h"
+
+#include "../common/PerformanceTest.h"
+
+using namespace joynr;
+
+class NoOpMessagingStub : public IMessagingStub
+{
+public:
+    void transmit(std::shared_ptr<ImmutableMessage> message,
+                  const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+            override
+    {
+        std::ignore = message;
+        std::ignore = onFailure;
+    }
+};
+
+class NoOpMessagingStubFactory : public IMiddlewareMessagingStubFactory
+{
+public:
+    std::shared_ptr<IMessagingStub> create(
+            const system::RoutingTypes::Address& destAddress) override
+    {
+        std::ignore = destAddress;
+        return std::make_shared<NoOpMessagingStub>();
+    }
+
+    bool canCreate(const system::RoutingTypes::Address& destAddress) override
+    {
+        return dynamic_cast<const system::RoutingTypes::MqttAddress*>(&destAddress) != nullptr;
+    }
+
+    void registerOnMessagingStubClosedCallback(
+            std::function<void(std::shared_ptr<const system::RoutingTypes::Address>
+                                       destinationAddress)> onMessagingStubClosedCallback) override
+    {
+        std::ignore = onMessagingStubClosedCallback;
+    }
+};
+
+/**
+ * Every thread resolves the routing entry and then the messaging stub of a destination, as
+ * done by the message router for every routed message. The latency of each batch is recorded.
+ */
+template <typename ResolveFun>
+void runResolutions(const std::string& testCase,
+                    const RoutingTable& routingTable,
+                    std::size_t numberOfThreads,
+                    std::size_t numberOfParticipants,
+                    std::size_t batchesPerThread,
+                    ResolveFun resolve)
+{
+    const std::size_t resolutionsPerBatch = 1000;
+    std::vector<std::string> participantIds;
+    for (std::size_t i = 0; i < numberOfParticipants; ++i) {
+        participantIds.push_back("participantId" + std::to_string(i));
+    }
+
+    std::vector<std::vector<ClockResolution>> durations(numberOfThreads);
+    std::atomic<std::size_t> resolved(0);
+    const auto startLoop = Clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < numberOfThreads; ++thread) {
+        threads.emplace_back([&, thread]() {
+            std::size_t localResolved = 0;
+            durations[thread].reserve(batchesPerThread);
+            for (std::size_t batch = 0; batch < batchesPerThread; ++batch) {
+                const auto start = Clock::now();
+                for (std::size_t i = 0; i < resolutionsPerBatch; ++i) {
+                    const std::size_t index = thread * 7919 + batch * resolutionsPerBatch + i;
+                    const auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(
+                            participantIds[index % numberOfParticipants]);
+                    localResolved += resolve(*routingEntry) ? 1 : 0;
+                }
+                durations[thread].push_back(
+                        std::chrono::duration_cast<ClockResolution>(Clock::now() - start));
+            }
+            resolved += localResolved;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto endLoop = Clock::now();
+
+    std::vector<ClockResolution> allDurations;
+    for (const auto& threadDurations : durations) {
+        allDurations.insert(allDurations.end(), threadDurations.cbegin(), threadDurations.cend());
+    }
+    const auto totalDuration = std::chrono::duration_cast<ClockResolution>(endLoop - startLoop);
+    const double totalResolutions =
+            static_cast<double>(numberOfThreads * batchesPerThread * resolutionsPerBatch);
+    std::cerr << "Testcase: " << testCase << " threads: " << numberOfThreads
+              << " resolutions/sec: " << totalResolutions * 1e6 / totalDuration.count()
+              << " (latency per batch of " << resolutionsPerBatch << " resolutions, resolved "
+              << resolved << ")" << std::endl;
+    PerformanceTest::printStatistics(allDurations, totalDuration);
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t numberOfThreads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    const std::size_t numberOfParticipants = 10000;
+    const std::size_t numberOfAddresses = 100;
+    const std::size_t batchesPerThread = 500;
+
+    MessagingStubFactory messagingStubFactory;
+    messagingStubFactory.registerStubFactory(std::make_shared<NoOpMessagingStubFactory>());
+
+    RoutingTable routingTable;
+    for (std::size_t i = 0; i < numberOfParticipants; ++i) {
+        auto address = std::make_shared<const system::RoutingTypes::MqttAddress>(
+                "tcp://localhost:1883", "topic" + std::to_string(i % numberOfAddresses));
+        routingTable.add("participantId" + std::to_string(i),
+                         true,
+                         std::move(address),
+                         std::numeric_limits<std::int64_t>::max(),
+                         false);
+    }
+
+    runResolutions("RESOLVE_BY_ADDRESS",
+                   routingTable,
+                   numberOfThreads,
+                   numberOfParticipants,
+                   batchesPerThread,
+                   [&messagingStubFactory](const routingtable::RoutingEntry& routingEntry) {
+                       return messagingStubFactory.create(routingEntry.address);
+                   });
+
+    runResolutions("RESOLVE_CACHED_ON_ROUTING_ENTRY",
+                   routingTable,
+                   numberOfThreads,
+                   numberOfParticipants,
+                   batchesPerThread,
+                   [&messagingStubFactory](const routingtable::RoutingEntry& routingEntry) {
+                       return messagingStubFactory.createCached(
+                               routingEntry.address, *routingEntry.cachedMessagingStub);
+                   });
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/program_options.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/uds/UdsConnection.h"
+
+using namespace joynr;
+
+/**
+ * Sends numberOfMessages messages to uds-server-echo and waits until all of them have been
+ * echoed. The payload equals the one of websocket-client-echo, so that both transports can be
+ * compared.
+ */
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::string socketPath;
+    int numberOfMessages = 0;
+    bool killServer = false;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "path,p",
+            po::value<std::string>(&socketPath)->default_value("/tmp/uds-server-echo.sock"),
+            "path of the unix domain socket")(
+            "numberofmessages,n",
+            po::value<int>(&numberOfMessages)->default_value(10000),
+            "number of messages to transmit")(
+            "killserver,k", po::bool_switch(&killServer), "stop the server afterwards");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const std::string payload(R"({)"
+                              R"("_typeName":"joynr.types.TestTypes.TStructExtended",)"
+                              R"("tDouble":0.123456789,)"
+                              R"("tInt64":64,)"
+                              R"("tString":"myTestString",)"
+                              R"("tEnum":"TLITERALA",)"
+                              R"("tInt32":32)"
+                              R"(})");
+    const smrf::ByteVector message(payload.cbegin(), payload.cend());
+
+    try {
+        boost::asio::io_service ioService;
+        boost::asio::io_service::work work(ioService);
+        std::thread ioThread([&ioService]() { ioService.run(); });
+
+        UdsConnection::Socket socket(ioService);
+        socket.connect(boost::asio::local::stream_protocol::endpoint(socketPath));
+
+        std::atomic<int> numberOfReceivedMessages(0);
+        Semaphore finished(0);
+        auto connection = std::make_shared<UdsConnection>(
+                ioService,
+                std::move(socket),
+                [&numberOfReceivedMessages, &finished, numberOfMessages](smrf::ByteVector&&) {
+                    if (++numberOfReceivedMessages == numberOfMessages) {
+                        finished.notify();
+                    }
+                },
+                [&finished]() {
+                    std::cout << "connection closed by server" << std::endl;
+                    finished.notify();
+                });
+        connection->start();
+
+        auto onFailure = [](const exceptions::JoynrRuntimeException& e) {
+            std::cout << "Failed to send message: " << e.getMessage() << std::endl;
+        };
+        const auto startedTimestamp = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < numberOfMessages; i++) {
+            connection->send(smrf::ByteArrayView(message), onFailure);
+        }
+        finished.wait();
+        const auto durationUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - startedTimestamp);
+
+        if (killServer) {
+            const std::string kill("killServer");
+            const smrf::ByteVector killMessage(kill.cbegin(), kill.cend());
+            connection->send(smrf::ByteArrayView(killMessage), onFailure);
+        }
+        // let pending writes complete before closing
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        connection->close();
+        ioService.stop();
+        ioThread.join();
+
+        std::cout << "Received: " << numberOfReceivedMessages << std::endl;
+        std::cout << "Duration: " << static_cast<double>(durationUs.count()) / 1e6 << " sec"
+                  << std::endl;
+        if (durationUs.count() > 0) {
+            std::cout << "Msgs/s: "
+                      << numberOfReceivedMessages * 1e6 / static_cast<double>(durationUs.count())
+                      << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
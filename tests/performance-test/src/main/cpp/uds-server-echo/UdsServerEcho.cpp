@@ -0,0 +1,114 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/program_options.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/uds/UdsConnection.h"
+
+using namespace joynr;
+using Acceptor = boost::asio::local::stream_protocol::acceptor;
+
+/**
+ * Sends every message received on a unix domain socket back to its sender. The counterpart of
+ * websocket-server-echo using the length-prefixed framing of the joynr UDS transport.
+ */
+void startAccept(boost::asio::io_service& ioService, Acceptor& acceptor)
+{
+    auto socket = std::make_shared<UdsConnection::Socket>(ioService);
+    acceptor.async_accept(
+            *socket, [&ioService, &acceptor, socket](const boost::system::error_code& error) {
+                if (error) {
+                    std::cout << "accept failed: " << error.message() << std::endl;
+                    return;
+                }
+                auto connection = std::make_shared<std::weak_ptr<UdsConnection>>();
+                auto newConnection = std::make_shared<UdsConnection>(
+                        ioService,
+                        std::move(*socket),
+                        [&ioService, &acceptor, connection](smrf::ByteVector&& message) {
+                            const std::string killServer("killServer");
+                            if (message.size() == killServer.size() &&
+                                std::equal(killServer.cbegin(),
+                                           killServer.cend(),
+                                           message.cbegin())) {
+                                std::cout << "killServer" << std::endl;
+                                acceptor.close();
+                                ioService.stop();
+                                return;
+                            }
+                            if (auto echoConnection = connection->lock()) {
+                                echoConnection->send(
+                                        smrf::ByteArrayView(message),
+                                        [](const exceptions::JoynrRuntimeException& e) {
+                                            std::cout << "send failed: " << e.getMessage()
+                                                      << std::endl;
+                                        });
+                            }
+                        },
+                        nullptr);
+                *connection = newConnection;
+                newConnection->start();
+                startAccept(ioService, acceptor);
+            });
+}
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::string socketPath;
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "path,p",
+            po::value<std::string>(&socketPath)->default_value("/tmp/uds-server-echo.sock"),
+            "path of the unix domain socket");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    std::cout << "listening on:" << socketPath << std::endl;
+    try {
+        boost::asio::io_service ioService;
+        std::remove(socketPath.c_str());
+        Acceptor acceptor(ioService, boost::asio::local::stream_protocol::endpoint(socketPath));
+        startAccept(ioService, acceptor);
+        ioService.run();
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+    }
+    std::remove(socketPath.c_str());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+#include <websocketpp/client.hpp>
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/server.hpp>
+
+#include "joynr/IWebSocketSendInterface.h"
+#include "joynr/MessageBatch.h"
+#include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/websocket/WebSocketCoalescingSender.h"
+#include "libjoynr/websocket/WebSocketPpSender.h"
+
+using namespace joynr;
+using Server = websocketpp::server<websocketpp::config::asio>;
+using Client = websocketpp::client<websocketpp::config::asio_client>;
+using Clock = std::chrono::high_resolution_clock;
+
+/**
+ * Sends messages over a loopback WebSocket connection to an in-process echo server, keeping a
+ * window of messages in flight, and reports throughput, round trip times and the number of
+ * frames. With a coalescing size greater than zero both sides send through a
+ * WebSocketCoalescingSender, as a libjoynr runtime and a cluster controller do after they agreed
+ * on coalescing. The payload equals the one of websocket-client-echo.
+ */
+namespace
+{
+
+const std::string payload(R"({)"
+                          R"("_typeName":"joynr.types.TestTypes.TStructExtended",)"
+                          R"("tDouble":0.123456789,)"
+                          R"("tInt64":64,)"
+                          R"("tString":"myTestString",)"
+                          R"("tEnum":"TLITERALA",)"
+                          R"("tInt32":32)"
+                          R"(})");
+
+void onFailure(const exceptions::JoynrRuntimeException& e)
+{
+    std::cout << "Failed to send message: " << e.getMessage() << std::endl;
+}
+
+std::vector<smrf::ByteVector> unpack(const std::string& frame)
+{
+    smrf::ByteVector message(frame.cbegin(), frame.cend());
+    if (!MessageBatch::isBatch(message)) {
+        return {std::move(message)};
+    }
+    return MessageBatch::split(message);
+}
+
+std::shared_ptr<IWebSocketSendInterface> createSender(
+        boost::asio::io_service& ioService,
+        std::shared_ptr<IWebSocketSendInterface> webSocketSender,
+        std::uint32_t maxBytes,
+        std::chrono::microseconds maxDelay)
+{
+    if (maxBytes == 0) {
+        return webSocketSender;
+    }
+    return std::make_shared<WebSocketCoalescingSender>(
+            ioService, std::move(webSocketSender), maxBytes, maxDelay, true);
+}
+
+class EchoServer
+{
+public:
+    EchoServer(std::uint16_t port, std::uint32_t maxBytes, std::chrono::microseconds maxDelay)
+            : endpoint(),
+              maxBytes(maxBytes),
+              maxDelay(maxDelay),
+              sender(),
+              receivedFrames(0),
+              thread()
+    {
+        endpoint.init_asio();
+        endpoint.clear_access_channels(websocketpp::log::alevel::all);
+        endpoint.clear_error_channels(websocketpp::log::alevel::all);
+        endpoint.set_reuse_addr(true);
+        endpoint.set_open_handler([this](websocketpp::connection_hdl hdl) {
+            auto webSocketSender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
+            webSocketSender->setConnectionHandle(hdl);
+            sender = createSender(endpoint.get_io_service(),
+                                  std::move(webSocketSender),
+                                  this->maxBytes,
+                                  this->maxDelay);
+        });
+        // all handlers run on the single server thread
+        endpoint.set_message_handler(
+                [this](websocketpp::connection_hdl, Server::message_ptr frame) {
+                    receivedFrames++;
+                    for (const smrf::ByteVector& message : unpack(frame->get_payload())) {
+                        sender->send(smrf::ByteArrayView(message), onFailure);
+                    }
+                });
+        endpoint.listen(port);
+        endpoint.start_accept();
+        thread = std::thread(&Server::run, &endpoint);
+    }
+
+    ~EchoServer()
+    {
+        endpoint.stop();
+        thread.join();
+    }
+
+    std::uint64_t getReceivedFrames() const
+    {
+        return receivedFrames;
+    }
+
+private:
+    Server endpoint;
+    const std::uint32_t maxBytes;
+    const std::chrono::microseconds maxDelay;
+    std::shared_ptr<IWebSocketSendInterface> sender;
+    std::atomic<std::uint64_t> receivedFrames;
+    std::thread thread;
+};
+
+void printStatistics(std::vector<std::chrono::nanoseconds>& roundTripTimes,
+                     std::chrono::nanoseconds duration,
+                     std::uint64_t framesToServer,
+                     std::uint64_t framesFromServer)
+{
+    if (roundTripTimes.empty()) {
+        std::cout << "no round trips measured" << std::endl;
+        return;
+    }
+    std::sort(roundTripTimes.begin(), roundTripTimes.end());
+    auto toUs = [](std::chrono::nanoseconds value) {
+        return static_cast<double>(value.count()) / 1000.0;
+    };
+    const std::size_t count = roundTripTimes.size();
+    std::cout << "Messages: " << count << std::endl;
+    std::cout << "Messages/s: " << static_cast<double>(count) * 1e9 / duration.count()
+              << std::endl;
+    std::cout << "Frames to server: " << framesToServer << std::endl;
+    std::cout << "Frames from server: " << framesFromServer << std::endl;
+    std::cout << "Median round trip (us): " << toUs(roundTripTimes[count / 2]) << std::endl;
+    std::cout << "P99 round trip (us): " << toUs(roundTripTimes[count * 99 / 100]) << std::endl;
+    std::cout << "Max round trip (us): " << toUs(roundTripTimes.back()) << std::endl;
+}
+
+int run(int numberOfMessages,
+        std::size_t window,
+        std::uint16_t port,
+        std::uint32_t maxBytes,
+        std::chrono::microseconds maxDelay)
+{
+    EchoServer server(port, maxBytes, maxDelay);
+
+    Client client;
+    client.init_asio();
+    client.clear_access_channels(websocketpp::log::alevel::all);
+    client.clear_error_channels(websocketpp::log::alevel::all);
+
+    Semaphore connected(0);
+    Semaphore credits(window);
+    std::mutex sendTimesMutex;
+    std::deque<Clock::time_point> sendTimes;
+    std::vector<std::chrono::nanoseconds> roundTripTimes;
+    roundTripTimes.reserve(static_cast<std::size_t>(numberOfMessages));
+    std::uint64_t framesFromServer = 0;
+    Semaphore allReceived(0);
+
+    client.set_open_handler([&connected](websocketpp::connection_hdl) { connected.notify(); });
+    client.set_message_handler([&](websocketpp::connection_hdl, Client::message_ptr frame) {
+        framesFromServer++;
+        const std::size_t echoedMessages = unpack(frame->get_payload()).size();
+        const auto received = Clock::now();
+        std::lock_guard<std::mutex> lock(sendTimesMutex);
+        // messages are echoed in the order they were sent
+        for (std::size_t i = 0; i < echoedMessages && !sendTimes.empty(); i++) {
+            roundTripTimes.push_back(received - sendTimes.front());
+            sendTimes.pop_front();
+            credits.notify();
+        }
+        if (roundTripTimes.size() == static_cast<std::size_t>(numberOfMessages)) {
+            allReceived.notify();
+        }
+    });
+
+    websocketpp::lib::error_code errorCode;
+    websocketpp::uri hostUri(false, "localhost", port, std::string(""));
+    auto connection = client.get_connection(hostUri.str(), errorCode);
+    if (errorCode) {
+        std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
+        return EXIT_FAILURE;
+    }
+    client.connect(connection);
+    std::thread clientThread(&Client::run, &client);
+
+    int result = EXIT_SUCCESS;
+    if (connected.waitFor(std::chrono::seconds(5))) {
+        auto webSocketSender = std::make_shared<WebSocketPpSender<Client>>(client);
+        webSocketSender->setConnectionHandle(connection->get_handle());
+        auto sender = createSender(
+                client.get_io_service(), std::move(webSocketSender), maxBytes, maxDelay);
+
+        const smrf::ByteVector message(payload.cbegin(), payload.cend());
+        const auto start = Clock::now();
+        for (int i = 0; i < numberOfMessages; i++) {
+            credits.wait();
+            {
+                std::lock_guard<std::mutex> lock(sendTimesMutex);
+                sendTimes.push_back(Clock::now());
+            }
+            sender->send(smrf::ByteArrayView(message), onFailure);
+        }
+        if (!allReceived.waitFor(std::chrono::seconds(10))) {
+            std::cout << "not all echoes received" << std::endl;
+            result = EXIT_FAILURE;
+        }
+        const auto duration = Clock::now() - start;
+        client.close(connection, websocketpp::close::status::normal, std::string(""), errorCode);
+        clientThread.join();
+        std::lock_guard<std::mutex> lock(sendTimesMutex);
+        printStatistics(roundTripTimes, duration, server.getReceivedFrames(), framesFromServer);
+    } else {
+        std::cout << "Failed to connect to echo server" << std::endl;
+        client.stop();
+        clientThread.join();
+        result = EXIT_FAILURE;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    int numberOfMessages = 0;
+    std::size_t window = 0;
+    int port = 0;
+    std::uint32_t maxBytes = 0;
+    std::int64_t maxDelayUs = 0;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "numberofmessages,n",
+            po::value<int>(&numberOfMessages)->default_value(100000),
+            "number of messages")(
+            "window,w",
+            po::value<std::size_t>(&window)->default_value(64),
+            "number of messages in flight")(
+            "maxbytes,b",
+            po::value<std::uint32_t>(&maxBytes)->default_value(0),
+            "maximum size of a coalesced frame, 0 sends every message in a frame of its own")(
+            "maxdelayus,d",
+            po::value<std::int64_t>(&maxDelayUs)->default_value(200),
+            "maximum delay of a coalesced frame in microseconds")(
+            "port,p", po::value<int>(&port)->default_value(4221), "port of the echo server");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    return run(numberOfMessages,
+               std::max<std::size_t>(window, 1),
+               static_cast<std::uint16_t>(port),
+               maxBytes,
+               std::chrono::microseconds(maxDelayUs));
+}
@@ -0,0 +1,330 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <websocketpp/client.hpp>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+
+#include "joynr/IMessageRouter.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/TimePoint.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/system/RoutingTypes/WebSocketAddress.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+#include "libjoynr/websocket/WebSocketMessagingStubFactory.h"
+#include "libjoynrclustercontroller/websocket/WebSocketCcMessagingSkeletonNonTLS.h"
+
+using namespace joynr;
+using Client = websocketpp::client<websocketpp::config::asio_client>;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Measures the ingress throughput of the WebSocket server of the cluster controller: many
+ * clients send messages concurrently to an in-process WebSocketCcMessagingSkeleton whose
+ * router only counts the messages and optionally spends some time per message to simulate
+ * the routing cost.
+ */
+namespace
+{
+
+class CountingMessageRouter : public IMessageRouter
+{
+public:
+    CountingMessageRouter(std::uint64_t expectedMessages, std::chrono::microseconds routingTime)
+            : expectedMessages(expectedMessages),
+              routingTime(routingTime),
+              routedMessages(0),
+              allMessagesRouted(0)
+    {
+    }
+
+    void route(std::shared_ptr<ImmutableMessage> message, std::uint32_t tryCount) override
+    {
+        std::ignore = message;
+        std::ignore = tryCount;
+        if (routingTime.count() > 0) {
+            const auto end = Clock::now() + routingTime;
+            while (Clock::now() < end) {
+                // busy wait to simulate the CPU time of routing
+            }
+        }
+        if (++routedMessages == expectedMessages) {
+            allMessagesRouted.notify();
+        }
+    }
+
+    void addNextHop(const std::string&,
+                    const std::shared_ptr<const system::RoutingTypes::Address>&,
+                    bool,
+                    const std::int64_t,
+                    const bool,
+                    std::function<void()>,
+                    std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void addNextHops(const std::vector<std::string>&,
+                     const std::shared_ptr<const system::RoutingTypes::Address>&,
+                     bool,
+                     const std::int64_t,
+                     const bool,
+                     std::function<void()>,
+                     std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeNextHop(const std::string&,
+                       std::function<void()>,
+                       std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeNextHops(const std::vector<std::string>&,
+                        std::function<void()>,
+                        std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void addMulticastReceiver(
+            const std::string&,
+            const std::string&,
+            const std::string&,
+            std::function<void()>,
+            std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void removeMulticastReceiver(
+            const std::string&,
+            const std::string&,
+            const std::string&,
+            std::function<void()>,
+            std::function<void(const exceptions::ProviderRuntimeException&)>) override
+    {
+    }
+
+    void sendQueuedMessages(std::shared_ptr<const system::RoutingTypes::Address>) override
+    {
+    }
+
+    void setToKnown(const std::string&) override
+    {
+    }
+
+    bool waitForAllMessages(std::chrono::milliseconds timeout)
+    {
+        return allMessagesRouted.waitFor(timeout);
+    }
+
+    std::uint64_t getRoutedMessages() const
+    {
+        return routedMessages;
+    }
+
+private:
+    const std::uint64_t expectedMessages;
+    const std::chrono::microseconds routingTime;
+    std::atomic<std::uint64_t> routedMessages;
+    Semaphore allMessagesRouted;
+};
+
+std::string createSerializedMessage(int clientIndex)
+{
+    MutableMessage mutableMessage;
+    mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
+    mutableMessage.setSender("sender-" + std::to_string(clientIndex));
+    mutableMessage.setRecipient("recipient");
+    mutableMessage.setExpiryDate(TimePoint::fromRelativeMs(3600000));
+    mutableMessage.setPayload(R"({"_typeName":"joynr.OneWayRequest","methodName":"m"})");
+    const smrf::ByteVector& serializedMessage =
+            mutableMessage.getImmutableMessage()->getSerializedMessage();
+    return std::string(serializedMessage.cbegin(), serializedMessage.cend());
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    int numberOfClients = 0;
+    int numberOfMessages = 0;
+    int port = 0;
+    std::uint32_t ioThreads = 0;
+    std::uint32_t processingThreads = 0;
+    int routingTimeUs = 0;
+
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "clients,c", po::value<int>(&numberOfClients)->default_value(16), "number of clients")(
+            "numberofmessages,n",
+            po::value<int>(&numberOfMessages)->default_value(10000),
+            "number of messages per client")(
+            "port,p", po::value<int>(&port)->default_value(4250), "port of the WebSocket server")(
+            "iothreads,i",
+            po::value<std::uint32_t>(&ioThreads)->default_value(2),
+            "number of io threads of the WebSocket server")(
+            "processingthreads,w",
+            po::value<std::uint32_t>(&processingThreads)->default_value(4),
+            "number of message processing threads, 0 processes messages on the io threads")(
+            "routingtime,r",
+            po::value<int>(&routingTimeUs)->default_value(5),
+            "simulated routing time per message in microseconds");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const std::uint64_t totalMessages = static_cast<std::uint64_t>(numberOfClients) *
+                                        static_cast<std::uint64_t>(numberOfMessages);
+    auto messageRouter = std::make_shared<CountingMessageRouter>(
+            totalMessages, std::chrono::microseconds(routingTimeUs));
+    auto singleThreadedIOService = std::make_shared<SingleThreadedIOService>();
+    singleThreadedIOService->start();
+    auto skeleton = std::make_shared<WebSocketCcMessagingSkeletonNonTLS>(
+            singleThreadedIOService->getIOService(),
+            messageRouter,
+            std::make_shared<WebSocketMessagingStubFactory>(),
+            system::RoutingTypes::WebSocketAddress(
+                    system::RoutingTypes::WebSocketProtocol::WS, "localhost", port, ""),
+            ioThreads,
+            processingThreads);
+    skeleton->init();
+
+    // all clients share one io_service which is run by as many threads as there are clients,
+    // at most hardware_concurrency
+    Client client;
+    client.init_asio();
+    client.clear_access_channels(websocketpp::log::alevel::all);
+    client.clear_error_channels(websocketpp::log::alevel::all);
+
+    Semaphore connected(0);
+    client.set_open_handler([&connected](websocketpp::connection_hdl) { connected.notify(); });
+
+    std::vector<Client::connection_ptr> connections;
+    websocketpp::lib::error_code errorCode;
+    websocketpp::uri hostUri(false, "localhost", port, std::string(""));
+    for (int i = 0; i < numberOfClients; i++) {
+        auto connection = client.get_connection(hostUri.str(), errorCode);
+        if (errorCode) {
+            std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
+            return EXIT_FAILURE;
+        }
+        client.connect(connection);
+        connections.push_back(std::move(connection));
+    }
+    const unsigned int numberOfClientThreads =
+            std::max(1u,
+                     std::min(static_cast<unsigned int>(numberOfClients),
+                              std::thread::hardware_concurrency()));
+    std::vector<std::thread> clientThreads;
+    for (unsigned int i = 0; i < numberOfClientThreads; i++) {
+        clientThreads.emplace_back(&Client::run, &client);
+    }
+
+    int result = EXIT_SUCCESS;
+    for (int i = 0; i < numberOfClients; i++) {
+        if (!connected.waitFor(std::chrono::seconds(5))) {
+            std::cout << "Failed to connect to the WebSocket server" << std::endl;
+            result = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    if (result == EXIT_SUCCESS) {
+        for (int i = 0; i < numberOfClients; i++) {
+            system::RoutingTypes::WebSocketClientAddress clientAddress(
+                    "ingress-client-" + std::to_string(i));
+            client.send(connections[i],
+                        serializer::serializeToJson(clientAddress),
+                        websocketpp::frame::opcode::binary,
+                        errorCode);
+        }
+        // give the server time to register the clients
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        const auto start = Clock::now();
+        std::vector<std::thread> senderThreads;
+        for (int i = 0; i < numberOfClients; i++) {
+            senderThreads.emplace_back([&client, &connections, i, numberOfMessages]() {
+                const std::string message = createSerializedMessage(i);
+                websocketpp::lib::error_code sendError;
+                for (int j = 0; j < numberOfMessages; j++) {
+                    client.send(
+                            connections[i], message, websocketpp::frame::opcode::binary, sendError);
+                    if (sendError) {
+                        std::cout << "Failed to send message: " << sendError.message()
+                                  << std::endl;
+                        return;
+                    }
+                }
+            });
+        }
+        for (std::thread& senderThread : senderThreads) {
+            senderThread.join();
+        }
+        const bool completed = messageRouter->waitForAllMessages(std::chrono::minutes(5));
+        const auto duration =
+                std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+
+        if (!completed) {
+            std::cout << "only " << messageRouter->getRoutedMessages() << " of " << totalMessages
+                      << " messages routed" << std::endl;
+            result = EXIT_FAILURE;
+        }
+        const double seconds = static_cast<double>(duration.count()) / 1000000.0;
+        std::cout << "Clients: " << numberOfClients << std::endl;
+        std::cout << "IO threads: " << ioThreads << std::endl;
+        std::cout << "Processing threads: " << processingThreads << std::endl;
+        std::cout << "Messages routed: " << messageRouter->getRoutedMessages() << std::endl;
+        std::cout << "Duration (s): " << seconds << std::endl;
+        std::cout << "Throughput (msgs/s): "
+                  << static_cast<double>(messageRouter->getRoutedMessages()) / seconds
+                  << std::endl;
+    }
+
+    for (const Client::connection_ptr& connection : connections) {
+        connection->close(websocketpp::close::status::normal, std::string(""), errorCode);
+    }
+    client.stop();
+    for (std::thread& clientThread : clientThreads) {
+        clientThread.join();
+    }
+    skeleton->shutdown();
+    singleThreadedIOService->stop();
+    return result;
+}